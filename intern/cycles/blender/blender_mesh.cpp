@@ -36,8 +36,54 @@
 
 #include "mikktspace.h"
 
+#include "DNA_meshdata_types.h"
+
 CCL_NAMESPACE_BEGIN
 
+/* Direct Mesh Data Access
+ *
+ * Going through RNA for every vertex and face is slow for big meshes, the arrays of the
+ * evaluated mesh are read directly instead. Each returns NULL for an empty array. */
+
+static const MVert *mesh_verts(BL::Mesh &b_mesh)
+{
+  return (b_mesh.vertices.length()) ? (const MVert *)b_mesh.vertices[0].ptr.data : NULL;
+}
+
+static const MEdge *mesh_edges(BL::Mesh &b_mesh)
+{
+  return (b_mesh.edges.length()) ? (const MEdge *)b_mesh.edges[0].ptr.data : NULL;
+}
+
+static const MLoop *mesh_loops(BL::Mesh &b_mesh)
+{
+  return (b_mesh.loops.length()) ? (const MLoop *)b_mesh.loops[0].ptr.data : NULL;
+}
+
+static const MPoly *mesh_polys(BL::Mesh &b_mesh)
+{
+  return (b_mesh.polygons.length()) ? (const MPoly *)b_mesh.polygons[0].ptr.data : NULL;
+}
+
+static const MLoopTri *mesh_looptris(BL::Mesh &b_mesh)
+{
+  return (b_mesh.loop_triangles.length()) ?
+             (const MLoopTri *)b_mesh.loop_triangles[0].ptr.data :
+             NULL;
+}
+
+static inline float3 mvert_co(const MVert &mv)
+{
+  return make_float3(mv.co[0], mv.co[1], mv.co[2]);
+}
+
+static inline float3 mvert_normal(const MVert &mv)
+{
+  /* Same conversion as #normal_short_to_float_v3. */
+  const float scale = 1.0f / 32767.0f;
+  return make_float3(mv.no[0] * scale, mv.no[1] * scale, mv.no[2] * scale);
+}
+
 /* Tangent Space */
 
 struct MikkUserData {
@@ -539,6 +585,9 @@ static void attr_create_pointiness(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh, b
   if (num_verts == 0) {
     return;
   }
+  const MVert *verts = mesh_verts(b_mesh);
+  const MEdge *edges = mesh_edges(b_mesh);
+  const int num_edges = b_mesh.edges.length();
   /* STEP 1: Find out duplicated vertices and point duplicates to a single
    *         original vertex.
    */
@@ -592,7 +641,7 @@ static void attr_create_pointiness(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh, b
   vector<float3> vert_normal(num_verts, make_float3(0.0f, 0.0f, 0.0f));
   /* First we accumulate all vertex normals in the original index. */
   for (int vert_index = 0; vert_index < num_verts; ++vert_index) {
-    const float3 normal = get_float3(b_mesh.vertices[vert_index].normal());
+    const float3 normal = mvert_normal(verts[vert_index]);
     const int orig_index = vert_orig_index[vert_index];
     vert_normal[orig_index] += normal;
   }
@@ -607,18 +656,16 @@ static void attr_create_pointiness(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh, b
   vector<int> counter(num_verts, 0);
   vector<float> raw_data(num_verts, 0.0f);
   vector<float3> edge_accum(num_verts, make_float3(0.0f, 0.0f, 0.0f));
-  BL::Mesh::edges_iterator e;
   EdgeMap visited_edges;
-  int edge_index = 0;
   memset(&counter[0], 0, sizeof(int) * counter.size());
-  for (b_mesh.edges.begin(e); e != b_mesh.edges.end(); ++e, ++edge_index) {
-    const int v0 = vert_orig_index[b_mesh.edges[edge_index].vertices()[0]],
-              v1 = vert_orig_index[b_mesh.edges[edge_index].vertices()[1]];
+  for (int edge_index = 0; edge_index < num_edges; ++edge_index) {
+    const int v0 = vert_orig_index[edges[edge_index].v1],
+              v1 = vert_orig_index[edges[edge_index].v2];
     if (visited_edges.exists(v0, v1)) {
       continue;
     }
     visited_edges.insert(v0, v1);
-    float3 co0 = get_float3(b_mesh.vertices[v0].co()), co1 = get_float3(b_mesh.vertices[v1].co());
+    float3 co0 = mvert_co(verts[v0]), co1 = mvert_co(verts[v1]);
     float3 edge = normalize(co1 - co0);
     edge_accum[v0] += edge;
     edge_accum[v1] += -edge;
@@ -646,11 +693,10 @@ static void attr_create_pointiness(Scene *scene, Mesh *mesh, BL::Mesh &b_mesh, b
   float *data = attr->data_float();
   memcpy(data, &raw_data[0], sizeof(float) * raw_data.size());
   memset(&counter[0], 0, sizeof(int) * counter.size());
-  edge_index = 0;
   visited_edges.clear();
-  for (b_mesh.edges.begin(e); e != b_mesh.edges.end(); ++e, ++edge_index) {
-    const int v0 = vert_orig_index[b_mesh.edges[edge_index].vertices()[0]],
-              v1 = vert_orig_index[b_mesh.edges[edge_index].vertices()[1]];
+  for (int edge_index = 0; edge_index < num_edges; ++edge_index) {
+    const int v0 = vert_orig_index[edges[edge_index].v1],
+              v1 = vert_orig_index[edges[edge_index].v2];
     if (visited_edges.exists(v0, v1)) {
       continue;
     }
@@ -739,13 +785,18 @@ static void create_mesh(Scene *scene,
     return;
   }
 
+  const MVert *verts = mesh_verts(b_mesh);
+  const MLoop *loops = mesh_loops(b_mesh);
+  const MPoly *polys = mesh_polys(b_mesh);
+  const int numpolys = b_mesh.polygons.length();
+
   if (!subdivision) {
     numtris = numfaces;
   }
   else {
-    for (BL::MeshPolygon &p : b_mesh.polygons) {
-      numngons += (p.loop_total() == 4) ? 0 : 1;
-      numcorners += p.loop_total();
+    for (int i = 0; i < numpolys; i++) {
+      numngons += (polys[i].totloop == 4) ? 0 : 1;
+      numcorners += polys[i].totloop;
     }
   }
 
@@ -757,17 +808,15 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
 
   /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  for (int i = 0; i < numverts; i++)
+    mesh->add_vertex(mvert_co(verts[i]));
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  for (int i = 0; i < numverts; i++)
+    N[i] = mvert_normal(verts[i]);
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -782,6 +831,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -789,15 +839,18 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    for (BL::MeshLoopTriangle &t : b_mesh.loop_triangles) {
-      BL::MeshPolygon p = b_mesh.polygons[t.polygon_index()];
-      int3 vi = get_int3(t.vertices());
+    const MLoopTri *looptris = mesh_looptris(b_mesh);
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int t = 0; t < numtris; t++) {
+      const MLoopTri &lt = looptris[t];
+      const MPoly &p = polys[lt.poly];
+      int3 vi = make_int3(loops[lt.tri[0]].v, loops[lt.tri[1]].v, loops[lt.tri[2]].v);
+
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       if (use_loop_normals) {
-        BL::Array<float, 9> loop_normals = t.split_normals();
+        BL::Array<float, 9> loop_normals = b_mesh.loop_triangles[t].split_normals();
         for (int i = 0; i < 3; i++) {
           N[vi[i]] = make_float3(
               loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
@@ -814,15 +867,16 @@ static void create_mesh(Scene *scene,
   else {
     vector<int> vi;
 
-    for (BL::MeshPolygon &p : b_mesh.polygons) {
-      int n = p.loop_total();
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    for (int f = 0; f < numpolys; f++) {
+      const MPoly &p = polys[f];
+      int n = p.totloop;
+      int shader = clamp((int)p.mat_nr, 0, used_shaders.size() - 1);
+      bool smooth = (p.flag & ME_SMOOTH) || use_loop_normals;
 
       vi.resize(n);
       for (int i = 0; i < n; i++) {
         /* NOTE: Autosmooth is already taken care about. */
-        vi[i] = b_mesh.loops[p.loop_start() + i].vertex_index();
+        vi[i] = loops[p.loopstart + i].v;
       }
 
       /* create subd faces */
@@ -1125,12 +1179,12 @@ void BlenderSync::sync_mesh_motion(BL::Depsgraph b_depsgraph,
     /* NOTE: We don't copy more that existing amount of vertices to prevent
      * possible memory corruption.
      */
-    BL::Mesh::vertices_iterator v;
-    int i = 0;
-    for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
-      mP[i] = get_float3(v->co());
+    const MVert *verts = mesh_verts(b_mesh);
+    const int copy_verts = min(b_mesh.vertices.length(), numverts);
+    for (int i = 0; i < copy_verts; i++) {
+      mP[i] = mvert_co(verts[i]);
       if (mN)
-        mN[i] = get_float3(v->normal());
+        mN[i] = mvert_normal(verts[i]);
     }
     if (new_attribute) {
       /* In case of new attribute, we verify if there really was any motion. */
@@ -98,6 +98,60 @@ bool BlenderSync::object_is_light(BL::Object &b_ob)
 
 /* Object */
 
+const BlenderSync::ObjectInstanceSettings &BlenderSync::sync_object_instance_settings(
+    BL::ViewLayer &b_view_layer, BL::Object &b_parent, BL::Object &b_ob, BL::Object &b_ob_instance)
+{
+  const std::pair<void *, void *> key(b_parent.ptr.data, b_ob_instance.ptr.data);
+  map<std::pair<void *, void *>, ObjectInstanceSettings>::iterator it =
+      object_instance_settings.find(key);
+  if (it != object_instance_settings.end()) {
+    return it->second;
+  }
+
+  ObjectInstanceSettings &settings = object_instance_settings[key];
+
+  /* Visibility flags for both parent and child. */
+  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+  settings.use_holdout = get_boolean(cobject, "is_holdout") ||
+                         b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
+  settings.visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
+
+  if (b_parent.ptr.data != b_ob.ptr.data) {
+    settings.visibility &= object_ray_visibility(b_parent);
+  }
+
+  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
+#if 0
+  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
+    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
+  }
+#endif
+
+  /* Clear camera visibility for indirect only objects. */
+  bool use_indirect_only = !settings.use_holdout &&
+                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
+  if (use_indirect_only) {
+    settings.visibility &= ~PATH_RAY_CAMERA;
+  }
+
+  settings.is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
+  settings.shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
+
+  /* sync the asset name for Cryptomatte */
+  BL::Object parent = b_ob.parent();
+  if (parent) {
+    while (parent.parent()) {
+      parent = parent.parent();
+    }
+    settings.asset_name = parent.name();
+  }
+  else {
+    settings.asset_name = b_ob.name();
+  }
+
+  return settings;
+}
+
 Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  BL::ViewLayer &b_view_layer,
                                  BL::DepsgraphObjectInstance &b_instance,
@@ -155,32 +209,11 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
-  bool use_holdout = get_boolean(cobject, "is_holdout") ||
-                     b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
-  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
-
-  if (b_parent.ptr.data != b_ob.ptr.data) {
-    visibility &= object_ray_visibility(b_parent);
-  }
-
-  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
-#if 0
-  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
-    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
-  }
-#endif
-
-  /* Clear camera visibility for indirect only objects. */
-  bool use_indirect_only = !use_holdout &&
-                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
-  if (use_indirect_only) {
-    visibility &= ~PATH_RAY_CAMERA;
-  }
+  const ObjectInstanceSettings &settings = sync_object_instance_settings(
+      b_view_layer, b_parent, b_ob, b_ob_instance);
 
   /* Don't export completely invisible objects. */
-  if (visibility == 0) {
+  if (settings.visibility == 0) {
     return NULL;
   }
 
@@ -243,29 +276,16 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   }
 
   /* holdout */
-  object->set_use_holdout(use_holdout);
+  object->set_use_holdout(settings.use_holdout);
 
-  object->set_visibility(visibility);
+  object->set_visibility(settings.visibility);
 
-  bool is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
-  object->set_is_shadow_catcher(is_shadow_catcher);
+  object->set_is_shadow_catcher(settings.is_shadow_catcher);
 
-  float shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
-  object->set_shadow_terminator_offset(shadow_terminator_offset);
+  object->set_shadow_terminator_offset(settings.shadow_terminator_offset);
 
   /* sync the asset name for Cryptomatte */
-  BL::Object parent = b_ob.parent();
-  ustring parent_name;
-  if (parent) {
-    while (parent.parent()) {
-      parent = parent.parent();
-    }
-    parent_name = parent.name();
-  }
-  else {
-    parent_name = b_ob.name();
-  }
-  object->set_asset_name(parent_name);
+  object->set_asset_name(settings.asset_name);
 
   /* object sync
    * transform comparison should not be needed, but duplis don't work perfect
@@ -481,6 +501,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   /* layer data */
   bool motion = motion_time != 0.0f;
 
+  object_instance_settings.clear();
+
   if (!motion) {
     /* prepare for sync */
     light_map.pre_sync();
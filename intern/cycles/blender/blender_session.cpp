@@ -171,6 +171,12 @@ void BlenderSession::create_session()
 
 void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsgraph)
 {
+  /* With persistent data Blender keeps the depsgraph of the previous render of the same view
+   * layer, in which case the evaluated datablocks used as keys by the sync maps are still valid
+   * and only the updates reported by the depsgraph need to be synced. */
+  const bool is_same_depsgraph = (b_depsgraph.ptr.data == this->b_depsgraph.ptr.data) &&
+                                 (b_depsgraph.view_layer().name() == b_rlay_name);
+
   /* Update data, scene and depsgraph pointers. These can change after undo. */
   this->b_data = b_data;
   this->b_depsgraph = b_depsgraph;
@@ -225,7 +231,6 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   }
 
   session->progress.reset();
-  scene->reset();
 
   session->tile_manager.set_tile_order(session_params.tile_order);
 
@@ -237,9 +242,16 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   /* There is no single depsgraph to use for the entire render.
    * See note on create_session().
    */
-  /* sync object should be re-created */
-  delete sync;
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  if (is_new_session || !is_same_depsgraph) {
+    /* sync object should be re-created */
+    scene->reset();
+    delete sync;
+    sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  }
+  else {
+    /* Keep geometry, BVH and images of everything that did not change. */
+    sync->sync_recalc(b_depsgraph, b_v3d);
+  }
 
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
@@ -465,6 +477,22 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
                             time_human_readable_from_seconds(render_time).c_str());
   b_rr.stamp_data_add_field((prefix + "synchronization_time").c_str(),
                             time_human_readable_from_seconds(total_time - render_time).c_str());
+
+  /* Store the time spent per shader and object, so it's clear which ones are expensive. */
+  if (session->params.use_profiling) {
+    RenderStats stats;
+    session->collect_statistics(&stats);
+    const double shaders_avg = stats.shaders.avg_samples_per_hit();
+    foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.shaders.entries) {
+      b_rr.stamp_data_add_field((prefix + "profiling.shader." + entry.first.string()).c_str(),
+                                stats.shaders.entry_report(entry.second, shaders_avg).c_str());
+    }
+    const double objects_avg = stats.objects.avg_samples_per_hit();
+    foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.objects.entries) {
+      b_rr.stamp_data_add_field((prefix + "profiling.object." + entry.first.string()).c_str(),
+                                stats.objects.entry_report(entry.second, objects_avg).c_str());
+    }
+  }
 }
 
 void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
@@ -152,6 +152,19 @@ class BlenderSync {
 
   bool sync_object_attributes(BL::DepsgraphObjectInstance &b_instance, Object *object);
 
+  /* Settings that are the same for all instances of an object created by the same parent. */
+  struct ObjectInstanceSettings {
+    bool use_holdout;
+    uint visibility;
+    bool is_shadow_catcher;
+    float shadow_terminator_offset;
+    ustring asset_name;
+  };
+  const ObjectInstanceSettings &sync_object_instance_settings(BL::ViewLayer &b_view_layer,
+                                                              BL::Object &b_parent,
+                                                              BL::Object &b_ob,
+                                                              BL::Object &b_ob_instance);
+
   /* Volume */
   void sync_volume(BL::Object &b_ob, Volume *volume);
 
@@ -226,6 +239,9 @@ class BlenderSync {
   set<Geometry *> geometry_synced;
   set<Geometry *> geometry_motion_synced;
   set<float> motion_times;
+  /* Instance settings by parent and instanced object, looked up once per object sync instead of
+   * through RNA for every instance. */
+  map<std::pair<void *, void *>, ObjectInstanceSettings> object_instance_settings;
   void *world_map;
   bool world_recalc;
   BlenderViewportParameters viewport_parameters;
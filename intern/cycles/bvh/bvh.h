@@ -91,6 +91,12 @@ class BVH {
   {
   }
 
+  /* Whether refitting made the tree too slow to trace compared to building it again. */
+  virtual bool refit_degraded() const
+  {
+    return false;
+  }
+
  protected:
   BVH(const BVHParams &params,
       const vector<Geometry *> &geometry,
@@ -42,7 +42,7 @@ int BVHStackEntry::encodeIdx() const
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
-    : BVH(params_, geometry_, objects_)
+    : BVH(params_, geometry_, objects_), build_sah_cost(0.0f), refit_sah_cost(0.0f)
 {
 }
 
@@ -94,6 +94,8 @@ void BVH2::build(Progress &progress, Stats *)
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
 
+  build_sah_cost = refit_sah_cost = root->computeSubtreeSAHCost(params);
+
   /* free build nodes */
   root->deleteSubtree();
 }
@@ -110,6 +112,14 @@ void BVH2::refit(Progress &progress)
   refit_nodes();
 }
 
+/* Rebuild once tracing the refitted tree is estimated to be this much slower. */
+#define BVH_REFIT_MAX_COST_RATIO 1.5f
+
+bool BVH2::refit_degraded() const
+{
+  return refit_sah_cost > build_sah_cost * BVH_REFIT_MAX_COST_RATIO;
+}
+
 BVHNode *BVH2::widen_children_nodes(const BVHNode *root)
 {
   return const_cast<BVHNode *>(root);
@@ -319,7 +329,12 @@ void BVH2::refit_nodes()
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
+  refit_sah_cost = 0.0f;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+
+  /* Same as BVHNode::computeSubtreeSAHCost, weighted by the area relative to the root. */
+  const float root_area = bbox.safe_area();
+  refit_sah_cost = (root_area > 0.0f) ? refit_sah_cost / root_area : 0.0f;
 }
 
 void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
@@ -332,6 +347,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c1 = data[0].y;
 
     refit_primitives(c0, c1, bbox, visibility);
+    refit_sah_cost += bbox.safe_area() * params.cost(0, c1 - c0);
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -367,6 +383,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    refit_sah_cost += bbox.safe_area() * params.cost(2, 0);
   }
 }
 
@@ -48,6 +48,8 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  bool refit_degraded() const override;
+
   PackedBVH pack;
 
  protected:
@@ -90,6 +92,11 @@ class BVH2 : public BVH {
                            uint visibility0,
                            uint visibility1);
 
+  /* SAH cost of the tree when it was built and after the last refit. Refitting keeps the
+   * structure of the tree, its nodes grow and overlap more as the primitives move around. */
+  float build_sah_cost;
+  float refit_sah_cost;
+
   /* refit */
   void refit_nodes();
   void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
@@ -52,6 +52,7 @@
 #  include "util/util_logging.h"
 #  include "util/util_progress.h"
 #  include "util/util_stats.h"
+#  include "util/util_tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -343,27 +344,34 @@ void BVHEmbree::build(Progress &progress, Stats *stats, RTCDevice rtc_device_)
                                                         RTC_BUILD_QUALITY_MEDIUM);
   rtcSetSceneBuildQuality(scene, build_quality);
 
-  int i = 0;
-  foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        ++i;
-        continue;
-      }
-      if (!ob->get_geometry()->is_instanced()) {
-        add_object(ob, i);
-      }
-      else {
-        add_instance(ob, i);
-      }
-    }
-    else {
-      add_object(ob, i);
-    }
-    ++i;
-    if (progress.get_cancel())
-      return;
-  }
+  /* Create the geometries in parallel, attaching them to the scene is thread-safe and every
+   * object uses its own geometry IDs. The grain size avoids too much threading overhead for
+   * scenes with many small objects. */
+  static const int OBJECTS_PER_TASK = 32;
+  parallel_for(blocked_range<size_t>(0, objects.size(), OBJECTS_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   Object *ob = objects[i];
+                   if (params.top_level) {
+                     if (!ob->is_traceable()) {
+                       continue;
+                     }
+                     if (!ob->get_geometry()->is_instanced()) {
+                       add_object(ob, i);
+                     }
+                     else {
+                       add_instance(ob, i);
+                     }
+                   }
+                   else {
+                     add_object(ob, i);
+                   }
+                   if (progress.get_cancel()) {
+                     parallel_for_cancel();
+                     break;
+                   }
+                 }
+               });
 
   if (progress.get_cancel()) {
     return;
@@ -671,10 +679,14 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update the vertex buffers of modified geometry, then tell Embree to rebuild/-fit the BVHs.
+   * Embree only rebuilds the parts of the scene which were committed again. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
+    if (!ob->get_geometry()->is_modified()) {
+      /* Nothing changed. */
+    }
+    else if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
       Geometry *geom = ob->get_geometry();
 
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -696,6 +708,11 @@ void BVHEmbree::refit(Progress &progress)
         }
       }
     }
+    else if (ob->is_traceable()) {
+      /* The BVH of the instanced geometry was refitted, which changes the bounds of the
+       * instance. */
+      rtcCommitGeometry(rtcGetGeometry(scene, geom_id));
+    }
     geom_id += 2;
   }
 
@@ -130,6 +130,21 @@ bool CUDADevice::show_samples() const
   return true;
 }
 
+size_t CUDADevice::texture_memory_available()
+{
+  CUDAContextScope scope(this);
+
+  size_t free = 0, total = 0;
+  cuMemGetInfo(&free, &total);
+
+  size_t available = (free > device_texture_headroom) ? free - device_texture_headroom : 0;
+  if (can_map_host && map_host_limit > map_host_used) {
+    available += map_host_limit - map_host_used;
+  }
+
+  return available;
+}
+
 BVHLayoutMask CUDADevice::get_bvh_layout_mask() const
 {
   return BVH_LAYOUT_BVH2;
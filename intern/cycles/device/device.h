@@ -356,6 +356,13 @@ class Device {
   }
   virtual BVHLayoutMask get_bvh_layout_mask() const = 0;
 
+  /* Memory that can still be allocated for textures, including mapped host memory. Zero when
+   * there is no limit to take into account, as on the CPU. */
+  virtual size_t texture_memory_available()
+  {
+    return 0;
+  }
+
   /* statistics */
   Stats &stats;
   Profiler &profiler;
@@ -1626,7 +1626,9 @@ int2 CPUSplitKernel::split_kernel_global_size(device_memory & /*kg*/,
                                               device_memory & /*data*/,
                                               DeviceTask & /*task*/)
 {
-  return make_int2(1, 1);
+  /* Keep enough paths in flight for each kernel to work through a queue of similar rays, but
+   * every render thread has its own state so it must not grow too large either. */
+  return make_int2(32, 32);
 }
 
 uint64_t CPUSplitKernel::state_buffer_size(device_memory &kernel_globals,
@@ -164,6 +164,20 @@ class MultiDevice : public Device {
     return devices.front().device->show_samples();
   }
 
+  virtual size_t texture_memory_available() override
+  {
+    /* Use the smallest amount, textures are copied to every device unless it shares memory
+     * with its peers. */
+    size_t available = 0;
+    foreach (SubDevice &sub, devices) {
+      const size_t sub_available = sub.device->texture_memory_available();
+      if (sub_available != 0 && (available == 0 || sub_available < available)) {
+        available = sub_available;
+      }
+    }
+    return available;
+  }
+
   virtual BVHLayoutMask get_bvh_layout_mask() const override
   {
     BVHLayoutMask bvh_layout_mask = BVH_LAYOUT_ALL;
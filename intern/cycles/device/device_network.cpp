@@ -48,6 +48,10 @@ class NetworkDevice : public Device {
   device_ptr mem_counter;
   DeviceTask the_task; /* todo: handle multiple tasks */
 
+  /* Serves the tile requests of the server while its task runs, so that the tiles of multiple
+   * servers are rendered at the same time instead of one server after the other. */
+  thread *task_thread;
+
   thread_mutex rpc_lock;
 
   virtual bool show_samples() const
@@ -56,7 +60,7 @@ class NetworkDevice : public Device {
   }
 
   NetworkDevice(DeviceInfo &info, Stats &stats, Profiler &profiler, const char *address)
-      : Device(info, stats, profiler, true), socket(io_service)
+      : Device(info, stats, profiler, true), socket(io_service), task_thread(NULL)
   {
     error_func = NetworkError();
     stringstream portstr;
@@ -81,6 +85,8 @@ class NetworkDevice : public Device {
 
   ~NetworkDevice()
   {
+    task_wait();
+
     RPCSend snd(socket, &error_func, "stop");
     snd.write();
   }
@@ -198,6 +204,9 @@ class NetworkDevice : public Device {
 
   void task_add(DeviceTask &task)
   {
+    /* Only one task runs on the server at a time. */
+    task_wait();
+
     thread_scoped_lock lock(rpc_lock);
 
     the_task = task;
@@ -205,9 +214,22 @@ class NetworkDevice : public Device {
     RPCSend snd(socket, &error_func, "task_add");
     snd.add(task);
     snd.write();
+
+    lock.unlock();
+
+    task_thread = new thread(function_bind(&NetworkDevice::task_run, this));
   }
 
   void task_wait()
+  {
+    if (task_thread) {
+      task_thread->join();
+      delete task_thread;
+      task_thread = NULL;
+    }
+  }
+
+  void task_run()
   {
     thread_scoped_lock lock(rpc_lock);
 
@@ -218,7 +240,6 @@ class NetworkDevice : public Device {
 
     TileList the_tiles;
 
-    /* todo: run this threaded for connecting to multiple clients */
     for (;;) {
       if (error_func.have_error())
         break;
@@ -328,12 +328,21 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
+/* Probability density per unit of area of picking a point on an emissive triangle from the light
+ * distribution, which is weighted by the brightness of the triangle's shader. */
+ccl_device_inline float triangle_light_distribution_pdf(KernelGlobals *kg, int shader)
+{
+  return kernel_data.integrator.pdf_triangles *
+         kernel_tex_fetch(__shaders, (shader & SHADER_MASK)).emission_sample_weight;
+}
+
 ccl_device_inline float triangle_light_pdf_area(KernelGlobals *kg,
+                                                const int shader,
                                                 const float3 Ng,
                                                 const float3 I,
                                                 float t)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
+  float pdf = triangle_light_distribution_pdf(kg, shader);
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
@@ -389,12 +398,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       else {
         area = 0.5f * len(N);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * triangle_light_distribution_pdf(kg, sd->shader);
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    float pdf = triangle_light_pdf_area(kg, sd->shader, sd->Ng, sd->I, t);
     if (has_motion) {
       const float area = 0.5f * len(N);
       if (UNLIKELY(area == 0.0f)) {
@@ -542,7 +551,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * triangle_light_distribution_pdf(kg, ls->shader);
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -564,7 +573,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    ls->pdf = triangle_light_pdf_area(kg, ls->shader, ls->Ng, -ls->D, ls->t);
     if (has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
@@ -583,9 +592,8 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
 ccl_device int light_distribution_sample(KernelGlobals *kg, float *randu)
 {
   /* This is basically std::upper_bound as used by PBRT, to find a point light or
-   * triangle to emit from, proportional to area. a good improvement would be to
-   * also sample proportional to power, though it's not so well defined with
-   * arbitrary shaders. */
+   * triangle to emit from, proportional to area. Triangles are also weighted by the
+   * brightness of their shader when it is known, see #ShaderManager. */
   int first = 0;
   int len = kernel_data.integrator.num_distribution + 1;
   float r = *randu;
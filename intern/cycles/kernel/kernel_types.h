@@ -1567,7 +1567,8 @@ typedef struct KernelShader {
   float cryptomatte_id;
   int flags;
   int pass_id;
-  int pad2, pad3;
+  float emission_sample_weight;
+  int pad3;
 } KernelShader;
 static_assert_align(KernelShader, 16);
 
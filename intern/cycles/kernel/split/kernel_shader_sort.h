@@ -18,7 +18,6 @@ CCL_NAMESPACE_BEGIN
 
 ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSortLocals *locals)
 {
-#ifndef __KERNEL_CUDA__
   int tid = ccl_global_id(1) * ccl_global_size(0) + ccl_global_id(0);
   uint qsize = kernel_split_params.queue_index[QUEUE_ACTIVE_AND_REGENERATED_RAYS];
   if (tid == 0) {
@@ -54,10 +53,9 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
-#  ifdef __KERNEL_OPENCL__
-
-  /* bitonic sort */
+  /* bitonic sort
+   * On the CPU the local size is one, so a single thread visits every pair of a pass in turn.
+   * The second visit of a pair then finds it in order already and leaves it alone. */
   for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
     for (uint inc = length; inc > 0; inc >>= 1) {
       for (uint ii = 0; ii < SHADER_SORT_BLOCK_SIZE; ii += SHADER_SORT_LOCAL_SIZE) {
@@ -77,7 +75,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
-#  endif /* __KERNEL_OPENCL__ */
 
   /* copy to destination */
   for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i += SHADER_SORT_LOCAL_SIZE) {
@@ -91,7 +88,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
                                                               kernel_split_state.queue_data[ini];
     }
   }
-#endif /* __KERNEL_CUDA__ */
 }
 
 CCL_NAMESPACE_END
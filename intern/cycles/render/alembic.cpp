@@ -169,7 +169,7 @@ void CachedData::set_time_sampling(TimeSampling time_sampling)
   }
 }
 
-/* get the sample times to load data for the given the start and end frame of the procedural */
+/* get the sample times to load data for the given the frame range loaded by the procedural */
 static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
                                                const TimeSampling &time_sampling,
                                                size_t num_samples)
@@ -181,8 +181,8 @@ static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
     return result;
   }
 
-  double start_frame = (double)(proc->get_start_frame() / proc->get_frame_rate());
-  double end_frame = (double)((proc->get_end_frame() + 1) / proc->get_frame_rate());
+  double start_frame = (double)(proc->get_loaded_start_frame() / proc->get_frame_rate());
+  double end_frame = (double)((proc->get_loaded_end_frame() + 1) / proc->get_frame_rate());
 
   size_t start_index = time_sampling.getFloorIndex(start_frame, num_samples).first;
   size_t end_index = time_sampling.getCeilIndex(end_frame, num_samples).first;
@@ -630,7 +630,8 @@ bool AlembicObject::has_data_loaded() const
   return data_loaded;
 }
 
-void AlembicObject::update_shader_attributes(const ICompoundProperty &arb_geom_params,
+void AlembicObject::update_shader_attributes(AlembicProcedural *proc,
+                                             const ICompoundProperty &arb_geom_params,
                                              Progress &progress)
 {
   AttributeRequestSet requested_attributes = get_requested_attributes();
@@ -652,7 +653,7 @@ void AlembicObject::update_shader_attributes(const ICompoundProperty &arb_geom_p
       continue;
     }
 
-    read_attribute(arb_geom_params, attr.name, progress);
+    read_attribute(proc, arb_geom_params, attr.name, progress);
   }
 
   cached_data.invalidate_last_loaded_time(true);
@@ -767,7 +768,7 @@ void AlembicObject::load_all_data(AlembicProcedural *proc,
     return;
   }
 
-  update_shader_attributes(schema.getArbGeomParams(), progress);
+  update_shader_attributes(proc, schema.getArbGeomParams(), progress);
 
   if (progress.get_cancel()) {
     return;
@@ -1059,7 +1060,8 @@ AttributeRequestSet AlembicObject::get_requested_attributes()
   return requested_attributes;
 }
 
-void AlembicObject::read_attribute(const ICompoundProperty &arb_geom_params,
+void AlembicObject::read_attribute(AlembicProcedural *proc,
+                                   const ICompoundProperty &arb_geom_params,
                                    const ustring &attr_name,
                                    Progress &progress)
 {
@@ -1075,18 +1077,19 @@ void AlembicObject::read_attribute(const ICompoundProperty &arb_geom_params,
     CachedData::CachedAttribute &attribute = cached_data.add_attribute(attr_name,
                                                                        *param.getTimeSampling());
 
-    for (size_t i = 0; i < param.getNumSamples(); ++i) {
+    ccl::set<chrono_t> times = get_relevant_sample_times(
+        proc, *param.getTimeSampling(), param.getNumSamples());
+
+    foreach (chrono_t time, times) {
       if (progress.get_cancel()) {
         return;
       }
 
-      ISampleSelector iss = ISampleSelector(index_t(i));
+      ISampleSelector iss = ISampleSelector(time);
 
       IV2fGeomParam::Sample sample;
       param.getIndexed(sample, iss);
 
-      const chrono_t time = param.getTimeSampling()->getSampleTime(index_t(i));
-
       if (param.getScope() == kFacevaryingScope) {
         V2fArraySamplePtr values = sample.getVals();
         UInt32ArraySamplePtr indices = sample.getIndices();
@@ -1130,18 +1133,19 @@ void AlembicObject::read_attribute(const ICompoundProperty &arb_geom_params,
     CachedData::CachedAttribute &attribute = cached_data.add_attribute(attr_name,
                                                                        *param.getTimeSampling());
 
-    for (size_t i = 0; i < param.getNumSamples(); ++i) {
+    ccl::set<chrono_t> times = get_relevant_sample_times(
+        proc, *param.getTimeSampling(), param.getNumSamples());
+
+    foreach (chrono_t time, times) {
       if (progress.get_cancel()) {
         return;
       }
 
-      ISampleSelector iss = ISampleSelector(index_t(i));
+      ISampleSelector iss = ISampleSelector(time);
 
       IC3fGeomParam::Sample sample;
       param.getIndexed(sample, iss);
 
-      const chrono_t time = param.getTimeSampling()->getSampleTime(index_t(i));
-
       C3fArraySamplePtr values = sample.getVals();
 
       attribute.std = ATTR_STD_NONE;
@@ -1186,18 +1190,19 @@ void AlembicObject::read_attribute(const ICompoundProperty &arb_geom_params,
     CachedData::CachedAttribute &attribute = cached_data.add_attribute(attr_name,
                                                                        *param.getTimeSampling());
 
-    for (size_t i = 0; i < param.getNumSamples(); ++i) {
+    ccl::set<chrono_t> times = get_relevant_sample_times(
+        proc, *param.getTimeSampling(), param.getNumSamples());
+
+    foreach (chrono_t time, times) {
       if (progress.get_cancel()) {
         return;
       }
 
-      ISampleSelector iss = ISampleSelector(index_t(i));
+      ISampleSelector iss = ISampleSelector(time);
 
       IC4fGeomParam::Sample sample;
       param.getIndexed(sample, iss);
 
-      const chrono_t time = param.getTimeSampling()->getSampleTime(index_t(i));
-
       C4fArraySamplePtr values = sample.getVals();
 
       attribute.std = ATTR_STD_NONE;
@@ -1292,6 +1297,7 @@ NODE_DEFINE(AlembicProcedural)
   SOCKET_FLOAT(frame, "Frame", 1.0f);
   SOCKET_FLOAT(start_frame, "Start Frame", 1.0f);
   SOCKET_FLOAT(end_frame, "End Frame", 1.0f);
+  SOCKET_INT(prefetch_frames, "Prefetch Frames", 0);
   SOCKET_FLOAT(frame_rate, "Frame Rate", 24.0f);
   SOCKET_FLOAT(frame_offset, "Frame Offset", 0.0f);
   SOCKET_FLOAT(default_radius, "Default Radius", 0.01f);
@@ -1306,6 +1312,8 @@ AlembicProcedural::AlembicProcedural() : Procedural(node_type)
 {
   objects_loaded = false;
   scene_ = nullptr;
+  loaded_start_frame = 0.0f;
+  loaded_end_frame = 0.0f;
 }
 
 AlembicProcedural::~AlembicProcedural()
@@ -1370,6 +1378,13 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     objects_loaded = true;
   }
 
+  if (update_loaded_frame_range()) {
+    foreach (Node *node, objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      object->data_loaded = false;
+    }
+  }
+
   const chrono_t frame_time = (chrono_t)((frame - frame_offset) / frame_rate);
 
   foreach (Node *node, objects) {
@@ -1430,6 +1445,36 @@ AlembicObject *AlembicProcedural::get_or_create_object(const ustring &path)
   return object;
 }
 
+bool AlembicProcedural::update_loaded_frame_range()
+{
+  float range_start = start_frame;
+  float range_end = end_frame;
+
+  if (prefetch_frames > 0) {
+    /* Keep the loaded data as long as it covers the frames around the current one, which are
+     * needed for motion blur. */
+    const float current_frame = frame - frame_offset;
+    range_start = max(start_frame, current_frame - 1.0f);
+
+    const bool is_covered = range_start >= loaded_start_frame &&
+                            min(end_frame, current_frame + 1.0f) <= loaded_end_frame &&
+                            loaded_start_frame >= start_frame && loaded_end_frame <= end_frame;
+    if (is_covered) {
+      return false;
+    }
+
+    range_end = max(range_start, min(end_frame, current_frame + (float)prefetch_frames));
+  }
+
+  if (range_start == loaded_start_frame && range_end == loaded_end_frame) {
+    return false;
+  }
+
+  loaded_start_frame = range_start;
+  loaded_end_frame = range_end;
+  return true;
+}
+
 void AlembicProcedural::load_objects(Progress &progress)
 {
   unordered_map<string, AlembicObject *> object_map;
@@ -1489,7 +1534,7 @@ void AlembicProcedural::read_mesh(Scene *scene,
   }
   else {
     if (abc_object->need_shader_update) {
-      abc_object->update_shader_attributes(schema.getArbGeomParams(), progress);
+      abc_object->update_shader_attributes(this, schema.getArbGeomParams(), progress);
     }
 
     if (scale_is_modified()) {
@@ -1584,7 +1629,7 @@ void AlembicProcedural::read_subd(Scene *scene,
   }
   else {
     if (abc_object->need_shader_update) {
-      abc_object->update_shader_attributes(schema.getArbGeomParams(), progress);
+      abc_object->update_shader_attributes(this, schema.getArbGeomParams(), progress);
     }
 
     if (scale_is_modified()) {
@@ -19,6 +19,7 @@
 #include "graph/node.h"
 #include "render/attribute.h"
 #include "render/procedural.h"
+#include "util/util_algorithm.h"
 #include "util/util_set.h"
 #include "util/util_transform.h"
 #include "util/util_vector.h"
@@ -61,6 +62,26 @@ template<typename T> class DataStore {
 
   double last_loaded_time = std::numeric_limits<double>::max();
 
+  /* Only the samples of the frame range loaded by the procedural are stored, so lookup the
+   * stored sample nearest to the time instead of using the sample index from the TimeSampling. */
+  DataTimePair *find_nearest(double time)
+  {
+    typename vector<DataTimePair>::iterator it = std::lower_bound(
+        data.begin(), data.end(), time, [](const DataTimePair &pair, double time_) {
+          return pair.time < time_;
+        });
+
+    if (it == data.end()) {
+      return &data.back();
+    }
+
+    if (it != data.begin() && time - (it - 1)->time <= it->time - time) {
+      --it;
+    }
+
+    return &*it;
+  }
+
  public:
   void set_time_sampling(Alembic::AbcCoreAbstract::TimeSampling time_sampling_)
   {
@@ -80,9 +101,7 @@ template<typename T> class DataStore {
       return nullptr;
     }
 
-    std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, data.size());
-    DataTimePair &data_pair = data[index_pair.first];
+    DataTimePair &data_pair = *find_nearest(time);
 
     if (last_loaded_time == data_pair.time) {
       return nullptr;
@@ -101,10 +120,7 @@ template<typename T> class DataStore {
       return nullptr;
     }
 
-    std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, data.size());
-    DataTimePair &data_pair = data[index_pair.first];
-    return &data_pair.data;
+    return &find_nearest(time)->data;
   }
 
   void add_data(T &data_, double time)
@@ -285,10 +301,12 @@ class AlembicObject : public Node {
 
   CachedData cached_data;
 
-  void update_shader_attributes(const Alembic::AbcGeom::ICompoundProperty &arb_geom_params,
+  void update_shader_attributes(AlembicProcedural *proc,
+                                const Alembic::AbcGeom::ICompoundProperty &arb_geom_params,
                                 Progress &progress);
 
-  void read_attribute(const Alembic::AbcGeom::ICompoundProperty &arb_geom_params,
+  void read_attribute(AlembicProcedural *proc,
+                      const Alembic::AbcGeom::ICompoundProperty &arb_geom_params,
                       const ustring &attr_name,
                       Progress &progress);
 
@@ -310,12 +328,20 @@ class AlembicObject : public Node {
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
  * faster updates between frames as it avoids reseeking the data on disk.
+ *
+ * For heavy caches, the prefetch_frames socket limits the data in memory to a window starting
+ * just before the current frame, the window is loaded again once the current frame moves out of
+ * it.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
   bool objects_loaded;
   Scene *scene_;
 
+  /* Range of frames for which the data of the objects is loaded. */
+  float loaded_start_frame;
+  float loaded_end_frame;
+
  public:
   NODE_DECLARE
 
@@ -331,6 +357,10 @@ class AlembicProcedural : public Procedural {
   /* The last frame to load data for. */
   NODE_SOCKET_API(float, end_frame)
 
+  /* Number of frames after the current frame to load data for. When zero, the data for all frames
+   * between the start and the end frame is loaded at once. */
+  NODE_SOCKET_API(int, prefetch_frames)
+
   /* Subtracted to the current frame. */
   NODE_SOCKET_API(float, frame_offset)
 
@@ -364,7 +394,21 @@ class AlembicProcedural : public Procedural {
   /* Returns a pointer to an exisiting or a newly created AlembicObject for the given path. */
   AlembicObject *get_or_create_object(const ustring &path);
 
+  float get_loaded_start_frame() const
+  {
+    return loaded_start_frame;
+  }
+
+  float get_loaded_end_frame() const
+  {
+    return loaded_end_frame;
+  }
+
  private:
+  /* Update the range of frames to load data for, returns true if the data of the objects has to
+   * be loaded again. */
+  bool update_loaded_frame_range();
+
   /* Load the data for all the objects whose data has not yet been loaded. */
   void load_objects(Progress &progress);
 
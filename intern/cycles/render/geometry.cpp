@@ -220,8 +220,14 @@ void Geometry::compute_bvh(
       bvh->objects = objects;
 
       device->build_bvh(bvh, *progress, true);
+
+      if (bvh->refit_degraded()) {
+        VLOG(1) << "Rebuilding BVH of " << name << ", refitting degraded it too much.";
+        need_update_rebuild = true;
+      }
     }
-    else {
+
+    if (!bvh || need_update_rebuild) {
       progress->set_status(msg, "Building BVH");
 
       BVHParams bparams;
@@ -1012,8 +1018,10 @@ void GeometryManager::mesh_calc_offset(Scene *scene, BVHLayout bvh_layout)
   }
 }
 
-void GeometryManager::device_update_mesh(
-    Device *, DeviceScene *dscene, Scene *scene, bool for_displacement, Progress &progress)
+void GeometryManager::device_update_mesh(Device *,
+                                         DeviceScene *dscene,
+                                         Scene *scene,
+                                         Progress &progress)
 {
   /* Count. */
   size_t vert_size = 0;
@@ -1050,43 +1058,20 @@ void GeometryManager::device_update_mesh(
     }
   }
 
-  /* Create mapping from triangle to primitive triangle array. */
-  vector<uint> tri_prim_index(tri_size);
-  if (for_displacement) {
-    /* For displacement kernels we do some trickery to make them believe
-     * we've got all required data ready. However, that data is different
-     * from final render kernels since we don't have BVH yet, so can't
-     * really use same semantic of arrays.
-     */
-    foreach (Geometry *geom, scene->geometry) {
-      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
-        Mesh *mesh = static_cast<Mesh *>(geom);
-        for (size_t i = 0; i < mesh->num_triangles(); ++i) {
-          tri_prim_index[i + mesh->prim_offset] = 3 * (i + mesh->prim_offset);
-        }
-      }
-    }
-  }
-  else {
-    for (size_t i = 0; i < dscene->prim_index.size(); ++i) {
-      if ((dscene->prim_type[i] & PRIMITIVE_ALL_TRIANGLE) != 0) {
-        tri_prim_index[dscene->prim_index[i]] = dscene->prim_tri_index[i];
-      }
-    }
-  }
-
   /* Fill in all the arrays. */
   if (tri_size != 0) {
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
 
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
+    float4 *tri_verts = dscene->tri_verts.alloc(vert_size);
     float4 *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
 
     const bool copy_all_data = dscene->tri_shader.need_realloc() ||
+                               dscene->tri_verts.need_realloc() ||
                                dscene->tri_vindex.need_realloc() ||
                                dscene->tri_vnormal.need_realloc() ||
                                dscene->tri_patch.need_realloc() ||
@@ -1102,16 +1087,15 @@ void GeometryManager::device_update_mesh(
         }
 
         if (mesh->verts_is_modified() || copy_all_data) {
+          mesh->pack_positions(&tri_verts[mesh->vert_offset]);
           mesh->pack_normals(&vnormal[mesh->vert_offset]);
         }
 
         if (mesh->triangles_is_modified() || mesh->vert_patch_uv_is_modified() || copy_all_data) {
-          mesh->pack_verts(tri_prim_index,
-                           &tri_vindex[mesh->prim_offset],
+          mesh->pack_verts(&tri_vindex[mesh->prim_offset],
                            &tri_patch[mesh->prim_offset],
                            &tri_patch_uv[mesh->vert_offset],
-                           mesh->vert_offset,
-                           mesh->prim_offset);
+                           mesh->vert_offset);
         }
 
         if (progress.get_cancel())
@@ -1123,6 +1107,7 @@ void GeometryManager::device_update_mesh(
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
     dscene->tri_shader.copy_to_device_if_modified();
+    dscene->tri_verts.copy_to_device_if_modified();
     dscene->tri_vnormal.copy_to_device_if_modified();
     dscene->tri_vindex.copy_to_device_if_modified();
     dscene->tri_patch.copy_to_device_if_modified();
@@ -1188,23 +1173,6 @@ void GeometryManager::device_update_mesh(
 
     dscene->patches.copy_to_device();
   }
-
-  if (for_displacement) {
-    float4 *prim_tri_verts = dscene->prim_tri_verts.alloc(tri_size * 3);
-    foreach (Geometry *geom, scene->geometry) {
-      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
-        Mesh *mesh = static_cast<Mesh *>(geom);
-        for (size_t i = 0; i < mesh->num_triangles(); ++i) {
-          Mesh::Triangle t = mesh->get_triangle(i);
-          size_t offset = 3 * (i + mesh->prim_offset);
-          prim_tri_verts[offset + 0] = float3_to_float4(mesh->verts[t.v[0]]);
-          prim_tri_verts[offset + 1] = float3_to_float4(mesh->verts[t.v[1]]);
-          prim_tri_verts[offset + 2] = float3_to_float4(mesh->verts[t.v[2]]);
-        }
-      }
-    }
-    dscene->prim_tri_verts.copy_to_device();
-  }
 }
 
 void GeometryManager::device_update_bvh(Device *device,
@@ -1229,14 +1197,25 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* The scene BVH is only kept when no geometry was added, removed or changed topology. With
+   * Embree in interactive renders it can be refitted too, when no objects changed either, so
+   * deforming meshes only update the parts of the BVH they are in. */
   const bool can_refit = scene->bvh != nullptr &&
-                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX);
+                         (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
+                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE &&
+                           bparams.bvh_type == SceneParams::BVH_DYNAMIC &&
+                           (update_flags & OBJECT_MANAGER) == 0 &&
+                           scene->bvh->objects == scene->objects));
   const bool pack_all = scene->bvh == nullptr;
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
     bvh = scene->bvh = BVH::create(bparams, scene->geometry, scene->objects, device);
   }
+  else {
+    bvh->geometry = scene->geometry;
+    bvh->objects = scene->objects;
+  }
 
   device->build_bvh(bvh, progress, can_refit);
 
@@ -1254,12 +1233,10 @@ void GeometryManager::device_update_bvh(Device *device,
     progress.set_status("Updating Scene BVH", "Packing BVH primitives");
 
     size_t num_prims = 0;
-    size_t num_tri_verts = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
         num_prims += mesh->num_triangles();
-        num_tri_verts += 3 * mesh->num_triangles();
       }
       else if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
@@ -1269,16 +1246,12 @@ void GeometryManager::device_update_bvh(Device *device,
 
     pack.root_index = -1;
 
-    if (!pack_all) {
-      /* if we do not need to recreate the BVH, then only the vertices are updated, so we can
-       * safely retake the memory */
-      dscene->prim_tri_verts.give_data(pack.prim_tri_verts);
-    }
-    else {
+    /* If we do not need to recreate the BVH, nothing needs to be packed: the triangle vertices
+     * are read from the mesh vertex array by index. */
+    if (pack_all) {
       /* It is not strictly necessary to skip those resizes we if do not have to repack, as the OS
        * will not allocate pages if we do not touch them, however it does help catching bugs. */
       pack.prim_tri_index.resize(num_prims);
-      pack.prim_tri_verts.resize(num_tri_verts);
       pack.prim_type.resize(num_prims);
       pack.prim_index.resize(num_prims);
       pack.prim_object.resize(num_prims);
@@ -1565,6 +1538,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     dscene->prim_time.tag_realloc();
 
     if (device_update_flags & DEVICE_MESH_DATA_NEEDS_REALLOC) {
+      dscene->tri_verts.tag_realloc();
       dscene->tri_vnormal.tag_realloc();
       dscene->tri_vindex.tag_realloc();
       dscene->tri_patch.tag_realloc();
@@ -1614,6 +1588,7 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
   if (device_update_flags & DEVICE_MESH_DATA_MODIFIED) {
     /* if anything else than vertices or shaders are modified, we would need to reallocate, so
      * these are the only arrays that can be updated */
+    dscene->tri_verts.tag_modified();
     dscene->tri_vnormal.tag_modified();
     dscene->tri_shader.tag_modified();
   }
@@ -1829,7 +1804,7 @@ void GeometryManager::device_update(Device *device,
             {"device_update (displacement: copy meshes to device)", time});
       }
     });
-    device_update_mesh(device, dscene, scene, true, progress);
+    device_update_mesh(device, dscene, scene, progress);
   }
   if (progress.get_cancel()) {
     return;
@@ -1971,7 +1946,7 @@ void GeometryManager::device_update(Device *device,
             {"device_update (copy meshes to device)", time});
       }
     });
-    device_update_mesh(device, dscene, scene, false, progress);
+    device_update_mesh(device, dscene, scene, progress);
     if (progress.get_cancel()) {
       return;
     }
@@ -2012,6 +1987,7 @@ void GeometryManager::device_update(Device *device,
   dscene->prim_object.clear_modified();
   dscene->prim_time.clear_modified();
   dscene->tri_shader.clear_modified();
+  dscene->tri_verts.clear_modified();
   dscene->tri_vindex.clear_modified();
   dscene->tri_patch.clear_modified();
   dscene->tri_vnormal.clear_modified();
@@ -2039,6 +2015,7 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool forc
   dscene->prim_object.free_if_need_realloc(force_free);
   dscene->prim_time.free_if_need_realloc(force_free);
   dscene->tri_shader.free_if_need_realloc(force_free);
+  dscene->tri_verts.free_if_need_realloc(force_free);
   dscene->tri_vnormal.free_if_need_realloc(force_free);
   dscene->tri_vindex.free_if_need_realloc(force_free);
   dscene->tri_patch.free_if_need_realloc(force_free);
@@ -234,11 +234,7 @@ class GeometryManager {
 
   void device_update_object(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
-  void device_update_mesh(Device *device,
-                          DeviceScene *dscene,
-                          Scene *scene,
-                          bool for_displacement,
-                          Progress &progress);
+  void device_update_mesh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
   void device_update_attributes(Device *device,
                                 DeviceScene *dscene,
@@ -301,6 +301,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
   need_update_ = true;
   osl_texture_system = NULL;
   animation_frame = 0;
+  device_texture_limit = 0;
 
   /* Set image limits */
   has_half_images = info.has_half_images;
@@ -656,7 +657,8 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  const int texture_limit = (device_texture_limit > 0) ? device_texture_limit :
+                                                          scene->params.texture_limit;
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -808,6 +810,97 @@ void ImageManager::device_free_image(Device *, int slot)
   images[slot] = NULL;
 }
 
+static size_t image_pixel_size(ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(uint16_t) * 4;
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    default:
+      return 0;
+  }
+}
+
+/* Device memory used by an image loaded with the texture limit, matching the scaling done by
+ * file_load_image. */
+static size_t image_device_size(const ImageMetaData &metadata, int texture_limit)
+{
+  if (metadata.byte_size != 0) {
+    /* NanoVDB grids are never scaled. */
+    return metadata.byte_size;
+  }
+
+  const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  float scale_factor = 1.0f;
+  if (texture_limit > 0) {
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
+  }
+
+  const size_t width = max((size_t)((float)metadata.width * scale_factor), (size_t)1);
+  const size_t height = max((size_t)((float)metadata.height * scale_factor), (size_t)1);
+  const size_t depth = max((size_t)((float)metadata.depth * scale_factor), (size_t)1);
+  return width * height * depth * image_pixel_size(metadata.type);
+}
+
+/* Images are always loaded whole. When the ones about to be loaded don't fit into the memory
+ * left on the device, find the largest texture limit for which they do, so only the largest
+ * images are scaled down instead of failing to render. Returns zero when no limit is needed. */
+int ImageManager::fit_texture_limit(Device *device, int texture_limit)
+{
+  const size_t available = device->texture_memory_available();
+  if (available == 0) {
+    return 0;
+  }
+
+  vector<Image *> load_images;
+  size_t max_size = 0;
+  foreach (Image *img, images) {
+    if (img && img->users > 0 && img->need_load) {
+      load_image_metadata(img);
+      load_images.push_back(img);
+      max_size = max(max_size,
+                     max(max(img->metadata.width, img->metadata.height), img->metadata.depth));
+    }
+  }
+
+  /* Smallest limit offered in the user interface. */
+  const int min_limit = 128;
+  int limit = (texture_limit > 0) ? texture_limit : (int)min(max_size, (size_t)INT_MAX);
+  size_t total = 0;
+
+  for (; limit > 0; limit /= 2) {
+    total = 0;
+    foreach (Image *img, load_images) {
+      total += image_device_size(img->metadata, limit);
+    }
+    if (total <= available || limit / 2 < min_limit) {
+      break;
+    }
+  }
+
+  if (limit == texture_limit || (size_t)limit >= max_size) {
+    return 0;
+  }
+
+  VLOG(1) << "Images need " << string_human_readable_size(total) << " with a texture limit of "
+          << limit << ", " << string_human_readable_size(available)
+          << " available on the device.";
+  return limit;
+}
+
 void ImageManager::device_update(Device *device, Scene *scene, Progress &progress)
 {
   if (!need_update()) {
@@ -820,13 +913,20 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
-  TaskPool pool;
+  /* Free images first, so their memory is available to the new ones. */
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
     if (img && img->users == 0) {
       device_free_image(device, slot);
     }
-    else if (img && img->need_load) {
+  }
+
+  device_texture_limit = fit_texture_limit(device, scene->params.texture_limit);
+
+  TaskPool pool;
+  for (size_t slot = 0; slot < images.size(); slot++) {
+    Image *img = images[slot];
+    if (img && img->need_load) {
       pool.push(
           function_bind(&ImageManager::device_load_image, this, device, scene, slot, &progress));
     }
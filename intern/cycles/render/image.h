@@ -227,6 +227,10 @@ class ImageManager {
 
   void load_image_metadata(Image *img);
 
+  /* Texture size limit of images to fit into device memory, zero when all of them fit. */
+  int device_texture_limit;
+  int fit_texture_limit(Device *device, int texture_limit);
+
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
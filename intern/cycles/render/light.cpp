@@ -400,7 +400,7 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        totarea += triangle_area(p1, p2, p3) * shader->emission_sample_weight;
       }
     }
 
@@ -705,6 +705,15 @@ void Mesh::pack_shaders(Scene *scene, uint *tri_shader)
   }
 }
 
+void Mesh::pack_positions(float4 *tri_verts)
+{
+  size_t verts_size = verts.size();
+
+  for (size_t i = 0; i < verts_size; i++) {
+    tri_verts[i] = float3_to_float4(verts[i]);
+  }
+}
+
 void Mesh::pack_normals(float4 *vnormal)
 {
   Attribute *attr_vN = attributes.find(ATTR_STD_VERTEX_NORMAL);
@@ -729,12 +738,7 @@ void Mesh::pack_normals(float4 *vnormal)
   }
 }
 
-void Mesh::pack_verts(const vector<uint> &tri_prim_index,
-                      uint4 *tri_vindex,
-                      uint *tri_patch,
-                      float2 *tri_patch_uv,
-                      size_t vert_offset,
-                      size_t tri_offset)
+void Mesh::pack_verts(uint4 *tri_vindex, uint *tri_patch, float2 *tri_patch_uv, size_t vert_offset)
 {
   size_t verts_size = verts.size();
 
@@ -750,10 +754,9 @@ void Mesh::pack_verts(const vector<uint> &tri_prim_index,
 
   for (size_t i = 0; i < triangles_size; i++) {
     Triangle t = get_triangle(i);
-    tri_vindex[i] = make_uint4(t.v[0] + vert_offset,
-                               t.v[1] + vert_offset,
-                               t.v[2] + vert_offset,
-                               tri_prim_index[i + tri_offset]);
+    /* The last component is unused, the vertex positions are looked up in `tri_verts`. */
+    tri_vindex[i] = make_uint4(
+        t.v[0] + vert_offset, t.v[1] + vert_offset, t.v[2] + vert_offset, 0);
 
     tri_patch[i] = (!get_num_subd_faces()) ? -1 : (triangle_patch[i] * 8 + patch_offset);
   }
@@ -810,37 +813,30 @@ void Mesh::pack_primitives(ccl::PackedBVH *pack, int object, uint visibility, bo
   if (triangles.empty())
     return;
 
+  /* If the BVH does not have to be recreated, we can bail out. Vertices are read from
+   * `tri_verts` by index, so they don't need to be packed. */
+  if (!pack_all) {
+    return;
+  }
+
   const size_t num_prims = num_triangles();
 
-  /* Use prim_offset for indexing as it is computed per geometry type, and prim_tri_verts does not
-   * contain data for Hair geometries. */
-  float4 *prim_tri_verts = &pack->prim_tri_verts[prim_offset * 3];
-  // 'pack->prim_time' is unused by Embree and OptiX
+  /* Use optix_prim_offset for indexing as those arrays also contain data for Hair geometries. */
+  unsigned int *prim_tri_index = &pack->prim_tri_index[optix_prim_offset];
+  int *prim_type = &pack->prim_type[optix_prim_offset];
+  unsigned int *prim_visibility = &pack->prim_visibility[optix_prim_offset];
+  int *prim_index = &pack->prim_index[optix_prim_offset];
+  int *prim_object = &pack->prim_object[optix_prim_offset];
+  // 'pack->prim_time' and 'pack->prim_tri_verts' are unused by Embree and OptiX
 
   uint type = has_motion_blur() ? PRIMITIVE_MOTION_TRIANGLE : PRIMITIVE_TRIANGLE;
 
-  if (pack_all) {
-    /* Use optix_prim_offset for indexing as those arrays also contain data for Hair geometries. */
-    unsigned int *prim_tri_index = &pack->prim_tri_index[optix_prim_offset];
-    int *prim_type = &pack->prim_type[optix_prim_offset];
-    unsigned int *prim_visibility = &pack->prim_visibility[optix_prim_offset];
-    int *prim_index = &pack->prim_index[optix_prim_offset];
-    int *prim_object = &pack->prim_object[optix_prim_offset];
-
-    for (size_t k = 0; k < num_prims; ++k) {
-      prim_tri_index[k] = (prim_offset + k) * 3;
-      prim_type[k] = type;
-      prim_index[k] = prim_offset + k;
-      prim_object[k] = object;
-      prim_visibility[k] = visibility;
-    }
-  }
-
   for (size_t k = 0; k < num_prims; ++k) {
-    const Mesh::Triangle t = get_triangle(k);
-    prim_tri_verts[k * 3] = float3_to_float4(verts[t.v[0]]);
-    prim_tri_verts[k * 3 + 1] = float3_to_float4(verts[t.v[1]]);
-    prim_tri_verts[k * 3 + 2] = float3_to_float4(verts[t.v[2]]);
+    prim_tri_index[k] = (prim_offset + k) * 3;
+    prim_type[k] = type;
+    prim_index[k] = prim_offset + k;
+    prim_object[k] = object;
+    prim_visibility[k] = visibility;
   }
 }
 
@@ -223,13 +223,9 @@ class Mesh : public Geometry {
   void get_uv_tiles(ustring map, unordered_set<int> &tiles) override;
 
   void pack_shaders(Scene *scene, uint *shader);
+  void pack_positions(float4 *tri_verts);
   void pack_normals(float4 *vnormal);
-  void pack_verts(const vector<uint> &tri_prim_index,
-                  uint4 *tri_vindex,
-                  uint *tri_patch,
-                  float2 *tri_patch_uv,
-                  size_t vert_offset,
-                  size_t tri_offset);
+  void pack_verts(uint4 *tri_vindex, uint *tri_patch, float2 *tri_patch_uv, size_t vert_offset);
   void pack_patches(uint *patch_data, uint vert_offset, uint face_offset, uint corner_offset);
 
   void pack_primitives(PackedBVH *pack, int object, uint visibility, bool pack_all) override;
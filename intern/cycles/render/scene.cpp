@@ -57,6 +57,7 @@ DeviceScene::DeviceScene(Device *device)
       prim_object(device, "__prim_object", MEM_GLOBAL),
       prim_time(device, "__prim_time", MEM_GLOBAL),
       tri_shader(device, "__tri_shader", MEM_GLOBAL),
+      tri_verts(device, "__tri_verts", MEM_GLOBAL),
       tri_vnormal(device, "__tri_vnormal", MEM_GLOBAL),
       tri_vindex(device, "__tri_vindex", MEM_GLOBAL),
       tri_patch(device, "__tri_patch", MEM_GLOBAL),
@@ -84,6 +84,7 @@ class DeviceScene {
 
   /* mesh */
   device_vector<uint> tri_shader;
+  device_vector<float4> tri_verts;
   device_vector<float4> tri_vnormal;
   device_vector<uint4> tri_vindex;
   device_vector<uint> tri_patch;
@@ -61,6 +61,18 @@ Session::Session(const SessionParams &params_)
 
   TaskScheduler::init(params.threads);
 
+  /* Every CPU thread renders a tile of its own, keep enough tiles around for all of them. */
+  tile_manager.split_tiles_below = 0;
+  foreach (const DeviceInfo &info, params.device.multi_devices) {
+    tile_manager.split_tiles_below += (info.type == DEVICE_CPU) ? TaskScheduler::num_threads() :
+                                                                  1;
+  }
+  if (params.device.multi_devices.empty()) {
+    tile_manager.split_tiles_below = (params.device.type == DEVICE_CPU) ?
+                                         TaskScheduler::num_threads() :
+                                         1;
+  }
+
   session_thread = NULL;
   scene = NULL;
 
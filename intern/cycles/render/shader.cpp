@@ -202,6 +202,7 @@ Shader::Shader() : Node(node_type)
   has_surface = false;
   has_surface_transparent = false;
   has_surface_emission = false;
+  emission_sample_weight = 1.0f;
   has_surface_bssrdf = false;
   has_volume = false;
   has_displacement = false;
@@ -599,6 +600,12 @@ void ShaderManager::device_update_common(Device *device,
     if (shader->is_constant_emission(&constant_emission))
       flag |= SD_HAS_CONSTANT_EMISSION;
 
+    /* Sample emissive triangles proportional to their power where it is known, emission that
+     * depends on the shading point counts as a white emitter of unit strength. */
+    shader->emission_sample_weight = (flag & SD_HAS_CONSTANT_EMISSION) ?
+                                         average(fabs(constant_emission)) :
+                                         1.0f;
+
     uint32_t cryptomatte_id = util_murmur_hash3(shader->name.c_str(), shader->name.length(), 0);
 
     /* regular shader */
@@ -608,6 +615,7 @@ void ShaderManager::device_update_common(Device *device,
     kshader->constant_emission[1] = constant_emission.y;
     kshader->constant_emission[2] = constant_emission.z;
     kshader->cryptomatte_id = util_hash_to_float(cryptomatte_id);
+    kshader->emission_sample_weight = shader->emission_sample_weight;
     kshader++;
 
     has_transparent_shadow |= (flag & SD_HAS_TRANSPARENT_SHADOW) != 0;
@@ -818,10 +826,9 @@ string ShaderManager::get_cryptomatte_materials(Scene *scene)
   return manifest;
 }
 
-void ShaderManager::tag_update(Scene * /*scene*/, uint32_t /*flag*/)
+void ShaderManager::tag_update(Scene * /*scene*/, uint32_t flag)
 {
-  /* update everything for now */
-  update_flags = ShaderManager::UPDATE_ALL;
+  update_flags |= flag;
 }
 
 bool ShaderManager::need_update() const
@@ -127,6 +127,10 @@ class Shader : public Node {
   bool has_volume_attribute_dependency;
   bool has_integrator_dependency;
 
+  /* Weight of the emission when picking emissive triangles to sample, computed by the shader
+   * manager during device update. */
+  float emission_sample_weight;
+
   /* requested mesh attributes */
   AttributeRequestSet attributes;
 
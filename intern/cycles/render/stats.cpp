@@ -199,31 +199,40 @@ string NamedSampleCountStats::full_report(int indent_level)
   vector<NamedSampleCountPair> sorted_entries;
   sorted_entries.reserve(entries.size());
 
-  uint64_t total_hits = 0, total_samples = 0;
   foreach (entry_map::const_reference entry, entries) {
-    const NamedSampleCountPair &pair = entry.second;
-
-    total_hits += pair.hits;
-    total_samples += pair.samples;
-
-    sorted_entries.push_back(pair);
+    sorted_entries.push_back(entry.second);
   }
-  const double avg_samples_per_hit = ((double)total_samples) / total_hits;
 
   sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
 
+  const double avg = avg_samples_per_hit();
+
   string result = "";
   foreach (const NamedSampleCountPair &entry, sorted_entries) {
-    const double seconds = entry.samples * 0.001;
-    const double relative = ((double)entry.samples) / (entry.hits * avg_samples_per_hit);
-
-    result += indent +
-              string_printf(
-                  "%-32s: %.2fs (Relative cost: %.2f)\n", entry.name.c_str(), seconds, relative);
+    result += indent + string_printf("%-32s: ", entry.name.c_str()) + entry_report(entry, avg) +
+              "\n";
   }
   return result;
 }
 
+double NamedSampleCountStats::avg_samples_per_hit() const
+{
+  uint64_t total_hits = 0, total_samples = 0;
+  foreach (entry_map::const_reference entry, entries) {
+    total_hits += entry.second.hits;
+    total_samples += entry.second.samples;
+  }
+  return ((double)total_samples) / total_hits;
+}
+
+string NamedSampleCountStats::entry_report(const NamedSampleCountPair &entry, double avg) const
+{
+  const double seconds = entry.samples * 0.001;
+  const double relative = ((double)entry.samples) / (entry.hits * avg);
+
+  return string_printf("%.2fs (Relative cost: %.2f)", seconds, relative);
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -143,6 +143,11 @@ class NamedSampleCountStats {
   string full_report(int indent_level = 0);
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
+  /* Average number of samples per hit over all entries, to pass to #entry_report. */
+  double avg_samples_per_hit() const;
+  /* Time spent on the entry and its cost relative to the average entry, as used in the report. */
+  string entry_report(const NamedSampleCountPair &entry, double avg) const;
+
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
   entry_map entries;
 };
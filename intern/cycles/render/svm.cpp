@@ -35,7 +35,7 @@ CCL_NAMESPACE_BEGIN
 
 /* Shader Manager */
 
-SVMShaderManager::SVMShaderManager()
+SVMShaderManager::SVMShaderManager() : compiled_background_shader(NULL)
 {
 }
 
@@ -45,6 +45,9 @@ SVMShaderManager::~SVMShaderManager()
 
 void SVMShaderManager::reset(Scene * /*scene*/)
 {
+  compiled_svm_nodes.clear();
+  compiled_background_shader = NULL;
+  compiled_passes.clear();
 }
 
 void SVMShaderManager::device_update_shader(Scene *scene,
@@ -92,23 +95,53 @@ void SVMShaderManager::device_update(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
+  /* Compiled shaders only depend on the scene through the integrator, the background and the
+   * film passes, so when nothing but shaders changed, the unmodified ones are reused as they
+   * are. */
+  Shader *background_shader = scene->background->get_shader(scene);
+  const bool background_changed = (background_shader != compiled_background_shader);
+  const bool reuse_compiled = (update_flags & ~(SHADER_ADDED | SHADER_MODIFIED)) == 0 &&
+                              Pass::equals(scene->passes, compiled_passes);
+  int num_compiled = 0;
+
   /* Build all shaders. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+    map<Shader *, array<int4>>::iterator compiled = compiled_svm_nodes.find(shader);
+
+    if (reuse_compiled && !shader->is_modified() && compiled != compiled_svm_nodes.end() &&
+        !(background_changed &&
+          (shader == background_shader || shader == compiled_background_shader))) {
+      shader_svm_nodes[i].steal_data(compiled->second);
+      continue;
+    }
+
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
-                                 scene->shaders[i],
+                                 shader,
                                  &progress,
                                  &shader_svm_nodes[i]));
+    num_compiled++;
   }
   task_pool.wait_work();
 
+  compiled_svm_nodes.clear();
+  compiled_background_shader = NULL;
+  compiled_passes.clear();
+
   if (progress.get_cancel()) {
     return;
   }
 
+  for (int i = 0; i < num_shaders; i++) {
+    compiled_svm_nodes[scene->shaders[i]] = shader_svm_nodes[i];
+  }
+  compiled_background_shader = background_shader;
+  compiled_passes = scene->passes;
+
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
   int svm_nodes_size = num_shaders;
@@ -161,8 +194,8 @@ void SVMShaderManager::device_update(Device *device,
 
   update_flags = UPDATE_NONE;
 
-  VLOG(1) << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
-          << " seconds.";
+  VLOG(1) << "Shader manager updated " << num_shaders << " shaders (" << num_compiled
+          << " compiled) in " << time_dt() - start_time << " seconds.";
 }
 
 void SVMShaderManager::device_free(Device *device, DeviceScene *dscene, Scene *scene)
@@ -18,10 +18,12 @@
 #define __SVM_H__
 
 #include "render/attribute.h"
+#include "render/film.h"
 #include "render/graph.h"
 #include "render/shader.h"
 
 #include "util/util_array.h"
+#include "util/util_map.h"
 #include "util/util_set.h"
 #include "util/util_string.h"
 #include "util/util_thread.h"
@@ -54,6 +56,13 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Nodes of every shader compiled by the last update, reused for shaders that didn't change
+   * since. Keys are only compared, the shaders may have been freed in the meantime. */
+  map<Shader *, array<int4>> compiled_svm_nodes;
+  Shader *compiled_background_shader;
+  /* Passes the nodes were compiled for, AOV outputs write to offsets in the pass layout. */
+  vector<Pass> compiled_passes;
 };
 
 /* Graph Compiler */
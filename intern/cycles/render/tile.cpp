@@ -107,6 +107,7 @@ TileManager::TileManager(bool progressive_,
   preserve_tile_device = preserve_tile_device_;
   background = background_;
   schedule_denoising = false;
+  split_tiles_below = 0;
 
   range_start_sample = 0;
   range_num_samples = -1;
@@ -212,6 +213,8 @@ int TileManager::gen_tiles(bool sliced)
   state.render_tiles.resize(num);
   state.denoising_tiles.resize(num);
   state.tile_stride = tile_w;
+  /* Leave room for split tiles, tiles are referenced by pointer while they're rendered. */
+  state.tiles.reserve(2 * tile_w * divide_up(image_h, min(tile_size.y, image_h)));
   vector<list<int>>::iterator tile_list;
   tile_list = state.render_tiles.begin();
 
@@ -495,6 +498,37 @@ bool TileManager::finish_tile(const int index, const bool need_denoise, bool &de
   }
 }
 
+/* Split a tile that is waiting to be rendered in two along its longest side. The first half keeps
+ * the index of the tile, the second half is rendered next. */
+void TileManager::split_tile(int index, list<int> &tile_list)
+{
+  /* Smallest tile side to split to, smaller tiles run inefficiently on GPUs. */
+  const int min_tile_size = 32;
+
+  Tile &tile = state.tiles[index];
+  const bool split_x = (tile.w >= tile.h);
+  const int size = split_x ? tile.w : tile.h;
+  if (size < 2 * min_tile_size || state.tiles.size() == state.tiles.capacity()) {
+    return;
+  }
+
+  const int new_index = state.tiles.size();
+  if (split_x) {
+    const int w = tile.w / 2;
+    state.tiles.push_back(
+        Tile(new_index, tile.x + w, tile.y, tile.w - w, tile.h, tile.device, Tile::RENDER));
+    state.tiles[index].w = w;
+  }
+  else {
+    const int h = tile.h / 2;
+    state.tiles.push_back(
+        Tile(new_index, tile.x, tile.y + h, tile.w, tile.h - h, tile.device, Tile::RENDER));
+    state.tiles[index].h = h;
+  }
+  tile_list.push_front(new_index);
+  state.num_tiles++;
+}
+
 bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 {
   /* Preserve device if requested, unless this is a separate denoising device that just wants to
@@ -544,6 +578,13 @@ bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 
       tile_index = state.render_tiles[logical_device].front();
       state.render_tiles[logical_device].pop_front();
+
+      /* Split tiles are not part of the tile grid that denoising and progressive rendering rely
+       * on. */
+      if (!preserve_device && !progressive && !schedule_denoising &&
+          (int)state.render_tiles[logical_device].size() < split_tiles_below) {
+        split_tile(tile_index, state.render_tiles[logical_device]);
+      }
       break;
     }
 
@@ -133,6 +133,10 @@ class TileManager {
   /* Schedule tiles for denoising after they've been rendered. */
   bool schedule_denoising;
 
+  /* Split tiles in two when fewer than this many are left to render, so that no device sits idle
+   * waiting for the last large tile at the end of the frame. Zero disables splitting. */
+  int split_tiles_below;
+
  protected:
   void set_tiles();
 
@@ -165,6 +169,7 @@ class TileManager {
   /* Generate tile list, return number of tiles. */
   int gen_tiles(bool sliced);
   void gen_render_tiles();
+  void split_tile(int index, list<int> &tile_list);
 };
 
 CCL_NAMESPACE_END
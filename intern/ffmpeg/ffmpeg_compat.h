@@ -120,6 +120,12 @@
 #  define FFMPEG_HAVE_AVFRAME_SAMPLE_RATE
 #endif
 
+/* Hardware decoders through #avcodec_get_hw_config, FFmpeg 4.0. */
+#if ((LIBAVCODEC_VERSION_MAJOR > 58) || \
+     (LIBAVCODEC_VERSION_MAJOR == 58) && (LIBAVCODEC_VERSION_MINOR >= 18))
+#  define FFMPEG_HAVE_HW_CONFIG
+#endif
+
 #if ((LIBAVUTIL_VERSION_MAJOR > 51) || \
      (LIBAVUTIL_VERSION_MAJOR == 51) && (LIBAVUTIL_VERSION_MINOR >= 21))
 #  define FFMPEG_FFV1_ALPHA_SUPPORTED
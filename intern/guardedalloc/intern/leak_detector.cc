@@ -74,7 +74,11 @@ void MEM_init_memleak_detection(void)
    * leaked memory blocks. Static variables are destructed in reversed order of their
    * construction. Therefore, all static variables that own memory have to be constructed after
    * this function has been called.
+   *
+   * The memory usage counters are initialized first, so that they are still available when the
+   * leak detector runs.
    */
+  memory_usage_init();
   static MemLeakPrinter printer;
 }
 
@@ -0,0 +1,233 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * Every thread counts its own allocations, so that threads allocating at the same time don't
+ * write to the same cache line. The totals are only computed when they are requested.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/**
+ * Counters of a single thread. Aligned so that the counters of different threads never share a
+ * cache line.
+ */
+struct alignas(128) Local {
+  /** True for the first thread that allocated memory, this is the main thread. */
+  bool is_main = false;
+  /** Set when the thread exits, its counts are moved to #Global then. */
+  bool destructed = false;
+  /** Only written by the owning thread, atomic so that other threads can read them. */
+  std::atomic<int64_t> blocks{0};
+  std::atomic<int64_t> mem_in_use{0};
+  /** Value of #mem_in_use the last time the peak memory usage was updated. */
+  std::atomic<int64_t> mem_in_use_during_peak_update{0};
+
+  Local();
+  ~Local();
+};
+
+struct Global {
+  /** Guards #locals, held while computing the totals. */
+  std::mutex locals_mutex;
+  std::vector<Local *> locals;
+  /** Counts of threads that exited and of allocations done after the main thread exited. */
+  std::atomic<int64_t> blocks_outside_locals{0};
+  std::atomic<int64_t> mem_in_use_outside_locals{0};
+  size_t peak = 0;
+};
+
+}  // namespace
+
+/** Disabled when the main thread exits, remaining allocations are counted in #Global. */
+static std::atomic<bool> use_local_counters{true};
+
+/**
+ * Local memory usage increase after which the peak memory usage is updated. A larger value makes
+ * the peak less accurate, a smaller value makes threads synchronize more often.
+ */
+static constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+/* Construct on first use, allocations can happen before `main` and after it returned. */
+static Global &get_global()
+{
+  static Global global;
+  return global;
+}
+
+static Local &get_local_data()
+{
+  static thread_local Local local;
+  return local;
+}
+
+Local::Local()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  if (global.locals.empty()) {
+    this->is_main = true;
+  }
+  global.locals.push_back(this);
+}
+
+Local::~Local()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  global.locals.erase(std::find(global.locals.begin(), global.locals.end(), this));
+  global.blocks_outside_locals.fetch_add(this->blocks, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+
+  if (this->is_main) {
+    /* Static variables are freed after the thread local variables of the main thread. */
+    use_local_counters.store(false, std::memory_order_relaxed);
+  }
+  this->destructed = true;
+}
+
+/* Expects #Global::locals_mutex to be locked. */
+static int64_t mem_in_use_locked(const Global &global)
+{
+  int64_t mem_in_use = global.mem_in_use_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local : global.locals) {
+    mem_in_use += local->mem_in_use.load(std::memory_order_relaxed);
+  }
+  return mem_in_use;
+}
+
+static void update_global_peak()
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  for (Local *local : global.locals) {
+    local->mem_in_use_during_peak_update.store(local->mem_in_use.load(std::memory_order_relaxed),
+                                               std::memory_order_relaxed);
+  }
+  global.peak = std::max(global.peak, size_t(std::max<int64_t>(mem_in_use_locked(global), 0)));
+}
+
+void memory_usage_init(void)
+{
+  /* Make sure the global counters and the ones of the main thread exist. */
+  get_local_data();
+}
+
+void memory_usage_block_alloc(size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    if (LIKELY(!local.destructed)) {
+      /* Only the owning thread writes to these, so there is no contention with other threads.
+       * Relaxed stores are enough, the totals don't need to be exact while threads allocate. */
+      local.blocks.store(local.blocks.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+      const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed) + int64_t(size);
+      local.mem_in_use.store(mem_in_use, std::memory_order_relaxed);
+
+      if (mem_in_use - local.mem_in_use_during_peak_update.load(std::memory_order_relaxed) >
+          peak_update_threshold) {
+        update_global_peak();
+      }
+      return;
+    }
+  }
+
+  Global &global = get_global();
+  global.blocks_outside_locals.fetch_add(1, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+}
+
+void memory_usage_block_free(size_t size)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    if (LIKELY(!local.destructed)) {
+      /* Blocks freed by another thread than the one that allocated them make the counters of a
+       * thread negative, only the sum over all threads is meaningful. */
+      local.blocks.store(local.blocks.load(std::memory_order_relaxed) - 1,
+                         std::memory_order_relaxed);
+      const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed) - int64_t(size);
+      local.mem_in_use.store(mem_in_use, std::memory_order_relaxed);
+
+      /* Measure the increase for the next peak update from here, a new peak can be reached
+       * without this thread allocating more than before the last update. */
+      if (mem_in_use < local.mem_in_use_during_peak_update.load(std::memory_order_relaxed)) {
+        local.mem_in_use_during_peak_update.store(mem_in_use, std::memory_order_relaxed);
+      }
+      return;
+    }
+  }
+
+  Global &global = get_global();
+  global.blocks_outside_locals.fetch_sub(1, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+}
+
+size_t memory_usage_block_num(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  int64_t blocks = global.blocks_outside_locals.load(std::memory_order_relaxed);
+  for (const Local *local : global.locals) {
+    blocks += local->blocks.load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(blocks, 0));
+}
+
+size_t memory_usage_current(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+  return size_t(std::max<int64_t>(mem_in_use_locked(global), 0));
+}
+
+size_t memory_usage_peak(void)
+{
+  update_global_peak();
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+  return global.peak;
+}
+
+void memory_usage_peak_reset(void)
+{
+  Global &global = get_global();
+  std::lock_guard<std::mutex> lock{global.locals_mutex};
+
+  for (Local *local : global.locals) {
+    local->mem_in_use_during_peak_update.store(local->mem_in_use.load(std::memory_order_relaxed),
+                                               std::memory_order_relaxed);
+  }
+  global.peak = size_t(std::max<int64_t>(mem_in_use_locked(global), 0));
+}
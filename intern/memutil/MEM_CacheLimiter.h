@@ -56,7 +56,6 @@
 #include "MEM_Allocator.h"
 #include <list>
 #include <queue>
-#include <vector>
 
 template<class T> class MEM_CacheLimiter;
 
@@ -71,6 +70,9 @@ bool MEM_CacheLimiter_is_disabled(void);
 
 template<class T> class MEM_CacheLimiterHandle {
  public:
+  typedef std::list<MEM_CacheLimiterHandle<T> *, MEM_Allocator<MEM_CacheLimiterHandle<T> *>>
+      MEM_CacheQueue;
+
   explicit MEM_CacheLimiterHandle(T *data_, MEM_CacheLimiter<T> *parent_)
       : data(data_), refcount(0), parent(parent_)
   {
@@ -132,7 +134,8 @@ template<class T> class MEM_CacheLimiterHandle {
 
   T *data;
   int refcount;
-  int pos;
+  /** Position in #MEM_CacheLimiter.queue, to move or remove the element in constant time. */
+  typename MEM_CacheQueue::iterator pos;
   MEM_CacheLimiter<T> *parent;
 };
 
@@ -148,25 +151,21 @@ template<class T> class MEM_CacheLimiter {
 
   ~MEM_CacheLimiter()
   {
-    int i;
-    for (i = 0; i < queue.size(); i++) {
-      delete queue[i];
+    for (iterator it = queue.begin(); it != queue.end(); it++) {
+      delete *it;
     }
   }
 
   MEM_CacheLimiterHandle<T> *insert(T *elem)
   {
     queue.push_back(new MEM_CacheLimiterHandle<T>(elem, this));
-    queue.back()->pos = queue.size() - 1;
+    queue.back()->pos = --queue.end();
     return queue.back();
   }
 
   void unmanage(MEM_CacheLimiterHandle<T> *handle)
   {
-    int pos = handle->pos;
-    queue[pos] = queue.back();
-    queue[pos]->pos = pos;
-    queue.pop_back();
+    queue.erase(handle->pos);
     delete handle;
   }
 
@@ -174,9 +173,8 @@ template<class T> class MEM_CacheLimiter {
   {
     size_t size = 0;
     if (data_size_func) {
-      int i;
-      for (i = 0; i < queue.size(); i++) {
-        size += data_size_func(queue[i]->get()->get_data());
+      for (iterator it = queue.begin(); it != queue.end(); it++) {
+        size += data_size_func((*it)->get()->get_data());
       }
     }
     else {
@@ -236,11 +234,8 @@ template<class T> class MEM_CacheLimiter {
      * least priority element anyway.
      */
     if (item_priority_func == NULL) {
-      queue[handle->pos] = queue.back();
-      queue[handle->pos]->pos = handle->pos;
-      queue.pop_back();
-      queue.push_back(handle);
-      handle->pos = queue.size() - 1;
+      /* Keep the queue sorted from least to most recently used, splicing keeps the iterator. */
+      queue.splice(queue.end(), queue, handle->pos);
     }
   }
 
@@ -256,7 +251,7 @@ template<class T> class MEM_CacheLimiter {
 
  private:
   typedef MEM_CacheLimiterHandle<T> *MEM_CacheElementPtr;
-  typedef std::vector<MEM_CacheElementPtr, MEM_Allocator<MEM_CacheElementPtr>> MEM_CacheQueue;
+  typedef typename MEM_CacheLimiterHandle<T>::MEM_CacheQueue MEM_CacheQueue;
   typedef typename MEM_CacheQueue::iterator iterator;
 
   /* Check whether element can be destroyed when enforcing cache limits */
@@ -291,10 +286,10 @@ template<class T> class MEM_CacheLimiter {
     }
     else {
       int best_match_priority = 0;
-      int i;
+      int i = 0;
 
-      for (i = 0; i < queue.size(); i++) {
-        MEM_CacheElementPtr elem = queue[i];
+      for (iterator it = queue.begin(); it != queue.end(); it++, i++) {
+        MEM_CacheElementPtr elem = *it;
 
         if (!can_destroy_element(elem))
           continue;
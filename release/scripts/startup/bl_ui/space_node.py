@@ -660,14 +660,17 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(tree, "render_quality", text="Render")
         col.prop(tree, "edit_quality", text="Edit")
         col.prop(tree, "chunk_size")
+        col.prop(tree, "memory_limit")
 
         col = layout.column()
         col.prop(tree, "use_opencl")
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
+        col.prop(tree, "use_preview_resolution")
         col.separator()
         col.prop(snode, "use_auto_render")
+        col.prop(snode, "show_execution_stats")
 
 
 class NODE_UL_interface_sockets(bpy.types.UIList):
@@ -655,6 +655,11 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         col.prop(system, "sequencer_disk_cache_size_limit", text="Cache Limit")
         col.prop(system, "sequencer_disk_cache_compression", text="Compression")
 
+        layout.separator()
+
+        layout.prop(system, "sequencer_proxy_build_jobs")
+        layout.prop(system, "use_hardware_video_decoding")
+
 
 # -----------------------------------------------------------------------------
 # Viewport Panels
@@ -2252,6 +2257,10 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
             context, (
                 ({"property": "use_new_hair_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
+                ({"property": "use_undo_incremental"}, None),
+                ({"property": "use_playback_prefetch"}, None),
+                ({"property": "use_geometry_nodes_cache"}, None),
+                ({"property": "use_viewport_lod"}, None),
             ),
         )
 
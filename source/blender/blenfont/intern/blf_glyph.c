@@ -198,6 +198,7 @@ void blf_glyph_cache_clear(FontBLF *font)
   while ((gc = BLI_pophead(&font->cache))) {
     blf_glyph_cache_free(gc);
   }
+  blf_glyph_texture_free(font);
 
   BLI_spin_unlock(font->glyph_cache_mutex);
 }
@@ -210,15 +211,24 @@ void blf_glyph_cache_free(GlyphCacheBLF *gc)
       blf_glyph_free(g);
     }
   }
-  if (gc->texture) {
-    GPU_texture_free(gc->texture);
-  }
-  if (gc->bitmap_result) {
-    MEM_freeN(gc->bitmap_result);
-  }
   MEM_freeN(gc);
 }
 
+/* Free the glyph texture of the font, only valid once all its glyph caches are freed. */
+void blf_glyph_texture_free(FontBLF *font)
+{
+  BLI_assert(BLI_listbase_is_empty(&font->cache));
+
+  if (font->texture) {
+    GPU_texture_free(font->texture);
+    font->texture = NULL;
+  }
+  MEM_SAFE_FREE(font->bitmap_result);
+  font->bitmap_len = 0;
+  font->bitmap_len_landed = 0;
+  font->bitmap_len_alloc = 0;
+}
+
 GlyphBLF *blf_glyph_search(GlyphCacheBLF *gc, unsigned int c)
 {
   GlyphBLF *p;
@@ -490,29 +500,35 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
       font->tex_size_max = GPU_max_texture_size();
     }
 
-    g->offset = gc->bitmap_len;
+    g->offset = font->bitmap_len;
 
     int buff_size = g->dims[0] * g->dims[1];
-    int bitmap_len = gc->bitmap_len + buff_size;
+    int bitmap_len = font->bitmap_len + buff_size;
 
-    if (bitmap_len > gc->bitmap_len_alloc) {
+    if (bitmap_len > font->bitmap_len_alloc) {
       int w = font->tex_size_max;
       int h = bitmap_len / w + 1;
 
-      gc->bitmap_len_alloc = w * h;
-      gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
+      /* Double the rows, every resize uploads the whole texture again. */
+      if (font->bitmap_len_alloc > 0) {
+        const int h_double = MIN2(font->bitmap_len_alloc / w * 2, GPU_max_texture_layers());
+        h = MAX2(h, h_double);
+      }
+
+      font->bitmap_len_alloc = w * h;
+      font->bitmap_result = MEM_reallocN(font->bitmap_result, (size_t)font->bitmap_len_alloc);
 
       /* Keep in sync with the texture. */
-      if (gc->texture) {
-        GPU_texture_free(gc->texture);
+      if (font->texture) {
+        GPU_texture_free(font->texture);
       }
-      gc->texture = GPU_texture_create_1d_array(__func__, w, h, 1, GPU_R8, NULL);
+      font->texture = GPU_texture_create_1d_array(__func__, w, h, 1, GPU_R8, NULL);
 
-      gc->bitmap_len_landed = 0;
+      font->bitmap_len_landed = 0;
     }
 
-    memcpy(&gc->bitmap_result[gc->bitmap_len], g->bitmap, (size_t)buff_size);
-    gc->bitmap_len = bitmap_len;
+    memcpy(&font->bitmap_result[font->bitmap_len], g->bitmap, (size_t)buff_size);
+    font->bitmap_len = bitmap_len;
 
     gc->glyphs_len_free--;
     g->glyph_cache = gc;
@@ -528,11 +544,6 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
   }
 
-  if (g_batch.glyph_cache != g->glyph_cache) {
-    blf_batch_draw();
-    g_batch.glyph_cache = g->glyph_cache;
-  }
-
   if (font->flags & BLF_SHADOW) {
     rctf rect_ofs;
     blf_glyph_calc_rect_shadow(&rect_ofs, g, x, y, font);
@@ -38,7 +38,6 @@ typedef struct BatchBLF {
   float ofs[2];    /* copy of font->pos */
   float mat[4][4]; /* previous call modelmatrix. */
   bool enabled, active, simple_shader;
-  struct GlyphCacheBLF *glyph_cache;
 } BatchBLF;
 
 extern BatchBLF g_batch;
@@ -73,13 +72,6 @@ typedef struct GlyphCacheBLF {
   /* fast ascii lookup */
   struct GlyphBLF *glyph_ascii_table[256];
 
-  /* texture array, to draw the glyphs. */
-  GPUTexture *texture;
-  char *bitmap_result;
-  int bitmap_len;
-  int bitmap_len_landed;
-  int bitmap_len_alloc;
-
   /* and the bigger glyph in the font. */
   int glyph_width_max;
   int glyph_height_max;
@@ -113,7 +105,7 @@ typedef struct GlyphBLF {
   /* avoid conversion to int while drawing */
   int advance_i;
 
-  /* position inside the texture where this glyph is store. */
+  /* position inside the font texture where this glyph is store. */
   int offset;
 
   /* Bitmap data, from freetype. Take care that this
@@ -225,6 +217,14 @@ typedef struct FontBLF {
    */
   ListBase cache;
 
+  /* Texture array holding the glyphs of all the caches, so that text of different sizes and
+   * styles can be drawn in the same batch. Cleared together with the caches. */
+  GPUTexture *texture;
+  char *bitmap_result;
+  int bitmap_len;
+  int bitmap_len_landed;
+  int bitmap_len_alloc;
+
   /* list of kerning cache for this font. */
   ListBase kerning_caches;
 
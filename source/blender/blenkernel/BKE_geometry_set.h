@@ -45,10 +45,15 @@ typedef struct InstancedData {
   } data;
 } InstancedData;
 
+/**
+ * Get the instances of the geometry set. The instanced data of instance `i` is
+ * `r_references[r_reference_handles[i]]`. Returns the number of instances.
+ */
 int BKE_geometry_set_instances(const struct GeometrySet *geometry_set,
                                float (**r_transforms)[4][4],
                                int **r_ids,
-                               struct InstancedData **r_instanced_data);
+                               int **r_reference_handles,
+                               struct InstancedData **r_references);
 
 #ifdef __cplusplus
 }
@@ -187,6 +187,9 @@ class GeometryComponent {
 
   virtual blender::Set<std::string> attribute_names() const;
   virtual bool is_empty() const;
+  /* Returns false when the component references data that it does not own, which might be freed
+   * before the component. */
+  virtual bool owns_direct_data() const;
 
   /* Get a read-only attribute for the given domain and data type.
    * Returns null when it does not exist. */
@@ -312,6 +315,8 @@ struct GeometrySet {
   friend bool operator==(const GeometrySet &a, const GeometrySet &b);
   uint64_t hash() const;
 
+  void ensure_owns_direct_data();
+
   /* Utility methods for creation. */
   static GeometrySet create_with_mesh(
       Mesh *mesh, GeometryOwnershipType ownership = GeometryOwnershipType::Owned);
@@ -350,6 +355,7 @@ class MeshComponent : public GeometryComponent {
   MeshComponent();
   ~MeshComponent();
   GeometryComponent *copy() const override;
+  bool owns_direct_data() const override;
 
   void clear();
   bool has_mesh() const;
@@ -393,6 +399,7 @@ class PointCloudComponent : public GeometryComponent {
   PointCloudComponent();
   ~PointCloudComponent();
   GeometryComponent *copy() const override;
+  bool owns_direct_data() const override;
 
   void clear();
   bool has_pointcloud() const;
@@ -425,12 +432,21 @@ class PointCloudComponent : public GeometryComponent {
   static constexpr inline GeometryComponentType static_type = GeometryComponentType::PointCloud;
 };
 
-/** A geometry component that stores instances. */
+/**
+ * A geometry component that stores instances. The instanced objects and collections are stored
+ * once as references, every instance only stores a handle to its reference next to its transform,
+ * so large amounts of instances are cheap to create, copy and join.
+ */
 class InstancesComponent : public GeometryComponent {
  private:
   blender::Vector<blender::float4x4> transforms_;
   blender::Vector<int> ids_;
-  blender::Vector<InstancedData> instanced_data_;
+  /** Index into #references_ for every instance. */
+  blender::Vector<int> instance_reference_handles_;
+  /** Unique instanced data, referenced by index from the instances. */
+  blender::Vector<InstancedData> references_;
+  /** Handles of the references, keyed by the instanced object or collection. */
+  blender::Map<const void *, int> reference_handle_by_data_;
 
  public:
   InstancesComponent();
@@ -438,11 +454,20 @@ class InstancesComponent : public GeometryComponent {
   GeometryComponent *copy() const override;
 
   void clear();
+  void reserve(const int amount);
+
+  int add_reference(InstancedData data);
+  void add_instance(const int reference_handle,
+                    blender::float4x4 transform,
+                    const int id = -1);
   void add_instance(Object *object, blender::float4x4 transform, const int id = -1);
   void add_instance(Collection *collection, blender::float4x4 transform, const int id = -1);
   void add_instance(InstancedData data, blender::float4x4 transform, const int id = -1);
+  /** Append all instances of \a other, without copying their references more than once. */
+  void add_instances(const InstancesComponent &other);
 
-  blender::Span<InstancedData> instanced_data() const;
+  blender::Span<InstancedData> references() const;
+  blender::Span<int> instance_reference_handles() const;
   blender::Span<blender::float4x4> transforms() const;
   blender::Span<int> ids() const;
   blender::MutableSpan<blender::float4x4> transforms();
@@ -463,6 +488,7 @@ class VolumeComponent : public GeometryComponent {
   VolumeComponent();
   ~VolumeComponent();
   GeometryComponent *copy() const override;
+  bool owns_direct_data() const override;
 
   void clear();
   bool has_volume() const;
@@ -94,6 +94,9 @@ typedef enum MainIDRelationsEntryTags {
   MAINIDRELATIONS_ENTRY_TAGS_DOIT = 1 << 0,
   /* Generic tag marking the entry as processed. */
   MAINIDRELATIONS_ENTRY_TAGS_PROCESSED = 1 << 1,
+  /* The ID of that entry has been removed from Main (e.g. by batch deletion), remapping code
+   * does not process it as a user of other IDs anymore. */
+  MAINIDRELATIONS_ENTRY_TAGS_NO_MAIN = 1 << 2,
 } MainIDRelationsEntryTags;
 
 typedef struct MainIDRelations {
@@ -39,6 +39,7 @@ struct GeometrySet;
 struct ID;
 struct ListBase;
 struct Main;
+struct MemArena;
 struct Mesh;
 struct ModifierData;
 struct Object;
@@ -153,6 +154,9 @@ typedef struct ModifierEvalContext {
   struct Depsgraph *depsgraph;
   struct Object *object;
   ModifierApplyFlag flag;
+  /* Temporary memory of the modifier being evaluated, cleared after each modifier.
+   * Only set when evaluating the modifier stack, see #BKE_modifier_temp_alloc. */
+  struct MemArena *memarena;
 } ModifierEvalContext;
 
 typedef struct ModifierTypeInfo {
@@ -543,6 +547,11 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
                                  float (*vertexCos)[3],
                                  int numVerts);
 
+void *BKE_modifier_temp_alloc(const struct ModifierEvalContext *ctx,
+                              size_t size,
+                              const char *name);
+void BKE_modifier_temp_free(const struct ModifierEvalContext *ctx, void *ptr);
+
 struct Mesh *BKE_modifier_get_evaluated_mesh_from_evaluated_object(struct Object *ob_eval,
                                                                    const bool get_cage_mesh);
 
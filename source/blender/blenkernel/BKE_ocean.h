@@ -105,6 +105,10 @@ void BKE_ocean_simulate(struct Ocean *o, float t, float scale, float chop_amount
 /* sampling the ocean surface */
 float BKE_ocean_jminus_to_foam(float jminus, float coverage);
 void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float v);
+/* For sampling many points from multiple threads, the lock is only taken once. */
+void BKE_ocean_read_lock(struct Ocean *oc);
+void BKE_ocean_read_unlock(struct Ocean *oc);
+void BKE_ocean_eval_uv_unlocked(struct Ocean *oc, struct OceanResult *ocr, float u, float v);
 void BKE_ocean_eval_uv_catrom(struct Ocean *oc, struct OceanResult *ocr, float u, float v);
 void BKE_ocean_eval_xz(struct Ocean *oc, struct OceanResult *ocr, float x, float z);
 void BKE_ocean_eval_xz_catrom(struct Ocean *oc, struct OceanResult *ocr, float x, float z);
@@ -317,6 +317,7 @@ void BKE_pbvh_face_sets_set(PBVH *pbvh, int *face_sets);
 void BKE_pbvh_face_sets_color_set(PBVH *pbvh, int seed, int color_default);
 
 void BKE_pbvh_respect_hide_set(PBVH *pbvh, bool respect_hide);
+void BKE_pbvh_draw_buffers_keep_data_set(PBVH *pbvh, bool keep_data);
 
 /* vertex deformer */
 float (*BKE_pbvh_vert_coords_alloc(struct PBVH *pbvh))[3];
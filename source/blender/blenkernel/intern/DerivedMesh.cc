@@ -41,6 +41,7 @@
 #include "BLI_float2.hh"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_memarena.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -983,10 +984,12 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Modifier evaluation contexts for different types of modifiers. */
   ModifierApplyFlag apply_render = use_render ? MOD_APPLY_RENDER : (ModifierApplyFlag)0;
   ModifierApplyFlag apply_cache = use_cache ? MOD_APPLY_USECACHE : (ModifierApplyFlag)0;
+  /* Temporary memory of the modifiers, only allocated when a modifier uses it. */
+  MemArena *memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
   const ModifierEvalContext mectx = {
-      depsgraph, ob, (ModifierApplyFlag)(apply_render | apply_cache)};
+      depsgraph, ob, (ModifierApplyFlag)(apply_render | apply_cache), memarena};
   const ModifierEvalContext mectx_orco = {
-      depsgraph, ob, (ModifierApplyFlag)(apply_render | MOD_APPLY_ORCO)};
+      depsgraph, ob, (ModifierApplyFlag)(apply_render | MOD_APPLY_ORCO), memarena};
 
   /* Get effective list of modifiers to execute. Some effects like shape keys
    * are added as virtual modifiers before the user created modifiers. */
@@ -1350,6 +1353,7 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   BLI_linklist_free((LinkNode *)datamasks, nullptr);
+  BLI_memarena_free(memarena);
 
   for (md = firstmd; md; md = md->next) {
     BKE_modifier_free_temporary_data(md);
@@ -1572,9 +1576,11 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
   const bool use_render = (DEG_get_mode(depsgraph) == DAG_EVAL_RENDER);
   /* Modifier evaluation contexts for different types of modifiers. */
   ModifierApplyFlag apply_render = use_render ? MOD_APPLY_RENDER : (ModifierApplyFlag)0;
+  /* Temporary memory of the modifiers, only allocated when a modifier uses it. */
+  MemArena *memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
   const ModifierEvalContext mectx = {
-      depsgraph, ob, (ModifierApplyFlag)(MOD_APPLY_USECACHE | apply_render)};
-  const ModifierEvalContext mectx_orco = {depsgraph, ob, MOD_APPLY_ORCO};
+      depsgraph, ob, (ModifierApplyFlag)(MOD_APPLY_USECACHE | apply_render), memarena};
+  const ModifierEvalContext mectx_orco = {depsgraph, ob, MOD_APPLY_ORCO, memarena};
 
   /* Get effective list of modifiers to execute. Some effects like shape keys
    * are added as virtual modifiers before the user created modifiers. */
@@ -1654,11 +1660,11 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       /* apply vertex coordinates or build a DerivedMesh as necessary */
       if (mesh_final) {
         if (deformed_verts) {
-          Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, false);
-          if (mesh_final != mesh_cage) {
-            BKE_id_free(nullptr, mesh_final);
+          /* Only the cage has to be kept as is, otherwise the coordinates are applied in place
+           * so the layers that aren't deformed don't have to be copied. */
+          if (mesh_final == mesh_cage) {
+            mesh_final = BKE_mesh_copy_for_eval(mesh_final, false);
           }
-          mesh_final = mesh_tmp;
           BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
         }
         else if (mesh_final == mesh_cage) {
@@ -1762,17 +1768,16 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   BLI_linklist_free((LinkNode *)datamasks, nullptr);
+  BLI_memarena_free(memarena);
 
   /* Yay, we are done. If we have a DerivedMesh and deformed vertices need
    * to apply these back onto the DerivedMesh. If we have no DerivedMesh
    * then we need to build one. */
   if (mesh_final) {
     if (deformed_verts) {
-      Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, false);
-      if (mesh_final != mesh_cage) {
-        BKE_id_free(nullptr, mesh_final);
+      if (mesh_final == mesh_cage) {
+        mesh_final = BKE_mesh_copy_for_eval(mesh_final, false);
       }
-      mesh_final = mesh_tmp;
       BKE_mesh_vert_coords_apply(mesh_final, deformed_verts);
     }
   }
@@ -1869,18 +1874,30 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
 
   Mesh *mesh_eval = nullptr, *mesh_deform_eval = nullptr;
   GeometrySet *geometry_set_eval = nullptr;
-  mesh_calc_modifiers(depsgraph,
-                      scene,
-                      ob,
-                      1,
-                      need_mapping,
-                      dataMask,
-                      -1,
-                      true,
-                      true,
-                      &mesh_deform_eval,
-                      &mesh_eval,
-                      &geometry_set_eval);
+  /* Use the result evaluated in advance during playback when possible. */
+  if ((ob->mode & OB_MODE_ALL_SCULPT) == 0) {
+    mesh_eval = DEG_playback_prefetch_mesh_pop(
+        depsgraph, ob, dataMask, need_mapping, &mesh_deform_eval);
+  }
+  if (mesh_eval != nullptr) {
+    /* Only results without other geometry than the mesh are prefetched, the mesh itself is added
+     * to the geometry set below. */
+    geometry_set_eval = new GeometrySet();
+  }
+  else {
+    mesh_calc_modifiers(depsgraph,
+                        scene,
+                        ob,
+                        1,
+                        need_mapping,
+                        dataMask,
+                        -1,
+                        true,
+                        true,
+                        &mesh_deform_eval,
+                        &mesh_eval,
+                        &geometry_set_eval);
+  }
 
   /* The modifier stack evaluation is storing result in mesh->runtime.mesh_eval, but this result
    * is not guaranteed to be owned by object.
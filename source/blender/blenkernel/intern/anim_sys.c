@@ -35,6 +35,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 
@@ -596,6 +597,41 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Property resolved for the previous F-Curve, see #animsys_store_rna_setting_cached(). */
+typedef struct AnimsysResolvedPathCache {
+  const char *rna_path;
+  PathResolvedRNA anim_rna;
+  int array_len;
+} AnimsysResolvedPathCache;
+
+/**
+ * Same as #BKE_animsys_store_rna_setting, but reuses the property resolved for the previous
+ * F-Curve when this one animates another element of the same array property, like `location[1]`
+ * after `location[0]`. All F-Curves must be evaluated on the same \a ptr.
+ */
+static bool animsys_store_rna_setting_cached(PointerRNA *ptr,
+                                             const char *rna_path,
+                                             const int array_index,
+                                             AnimsysResolvedPathCache *cache,
+                                             PathResolvedRNA *r_result)
+{
+  if (cache->rna_path != NULL && rna_path != NULL && array_index < cache->array_len &&
+      STREQ(cache->rna_path, rna_path)) {
+    *r_result = cache->anim_rna;
+    r_result->prop_index = array_index;
+    return true;
+  }
+
+  if (!BKE_animsys_store_rna_setting(ptr, rna_path, array_index, r_result)) {
+    return false;
+  }
+
+  cache->rna_path = rna_path;
+  cache->anim_rna = *r_result;
+  cache->array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -606,6 +642,8 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysResolvedPathCache path_cache = {NULL};
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -614,7 +652,8 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_store_rna_setting_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_rna_setting(&anim_rna, curval);
       if (flush_to_original) {
@@ -742,12 +781,15 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  AnimsysResolvedPathCache path_cache = {NULL};
+
   /* calculate then execute each curve */
   for (fcu = agrp->channels.first; (fcu) && (fcu->grp == agrp); fcu = fcu->next) {
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_store_rna_setting_cached(
+              ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_rna_setting(&anim_rna, curval);
       }
@@ -1046,7 +1088,7 @@ static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
   int length = nec->base_snapshot.length;
 
   size_t byte_size = sizeof(NlaEvalChannelSnapshot) + sizeof(float) * length;
-  NlaEvalChannelSnapshot *nec_snapshot = MEM_callocN(byte_size, "NlaEvalChannelSnapshot");
+  NlaEvalChannelSnapshot *nec_snapshot = BLI_memarena_calloc(nec->owner->arena, byte_size);
 
   nec_snapshot->channel = nec;
   nec_snapshot->length = length;
@@ -1054,12 +1096,12 @@ static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
   return nec_snapshot;
 }
 
-/* Free a channel's blending value snapshot. */
+/* Free a channel's blending value snapshot.
+ * The memory is owned by the arena of the #NlaEvalData, so this only releases the slot. */
 static void nlaevalchan_snapshot_free(NlaEvalChannelSnapshot *nec_snapshot)
 {
   BLI_assert(!nec_snapshot->is_base);
-
-  MEM_freeN(nec_snapshot);
+  UNUSED_VARS_NDEBUG(nec_snapshot);
 }
 
 /* Copy all data in the snapshot. */
@@ -1184,6 +1226,7 @@ static void nlaeval_init(NlaEvalData *nlaeval)
 {
   memset(nlaeval, 0, sizeof(*nlaeval));
 
+  nlaeval->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "NlaEvalData::arena");
   nlaeval->path_hash = BLI_ghash_str_new("NlaEvalData::path_hash");
   nlaeval->key_hash = BLI_ghash_new(
       nlaevalchan_keyhash, nlaevalchan_keycmp, "NlaEvalData::key_hash");
@@ -1202,9 +1245,10 @@ static void nlaeval_free(NlaEvalData *nlaeval)
     nlaevalchan_free_data(nec);
   }
 
-  BLI_freelistN(&nlaeval->channels);
+  BLI_listbase_clear(&nlaeval->channels);
   BLI_ghash_free(nlaeval->path_hash, NULL, NULL);
   BLI_ghash_free(nlaeval->key_hash, NULL, NULL);
+  BLI_memarena_free(nlaeval->arena);
 }
 
 /* ---------------------- */
@@ -1360,8 +1404,8 @@ static NlaEvalChannel *nlaevalchan_verify_key(NlaEvalData *nlaeval,
   bool is_array = RNA_property_array_check(key->prop);
   int length = is_array ? RNA_property_array_length(&key->ptr, key->prop) : 1;
 
-  NlaEvalChannel *nec = MEM_callocN(sizeof(NlaEvalChannel) + sizeof(float) * length,
-                                    "NlaEvalChannel");
+  NlaEvalChannel *nec = BLI_memarena_calloc(nlaeval->arena,
+                                            sizeof(NlaEvalChannel) + sizeof(float) * length);
 
   /* Initialize the channel. */
   nec->rna_path = path;
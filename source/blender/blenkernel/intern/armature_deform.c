@@ -205,6 +205,7 @@ static float dist_bone_deform(
 }
 
 static void pchan_bone_deform(bPoseChannel *pchan,
+                              const bool use_bbone,
                               float weight,
                               float vec[3],
                               DualQuat *dq,
@@ -212,13 +213,11 @@ static void pchan_bone_deform(bPoseChannel *pchan,
                               const float co[3],
                               float *contrib)
 {
-  Bone *bone = pchan->bone;
-
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+  if (use_bbone) {
     b_bone_deform(pchan, co, weight, vec, dq, mat);
   }
   else {
@@ -237,6 +236,18 @@ static void pchan_bone_deform(bPoseChannel *pchan,
  * #BKE_armature_deform_coords and related functions.
  * \{ */
 
+/**
+ * The bone deforming the vertices of a vertex group, looked up once per evaluation
+ * so the per-vertex loop doesn't need to access the #Bone of every influence.
+ */
+typedef struct ArmatureDeformGroup {
+  /** NULL when there is no deforming bone with the name of the group. */
+  bPoseChannel *pchan;
+  bool use_bbone;
+  /** #BONE_MULT_VG_ENV, multiply the weight with the envelope of the bone. */
+  bool use_envelope_multiply;
+} ArmatureDeformGroup;
+
 typedef struct ArmatureUserdata {
   const Object *ob_arm;
   const Object *ob_target;
@@ -255,7 +266,7 @@ typedef struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
+  const ArmatureDeformGroup *deform_groups;
   int defbase_len;
 
   float premat[4][4];
@@ -333,18 +344,24 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      if (index < data->defbase_len && (pchan = data->deform_groups[index].pchan)) {
+        const ArmatureDeformGroup *group = &data->deform_groups[index];
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        /* Zero weights are common, skip them before the envelope is measured. */
+        if (weight == 0.0f) {
+          continue;
+        }
+
+        if (group->use_envelope_multiply) {
+          Bone *bone = pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        pchan_bone_deform(pchan, group->use_bbone, weight, vec, dq, smat, co, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
@@ -472,7 +489,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   bArmature *arm = ob_arm->data;
-  bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureDeformGroup *deform_groups = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -542,18 +559,20 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        deform_groups = MEM_callocN(sizeof(*deform_groups) * defbase_len, "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         for (i = 0, dg = ob_target->defbase.first; dg; i++, dg = dg->next) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+          bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = NULL;
-            }
+          if (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+            const Bone *bone = pchan->bone;
+            deform_groups[i].pchan = pchan;
+            deform_groups[i].use_bbone = (bone->segments > 1 &&
+                                          pchan->runtime.bbone_segments == bone->segments);
+            deform_groups[i].use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
           }
         }
       }
@@ -574,7 +593,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .armature_def_nr = armature_def_nr,
       .dverts = dverts,
       .dverts_len = dverts_len,
-      .pchan_from_defbase = pchan_from_defbase,
+      .deform_groups = deform_groups,
       .defbase_len = defbase_len,
       .bmesh =
           {
@@ -608,8 +627,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
 
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
+  if (deform_groups) {
+    MEM_freeN(deform_groups);
   }
 }
 
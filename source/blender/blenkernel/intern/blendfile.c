@@ -388,6 +388,10 @@ static void setup_app_data(bContext *C,
     /* TODO(sergey): Can this be also move above? */
     RE_FreeAllPersistentData();
   }
+  else {
+    /* The engines are kept, but their depsgraphs may reference data-blocks freed by undo. */
+    RE_FreeAllPersistentDepsgraphs();
+  }
 
   if (mode == LOAD_UNDO) {
     /* In undo/redo case, we do a whole lot of magic tricks to avoid having to re-read linked
@@ -5726,15 +5726,12 @@ static void dynamic_paint_wave_step_cb(void *__restrict userdata,
 static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescale)
 {
   PaintSurfaceData *sData = surface->data;
-  BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  int index;
   int steps, ss;
   float dt, min_dist, damp_factor;
   const float wave_speed = surface->wave_speed;
   const float wave_max_slope = (surface->wave_smoothness >= 0.01f) ?
                                    (0.5f / surface->wave_smoothness) :
                                    0.0f;
-  double average_dist = 0.0f;
   const float canvas_size = getSurfaceDimension(sData);
   const float wave_scale = CANVAS_REL_SIZE / canvas_size;
 
@@ -5744,15 +5741,8 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
     return;
   }
 
-  /* calculate average neigh distance (single thread) */
-  for (index = 0; index < sData->total_points; index++) {
-    int numOfNeighs = sData->adj_data->n_num[index];
-
-    for (int i = 0; i < numOfNeighs; i++) {
-      average_dist += (double)bNeighs[sData->adj_data->n_index[index] + i].dist;
-    }
-  }
-  average_dist *= (double)wave_scale / sData->adj_data->total_targets;
+  /* The average neighbor distance is computed with the adjacency data of this step. */
+  const double average_dist = sData->bData->average_dist * (double)wave_scale;
 
   /* determine number of required steps */
   steps = (int)ceil((double)(WAVE_TIME_FAC * timescale * surface->wave_timescale) /
@@ -1760,6 +1760,32 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Check whether `evaltime` lies in the segment found by the previous evaluation or the one after
+ * it, which is the common case during playback. Returns the index the binary search would give,
+ * or -1 when the time is outside those segments or within `threshold` of one of their keys.
+ *
+ * \note F-Curves of an action shared by multiple data-blocks can be evaluated from multiple
+ * threads, the hint is validated before use so a stale value only costs a regular search.
+ */
+static int fcurve_eval_segment_hint_find(const FCurve *fcu,
+                                         const BezTriple *bezts,
+                                         float evaltime,
+                                         float threshold)
+{
+  const int hint = fcu->eval_segment_hint;
+
+  for (int a = max_ii(hint, 1); a <= hint + 1 && a < (int)fcu->totvert; a++) {
+    const float prevframe = bezts[a - 1].vec[1][0];
+    const float frame = bezts[a].vec[1][0];
+    if (prevframe < evaltime && evaltime < frame && !IS_EQT(evaltime, prevframe, threshold) &&
+        !IS_EQT(evaltime, frame, threshold)) {
+      return a;
+    }
+  }
+  return -1;
+}
+
 static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -1779,7 +1805,15 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+  const int hint = fcurve_eval_segment_hint_find(fcu, bezts, evaltime, threshold);
+  if (hint != -1) {
+    a = (unsigned int)hint;
+  }
+  else {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    fcu->eval_segment_hint = (int)a;
+  }
   bezt = bezts + a;
 
   if (exact) {
@@ -1064,6 +1064,10 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
   if (atomic_cas_ptr((void **)&driver->expr_simple, NULL, expr) != NULL) {
     BLI_expr_pylike_free(expr);
   }
+  else if (!BLI_expr_pylike_is_valid(expr)) {
+    /* Report once per driver, Python evaluation is much slower and not multi-threaded. */
+    CLOG_INFO(&LOG, 1, "driver expression '%s' is evaluated with Python", driver->expression);
+  }
 
   return true;
 }
@@ -94,6 +94,30 @@ TEST(evaluate_fcurve, InterpolationLinear)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 10; i++) {
+    insert_vert_fcurve(
+        fcu, (float)i, (float)(i * i), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i].ipo = BEZT_IPO_LIN;
+  }
+
+  /* Evaluating forward, backward and jumping around must not depend on the segment found by the
+   * previous evaluation. Times within the search threshold of a key snap to that key. */
+  const float times[] = {0.5f, 1.5f, 2.5f, 2.75f, 1.25f, 8.5f, 3.5f, 3.0f, 3.00008f, 4.5f};
+  for (const float time : times) {
+    const int key = (int)time;
+    const float fac = time - (float)key;
+    const float expected = (fac < 0.0001f) ? (float)(key * key) :
+                                             (float)(key * key) + fac * (float)(2 * key + 1);
+    EXPECT_NEAR(evaluate_fcurve(fcu, time), expected, 1e-4f) << "time " << time;
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationBezier)
 {
   FCurve *fcu = BKE_fcurve_create();
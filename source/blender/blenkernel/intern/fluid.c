@@ -3253,14 +3253,121 @@ static void update_effectors(
   BKE_effectors_free(effectors);
 }
 
+typedef struct LiquidGeometryData {
+  FluidDomainSettings *fds;
+
+  MVert *mverts;
+  MPoly *mpolys;
+  MLoop *mloops;
+  short (*normals)[3];
+  FluidDomainVertexVelocity *velarray;
+
+  float co_scale[3];
+  float co_offset[3];
+  float time_mult;
+  short mp_mat_nr;
+  char mp_flag;
+} LiquidGeometryData;
+
+static void create_liquid_geometry_verts_task_cb(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidGeometryData *data = userdata;
+  FluidDomainSettings *fds = data->fds;
+  MVert *mverts = &data->mverts[i];
+  short *no_s = data->normals[i];
+  float no[3];
+
+  /* Vertices (data is normalized cube around domain origin). */
+  mverts->co[0] = manta_liquid_get_vertex_x_at(fds->fluid, i);
+  mverts->co[1] = manta_liquid_get_vertex_y_at(fds->fluid, i);
+  mverts->co[2] = manta_liquid_get_vertex_z_at(fds->fluid, i);
+
+  /* Adjust coordinates from Mantaflow to match viewport scaling. */
+  float tmp[3] = {(float)fds->res[0], (float)fds->res[1], (float)fds->res[2]};
+  /* Scale to unit cube around 0. */
+  mul_v3_fl(tmp, fds->mesh_scale * 0.5f);
+  sub_v3_v3(mverts->co, tmp);
+  /* Apply scaling of domain object. */
+  mul_v3_fl(mverts->co, fds->dx / fds->mesh_scale);
+
+  mul_v3_v3(mverts->co, data->co_scale);
+  add_v3_v3(mverts->co, data->co_offset);
+
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print coordinates of vertices. */
+  printf("mverts->co[0]: %f, mverts->co[1]: %f, mverts->co[2]: %f\n",
+         mverts->co[0],
+         mverts->co[1],
+         mverts->co[2]);
+#  endif
+
+  /* Normals (data is normalized cube around domain origin). */
+  no[0] = manta_liquid_get_normal_x_at(fds->fluid, i);
+  no[1] = manta_liquid_get_normal_y_at(fds->fluid, i);
+  no[2] = manta_liquid_get_normal_z_at(fds->fluid, i);
+
+  normal_float_to_short_v3(no_s, no);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print coordinates of normals. */
+  printf("no_s[0]: %d, no_s[1]: %d, no_s[2]: %d\n", no_s[0], no_s[1], no_s[2]);
+#  endif
+
+  if (data->velarray) {
+    FluidDomainVertexVelocity *velarray = data->velarray;
+    const float time_mult = data->time_mult;
+    velarray[i].vel[0] = manta_liquid_get_vertvel_x_at(fds->fluid, i) * (fds->dx / time_mult);
+    velarray[i].vel[1] = manta_liquid_get_vertvel_y_at(fds->fluid, i) * (fds->dx / time_mult);
+    velarray[i].vel[2] = manta_liquid_get_vertvel_z_at(fds->fluid, i) * (fds->dx / time_mult);
+#  ifdef DEBUG_PRINT
+    /* Debugging: Print velocities of vertices. */
+    printf("velarray[%d].vel[0]: %f, velarray[%d].vel[1]: %f, velarray[%d].vel[2]: %f\n",
+           i,
+           velarray[i].vel[0],
+           i,
+           velarray[i].vel[1],
+           i,
+           velarray[i].vel[2]);
+#  endif
+  }
+}
+
+static void create_liquid_geometry_faces_task_cb(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidGeometryData *data = userdata;
+  FluidDomainSettings *fds = data->fds;
+  MPoly *mpolys = &data->mpolys[i];
+  MLoop *mloops = &data->mloops[i * 3];
+
+  /* Initialize from existing face. */
+  mpolys->mat_nr = data->mp_mat_nr;
+  mpolys->flag = data->mp_flag;
+
+  mpolys->loopstart = i * 3;
+  mpolys->totloop = 3;
+
+  mloops[0].v = manta_liquid_get_triangle_x_at(fds->fluid, i);
+  mloops[1].v = manta_liquid_get_triangle_y_at(fds->fluid, i);
+  mloops[2].v = manta_liquid_get_triangle_z_at(fds->fluid, i);
+#  ifdef DEBUG_PRINT
+  /* Debugging: Print mesh faces. */
+  printf("mloops[0].v: %d, mloops[1].v: %d, mloops[2].v: %d\n",
+         mloops[0].v,
+         mloops[1].v,
+         mloops[2].v);
+#  endif
+}
+
 static Mesh *create_liquid_geometry(FluidDomainSettings *fds, Mesh *orgmesh, Object *ob)
 {
   Mesh *me;
   MVert *mverts;
   MPoly *mpolys;
   MLoop *mloops;
-  short *normals, *no_s;
-  float no[3];
+  short *normals;
   float min[3];
   float max[3];
   float size[3];
@@ -3278,7 +3385,6 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *fds, Mesh *orgmesh, Obj
   const short mp_mat_nr = mp_example.mat_nr;
   const char mp_flag = mp_example.flag;
 
-  int i;
   int num_verts, num_normals, num_faces;
 
   if (!fds->fluid) {
@@ -3347,81 +3453,29 @@ static Mesh *create_liquid_geometry(FluidDomainSettings *fds, Mesh *orgmesh, Obj
   /* Normals. */
   normals = MEM_callocN(sizeof(short[3]) * num_normals, "Fluidmesh_tmp_normals");
 
-  /* Loop for vertices and normals. */
-  for (i = 0, no_s = normals; i < num_verts && i < num_normals; i++, mverts++, no_s += 3) {
-
-    /* Vertices (data is normalized cube around domain origin). */
-    mverts->co[0] = manta_liquid_get_vertex_x_at(fds->fluid, i);
-    mverts->co[1] = manta_liquid_get_vertex_y_at(fds->fluid, i);
-    mverts->co[2] = manta_liquid_get_vertex_z_at(fds->fluid, i);
-
-    /* Adjust coordinates from Mantaflow to match viewport scaling. */
-    float tmp[3] = {(float)fds->res[0], (float)fds->res[1], (float)fds->res[2]};
-    /* Scale to unit cube around 0. */
-    mul_v3_fl(tmp, fds->mesh_scale * 0.5f);
-    sub_v3_v3(mverts->co, tmp);
-    /* Apply scaling of domain object. */
-    mul_v3_fl(mverts->co, fds->dx / fds->mesh_scale);
-
-    mul_v3_v3(mverts->co, co_scale);
-    add_v3_v3(mverts->co, co_offset);
-
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print coordinates of vertices. */
-    printf("mverts->co[0]: %f, mverts->co[1]: %f, mverts->co[2]: %f\n",
-           mverts->co[0],
-           mverts->co[1],
-           mverts->co[2]);
-#  endif
-
-    /* Normals (data is normalized cube around domain origin). */
-    no[0] = manta_liquid_get_normal_x_at(fds->fluid, i);
-    no[1] = manta_liquid_get_normal_y_at(fds->fluid, i);
-    no[2] = manta_liquid_get_normal_z_at(fds->fluid, i);
-
-    normal_float_to_short_v3(no_s, no);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print coordinates of normals. */
-    printf("no_s[0]: %d, no_s[1]: %d, no_s[2]: %d\n", no_s[0], no_s[1], no_s[2]);
-#  endif
-
-    if (use_speedvectors) {
-      velarray[i].vel[0] = manta_liquid_get_vertvel_x_at(fds->fluid, i) * (fds->dx / time_mult);
-      velarray[i].vel[1] = manta_liquid_get_vertvel_y_at(fds->fluid, i) * (fds->dx / time_mult);
-      velarray[i].vel[2] = manta_liquid_get_vertvel_z_at(fds->fluid, i) * (fds->dx / time_mult);
-#  ifdef DEBUG_PRINT
-      /* Debugging: Print velocities of vertices. */
-      printf("velarray[%d].vel[0]: %f, velarray[%d].vel[1]: %f, velarray[%d].vel[2]: %f\n",
-             i,
-             velarray[i].vel[0],
-             i,
-             velarray[i].vel[1],
-             i,
-             velarray[i].vel[2]);
-#  endif
-    }
-  }
+  LiquidGeometryData data = {
+      .fds = fds,
+      .mverts = mverts,
+      .mpolys = mpolys,
+      .mloops = mloops,
+      .normals = (short(*)[3])normals,
+      .velarray = velarray,
+      .time_mult = time_mult,
+      .mp_mat_nr = mp_mat_nr,
+      .mp_flag = mp_flag,
+  };
+  copy_v3_v3(data.co_scale, co_scale);
+  copy_v3_v3(data.co_offset, co_offset);
+
+  /* Loop for vertices and normals in parallel, the mesh of a liquid can be large. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(
+      0, min_ii(num_verts, num_normals), &data, create_liquid_geometry_verts_task_cb, &settings);
 
   /* Loop for triangles. */
-  for (i = 0; i < num_faces; i++, mpolys++, mloops += 3) {
-    /* Initialize from existing face. */
-    mpolys->mat_nr = mp_mat_nr;
-    mpolys->flag = mp_flag;
-
-    mpolys->loopstart = i * 3;
-    mpolys->totloop = 3;
-
-    mloops[0].v = manta_liquid_get_triangle_x_at(fds->fluid, i);
-    mloops[1].v = manta_liquid_get_triangle_y_at(fds->fluid, i);
-    mloops[2].v = manta_liquid_get_triangle_z_at(fds->fluid, i);
-#  ifdef DEBUG_PRINT
-    /* Debugging: Print mesh faces. */
-    printf("mloops[0].v: %d, mloops[1].v: %d, mloops[2].v: %d\n",
-           mloops[0].v,
-           mloops[1].v,
-           mloops[2].v);
-#  endif
-  }
+  BLI_task_parallel_range(0, num_faces, &data, create_liquid_geometry_faces_task_cb, &settings);
 
   BKE_mesh_ensure_normals(me);
   BKE_mesh_calc_edges(me, false, false);
@@ -14,6 +14,8 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "BLI_array.hh"
+
 #include "BKE_geometry_set.hh"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
@@ -25,6 +27,7 @@
 
 #include "MEM_guardedalloc.h"
 
+using blender::Array;
 using blender::float3;
 using blender::float4x4;
 using blender::MutableSpan;
@@ -90,6 +93,11 @@ bool GeometryComponent::is_empty() const
   return false;
 }
 
+bool GeometryComponent::owns_direct_data() const
+{
+  return true;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -184,6 +192,17 @@ uint64_t GeometrySet::hash() const
   return reinterpret_cast<uint64_t>(this);
 }
 
+/* Copy the components that reference data owned by someone else, so that the geometry set can be
+ * kept longer than that data, e.g. for caching. */
+void GeometrySet::ensure_owns_direct_data()
+{
+  for (GeometryComponentPtr &component : components_.values()) {
+    if (!component->owns_direct_data()) {
+      component = GeometryComponentPtr{component->copy()};
+    }
+  }
+}
+
 /* Returns a read-only mesh or null. */
 const Mesh *GeometrySet::get_mesh_for_read() const
 {
@@ -384,6 +403,11 @@ bool MeshComponent::is_empty() const
   return mesh_ == nullptr;
 }
 
+bool MeshComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -470,6 +494,11 @@ bool PointCloudComponent::is_empty() const
   return pointcloud_ == nullptr;
 }
 
+bool PointCloudComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -484,14 +513,61 @@ GeometryComponent *InstancesComponent::copy() const
 {
   InstancesComponent *new_component = new InstancesComponent();
   new_component->transforms_ = transforms_;
-  new_component->instanced_data_ = instanced_data_;
+  new_component->ids_ = ids_;
+  new_component->instance_reference_handles_ = instance_reference_handles_;
+  new_component->references_ = references_;
+  new_component->reference_handle_by_data_ = reference_handle_by_data_;
   return new_component;
 }
 
 void InstancesComponent::clear()
 {
-  instanced_data_.clear();
   transforms_.clear();
+  ids_.clear();
+  instance_reference_handles_.clear();
+  references_.clear();
+  reference_handle_by_data_.clear();
+}
+
+void InstancesComponent::reserve(const int amount)
+{
+  transforms_.reserve(amount);
+  ids_.reserve(amount);
+  instance_reference_handles_.reserve(amount);
+}
+
+static const void *instanced_data_key(const InstancedData &data)
+{
+  switch (data.type) {
+    case INSTANCE_DATA_TYPE_OBJECT:
+      return data.data.object;
+    case INSTANCE_DATA_TYPE_COLLECTION:
+      return data.data.collection;
+  }
+  BLI_assert(false);
+  return nullptr;
+}
+
+/**
+ * Returns a handle to the given instanced data, adding it to the references if it is not used by
+ * any instance yet.
+ */
+int InstancesComponent::add_reference(InstancedData data)
+{
+  return reference_handle_by_data_.lookup_or_add_cb(instanced_data_key(data), [&]() {
+    references_.append(data);
+    return references_.size() - 1;
+  });
+}
+
+void InstancesComponent::add_instance(const int reference_handle,
+                                      float4x4 transform,
+                                      const int id)
+{
+  BLI_assert(reference_handle >= 0 && reference_handle < references_.size());
+  instance_reference_handles_.append(reference_handle);
+  transforms_.append(transform);
+  ids_.append(id);
 }
 
 void InstancesComponent::add_instance(Object *object, float4x4 transform, const int id)
@@ -512,14 +588,38 @@ void InstancesComponent::add_instance(Collection *collection, float4x4 transform
 
 void InstancesComponent::add_instance(InstancedData data, float4x4 transform, const int id)
 {
-  instanced_data_.append(data);
-  transforms_.append(transform);
-  ids_.append(id);
+  this->add_instance(this->add_reference(data), transform, id);
+}
+
+void InstancesComponent::add_instances(const InstancesComponent &other)
+{
+  /* Only the references have to be remapped, the per-instance arrays are appended as a whole. */
+  Array<int> handle_map(other.references_.size());
+  for (const int i : other.references_.index_range()) {
+    handle_map[i] = this->add_reference(other.references_[i]);
+  }
+
+  const int old_size = instance_reference_handles_.size();
+  transforms_.extend(other.transforms_);
+  ids_.extend(other.ids_);
+  instance_reference_handles_.resize(old_size + other.instance_reference_handles_.size());
+
+  MutableSpan<int> new_handles = instance_reference_handles_.as_mutable_span().drop_front(
+      old_size);
+  Span<int> other_handles = other.instance_reference_handles_;
+  for (const int i : other_handles.index_range()) {
+    new_handles[i] = handle_map[other_handles[i]];
+  }
 }
 
-Span<InstancedData> InstancesComponent::instanced_data() const
+Span<InstancedData> InstancesComponent::references() const
 {
-  return instanced_data_;
+  return references_;
+}
+
+Span<int> InstancesComponent::instance_reference_handles() const
+{
+  return instance_reference_handles_;
 }
 
 Span<float4x4> InstancesComponent::transforms() const
@@ -539,8 +639,8 @@ MutableSpan<float4x4> InstancesComponent::transforms()
 
 int InstancesComponent::instances_amount() const
 {
-  const int size = instanced_data_.size();
-  BLI_assert(transforms_.size() == size);
+  const int size = transforms_.size();
+  BLI_assert(instance_reference_handles_.size() == size);
   return size;
 }
 
@@ -628,6 +728,11 @@ Volume *VolumeComponent::get_for_write()
   return volume_;
 }
 
+bool VolumeComponent::owns_direct_data() const
+{
+  return ownership_ == GeometryOwnershipType::Owned;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -647,7 +752,8 @@ bool BKE_geometry_set_has_instances(const GeometrySet *geometry_set)
 int BKE_geometry_set_instances(const GeometrySet *geometry_set,
                                float (**r_transforms)[4][4],
                                int **r_ids,
-                               InstancedData **r_instanced_data)
+                               int **r_reference_handles,
+                               InstancedData **r_references)
 {
   const InstancesComponent *component = geometry_set->get_component_for_read<InstancesComponent>();
   if (component == nullptr) {
@@ -655,8 +761,8 @@ int BKE_geometry_set_instances(const GeometrySet *geometry_set,
   }
   *r_transforms = (float(*)[4][4])component->transforms().data();
   *r_ids = (int *)component->ids().data();
-  *r_instanced_data = (InstancedData *)component->instanced_data().data();
-  *r_instanced_data = (InstancedData *)component->instanced_data().data();
+  *r_reference_handles = (int *)component->instance_reference_handles().data();
+  *r_references = (InstancedData *)component->references().data();
   return component->instances_amount();
 }
 
@@ -4015,10 +4015,17 @@ static void image_create_multilayer(Image *ima, ImBuf *ibuf, int framenr)
 
   /* only load rr once for multiview */
   if (!ima->rr) {
+    /* Passes are read from the file when used, the render result keeps the handle. */
+    if (IMB_exr_is_deferred(ibuf->userdata) &&
+        !IMB_exr_open_deferred(ibuf->userdata, ibuf->name)) {
+      printf("%s: failed to open '%s' for reading passes\n", __func__, ibuf->name);
+    }
     ima->rr = RE_MultilayerConvert(ibuf->userdata, colorspace, predivide, ibuf->x, ibuf->y);
   }
 
-  IMB_exr_close(ibuf->userdata);
+  if (ima->rr == NULL || ima->rr->exrhandle != ibuf->userdata) {
+    IMB_exr_close(ibuf->userdata);
+  }
 
   ibuf->userdata = NULL;
   if (ima->rr != NULL) {
@@ -4106,7 +4113,7 @@ static ImBuf *load_sequence_single(
   iuser_t.view = view_id;
   BKE_image_user_file_path(&iuser_t, ima, name);
 
-  flag = IB_rect | IB_multilayer | IB_metadata;
+  flag = IB_rect | IB_multilayer | IB_multilayer_deferred | IB_metadata;
   flag |= imbuf_alpha_flags_for_image(ima);
 
   /* read ibuf */
@@ -4234,6 +4241,7 @@ static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int e
     if (rpass) {
       // printf("load from pass %s\n", rpass->name);
       /* since we free  render results, we copy the rect */
+      RE_pass_ensure_loaded(ima->rr, rpass);
       ibuf = IMB_allocImBuf(ima->rr->rectx, ima->rr->recty, 32, 0);
       ibuf->rect_float = MEM_dupallocN(rpass->rect);
       ibuf->flags |= IB_rectfloat;
@@ -4414,7 +4422,7 @@ static ImBuf *load_image_single(Image *ima,
   else {
     ImageUser iuser_t;
 
-    flag = IB_rect | IB_multilayer | IB_metadata;
+    flag = IB_rect | IB_multilayer | IB_multilayer_deferred | IB_metadata;
     flag |= imbuf_alpha_flags_for_image(ima);
 
     /* get the correct filepath */
@@ -4565,6 +4573,7 @@ static ImBuf *image_get_ibuf_multilayer(Image *ima, ImageUser *iuser)
 
       image_init_after_load(ima, iuser, ibuf);
 
+      RE_pass_ensure_loaded(ima->rr, rpass);
       ibuf->rect_float = rpass->rect;
       ibuf->flags |= IB_rectfloat;
       ibuf->channels = rpass->channels;
@@ -522,11 +522,62 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+/* Keep at least this fraction of the video memory free when the driver reports memory usage. */
+#define IMA_GPU_MEM_FREE_FACTOR_MIN 0.1f
+
+static int image_lastused_cmp(const void *a, const void *b)
+{
+  const Image *ima_a = *(const Image **)a;
+  const Image *ima_b = *(const Image **)b;
+  return (ima_a->lastused > ima_b->lastused) - (ima_a->lastused < ima_b->lastused);
+}
+
+static bool image_gpu_mem_is_over_budget(void)
+{
+  int totalmem, freemem;
+  GPU_mem_stats_get(&totalmem, &freemem);
+  return totalmem > 0 && freemem < totalmem * IMA_GPU_MEM_FREE_FACTOR_MIN;
+}
+
+/**
+ * Free the GPU textures of the least recently used images while the video memory is almost full.
+ * Images used during the last second are kept since they are likely still visible, they will be
+ * recreated on demand anyway.
+ */
+static void image_free_gputextures_over_budget(Main *bmain, const int ctime)
+{
+  if (!GPU_mem_stats_supported() || !image_gpu_mem_is_over_budget()) {
+    return;
+  }
+
+  const int images_len = BLI_listbase_count(&bmain->images);
+  Image **images = MEM_mallocN(sizeof(*images) * images_len, __func__);
+  int unused_len = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    if ((ima->flag & IMA_NOCOLLECT) == 0 && ctime - ima->lastused > 1 &&
+        BKE_image_has_opengl_texture(ima)) {
+      images[unused_len++] = ima;
+    }
+  }
+  qsort(images, unused_len, sizeof(*images), image_lastused_cmp);
+
+  for (int i = 0; i < unused_len && image_gpu_mem_is_over_budget(); i++) {
+    BKE_image_free_gputextures(images[i]);
+  }
+  MEM_freeN(images);
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
+  static int lasttime_budget = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  if (ctime != lasttime_budget && !G.is_rendering) {
+    lasttime_budget = ctime;
+    image_free_gputextures_over_budget(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
@@ -180,6 +180,10 @@ static bool image_save_single(ReportList *reports,
 
   /* we need renderresult for exr and rendered multiview */
   rr = BKE_image_acquire_renderresult(opts->scene, ima);
+  if (rr) {
+    /* Passes of multilayer files are read when used, saving needs all of them. */
+    RE_render_result_ensure_loaded(rr);
+  }
   bool is_mono = rr ? BLI_listbase_count_at_most(&rr->views, 2) < 2 :
                       BLI_listbase_count_at_most(&ima->views, 2) < 2;
   bool is_exr_rr = rr && ELEM(imf->imtype, R_IMF_IMTYPE_OPENEXR, R_IMF_IMTYPE_MULTILAYER) &&
@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -935,8 +936,20 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          weights += start;
+        }
 
         for (b = start; b < end; b += step) {
+          /* Vertex groups often limit a shape to a small part of the mesh, skip the elements
+           * outside of it. Weights are only used for meshes and lattices, with one element each. */
+          if (weights && *weights == 0.0f) {
+            poin += ofs[0];
+            reffrom += elemsize;
+            from += elemsize;
+            weights++;
+            continue;
+          }
 
           weight = weights ? (*weights * icuval) : icuval;
 
@@ -1390,6 +1403,67 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Number of elements blended by each task of #key_evaluate_relative_parallel. */
+#define KEY_EVALUATE_CHUNK_SIZE 4096
+
+typedef struct KeyEvaluateRelativeTaskData {
+  int tot;
+  char *basispoin;
+  Key *key;
+  KeyBlock *actkb;
+  float **per_keyblock_weights;
+} KeyEvaluateRelativeTaskData;
+
+static void key_evaluate_relative_task_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KeyEvaluateRelativeTaskData *data = userdata;
+  const int start = chunk * KEY_EVALUATE_CHUNK_SIZE;
+
+  key_evaluate_relative(start,
+                        start + KEY_EVALUATE_CHUNK_SIZE,
+                        data->tot,
+                        data->basispoin,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
+/**
+ * Blend the relative shape keys of a mesh, split into chunks of vertices evaluated in parallel.
+ */
+static void key_evaluate_relative_parallel(
+    const int tot, char *basispoin, Key *key, KeyBlock *actkb, float **per_keyblock_weights)
+{
+  const Mesh *me = (const Mesh *)key->from;
+
+  /* In edit-mode the coordinates of the active key are copied from the edit-mesh for every call,
+   * see #key_block_get_data. */
+  if (me == NULL || me->edit_mesh != NULL || tot <= KEY_EVALUATE_CHUNK_SIZE) {
+    key_evaluate_relative(
+        0, tot, tot, basispoin, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    return;
+  }
+
+  KeyEvaluateRelativeTaskData data = {
+      .tot = tot,
+      .basispoin = basispoin,
+      .key = key,
+      .actkb = actkb,
+      .per_keyblock_weights = per_keyblock_weights,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0,
+                          (tot + KEY_EVALUATE_CHUNK_SIZE - 1) / KEY_EVALUATE_CHUNK_SIZE,
+                          &data,
+                          key_evaluate_relative_task_cb,
+                          &settings);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1400,8 +1474,7 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    key_evaluate_relative_parallel(tot, (char *)out, key, actkb, per_keyblock_weights);
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -750,16 +750,24 @@ static void layer_collection_sync(ViewLayer *view_layer,
    * For local edits we can make editing operating do the appropriate thing, but for
    * linking we can only sync after the fact. */
 
-  /* Remove layer collections that no longer have a corresponding scene collection. */
+  /* Remove layer collections that no longer have a corresponding scene collection.
+   * Both lists are usually in the same order, only search when the next child doesn't match,
+   * syncing would be quadratic in the number of child collections otherwise. */
+  const CollectionChild *child_next = lb_collections->first;
   LISTBASE_FOREACH_MUTABLE (LayerCollection *, lc, lb_layer_collections) {
     /* Note that ID remap can set lc->collection to NULL when deleting collections. */
-    Collection *collection = (lc->collection) ?
-                                 BLI_findptr(lb_collections,
-                                             lc->collection,
-                                             offsetof(CollectionChild, collection)) :
-                                 NULL;
+    const CollectionChild *child = NULL;
+    if (lc->collection) {
+      if (child_next && child_next->collection == lc->collection) {
+        child = child_next;
+        child_next = child_next->next;
+      }
+      else {
+        child = BLI_findptr(lb_collections, lc->collection, offsetof(CollectionChild, collection));
+      }
+    }
 
-    if (!collection) {
+    if (!child) {
       if (lc == view_layer->active_collection) {
         view_layer->active_collection = NULL;
       }
@@ -775,8 +783,12 @@ static void layer_collection_sync(ViewLayer *view_layer,
 
   LISTBASE_FOREACH (const CollectionChild *, child, lb_collections) {
     Collection *collection = child->collection;
-    LayerCollection *lc = BLI_findptr(
-        lb_layer_collections, collection, offsetof(LayerCollection, collection));
+    /* Matching layer collections are moved to the new list, so when the order didn't change the
+     * match is the first remaining one. */
+    LayerCollection *lc = lb_layer_collections->first;
+    if (lc == NULL || lc->collection != collection) {
+      lc = BLI_findptr(lb_layer_collections, collection, offsetof(LayerCollection, collection));
+    }
 
     if (lc) {
       BLI_remlink(lb_layer_collections, lc);
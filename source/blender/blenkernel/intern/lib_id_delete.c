@@ -28,6 +28,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 
 #include "BKE_anim_data.h"
@@ -262,7 +263,11 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
      * This gives tremendous speed-up when deleting a large amount of IDs from a Main
      * containing thousands of those.
      * This also means that we have to be very careful here, as we by-pass many 'common'
-     * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves. */
+     * processing, hence risking to 'corrupt' at least user counts, if not IDs themselves.
+     * Users of the deleted IDs are found from Main relations, instead of checking the whole
+     * Main database for each of them. Remapping only uses the lists of users, which remain valid
+     * since no ID is freed and no new ID usage is added until the relations are freed. */
+    BKE_main_relations_create(bmain, 0);
     bool keep_looping = true;
     while (keep_looping) {
       ID *id, *id_next;
@@ -281,6 +286,11 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
           if ((id->tag & tag) || (id->lib != NULL && (id->lib->id.tag & tag))) {
             BLI_remlink(lb, id);
             BLI_addtail(&tagged_deleted_ids, id);
+            MainIDRelationsEntry *entry = BLI_ghash_lookup(
+                bmain->relations->relations_from_pointers, id);
+            if (entry != NULL) {
+              entry->tags |= MAINIDRELATIONS_ENTRY_TAGS_NO_MAIN;
+            }
             /* Do not tag as no_main now, we want to unlink it first (lower-level ID management
              * code has some specific handling of 'no main' IDs that would be a problem in that
              * case). */
@@ -312,6 +322,7 @@ static size_t id_delete(Main *bmain, const bool do_tagged_deletion)
         // id->us = 0;  /* Is it actually? */
       }
     }
+    BKE_main_relations_free(bmain);
   }
   else {
     /* First tag all datablocks directly from target lib.
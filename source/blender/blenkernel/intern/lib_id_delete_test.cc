@@ -0,0 +1,111 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_collection.h"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "CLG_log.h"
+
+namespace blender::bke::tests {
+
+class BKE_id_delete_test : public testing::Test {
+ public:
+  Main *bmain;
+  Collection *collection;
+  Mesh *mesh;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    collection = BKE_collection_add(bmain, nullptr, "Collection");
+    mesh = BKE_mesh_add(bmain, "Mesh");
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+  }
+
+  Object *add_object(const char *name)
+  {
+    Object *ob = BKE_object_add_only_object(bmain, OB_MESH, name);
+    ob->data = mesh;
+    id_us_plus(&mesh->id);
+    BKE_collection_object_add(bmain, collection, ob);
+    return ob;
+  }
+};
+
+TEST_F(BKE_id_delete_test, multi_tagged_delete_objects)
+{
+  Object *ob_delete = add_object("Delete");
+  Object *ob_keep = add_object("Keep");
+  const int mesh_users = mesh->id.us;
+
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+  ob_delete->id.tag |= LIB_TAG_DOIT;
+  EXPECT_EQ(BKE_id_multi_tagged_delete(bmain), 1);
+
+  EXPECT_EQ(BLI_listbase_count(&bmain->objects), 1);
+  EXPECT_EQ(bmain->objects.first, ob_keep);
+  EXPECT_EQ(BLI_listbase_count(&collection->gobject), 1);
+  EXPECT_EQ(static_cast<CollectionObject *>(collection->gobject.first)->ob,
+            ob_keep);
+  EXPECT_EQ(mesh->id.us, mesh_users - 1);
+}
+
+TEST_F(BKE_id_delete_test, multi_tagged_delete_never_null_users)
+{
+  add_object("A");
+  add_object("B");
+
+  /* Objects cannot exist without their mesh, they are deleted with it. */
+  BKE_main_id_tag_all(bmain, LIB_TAG_DOIT, false);
+  mesh->id.tag |= LIB_TAG_DOIT;
+  EXPECT_EQ(BKE_id_multi_tagged_delete(bmain), 3);
+
+  EXPECT_TRUE(BLI_listbase_is_empty(&bmain->meshes));
+  EXPECT_TRUE(BLI_listbase_is_empty(&bmain->objects));
+  EXPECT_TRUE(BLI_listbase_is_empty(&collection->gobject));
+}
+
+}  // namespace blender::bke::tests
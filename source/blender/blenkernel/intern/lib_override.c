@@ -1545,13 +1545,20 @@ bool BKE_lib_override_library_main_operations_create(Main *bmain, const bool for
   }
 
   /* Usual pose bones issue, need to be done outside of the threaded process or we may run into
-   * concurrency issues here.
+   * concurrency issues here, since several overrides may share the same reference.
+   * Only the poses of the objects that are going to be checked and of their references are
+   * needed, this runs on every undo push so avoid going over all armatures of the file.
    * Note that calling #BKE_pose_ensure again in thread in
    * #BKE_lib_override_library_operations_create is not a problem then. */
   LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
-    if (ob->type == OB_ARMATURE) {
+    if (ob->type == OB_ARMATURE && ID_IS_OVERRIDE_LIBRARY_REAL(ob) &&
+        (force_auto || (ob->id.tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH)) &&
+        (ob->id.override_library->reference->tag & LIB_TAG_MISSING) == 0) {
+      Object *ob_reference = (Object *)ob->id.override_library->reference;
       BLI_assert(ob->data != NULL);
+      BLI_assert(ob_reference->data != NULL);
       BKE_pose_ensure(bmain, ob, ob->data, true);
+      BKE_pose_ensure(bmain, ob_reference, ob_reference->data, true);
     }
   }
 
@@ -1561,15 +1568,6 @@ bool BKE_lib_override_library_main_operations_create(Main *bmain, const bool for
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (ID_IS_OVERRIDE_LIBRARY_REAL(id) &&
         (force_auto || (id->tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH))) {
-      /* Usual issue with pose, it's quiet rare but sometimes they may not be up to date when this
-       * function is called. */
-      if (GS(id->name) == ID_OB) {
-        Object *ob = (Object *)id;
-        if (ob->type == OB_ARMATURE) {
-          BLI_assert(ob->data != NULL);
-          BKE_pose_ensure(bmain, ob, ob->data, true);
-        }
-      }
       /* Only check overrides if we do have the real reference data available, and not some empty
        * 'placeholder' for missing data (broken links). */
       if ((id->override_library->reference->tag & LIB_TAG_MISSING) == 0) {
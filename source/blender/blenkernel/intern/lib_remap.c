@@ -24,6 +24,8 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_ghash.h"
+
 #include "DNA_collection_types.h"
 #include "DNA_object_types.h"
 
@@ -346,6 +348,56 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id);
 }
 
+/**
+ * Get the ID in Main owning \a id, going up through embedded IDs (root node-trees, master
+ * collections...) which only have their owner as user.
+ * Returns NULL if the owner cannot be found, or if it is not part of Main anymore.
+ */
+static ID *libblock_remap_relations_owner_get(MainIDRelations *relations, ID *id)
+{
+  while (id != NULL) {
+    MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, id);
+    if (entry == NULL || (entry->tags & MAINIDRELATIONS_ENTRY_TAGS_NO_MAIN)) {
+      return NULL;
+    }
+    if ((id->flag & LIB_EMBEDDED_DATA) == 0) {
+      return id;
+    }
+    ID *id_owner = NULL;
+    for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+         from_id_entry = from_id_entry->next) {
+      if (from_id_entry->usage_flag & IDWALK_CB_EMBEDDED) {
+        id_owner = from_id_entry->id_pointer.from;
+        break;
+      }
+    }
+    id = id_owner;
+  }
+  return NULL;
+}
+
+/**
+ * Collect the IDs from Main using \a old_id, from the cached \a relations.
+ * Returns NULL if \a old_id was added after the relations were built.
+ */
+static GSet *libblock_remap_relations_users_get(MainIDRelations *relations, ID *old_id)
+{
+  MainIDRelationsEntry *entry = BLI_ghash_lookup(relations->relations_from_pointers, old_id);
+  if (entry == NULL) {
+    return NULL;
+  }
+
+  GSet *id_users = BLI_gset_ptr_new(__func__);
+  for (MainIDRelationsEntryItem *from_id_entry = entry->from_ids; from_id_entry != NULL;
+       from_id_entry = from_id_entry->next) {
+    ID *id_owner = libblock_remap_relations_owner_get(relations, from_id_entry->id_pointer.from);
+    if (id_owner != NULL) {
+      BLI_gset_add(id_users, id_owner);
+    }
+  }
+  return id_users;
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -353,7 +405,8 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
  * - \a id NULL: \a old_id must be non-NULL, \a new_id may be NULL (unlinking \a old_id) or not
  *   (remapping \a old_id to \a new_id).
  *   The whole \a bmain database is checked, and all pointers to \a old_id
- *   are remapped to \a new_id.
+ *   are remapped to \a new_id. When \a bmain has relations, only the users of \a old_id
+ *   are checked.
  * - \a id is non-NULL:
  *   + If \a old_id is NULL, \a new_id must also be NULL,
  *     and all ID pointers from \a id are cleared
@@ -376,6 +429,7 @@ static void libblock_remap_data(
   const int foreach_id_flags = (remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
                                    IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
                                    IDWALK_NOP;
+  GSet *id_users;
 
   if (r_id_remap_data == NULL) {
     r_id_remap_data = &id_remap_data;
@@ -399,6 +453,21 @@ static void libblock_remap_data(
     BKE_library_foreach_ID_link(
         NULL, id, foreach_libblock_remap_callback, (void *)r_id_remap_data, foreach_id_flags);
   }
+  else if (bmain->relations != NULL &&
+           (id_users = libblock_remap_relations_users_get(bmain->relations, old_id)) != NULL) {
+    /* Main->relations is assumed valid by code using it, see #BKE_library_foreach_ID_link. */
+    GSET_FOREACH_BEGIN (ID *, id_curr, id_users) {
+      r_id_remap_data->id_owner = id_curr;
+      libblock_remap_data_preprocess(r_id_remap_data);
+      BKE_library_foreach_ID_link(NULL,
+                                  id_curr,
+                                  foreach_libblock_remap_callback,
+                                  (void *)r_id_remap_data,
+                                  foreach_id_flags);
+    }
+    GSET_FOREACH_END();
+    BLI_gset_free(id_users, NULL);
+  }
   else {
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
@@ -268,9 +268,16 @@ void BKE_main_relations_create(Main *bmain, const short flag)
     BKE_main_relations_free(bmain);
   }
 
+  /* Every ID gets an entry, avoid growing the hash while adding them. */
+  ListBase *lbarray[MAX_LIBARRAY];
+  int ids_len = 0;
+  for (int a = set_listbasepointers(bmain, lbarray); a--;) {
+    ids_len += BLI_listbase_count(lbarray[a]);
+  }
+
   bmain->relations = MEM_mallocN(sizeof(*bmain->relations), __func__);
-  bmain->relations->relations_from_pointers = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+  bmain->relations->relations_from_pointers = BLI_ghash_new_ex(
+      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__, (uint)ids_len);
   bmain->relations->entry_items_pool = BLI_mempool_create(
       sizeof(MainIDRelationsEntryItem), 128, 128, BLI_MEMPOOL_NOP);
 
@@ -208,6 +208,9 @@ struct MaskRasterHandle {
 
   /* 2d bounds (to quickly skip bucket lookup) */
   rctf bounds;
+
+  /* When no layer is inverted, everything outside of the bounds is zero. */
+  bool use_bounds_clip;
 };
 
 /* --------------------------------------------------------------------- */
@@ -1221,6 +1224,16 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
   }
 
   BLI_memarena_free(sf_arena);
+
+  /* Outside of all layer bounds every layer value is zero, no blend mode changes a zero value
+   * unless the layer is inverted. */
+  mr_handle->use_bounds_clip = true;
+  for (uint i = 0; i < mr_handle->layers_tot; i++) {
+    if (mr_handle->layers[i].blend_flag & MASK_BLENDFLAG_INVERT) {
+      mr_handle->use_bounds_clip = false;
+      break;
+    }
+  }
 }
 
 /* --------------------------------------------------------------------- */
@@ -1347,8 +1360,10 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
 
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
 {
-  /* can't do this because some layers may invert */
-  /* if (BLI_rctf_isect_pt_v(&mr_handle->bounds, xy)) */
+  /* can't do this when some layers invert */
+  if (mr_handle->use_bounds_clip && !BLI_rctf_isect_pt_v(&mr_handle->bounds, xy)) {
+    return 0.0f;
+  }
 
   const unsigned int layers_tot = mr_handle->layers_tot;
   MaskRasterLayer *layer = mr_handle->layers;
@@ -1467,6 +1482,13 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   uint i = (uint)y * width;
   float xy[2];
   xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
+
+  if (mr_handle->use_bounds_clip &&
+      (xy[1] < mr_handle->bounds.ymin || xy[1] > mr_handle->bounds.ymax)) {
+    copy_vn_fl(&buffer[i], (int)width, 0.0f);
+    return;
+  }
+
   for (uint x = 0; x < width; x++, i++) {
     xy[0] = ((float)x * x_inv) + x_px_ofs;
 
@@ -820,111 +820,141 @@ typedef struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
-static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
-                                 const bool check_angle,
-                                 const float split_angle,
-                                 const bool do_sharp_edges_tag)
-{
-  const MVert *mverts = data->mverts;
-  const MEdge *medges = data->medges;
-  const MLoop *mloops = data->mloops;
-
-  const MPoly *mpolys = data->mpolys;
-
-  const int numEdges = data->numEdges;
-  const int numPolys = data->numPolys;
+/* Number of polys or edges handled by each thread when tagging sharp edges. */
+#define EDGES_SHARP_TAG_MIN_ITER_PER_THREAD 1024
+
+typedef struct EdgesSharpTagData {
+  LoopSplitTaskDataCommon *common_data;
+  /** Edges used by more than two loops, always sharp. */
+  const BLI_bitmap *non_manifold_edges;
+  float split_angle_cos;
+  bool check_angle;
+  bool do_sharp_edges_tag;
+} EdgesSharpTagData;
+
+static void mesh_loops_poly_map_cb(void *__restrict userdata,
+                                   const int mp_index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *data = userdata;
+  const MPoly *mp = &data->mpolys[mp_index];
+  const int ml_index_end = mp->loopstart + mp->totloop;
+
+  for (int ml_index = mp->loopstart; ml_index < ml_index_end; ml_index++) {
+    data->loop_to_poly[ml_index] = mp_index;
+
+    /* Pre-populate all loop normals as if their verts were all-smooth,
+     * this way we don't have to compute those later!
+     */
+    if (data->loopnors) {
+      normal_short_to_float_v3(data->loopnors[ml_index],
+                               data->mverts[data->mloops[ml_index].v].no);
+    }
+  }
+}
 
-  float(*loopnors)[3] = data->loopnors; /* Note: loopnors may be NULL here. */
-  const float(*polynors)[3] = data->polynors;
+static void mesh_edges_sharp_tag_cb(void *__restrict userdata,
+                                    const int me_index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const EdgesSharpTagData *tag_data = userdata;
+  LoopSplitTaskDataCommon *data = tag_data->common_data;
+  int *e2l = data->edge_to_loops[me_index];
 
-  int(*edge_to_loops)[2] = data->edge_to_loops;
-  int *loop_to_poly = data->loop_to_poly;
+  if ((e2l[0] | e2l[1]) == 0) {
+    /* Loose edge. */
+    return;
+  }
 
-  BLI_bitmap *sharp_edges = do_sharp_edges_tag ? BLI_BITMAP_NEW(numEdges, __func__) : NULL;
+  const MPoly *mpolys = data->mpolys;
+  const int mp_index_first = data->loop_to_poly[e2l[0]];
 
-  const MPoly *mp;
-  int mp_index;
+  /* We have to check this here too, else we might miss some flat faces!!! */
+  if (!(mpolys[mp_index_first].flag & ME_SMOOTH)) {
+    e2l[1] = INDEX_INVALID;
+    return;
+  }
+  if (e2l[1] == INDEX_UNSET) {
+    /* Only used by one loop. */
+    return;
+  }
 
-  const float split_angle_cos = check_angle ? cosf(split_angle) : -1.0f;
+  const MLoop *mloops = data->mloops;
+  const int mp_index = data->loop_to_poly[e2l[1]];
+  const bool is_angle_sharp = (tag_data->check_angle &&
+                               dot_v3v3(data->polynors[mp_index_first],
+                                        data->polynors[mp_index]) < tag_data->split_angle_cos);
+
+  /* Test the sharpness of the edge using its first two loops.
+   * An edge is sharp if it is tagged as such, or its face is not smooth,
+   * or both poly have opposed (flipped) normals, i.e. both loops on the same edge share the
+   * same vertex, or angle between both its polys' normals is above split_angle value.
+   * More than two loops using this edge always make it sharp.
+   */
+  MEdge *me = (MEdge *)&data->medges[me_index];
+  if (!(mpolys[mp_index].flag & ME_SMOOTH) || (me->flag & ME_SHARP) ||
+      mloops[e2l[1]].v == mloops[e2l[0]].v || is_angle_sharp ||
+      BLI_BITMAP_TEST(tag_data->non_manifold_edges, me_index)) {
+    e2l[1] = INDEX_INVALID;
 
-  for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
-    const MLoop *ml_curr;
-    int *e2l;
-    int ml_curr_index = mp->loopstart;
-    const int ml_last_index = (ml_curr_index + mp->totloop) - 1;
+    /* We want to avoid tagging edges as sharp when it is already defined as such by
+     * other causes than angle threshold... */
+    if (tag_data->do_sharp_edges_tag && is_angle_sharp) {
+      me->flag |= ME_SHARP;
+    }
+  }
+}
 
-    ml_curr = &mloops[ml_curr_index];
+static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
+                                 const bool check_angle,
+                                 const float split_angle,
+                                 const bool do_sharp_edges_tag)
+{
+  const MLoop *mloops = data->mloops;
+  int(*edge_to_loops)[2] = data->edge_to_loops;
+  BLI_bitmap *non_manifold_edges = BLI_BITMAP_NEW(data->numEdges, __func__);
 
-    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
-      e2l = edge_to_loops[ml_curr->e];
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = EDGES_SHARP_TAG_MIN_ITER_PER_THREAD;
 
-      loop_to_poly[ml_curr_index] = mp_index;
+  /* Note: loopnors may be NULL here. */
+  BLI_task_parallel_range(0, data->numPolys, data, mesh_loops_poly_map_cb, &settings);
 
-      /* Pre-populate all loop normals as if their verts were all-smooth,
-       * this way we don't have to compute those later!
-       */
-      if (loopnors) {
-        normal_short_to_float_v3(loopnors[ml_curr_index], mverts[ml_curr->v].no);
-      }
+  /* Find the first two loops using each edge. Only this is done serially, the sharpness of the
+   * edges is checked in parallel once all their loops are known. */
+  const MPoly *mp = data->mpolys;
+  for (int mp_index = 0; mp_index < data->numPolys; mp++, mp_index++) {
+    const int ml_index_end = mp->loopstart + mp->totloop;
+    for (int ml_index = mp->loopstart; ml_index < ml_index_end; ml_index++) {
+      const uint me_index = mloops[ml_index].e;
+      int *e2l = edge_to_loops[me_index];
 
-      /* Check whether current edge might be smooth or sharp */
       if ((e2l[0] | e2l[1]) == 0) {
         /* 'Empty' edge until now, set e2l[0] (and e2l[1] to INDEX_UNSET to tag it as unset). */
-        e2l[0] = ml_curr_index;
-        /* We have to check this here too, else we might miss some flat faces!!! */
-        e2l[1] = (mp->flag & ME_SMOOTH) ? INDEX_UNSET : INDEX_INVALID;
+        e2l[0] = ml_index;
+        e2l[1] = INDEX_UNSET;
       }
       else if (e2l[1] == INDEX_UNSET) {
-        const bool is_angle_sharp = (check_angle &&
-                                     dot_v3v3(polynors[loop_to_poly[e2l[0]]], polynors[mp_index]) <
-                                         split_angle_cos);
-
-        /* Second loop using this edge, time to test its sharpness.
-         * An edge is sharp if it is tagged as such, or its face is not smooth,
-         * or both poly have opposed (flipped) normals, i.e. both loops on the same edge share the
-         * same vertex, or angle between both its polys' normals is above split_angle value.
-         */
-        if (!(mp->flag & ME_SMOOTH) || (medges[ml_curr->e].flag & ME_SHARP) ||
-            ml_curr->v == mloops[e2l[0]].v || is_angle_sharp) {
-          /* Note: we are sure that loop != 0 here ;) */
-          e2l[1] = INDEX_INVALID;
-
-          /* We want to avoid tagging edges as sharp when it is already defined as such by
-           * other causes than angle threshold... */
-          if (do_sharp_edges_tag && is_angle_sharp) {
-            BLI_BITMAP_SET(sharp_edges, ml_curr->e, true);
-          }
-        }
-        else {
-          e2l[1] = ml_curr_index;
-        }
+        /* Note: we are sure that loop != 0 here ;) */
+        e2l[1] = ml_index;
       }
-      else if (!IS_EDGE_SHARP(e2l)) {
-        /* More than two loops using this edge, tag as sharp if not yet done. */
-        e2l[1] = INDEX_INVALID;
-
-        /* We want to avoid tagging edges as sharp when it is already defined as such by
-         * other causes than angle threshold... */
-        if (do_sharp_edges_tag) {
-          BLI_BITMAP_SET(sharp_edges, ml_curr->e, false);
-        }
+      else {
+        BLI_BITMAP_ENABLE(non_manifold_edges, me_index);
       }
-      /* Else, edge is already 'disqualified' (i.e. sharp)! */
     }
   }
 
-  /* If requested, do actual tagging of edges as sharp in another loop. */
-  if (do_sharp_edges_tag) {
-    MEdge *me;
-    int me_index;
-    for (me = (MEdge *)medges, me_index = 0; me_index < numEdges; me++, me_index++) {
-      if (BLI_BITMAP_TEST(sharp_edges, me_index)) {
-        me->flag |= ME_SHARP;
-      }
-    }
+  EdgesSharpTagData tag_data = {
+      .common_data = data,
+      .non_manifold_edges = non_manifold_edges,
+      .split_angle_cos = check_angle ? cosf(split_angle) : -1.0f,
+      .check_angle = check_angle,
+      .do_sharp_edges_tag = do_sharp_edges_tag,
+  };
+  BLI_task_parallel_range(0, data->numEdges, &tag_data, mesh_edges_sharp_tag_cb, &settings);
 
-    MEM_freeN(sharp_edges);
-  }
+  MEM_freeN(non_manifold_edges);
 }
 
 /**
@@ -115,6 +115,102 @@ static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
   return false;
 }
 
+/**
+ * Coordinates of the destination vertices converted to tree coordinates, if needed.
+ * Optionally also the converted vertex normals.
+ */
+static float (*mesh_remap_verts_dst_coords_alloc(const MVert *verts_dst,
+                                                 const int numverts_dst,
+                                                 const SpaceTransform *space_transform,
+                                                 float (**r_nors)[3]))[3]
+{
+  float(*cos)[3] = MEM_mallocN(sizeof(*cos) * (size_t)numverts_dst, __func__);
+  float(*nors)[3] = r_nors ? MEM_mallocN(sizeof(*nors) * (size_t)numverts_dst, __func__) : NULL;
+
+  for (int i = 0; i < numverts_dst; i++) {
+    copy_v3_v3(cos[i], verts_dst[i].co);
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, cos[i]);
+    }
+    if (nors) {
+      normal_short_to_float_v3(nors[i], verts_dst[i].no);
+      if (space_transform) {
+        BLI_space_transform_apply_normal(space_transform, nors[i]);
+      }
+    }
+  }
+
+  if (r_nors) {
+    *r_nors = nors;
+  }
+  return cos;
+}
+
+/**
+ * Same as #mesh_remap_bvhtree_query_nearest for many coordinates at once, the queries run in
+ * parallel. Items that are not found have an index of -1.
+ */
+static BVHTreeNearest *mesh_remap_bvhtree_query_nearest_batch(BVHTreeFromMesh *treedata,
+                                                              const float (*cos)[3],
+                                                              const int cos_num,
+                                                              const float max_dist_sq)
+{
+  BVHTreeNearest *nearests = MEM_mallocN(sizeof(*nearests) * (size_t)cos_num, __func__);
+
+  for (int i = 0; i < cos_num; i++) {
+    nearests[i].index = -1;
+    nearests[i].dist_sq = max_dist_sq;
+  }
+  BLI_bvhtree_find_nearest_batch(
+      treedata->tree, cos, cos_num, nearests, treedata->nearest_callback, treedata);
+
+  return nearests;
+}
+
+/**
+ * Same as #mesh_remap_bvhtree_query_raycast for many rays at once, the rays are cast in
+ * parallel. Items that are not hit have an index of -1.
+ */
+static BVHTreeRayHit *mesh_remap_bvhtree_query_raycast_batch(BVHTreeFromMesh *treedata,
+                                                             const float (*cos)[3],
+                                                             const float (*nos)[3],
+                                                             const int cos_num,
+                                                             const float radius,
+                                                             const float max_dist)
+{
+  BVHTreeRayHit *rayhits = MEM_mallocN(sizeof(*rayhits) * (size_t)cos_num * 2, __func__);
+  BVHTreeRayHit *rayhits_inv = rayhits + cos_num;
+  float(*inv_nos)[3] = MEM_mallocN(sizeof(*inv_nos) * (size_t)cos_num, __func__);
+
+  for (int i = 0; i < cos_num; i++) {
+    rayhits[i].index = -1;
+    rayhits[i].dist = max_dist;
+    rayhits_inv[i] = rayhits[i];
+    negate_v3_v3(inv_nos[i], nos[i]);
+  }
+  BLI_bvhtree_ray_cast_batch(
+      treedata->tree, cos, nos, cos_num, radius, rayhits, treedata->raycast_callback, treedata);
+
+  /* Also cast in the other direction! */
+  BLI_bvhtree_ray_cast_batch(treedata->tree,
+                             cos,
+                             (const float(*)[3])inv_nos,
+                             cos_num,
+                             radius,
+                             rayhits_inv,
+                             treedata->raycast_callback,
+                             treedata);
+
+  for (int i = 0; i < cos_num; i++) {
+    if (rayhits_inv[i].dist < rayhits[i].dist) {
+      rayhits[i] = rayhits_inv[i];
+    }
+  }
+
+  MEM_freeN(inv_nos);
+  return rayhits;
+}
+
 /** \} */
 
 /**
@@ -526,47 +622,47 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
     BVHTreeNearest nearest = {0};
     BVHTreeRayHit rayhit = {0};
     float hit_dist;
-    float tmp_co[3], tmp_no[3];
+    float tmp_co[3];
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+      float(*cos_dst)[3] = mesh_remap_verts_dst_coords_alloc(
+          verts_dst, numverts_dst, space_transform, NULL);
+      BVHTreeNearest *nearests = mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+      for (i = 0; i < numverts_dst; i++) {
+        if (nearests[i].index != -1) {
+          hit_dist = sqrtf(nearests[i].dist_sq);
+          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearests[i].index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(nearests);
+      MEM_freeN(cos_dst);
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
 
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
+      float(*cos_dst)[3] = mesh_remap_verts_dst_coords_alloc(
+          verts_dst, numverts_dst, space_transform, NULL);
+      BVHTreeNearest *nearests = mesh_remap_bvhtree_query_nearest_batch(
+          &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq);
 
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+      for (i = 0; i < numverts_dst; i++) {
+        copy_v3_v3(tmp_co, cos_dst[i]);
+        nearest = nearests[i];
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
+        if (nearest.index != -1) {
+          hit_dist = sqrtf(nearest.dist_sq);
           MEdge *me = &edges_src[nearest.index];
           const float *v1cos = vcos_src[me->v1];
           const float *v2cos = vcos_src[me->v2];
@@ -598,6 +694,8 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
         }
       }
 
+      MEM_freeN(nearests);
+      MEM_freeN(cos_dst);
       MEM_freeN(vcos_src);
     }
     else if (ELEM(mode,
@@ -616,18 +714,22 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
 
       if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
+        float(*nos_dst)[3];
+        float(*cos_dst)[3] = mesh_remap_verts_dst_coords_alloc(
+            verts_dst, numverts_dst, space_transform, &nos_dst);
+        BVHTreeRayHit *rayhits = mesh_remap_bvhtree_query_raycast_batch(
+            &treedata,
+            (const float(*)[3])cos_dst,
+            (const float(*)[3])nos_dst,
+            numverts_dst,
+            ray_radius,
+            max_dist);
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
-          }
+        for (i = 0; i < numverts_dst; i++) {
+          rayhit = rayhits[i];
 
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
+          if (rayhit.index != -1) {
+            hit_dist = rayhit.dist;
             const MLoopTri *lt = &treedata.looptri[rayhit.index];
             MPoly *mp_src = &polys_src[lt->poly];
             const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
@@ -649,20 +751,22 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             BKE_mesh_remap_item_define_invalid(r_map, i);
           }
         }
+
+        MEM_freeN(rayhits);
+        MEM_freeN(nos_dst);
+        MEM_freeN(cos_dst);
       }
       else {
-        nearest.index = -1;
+        float(*cos_dst)[3] = mesh_remap_verts_dst_coords_alloc(
+            verts_dst, numverts_dst, space_transform, NULL);
+        BVHTreeNearest *nearests = mesh_remap_bvhtree_query_nearest_batch(
+            &treedata, (const float(*)[3])cos_dst, numverts_dst, max_dist_sq);
 
         for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+          nearest = nearests[i];
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
+          if (nearest.index != -1) {
+            hit_dist = sqrtf(nearest.dist_sq);
             const MLoopTri *lt = &treedata.looptri[nearest.index];
             MPoly *mp = &polys_src[lt->poly];
 
@@ -703,6 +807,9 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             BKE_mesh_remap_item_define_invalid(r_map, i);
           }
         }
+
+        MEM_freeN(nearests);
+        MEM_freeN(cos_dst);
       }
 
       MEM_freeN(vcos_src);
@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -314,13 +315,82 @@ Mesh *BKE_mesh_remesh_voxel_to_mesh_nomain(Mesh *mesh,
   return new_mesh;
 }
 
+typedef struct RemeshReprojectData {
+  BVHTreeFromMesh *bvhtree;
+  const MVert *target_verts;
+  const MPoly *target_polys;
+  const MLoop *target_loops;
+  /* Index of the nearest source element of each target element, -1 when none is found. */
+  int *r_nearest_index;
+} RemeshReprojectData;
+
+static void remesh_reproject_nearest_vert_task_cb(void *__restrict userdata,
+                                                  const int i,
+                                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RemeshReprojectData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(
+      bvhtree->tree, data->target_verts[i].co, &nearest, bvhtree->nearest_callback, bvhtree);
+  data->r_nearest_index[i] = nearest.index;
+}
+
+static void remesh_reproject_nearest_poly_task_cb(void *__restrict userdata,
+                                                  const int i,
+                                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RemeshReprojectData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+  float from_co[3];
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  const MPoly *mpoly = &data->target_polys[i];
+  BKE_mesh_calc_poly_center(
+      mpoly, &data->target_loops[mpoly->loopstart], data->target_verts, from_co);
+  BLI_bvhtree_find_nearest(bvhtree->tree, from_co, &nearest, bvhtree->nearest_callback, bvhtree);
+  data->r_nearest_index[i] = nearest.index;
+}
+
+/**
+ * Find the nearest element of \a bvhtree for every vertex or polygon of \a target in parallel.
+ * \return an array of indices, -1 where nothing was found.
+ */
+static int *remesh_reproject_nearest_index(BVHTreeFromMesh *bvhtree,
+                                           Mesh *target,
+                                           const bool use_polys)
+{
+  const int len = use_polys ? target->totpoly : target->totvert;
+  RemeshReprojectData data = {
+      .bvhtree = bvhtree,
+      .target_verts = CustomData_get_layer(&target->vdata, CD_MVERT),
+      .target_polys = CustomData_get_layer(&target->pdata, CD_MPOLY),
+      .target_loops = CustomData_get_layer(&target->ldata, CD_MLOOP),
+      .r_nearest_index = MEM_malloc_arrayN(len, sizeof(int), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0,
+                          len,
+                          &data,
+                          use_polys ? remesh_reproject_nearest_poly_task_cb :
+                                      remesh_reproject_nearest_vert_task_cb,
+                          &settings);
+
+  return data.r_nearest_index;
+}
+
 void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
       .nearest_callback = NULL,
   };
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_VERTS, 2);
-  MVert *target_verts = CustomData_get_layer(&target->vdata, CD_MVERT);
 
   float *target_mask;
   if (CustomData_has_layer(&target->vdata, CD_PAINT_MASK)) {
@@ -340,17 +410,13 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, NULL, source->totvert);
   }
 
+  int *nearest_index = remesh_reproject_nearest_index(&bvhtree, target, false);
   for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
+    if (nearest_index[i] != -1) {
+      target_mask[i] = source_mask[nearest_index[i]];
     }
   }
+  MEM_freeN(nearest_index);
   free_bvhtree_from_mesh(&bvhtree);
 }
 
@@ -360,10 +426,6 @@ void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
       .nearest_callback = NULL,
   };
 
-  const MPoly *target_polys = CustomData_get_layer(&target->pdata, CD_MPOLY);
-  const MVert *target_verts = CustomData_get_layer(&target->vdata, CD_MVERT);
-  const MLoop *target_loops = CustomData_get_layer(&target->ldata, CD_MLOOP);
-
   int *target_face_sets;
   if (CustomData_has_layer(&target->pdata, CD_SCULPT_FACE_SETS)) {
     target_face_sets = CustomData_get_layer(&target->pdata, CD_SCULPT_FACE_SETS);
@@ -385,32 +447,33 @@ void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(source);
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_LOOPTRI, 2);
 
+  int *nearest_index = remesh_reproject_nearest_index(&bvhtree, target, true);
   for (int i = 0; i < target->totpoly; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    const MPoly *mpoly = &target_polys[i];
-    BKE_mesh_calc_poly_center(mpoly, &target_loops[mpoly->loopstart], target_verts, from_co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_face_sets[i] = source_face_sets[looptri[nearest.index].poly];
+    if (nearest_index[i] != -1) {
+      target_face_sets[i] = source_face_sets[looptri[nearest_index[i]].poly];
     }
     else {
       target_face_sets[i] = 1;
     }
   }
+  MEM_freeN(nearest_index);
   free_bvhtree_from_mesh(&bvhtree);
 }
 
 void BKE_remesh_reproject_vertex_paint(Mesh *target, Mesh *source)
 {
+  int tot_color_layer = CustomData_number_of_layers(&source->vdata, CD_PROP_COLOR);
+  if (tot_color_layer == 0) {
+    return;
+  }
+
   BVHTreeFromMesh bvhtree = {
       .nearest_callback = NULL,
   };
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_VERTS, 2);
 
-  int tot_color_layer = CustomData_number_of_layers(&source->vdata, CD_PROP_COLOR);
+  /* The nearest vertices are the same for all layers. */
+  int *nearest_index = remesh_reproject_nearest_index(&bvhtree, target, false);
 
   for (int layer_n = 0; layer_n < tot_color_layer; layer_n++) {
     const char *layer_name = CustomData_get_layer_name(&source->vdata, CD_PROP_COLOR, layer_n);
@@ -418,19 +481,14 @@ void BKE_remesh_reproject_vertex_paint(Mesh *target, Mesh *source)
         &target->vdata, CD_PROP_COLOR, CD_CALLOC, NULL, target->totvert, layer_name);
 
     MPropCol *target_color = CustomData_get_layer_n(&target->vdata, CD_PROP_COLOR, layer_n);
-    MVert *target_verts = CustomData_get_layer(&target->vdata, CD_MVERT);
     MPropCol *source_color = CustomData_get_layer_n(&source->vdata, CD_PROP_COLOR, layer_n);
     for (int i = 0; i < target->totvert; i++) {
-      BVHTreeNearest nearest;
-      nearest.index = -1;
-      nearest.dist_sq = FLT_MAX;
-      BLI_bvhtree_find_nearest(
-          bvhtree.tree, target_verts[i].co, &nearest, bvhtree.nearest_callback, &bvhtree);
-      if (nearest.index != -1) {
-        copy_v4_v4(target_color[i].color, source_color[nearest.index].color);
+      if (nearest_index[i] != -1) {
+        copy_v4_v4(target_color[i].color, source_color[nearest_index[i]].color);
       }
     }
   }
+  MEM_freeN(nearest_index);
   free_bvhtree_from_mesh(&bvhtree);
 }
 
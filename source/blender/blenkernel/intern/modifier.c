@@ -50,6 +50,7 @@
 
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_path_util.h"
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
@@ -1034,6 +1035,17 @@ static void modwrap_dependsOnNormals(Mesh *me)
   }
 }
 
+/**
+ * Free the temporary memory of the modifier that was just evaluated, see
+ * #BKE_modifier_temp_alloc.
+ */
+static void modwrap_temp_clear(const ModifierEvalContext *ctx)
+{
+  if (ctx->memarena) {
+    BLI_memarena_clear(ctx->memarena);
+  }
+}
+
 /* wrapper around ModifierTypeInfo.modifyMesh that ensures valid normals */
 
 struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
@@ -1052,7 +1064,9 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+  Mesh *result = mti->modifyMesh(md, ctx, me);
+  modwrap_temp_clear(ctx);
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1068,6 +1082,7 @@ void BKE_modifier_deform_verts(ModifierData *md,
     modwrap_dependsOnNormals(me);
   }
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  modwrap_temp_clear(ctx);
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1084,6 +1099,32 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
     BKE_mesh_calc_normals(me);
   }
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
+  modwrap_temp_clear(ctx);
+}
+
+/**
+ * Allocate memory that is only used while the modifier is evaluated, like buffers for each
+ * element. This avoids many small allocations when evaluating the modifier stack, where the
+ * memory is taken from #ModifierEvalContext.memarena and freed all at once afterwards.
+ * Must be freed with #BKE_modifier_temp_free.
+ *
+ * \note This is not thread-safe, don't call it from parallel callbacks of the modifier.
+ * Allocate the memory needed by all threads up-front instead.
+ * Freeing doesn't return memory to the arena, so avoid allocating inside loops too.
+ */
+void *BKE_modifier_temp_alloc(const ModifierEvalContext *ctx, size_t size, const char *name)
+{
+  if (ctx->memarena) {
+    return BLI_memarena_alloc(ctx->memarena, size);
+  }
+  return MEM_mallocN(size, name);
+}
+
+void BKE_modifier_temp_free(const ModifierEvalContext *ctx, void *ptr)
+{
+  if (ctx->memarena == NULL) {
+    MEM_freeN(ptr);
+  }
 }
 
 /* end modifier callback wrappers */
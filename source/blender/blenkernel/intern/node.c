@@ -584,6 +584,8 @@ void ntreeBlendReadData(BlendDataReader *reader, bNodeTree *ntree)
   BLO_read_list(reader, &ntree->nodes);
   LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
     node->typeinfo = NULL;
+    node->exec_time = 0.0f;
+    node->exec_memory = 0.0f;
 
     BLO_read_list(reader, &node->inputs);
     BLO_read_list(reader, &node->outputs);
@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utf8.h"
 
 #include "BLI_alloca.h"
@@ -85,11 +86,22 @@ typedef struct DupliContext {
   int level;
 
   const struct DupliGenerator *gen;
+  /** Hash of the name of #object, used for the random ID of its duplis. */
+  uint object_name_hash;
 
   /** Result containers. */
-  ListBase *duplilist; /* Legacy doubly-linked list. */
+  struct DupliList *duplilist;
 } DupliContext;
 
+/**
+ * Returned as a #ListBase of #DupliObject, which is the first member so that the list can be used
+ * directly. The objects are allocated from the arena, so that the whole list is freed at once.
+ */
+typedef struct DupliList {
+  ListBase list; /* Legacy doubly-linked list. */
+  MemArena *arena;
+} DupliList;
+
 typedef struct DupliGenerator {
   short type; /* Dupli Type, see members of #OB_DUPLI. */
   void (*make_duplis)(const DupliContext *ctx);
@@ -122,6 +134,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->level = 0;
 
   r_ctx->gen = get_dupli_generator(r_ctx);
+  r_ctx->object_name_hash = r_ctx->gen ? BLI_hash_string(ob->id.name + 2) : 0;
 
   r_ctx->duplilist = NULL;
 }
@@ -148,6 +161,7 @@ static void copy_dupli_context(
   ++r_ctx->level;
 
   r_ctx->gen = get_dupli_generator(r_ctx);
+  r_ctx->object_name_hash = r_ctx->gen ? BLI_hash_string(ob->id.name + 2) : 0;
 }
 
 /**
@@ -165,8 +179,8 @@ static DupliObject *make_dupli(const DupliContext *ctx,
 
   /* Add a #DupliObject instance to the result container. */
   if (ctx->duplilist) {
-    dob = MEM_callocN(sizeof(DupliObject), "dupli object");
-    BLI_addtail(ctx->duplilist, dob);
+    dob = BLI_memarena_calloc(ctx->duplilist->arena, sizeof(DupliObject));
+    BLI_addtail(&ctx->duplilist->list, dob);
   }
   else {
     return NULL;
@@ -210,7 +224,7 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->object->id.name + 2));
+    dob->random_id ^= BLI_hash_int(ctx->object_name_hash);
   }
 
   return dob;
@@ -815,12 +829,16 @@ static void make_duplis_instances_component(const DupliContext *ctx)
 {
   float(*instance_offset_matrices)[4][4];
   int *ids;
-  InstancedData *instanced_data;
-  const int amount = BKE_geometry_set_instances(
-      ctx->object->runtime.geometry_set_eval, &instance_offset_matrices, &ids, &instanced_data);
+  int *reference_handles;
+  InstancedData *references;
+  const int amount = BKE_geometry_set_instances(ctx->object->runtime.geometry_set_eval,
+                                                &instance_offset_matrices,
+                                                &ids,
+                                                &reference_handles,
+                                                &references);
 
   for (int i = 0; i < amount; i++) {
-    InstancedData *data = &instanced_data[i];
+    InstancedData *data = &references[reference_handles[i]];
 
     const int id = ids[i] != -1 ? ids[i] : i;
 
@@ -1591,7 +1609,8 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
  */
 ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_callocN(sizeof(ListBase), "duplilist");
+  DupliList *duplilist = MEM_callocN(sizeof(DupliList), "duplilist");
+  duplilist->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
   DupliContext ctx;
   init_context(&ctx, depsgraph, sce, ob, NULL);
   if (ctx.gen) {
@@ -1599,13 +1618,14 @@ ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
     ctx.gen->make_duplis(&ctx);
   }
 
-  return duplilist;
+  return &duplilist->list;
 }
 
 void free_object_duplilist(ListBase *lb)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  DupliList *duplilist = (DupliList *)lb;
+  BLI_memarena_free(duplilist->arena);
+  MEM_freeN(duplilist);
 }
 
 /** \} */
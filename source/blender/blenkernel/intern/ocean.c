@@ -199,7 +199,25 @@ float BKE_ocean_jminus_to_foam(float jminus, float coverage)
   return foam;
 }
 
+void BKE_ocean_read_lock(struct Ocean *oc)
+{
+  BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
+}
+
+void BKE_ocean_read_unlock(struct Ocean *oc)
+{
+  BLI_rw_mutex_unlock(&oc->oceanmutex);
+}
+
 void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float v)
+{
+  BKE_ocean_read_lock(oc);
+  BKE_ocean_eval_uv_unlocked(oc, ocr, u, v);
+  BKE_ocean_read_unlock(oc);
+}
+
+/* Same as #BKE_ocean_eval_uv, the caller has to hold the lock of #BKE_ocean_read_lock. */
+void BKE_ocean_eval_uv_unlocked(struct Ocean *oc, struct OceanResult *ocr, float u, float v)
 {
   int i0, i1, j0, j1;
   float frac_x, frac_z;
@@ -216,8 +234,6 @@ void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float
     v += 1.0f;
   }
 
-  BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
-
   uu = u * oc->_M;
   vv = v * oc->_N;
 
@@ -266,8 +282,6 @@ void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float
     }
   }
 #  undef BILERP
-
-  BLI_rw_mutex_unlock(&oc->oceanmutex);
 }
 
 /* use catmullrom interpolation rather than linear */
@@ -1561,6 +1575,21 @@ void BKE_ocean_eval_uv(struct Ocean *UNUSED(oc),
 {
 }
 
+void BKE_ocean_read_lock(struct Ocean *UNUSED(oc))
+{
+}
+
+void BKE_ocean_read_unlock(struct Ocean *UNUSED(oc))
+{
+}
+
+void BKE_ocean_eval_uv_unlocked(struct Ocean *UNUSED(oc),
+                                struct OceanResult *UNUSED(ocr),
+                                float UNUSED(u),
+                                float UNUSED(v))
+{
+}
+
 /* use catmullrom interpolation rather than linear */
 void BKE_ocean_eval_uv_catrom(struct Ocean *UNUSED(oc),
                               struct OceanResult *UNUSED(ocr),
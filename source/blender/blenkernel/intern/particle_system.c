@@ -3715,6 +3715,23 @@ static void dynamics_step_sphdata_reduce(const void *__restrict UNUSED(userdata)
   BLI_buffer_field_free(&sphdata_from->new_springs);
 }
 
+static void dynamics_step_newtonian_basic_integrate_task_cb_ex(
+    void *__restrict userdata, const int p, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+}
+
 static void dynamics_step_sph_ddr_task_cb_ex(void *__restrict userdata,
                                              const int p,
                                              const TaskParallelTLS *__restrict tls)
@@ -3946,10 +3963,36 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      /* Brownian motion and collisions draw from the shared 'sim->rng', keep them serial so the
+       * random sequence stays the same. Without brownian motion the effectors are evaluated for
+       * all particles first, particles don't interact with each other so the result is the same
+       * as doing the deflection of each particle right after its integration. */
+      const bool use_threading = (part->brownfac == 0.0f);
+
+      if (use_threading) {
+        DynamicStepSolverTaskData task_data = {
+            .sim = sim,
+            .cfra = cfra,
+            .timestep = timestep,
+            .dtime = dtime,
+        };
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (psys->totpart > 100);
+        BLI_task_parallel_range(0,
+                                psys->totpart,
+                                &task_data,
+                                dynamics_step_newtonian_basic_integrate_task_cb_ex,
+                                &settings);
+      }
+
       LOOP_DYNAMIC_PARTICLES
       {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
+        if (!use_threading) {
+          /* do global forces & effectors */
+          basic_integrate(sim, p, pa->state.time, cfra);
+        }
 
         /* deflection */
         if (sim->colliders) {
@@ -252,16 +252,19 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+static int map_insert_vert(PBVH *pbvh,
+                           GHash *map,
+                           unsigned int *face_verts,
+                           unsigned int *uniq_verts,
+                           int vertex,
+                           int node_index)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+    if (pbvh->vert_owner[vertex] == node_index) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -276,14 +279,25 @@ static int map_insert_vert(
   return POINTER_AS_INT(*value_p);
 }
 
+static int cmp_int_ascending(const void *a, const void *b)
+{
+  const int i1 = *(const int *)a, i2 = *(const int *)b;
+  return (i1 > i2) - (i1 < i2);
+}
+
 /* Find vertices used by the faces in this node and update the draw buffers */
 static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
 {
+  const int node_index = (int)(node - pbvh->nodes);
   bool has_visible = false;
 
   node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
 
+  /* Visit the triangles in mesh order, the order of the partitioning doesn't matter here and
+   * brushes gathering the loops and polygons of the node read memory front to back. */
+  qsort(node->prim_indices, totface, sizeof(int), cmp_int_ascending);
+
   /* reserve size is rough guess */
   GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
 
@@ -298,8 +312,12 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      map_insert_vert(pbvh,
+                      map,
+                      &node->face_verts,
+                      &node->uniq_verts,
+                      pbvh->mloop[lt->tri[j]].v,
+                      node_index);
     }
 
     if (has_visible == false) {
@@ -326,13 +344,21 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
   }
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+  /* The hash iteration order is arbitrary, sort the unique and the additional vertices by index
+   * so looping over the vertices of the node doesn't jump around in the mesh arrays. */
+  qsort(vert_indices, node->uniq_verts, sizeof(int), cmp_int_ascending);
+  qsort(vert_indices + node->uniq_verts, node->face_verts, sizeof(int), cmp_int_ascending);
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  const int totvert = node->uniq_verts + node->face_verts;
+  for (int i = 0; i < totvert; i++) {
+    *BLI_ghash_lookup_p(map, POINTER_FROM_INT(vert_indices[i])) = POINTER_FROM_INT(i);
+  }
+
+  for (int i = 0; i < totface; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = POINTER_AS_INT(
+          BLI_ghash_lookup(map, POINTER_FROM_INT(pbvh->mloop[lt->tri[j]].v)));
     }
   }
 
@@ -423,14 +449,78 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
+  /* The vertices and draw buffers of the leaves are set up afterwards, see
+   * #pbvh_build_leaf_nodes. */
+}
+
+/* Claim \a vertex for the leaf node with the lowest index using it, so the owner of every vertex
+ * doesn't depend on the order the leaves are built in. */
+static void vert_owner_claim(int *vert_owner, const int vertex, const int node_index)
+{
+  int owner = vert_owner[vertex];
+  while (node_index < owner) {
+    const int owner_prev = atomic_cas_int32(&vert_owner[vertex], owner, node_index);
+    if (owner_prev == owner) {
+      break;
+    }
+    owner = owner_prev;
+  }
+}
+
+static void pbvh_claim_leaf_verts_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVH *pbvh = userdata;
+  const PBVHNode *node = &pbvh->nodes[n];
+  if (!(node->flag & PBVH_Leaf)) {
+    return;
+  }
+
+  for (int i = 0; i < node->totprim; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      vert_owner_claim(pbvh->vert_owner, pbvh->mloop[lt->tri[j]].v, n);
+    }
+  }
+}
+
+static void pbvh_build_leaf_node_task_cb(void *__restrict userdata,
+                                         const int n,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVH *pbvh = userdata;
+  PBVHNode *node = &pbvh->nodes[n];
+  if (!(node->flag & PBVH_Leaf)) {
+    return;
+  }
+
   if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_mesh_leaf_node(pbvh, node);
   }
   else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_grid_leaf_node(pbvh, node);
   }
 }
 
+/* Set up the vertices and draw buffers of all leaves once the tree is built, each leaf only
+ * writes to its own node. For meshes, the owner of every vertex is found first. */
+static void pbvh_build_leaf_nodes(PBVH *pbvh)
+{
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, pbvh->totnode);
+
+  if (pbvh->looptri) {
+    pbvh->vert_owner = MEM_mallocN(sizeof(int) * pbvh->totvert, __func__);
+    copy_vn_i(pbvh->vert_owner, pbvh->totvert, INT_MAX);
+    BLI_task_parallel_range(0, pbvh->totnode, pbvh, pbvh_claim_leaf_verts_task_cb, &settings);
+  }
+
+  BLI_task_parallel_range(0, pbvh->totnode, pbvh, pbvh_build_leaf_node_task_cb, &settings);
+
+  MEM_SAFE_FREE(pbvh->vert_owner);
+}
+
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
@@ -554,6 +644,7 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaf_nodes(pbvh);
 }
 
 /**
@@ -583,7 +674,6 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->mloop = mloop;
   pbvh->looptri = looptri;
   pbvh->verts = verts;
-  pbvh->vert_bitmap = BLI_BITMAP_NEW(totvert, "bvh->vert_bitmap");
   pbvh->totvert = totvert;
   pbvh->leaf_limit = LEAF_LIMIT;
   pbvh->vdata = vdata;
@@ -619,7 +709,6 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   }
 
   MEM_freeN(prim_bbc);
-  MEM_freeN(pbvh->vert_bitmap);
 }
 
 /* Do a full rebuild with on Grids data structure */
@@ -1254,10 +1343,13 @@ void pbvh_update_BB_redraw(PBVH *pbvh, PBVHNode **nodes, int totnode, int flag)
   BLI_task_parallel_range(0, totnode, &data, pbvh_update_BB_redraw_task_cb, &settings);
 }
 
-static int pbvh_get_buffers_update_flags(PBVH *UNUSED(pbvh))
+static int pbvh_get_buffers_update_flags(PBVH *pbvh)
 {
   int update_flags = GPU_PBVH_BUFFERS_SHOW_VCOL | GPU_PBVH_BUFFERS_SHOW_MASK |
                      GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS;
+  if (pbvh->draw_keep_data) {
+    update_flags |= GPU_PBVH_BUFFERS_KEEP_DATA;
+  }
   return update_flags;
 }
 
@@ -3070,3 +3162,21 @@ void BKE_pbvh_respect_hide_set(PBVH *pbvh, bool respect_hide)
 {
   pbvh->respect_hide = respect_hide;
 }
+
+/**
+ * While enabled, draw buffers of nodes keep their vertex data after it's uploaded, so the next
+ * update only uploads what changed. Meant for the duration of a stroke, disabling it frees the
+ * data kept until then.
+ */
+void BKE_pbvh_draw_buffers_keep_data_set(PBVH *pbvh, bool keep_data)
+{
+  if (pbvh->draw_keep_data && !keep_data) {
+    for (int i = 0; i < pbvh->totnode; i++) {
+      PBVHNode *node = &pbvh->nodes[i];
+      if (node->draw_buffers) {
+        GPU_pbvh_buffers_release_data(node->draw_buffers);
+      }
+    }
+  }
+  pbvh->draw_keep_data = keep_data;
+}
@@ -152,7 +152,8 @@ struct PBVH {
 
   /* Only used during BVH build and update,
    * don't need to remain valid after */
-  BLI_bitmap *vert_bitmap;
+  /** Lowest index of the leaf nodes using each vertex, used to pick its unique owner. */
+  int *vert_owner;
 
 #ifdef PERFCNTRS
   int perf_modified;
@@ -163,6 +164,8 @@ struct PBVH {
   bool show_mask;
   bool show_face_sets;
   bool respect_hide;
+  /* Keep the vertex data of updated draw buffers, see #BKE_pbvh_draw_buffers_keep_data_set. */
+  bool draw_keep_data;
 
   /* Dynamic topology */
   BMesh *bm;
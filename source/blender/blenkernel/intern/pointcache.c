@@ -47,6 +47,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -1513,88 +1514,130 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
-static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
+/* A block of cache data as it's stored in the file, reading and writing the file is kept
+ * separate from the (de)compression so the blocks of a frame can be processed in parallel. */
+typedef struct PTCacheCompressedBlock {
+  /** Uncompressed data. */
+  unsigned char *data;
+  unsigned int data_len;
+  /** Compressed data, only used when `compressed` is set. */
+  unsigned char *buffer;
+  size_t buffer_len;
+  /** 0 for uncompressed data, 1 for LZO and 2 for LZMA. */
+  unsigned char compressed;
+  unsigned char props[16];
+  unsigned int props_len;
+  int result;
+} PTCacheCompressedBlock;
+
+static void ptcache_file_compressed_block_read(PTCacheFile *pf, PTCacheCompressedBlock *block)
 {
-  int r = 0;
-  unsigned char compressed = 0;
-  size_t in_len;
-#ifdef WITH_LZO
-  size_t out_len = len;
-#endif
-  unsigned char *in;
-  unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
+  unsigned int size;
+
+  block->compressed = 0;
+  block->buffer = NULL;
+  block->buffer_len = 0;
+  block->props_len = 0;
+  block->result = 0;
 
-  ptcache_file_read(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
-    unsigned int size;
+  ptcache_file_read(pf, &block->compressed, 1, sizeof(unsigned char));
+  if (block->compressed) {
     ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-    in_len = (size_t)size;
-    if (in_len == 0) {
+    block->buffer_len = (size_t)size;
+    if (block->buffer_len == 0) {
       /* do nothing */
     }
     else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
-                                        "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
-#ifdef WITH_LZO
-      if (compressed == 1) {
-        r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, NULL);
-      }
-#endif
+      block->buffer = (unsigned char *)MEM_callocN(sizeof(unsigned char) * block->buffer_len,
+                                                   "pointcache_compressed_buffer");
+      ptcache_file_read(pf, block->buffer, block->buffer_len, sizeof(unsigned char));
 #ifdef WITH_LZMA
-      if (compressed == 2) {
-        size_t sizeOfIt;
-        size_t leni = in_len, leno = len;
+      if (block->compressed == 2) {
         ptcache_file_read(pf, &size, 1, sizeof(unsigned int));
-        sizeOfIt = (size_t)size;
-        ptcache_file_read(pf, props, sizeOfIt, sizeof(unsigned char));
-        r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
+        block->props_len = MIN2(size, sizeof(block->props));
+        ptcache_file_read(pf, block->props, block->props_len, sizeof(unsigned char));
       }
 #endif
-      MEM_freeN(in);
     }
   }
   else {
-    ptcache_file_read(pf, result, len, sizeof(unsigned char));
+    ptcache_file_read(pf, block->data, block->data_len, sizeof(unsigned char));
   }
+}
 
-  MEM_freeN(props);
+static void ptcache_compressed_block_decompress(PTCacheCompressedBlock *block)
+{
+  if (block->buffer == NULL) {
+    return;
+  }
 
-  return r;
+#ifdef WITH_LZO
+  if (block->compressed == 1) {
+    size_t out_len = block->data_len;
+    block->result = lzo1x_decompress_safe(block->buffer,
+                                          (lzo_uint)block->buffer_len,
+                                          block->data,
+                                          (lzo_uint *)&out_len,
+                                          NULL);
+  }
+#endif
+#ifdef WITH_LZMA
+  if (block->compressed == 2) {
+    size_t leni = block->buffer_len, leno = block->data_len;
+    block->result = LzmaUncompress(
+        block->data, &leno, block->buffer, &leni, block->props, block->props_len);
+  }
+#endif
+
+  MEM_freeN(block->buffer);
+  block->buffer = NULL;
 }
-static int ptcache_file_compressed_write(
-    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
+
+static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
+{
+  PTCacheCompressedBlock block = {.data = result, .data_len = len};
+
+  ptcache_file_compressed_block_read(pf, &block);
+  ptcache_compressed_block_decompress(&block);
+
+  return block.result;
+}
+
+/* Compresses `block->data` into `block->buffer`, which must be allocated by the caller with
+ * room for `LZO_OUT_LEN(data_len) * 4` bytes. */
+static void ptcache_compressed_block_compress(PTCacheCompressedBlock *block, int mode)
 {
   int r = 0;
-  unsigned char compressed = 0;
   size_t out_len = 0;
-  unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
   size_t sizeOfIt = 5;
 
   (void)mode; /* unused when building w/o compression */
 
+  block->compressed = 0;
+
 #ifdef WITH_LZO
-  out_len = LZO_OUT_LEN(in_len);
+  out_len = LZO_OUT_LEN(block->data_len);
   if (mode == 1) {
     LZO_HEAP_ALLOC(wrkmem, LZO1X_MEM_COMPRESS);
 
-    r = lzo1x_1_compress(in, (lzo_uint)in_len, out, (lzo_uint *)&out_len, wrkmem);
-    if (!(r == LZO_E_OK) || (out_len >= in_len)) {
-      compressed = 0;
+    r = lzo1x_1_compress(
+        block->data, (lzo_uint)block->data_len, block->buffer, (lzo_uint *)&out_len, wrkmem);
+    if (!(r == LZO_E_OK) || (out_len >= block->data_len)) {
+      block->compressed = 0;
     }
     else {
-      compressed = 1;
+      block->compressed = 1;
     }
   }
 #endif
 #ifdef WITH_LZMA
   if (mode == 2) {
 
-    r = LzmaCompress(out,
+    r = LzmaCompress(block->buffer,
                      &out_len,
-                     in,
-                     in_len, /* assume sizeof(char)==1.... */
-                     props,
+                     block->data,
+                     block->data_len, /* assume sizeof(char)==1.... */
+                     block->props,
                      &sizeOfIt,
                      5,
                      1 << 24,
@@ -1604,34 +1647,89 @@ static int ptcache_file_compressed_write(
                      32,
                      2);
 
-    if (!(r == SZ_OK) || (out_len >= in_len)) {
-      compressed = 0;
+    if (!(r == SZ_OK) || (out_len >= block->data_len)) {
+      block->compressed = 0;
     }
     else {
-      compressed = 2;
+      block->compressed = 2;
     }
   }
 #endif
 
-  ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
-  if (compressed) {
-    unsigned int size = out_len;
+  block->buffer_len = out_len;
+  block->props_len = (unsigned int)sizeOfIt;
+  block->result = r;
+}
+
+static void ptcache_file_compressed_block_write(PTCacheFile *pf,
+                                                const PTCacheCompressedBlock *block)
+{
+  ptcache_file_write(pf, &block->compressed, 1, sizeof(unsigned char));
+  if (block->compressed) {
+    unsigned int size = block->buffer_len;
     ptcache_file_write(pf, &size, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, out, out_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->buffer, block->buffer_len, sizeof(unsigned char));
   }
   else {
-    ptcache_file_write(pf, in, in_len, sizeof(unsigned char));
+    ptcache_file_write(pf, block->data, block->data_len, sizeof(unsigned char));
   }
 
-  if (compressed == 2) {
-    unsigned int size = sizeOfIt;
-    ptcache_file_write(pf, &sizeOfIt, 1, sizeof(unsigned int));
-    ptcache_file_write(pf, props, size, sizeof(unsigned char));
+  if (block->compressed == 2) {
+    ptcache_file_write(pf, &block->props_len, 1, sizeof(unsigned int));
+    ptcache_file_write(pf, block->props, block->props_len, sizeof(unsigned char));
   }
+}
+
+static int ptcache_file_compressed_write(
+    PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode)
+{
+  PTCacheCompressedBlock block = {.data = in, .data_len = in_len, .buffer = out};
 
-  MEM_freeN(props);
+  ptcache_compressed_block_compress(&block, mode);
+  ptcache_file_compressed_block_write(pf, &block);
 
-  return r;
+  return block.result;
+}
+
+typedef struct PTCacheCompressTaskData {
+  PTCacheCompressedBlock *blocks;
+  int mode;
+} PTCacheCompressTaskData;
+
+static void ptcache_compress_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PTCacheCompressTaskData *data = userdata;
+  PTCacheCompressedBlock *block = &data->blocks[i];
+
+  if (block->data == NULL) {
+    return;
+  }
+
+  if (data->mode) {
+    ptcache_compressed_block_compress(block, data->mode);
+  }
+  else {
+    ptcache_compressed_block_decompress(block);
+  }
+}
+
+/* Compresses (or decompresses when `mode` is zero) the blocks of all data types of a frame,
+ * LZMA especially is slow enough that the few blocks of a frame are worth threading. */
+static void ptcache_compressed_blocks_process(PTCacheCompressedBlock blocks[BPHYS_TOT_DATA],
+                                              unsigned int totpoint,
+                                              int mode)
+{
+  PTCacheCompressTaskData data = {
+      .blocks = blocks,
+      .mode = mode,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totpoint > 1000);
+  BLI_task_parallel_range(0, BPHYS_TOT_DATA, &data, ptcache_compress_task_cb, &settings);
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
@@ -1967,12 +2065,17 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
     ptcache_data_alloc(pm);
 
     if (pf->flag & PTCACHE_TYPEFLAG_COMPRESS) {
+      PTCacheCompressedBlock blocks[BPHYS_TOT_DATA] = {{NULL}};
+
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
-        unsigned int out_len = pm->totpoint * ptcache_data_size[i];
         if (pf->data_types & (1 << i)) {
-          ptcache_file_compressed_read(pf, (unsigned char *)(pm->data[i]), out_len);
+          blocks[i].data = (unsigned char *)(pm->data[i]);
+          blocks[i].data_len = pm->totpoint * ptcache_data_size[i];
+          ptcache_file_compressed_block_read(pf, &blocks[i]);
         }
       }
+
+      ptcache_compressed_blocks_process(blocks, pm->totpoint, 0);
     }
     else {
       void *cur[BPHYS_TOT_DATA];
@@ -2065,14 +2168,24 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
 
   if (!error) {
     if (pid->cache->compression) {
+      PTCacheCompressedBlock blocks[BPHYS_TOT_DATA] = {{NULL}};
+
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         if (pm->data[i]) {
           unsigned int in_len = pm->totpoint * ptcache_data_size[i];
-          unsigned char *out = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
-                                                            "pointcache_lzo_buffer");
-          ptcache_file_compressed_write(
-              pf, (unsigned char *)(pm->data[i]), in_len, out, pid->cache->compression);
-          MEM_freeN(out);
+          blocks[i].data = (unsigned char *)(pm->data[i]);
+          blocks[i].data_len = in_len;
+          blocks[i].buffer = (unsigned char *)MEM_callocN(LZO_OUT_LEN(in_len) * 4,
+                                                          "pointcache_lzo_buffer");
+        }
+      }
+
+      ptcache_compressed_blocks_process(blocks, pm->totpoint, pid->cache->compression);
+
+      for (i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (blocks[i].data) {
+          ptcache_file_compressed_block_write(pf, &blocks[i]);
+          MEM_freeN(blocks[i].buffer);
         }
       }
     }
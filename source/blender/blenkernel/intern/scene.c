@@ -2688,6 +2688,16 @@ void BKE_scene_graph_evaluated_ensure(Depsgraph *depsgraph, Main *bmain)
 
 /* applies changes right away, does all sets too */
 void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
+{
+  BKE_scene_graph_update_for_newframe_ex(depsgraph, true);
+}
+
+/**
+ * Same as #BKE_scene_graph_update_for_newframe, optionally keeping the recalc flags of the
+ * evaluated data-blocks so that a render engine reusing the depsgraph can query what changed.
+ * The caller is then responsible for clearing them with #DEG_ids_clear_recalc.
+ */
+void BKE_scene_graph_update_for_newframe_ex(Depsgraph *depsgraph, const bool clear_recalc)
 {
   Scene *scene = DEG_get_input_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -2731,7 +2741,9 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph)
     /* Inform editors about possible changes. */
     DEG_ids_check_recalc(bmain, depsgraph, scene, view_layer, true);
     /* clear recalc flags */
-    DEG_ids_clear_recalc(bmain, depsgraph);
+    if (clear_recalc) {
+      DEG_ids_clear_recalc(bmain, depsgraph);
+    }
 
     /* If user callback did not tag anything for update we can skip second iteration.
      * Otherwise we update scene once again, but without running callbacks to bring
@@ -32,6 +32,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -711,19 +712,13 @@ bool BKE_texture_dependsOnTime(const struct Tex *texture)
 
 /* ------------------------------------------------------------------------- */
 
-void BKE_texture_get_value_ex(const Scene *scene,
-                              Tex *texture,
+static void texture_get_value(Tex *texture,
                               const float *tex_co,
                               TexResult *texres,
                               struct ImagePool *pool,
-                              bool use_color_management)
+                              bool do_color_manage)
 {
   int result_type;
-  bool do_color_manage = false;
-
-  if (scene && use_color_management) {
-    do_color_manage = BKE_scene_check_color_management_enabled(scene);
-  }
 
   /* no node textures for now */
   result_type = multitex_ext_safe(texture, tex_co, texres, pool, do_color_manage, false);
@@ -740,6 +735,22 @@ void BKE_texture_get_value_ex(const Scene *scene,
   }
 }
 
+void BKE_texture_get_value_ex(const Scene *scene,
+                              Tex *texture,
+                              const float *tex_co,
+                              TexResult *texres,
+                              struct ImagePool *pool,
+                              bool use_color_management)
+{
+  bool do_color_manage = false;
+
+  if (scene && use_color_management) {
+    do_color_manage = BKE_scene_check_color_management_enabled(scene);
+  }
+
+  texture_get_value(texture, tex_co, texres, pool, do_color_manage);
+}
+
 void BKE_texture_get_value(const Scene *scene,
                            Tex *texture,
                            const float *tex_co,
@@ -749,6 +760,58 @@ void BKE_texture_get_value(const Scene *scene,
   BKE_texture_get_value_ex(scene, texture, tex_co, texres, NULL, use_color_management);
 }
 
+typedef struct TextureGetValuesData {
+  Tex *texture;
+  const float (*tex_co)[3];
+  const int *indices;
+  TexResult *texres;
+  struct ImagePool *pool;
+  bool do_color_manage;
+} TextureGetValuesData;
+
+static void texture_get_values_fn(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TextureGetValuesData *data = userdata;
+  const int index = data->indices ? data->indices[i] : i;
+  TexResult *texres = &data->texres[i];
+
+  texres->nor = NULL;
+  texture_get_value(data->texture, data->tex_co[index], texres, data->pool, data->do_color_manage);
+}
+
+/**
+ * Evaluate the texture for \a num points at once, using multiple threads for large inputs.
+ * Point \a i is sampled at `tex_co[indices[i]]`, or at `tex_co[i]` when \a indices is NULL.
+ */
+void BKE_texture_get_values(const Scene *scene,
+                            Tex *texture,
+                            const float (*tex_co)[3],
+                            const int *indices,
+                            int num,
+                            TexResult *r_texres,
+                            bool use_color_management)
+{
+  TextureGetValuesData data = {
+      .texture = texture,
+      .tex_co = tex_co,
+      .indices = indices,
+      .texres = r_texres,
+      .pool = BKE_image_pool_new(),
+      .do_color_manage = scene && use_color_management &&
+                         BKE_scene_check_color_management_enabled(scene),
+  };
+  BKE_texture_fetch_images_for_pool(texture, data.pool);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (num > 512);
+  BLI_task_parallel_range(0, num, &data, texture_get_values_fn, &settings);
+
+  BKE_image_pool_free(data.pool);
+}
+
 static void texture_nodes_fetch_images_for_pool(Tex *texture,
                                                 bNodeTree *ntree,
                                                 struct ImagePool *pool)
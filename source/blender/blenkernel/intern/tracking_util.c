@@ -615,6 +615,23 @@ MovieTrackingMarker *tracking_get_keyframed_marker(MovieTrackingTrack *track,
 
 /*********************** Frame accessr *************************/
 
+/* Get a new reference to the frame from the frame window, NULL if it is not in the window.
+ * Expects the cache lock to be held. */
+static ImBuf *accessor_frame_window_lookup(TrackingImageAccessor *accessor,
+                                           int clip_index,
+                                           int frame)
+{
+  for (int i = 0; i < ACCESSOR_FRAME_WINDOW_SIZE; i++) {
+    TrackingImageAccessorFrame *window_frame = &accessor->frame_window[i];
+    if (window_frame->ibuf != NULL && window_frame->clip_index == clip_index &&
+        window_frame->frame == frame) {
+      IMB_refImBuf(window_frame->ibuf);
+      return window_frame->ibuf;
+    }
+  }
+  return NULL;
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -626,12 +643,46 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  BLI_spin_lock(&accessor->cache_lock);
+  ibuf = accessor_frame_window_lookup(accessor, clip_index, frame);
+  BLI_spin_unlock(&accessor->cache_lock);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
   user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
   user.render_flag = 0;
   ibuf = BKE_movieclip_get_ibuf(clip, &user);
+  if (ibuf == NULL) {
+    return NULL;
+  }
+
+  /* Another thread might have added the same frame while this one was reading it. */
+  BLI_spin_lock(&accessor->cache_lock);
+  ImBuf *window_ibuf = accessor_frame_window_lookup(accessor, clip_index, frame);
+  ImBuf *evicted_ibuf = NULL;
+  if (window_ibuf == NULL) {
+    const int window_index = accessor->frame_window_next;
+    TrackingImageAccessorFrame *window_frame = &accessor->frame_window[window_index];
+    evicted_ibuf = window_frame->ibuf;
+    window_frame->clip_index = clip_index;
+    window_frame->frame = frame;
+    window_frame->ibuf = ibuf;
+    IMB_refImBuf(ibuf);
+    accessor->frame_window_next = (window_index + 1) % ACCESSOR_FRAME_WINDOW_SIZE;
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  if (window_ibuf != NULL) {
+    IMB_freeImBuf(ibuf);
+    ibuf = window_ibuf;
+  }
+  if (evicted_ibuf != NULL) {
+    IMB_freeImBuf(evicted_ibuf);
+  }
 
   return ibuf;
 }
@@ -932,6 +983,11 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
+  for (int i = 0; i < ACCESSOR_FRAME_WINDOW_SIZE; i++) {
+    if (accessor->frame_window[i].ibuf != NULL) {
+      IMB_freeImBuf(accessor->frame_window[i].ibuf);
+    }
+  }
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor->tracks);
   MEM_freeN(accessor);
@@ -55,6 +55,7 @@
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
 #  include <libavutil/imgutils.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libavutil/samplefmt.h>
 #  include <libswscale/swscale.h>
@@ -77,6 +78,7 @@ typedef struct FFMpegContext {
 
   int ffmpeg_crf;    /* set to 0 to not use CRF mode; we have another flag for lossless anyway. */
   int ffmpeg_preset; /* see eFFMpegPreset */
+  bool ffmpeg_hw_encode;
 
   AVFormatContext *outfile;
   AVStream *video_stream;
@@ -541,6 +543,58 @@ static void set_ffmpeg_properties(RenderData *rd,
 
 /* prepare a video stream for the output file */
 
+/* First pixel format in system memory, hardware encoders also list their device formats. */
+static enum AVPixelFormat hardware_encoder_pix_fmt(const AVCodec *codec)
+{
+  for (const enum AVPixelFormat *pix_fmt = codec->pix_fmts; *pix_fmt != AV_PIX_FMT_NONE;
+       pix_fmt++) {
+    if ((av_pix_fmt_desc_get(*pix_fmt)->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0) {
+      return *pix_fmt;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+/* Hardware encoder for the codec which takes frames from system memory, NULL when there is no
+ * such encoder or no device for it. */
+static AVCodec *find_hardware_encoder(int codec_id, int rectx, int recty)
+{
+  static const char *h264_encoders[] = {
+      "h264_nvenc", "h264_videotoolbox", "h264_qsv", "h264_amf", NULL};
+  const char **names = NULL;
+
+  if (codec_id == AV_CODEC_ID_H264) {
+    names = h264_encoders;
+  }
+  if (names == NULL) {
+    return NULL;
+  }
+
+  for (int i = 0; names[i]; i++) {
+    AVCodec *codec = avcodec_find_encoder_by_name(names[i]);
+    if (codec == NULL || codec->pix_fmts == NULL ||
+        hardware_encoder_pix_fmt(codec) == AV_PIX_FMT_NONE) {
+      continue;
+    }
+
+    /* Encoders are available whether there is a device for them or not, open one to know. */
+    AVCodecContext *c = avcodec_alloc_context3(codec);
+    c->width = rectx;
+    c->height = recty;
+    c->time_base = (AVRational){1, 25};
+    c->pix_fmt = hardware_encoder_pix_fmt(codec);
+    const bool found = avcodec_open2(c, codec, NULL) >= 0;
+    avcodec_free_context(&c);
+
+    if (found) {
+      PRINT("Using hardware encoder %s\n", names[i]);
+      return codec;
+    }
+  }
+
+  return NULL;
+}
+
 static AVStream *alloc_video_stream(FFMpegContext *context,
                                     RenderData *rd,
                                     int codec_id,
@@ -552,11 +606,23 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 {
   AVStream *st;
   AVCodecContext *c;
-  AVCodec *codec;
+  AVCodec *codec = NULL;
   AVDictionary *opts = NULL;
+  bool use_hw_encoder = false;
 
   error[0] = '\0';
 
+  if (context->ffmpeg_hw_encode) {
+    codec = find_hardware_encoder(codec_id, rectx, recty);
+    use_hw_encoder = codec != NULL;
+  }
+  if (codec == NULL) {
+    codec = avcodec_find_encoder(codec_id);
+  }
+  if (!codec) {
+    return NULL;
+  }
+
   st = avformat_new_stream(of, NULL);
   if (!st) {
     return NULL;
@@ -611,6 +677,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
     ffmpeg_dict_set_int(&opts, "lossless", 1);
   }
+  else if (use_hw_encoder && context->ffmpeg_crf >= 0) {
+    /* Closest to CRF for NVENC, the other hardware encoders use their default rate control. */
+    ffmpeg_dict_set_int(&opts, "cq", context->ffmpeg_crf);
+  }
   else if (context->ffmpeg_crf >= 0) {
     ffmpeg_dict_set_int(&opts, "crf", context->ffmpeg_crf);
   }
@@ -621,7 +691,8 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  /* Hardware encoders have their own presets, they fail to open with the x264 names. */
+  if (context->ffmpeg_preset && !use_hw_encoder) {
     /* 'preset' is used by h.264, 'deadline' is used by webm/vp9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -654,14 +725,12 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   /* Deprecated and not doing anything since July 2015, deleted in recent ffmpeg */
   // c->me_method = ME_EPZS;
 
-  codec = avcodec_find_encoder(c->codec_id);
-  if (!codec) {
-    return NULL;
-  }
-
   /* Be sure to use the correct pixel format(e.g. RGB, YUV) */
 
-  if (codec->pix_fmts) {
+  if (use_hw_encoder) {
+    c->pix_fmt = hardware_encoder_pix_fmt(codec);
+  }
+  else if (codec->pix_fmts) {
     c->pix_fmt = codec->pix_fmts[0];
   }
   else {
@@ -675,7 +744,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->codec_tag = (('D' << 24) + ('I' << 16) + ('V' << 8) + 'X');
   }
 
-  if (codec_id == AV_CODEC_ID_H264) {
+  if (codec_id == AV_CODEC_ID_H264 && !use_hw_encoder) {
     /* correct wrong default ffmpeg param which crash x264 */
     c->qmin = 10;
     c->qmax = 51;
@@ -965,6 +1034,7 @@ static int start_ffmpeg_impl(FFMpegContext *context,
   context->ffmpeg_autosplit = rd->ffcodecdata.flags & FFMPEG_AUTOSPLIT_OUTPUT;
   context->ffmpeg_crf = rd->ffcodecdata.constant_rate_factor;
   context->ffmpeg_preset = rd->ffcodecdata.ffmpeg_preset;
+  context->ffmpeg_hw_encode = (rd->ffcodecdata.flags & FFMPEG_USE_HW_ENCODER) != 0;
 
   if ((rd->ffcodecdata.flags & FFMPEG_USE_MAX_B_FRAMES) != 0) {
     context->ffmpeg_max_b_frames = rd->ffcodecdata.max_b_frames;
@@ -133,6 +133,9 @@ typedef struct NlaEvalSnapshot {
 typedef struct NlaEvalData {
   ListBase channels;
 
+  /* Storage of the channels and their value snapshots, freed together with the data. */
+  struct MemArena *arena;
+
   /* Mapping of paths and NlaEvalChannelKeys to channels. */
   GHash *path_hash;
   GHash *key_hash;
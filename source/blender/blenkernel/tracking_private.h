@@ -127,9 +127,21 @@ float *tracking_track_get_mask_for_region(int frame_width,
 
 /*********************** Frame accessr *************************/
 
+struct ImBuf;
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+
+/* Number of original frames the accessor keeps referenced. Tracking a frame reads the same two
+ * frames for every track, so this covers a tracking step of a single clip twice over. */
+#define ACCESSOR_FRAME_WINDOW_SIZE 4
+
+typedef struct TrackingImageAccessorFrame {
+  int clip_index;
+  int frame;
+  struct ImBuf *ibuf;
+} TrackingImageAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
   int num_clips;
@@ -141,6 +153,11 @@ typedef struct TrackingImageAccessor {
   int num_tracks;
 
   struct libmv_FrameAccessor *libmv_accessor;
+
+  /* Most recently accessed original frames, allows threads to get them without going through
+   * the movie clip cache and its global lock. Guarded by the cache lock. */
+  TrackingImageAccessorFrame frame_window[ACCESSOR_FRAME_WINDOW_SIZE];
+  int frame_window_next;
   SpinLock cache_lock;
 } TrackingImageAccessor;
 
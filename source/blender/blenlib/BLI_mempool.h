@@ -32,8 +32,10 @@ extern "C" {
 
 struct BLI_mempool;
 struct BLI_mempool_chunk;
+struct BLI_mempool_thread_cache;
 
 typedef struct BLI_mempool BLI_mempool;
+typedef struct BLI_mempool_thread_cache BLI_mempool_thread_cache;
 
 BLI_mempool *BLI_mempool_create(unsigned int esize,
                                 unsigned int totelem,
@@ -58,6 +60,16 @@ void *BLI_mempool_as_arrayN(BLI_mempool *pool,
                             const char *allocstr) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(1, 2);
 
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr)
+    ATTR_NONNULL(1, 2);
+void BLI_mempool_thread_cache_destroy(BLI_mempool_thread_cache *cache) ATTR_NONNULL(1);
+
 #ifndef NDEBUG
 void BLI_mempool_set_memory_debug(void);
 #endif
@@ -0,0 +1,48 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording of timed zones and counters from any thread, written to a file in the Chrome trace
+ * event format, which can be viewed in `chrome://tracing` or Perfetto.
+ *
+ * Recording is started with `--debug-trace <filename>`. When it is not started, every function
+ * returns after checking a single flag, so they can be called from performance critical code.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void BLI_trace_begin(const char *filepath);
+void BLI_trace_end(void);
+bool BLI_trace_is_enabled(void);
+
+/* Zones have to be ended on the thread that began them, they can be nested. */
+void BLI_trace_zone_begin(const char *name);
+void BLI_trace_zone_end(void);
+
+void BLI_trace_counter(const char *name, int64_t value);
+void BLI_trace_thread_name_set(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -70,6 +70,13 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Number of leafs per task when calculating the bounding volume of large branches. */
+#define KDOPBVH_REFIT_LEAFS_PER_TASK 4096
+
+/* Number of queries of the batch functions to run per task, a single query is too cheap to be
+ * worth the threading overhead. */
+#define BVH_BATCH_MIN_ITER_PER_THREAD 64
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -387,15 +394,13 @@ static void create_kdop_hull(
 /**
  * \note depends on the fact that the BVH's for each face is already built
  */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+/* Grow the bounding volume \a bv to include the nodes from \a start to \a end. */
+static void kdop_hull_expand(const BVHTree *tree, float *__restrict bv, int start, int end)
 {
   float newmin, newmax;
-  float *__restrict bv = node->bv;
   int j;
   axis_t axis_iter;
 
-  node_minmax_init(tree, node);
-
   for (j = start; j < end; j++) {
     float *__restrict node_bv = tree->nodes[j]->bv;
 
@@ -414,6 +419,78 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct RefitKdopHullData {
+  const BVHTree *tree;
+  int start, end;
+} RefitKdopHullData;
+
+typedef struct RefitKdopHullChunk {
+  /* Large enough for the 26-DOP, the largest supported bounding volume. */
+  float bv[26];
+} RefitKdopHullChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int block,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const RefitKdopHullData *data = userdata;
+  RefitKdopHullChunk *chunk = tls->userdata_chunk;
+
+  const int start = data->start + block * KDOPBVH_REFIT_LEAFS_PER_TASK;
+  const int end = min_ii(start + KDOPBVH_REFIT_LEAFS_PER_TASK, data->end);
+  kdop_hull_expand(data->tree, chunk->bv, start, end);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const RefitKdopHullData *data = userdata;
+  const BVHTree *tree = data->tree;
+  float *bv_join = ((RefitKdopHullChunk *)chunk_join)->bv;
+  const float *bv = ((RefitKdopHullChunk *)chunk)->bv;
+  axis_t axis_iter;
+
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    bv_join[(2 * axis_iter)] = min_ff(bv_join[(2 * axis_iter)], bv[(2 * axis_iter)]);
+    bv_join[(2 * axis_iter) + 1] = max_ff(bv_join[(2 * axis_iter) + 1], bv[(2 * axis_iter) + 1]);
+  }
+}
+
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  node_minmax_init(tree, node);
+
+  /* Only the nodes at the top of the tree are large enough to benefit from threading, these are
+   * otherwise calculated by a single thread while the others wait for the next level. */
+  if (end - start < KDOPBVH_REFIT_LEAFS_PER_TASK * 4) {
+    kdop_hull_expand(tree, node->bv, start, end);
+    return;
+  }
+
+  RefitKdopHullData data = {
+      .tree = tree,
+      .start = start,
+      .end = end,
+  };
+  RefitKdopHullChunk chunk;
+  memcpy(chunk.bv, node->bv, sizeof(*node->bv) * (size_t)tree->axis);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_reduce = refit_kdop_hull_reduce;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0,
+                          (int)divide_ceil_u((uint)(end - start), KDOPBVH_REFIT_LEAFS_PER_TASK),
+                          &data,
+                          refit_kdop_hull_task_cb,
+                          &settings);
+
+  memcpy(node->bv, chunk.bv, sizeof(*node->bv) * (size_t)tree->axis);
+}
+
 /**
  * only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake */
@@ -1660,6 +1737,51 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
   return BLI_bvhtree_find_nearest_ex(tree, co, nearest, callback, userdata, 0);
 }
 
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*coords)[3];
+  BVHTreeNearest *nearest;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+} BVHNearestBatchData;
+
+static void bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHNearestBatchData *data = userdata;
+  BLI_bvhtree_find_nearest(
+      data->tree, data->coords[i], &data->nearest[i], data->callback, data->userdata);
+}
+
+/**
+ * Find the nearest node of each of the \a coords, the queries are run in parallel.
+ *
+ * \param r_nearest: Array of \a coords_len items, which must be initialized like the
+ * \a nearest argument of #BLI_bvhtree_find_nearest.
+ * \note \a callback is called from multiple threads.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*coords)[3],
+                                    const int coords_len,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata)
+{
+  BVHNearestBatchData data = {
+      .tree = tree,
+      .coords = coords,
+      .nearest = r_nearest,
+      .callback = callback,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = BVH_BATCH_MIN_ITER_PER_THREAD;
+  BLI_task_parallel_range(0, coords_len, &data, bvhtree_find_nearest_batch_cb, &settings);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1993,6 +2115,62 @@ int BLI_bvhtree_ray_cast(BVHTree *tree,
       tree, co, dir, radius, hit, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*coords)[3];
+  const float (*dirs)[3];
+  float radius;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHRayCastBatchData *data = userdata;
+  BLI_bvhtree_ray_cast(data->tree,
+                       data->coords[i],
+                       data->dirs[i],
+                       data->radius,
+                       &data->hits[i],
+                       data->callback,
+                       data->userdata);
+}
+
+/**
+ * Cast a ray from each of the \a coords along \a dirs, the rays are cast in parallel.
+ *
+ * \param r_hits: Array of \a coords_len items, which must be initialized like the \a hit
+ * argument of #BLI_bvhtree_ray_cast.
+ * \note \a callback is called from multiple threads.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*coords)[3],
+                                const float (*dirs)[3],
+                                const int coords_len,
+                                float radius,
+                                BVHTreeRayHit *r_hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata)
+{
+  BVHRayCastBatchData data = {
+      .tree = tree,
+      .coords = coords,
+      .dirs = dirs,
+      .radius = radius,
+      .hits = r_hits,
+      .callback = callback,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = BVH_BATCH_MIN_ITER_PER_THREAD;
+  BLI_task_parallel_range(0, coords_len, &data, bvhtree_ray_cast_batch_cb, &settings);
+}
+
 float BLI_bvhtree_bb_raycast(const float bv[6],
                              const float light_start[3],
                              const float light_end[3],
@@ -27,6 +27,7 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating from multiple threads at once, using a #BLI_mempool_thread_cache for each.
  */
 
 #include <stdlib.h>
@@ -135,6 +136,20 @@ struct BLI_mempool {
   /** Number of elements allocated in total. */
   uint totalloc;
 #endif
+  /** Protects \a chunks and \a free while thread caches take elements from the pool,
+   * non-zero while locked. Not a #SpinLock since makesdna uses this file without threading. */
+  uint32_t lock;
+};
+
+/**
+ * Allocates from elements owned by a single thread, taken from the pool a chunk at a time.
+ */
+struct BLI_mempool_thread_cache {
+  BLI_mempool *pool;
+  /** Free element list, only accessed by the thread owning the cache. */
+  BLI_freenode *free;
+  /** Elements allocated minus elements freed, added to #BLI_mempool.totused on destruction. */
+  int totused_delta;
 };
 
 #define MEMPOOL_ELEM_SIZE_MIN (sizeof(void *) * 2)
@@ -185,38 +200,16 @@ static BLI_mempool_chunk *mempool_chunk_alloc(BLI_mempool *pool)
 }
 
 /**
- * Initialize a chunk and add into \a pool->chunks
+ * Link all elements of \a mpchunk into a free list, starting at the chunk data.
  *
- * \param pool: The pool to add the chunk into.
- * \param mpchunk: The new uninitialized chunk (can be malloc'd)
- * \param last_tail: The last element of the previous chunk
- * (used when building free chunks initially)
- * \return The last chunk,
+ * \return The last element of the list, its next pointer is NULL.
  */
-static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
-                                       BLI_mempool_chunk *mpchunk,
-                                       BLI_freenode *last_tail)
+static BLI_freenode *mempool_chunk_link_nodes(const BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
 {
   const uint esize = pool->esize;
   BLI_freenode *curnode = CHUNK_DATA(mpchunk);
   uint j;
 
-  /* append */
-  if (pool->chunk_tail) {
-    pool->chunk_tail->next = mpchunk;
-  }
-  else {
-    BLI_assert(pool->chunks == NULL);
-    pool->chunks = mpchunk;
-  }
-
-  mpchunk->next = NULL;
-  pool->chunk_tail = mpchunk;
-
-  if (UNLIKELY(pool->free == NULL)) {
-    pool->free = curnode;
-  }
-
   /* loop through the allocated data, building the pointer structures */
   j = pool->pchunk;
   if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
@@ -233,14 +226,57 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
     }
   }
 
-  /* terminate the list (rewind one)
-   * will be overwritten if 'curnode' gets passed in again as 'last_tail' */
+  /* terminate the list (rewind one) */
   curnode = NODE_STEP_PREV(curnode);
   curnode->next = NULL;
 
+  return curnode;
+}
+
+/**
+ * Append \a mpchunk to the chunks of \a pool, its elements are not added to the free list.
+ */
+static void mempool_chunk_append(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
+{
+  if (pool->chunk_tail) {
+    pool->chunk_tail->next = mpchunk;
+  }
+  else {
+    BLI_assert(pool->chunks == NULL);
+    pool->chunks = mpchunk;
+  }
+
+  mpchunk->next = NULL;
+  pool->chunk_tail = mpchunk;
+
 #ifdef USE_TOTALLOC
   pool->totalloc += pool->pchunk;
 #endif
+}
+
+/**
+ * Initialize a chunk and add into \a pool->chunks
+ *
+ * \param pool: The pool to add the chunk into.
+ * \param mpchunk: The new uninitialized chunk (can be malloc'd)
+ * \param last_tail: The last element of the previous chunk
+ * (used when building free chunks initially)
+ * \return The last chunk,
+ */
+static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
+                                       BLI_mempool_chunk *mpchunk,
+                                       BLI_freenode *last_tail)
+{
+  BLI_freenode *curnode;
+
+  mempool_chunk_append(pool, mpchunk);
+
+  if (UNLIKELY(pool->free == NULL)) {
+    pool->free = CHUNK_DATA(mpchunk);
+  }
+
+  /* will be overwritten if 'curnode' gets passed in again as 'last_tail' */
+  curnode = mempool_chunk_link_nodes(pool, mpchunk);
 
   /* final pointer in the previously allocated chunk is wrong */
   if (last_tail) {
@@ -315,6 +351,7 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   pool->totalloc = 0;
 #endif
   pool->totused = 0;
+  pool->lock = 0;
 
   if (totelem) {
     /* Allocate the actual chunks. */
@@ -451,6 +488,156 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 }
 
+/**
+ * Thread caches allow multiple threads to allocate from the same pool, each thread takes elements
+ * from the pool a chunk at a time and allocates and frees them without synchronization.
+ * Only taking over elements and adding new chunks to the pool locks.
+ *
+ * While any thread cache of a pool exists, the pool may not be used directly
+ * (only through its caches), its length isn't valid and it can't be iterated over.
+ */
+
+/**
+ * Create a cache for the calling thread to allocate from \a pool.
+ */
+BLI_mempool_thread_cache *BLI_mempool_thread_cache_create(BLI_mempool *pool)
+{
+  BLI_mempool_thread_cache *cache = MEM_mallocN(sizeof(*cache), __func__);
+  cache->pool = pool;
+  cache->free = NULL;
+  cache->totused_delta = 0;
+  return cache;
+}
+
+BLI_INLINE void mempool_lock(BLI_mempool *pool)
+{
+  while (atomic_cas_uint32(&pool->lock, 0, 1) != 0) {
+    /* pass */
+  }
+}
+
+BLI_INLINE void mempool_unlock(BLI_mempool *pool)
+{
+  atomic_cas_uint32(&pool->lock, 1, 0);
+}
+
+static void mempool_thread_cache_refill(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+
+  /* Take over up to one chunk worth of the elements which are free in the pool. */
+  mempool_lock(pool);
+  if (pool->free != NULL) {
+    BLI_freenode *tail = pool->free;
+    for (uint i = 1; i < pool->pchunk && tail->next; i++) {
+      tail = tail->next;
+    }
+    cache->free = pool->free;
+    pool->free = tail->next;
+    tail->next = NULL;
+    mempool_unlock(pool);
+    return;
+  }
+  mempool_unlock(pool);
+
+  /* Initialize the new chunk before locking, only adding it to the pool is serialized. */
+  BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+  mempool_chunk_link_nodes(pool, mpchunk);
+  cache->free = CHUNK_DATA(mpchunk);
+
+  mempool_lock(pool);
+  mempool_chunk_append(pool, mpchunk);
+  mempool_unlock(pool);
+}
+
+void *BLI_mempool_thread_cache_alloc(BLI_mempool_thread_cache *cache)
+{
+  BLI_freenode *free_pop;
+
+  if (UNLIKELY(cache->free == NULL)) {
+    mempool_thread_cache_refill(cache);
+  }
+
+  free_pop = cache->free;
+
+  if (cache->pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+
+  cache->free = free_pop->next;
+  cache->totused_delta++;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(cache->pool, free_pop, cache->pool->esize);
+#endif
+
+  return (void *)free_pop;
+}
+
+void *BLI_mempool_thread_cache_calloc(BLI_mempool_thread_cache *cache)
+{
+  void *retval = BLI_mempool_thread_cache_alloc(cache);
+  memset(retval, 0, (size_t)cache->pool->esize);
+  return retval;
+}
+
+/**
+ * Free an element of the pool of \a cache, it may have been allocated by any cache of the pool.
+ *
+ * \note Unlike #BLI_mempool_free, chunks are never freed when the pool becomes empty.
+ */
+void BLI_mempool_thread_cache_free(BLI_mempool_thread_cache *cache, void *addr)
+{
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, cache->pool->esize);
+  }
+#endif
+
+  if (cache->pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = cache->free;
+  cache->free = newhead;
+  cache->totused_delta--;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(cache->pool, addr);
+#endif
+}
+
+/**
+ * Return the unused elements of \a cache to its pool and free the cache.
+ */
+void BLI_mempool_thread_cache_destroy(BLI_mempool_thread_cache *cache)
+{
+  BLI_mempool *pool = cache->pool;
+  BLI_freenode *tail = cache->free;
+
+  if (tail != NULL) {
+    while (tail->next) {
+      tail = tail->next;
+    }
+  }
+
+  mempool_lock(pool);
+  if (tail != NULL) {
+    tail->next = pool->free;
+    pool->free = cache->free;
+  }
+  pool->totused = (uint)((int)pool->totused + cache->totused_delta);
+  mempool_unlock(pool);
+
+  MEM_freeN(cache);
+}
+
 int BLI_mempool_len(BLI_mempool *pool)
 {
   return (int)pool->totused;
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -58,6 +59,9 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/* Number of points above which duplicates are looked for in parallel. */
+#define KD_DEDUPLICATE_PARALLEL_MIN 10000
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see T62210.
@@ -866,6 +870,47 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/* Check if any other node is in range of the search coordinate, with the same tests as
+ * #deduplicate_recursive but regardless of the duplicates found so far. */
+static bool deduplicate_has_neighbor_recursive(const struct DeDuplicateParams *p,
+                                               const float search_co[KD_DIMS],
+                                               const int search,
+                                               uint i)
+{
+  const KDTreeNode *node = &p->nodes[i];
+  if (search_co[node->d] + p->range <= node->co[node->d]) {
+    return (node->left != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(p, search_co, search, node->left);
+  }
+  if (search_co[node->d] - p->range >= node->co[node->d]) {
+    return (node->right != KD_NODE_UNSET) &&
+           deduplicate_has_neighbor_recursive(p, search_co, search, node->right);
+  }
+  if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= p->range_sq)) {
+    return true;
+  }
+  return ((node->left != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(p, search_co, search, node->left)) ||
+         ((node->right != KD_NODE_UNSET) &&
+          deduplicate_has_neighbor_recursive(p, search_co, search, node->right));
+}
+
+struct DeDuplicateNeighborData {
+  const struct DeDuplicateParams *p;
+  uint root;
+  bool *has_neighbor;
+};
+
+static void deduplicate_has_neighbor_task_cb(void *__restrict userdata,
+                                             const int node_index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct DeDuplicateNeighborData *data = userdata;
+  const KDTreeNode *node = &data->p->nodes[node_index];
+  data->has_neighbor[node_index] = deduplicate_has_neighbor_recursive(
+      data->p, node->co, node->index, data->root);
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -898,11 +943,32 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
+  /* Searching from a point without any other point in range can't find duplicates, and such
+   * points can't be found by other searches either. Finding them is independent of the order of
+   * the searches, so it's done in parallel, leaving only the other points for the ordered loop. */
+  bool *has_neighbor = NULL;
+  if (tree->nodes_len > KD_DEDUPLICATE_PARALLEL_MIN) {
+    has_neighbor = MEM_mallocN(sizeof(*has_neighbor) * tree->nodes_len, __func__);
+    struct DeDuplicateNeighborData data = {
+        .p = &p,
+        .root = tree->root,
+        .has_neighbor = has_neighbor,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(
+        0, (int)tree->nodes_len, &data, deduplicate_has_neighbor_task_cb, &settings);
+  }
+
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = order[i];
       const int index = (int)i;
+      if (has_neighbor && !has_neighbor[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -920,6 +986,9 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
     for (uint i = 0; i < tree->nodes_len; i++) {
       const uint node_index = i;
       const int index = p.nodes[node_index].index;
+      if (has_neighbor && !has_neighbor[node_index]) {
+        continue;
+      }
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -932,6 +1001,10 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+
+  if (has_neighbor) {
+    MEM_freeN(has_neighbor);
+  }
   return found;
 }
 
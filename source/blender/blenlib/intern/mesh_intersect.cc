@@ -2384,6 +2384,41 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
   return cd_data;
 }
 
+/* Data and functions to calculate the exact planes of the overlapping triangles in parallel. */
+struct PopulatePlaneData {
+  const IMesh &tm;
+  const TriOverlaps &ov;
+};
+
+static void populate_plane_range_func(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PopulatePlaneData *data = static_cast<PopulatePlaneData *>(userdata);
+  if (data->ov.first_overlap_index(iter) != -1) {
+    data->tm.face(iter)->populate_plane(true);
+  }
+}
+
+/* Data and functions to subdivide the coplanar clusters in parallel. */
+struct SubdivideClusterData {
+  Array<CDT_data> &r_cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  const TriOverlaps &ov;
+  const Map<std::pair<int, int>, ITT_value> &itt_map;
+  IMeshArena *arena;
+};
+
+static void calc_cluster_subdivided_range_func(void *__restrict userdata,
+                                               const int iter,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivideClusterData *data = static_cast<SubdivideClusterData *>(userdata);
+  data->r_cluster_subdivided[iter] = calc_cluster_subdivided(
+      data->clinfo, iter, data->tm, data->ov, data->itt_map, data->arena);
+}
+
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
   int tot_tri = 0;
@@ -2672,11 +2707,16 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   double overlap_time = PIL_check_seconds_timer();
   std::cout << "intersect overlaps calculated, time = " << overlap_time - bb_calc_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    if (tri_ov.first_overlap_index(t) != -1) {
-      tm_clean->face(t)->populate_plane(true);
-    }
-  }
+  PopulatePlaneData populate_plane_data = {*tm_clean, tri_ov};
+  TaskParallelSettings populate_plane_settings;
+  BLI_parallel_range_settings_defaults(&populate_plane_settings);
+  populate_plane_settings.min_iter_per_thread = 1000;
+  populate_plane_settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0,
+                          tm_clean->face_size(),
+                          &populate_plane_data,
+                          populate_plane_range_func,
+                          &populate_plane_settings);
 #  ifdef PERFDEBUG
   double plane_populate = PIL_check_seconds_timer();
   std::cout << "planes populated, time = " << plane_populate - overlap_time << "\n";
@@ -2708,9 +2748,17 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided tris found, time = " << subdivided_tris_time - itt_time << "\n";
 #  endif
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  SubdivideClusterData cluster_data = {
+      cluster_subdivided, clinfo, *tm_clean, tri_ov, itt_map, arena};
+  TaskParallelSettings cluster_settings;
+  BLI_parallel_range_settings_defaults(&cluster_settings);
+  cluster_settings.min_iter_per_thread = 1;
+  cluster_settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0,
+                          clinfo.tot_cluster(),
+                          &cluster_data,
+                          calc_cluster_subdivided_range_func,
+                          &cluster_settings);
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
@@ -28,6 +28,7 @@
 
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_timeit.hh"
 
 #include "atomic_ops.h"
 
@@ -104,6 +105,93 @@ struct RangeTask {
   }
 };
 
+/* Print the measured iteration cost and chosen grain size of adaptive ranges. */
+// #define DEBUG_ADAPTIVE_GRAIN_SIZE
+
+#  ifdef DEBUG_ADAPTIVE_GRAIN_SIZE
+#    include <cstdio>
+#  endif
+
+/* Ranges without a minimum number of iterations per thread and at least this many iterations
+ * choose their grain size from the measured cost of their first iterations. Below this, running
+ * one expensive iteration on the calling thread before threading would cost too much. */
+#  define ADAPTIVE_GRAIN_SIZE_MIN_RANGE 1024
+/* The first iterations are run on the calling thread until this much time passed, or until
+ * #ADAPTIVE_GRAIN_SIZE_PROBE_ITER_MAX iterations have been run. The time is read after batches
+ * of iterations which double in size, so cheap iterations don't pay for reading the clock. */
+#  define ADAPTIVE_GRAIN_SIZE_PROBE_DURATION_NS 20000
+#  define ADAPTIVE_GRAIN_SIZE_PROBE_ITER_MAX 256
+/* Aimed duration of each task, long enough for the scheduling overhead not to matter. */
+#  define ADAPTIVE_GRAIN_SIZE_TASK_DURATION_NS 100000
+/* Minimum number of tasks per thread, so that the iterations can still be balanced between
+ * threads when the cost of the first iterations is not representative of the whole range. */
+#  define ADAPTIVE_GRAIN_SIZE_TASKS_PER_THREAD 4
+
+static void parallel_range_adaptive(const int start,
+                                    const int stop,
+                                    void *userdata,
+                                    TaskParallelRangeFunc func,
+                                    const TaskParallelSettings *settings)
+{
+  using namespace blender::timeit;
+
+  /* The first iterations get their own chunk, the chunk of the remaining iterations is joined
+   * into it, keeping the order of the reduction. */
+  RangeTask task(func, userdata, settings);
+  TaskParallelTLS tls;
+  tls.userdata_chunk = task.userdata_chunk;
+
+  const TimePoint probe_start = Clock::now();
+  Nanoseconds probe_duration;
+  int iter = start;
+  /* Isolated like the tasks, the iterations can contain nested threading. */
+  tbb::this_task_arena::isolate([&] {
+    int batch_end = start + 1;
+    do {
+      for (; iter < batch_end; iter++) {
+        func(userdata, iter, &tls);
+      }
+      probe_duration = Clock::now() - probe_start;
+      batch_end = MIN3(
+          iter + (iter - start), start + ADAPTIVE_GRAIN_SIZE_PROBE_ITER_MAX, stop - 1);
+    } while (iter < batch_end &&
+             probe_duration.count() < ADAPTIVE_GRAIN_SIZE_PROBE_DURATION_NS);
+  });
+
+  /* Never leave fewer tasks than #ADAPTIVE_GRAIN_SIZE_TASKS_PER_THREAD for each thread. */
+  const int grainsize_max = MAX2(
+      (stop - iter) / (BLI_task_scheduler_num_threads() * ADAPTIVE_GRAIN_SIZE_TASKS_PER_THREAD),
+      1);
+  const double iter_cost_ns = MAX2((double)probe_duration.count() / (iter - start), 1.0);
+  const int grainsize = (int)MAX2(
+      MIN2(ADAPTIVE_GRAIN_SIZE_TASK_DURATION_NS / iter_cost_ns, (double)grainsize_max), 1.0);
+
+#  ifdef DEBUG_ADAPTIVE_GRAIN_SIZE
+  printf("%s: func %p, %d iterations, %.1fns per iteration, grain size %d\n",
+         __func__,
+         (void *)func,
+         stop - start,
+         iter_cost_ns,
+         grainsize);
+#  endif
+
+  /* The probe always leaves at least one iteration. */
+  RangeTask task_remaining(func, userdata, settings);
+  const tbb::blocked_range<int> range(iter, stop, grainsize);
+
+  if (settings->func_reduce) {
+    parallel_reduce(range, task_remaining);
+    task.join(task_remaining);
+  }
+  else {
+    parallel_for(range, task_remaining);
+  }
+
+  if (settings->func_reduce && settings->userdata_chunk) {
+    memcpy(settings->userdata_chunk, task.userdata_chunk, settings->userdata_chunk_size);
+  }
+}
+
 #endif
 
 void BLI_task_parallel_range(const int start,
@@ -115,6 +203,11 @@ void BLI_task_parallel_range(const int start,
 #ifdef WITH_TBB
   /* Multithreading. */
   if (settings->use_threading && BLI_task_scheduler_num_threads() > 1) {
+    if (settings->min_iter_per_thread == 0 && stop - start >= ADAPTIVE_GRAIN_SIZE_MIN_RANGE) {
+      parallel_range_adaptive(start, stop, userdata, func, settings);
+      return;
+    }
+
     RangeTask task(func, userdata, settings);
     const size_t grainsize = MAX2(settings->min_iter_per_thread, 1);
     const tbb::blocked_range<int> range(start, stop, grainsize);
@@ -0,0 +1,224 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Every thread records its events into its own buffer, so that threads only synchronize with
+ * each other when they record their first event. The buffers are merged when the trace file is
+ * written.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BLI_fileops.h"
+#include "BLI_trace.h"
+#include "BLI_utildefines.h"
+
+namespace blender::trace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TraceEvent {
+  /** Phase of the event in the Chrome trace format: 'B' (begin), 'E' (end) or 'C' (counter). */
+  char phase;
+  Clock::time_point time;
+  std::string name;
+  int64_t value;
+};
+
+struct ThreadTrace {
+  int tid;
+  std::string name;
+  /** Only contended when the trace file is written while the thread records events. */
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+};
+
+struct Trace {
+  std::atomic<bool> is_enabled{false};
+  std::string filepath;
+  Clock::time_point start_time;
+  /** Guards #threads. */
+  std::mutex mutex;
+  /** Kept until exit, because threads keep a pointer to theirs. */
+  std::vector<std::unique_ptr<ThreadTrace>> threads;
+};
+
+static Trace &get_trace()
+{
+  static Trace trace;
+  return trace;
+}
+
+static ThreadTrace &get_thread_trace()
+{
+  static thread_local ThreadTrace *thread_trace = nullptr;
+  if (thread_trace == nullptr) {
+    Trace &trace = get_trace();
+    std::lock_guard<std::mutex> lock{trace.mutex};
+    trace.threads.push_back(std::make_unique<ThreadTrace>());
+    thread_trace = trace.threads.back().get();
+    thread_trace->tid = static_cast<int>(trace.threads.size());
+  }
+  return *thread_trace;
+}
+
+static void add_event(char phase, const char *name, int64_t value)
+{
+  ThreadTrace &thread_trace = get_thread_trace();
+  std::lock_guard<std::mutex> lock{thread_trace.mutex};
+  thread_trace.events.push_back({phase, Clock::now(), name ? name : "", value});
+}
+
+static void write_json_string(FILE *file, const std::string &str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    }
+    else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static void write_trace(Trace &trace)
+{
+  FILE *file = BLI_fopen(trace.filepath.c_str(), "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Error: could not write trace to '%s'\n", trace.filepath.c_str());
+    return;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  bool is_first = true;
+  std::lock_guard<std::mutex> lock{trace.mutex};
+  for (const std::unique_ptr<ThreadTrace> &thread_trace : trace.threads) {
+    std::lock_guard<std::mutex> thread_lock{thread_trace->mutex};
+
+    if (!thread_trace->name.empty()) {
+      fprintf(file,
+              "%s{\"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"name\": \"thread_name\", "
+              "\"args\": {\"name\": ",
+              is_first ? "" : ",\n",
+              thread_trace->tid);
+      write_json_string(file, thread_trace->name);
+      fprintf(file, "}}");
+      is_first = false;
+    }
+
+    for (const TraceEvent &event : thread_trace->events) {
+      /* Microseconds since the start of the trace. */
+      const double time = std::chrono::duration<double, std::micro>(event.time -
+                                                                    trace.start_time)
+                              .count();
+      fprintf(file,
+              "%s{\"ph\": \"%c\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f",
+              is_first ? "" : ",\n",
+              event.phase,
+              thread_trace->tid,
+              time);
+      if (event.phase != 'E') {
+        fprintf(file, ", \"name\": ");
+        write_json_string(file, event.name);
+      }
+      if (event.phase == 'C') {
+        fprintf(file, ", \"args\": {\"value\": %lld}", static_cast<long long>(event.value));
+      }
+      fprintf(file, "}");
+      is_first = false;
+    }
+    thread_trace->events.clear();
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+}
+
+}  // namespace blender::trace
+
+using namespace blender::trace;
+
+/**
+ * Start recording events, the calling thread is named "Main".
+ */
+void BLI_trace_begin(const char *filepath)
+{
+  Trace &trace = get_trace();
+  trace.filepath = filepath;
+  trace.start_time = Clock::now();
+  trace.is_enabled.store(true, std::memory_order_release);
+  BLI_trace_thread_name_set("Main");
+}
+
+/**
+ * Stop recording events and write them to the file passed to #BLI_trace_begin.
+ */
+void BLI_trace_end(void)
+{
+  Trace &trace = get_trace();
+  if (!trace.is_enabled.exchange(false)) {
+    return;
+  }
+  write_trace(trace);
+}
+
+bool BLI_trace_is_enabled(void)
+{
+  return get_trace().is_enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_trace_zone_begin(const char *name)
+{
+  if (BLI_trace_is_enabled()) {
+    add_event('B', name, 0);
+  }
+}
+
+void BLI_trace_zone_end(void)
+{
+  if (BLI_trace_is_enabled()) {
+    add_event('E', nullptr, 0);
+  }
+}
+
+void BLI_trace_counter(const char *name, int64_t value)
+{
+  if (BLI_trace_is_enabled()) {
+    add_event('C', name, value);
+  }
+}
+
+void BLI_trace_thread_name_set(const char *name)
+{
+  if (BLI_trace_is_enabled()) {
+    ThreadTrace &thread_trace = get_thread_trace();
+    std::lock_guard<std::mutex> lock{thread_trace.mutex};
+    thread_trace.name = name;
+  }
+}
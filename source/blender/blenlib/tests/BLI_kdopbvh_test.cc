@@ -119,6 +119,11 @@ TEST(kdopbvh, FindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12);
 }
+/* Large enough for the bounds of the top branches to be calculated in parallel. */
+TEST(kdopbvh, FindNearest_50000)
+{
+  find_nearest_points_test(50000, 1.0, 1000, 12);
+}
 
 TEST(kdopbvh, OptimalFindNearest_1)
 {
@@ -0,0 +1,84 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+/**
+ * Points on a grid in groups of three: a point, a duplicate of it and a point that isn't in
+ * range of any other point.
+ */
+static KDTree_3d *kdtree_duplicate_groups_new(int groups_len, float range)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(groups_len * 3);
+  for (int i = 0; i < groups_len; i++) {
+    const float co[3] = {(float)(i % 100), (float)((i / 100) % 100), (float)(i / 10000)};
+    const float co_duplicate[3] = {co[0], co[1] + range * 0.5f, co[2]};
+    const float co_single[3] = {co[0] + 0.5f, co[1], co[2]};
+    BLI_kdtree_3d_insert(tree, i * 3, co);
+    BLI_kdtree_3d_insert(tree, i * 3 + 1, co_duplicate);
+    BLI_kdtree_3d_insert(tree, i * 3 + 2, co_single);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static void kdtree_calc_duplicates_fast_test(int groups_len, bool use_index_order)
+{
+  const float range = 0.01f;
+  const int points_len = groups_len * 3;
+  KDTree_3d *tree = kdtree_duplicate_groups_new(groups_len, range);
+
+  int *duplicates = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    duplicates[i] = -1;
+  }
+
+  EXPECT_EQ(BLI_kdtree_3d_calc_duplicates_fast(tree, range, use_index_order, duplicates),
+            groups_len);
+
+  for (int i = 0; i < groups_len; i++) {
+    const int a = i * 3, b = i * 3 + 1;
+    if (use_index_order) {
+      EXPECT_EQ(duplicates[a], a);
+      EXPECT_EQ(duplicates[b], a);
+    }
+    else {
+      EXPECT_TRUE((duplicates[a] == a && duplicates[b] == a) ||
+                  (duplicates[a] == b && duplicates[b] == b));
+    }
+    EXPECT_EQ(duplicates[i * 3 + 2], -1);
+  }
+
+  MEM_freeN(duplicates);
+  BLI_kdtree_3d_free(tree);
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+TEST(kdtree, CalcDuplicatesFast)
+{
+  kdtree_calc_duplicates_fast_test(100, false);
+}
+
+TEST(kdtree, CalcDuplicatesFastIndexOrder)
+{
+  kdtree_calc_duplicates_fast_test(100, true);
+}
+
+/* Enough points to look for the points without neighbors in parallel. */
+TEST(kdtree, CalcDuplicatesFastLarge)
+{
+  kdtree_calc_duplicates_fast_test(20000, false);
+}
+
+TEST(kdtree, CalcDuplicatesFastLargeIndexOrder)
+{
+  kdtree_calc_duplicates_fast_test(20000, true);
+}
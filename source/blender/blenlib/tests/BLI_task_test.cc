@@ -134,6 +134,82 @@ TEST(task, MempoolIter)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel allocations from a mempool. *** */
+
+static void task_mempool_thread_cache_func(void *userdata,
+                                           int index,
+                                           const TaskParallelTLS *__restrict tls)
+{
+  int **data = (int **)userdata;
+  BLI_mempool *mempool = (BLI_mempool *)data[NUM_ITEMS];
+  BLI_mempool_thread_cache **cache = (BLI_mempool_thread_cache **)tls->userdata_chunk;
+
+  if (*cache == nullptr) {
+    *cache = BLI_mempool_thread_cache_create(mempool);
+  }
+  data[index] = (int *)BLI_mempool_thread_cache_alloc(*cache);
+  *data[index] = index;
+
+  /* Free some items again, so they get reused. */
+  if (index % 5 == 0) {
+    BLI_mempool_thread_cache_free(*cache, data[index]);
+    data[index] = nullptr;
+  }
+}
+
+static void task_mempool_thread_cache_free_func(const void *__restrict UNUSED(userdata),
+                                                void *__restrict userdata_chunk)
+{
+  BLI_mempool_thread_cache **cache = (BLI_mempool_thread_cache **)userdata_chunk;
+  if (*cache != nullptr) {
+    BLI_mempool_thread_cache_destroy(*cache);
+  }
+}
+
+TEST(task, MempoolThreadCache)
+{
+  int *data[NUM_ITEMS + 1];
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(
+      sizeof(*data[0]), NUM_ITEMS / 2, 32, BLI_MEMPOOL_ALLOW_ITER);
+  /* Pass the pool after the items. */
+  data[NUM_ITEMS] = (int *)mempool;
+
+  BLI_mempool_thread_cache *cache = nullptr;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.userdata_chunk = &cache;
+  settings.userdata_chunk_size = sizeof(cache);
+  settings.func_free = task_mempool_thread_cache_free_func;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, data, task_mempool_thread_cache_func, &settings);
+
+  int num_items = 0;
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    if (data[i] != nullptr) {
+      num_items++;
+    }
+  }
+  EXPECT_EQ(BLI_mempool_len(mempool), num_items);
+
+  /* Those checks should ensure us all allocated items are in the mempool, once. */
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(mempool, &iter);
+  int num_items_iter = 0;
+  for (int *item = (int *)BLI_mempool_iterstep(&iter); item;
+       item = (int *)BLI_mempool_iterstep(&iter)) {
+    ASSERT_TRUE(*item >= 0 && *item < NUM_ITEMS);
+    EXPECT_EQ(data[*item], item);
+    num_items_iter++;
+  }
+  EXPECT_EQ(num_items_iter, num_items);
+
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -0,0 +1,137 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_map.hh"
+#include "BLI_mempool.h"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+/* Number of keys added to the containers, keys are generated from a fixed seed so that the
+ * timings of different runs can be compared. */
+#define TESTCASE_SIZE 1000000
+#define TESTCASE_SEED 0
+
+namespace blender::tests {
+
+static Vector<int> random_ints(int amount, int factor)
+{
+  RandomNumberGenerator rng(TESTCASE_SEED);
+  Vector<int> values(amount);
+  for (int &value : values) {
+    /* Multiply unsigned, signed overflow is undefined. */
+    value = (int)((uint32_t)rng.get_int32() * (uint32_t)factor);
+  }
+  return values;
+}
+
+template<typename MapT> BLI_NOINLINE static void map_random_ints(StringRef name, int factor)
+{
+  const Vector<int> values = random_ints(TESTCASE_SIZE, factor);
+
+  MapT map;
+  {
+    SCOPED_TIMER(name + " Add");
+    for (int value : values) {
+      map.add(value, value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER(name + " Contains");
+    for (int value : values) {
+      count += map.contains(value);
+    }
+  }
+  {
+    SCOPED_TIMER(name + " Remove");
+    for (int value : values) {
+      count += map.remove(value);
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(containers, MapRandomInts)
+{
+  map_random_ints<Map<int, int>>("Map", 1);
+  /* Keys with unused low bits, these are bad for hashing by identity. */
+  map_random_ints<Map<int, int>>("Map (sparse keys)", 3 << 10);
+}
+
+template<typename SetT> BLI_NOINLINE static void set_random_ints(StringRef name, int factor)
+{
+  const Vector<int> values = random_ints(TESTCASE_SIZE, factor);
+
+  SetT set;
+  {
+    SCOPED_TIMER(name + " Add");
+    for (int value : values) {
+      set.add(value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER(name + " Contains");
+    for (int value : values) {
+      count += set.contains(value);
+    }
+  }
+  {
+    SCOPED_TIMER(name + " Remove");
+    for (int value : values) {
+      count += set.remove(value);
+    }
+  }
+
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(containers, SetRandomInts)
+{
+  set_random_ints<Set<int>>("Set", 1);
+  set_random_ints<Set<int>>("Set (sparse keys)", 3 << 10);
+}
+
+TEST(containers, VectorSetRandomInts)
+{
+  set_random_ints<VectorSet<int>>("VectorSet", 1);
+  set_random_ints<VectorSet<int>>("VectorSet (sparse keys)", 3 << 10);
+}
+
+TEST(containers, MempoolAllocFree)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(int64_t), 0, 512, BLI_MEMPOOL_NOP);
+  Vector<void *> elements(TESTCASE_SIZE);
+
+  for (int iteration = 0; iteration < 3; iteration++) {
+    {
+      SCOPED_TIMER("Mempool Alloc");
+      for (void *&elem : elements) {
+        elem = BLI_mempool_alloc(pool);
+      }
+    }
+    {
+      /* Free every other element first, so that the next allocations reuse a fragmented pool. */
+      SCOPED_TIMER("Mempool Free");
+      for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+        BLI_mempool_free(pool, elements[i]);
+      }
+      for (int i = 1; i < TESTCASE_SIZE; i += 2) {
+        BLI_mempool_free(pool, elements[i]);
+      }
+    }
+  }
+
+  std::cout << "Count: " << BLI_mempool_len(pool) << "\n";
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,110 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_float3.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_kdtree.h"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+/* Points are generated from a fixed seed in a unit cube, so that the timings of different runs
+ * can be compared. The search radius finds about 30 points on average. */
+#define TESTCASE_SIZE 1000000
+#define TESTCASE_QUERIES 100000
+#define TESTCASE_SEED 0
+#define TESTCASE_RANGE 0.02f
+
+namespace blender::tests {
+
+static Vector<float3> random_points(int amount, uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Vector<float3> points(amount);
+  for (float3 &point : points) {
+    point = float3(rng.get_float(), rng.get_float(), rng.get_float());
+  }
+  return points;
+}
+
+TEST(spatial_tree, KDTree)
+{
+  const Vector<float3> points = random_points(TESTCASE_SIZE, TESTCASE_SEED);
+  const Vector<float3> queries = random_points(TESTCASE_QUERIES, TESTCASE_SEED + 1);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(TESTCASE_SIZE);
+  {
+    SCOPED_TIMER("KDTree Build");
+    for (const int i : points.index_range()) {
+      BLI_kdtree_3d_insert(tree, i, points[i]);
+    }
+    BLI_kdtree_3d_balance(tree);
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER("KDTree Find Nearest");
+    for (const float3 &query : queries) {
+      KDTreeNearest_3d nearest;
+      count += BLI_kdtree_3d_find_nearest(tree, query, &nearest) != -1;
+    }
+  }
+  {
+    SCOPED_TIMER("KDTree Range Search");
+    for (const float3 &query : queries) {
+      KDTreeNearest_3d *nearest = nullptr;
+      count += BLI_kdtree_3d_range_search(tree, query, &nearest, TESTCASE_RANGE);
+      MEM_SAFE_FREE(nearest);
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+}
+
+static void bvhtree_range_count_cb(void *userdata,
+                                   int UNUSED(index),
+                                   const float UNUSED(co[3]),
+                                   float UNUSED(dist_sq))
+{
+  (*(int *)userdata)++;
+}
+
+TEST(spatial_tree, BVHTree)
+{
+  const Vector<float3> points = random_points(TESTCASE_SIZE, TESTCASE_SEED);
+  const Vector<float3> queries = random_points(TESTCASE_QUERIES, TESTCASE_SEED + 1);
+
+  BVHTree *tree = BLI_bvhtree_new(TESTCASE_SIZE, 0.0f, 2, 6);
+  {
+    SCOPED_TIMER("BVHTree Build");
+    for (const int i : points.index_range()) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+    BLI_bvhtree_balance(tree);
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER("BVHTree Find Nearest");
+    for (const float3 &query : queries) {
+      BVHTreeNearest nearest;
+      nearest.index = -1;
+      nearest.dist_sq = FLT_MAX;
+      count += BLI_bvhtree_find_nearest(tree, query, &nearest, nullptr, nullptr) != -1;
+    }
+  }
+  {
+    SCOPED_TIMER("BVHTree Range Query");
+    for (const float3 &query : queries) {
+      BLI_bvhtree_range_query(tree, query, TESTCASE_RANGE, bvhtree_range_count_cb, &count);
+    }
+  }
+  BLI_bvhtree_free(tree);
+
+  std::cout << "Count: " << count << "\n";
+}
+
+}  // namespace blender::tests
@@ -20,6 +20,8 @@
  * \brief defines for blend-file codes.
  */
 
+#include "BLI_sys_types.h"
+
 /* INTEGER CODES */
 #ifdef __BIG_ENDIAN__
 /* Big Endian */
@@ -71,3 +73,35 @@ enum {
 };
 
 #define BLEN_THUMB_MEMSIZE_FILE(_x, _y) (sizeof(int) * (2 + (size_t)(_x) * (size_t)(_y)))
+
+/**
+ * Optional index of the blocks of a file, letting readers seek directly to the blocks they need
+ * instead of walking over all blocks of (possibly huge) files.
+ *
+ * Stored as an array of #BlendBlockIndexEntry followed by a #BlendBlockIndexFooter, in a #DATA
+ * block that is the last one before #ENDB (so it is skipped by readers not aware of it).
+ * Only written to regular files, using the byte order of the file.
+ */
+typedef struct BlendBlockIndexEntry {
+  /** #BHead.code. */
+  int code;
+  int _pad;
+  /** File offset of the #BHead. */
+  uint64_t offset;
+  /** #BHead.old. */
+  uint64_t old;
+  /** ID name (including the two letters ID code) for ID blocks, empty otherwise. */
+  char name[66]; /* MAX_ID_NAME */
+  char _pad1[6];
+} BlendBlockIndexEntry;
+
+typedef struct BlendBlockIndexFooter {
+  /** File offset of the first #BlendBlockIndexEntry. */
+  uint64_t entries_offset;
+  int entries_len;
+  int _pad;
+  /** #BLEN_BLOCK_INDEX_MAGIC. */
+  char magic[8];
+} BlendBlockIndexFooter;
+
+#define BLEN_BLOCK_INDEX_MAGIC "BLKINDX1"
@@ -73,6 +73,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+bool BLO_memfile_chunks_reuse(MemFileWriteData *mem_data);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
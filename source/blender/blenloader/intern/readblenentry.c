@@ -143,17 +143,14 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh, int ofblocktype,
   LinkNode *names = NULL;
   BHead *bhead;
   int tot = 0;
+  int iter;
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == ofblocktype) {
-      const char *idname = blo_bhead_id_name(fd, bhead);
+  for (bhead = blo_bhead_first_of_code(fd, ofblocktype, &iter); bhead;
+       bhead = blo_bhead_next_of_code(fd, ofblocktype, bhead, &iter)) {
+    const char *idname = blo_bhead_id_name(fd, bhead);
 
-      BLI_linklist_prepend(&names, BLI_strdup(idname + 2));
-      tot++;
-    }
-    else if (bhead->code == ENDB) {
-      break;
-    }
+    BLI_linklist_prepend(&names, BLI_strdup(idname + 2));
+    tot++;
   }
 
   *tot_names = tot;
@@ -176,29 +173,23 @@ LinkNode *BLO_blendhandle_get_datablock_info(BlendHandle *bh, int ofblocktype, i
   LinkNode *infos = NULL;
   BHead *bhead;
   int tot = 0;
+  int iter;
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == ofblocktype) {
-      struct BLODataBlockInfo *info = MEM_mallocN(sizeof(*info), __func__);
-      const char *name = blo_bhead_id_name(fd, bhead) + 2;
-
-      STRNCPY(info->name, name);
-
-      /* Lastly, read asset data from the following blocks. */
-      info->asset_data = blo_bhead_id_asset_data_address(fd, bhead);
-      if (info->asset_data) {
-        bhead = blo_read_asset_data_block(fd, bhead, &info->asset_data);
-        /* blo_read_asset_data_block() reads all DATA heads and already advances bhead to the next
-         * non-DATA one. Go back, so the loop doesn't skip the non-DATA head. */
-        bhead = blo_bhead_prev(fd, bhead);
-      }
+  for (bhead = blo_bhead_first_of_code(fd, ofblocktype, &iter); bhead;
+       bhead = blo_bhead_next_of_code(fd, ofblocktype, bhead, &iter)) {
+    struct BLODataBlockInfo *info = MEM_mallocN(sizeof(*info), __func__);
+    const char *name = blo_bhead_id_name(fd, bhead) + 2;
 
-      BLI_linklist_prepend(&infos, info);
-      tot++;
-    }
-    else if (bhead->code == ENDB) {
-      break;
+    STRNCPY(info->name, name);
+
+    /* Lastly, read asset data from the following blocks. */
+    info->asset_data = blo_bhead_id_asset_data_address(fd, bhead);
+    if (info->asset_data) {
+      blo_read_asset_data_block(fd, bhead, &info->asset_data);
     }
+
+    BLI_linklist_prepend(&infos, info);
+    tot++;
   }
 
   *tot_info_items = tot;
@@ -219,79 +210,72 @@ LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *to
   FileData *fd = (FileData *)bh;
   LinkNode *previews = NULL;
   BHead *bhead;
-  int looking = 0;
   PreviewImage *prv = NULL;
   PreviewImage *new_prv = NULL;
   int tot = 0;
+  int iter;
+
+  for (bhead = blo_bhead_first_of_code(fd, ofblocktype, &iter); bhead;
+       bhead = blo_bhead_next_of_code(fd, ofblocktype, bhead, &iter)) {
+    const char *idname = blo_bhead_id_name(fd, bhead);
+    switch (GS(idname)) {
+      case ID_MA:  /* fall through */
+      case ID_TE:  /* fall through */
+      case ID_IM:  /* fall through */
+      case ID_WO:  /* fall through */
+      case ID_LA:  /* fall through */
+      case ID_OB:  /* fall through */
+      case ID_GR:  /* fall through */
+      case ID_SCE: /* fall through */
+        new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
+        BLI_linklist_prepend(&previews, new_prv);
+        tot++;
+        break;
+      default:
+        continue;
+    }
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == ofblocktype) {
-      const char *idname = blo_bhead_id_name(fd, bhead);
-      switch (GS(idname)) {
-        case ID_MA:  /* fall through */
-        case ID_TE:  /* fall through */
-        case ID_IM:  /* fall through */
-        case ID_WO:  /* fall through */
-        case ID_LA:  /* fall through */
-        case ID_OB:  /* fall through */
-        case ID_GR:  /* fall through */
-        case ID_SCE: /* fall through */
-          new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
-          BLI_linklist_prepend(&previews, new_prv);
-          tot++;
-          looking = 1;
-          break;
-        default:
-          break;
+    /* The preview is stored in the DATA blocks following the ID block. */
+    for (BHead *bhead_data = blo_bhead_next(fd, bhead); bhead_data && bhead_data->code == DATA;
+         bhead_data = blo_bhead_next(fd, bhead_data)) {
+      if (bhead_data->SDNAnr != DNA_struct_find_nr(fd->filesdna, "PreviewImage")) {
+        continue;
       }
-    }
-    else if (bhead->code == DATA) {
-      if (looking) {
-        if (bhead->SDNAnr == DNA_struct_find_nr(fd->filesdna, "PreviewImage")) {
-          prv = BLO_library_read_struct(fd, bhead, "PreviewImage");
-
-          if (prv) {
-            memcpy(new_prv, prv, sizeof(PreviewImage));
-            if (prv->rect[0] && prv->w[0] && prv->h[0]) {
-              bhead = blo_bhead_next(fd, bhead);
-              BLI_assert((new_prv->w[0] * new_prv->h[0] * sizeof(uint)) == bhead->len);
-              new_prv->rect[0] = BLO_library_read_struct(fd, bhead, "PreviewImage Icon Rect");
-            }
-            else {
-              /* This should not be needed, but can happen in 'broken' .blend files,
-               * better handle this gracefully than crashing. */
-              BLI_assert(prv->rect[0] == NULL && prv->w[0] == 0 && prv->h[0] == 0);
-              new_prv->rect[0] = NULL;
-              new_prv->w[0] = new_prv->h[0] = 0;
-            }
-            BKE_previewimg_finish(new_prv, 0);
-
-            if (prv->rect[1] && prv->w[1] && prv->h[1]) {
-              bhead = blo_bhead_next(fd, bhead);
-              BLI_assert((new_prv->w[1] * new_prv->h[1] * sizeof(uint)) == bhead->len);
-              new_prv->rect[1] = BLO_library_read_struct(fd, bhead, "PreviewImage Image Rect");
-            }
-            else {
-              /* This should not be needed, but can happen in 'broken' .blend files,
-               * better handle this gracefully than crashing. */
-              BLI_assert(prv->rect[1] == NULL && prv->w[1] == 0 && prv->h[1] == 0);
-              new_prv->rect[1] = NULL;
-              new_prv->w[1] = new_prv->h[1] = 0;
-            }
-            BKE_previewimg_finish(new_prv, 1);
-            MEM_freeN(prv);
-          }
+      prv = BLO_library_read_struct(fd, bhead_data, "PreviewImage");
+
+      if (prv) {
+        memcpy(new_prv, prv, sizeof(PreviewImage));
+        if (prv->rect[0] && prv->w[0] && prv->h[0]) {
+          bhead_data = blo_bhead_next(fd, bhead_data);
+          BLI_assert((new_prv->w[0] * new_prv->h[0] * sizeof(uint)) == bhead_data->len);
+          new_prv->rect[0] = BLO_library_read_struct(fd, bhead_data, "PreviewImage Icon Rect");
         }
+        else {
+          /* This should not be needed, but can happen in 'broken' .blend files,
+           * better handle this gracefully than crashing. */
+          BLI_assert(prv->rect[0] == NULL && prv->w[0] == 0 && prv->h[0] == 0);
+          new_prv->rect[0] = NULL;
+          new_prv->w[0] = new_prv->h[0] = 0;
+        }
+        BKE_previewimg_finish(new_prv, 0);
+
+        if (prv->rect[1] && prv->w[1] && prv->h[1]) {
+          bhead_data = blo_bhead_next(fd, bhead_data);
+          BLI_assert((new_prv->w[1] * new_prv->h[1] * sizeof(uint)) == bhead_data->len);
+          new_prv->rect[1] = BLO_library_read_struct(fd, bhead_data, "PreviewImage Image Rect");
+        }
+        else {
+          /* This should not be needed, but can happen in 'broken' .blend files,
+           * better handle this gracefully than crashing. */
+          BLI_assert(prv->rect[1] == NULL && prv->w[1] == 0 && prv->h[1] == 0);
+          new_prv->rect[1] = NULL;
+          new_prv->w[1] = new_prv->h[1] = 0;
+        }
+        BKE_previewimg_finish(new_prv, 1);
+        MEM_freeN(prv);
       }
-    }
-    else if (bhead->code == ENDB) {
       break;
     }
-    else {
-      looking = 0;
-      new_prv = NULL;
-      prv = NULL;
-    }
   }
 
   *tot_prev = tot;
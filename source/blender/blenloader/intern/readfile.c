@@ -69,6 +69,7 @@
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
@@ -100,6 +101,8 @@
 
 #include "DEG_depsgraph.h"
 
+#include "PIL_time.h"
+
 #include "BLO_blend_defs.h"
 #include "BLO_blend_validate.h"
 #include "BLO_read_write.h"
@@ -112,6 +115,7 @@
 #include "SEQ_sequencer.h"
 
 #include "readfile.h"
+#include "readfile_oldnewmap.h"
 
 #include <errno.h>
 
@@ -177,9 +181,29 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Read and reconstruct the DATA blocks of an ID in parallel when they are backed by a
+ * memory-mapped file. Memory-mapped reads don't depend on the file position,
+ * so multiple threads can read (and DNA-reconstruct) different blocks at once.
+ *
+ * \note Depends on #USE_BHEAD_READ_ON_DEMAND since only delayed blocks are read this way.
+ */
+#define USE_BHEAD_PARALLEL_READ
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
+/**
+ * Use the block index stored at the end of files (see #BlendBlockIndexEntry) to read only the
+ * blocks which are needed, instead of reading all blocks from the start of the file.
+ *
+ * #FileData.bhead_list is kept sorted by file offset, blocks which haven't been read yet are
+ * read when iterating over the list.
+ *
+ * \note Depends on #USE_BHEAD_READ_ON_DEMAND since the file needs to support seeking.
+ */
+#define USE_BHEAD_INDEX
+
 /* Use GHash for restoring pointers by name */
 #define USE_GHASH_RESTORE_POINTER
 
@@ -206,6 +230,11 @@ typedef struct BHeadN {
   off64_t file_offset;
   /** When set, the remainder of this allocation is the data, otherwise it needs to be read. */
   bool has_data;
+#endif
+#ifdef USE_BHEAD_INDEX
+  /** File offsets of the #BHead and of the following block. */
+  off64_t bhead_offset;
+  off64_t bhead_offset_next;
 #endif
   bool is_memchunk_identical;
   struct BHead bhead;
@@ -251,148 +280,15 @@ static const char *library_parent_filepath(Library *lib)
 
 /* -------------------------------------------------------------------- */
 /** \name OldNewMap API
+ *
+ * See `readfile_oldnewmap.cc` for the implementation.
  * \{ */
 
-typedef struct OldNew {
-  const void *oldp;
-  void *newp;
-  /* `nr` is "user count" for data, and ID code for libdata. */
-  int nr;
-} OldNew;
-
-typedef struct OldNewMap {
-  /* Array that stores the actual entries. */
-  OldNew *entries;
-  int nentries;
-  /* Hashmap that stores indices into the `entries` array. */
-  int32_t *map;
-
-  int capacity_exp;
-} OldNewMap;
-
-#define ENTRIES_CAPACITY(onm) (1ll << (onm)->capacity_exp)
-#define MAP_CAPACITY(onm) (1ll << ((onm)->capacity_exp + 1))
-#define SLOT_MASK(onm) (MAP_CAPACITY(onm) - 1)
-#define DEFAULT_SIZE_EXP 6
-#define PERTURB_SHIFT 5
-
-/* based on the probing algorithm used in Python dicts. */
-#define ITER_SLOTS(onm, KEY, SLOT_NAME, INDEX_NAME) \
-  uint32_t hash = BLI_ghashutil_ptrhash(KEY); \
-  uint32_t mask = SLOT_MASK(onm); \
-  uint perturb = hash; \
-  int SLOT_NAME = mask & hash; \
-  int INDEX_NAME = onm->map[SLOT_NAME]; \
-  for (;; SLOT_NAME = mask & ((5 * SLOT_NAME) + 1 + perturb), \
-          perturb >>= PERTURB_SHIFT, \
-          INDEX_NAME = onm->map[SLOT_NAME])
-
-static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int index)
-{
-  ITER_SLOTS (onm, ptr, slot, stored_index) {
-    if (stored_index == -1) {
-      onm->map[slot] = index;
-      break;
-    }
-  }
-}
-
-static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
-{
-  ITER_SLOTS (onm, entry.oldp, slot, index) {
-    if (index == -1) {
-      onm->entries[onm->nentries] = entry;
-      onm->map[slot] = onm->nentries;
-      onm->nentries++;
-      break;
-    }
-    if (onm->entries[index].oldp == entry.oldp) {
-      onm->entries[index] = entry;
-      break;
-    }
-  }
-}
-
-static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
-{
-  ITER_SLOTS (onm, addr, slot, index) {
-    if (index >= 0) {
-      OldNew *entry = &onm->entries[index];
-      if (entry->oldp == addr) {
-        return entry;
-      }
-    }
-    else {
-      return NULL;
-    }
-  }
-}
-
-static void oldnewmap_clear_map(OldNewMap *onm)
-{
-  memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
-}
-
-static void oldnewmap_increase_size(OldNewMap *onm)
-{
-  onm->capacity_exp++;
-  onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
-  onm->map = MEM_reallocN(onm->map, sizeof(*onm->map) * MAP_CAPACITY(onm));
-  oldnewmap_clear_map(onm);
-  for (int i = 0; i < onm->nentries; i++) {
-    oldnewmap_insert_index_in_map(onm, onm->entries[i].oldp, i);
-  }
-}
-
-/* Public OldNewMap API */
-
-static OldNewMap *oldnewmap_new(void)
-{
-  OldNewMap *onm = MEM_callocN(sizeof(*onm), "OldNewMap");
-
-  onm->capacity_exp = DEFAULT_SIZE_EXP;
-  onm->entries = MEM_malloc_arrayN(
-      ENTRIES_CAPACITY(onm), sizeof(*onm->entries), "OldNewMap.entries");
-  onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
-  oldnewmap_clear_map(onm);
-
-  return onm;
-}
-
-static void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
-{
-  if (oldaddr == NULL || newaddr == NULL) {
-    return;
-  }
-
-  if (UNLIKELY(onm->nentries == ENTRIES_CAPACITY(onm))) {
-    oldnewmap_increase_size(onm);
-  }
-
-  OldNew entry;
-  entry.oldp = oldaddr;
-  entry.newp = newaddr;
-  entry.nr = nr;
-  oldnewmap_insert_or_replace(onm, entry);
-}
-
 void blo_do_versions_oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
 {
   oldnewmap_insert(onm, oldaddr, newaddr, nr);
 }
 
-static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool increase_users)
-{
-  OldNew *entry = oldnewmap_lookup_entry(onm, addr);
-  if (entry == NULL) {
-    return NULL;
-  }
-  if (increase_users) {
-    entry->nr++;
-  }
-  return entry->newp;
-}
-
 /* for libdata, OldNew.nr has ID code, no increment */
 static void *oldnewmap_liblookup(OldNewMap *onm, const void *addr, const void *lib)
 {
@@ -410,36 +306,6 @@ static void *oldnewmap_liblookup(OldNewMap *onm, const void *addr, const void *l
   return NULL;
 }
 
-static void oldnewmap_clear(OldNewMap *onm)
-{
-  /* Free unused data. */
-  for (int i = 0; i < onm->nentries; i++) {
-    OldNew *entry = &onm->entries[i];
-    if (entry->nr == 0) {
-      MEM_freeN(entry->newp);
-      entry->newp = NULL;
-    }
-  }
-
-  onm->capacity_exp = DEFAULT_SIZE_EXP;
-  oldnewmap_clear_map(onm);
-  onm->nentries = 0;
-}
-
-static void oldnewmap_free(OldNewMap *onm)
-{
-  MEM_freeN(onm->entries);
-  MEM_freeN(onm->map);
-  MEM_freeN(onm);
-}
-
-#undef ENTRIES_CAPACITY
-#undef MAP_CAPACITY
-#undef SLOT_MASK
-#undef DEFAULT_SIZE_EXP
-#undef PERTURB_SHIFT
-#undef ITER_SLOTS
-
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -532,20 +398,16 @@ void blo_split_main(ListBase *mainlist, Main *main)
 
 static void read_file_version(FileData *fd, Main *main)
 {
-  BHead *bhead;
+  int iter;
+  BHead *bhead = blo_bhead_first_of_code(fd, GLOB, &iter);
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == GLOB) {
-      FileGlobal *fg = read_struct(fd, bhead, "Global");
-      if (fg) {
-        main->subversionfile = fg->subversion;
-        main->minversionfile = fg->minversion;
-        main->minsubversionfile = fg->minsubversion;
-        MEM_freeN(fg);
-      }
-      else if (bhead->code == ENDB) {
-        break;
-      }
+  if (bhead != NULL) {
+    FileGlobal *fg = read_struct(fd, bhead, "Global");
+    if (fg) {
+      main->subversionfile = fg->subversion;
+      main->minversionfile = fg->minversion;
+      main->minsubversionfile = fg->minsubversion;
+      MEM_freeN(fg);
     }
   }
   if (main->curlib) {
@@ -564,6 +426,22 @@ static void read_file_bhead_idname_map_create(FileData *fd)
   int code_prev = ENDB;
   uint reserve = 0;
 
+#  ifdef USE_BHEAD_INDEX
+  /* Map the names to index entries, only reading the blocks which are looked up. */
+  if (fd->block_index != NULL) {
+    BLI_assert(fd->block_index_idname_hash == NULL);
+    fd->block_index_idname_hash = BLI_ghash_str_new_ex(__func__, (uint)fd->block_index_len);
+    for (int i = 0; i < fd->block_index_len; i++) {
+      BlendBlockIndexEntry *entry = &fd->block_index[i];
+      if (BKE_idtype_idcode_is_valid(entry->code) &&
+          BKE_idtype_idcode_is_linkable(entry->code)) {
+        BLI_ghash_insert(fd->block_index_idname_hash, entry->name, entry);
+      }
+    }
+    return;
+  }
+#  endif
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (code_prev != bhead->code) {
       code_prev = bhead->code;
@@ -733,10 +611,14 @@ static void bh8_from_bh4(BHead *bhead, BHead4 *bhead4)
   }
 }
 
-static BHeadN *get_bhead(FileData *fd)
+/** Read the block at the current file position. */
+static BHeadN *read_bhead(FileData *fd)
 {
   BHeadN *new_bhead = NULL;
   ssize_t readsize;
+#ifdef USE_BHEAD_INDEX
+  const off64_t bhead_offset = fd ? fd->file_offset : 0;
+#endif
 
   if (fd) {
     if (!fd->is_eof) {
@@ -861,6 +743,20 @@ static BHeadN *get_bhead(FileData *fd)
     }
   }
 
+#ifdef USE_BHEAD_INDEX
+  if (new_bhead) {
+    new_bhead->bhead_offset = bhead_offset;
+    new_bhead->bhead_offset_next = fd->file_offset;
+  }
+#endif
+
+  return new_bhead;
+}
+
+static BHeadN *get_bhead(FileData *fd)
+{
+  BHeadN *new_bhead = read_bhead(fd);
+
   /* We've read a new block. Now add it to the list
    * of blocks.
    */
@@ -871,6 +767,121 @@ static BHeadN *get_bhead(FileData *fd)
   return new_bhead;
 }
 
+#ifdef USE_BHEAD_INDEX
+/**
+ * Get the block at \a offset, reading it when it's not in #FileData.bhead_list yet.
+ * \a prev must be the block before \a offset in the list (NULL to insert at the start).
+ */
+static BHeadN *get_bhead_at_offset(FileData *fd, BHeadN *prev, const off64_t offset)
+{
+  BHeadN *next = prev ? prev->next : fd->bhead_list.first;
+  if (next != NULL && next->bhead_offset == offset) {
+    return next;
+  }
+  BLI_assert(next == NULL || next->bhead_offset > offset);
+
+  if (fd->seek(fd, offset, SEEK_SET) == -1) {
+    return NULL;
+  }
+  fd->is_eof = false;
+
+  BHeadN *new_bhead = read_bhead(fd);
+  if (new_bhead != NULL) {
+    if (next != NULL && new_bhead->bhead_offset_next > next->bhead_offset) {
+      /* Overlaps the next block, the offset isn't the start of a block. */
+      MEM_freeN(new_bhead);
+      return NULL;
+    }
+    BLI_insertlinkafter(&fd->bhead_list, prev, new_bhead);
+  }
+  return new_bhead;
+}
+
+/** Find the last block in #FileData.bhead_list before \a offset. */
+static BHeadN *bhead_list_find_prev(FileData *fd, const off64_t offset)
+{
+  /* Search backwards, blocks are mostly accessed in file order. */
+  BHeadN *prev = fd->bhead_list.last;
+  while (prev != NULL && prev->bhead_offset >= offset) {
+    prev = prev->prev;
+  }
+  return prev;
+}
+
+static BHead *bhead_from_index_entry(FileData *fd, const BlendBlockIndexEntry *entry)
+{
+  const off64_t offset = (off64_t)entry->offset;
+  BHeadN *prev = bhead_list_find_prev(fd, offset);
+  BHeadN *next = prev ? prev->next : fd->bhead_list.first;
+  const bool is_read = (next != NULL && next->bhead_offset == offset);
+
+  BHeadN *new_bhead = get_bhead_at_offset(fd, prev, offset);
+  if (new_bhead == NULL) {
+    return NULL;
+  }
+  /* Don't trust the index blindly, the file may have been modified by other software. */
+  if (new_bhead->bhead.code != entry->code) {
+    if (!is_read) {
+      BLI_remlink(&fd->bhead_list, new_bhead);
+      MEM_freeN(new_bhead);
+    }
+    return NULL;
+  }
+  return &new_bhead->bhead;
+}
+
+static BHead *bhead_index_next_of_code(FileData *fd, const int code, int *r_iter)
+{
+  for (int i = *r_iter; i < fd->block_index_len; i++) {
+    if (fd->block_index[i].code == code) {
+      *r_iter = i + 1;
+      return bhead_from_index_entry(fd, &fd->block_index[i]);
+    }
+  }
+  *r_iter = fd->block_index_len;
+  return NULL;
+}
+
+/**
+ * Read the block index at the end of the file, when it has one.
+ * Ignored for files with a different byte order.
+ */
+static void read_file_block_index(FileData *fd)
+{
+  if (fd->seek == NULL || fd->memfile != NULL || (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return;
+  }
+
+  const off64_t offset_backup = fd->file_offset;
+  const size_t endb_size = (fd->flags & FD_FLAGS_FILE_POINTSIZE_IS_4) ? sizeof(BHead4) :
+                                                                        sizeof(BHead8);
+  const off64_t file_size = fd->seek(fd, 0, SEEK_END);
+  const off64_t footer_offset = file_size - (off64_t)(endb_size + sizeof(BlendBlockIndexFooter));
+
+  BlendBlockIndexFooter footer;
+  if (file_size != -1 && footer_offset > SIZEOFBLENDERHEADER &&
+      fd->seek(fd, footer_offset, SEEK_SET) != -1 &&
+      fd->read(fd, &footer, sizeof(footer), NULL) == sizeof(footer) &&
+      memcmp(footer.magic, BLEN_BLOCK_INDEX_MAGIC, sizeof(footer.magic)) == 0 &&
+      footer.entries_len > 0 &&
+      footer.entries_offset + (uint64_t)footer.entries_len * sizeof(BlendBlockIndexEntry) ==
+          (uint64_t)footer_offset) {
+    const size_t entries_size = sizeof(BlendBlockIndexEntry) * (size_t)footer.entries_len;
+    BlendBlockIndexEntry *entries = MEM_mallocN(entries_size, __func__);
+    if (fd->seek(fd, (off64_t)footer.entries_offset, SEEK_SET) != -1 &&
+        fd->read(fd, entries, entries_size, NULL) == (ssize_t)entries_size) {
+      fd->block_index = entries;
+      fd->block_index_len = footer.entries_len;
+    }
+    else {
+      MEM_freeN(entries);
+    }
+  }
+
+  fd->seek(fd, offset_backup, SEEK_SET);
+}
+#endif /* USE_BHEAD_INDEX */
+
 BHead *blo_bhead_first(FileData *fd)
 {
   BHeadN *new_bhead;
@@ -879,9 +890,17 @@ BHead *blo_bhead_first(FileData *fd)
   /* Rewind the file
    * Read in a new block if necessary
    */
-  new_bhead = fd->bhead_list.first;
-  if (new_bhead == NULL) {
-    new_bhead = get_bhead(fd);
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL) {
+    new_bhead = get_bhead_at_offset(fd, NULL, SIZEOFBLENDERHEADER);
+  }
+  else
+#endif
+  {
+    new_bhead = fd->bhead_list.first;
+    if (new_bhead == NULL) {
+      new_bhead = get_bhead(fd);
+    }
   }
 
   if (new_bhead) {
@@ -891,11 +910,28 @@ BHead *blo_bhead_first(FileData *fd)
   return bhead;
 }
 
-BHead *blo_bhead_prev(FileData *UNUSED(fd), BHead *thisblock)
+BHead *blo_bhead_prev(FileData *fd, BHead *thisblock)
 {
   BHeadN *bheadn = BHEADN_FROM_BHEAD(thisblock);
   BHeadN *prev = bheadn->prev;
 
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL && bheadn->bhead_offset > SIZEOFBLENDERHEADER &&
+      (prev == NULL || prev->bhead_offset_next != bheadn->bhead_offset)) {
+    /* Blocks can only be read forward, read the ones missing before this one. */
+    BHead *bhead = (prev != NULL) ? &prev->bhead : blo_bhead_first(fd);
+    while (bhead != NULL && BHEADN_FROM_BHEAD(bhead)->bhead_offset_next < bheadn->bhead_offset) {
+      bhead = blo_bhead_next(fd, bhead);
+    }
+    prev = bhead ? BHEADN_FROM_BHEAD(bhead) : NULL;
+    if (prev != NULL && prev->bhead_offset_next != bheadn->bhead_offset) {
+      prev = NULL;
+    }
+  }
+#else
+  UNUSED_VARS(fd);
+#endif
+
   return (prev) ? &prev->bhead : NULL;
 }
 
@@ -910,9 +946,17 @@ BHead *blo_bhead_next(FileData *fd, BHead *thisblock)
     new_bhead = BHEADN_FROM_BHEAD(thisblock);
 
     /* get the next BHeadN. If it doesn't exist we read in the next one */
-    new_bhead = new_bhead->next;
-    if (new_bhead == NULL) {
-      new_bhead = get_bhead(fd);
+#ifdef USE_BHEAD_INDEX
+    if (fd->block_index != NULL) {
+      new_bhead = get_bhead_at_offset(fd, new_bhead, new_bhead->bhead_offset_next);
+    }
+    else
+#endif
+    {
+      new_bhead = new_bhead->next;
+      if (new_bhead == NULL) {
+        new_bhead = get_bhead(fd);
+      }
     }
   }
 
@@ -925,12 +969,57 @@ BHead *blo_bhead_next(FileData *fd, BHead *thisblock)
   return bhead;
 }
 
+/**
+ * Iterate over the blocks with the given \a code, using the block index of the file to only read
+ * those when possible. \a r_iter is used to keep track of the iteration state.
+ */
+BHead *blo_bhead_first_of_code(FileData *fd, const int code, int *r_iter)
+{
+  *r_iter = 0;
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL) {
+    return bhead_index_next_of_code(fd, code, r_iter);
+  }
+#endif
+  BHead *bhead = blo_bhead_first(fd);
+  if (bhead != NULL && bhead->code != code) {
+    bhead = blo_bhead_next_of_code(fd, code, bhead, r_iter);
+  }
+  return bhead;
+}
+
+BHead *blo_bhead_next_of_code(FileData *fd, const int code, BHead *thisblock, int *r_iter)
+{
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL) {
+    return bhead_index_next_of_code(fd, code, r_iter);
+  }
+#else
+  UNUSED_VARS(r_iter);
+#endif
+  for (BHead *bhead = blo_bhead_next(fd, thisblock); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == code) {
+      return bhead;
+    }
+    if (bhead->code == ENDB) {
+      break;
+    }
+  }
+  return NULL;
+}
+
 #ifdef USE_BHEAD_READ_ON_DEMAND
 static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
 {
   bool success = true;
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
   BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->mmap_file != NULL) {
+    /* Read directly from the mapped memory, leaving the file offset untouched,
+     * this is thread-safe (see #USE_BHEAD_PARALLEL_READ). */
+    return BLI_mmap_read(
+        fd->mmap_file, buf, (size_t)new_bhead->file_offset, (size_t)new_bhead->bhead.len);
+  }
   off64_t offset_backup = fd->file_offset;
   if (UNLIKELY(fd->seek(fd, new_bhead->file_offset, SEEK_SET) == -1)) {
     success = false;
@@ -1023,52 +1112,67 @@ static void decode_blender_header(FileData *fd)
  */
 static bool read_file_dna(FileData *fd, const char **r_error_message)
 {
-  BHead *bhead;
-  int subversion = 0;
+  BHead *bhead_glob = NULL;
+  BHead *bhead_dna = NULL;
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == GLOB) {
-      /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
-       * value isn't accessible for the purpose of DNA versioning in this case. */
-      if (fd->fileversion <= 242) {
-        continue;
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL) {
+    int iter;
+    bhead_glob = blo_bhead_first_of_code(fd, GLOB, &iter);
+    bhead_dna = blo_bhead_first_of_code(fd, DNA1, &iter);
+  }
+  if (bhead_dna == NULL)
+#endif
+  {
+    for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+      if (bhead->code == GLOB) {
+        bhead_glob = bhead;
       }
-      /* We can't use read_global because this needs 'DNA1' to be decoded,
-       * however the first 4 chars are _always_ the subversion. */
-      FileGlobal *fg = (void *)&bhead[1];
-      BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
-      char num[5];
-      memcpy(num, fg->subvstr, 4);
-      num[4] = 0;
-      subversion = atoi(num);
-    }
-    else if (bhead->code == DNA1) {
-      const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+      else if (bhead->code == DNA1) {
+        bhead_dna = bhead;
+        break;
+      }
+      else if (bhead->code == ENDB) {
+        break;
+      }
+    }
+  }
 
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        fd->reconstruct_info = DNA_reconstruct_info_create(
-            fd->filesdna, fd->memsdna, fd->compflags);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offs = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
-        BLI_assert(fd->id_name_offs != -1);
-        fd->id_asset_data_offs = DNA_elem_offset(
-            fd->filesdna, "ID", "AssetMetaData", "*asset_data");
+  if (bhead_dna == NULL) {
+    *r_error_message = "Missing DNA block";
+    return false;
+  }
 
-        return true;
-      }
+  int subversion = 0;
+  /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
+   * value isn't accessible for the purpose of DNA versioning in this case. */
+  if (bhead_glob != NULL && fd->fileversion > 242) {
+    /* We can't use read_global because this needs 'DNA1' to be decoded,
+     * however the first 4 chars are _always_ the subversion. */
+    FileGlobal *fg = (void *)&bhead_glob[1];
+    BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
+    char num[5];
+    memcpy(num, fg->subvstr, 4);
+    num[4] = 0;
+    subversion = atoi(num);
+  }
+
+  const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+
+  fd->filesdna = DNA_sdna_from_data(
+      &bhead_dna[1], bhead_dna->len, do_endian_swap, true, r_error_message);
+  if (fd->filesdna) {
+    blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
+    fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
+    fd->reconstruct_info = DNA_reconstruct_info_create(fd->filesdna, fd->memsdna, fd->compflags);
+    /* used to retrieve ID names from (bhead+1) */
+    fd->id_name_offs = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
+    BLI_assert(fd->id_name_offs != -1);
+    fd->id_asset_data_offs = DNA_elem_offset(fd->filesdna, "ID", "AssetMetaData", "*asset_data");
 
-      return false;
-    }
-    else if (bhead->code == ENDB) {
-      break;
-    }
+    return true;
   }
 
-  *r_error_message = "Missing DNA block";
   return false;
 }
 
@@ -1322,6 +1426,12 @@ static FileData *filedata_new(void)
   fd->globmap = oldnewmap_new();
   fd->libmap = oldnewmap_new();
 
+  if (G.debug & G_DEBUG_IO) {
+    oldnewmap_stats_enable(fd->datamap);
+    oldnewmap_stats_enable(fd->globmap);
+    oldnewmap_stats_enable(fd->libmap);
+  }
+
   return fd;
 }
 
@@ -1330,6 +1440,9 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
   decode_blender_header(fd);
 
   if (fd->flags & FD_FLAGS_FILE_OK) {
+#ifdef USE_BHEAD_INDEX
+    read_file_block_index(fd);
+#endif
     const char *error_message = NULL;
     if (read_file_dna(fd, &error_message) == false) {
       BKE_reportf(
@@ -1489,6 +1602,15 @@ static ssize_t fd_read_gzip_from_memory(FileData *filedata,
   /* Inflate another chunk. */
   err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
+  /* Files may consist of multiple gzip members (written by threaded compression),
+   * continue with the next member while there is input left. */
+  while (err == Z_STREAM_END && filedata->strm.avail_in != 0) {
+    if (inflateReset(&filedata->strm) != Z_OK) {
+      break;
+    }
+    err = (filedata->strm.avail_out != 0) ? inflate(&filedata->strm, Z_SYNC_FLUSH) : Z_OK;
+  }
+
   if (err == Z_STREAM_END) {
     return 0;
   }
@@ -1618,6 +1740,13 @@ void blo_filedata_free(FileData *fd)
       DNA_reconstruct_info_free(fd->reconstruct_info);
     }
 
+    if (G.debug & G_DEBUG_IO) {
+      printf("Read '%s' pointer remapping:\n", fd->relabase);
+      oldnewmap_print_stats(fd->datamap, "  data");
+      oldnewmap_print_stats(fd->globmap, "  global");
+      oldnewmap_print_stats(fd->libmap, "  library");
+    }
+
     if (fd->datamap) {
       oldnewmap_free(fd->datamap);
     }
@@ -1633,10 +1762,22 @@ void blo_filedata_free(FileData *fd)
     if (fd->old_idmap != NULL) {
       BKE_main_idmap_destroy(fd->old_idmap);
     }
+    if (fd->old_libmain_idmap != NULL) {
+      BKE_main_idmap_destroy(fd->old_libmain_idmap);
+    }
     blo_cache_storage_end(fd);
     if (fd->bheadmap) {
       MEM_freeN(fd->bheadmap);
     }
+    if (fd->block_index) {
+      MEM_freeN(fd->block_index);
+    }
+    if (fd->block_index_idname_hash) {
+      BLI_ghash_free(fd->block_index_idname_hash, NULL, NULL);
+    }
+    if (fd->block_index_old_hash) {
+      BLI_ghash_free(fd->block_index_old_hash, NULL, NULL);
+    }
 
 #ifdef USE_GHASH_BHEAD
     if (fd->bhead_idname_hash) {
@@ -1823,20 +1964,28 @@ void *blo_do_versions_newlibadr(FileData *fd, const void *lib, const void *adr)
 }
 
 /* increases user number */
-static void change_link_placeholder_to_real_ID_pointer_fd(FileData *fd, const void *old, void *new)
-{
-  for (int i = 0; i < fd->libmap->nentries; i++) {
-    OldNew *entry = &fd->libmap->entries[i];
+typedef struct ChangeLinkPlaceholderData {
+  const void *old;
+  void *new;
+} ChangeLinkPlaceholderData;
 
-    if (old == entry->newp && entry->nr == ID_LINK_PLACEHOLDER) {
-      entry->newp = new;
-      if (new) {
-        entry->nr = GS(((ID *)new)->name);
-      }
+static void change_link_placeholder_to_real_ID_pointer_fn(OldNew *entry, void *user_data)
+{
+  ChangeLinkPlaceholderData *data = user_data;
+  if (data->old == entry->newp && entry->nr == ID_LINK_PLACEHOLDER) {
+    entry->newp = data->new;
+    if (data->new) {
+      entry->nr = GS(((ID *)data->new)->name);
     }
   }
 }
 
+static void change_link_placeholder_to_real_ID_pointer_fd(FileData *fd, const void *old, void *new)
+{
+  ChangeLinkPlaceholderData data = {old, new};
+  oldnewmap_foreach(fd->libmap, change_link_placeholder_to_real_ID_pointer_fn, &data);
+}
+
 static void change_link_placeholder_to_real_ID_pointer(ListBase *mainlist,
                                                        FileData *basefd,
                                                        void *old,
@@ -1925,16 +2074,17 @@ void blo_make_packed_pointer_map(FileData *fd, Main *oldmain)
 
 /* set old main packed data to zero if it has been restored */
 /* this works because freeing old main only happens after this call */
-void blo_end_packed_pointer_map(FileData *fd, Main *oldmain)
+static void end_packed_pointer_map_fn(OldNew *entry, void *UNUSED(user_data))
 {
-  OldNew *entry = fd->packedmap->entries;
+  if (entry->nr > 0) {
+    entry->newp = NULL;
+  }
+}
 
+void blo_end_packed_pointer_map(FileData *fd, Main *oldmain)
+{
   /* used entries were restored, so we put them to zero */
-  for (int i = 0; i < fd->packedmap->nentries; i++, entry++) {
-    if (entry->nr > 0) {
-      entry->newp = NULL;
-    }
-  }
+  oldnewmap_foreach(fd->packedmap, end_packed_pointer_map_fn, NULL);
 
   LISTBASE_FOREACH (Image *, ima, &oldmain->images) {
     ima->packedfile = newpackedadr(fd, ima->packedfile);
@@ -2150,7 +2300,13 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
-static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
+/**
+ * Read the data of \a bh as a newly allocated struct converted to the current DNA.
+ *
+ * Doesn't modify \a fd, so it can be called from multiple threads for different blocks
+ * when reading from a memory-mapped file, \a r_read_error is set on failure.
+ */
+static void *read_struct_ex(FileData *fd, BHead *bh, const char *blockname, bool *r_read_error)
 {
   void *temp = NULL;
 
@@ -2165,7 +2321,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
       if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
         bh = blo_bhead_read_full(fd, bh);
         if (UNLIKELY(bh == NULL)) {
-          fd->flags &= ~FD_FLAGS_FILE_OK;
+          *r_read_error = true;
           return NULL;
         }
       }
@@ -2179,7 +2335,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
           bh = blo_bhead_read_full(fd, bh);
           if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
+            *r_read_error = true;
             return NULL;
           }
         }
@@ -2197,7 +2353,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           /* Instead of allocating the bhead, then copying it,
            * read the data from the file directly into the memory. */
           if (UNLIKELY(!blo_bhead_read_data(fd, bh, temp))) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
+            *r_read_error = true;
             MEM_freeN(temp);
             temp = NULL;
           }
@@ -2218,6 +2374,16 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
   return temp;
 }
 
+static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
+{
+  bool read_error = false;
+  void *temp = read_struct_ex(fd, bh, blockname, &read_error);
+  if (UNLIKELY(read_error)) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+  }
+  return temp;
+}
+
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
@@ -3313,9 +3479,129 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_BHEAD_PARALLEL_READ
+
+/* Don't bother threading when there is little data to read, the overhead isn't worth it. */
+#  define BHEAD_PARALLEL_READ_MIN_BLOCKS 4
+#  define BHEAD_PARALLEL_READ_MIN_SIZE (1 << 20)
+
+typedef struct BHeadParallelReadData {
+  FileData *fd;
+  const char *allocname;
+  BHead **bheads;
+  void **data;
+  bool read_error;
+} BHeadParallelReadData;
+
+static void read_data_into_datamap_parallel_fn(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BHeadParallelReadData *data = userdata;
+  bool read_error = false;
+  data->data[i] = read_struct_ex(data->fd, data->bheads[i], data->allocname, &read_error);
+  if (UNLIKELY(read_error)) {
+    /* Only ever set, so no need for atomics. */
+    data->read_error = true;
+  }
+}
+
+/**
+ * Read all DATA blocks following \a bhead at once, reconstructing them on multiple threads.
+ *
+ * \param r_bhead_next: The first block following the DATA blocks.
+ * \return false when the data is too small for threading,
+ * in that case nothing has been read and the caller should read the blocks itself.
+ */
+static bool read_data_into_datamap_parallel(FileData *fd,
+                                            BHead *bhead,
+                                            const char *allocname,
+                                            BHead **r_bhead_next)
+{
+  BLI_assert(fd->mmap_file != NULL);
+
+  /* Index the blocks first, this only reads BHead's since DATA is read on demand.
+   * The array grows as needed, so the blocks are only walked once. */
+  int bheads_len = 0;
+  int bheads_alloc = 64;
+  BHead **bheads = MEM_malloc_arrayN(bheads_alloc, sizeof(*bheads), __func__);
+  size_t data_size = 0;
+  BHead *bhead_end = blo_bhead_next(fd, bhead);
+  while (bhead_end && bhead_end->code == DATA) {
+    BLI_assert(BHEADN_FROM_BHEAD(bhead_end)->has_data == false);
+    if (bheads_len == bheads_alloc) {
+      bheads_alloc *= 2;
+      bheads = MEM_reallocN(bheads, sizeof(*bheads) * (size_t)bheads_alloc);
+    }
+    bheads[bheads_len++] = bhead_end;
+    data_size += (size_t)bhead_end->len;
+    bhead_end = blo_bhead_next(fd, bhead_end);
+  }
+
+  if (bheads_len < BHEAD_PARALLEL_READ_MIN_BLOCKS || data_size < BHEAD_PARALLEL_READ_MIN_SIZE) {
+    MEM_freeN(bheads);
+    return false;
+  }
+
+  BHeadParallelReadData data = {
+      .fd = fd,
+      .allocname = allocname,
+      .bheads = bheads,
+      .data = MEM_calloc_arrayN(bheads_len, sizeof(*data.data), __func__),
+      .read_error = false,
+  };
+
+  int i;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, bheads_len, &data, read_data_into_datamap_parallel_fn, &settings);
+
+  if (UNLIKELY(data.read_error)) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+  }
+
+  /* Insert in file order, so duplicate addresses resolve the same way as serial reading. */
+  for (i = 0; i < bheads_len; i++) {
+    if (data.data[i]) {
+      oldnewmap_insert(fd->datamap, data.bheads[i]->old, data.data[i], 0);
+    }
+  }
+
+  MEM_freeN(data.bheads);
+  MEM_freeN(data.data);
+
+  *r_bhead_next = bhead_end;
+  return true;
+}
+
+#  undef BHEAD_PARALLEL_READ_MIN_BLOCKS
+#  undef BHEAD_PARALLEL_READ_MIN_SIZE
+
+#endif /* USE_BHEAD_PARALLEL_READ */
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
+  {
+    int data_bheads_len = 0;
+    for (BHead *bh = blo_bhead_next(fd, bhead); bh && bh->code == DATA;
+         bh = blo_bhead_next(fd, bh)) {
+      data_bheads_len++;
+    }
+    oldnewmap_reserve(fd->datamap, data_bheads_len);
+  }
+
+#ifdef USE_BHEAD_PARALLEL_READ
+  if (fd->mmap_file != NULL) {
+    BHead *bhead_next;
+    if (read_data_into_datamap_parallel(fd, bhead, allocname, &bhead_next)) {
+      return bhead_next;
+    }
+  }
+#endif
+
   bhead = blo_bhead_next(fd, bhead);
 
   while (bhead && bhead->code == DATA) {
@@ -3413,7 +3699,17 @@ static bool read_libblock_undo_restore_linked(FileData *fd, Main *main, const ID
                main->curlib ? main->curlib->id.name : "<NULL>",
                main->curlib ? main->curlib->filepath : "<NULL>");
 
-  ID *id_old = BKE_libblock_find_name(main, GS(id->name), id->name + 2);
+  /* All linked IDs of a library are restored one after the other, a map avoids searching the
+   * whole list of IDs of that type for each of them. */
+  if (fd->old_libmain_idmap == NULL || BKE_main_idmap_main_get(fd->old_libmain_idmap) != main) {
+    if (fd->old_libmain_idmap != NULL) {
+      BKE_main_idmap_destroy(fd->old_libmain_idmap);
+    }
+    fd->old_libmain_idmap = BKE_main_idmap_create(main, false, NULL, MAIN_IDMAP_TYPE_NAME);
+  }
+
+  ID *id_old = BKE_main_idmap_lookup_name(
+      fd->old_libmain_idmap, GS(id->name), id->name + 2, main->curlib);
   if (id_old != NULL) {
     DEBUG_PRINTF("  found!\n");
     /* Even though we found our linked ID, there is no guarantee its address
@@ -3797,6 +4093,66 @@ static void do_versions_userdef(FileData *UNUSED(fd), BlendFileData *bfd)
   blo_do_versions_userdef(user);
 }
 
+typedef struct DoVersionsIDParallelData {
+  ID **ids;
+  BLODoVersionsIDFn fn;
+  void *user_data;
+} DoVersionsIDParallelData;
+
+static void do_versions_id_parallel_fn(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DoVersionsIDParallelData *data = userdata;
+  data->fn(data->ids[i], data->user_data);
+}
+
+/**
+ * Run \a fn on all IDs of \a lb, using multiple threads.
+ *
+ * Only to be used for versioning which modifies each ID on its own: \a fn must not access any
+ * other ID or global data, nor add or remove IDs.
+ */
+void blo_do_versions_id_parallel(ListBase *lb, BLODoVersionsIDFn fn, void *user_data)
+{
+  const int ids_len = BLI_listbase_count(lb);
+  if (ids_len == 0) {
+    return;
+  }
+
+  ID **ids = MEM_malloc_arrayN(ids_len, sizeof(*ids), __func__);
+  int i = 0;
+  LISTBASE_FOREACH (ID *, id, lb) {
+    ids[i++] = id;
+  }
+
+  DoVersionsIDParallelData data = {
+      .ids = ids,
+      .fn = fn,
+      .user_data = user_data,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+  BLI_task_parallel_range(0, ids_len, &data, do_versions_id_parallel_fn, &settings);
+
+  MEM_freeN(ids);
+}
+
+/**
+ * Run a versioning pass, reporting the time spent in it with `--debug-io`,
+ * to find which ones are worth optimizing.
+ */
+#define DO_VERSIONS_PASS(pass) \
+  { \
+    const double _time_start = (G.debug & G_DEBUG_IO) ? PIL_check_seconds_timer() : 0.0; \
+    pass; \
+    if (G.debug & G_DEBUG_IO) { \
+      printf("  %s: %.3f ms\n", #pass, (PIL_check_seconds_timer() - _time_start) * 1e3); \
+    } \
+  } \
+  ((void)0)
+
 static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
@@ -3823,13 +4179,15 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
            main->build_hash);
   }
 
-  blo_do_versions_pre250(fd, lib, main);
-  blo_do_versions_250(fd, lib, main);
-  blo_do_versions_260(fd, lib, main);
-  blo_do_versions_270(fd, lib, main);
-  blo_do_versions_280(fd, lib, main);
-  blo_do_versions_290(fd, lib, main);
-  blo_do_versions_cycles(fd, lib, main);
+  /* The order matters, each pass relies on the ones before it.
+   * Use #blo_do_versions_id_parallel for independent per-ID changes inside a pass. */
+  DO_VERSIONS_PASS(blo_do_versions_pre250(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_250(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_260(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_270(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_280(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_290(fd, lib, main));
+  DO_VERSIONS_PASS(blo_do_versions_cycles(fd, lib, main));
 
   /* WATCH IT!!!: pointers from libdata have not been converted yet here! */
   /* WATCH IT 2!: Userdef struct init see do_versions_userdef() above! */
@@ -3847,16 +4205,18 @@ static void do_versions_after_linking(Main *main, ReportList *reports)
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
-  do_versions_after_linking_250(main);
-  do_versions_after_linking_260(main);
-  do_versions_after_linking_270(main);
-  do_versions_after_linking_280(main, reports);
-  do_versions_after_linking_290(main, reports);
-  do_versions_after_linking_cycles(main);
+  DO_VERSIONS_PASS(do_versions_after_linking_250(main));
+  DO_VERSIONS_PASS(do_versions_after_linking_260(main));
+  DO_VERSIONS_PASS(do_versions_after_linking_270(main));
+  DO_VERSIONS_PASS(do_versions_after_linking_280(main, reports));
+  DO_VERSIONS_PASS(do_versions_after_linking_290(main, reports));
+  DO_VERSIONS_PASS(do_versions_after_linking_cycles(main));
 
   main->is_locked_for_linking = false;
 }
 
+#undef DO_VERSIONS_PASS
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -4089,6 +4449,18 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  /* The blocks have all been indexed when reading the DNA, count the ID's to avoid growing the
+   * library map while reading. */
+  {
+    int id_bheads_len = 0;
+    for (BHead *bh = bhead; bh; bh = blo_bhead_next(fd, bh)) {
+      if (BKE_idtype_idcode_is_valid(bh->code)) {
+        id_bheads_len++;
+      }
+    }
+    oldnewmap_reserve(fd->libmap, id_bheads_len);
+  }
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -4268,6 +4640,29 @@ static BHead *find_previous_lib(FileData *fd, BHead *bhead)
     return NULL;
   }
 
+#ifdef USE_BHEAD_INDEX
+  if (fd->block_index != NULL) {
+    /* Binary search for the first entry at or after the block, entries are in file order. */
+    const uint64_t offset = (uint64_t)BHEADN_FROM_BHEAD(bhead)->bhead_offset;
+    int lo = 0, hi = fd->block_index_len;
+    while (lo < hi) {
+      const int mid = (lo + hi) / 2;
+      if (fd->block_index[mid].offset < offset) {
+        lo = mid + 1;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    for (int i = lo - 1; i >= 0; i--) {
+      if (fd->block_index[i].code == ID_LI) {
+        return bhead_from_index_entry(fd, &fd->block_index[i]);
+      }
+    }
+    return NULL;
+  }
+#endif
+
   for (; bhead; bhead = blo_bhead_prev(fd, bhead)) {
     if (bhead->code == ID_LI) {
       break;
@@ -4288,6 +4683,24 @@ static BHead *find_bhead(FileData *fd, void *old)
     return NULL;
   }
 
+#ifdef USE_BHEAD_INDEX
+  /* Only ID's are looked up, they are all in the index. Pointers of files with another pointer
+   * size are converted when reading, so they can't be looked up using the index. */
+  if (fd->block_index != NULL && (fd->flags & FD_FLAGS_POINTSIZE_DIFFERS) == 0) {
+    if (fd->block_index_old_hash == NULL) {
+      fd->block_index_old_hash = BLI_ghash_ptr_new_ex(__func__, (uint)fd->block_index_len);
+      for (int i = 0; i < fd->block_index_len; i++) {
+        BlendBlockIndexEntry *entry = &fd->block_index[i];
+        if (BKE_idtype_idcode_is_valid(entry->code) || entry->code == ID_LINK_PLACEHOLDER) {
+          BLI_ghash_insert(fd->block_index_old_hash, (void *)(uintptr_t)entry->old, entry);
+        }
+      }
+    }
+    const BlendBlockIndexEntry *entry = BLI_ghash_lookup(fd->block_index_old_hash, old);
+    return entry ? bhead_from_index_entry(fd, entry) : NULL;
+  }
+#endif
+
   if (fd->bheadmap == NULL) {
     sort_bhead_old_map(fd);
   }
@@ -4319,7 +4732,7 @@ static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const
   *((short *)idname_full) = idcode;
   BLI_strncpy(idname_full + 2, name, sizeof(idname_full) - 2);
 
-  return BLI_ghash_lookup(fd->bhead_idname_hash, idname_full);
+  return find_bhead_from_idname(fd, idname_full);
 
 #else
   BHead *bhead;
@@ -4343,6 +4756,12 @@ static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const
 static BHead *find_bhead_from_idname(FileData *fd, const char *idname)
 {
 #ifdef USE_GHASH_BHEAD
+#  ifdef USE_BHEAD_INDEX
+  if (fd->block_index_idname_hash != NULL) {
+    const BlendBlockIndexEntry *entry = BLI_ghash_lookup(fd->block_index_idname_hash, idname);
+    return entry ? bhead_from_index_entry(fd, entry) : NULL;
+  }
+#  endif
   return BLI_ghash_lookup(fd->bhead_idname_hash, idname);
 #else
   return find_bhead_from_code_name(fd, GS(idname), idname + 2);
@@ -4352,6 +4771,14 @@ static BHead *find_bhead_from_idname(FileData *fd, const char *idname)
 static ID *is_yet_read(FileData *fd, Main *mainvar, BHead *bhead)
 {
   const char *idname = blo_bhead_id_name(fd, bhead);
+
+  /* Fast path: ID's (and placeholders) read through this file are stored in its library map,
+   * avoiding a linear search by name, which is very slow when expanding large libraries. */
+  ID *id = oldnewmap_lookup_and_inc(fd->libmap, bhead->old, false);
+  if (id != NULL && id->lib == mainvar->curlib && STREQ(id->name, idname)) {
+    return id;
+  }
+
   /* which_libbase can be NULL, intentionally not using idname+2 */
   return BLI_findstring(which_libbase(mainvar, GS(idname)), idname, offsetof(ID, name));
 }
@@ -129,6 +129,13 @@ typedef struct FileData {
   struct BHeadSort *bheadmap;
   int tot_bheadmap;
 
+  /** Optional index of the blocks stored in the file, see #USE_BHEAD_INDEX. */
+  struct BlendBlockIndexEntry *block_index;
+  int block_index_len;
+  /** Lookup of #block_index entries by ID name and by #BHead.old, created when needed. */
+  struct GHash *block_index_idname_hash;
+  struct GHash *block_index_old_hash;
+
   /** See: #USE_GHASH_BHEAD. */
   struct GHash *bhead_idname_hash;
 
@@ -136,6 +143,8 @@ typedef struct FileData {
   /** Used for undo. */
   ListBase *old_mainlist;
   struct IDNameLib_Map *old_idmap;
+  /** Used for undo, name lookup of the linked IDs of the library currently being restored. */
+  struct IDNameLib_Map *old_libmain_idmap;
 
   struct ReportList *reports;
 } FileData;
@@ -172,6 +181,8 @@ void blo_filedata_free(FileData *fd);
 BHead *blo_bhead_first(FileData *fd);
 BHead *blo_bhead_next(FileData *fd, BHead *thisblock);
 BHead *blo_bhead_prev(FileData *fd, BHead *thisblock);
+BHead *blo_bhead_first_of_code(FileData *fd, const int code, int *r_iter);
+BHead *blo_bhead_next_of_code(FileData *fd, const int code, BHead *thisblock, int *r_iter);
 
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead);
 struct AssetMetaData *blo_bhead_id_asset_data_address(const FileData *fd, const BHead *bhead);
@@ -184,6 +195,9 @@ void blo_do_versions_oldnewmap_insert(struct OldNewMap *onm,
                                       const void *oldaddr,
                                       void *newaddr,
                                       int nr);
+typedef void (*BLODoVersionsIDFn)(struct ID *id, void *user_data);
+void blo_do_versions_id_parallel(ListBase *lb, BLODoVersionsIDFn fn, void *user_data);
+
 void *blo_do_versions_newlibadr(struct FileData *fd, const void *lib, const void *adr);
 void *blo_do_versions_newlibadr_us(struct FileData *fd, const void *lib, const void *adr);
 
@@ -0,0 +1,164 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup blenloader
+ */
+
+#include <cstdio>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_map.hh"
+
+#include "PIL_time.h"
+
+#include "readfile_oldnewmap.h"
+
+using blender::Map;
+
+struct OldNewMapStats {
+  int64_t inserts = 0;
+  int64_t lookups = 0;
+  int64_t lookups_missed = 0;
+  int64_t size_max = 0;
+  double time = 0.0;
+};
+
+struct OldNewMap {
+  /* Entries are stored in the map directly, the key is duplicated in #OldNew.oldp
+   * so that entries can be passed to C code as a whole. */
+  Map<const void *, OldNew> map;
+
+  bool use_stats = false;
+  OldNewMapStats stats;
+};
+
+/** Accumulates the time spent in the current scope into the map statistics. */
+class OldNewMapStatsTimer {
+  OldNewMap *onm_;
+  double start_;
+
+ public:
+  OldNewMapStatsTimer(OldNewMap *onm) : onm_(onm->use_stats ? onm : nullptr)
+  {
+    if (onm_) {
+      start_ = PIL_check_seconds_timer();
+    }
+  }
+  ~OldNewMapStatsTimer()
+  {
+    if (onm_) {
+      onm_->stats.time += PIL_check_seconds_timer() - start_;
+    }
+  }
+};
+
+OldNewMap *oldnewmap_new(void)
+{
+  return new OldNewMap();
+}
+
+void oldnewmap_free(OldNewMap *onm)
+{
+  delete onm;
+}
+
+void oldnewmap_reserve(OldNewMap *onm, int size)
+{
+  onm->map.reserve(size);
+}
+
+void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
+{
+  if (oldaddr == nullptr || newaddr == nullptr) {
+    return;
+  }
+
+  OldNewMapStatsTimer timer(onm);
+  onm->map.add_overwrite(oldaddr, {oldaddr, newaddr, nr});
+
+  if (onm->use_stats) {
+    onm->stats.inserts++;
+    onm->stats.size_max = std::max(onm->stats.size_max, onm->map.size());
+  }
+}
+
+OldNew *oldnewmap_lookup_entry(OldNewMap *onm, const void *addr)
+{
+  OldNewMapStatsTimer timer(onm);
+  OldNew *entry = onm->map.lookup_ptr(addr);
+
+  if (onm->use_stats) {
+    onm->stats.lookups++;
+    if (entry == nullptr) {
+      onm->stats.lookups_missed++;
+    }
+  }
+  return entry;
+}
+
+void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool increase_users)
+{
+  OldNew *entry = oldnewmap_lookup_entry(onm, addr);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  if (increase_users) {
+    entry->nr++;
+  }
+  return entry->newp;
+}
+
+void oldnewmap_foreach(OldNewMap *onm, OldNewMapForeachFn fn, void *user_data)
+{
+  for (OldNew &entry : onm->map.values()) {
+    fn(&entry, user_data);
+  }
+}
+
+void oldnewmap_clear(OldNewMap *onm)
+{
+  /* Free unused data. */
+  for (OldNew &entry : onm->map.values()) {
+    if (entry.nr == 0) {
+      MEM_freeN(entry.newp);
+      entry.newp = nullptr;
+    }
+  }
+
+  onm->map.clear();
+}
+
+void oldnewmap_stats_enable(OldNewMap *onm)
+{
+  onm->use_stats = true;
+}
+
+void oldnewmap_print_stats(const OldNewMap *onm, const char *name)
+{
+  if (!onm->use_stats) {
+    return;
+  }
+  const OldNewMapStats &stats = onm->stats;
+  printf("%s: %lld inserts, %lld lookups (%lld missed), max size %lld, %.3f ms\n",
+         name,
+         (long long)stats.inserts,
+         (long long)stats.lookups,
+         (long long)stats.lookups_missed,
+         (long long)stats.size_max,
+         stats.time * 1e3);
+}
@@ -0,0 +1,67 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup blenloader
+ *
+ * Map from addresses stored in a file (old) to addresses of the data read into memory (new),
+ * used to restore pointers while reading a file.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct OldNewMap;
+
+typedef struct OldNew {
+  const void *oldp;
+  void *newp;
+  /* `nr` is "user count" for data, and ID code for libdata. */
+  int nr;
+} OldNew;
+
+typedef struct OldNewMap OldNewMap;
+
+typedef void (*OldNewMapForeachFn)(OldNew *entry, void *user_data);
+
+OldNewMap *oldnewmap_new(void);
+void oldnewmap_free(OldNewMap *onm);
+
+/** Avoid growing the map while inserting \a size entries. */
+void oldnewmap_reserve(OldNewMap *onm, int size);
+
+void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr);
+OldNew *oldnewmap_lookup_entry(OldNewMap *onm, const void *addr);
+void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool increase_users);
+
+void oldnewmap_foreach(OldNewMap *onm, OldNewMapForeachFn fn, void *user_data);
+
+/** Free the data of entries without users and remove all entries. */
+void oldnewmap_clear(OldNewMap *onm);
+
+/**
+ * Collect timing of all map operations, reported by #oldnewmap_print_stats.
+ * Disabled by default since timing each lookup isn't free.
+ */
+void oldnewmap_stats_enable(OldNewMap *onm);
+void oldnewmap_print_stats(const OldNewMap *onm, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -192,6 +192,41 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+/**
+ * Add the chunks of the reference memfile written for the ID stored by \a mem_data
+ * (from #MemFileWriteData.reference_current_chunk on), sharing their buffers instead of
+ * comparing them against newly written data.
+ *
+ * \return false when the reference memfile has no chunks for that ID, nothing is added then.
+ */
+bool BLO_memfile_chunks_reuse(MemFileWriteData *mem_data)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  MemFileChunk *compchunk = mem_data->reference_current_chunk;
+  const uint id_session_uuid = mem_data->current_id_session_uuid;
+
+  if (compchunk == NULL || compchunk->id_session_uuid != id_session_uuid ||
+      id_session_uuid == MAIN_ID_SESSION_UUID_UNSET) {
+    return false;
+  }
+
+  for (; compchunk != NULL && compchunk->id_session_uuid == id_session_uuid;
+       compchunk = compchunk->next) {
+    MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    curchunk->size = compchunk->size;
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uuid = id_session_uuid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+  mem_data->reference_current_chunk = compchunk;
+
+  return true;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
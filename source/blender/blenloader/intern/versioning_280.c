@@ -1212,6 +1212,26 @@ static void do_version_fcurve_hide_viewport_fix(struct ID *UNUSED(id),
   fcu->rna_path = BLI_strdupn("hide_viewport", 13);
 }
 
+/* Meshes are converted independently, see #blo_do_versions_id_parallel. */
+static void do_version_mesh_tessface_to_poly_fn(ID *id, void *user_data)
+{
+  const Main *bmain = user_data;
+  Mesh *me = (Mesh *)id;
+
+  /*check if we need to convert mfaces to mpolys*/
+  if (me->totface && !me->totpoly) {
+    BKE_mesh_do_versions_convert_mfaces_to_mpolys(me);
+  }
+
+  /* Deprecated, only kept for conversion. */
+  BKE_mesh_tessface_clear(me);
+
+  /* Moved from do_versions because we need updated polygons for calculating normals. */
+  if (!MAIN_VERSION_ATLEAST(bmain, 256, 6)) {
+    BKE_mesh_calc_normals(me);
+  }
+}
+
 void do_versions_after_linking_280(Main *bmain, ReportList *UNUSED(reports))
 {
   bool use_collection_compat_28 = true;
@@ -1651,27 +1671,14 @@ void do_versions_after_linking_280(Main *bmain, ReportList *UNUSED(reports))
     /* This versioning could probably be done only on earlier versions, not sure however
      * which exact version fully deprecated tessfaces, so think we can keep that one here, no
      * harm to be expected anyway for being over-conservative. */
-    for (Mesh *me = bmain->meshes.first; me != NULL; me = me->id.next) {
-      /*check if we need to convert mfaces to mpolys*/
-      if (me->totface && !me->totpoly) {
-        /* temporarily switch main so that reading from
-         * external CustomData works */
-        Main *gmain = G_MAIN;
-        G_MAIN = bmain;
+    /* temporarily switch main so that reading from
+     * external CustomData works */
+    Main *gmain = G_MAIN;
+    G_MAIN = bmain;
 
-        BKE_mesh_do_versions_convert_mfaces_to_mpolys(me);
-
-        G_MAIN = gmain;
-      }
+    blo_do_versions_id_parallel(&bmain->meshes, do_version_mesh_tessface_to_poly_fn, bmain);
 
-      /* Deprecated, only kept for conversion. */
-      BKE_mesh_tessface_clear(me);
-
-      /* Moved from do_versions because we need updated polygons for calculating normals. */
-      if (!MAIN_VERSION_ATLEAST(bmain, 256, 6)) {
-        BKE_mesh_calc_normals(me);
-      }
-    }
+    G_MAIN = gmain;
   }
 
   if (!MAIN_VERSION_ATLEAST(bmain, 282, 2)) {
@@ -101,8 +101,12 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
+#include "atomic_ops.h"
+
 #include "BKE_blender_version.h"
 #include "BKE_bpath.h"
 #include "BKE_global.h" /* for G */
@@ -146,9 +150,14 @@
 
 typedef enum {
   WW_WRAP_NONE = 1,
+  WW_WRAP_NONE_THREADED,
   WW_WRAP_ZLIB,
+  WW_WRAP_ZLIB_THREADED,
 } eWriteWrapType;
 
+struct NoneThreaded;
+struct ZLibThreaded;
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -163,6 +172,8 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct NoneThreaded *none_threaded;
+    struct ZLibThreaded *zlib_threaded;
   } _user_data;
 };
 
@@ -192,6 +203,120 @@ static size_t ww_write_none(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* none, threaded.
+ *
+ * Data is written to the file on a separate thread, so serializing the data overlaps with
+ * waiting on the disk. A fixed number of buffers is cycled between both threads, so the memory
+ * used while saving doesn't depend on how fast the disk is. */
+#define FILE_HANDLE(ww) (ww)->_user_data.none_threaded
+
+#define NONE_THREADED_BUFFER_SIZE (1 << 20)
+#define NONE_THREADED_BUFFER_NUM 4
+
+typedef struct NoneThreadedBuffer {
+  uchar *data;
+  size_t data_len;
+} NoneThreadedBuffer;
+
+typedef struct NoneThreaded {
+  int file_handle;
+  ListBase threads;
+  NoneThreadedBuffer buffers[NONE_THREADED_BUFFER_NUM];
+  /** Buffers to be written by the thread, and buffers which can be filled again. */
+  ThreadQueue *queue_write;
+  ThreadQueue *queue_free;
+  /** The buffer being filled, taken from #NoneThreaded.queue_free. */
+  NoneThreadedBuffer *buffer_fill;
+  /** Only set by the writing thread, read by both threads so access it atomically. */
+  uint error;
+} NoneThreaded;
+
+static void *ww_none_threaded_write_thread(void *data)
+{
+  NoneThreaded *nt = data;
+  NoneThreadedBuffer *buffer;
+
+  while ((buffer = BLI_thread_queue_pop(nt->queue_write))) {
+    if (!atomic_add_and_fetch_uint32(&nt->error, 0) &&
+        write(nt->file_handle, buffer->data, buffer->data_len) != (ssize_t)buffer->data_len) {
+      atomic_fetch_and_or_uint32(&nt->error, 1);
+    }
+    buffer->data_len = 0;
+    BLI_thread_queue_push(nt->queue_free, buffer);
+  }
+
+  return NULL;
+}
+
+static bool ww_open_none_threaded(WriteWrap *ww, const char *filepath)
+{
+  const int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+
+  if (file == -1) {
+    return false;
+  }
+
+  NoneThreaded *nt = MEM_callocN(sizeof(*nt), __func__);
+  nt->file_handle = file;
+  nt->queue_write = BLI_thread_queue_init();
+  nt->queue_free = BLI_thread_queue_init();
+  for (int i = 0; i < NONE_THREADED_BUFFER_NUM; i++) {
+    nt->buffers[i].data = MEM_mallocN(NONE_THREADED_BUFFER_SIZE, __func__);
+    BLI_thread_queue_push(nt->queue_free, &nt->buffers[i]);
+  }
+  nt->buffer_fill = BLI_thread_queue_pop(nt->queue_free);
+
+  BLI_threadpool_init(&nt->threads, ww_none_threaded_write_thread, 1);
+  BLI_threadpool_insert(&nt->threads, nt);
+
+  FILE_HANDLE(ww) = nt;
+  return true;
+}
+static bool ww_close_none_threaded(WriteWrap *ww)
+{
+  NoneThreaded *nt = FILE_HANDLE(ww);
+
+  if (nt->buffer_fill->data_len != 0) {
+    BLI_thread_queue_push(nt->queue_write, nt->buffer_fill);
+  }
+  BLI_thread_queue_nowait(nt->queue_write);
+  BLI_threadpool_end(&nt->threads);
+
+  BLI_thread_queue_free(nt->queue_write);
+  BLI_thread_queue_free(nt->queue_free);
+  for (int i = 0; i < NONE_THREADED_BUFFER_NUM; i++) {
+    MEM_freeN(nt->buffers[i].data);
+  }
+
+  const bool success = !nt->error && (close(nt->file_handle) != -1);
+  MEM_freeN(nt);
+  return success;
+}
+static size_t ww_write_none_threaded(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  NoneThreaded *nt = FILE_HANDLE(ww);
+  size_t buf_offset = 0;
+
+  while (buf_offset < buf_len) {
+    NoneThreadedBuffer *buffer = nt->buffer_fill;
+    const size_t len = MIN2(buf_len - buf_offset, NONE_THREADED_BUFFER_SIZE - buffer->data_len);
+    memcpy(buffer->data + buffer->data_len, buf + buf_offset, len);
+    buffer->data_len += len;
+    buf_offset += len;
+
+    if (buffer->data_len == NONE_THREADED_BUFFER_SIZE) {
+      BLI_thread_queue_push(nt->queue_write, buffer);
+      /* Blocks when all buffers are waiting to be written. */
+      nt->buffer_fill = BLI_thread_queue_pop(nt->queue_free);
+    }
+  }
+
+  return atomic_add_and_fetch_uint32(&nt->error, 0) ? 0 : buf_len;
+}
+#undef NONE_THREADED_BUFFER_SIZE
+#undef NONE_THREADED_BUFFER_NUM
+#undef FILE_HANDLE
+
 /* zlib */
 #define FILE_HANDLE(ww) (ww)->_user_data.gz_handle
 
@@ -218,6 +343,195 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* zlib, threaded.
+ *
+ * The data is split into chunks which are compressed on worker threads, each into its own
+ * gzip member. A sequence of gzip members is a valid gzip stream, so the resulting file
+ * can be read by any zlib reader (including older Blender versions).
+ *
+ * Chunks are compressed in batches, while one batch is being compressed the next one is filled,
+ * so compression overlaps with writing the data itself. */
+#define FILE_HANDLE(ww) (ww)->_user_data.zlib_threaded
+
+/* Large enough for the compression ratio not to suffer from restarting the stream. */
+#define ZLIB_THREADED_CHUNK_SIZE (1 << 20)
+#define ZLIB_THREADED_BATCH_MAX 16
+
+typedef struct ZLibChunk {
+  uchar *in;
+  size_t in_len;
+  uchar *out;
+  size_t out_len;
+  bool error;
+} ZLibChunk;
+
+typedef struct ZLibChunkBatch {
+  ZLibChunk chunks[ZLIB_THREADED_BATCH_MAX];
+  int chunks_used;
+  /** The chunks have been pushed to the task pool and need to be written once compressed. */
+  bool is_pending;
+} ZLibChunkBatch;
+
+typedef struct ZLibThreaded {
+  int file_handle;
+  TaskPool *task_pool;
+  /** Number of chunks in each batch. */
+  int batch_len;
+  /** Double buffered, one batch is filled while the other is compressed. */
+  ZLibChunkBatch batches[2];
+  int batch_fill;
+  bool error;
+} ZLibThreaded;
+
+static void ww_zlib_threaded_compress_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ZLibChunk *chunk = taskdata;
+  z_stream strm = {NULL};
+
+  /* Compression level and window match `BLI_gzopen(filepath, "wb1")`. */
+  if (deflateInit2(&strm, 1, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    chunk->error = true;
+    return;
+  }
+
+  const size_t out_len_max = deflateBound(&strm, (uLong)chunk->in_len);
+  chunk->out = MEM_mallocN(out_len_max, __func__);
+
+  strm.next_in = chunk->in;
+  strm.avail_in = (uInt)chunk->in_len;
+  strm.next_out = chunk->out;
+  strm.avail_out = (uInt)out_len_max;
+
+  if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+    chunk->error = true;
+  }
+  chunk->out_len = out_len_max - strm.avail_out;
+
+  deflateEnd(&strm);
+}
+
+/* Wait for the pending batch to be compressed and write it to the file. */
+static void ww_zlib_threaded_write_pending(ZLibThreaded *zt)
+{
+  BLI_task_pool_work_and_wait(zt->task_pool);
+
+  for (int b = 0; b < 2; b++) {
+    ZLibChunkBatch *batch = &zt->batches[b];
+    if (!batch->is_pending) {
+      continue;
+    }
+    for (int i = 0; i < batch->chunks_used; i++) {
+      ZLibChunk *chunk = &batch->chunks[i];
+      if (chunk->error) {
+        zt->error = true;
+      }
+      else if (!zt->error &&
+               write(zt->file_handle, chunk->out, chunk->out_len) != (ssize_t)chunk->out_len) {
+        zt->error = true;
+      }
+      MEM_SAFE_FREE(chunk->out);
+      chunk->in_len = 0;
+      chunk->out_len = 0;
+      chunk->error = false;
+    }
+    batch->chunks_used = 0;
+    batch->is_pending = false;
+  }
+}
+
+/* Push the batch being filled for compression and write the previous one. */
+static void ww_zlib_threaded_flush(ZLibThreaded *zt)
+{
+  ZLibChunkBatch *batch = &zt->batches[zt->batch_fill];
+
+  ww_zlib_threaded_write_pending(zt);
+
+  for (int i = 0; i < batch->chunks_used; i++) {
+    BLI_task_pool_push(
+        zt->task_pool, ww_zlib_threaded_compress_task, &batch->chunks[i], false, NULL);
+  }
+  batch->is_pending = true;
+  zt->batch_fill = !zt->batch_fill;
+}
+
+static bool ww_open_zlib_threaded(WriteWrap *ww, const char *filepath)
+{
+  const int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+
+  if (file == -1) {
+    return false;
+  }
+
+  ZLibThreaded *zt = MEM_callocN(sizeof(*zt), __func__);
+  zt->file_handle = file;
+  zt->task_pool = BLI_task_pool_create(zt, TASK_PRIORITY_HIGH);
+  zt->batch_len = CLAMPIS(BLI_system_thread_count(), 1, ZLIB_THREADED_BATCH_MAX);
+  for (int b = 0; b < 2; b++) {
+    for (int i = 0; i < zt->batch_len; i++) {
+      zt->batches[b].chunks[i].in = MEM_mallocN(ZLIB_THREADED_CHUNK_SIZE, __func__);
+    }
+  }
+
+  FILE_HANDLE(ww) = zt;
+  return true;
+}
+static bool ww_close_zlib_threaded(WriteWrap *ww)
+{
+  ZLibThreaded *zt = FILE_HANDLE(ww);
+
+  ZLibChunkBatch *batch = &zt->batches[zt->batch_fill];
+  if (batch->chunks_used != 0 && batch->chunks[batch->chunks_used - 1].in_len == 0) {
+    batch->chunks_used--;
+  }
+  if (batch->chunks_used != 0) {
+    ww_zlib_threaded_flush(zt);
+  }
+  ww_zlib_threaded_write_pending(zt);
+
+  BLI_task_pool_free(zt->task_pool);
+  for (int b = 0; b < 2; b++) {
+    for (int i = 0; i < zt->batch_len; i++) {
+      MEM_freeN(zt->batches[b].chunks[i].in);
+    }
+  }
+
+  const bool success = !zt->error && (close(zt->file_handle) != -1);
+  MEM_freeN(zt);
+  return success;
+}
+static size_t ww_write_zlib_threaded(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  ZLibThreaded *zt = FILE_HANDLE(ww);
+  size_t buf_offset = 0;
+
+  while (buf_offset < buf_len) {
+    ZLibChunkBatch *batch = &zt->batches[zt->batch_fill];
+    if (batch->chunks_used == 0) {
+      batch->chunks_used = 1;
+    }
+    ZLibChunk *chunk = &batch->chunks[batch->chunks_used - 1];
+
+    const size_t len = MIN2(buf_len - buf_offset, ZLIB_THREADED_CHUNK_SIZE - chunk->in_len);
+    memcpy(chunk->in + chunk->in_len, buf + buf_offset, len);
+    chunk->in_len += len;
+    buf_offset += len;
+
+    if (chunk->in_len == ZLIB_THREADED_CHUNK_SIZE) {
+      if (batch->chunks_used == zt->batch_len) {
+        ww_zlib_threaded_flush(zt);
+      }
+      else {
+        batch->chunks_used++;
+      }
+    }
+  }
+
+  return zt->error ? 0 : buf_len;
+}
+#undef ZLIB_THREADED_CHUNK_SIZE
+#undef ZLIB_THREADED_BATCH_MAX
+#undef FILE_HANDLE
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -225,6 +539,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
   memset(r_ww, 0, sizeof(*r_ww));
 
   switch (ww_type) {
+    case WW_WRAP_NONE_THREADED: {
+      r_ww->open = ww_open_none_threaded;
+      r_ww->close = ww_close_none_threaded;
+      r_ww->write = ww_write_none_threaded;
+      r_ww->use_buf = false;
+      break;
+    }
     case WW_WRAP_ZLIB: {
       r_ww->open = ww_open_zlib;
       r_ww->close = ww_close_zlib;
@@ -232,6 +553,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_ZLIB_THREADED: {
+      r_ww->open = ww_open_zlib_threaded;
+      r_ww->close = ww_close_zlib_threaded;
+      r_ww->write = ww_write_zlib_threaded;
+      r_ww->use_buf = false;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -261,9 +589,18 @@ typedef struct {
   size_t write_len;
 #endif
 
+  /** File offset of the next data passed to #mywrite. */
+  size_t write_offset;
+
   /** Set on unlikely case of an error (ignores further file writing).  */
   bool error;
 
+  /** Index of the written blocks, see #BlendBlockIndexEntry (not used for undo). */
+  BlendBlockIndexEntry *block_index;
+  int block_index_len;
+  int block_index_len_alloc;
+  bool use_block_index;
+
   /** #MemFile writing (used for undo). */
   MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
@@ -327,6 +664,9 @@ static void writedata_free(WriteData *wd)
   if (wd->buf) {
     MEM_freeN(wd->buf);
   }
+  if (wd->block_index) {
+    MEM_freeN(wd->block_index);
+  }
   MEM_freeN(wd);
 }
 
@@ -367,6 +707,7 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
 #ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
 #endif
+  wd->write_offset += len;
 
   if (wd->buf == NULL) {
     writedata_do_write(wd, adr, len);
@@ -417,6 +758,9 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
     BLO_memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
+  else {
+    wd->use_block_index = true;
+  }
 
   return wd;
 }
@@ -486,6 +830,83 @@ static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
   }
 }
 
+/**
+ * Reuse the undo storage of \a id from the previous undo step instead of writing it again.
+ * Must be called right after #mywrite_id_begin.
+ *
+ * \return false when there is no usable storage for this ID, nothing is written then.
+ */
+static bool mywrite_id_reuse(WriteData *wd, const ID *id)
+{
+  BLI_assert(wd->use_memfile && wd->buf_used_len == 0);
+  const MemFileChunk *ref_chunk = wd->mem.reference_current_chunk;
+  if (ref_chunk == NULL || ref_chunk->id_session_uuid != id->session_uuid) {
+    return false;
+  }
+  /* Renaming does not tag the ID for update, the first chunk starts with the ID struct. */
+  if (ref_chunk->size < sizeof(BHead) + sizeof(ID) ||
+      !STREQ(((const ID *)(ref_chunk->buf + sizeof(BHead)))->name, id->name)) {
+    return false;
+  }
+  return BLO_memfile_chunks_reuse(&wd->mem);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Block Index
+ *
+ * Records the file offset of all non #DATA blocks, written at the end of the file,
+ * see #BlendBlockIndexEntry.
+ * \{ */
+
+static void mywrite_block_index_add(WriteData *wd, const BHead *bh, const void *data)
+{
+  if (!wd->use_block_index || bh->code == DATA) {
+    return;
+  }
+
+  if (wd->block_index_len == wd->block_index_len_alloc) {
+    wd->block_index_len_alloc = MAX2(wd->block_index_len_alloc * 2, 256);
+    wd->block_index = MEM_reallocN(wd->block_index,
+                                   sizeof(*wd->block_index) * wd->block_index_len_alloc);
+  }
+
+  BlendBlockIndexEntry *entry = &wd->block_index[wd->block_index_len++];
+  memset(entry, 0, sizeof(*entry));
+  entry->code = bh->code;
+  entry->offset = (uint64_t)wd->write_offset;
+  entry->old = (uint64_t)(uintptr_t)bh->old;
+  if (BKE_idtype_idcode_is_valid(bh->code) || bh->code == ID_LINK_PLACEHOLDER) {
+    BLI_assert(sizeof(entry->name) == MAX_ID_NAME);
+    STRNCPY(entry->name, ((const ID *)data)->name);
+  }
+}
+
+static void write_block_index(WriteData *wd)
+{
+  const size_t entries_size = sizeof(*wd->block_index) * (size_t)wd->block_index_len;
+
+  BHead bh;
+  bh.code = DATA;
+  /* Not a pointer to actual data, only has to be unique. */
+  bh.old = wd;
+  bh.nr = 1;
+  bh.SDNAnr = 0;
+  bh.len = (int)(entries_size + sizeof(BlendBlockIndexFooter));
+
+  BlendBlockIndexFooter footer = {0};
+  footer.entries_offset = (uint64_t)(wd->write_offset + sizeof(BHead));
+  footer.entries_len = wd->block_index_len;
+  memcpy(footer.magic, BLEN_BLOCK_INDEX_MAGIC, sizeof(footer.magic));
+
+  mywrite(wd, &bh, sizeof(BHead));
+  if (entries_size != 0) {
+    mywrite(wd, wd->block_index, entries_size);
+  }
+  mywrite(wd, &footer, sizeof(footer));
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -517,6 +938,7 @@ static void writestruct_at_address_nr(
     return;
   }
 
+  mywrite_block_index_add(wd, &bh, data);
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, data, (size_t)bh.len);
 }
@@ -551,6 +973,7 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = 0;
   bh.len = (int)len;
 
+  mywrite_block_index_add(wd, &bh, adr);
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, adr, len);
 }
@@ -944,6 +1367,11 @@ static bool write_file_handle(Main *mainvar,
    * avoid thumbnail detecting changes because of this. */
   mywrite_flush(wd);
 
+  /* Skip writing IDs which were not tagged for update since the previous undo push,
+   * referencing their storage from that step instead. */
+  const bool use_undo_incremental = wd->use_memfile && wd->mem.reference_memfile != NULL &&
+                                    USER_EXPERIMENTAL_TEST(&U, use_undo_incremental);
+
   OverrideLibraryStorage *override_storage = wd->use_memfile ?
                                                  NULL :
                                                  BKE_lib_override_library_operations_store_init();
@@ -984,6 +1412,20 @@ static bool write_file_handle(Main *mainvar,
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
 
+        /* Only obdata types are handled, their edits are reliably tagged for update,
+         * while for other types (scenes, objects, windows...) many changes are not. */
+        const bool use_reuse_unchanged = use_undo_incremental &&
+                                         ELEM(GS(id->name),
+                                              ID_ME,
+                                              ID_CU,
+                                              ID_MB,
+                                              ID_LT,
+                                              ID_GD,
+                                              ID_HA,
+                                              ID_PT,
+                                              ID_VO) &&
+                                         id->recalc_after_undo_push == 0;
+
         if (wd->use_memfile) {
           /* Record the changes that happened up to this undo push in
            * recalc_up_to_undo_push, and clear recalc_after_undo_push again
@@ -1008,6 +1450,11 @@ static bool write_file_handle(Main *mainvar,
 
         mywrite_id_begin(wd, id);
 
+        if (use_reuse_unchanged && mywrite_id_reuse(wd, id)) {
+          mywrite_id_end(wd, id);
+          continue;
+        }
+
         memcpy(id_buffer, id, idtype_struct_size);
 
         ((ID *)id_buffer)->tag = 0;
@@ -1058,6 +1505,10 @@ static bool write_file_handle(Main *mainvar,
    * so writing each time uses the same address and doesn't cause unnecessary undo overhead. */
   writedata(wd, DNA1, (size_t)wd->sdna->data_len, wd->sdna->data);
 
+  if (wd->use_block_index) {
+    write_block_index(wd);
+  }
+
   /* end of file */
   memset(&bhead, 0, sizeof(BHead));
   bhead.code = ENDB;
@@ -1149,10 +1600,10 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
+    ww_type = (BLI_system_thread_count() > 1) ? WW_WRAP_ZLIB_THREADED : WW_WRAP_ZLIB;
   }
   else {
-    ww_type = WW_WRAP_NONE;
+    ww_type = (BLI_system_thread_count() > 1) ? WW_WRAP_NONE_THREADED : WW_WRAP_NONE;
   }
 
   ww_handle_init(ww_type, &ww);
@@ -81,6 +81,8 @@
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -176,6 +178,152 @@ static BMFace *bm_face_create_from_mpoly(
   return BM_face_create(bm, verts, edges, mp->totloop, NULL, BM_CREATE_SKIP_CD);
 }
 
+/* Convert more elements than this in parallel. */
+#define BM_CONVERT_MIN_ITER_PER_THREAD 1024
+
+typedef struct BMCustomDataFromMeData {
+  const CustomData *cd_src;
+  CustomData *cd_dst;
+  BMElem **table;
+} BMCustomDataFromMeData;
+
+typedef struct BMFaceCustomDataFromMeData {
+  const Mesh *me;
+  BMesh *bm;
+  BMFace **ftable;
+  bool calc_face_normal;
+} BMFaceCustomDataFromMeData;
+
+typedef struct BMCustomDataFromMeTLS {
+  /** Created on first use, the custom-data pools can't be allocated from by multiple threads. */
+  BLI_mempool_thread_cache *elem_pool_cache;
+  BLI_mempool_thread_cache *loop_pool_cache;
+} BMCustomDataFromMeTLS;
+
+/**
+ * Thread safe version of allocating a custom-data block of an element created with
+ * #BM_CREATE_SKIP_CD, the block is left NULL when \a cd has no layers.
+ */
+static void bm_customdata_block_alloc(CustomData *cd,
+                                      BLI_mempool_thread_cache **pool_cache,
+                                      void **r_block)
+{
+  BLI_assert(*r_block == NULL);
+  if (cd->totsize > 0) {
+    if (*pool_cache == NULL) {
+      *pool_cache = BLI_mempool_thread_cache_create(cd->pool);
+    }
+    *r_block = BLI_mempool_thread_cache_alloc(*pool_cache);
+  }
+}
+
+static void bm_customdata_from_me_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  BMCustomDataFromMeData *data = userdata;
+  BMCustomDataFromMeTLS *data_tls = tls->userdata_chunk;
+  BMElem *ele = data->table[i];
+
+  bm_customdata_block_alloc(data->cd_dst, &data_tls->elem_pool_cache, &ele->head.data);
+  CustomData_to_bmesh_block(data->cd_src, data->cd_dst, i, &ele->head.data, true);
+}
+
+static void bm_face_customdata_from_me_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  BMFaceCustomDataFromMeData *data = userdata;
+  BMCustomDataFromMeTLS *data_tls = tls->userdata_chunk;
+  const Mesh *me = data->me;
+  BMesh *bm = data->bm;
+  BMFace *f = data->ftable[i];
+
+  /* Skipped bad face. */
+  if (f == NULL) {
+    return;
+  }
+
+  int j = me->mpoly[i].loopstart;
+  BMLoop *l_iter, *l_first;
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    bm_customdata_block_alloc(&bm->ldata, &data_tls->loop_pool_cache, &l_iter->head.data);
+    CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  bm_customdata_block_alloc(&bm->pdata, &data_tls->elem_pool_cache, &f->head.data);
+  CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+  if (data->calc_face_normal) {
+    BM_face_normal_update(f);
+  }
+}
+
+static void bm_customdata_from_me_free(const void *__restrict UNUSED(userdata),
+                                       void *__restrict chunk)
+{
+  BMCustomDataFromMeTLS *data_tls = chunk;
+  if (data_tls->elem_pool_cache != NULL) {
+    BLI_mempool_thread_cache_destroy(data_tls->elem_pool_cache);
+  }
+  if (data_tls->loop_pool_cache != NULL) {
+    BLI_mempool_thread_cache_destroy(data_tls->loop_pool_cache);
+  }
+}
+
+static void bm_customdata_from_me_settings(TaskParallelSettings *settings,
+                                           BMCustomDataFromMeTLS *data_tls)
+{
+  memset(data_tls, 0, sizeof(*data_tls));
+  BLI_parallel_range_settings_defaults(settings);
+  settings->min_iter_per_thread = BM_CONVERT_MIN_ITER_PER_THREAD;
+  settings->userdata_chunk = data_tls;
+  settings->userdata_chunk_size = sizeof(*data_tls);
+  settings->func_free = bm_customdata_from_me_free;
+}
+
+/**
+ * Copy the custom-data of the first \a totelem elements of \a cd_src into the elements of
+ * \a table, which have been created with #BM_CREATE_SKIP_CD.
+ */
+static void bm_customdata_from_me(const CustomData *cd_src,
+                                  CustomData *cd_dst,
+                                  BMElem **table,
+                                  const int totelem)
+{
+  BMCustomDataFromMeData data = {
+      .cd_src = cd_src,
+      .cd_dst = cd_dst,
+      .table = table,
+  };
+  BMCustomDataFromMeTLS data_tls;
+  TaskParallelSettings settings;
+  bm_customdata_from_me_settings(&settings, &data_tls);
+  BLI_task_parallel_range(0, totelem, &data, bm_customdata_from_me_cb, &settings);
+}
+
+/**
+ * Copy the face and loop custom-data of the mesh into the faces of \a ftable,
+ * which may contain NULL for faces which have been skipped.
+ */
+static void bm_face_customdata_from_me(const Mesh *me,
+                                       BMesh *bm,
+                                       BMFace **ftable,
+                                       const bool calc_face_normal)
+{
+  BMFaceCustomDataFromMeData data = {
+      .me = me,
+      .bm = bm,
+      .ftable = ftable,
+      .calc_face_normal = calc_face_normal,
+  };
+  BMCustomDataFromMeTLS data_tls;
+  TaskParallelSettings settings;
+  bm_customdata_from_me_settings(&settings, &data_tls);
+  BLI_task_parallel_range(0, me->totpoly, &data, bm_face_customdata_from_me_cb, &settings);
+}
+
 /**
  * \brief Mesh -> BMesh
  * \param bm: The mesh to write into, while this is typically a newly created BMesh,
@@ -345,30 +493,36 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
     }
 
     normal_short_to_float_v3(v->no, mvert->no);
+  }
+  if (is_new) {
+    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
+  }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+  /* Copy Custom Data */
+  bm_customdata_from_me(&me->vdata, &bm->vdata, (BMElem **)vtable, me->totvert);
 
-    if (cd_vert_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
-    }
+  if (cd_vert_bweight_offset != -1 || cd_shape_keyindex_offset != -1 || tot_shape_keys) {
+    for (i = 0, mvert = me->mvert; i < me->totvert; i++, mvert++) {
+      v = vtable[i];
 
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
+      if (cd_vert_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
+      }
 
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
+      /* Set shape key original index. */
+      if (cd_shape_keyindex_offset != -1) {
+        BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      }
+
+      /* Set shape-key data. */
+      if (tot_shape_keys) {
+        float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+        for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+          copy_v3_v3(*co_dst, shape_key_table[j][i]);
+        }
       }
     }
   }
-  if (is_new) {
-    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
-  }
 
   etable = MEM_mallocN(sizeof(BMEdge **) * me->totedge, __func__);
 
@@ -385,36 +539,36 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
     if (medge->flag & SELECT) {
       BM_edge_select_set(bm, e, true);
     }
-
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-    if (cd_edge_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
-    }
-    if (cd_edge_crease_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge->crease / 255.0f);
-    }
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
 
-  /* Only needed for selection. */
-  if (me->mselect && me->totselect != 0) {
-    ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
+  /* Copy Custom Data */
+  bm_customdata_from_me(&me->edata, &bm->edata, (BMElem **)etable, me->totedge);
+
+  if (cd_edge_bweight_offset != -1 || cd_edge_crease_offset != -1) {
+    for (i = 0, medge = me->medge; i < me->totedge; i++, medge++) {
+      e = etable[i];
+
+      if (cd_edge_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
+      }
+      if (cd_edge_crease_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge->crease / 255.0f);
+      }
+    }
   }
 
+  ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
+
   mloop = me->mloop;
   mp = me->mpoly;
   for (i = 0, totloops = 0; i < me->totpoly; i++, mp++) {
     BMLoop *l_iter;
     BMLoop *l_first;
 
-    f = bm_face_create_from_mpoly(mp, mloop + mp->loopstart, bm, vtable, etable);
-    if (ftable != NULL) {
-      ftable[i] = f;
-    }
+    f = ftable[i] = bm_face_create_from_mpoly(mp, mloop + mp->loopstart, bm, vtable, etable);
 
     if (UNLIKELY(f == NULL)) {
       printf(
@@ -442,27 +596,19 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       bm->act_face = f;
     }
 
-    int j = mp->loopstart;
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
       /* Don't use 'j' since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
-
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
     } while ((l_iter = l_iter->next) != l_first);
-
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
 
+  /* Copy Custom Data */
+  bm_face_customdata_from_me(me, bm, ftable, params->calc_face_normal);
+
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (avoid adding multiple times).
    *
@@ -582,16 +728,115 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
   }
 }
 
+typedef struct BMToMeData {
+  BMesh *bm;
+  Mesh *me;
+  MVert *mvert;
+  MEdge *medge;
+  MLoop *mloop;
+  MPoly *mpoly;
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+} BMToMeData;
+
+static void bm_vert_to_me_cb(void *__restrict userdata,
+                             const int i,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeData *data = userdata;
+  BMVert *v = data->bm->vtable[i];
+  MVert *mvert = &data->mvert[i];
+
+  copy_v3_v3(mvert->co, v->co);
+  normal_float_to_short_v3(mvert->no, v->no);
+
+  mvert->flag = BM_vert_flag_to_mflag(v);
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&data->bm->vdata, &data->me->vdata, v->head.data, i);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, data->cd_vert_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(v);
+}
+
+static void bm_edge_to_me_cb(void *__restrict userdata,
+                             const int i,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeData *data = userdata;
+  BMEdge *e = data->bm->etable[i];
+  MEdge *med = &data->medge[i];
+
+  med->v1 = BM_elem_index_get(e->v1);
+  med->v2 = BM_elem_index_get(e->v2);
+
+  med->flag = BM_edge_flag_to_mflag(e);
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&data->bm->edata, &data->me->edata, e->head.data, i);
+
+  bmesh_quick_edgedraw_flag(med, e);
+
+  if (data->cd_edge_crease_offset != -1) {
+    med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_crease_offset);
+  }
+  if (data->cd_edge_bweight_offset != -1) {
+    med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(e);
+}
+
+/**
+ * \note Expects #MPoly.loopstart to be set already.
+ */
+static void bm_face_to_me_cb(void *__restrict userdata,
+                             const int i,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BMToMeData *data = userdata;
+  BMFace *f = data->bm->ftable[i];
+  MPoly *mpoly = &data->mpoly[i];
+
+  mpoly->totloop = f->len;
+  mpoly->mat_nr = f->mat_nr;
+  mpoly->flag = BM_face_flag_to_mflag(f);
+
+  int j = mpoly->loopstart;
+  MLoop *mloop = &data->mloop[j];
+  BMLoop *l_iter, *l_first;
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    mloop->e = BM_elem_index_get(l_iter->e);
+    mloop->v = BM_elem_index_get(l_iter->v);
+
+    /* Copy over custom-data. */
+    CustomData_from_bmesh_block(&data->bm->ldata, &data->me->ldata, l_iter->head.data, j);
+
+    j++;
+    mloop++;
+    BM_CHECK_ELEMENT(l_iter);
+    BM_CHECK_ELEMENT(l_iter->e);
+    BM_CHECK_ELEMENT(l_iter->v);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&data->bm->pdata, &data->me->pdata, f->head.data, i);
+
+  BM_CHECK_ELEMENT(f);
+}
+
 /**
  *
  * \param bmain: May be NULL in case \a calc_object_remap parameter option is not set.
  */
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  MEdge *med;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -658,91 +903,38 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   /* This is called again, 'dotess' arg is used there. */
   BKE_mesh_update_customdata_pointers(me, 0);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert->co, v->co);
-    normal_float_to_short_v3(mvert->no, v->no);
-
-    mvert->flag = BM_vert_flag_to_mflag(v);
-
-    BM_elem_index_set(v, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-    if (cd_vert_bweight_offset != -1) {
-      mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-    }
-
-    i++;
-    mvert++;
-
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  med = medge;
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    med->v1 = BM_elem_index_get(e->v1);
-    med->v2 = BM_elem_index_get(e->v2);
-
-    med->flag = BM_edge_flag_to_mflag(e);
-
-    BM_elem_index_set(e, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-    bmesh_quick_edgedraw_flag(med, e);
-
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-    }
-
-    i++;
-    med++;
-    BM_CHECK_ELEMENT(e);
+  /* Elements are converted in parallel, looking up the elements of each index in the tables.
+   * The indices also give the vertices and edges of the converted edges and loops. */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  BMToMeData data = {
+      .bm = bm,
+      .me = me,
+      .mvert = mvert,
+      .medge = medge,
+      .mloop = mloop,
+      .mpoly = mpoly,
+      .cd_vert_bweight_offset = cd_vert_bweight_offset,
+      .cd_edge_bweight_offset = cd_edge_bweight_offset,
+      .cd_edge_crease_offset = cd_edge_crease_offset,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = BM_CONVERT_MIN_ITER_PER_THREAD;
+
+  BLI_task_parallel_range(0, bm->totvert, &data, bm_vert_to_me_cb, &settings);
+  BLI_task_parallel_range(0, bm->totedge, &data, bm_edge_to_me_cb, &settings);
+
+  for (i = 0, j = 0; i < bm->totface; i++) {
+    mpoly[i].loopstart = j;
+    j += bm->ftable[i]->len;
   }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly->loopstart = j;
-    mpoly->totloop = f->len;
-    mpoly->mat_nr = f->mat_nr;
-    mpoly->flag = BM_face_flag_to_mflag(f);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop->e = BM_elem_index_get(l_iter->e);
-      mloop->v = BM_elem_index_get(l_iter->v);
-
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-      j++;
-      mloop++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
-    }
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
+  BLI_task_parallel_range(0, bm->totface, &data, bm_face_to_me_cb, &settings);
 
-    i++;
-    mpoly++;
-    BM_CHECK_ELEMENT(f);
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
   }
 
   /* Patch hook indices and vertex parents. */
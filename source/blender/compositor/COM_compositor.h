@@ -356,8 +356,10 @@ void COM_deinitialize(void);
 /**
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
+ * \note can be called while the compositor is executing, the cached buffers are freed by the
+ * next execution.
  */
-// void COM_clearCaches(void); // NOT YET WRITTEN
+void COM_clearCaches(void);
 
 #ifdef __cplusplus
 }
@@ -62,16 +62,26 @@ typedef enum CompositorPriority {
 
 // chunk size determination
 #define COM_PREVIEW_SIZE 140.0f
+/* Viewers calculate every n-th pixel in the first pass when #NTREE_PREVIEW_RESOLUTION is set. */
+#define COM_PREVIEW_RESOLUTION_DIVIDER 4
 #define COM_OPENCL_ENABLED
 //#define COM_DEBUG
 
 // workscheduler threading models
 /**
  * COM_TM_QUEUE is a multi-threaded model, which uses the BLI_thread_queue pattern.
- * This is the default option.
+ * Every CPUDevice has its own thread popping work from a single shared queue.
  */
 #define COM_TM_QUEUE 1
 
+/**
+ * COM_TM_TASKPOOL is a multi-threaded model, which executes CPU work in a BLI_task pool.
+ * A task per CPUDevice pops work from a single shared queue, its threads are the ones of the task
+ * scheduler, shared with the rest of Blender. OpenCL work still uses a queue per device.
+ * This is the default option.
+ */
+#define COM_TM_TASKPOOL 2
+
 /**
  * COM_TM_NOTHREAD is a single threading model, everything is executed in the caller thread.
  * easy for debugging
@@ -79,9 +89,9 @@ typedef enum CompositorPriority {
 #define COM_TM_NOTHREAD 0
 
 /**
- * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_QUEUE is currently default.
+ * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_TASKPOOL is currently default.
  */
-#define COM_CURRENT_THREADING_MODEL COM_TM_QUEUE
+#define COM_CURRENT_THREADING_MODEL COM_TM_TASKPOOL
 // chunk order
 /**
  * \brief The order of chunks to be scheduled
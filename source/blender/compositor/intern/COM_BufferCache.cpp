@@ -0,0 +1,254 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <cstring>
+#include <typeinfo>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_hash_md5.h"
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "DNA_node_types.h"
+
+#include "BKE_node.h"
+
+#include "atomic_ops.h"
+
+#include "COM_BufferCache.h"
+#include "COM_ExecutionGroup.h"
+#include "COM_ExecutionSystem.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+map<uint64_t, BufferCache::Entry> BufferCache::s_entries;
+
+/* Guards #BufferCache::s_entries, which can be freed from the threads executing the chunks. */
+static ThreadMutex s_entries_lock = BLI_MUTEX_INITIALIZER;
+
+/* Incremented to invalidate all cached results, part of every key. */
+static uint32_t s_generation = 0;
+
+uint64_t BufferCacheKey::hash() const
+{
+  uint64_t digest[2];
+  BLI_hash_md5_buffer(this->m_data.data(), this->m_data.size(), digest);
+  /* Zero is used for results that can't be cached. */
+  return digest[0] ? digest[0] : 1;
+}
+
+/**
+ * Add the settings of \a node which its operations are created from, including which of its
+ * sockets are linked since the conversion of some nodes depends on it.
+ * Returns false when the result of the node depends on data that can change without the node
+ * changing, like the pixels of an image.
+ */
+static bool hash_bnode(BufferCacheKey &key, const bNode *node)
+{
+  if (node->id && node->type != CMP_NODE_R_LAYERS) {
+    return false;
+  }
+  key.add(node->type);
+  key.add(node->id);
+  key.add(node->custom1);
+  key.add(node->custom2);
+  key.add(node->custom3);
+  key.add(node->custom4);
+  key.add((node->flag & NODE_MUTED) != 0);
+  if (node->storage) {
+    key.addBytes(node->storage, MEM_allocN_len(node->storage));
+  }
+  LISTBASE_FOREACH (const bNodeSocket *, sock, &node->inputs) {
+    key.add((sock->flag & SOCK_IN_USE) != 0);
+    if (sock->default_value) {
+      key.addBytes(sock->default_value, MEM_allocN_len(sock->default_value));
+    }
+  }
+  LISTBASE_FOREACH (const bNodeSocket *, sock, &node->outputs) {
+    key.add((sock->flag & SOCK_IN_USE) != 0);
+  }
+  return true;
+}
+
+uint64_t BufferCache::operationKey(NodeOperation *operation, const BufferCacheKey &context_key)
+{
+  map<NodeOperation *, uint64_t>::iterator found = this->m_keys.find(operation);
+  if (found != this->m_keys.end()) {
+    return found->second;
+  }
+
+  uint64_t result = 0;
+  if (operation->isReadBufferOperation()) {
+    MemoryProxy *proxy = ((ReadBufferOperation *)operation)->getMemoryProxy();
+    result = operationKey(proxy->getWriteBufferOperation(), context_key);
+  }
+  else {
+    BufferCacheKey key = context_key;
+    const char *type_name = typeid(*operation).name();
+    key.addBytes(type_name, strlen(type_name));
+    key.add(operation->getWidth());
+    key.add(operation->getHeight());
+    operation->hashParameters(key);
+
+    /* Operations of the same type created for one node, like the channels of Separate RGBA or
+     * the passes of Render Layers, only differ in their position in the node's operations. */
+    bool cacheable = true;
+    if (operation->getbNode() != nullptr) {
+      cacheable = hash_bnode(key, operation->getbNode());
+      key.add(operation->getNodeOperationIndex());
+    }
+    for (unsigned int index = 0; cacheable && index < operation->getNumberOfInputSockets();
+         index++) {
+      NodeOperation *input = operation->getInputOperation(index);
+      const uint64_t input_key = input ? operationKey(input, context_key) : 0;
+      cacheable = input == nullptr || input_key != 0;
+      key.add(input_key);
+    }
+    if (cacheable) {
+      result = key.hash();
+    }
+  }
+
+  this->m_keys[operation] = result;
+  return result;
+}
+
+void BufferCache::restoreBuffers(ExecutionSystem *system)
+{
+  const CompositorContext &context = system->getContext();
+  const RenderData *rd = context.getRenderData();
+  BufferCacheKey context_key;
+  context_key.add(atomic_add_and_fetch_uint32(&s_generation, 0));
+  context_key.add(context.getFramenumber());
+  context_key.add(context.getQuality());
+  context_key.add(rd->size);
+  context_key.add(rd->xsch);
+  context_key.add(rd->ysch);
+  context_key.addBytes(context.getViewName(), strlen(context.getViewName()));
+
+  BLI_mutex_lock(&s_entries_lock);
+  for (ExecutionGroup *group : system->m_groups) {
+    NodeOperation *operation = group->getOutputOperation();
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    const uint64_t key = operationKey(operation, context_key);
+    map<uint64_t, Entry>::iterator found = s_entries.find(key);
+    if (key == 0 || found == s_entries.end()) {
+      continue;
+    }
+
+    MemoryBuffer *buffer = ((WriteBufferOperation *)operation)->getMemoryProxy()->getBuffer();
+    MemoryBuffer *cached = found->second.buffer;
+    if (cached->getWidth() != buffer->getWidth() || cached->getHeight() != buffer->getHeight() ||
+        cached->get_num_channels() != buffer->get_num_channels()) {
+      continue;
+    }
+    memcpy(buffer->getBuffer(),
+           cached->getBuffer(),
+           sizeof(float) * buffer->getWidth() * buffer->getHeight() * buffer->get_num_channels());
+    buffer->setCreatedState();
+    found->second.used = true;
+    this->m_restored_groups.push_back(group);
+  }
+  BLI_mutex_unlock(&s_entries_lock);
+}
+
+void BufferCache::skipRestoredGroups()
+{
+  for (ExecutionGroup *group : this->m_restored_groups) {
+    group->setChunksExecuted();
+  }
+}
+
+void BufferCache::storeBuffers(ExecutionSystem *system)
+{
+  const CompositorContext &context = system->getContext();
+  const bNodeTree *tree = context.getbNodeTree();
+
+  BLI_mutex_lock(&s_entries_lock);
+  /* Cancelled executions leave chunks half written. */
+  if (!tree->test_break(tree->tbh)) {
+    for (ExecutionGroup *group : system->m_groups) {
+      NodeOperation *operation = group->getOutputOperation();
+      if (!operation->isWriteBufferOperation() || !group->isFullyExecuted()) {
+        continue;
+      }
+      const uint64_t key = this->m_keys[operation];
+      if (key == 0 || s_entries.count(key)) {
+        continue;
+      }
+      MemoryProxy *proxy = ((WriteBufferOperation *)operation)->getMemoryProxy();
+      s_entries[key] = {proxy->releaseBuffer(), true};
+    }
+  }
+
+  /* The first pass of two pass execution skips nodes and the preview resolution pass skips
+   * outputs, keep the results of the previous full execution around for the next pass. */
+  if (!context.isFastCalculation() && context.getResolutionDivider() == 1) {
+    for (map<uint64_t, Entry>::iterator it = s_entries.begin(); it != s_entries.end();) {
+      if (it->second.used) {
+        it->second.used = false;
+        ++it;
+      }
+      else {
+        delete it->second.buffer;
+        it = s_entries.erase(it);
+      }
+    }
+  }
+  BLI_mutex_unlock(&s_entries_lock);
+}
+
+void BufferCache::invalidate()
+{
+  atomic_add_and_fetch_uint32(&s_generation, 1);
+}
+
+void BufferCache::freeUnused(size_t size)
+{
+  size_t freed = 0;
+  BLI_mutex_lock(&s_entries_lock);
+  for (const bool used : {false, true}) {
+    for (map<uint64_t, Entry>::iterator it = s_entries.begin();
+         freed < size && it != s_entries.end();) {
+      if (it->second.used != used) {
+        ++it;
+        continue;
+      }
+      MemoryBuffer *buffer = it->second.buffer;
+      freed += sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+               buffer->get_num_channels();
+      delete buffer;
+      it = s_entries.erase(it);
+    }
+  }
+  BLI_mutex_unlock(&s_entries_lock);
+}
+
+void BufferCache::clear()
+{
+  BLI_mutex_lock(&s_entries_lock);
+  for (map<uint64_t, Entry>::iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+    delete it->second.buffer;
+  }
+  s_entries.clear();
+  BLI_mutex_unlock(&s_entries_lock);
+}
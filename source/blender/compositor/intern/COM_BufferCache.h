@@ -0,0 +1,126 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class ExecutionGroup;
+class ExecutionSystem;
+class MemoryBuffer;
+class NodeOperation;
+
+using std::map;
+using std::vector;
+
+/**
+ * \brief Collects the settings identifying the result of an operation.
+ * \see NodeOperation.hashParameters
+ */
+class BufferCacheKey {
+ private:
+  std::string m_data;
+
+ public:
+  void addBytes(const void *data, size_t size)
+  {
+    this->m_data.append((const char *)data, size);
+  }
+
+  template<typename T> void add(const T &value)
+  {
+    addBytes(&value, sizeof(T));
+  }
+
+  /**
+   * \brief hash the collected settings, never returns zero.
+   */
+  uint64_t hash() const;
+};
+
+/**
+ * \brief Keeps the results of buffered operations between executions of the compositor.
+ *
+ * Every WriteBufferOperation is identified by a hash of the settings of all operations it
+ * depends on, so when a node is edited only the buffers downstream of it are calculated again.
+ * Results of operations that depend on data the nodes can't track (images, movie clips, masks)
+ * are never cached. Render results are invalidated with #COM_clearCaches. Cached results count
+ * towards the budget of MemoryBufferPool.
+ * \ingroup Execution
+ */
+class BufferCache {
+ private:
+  struct Entry {
+    MemoryBuffer *buffer;
+    bool used;
+  };
+
+  /**
+   * \brief hash of each WriteBufferOperation of the current execution, zero when not cached
+   */
+  map<NodeOperation *, uint64_t> m_keys;
+
+  /**
+   * \brief groups whose output has been restored from the cache
+   */
+  vector<ExecutionGroup *> m_restored_groups;
+
+  static map<uint64_t, Entry> s_entries;
+
+  uint64_t operationKey(NodeOperation *operation, const BufferCacheKey &context_key);
+
+ public:
+  /**
+   * \brief copy the cached results into the allocated buffers of \a system.
+   * \note must be called after the write buffers have been allocated.
+   */
+  void restoreBuffers(ExecutionSystem *system);
+
+  /**
+   * \brief mark the chunks of the restored groups as executed so they are not scheduled.
+   * \note must be called after the execution groups have been initialized.
+   */
+  void skipRestoredGroups();
+
+  /**
+   * \brief take over the buffers calculated by \a system and free the ones it didn't use.
+   * \note must be called before the operations are deinitialized.
+   */
+  void storeBuffers(ExecutionSystem *system);
+
+  /**
+   * \brief invalidate all cached results, they are freed on the next execution.
+   * \note can be called from any thread.
+   */
+  static void invalidate();
+
+  /**
+   * \brief free cached results until at least \a size bytes are freed.
+   * Results not restored by the current execution are freed first.
+   * \note can be called from any thread, used by MemoryBufferPool when over its budget.
+   */
+  static void freeUnused(size_t size);
+
+  /**
+   * \brief free all cached results.
+   */
+  static void clear();
+};
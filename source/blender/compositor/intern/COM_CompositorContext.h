@@ -77,6 +77,11 @@ class CompositorContext {
    */
   bool m_fastCalculation;
 
+  /**
+   * \brief Viewers only calculate every n-th pixel in both directions, see ViewerOperation
+   */
+  int m_resolutionDivider;
+
   /* \brief color management settings */
   const ColorManagedViewSettings *m_viewSettings;
   const ColorManagedDisplaySettings *m_displaySettings;
@@ -263,6 +268,14 @@ class CompositorContext {
   {
     return this->m_fastCalculation;
   }
+  void setResolutionDivider(int resolutionDivider)
+  {
+    this->m_resolutionDivider = resolutionDivider;
+  }
+  int getResolutionDivider() const
+  {
+    return this->m_resolutionDivider;
+  }
   bool isGroupnodeBufferEnabled() const
   {
     return (this->getbNodeTree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
@@ -57,6 +57,7 @@ ExecutionGroup::ExecutionGroup()
   this->m_openCL = false;
   this->m_singleThreaded = false;
   this->m_chunksFinished = 0;
+  this->m_executionTime = 0.0f;
   BLI_rcti_init(&this->m_viewerBorder, 0, 0, 0, 0);
   this->m_executionStartTime = 0;
 }
@@ -162,6 +163,60 @@ void ExecutionGroup::deinitExecution()
   this->m_cachedReadOperations.clear();
   this->m_bTree = nullptr;
 }
+void ExecutionGroup::setChunksExecuted()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
+bool ExecutionGroup::isFullyExecuted() const
+{
+  if (this->m_viewerBorder.xmin != 0 || this->m_viewerBorder.ymin != 0 ||
+      this->m_viewerBorder.xmax != (int)this->m_width ||
+      this->m_viewerBorder.ymax != (int)this->m_height) {
+    return false;
+  }
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExecutionGroup::addExecutionTime(double seconds)
+{
+  atomic_add_and_fetch_fl(&this->m_executionTime, (float)seconds);
+}
+
+void ExecutionGroup::updateNodeExecutionStats()
+{
+  vector<bNode *> nodes;
+  for (NodeOperation *operation : this->m_operations) {
+    bNode *node = operation->getbNode();
+    if (operation->isWriteBufferOperation()) {
+      /* Buffers are added after the nodes are converted, they belong to the node they store. */
+      NodeOperationOutput *input = operation->getInputSocket(0)->getLink();
+      MemoryBuffer *buffer = ((WriteBufferOperation *)operation)->getMemoryProxy()->getBuffer();
+      node = input ? input->getOperation().getbNode() : nullptr;
+      if (node && buffer) {
+        node->exec_memory += sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+                             buffer->get_num_channels() / (1024.0f * 1024.0f);
+      }
+    }
+    if (node && std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+      nodes.push_back(node);
+    }
+  }
+
+  /* A complex group only executes its complex operation, other groups are chains of per pixel
+   * operations which can't be timed separately, their time is split evenly. */
+  for (bNode *node : nodes) {
+    node->exec_time += this->m_executionTime * 1000.0f / nodes.size();
+  }
+}
+
 void ExecutionGroup::determineResolution(unsigned int resolution[2])
 {
   NodeOperation *operation = this->getOutputOperation();
@@ -386,9 +441,16 @@ MemoryBuffer **ExecutionGroup::getInputBuffersOpenCL(int chunkNumber)
     ReadBufferOperation *readOperation =
         (ReadBufferOperation *)this->m_cachedReadOperations[index];
     MemoryProxy *memoryProxy = readOperation->getMemoryProxy();
-    this->determineDependingAreaOfInterest(&rect, readOperation, &output);
-    MemoryBuffer *memoryBuffer = memoryProxy->getExecutor()->constructConsolidatedMemoryBuffer(
-        memoryProxy, &output);
+    ExecutionGroup *executor = memoryProxy->getExecutor();
+    MemoryBuffer *memoryBuffer;
+    if (executor->isFullyExecuted()) {
+      /* Use the complete buffer directly, so the device only has to upload it once. */
+      memoryBuffer = memoryProxy->getBuffer();
+    }
+    else {
+      this->determineDependingAreaOfInterest(&rect, readOperation, &output);
+      memoryBuffer = executor->constructConsolidatedMemoryBuffer(memoryProxy, &output);
+    }
     memoryBuffers[readOperation->getOffset()] = memoryBuffer;
   }
   return memoryBuffers;
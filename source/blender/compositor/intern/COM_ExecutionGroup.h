@@ -150,6 +150,12 @@ class ExecutionGroup {
    */
   unsigned int m_chunksFinished;
 
+  /**
+   * \brief time spent executing the chunks of this ExecutionGroup in seconds, summed over all
+   * threads
+   */
+  float m_executionTime;
+
   /**
    * \brief the chunkExecutionStates holds per chunk the execution state. this state can be
    *   - COM_ES_NOT_SCHEDULED: not scheduled
@@ -425,6 +431,30 @@ class ExecutionGroup {
     this->m_chunkSize = chunksize;
   }
 
+  /**
+   * \brief mark all chunks as executed, used when the result is already available
+   * \see BufferCache
+   */
+  void setChunksExecuted();
+
+  /**
+   * \brief have all chunks of the whole resolution been executed
+   */
+  bool isFullyExecuted() const;
+
+  /**
+   * \brief add the time a device spent executing a chunk.
+   * \note can be called from any thread.
+   */
+  void addExecutionTime(double seconds);
+
+  /**
+   * \brief add the execution time and the size of the written buffer of this group to the
+   * nodes its operations are created from.
+   * \see bNode.exec_time
+   */
+  void updateNodeExecutionStats();
+
   /**
    * \brief get the Render priority of this ExecutionGroup
    * \see ExecutionSystem.execute
@@ -18,6 +18,7 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include "BLI_listbase.h"
 #include "BLI_utildefines.h"
 #include "PIL_time.h"
 
@@ -25,6 +26,7 @@
 
 #include "BLT_translation.h"
 
+#include "COM_BufferCache.h"
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 #include "COM_ExecutionGroup.h"
@@ -42,6 +44,7 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bNodeTree *editingtree,
                                  bool rendering,
                                  bool fastcalculation,
+                                 int resolution_divider,
                                  const ColorManagedViewSettings *viewSettings,
                                  const ColorManagedDisplaySettings *displaySettings,
                                  const char *viewName)
@@ -51,6 +54,7 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
   this->m_context.setbNodeTree(editingtree);
   this->m_context.setPreviewHash(editingtree->previews);
   this->m_context.setFastCalculation(fastcalculation);
+  this->m_context.setResolutionDivider(resolution_divider);
   /* initialize the CompositorContext */
   if (rendering) {
     this->m_context.setQuality((CompositorQuality)editingtree->render_quality);
@@ -155,6 +159,12 @@ void ExecutionSystem::execute()
       operation->initExecution();
     }
   }
+  // Reuse the results of previous executions, rendering always starts from new render results
+  BufferCache cache;
+  const bool use_cache = !this->m_context.isRendering();
+  if (use_cache) {
+    cache.restoreBuffers(this);
+  }
   // Connect read buffers to their write buffers
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -176,11 +186,15 @@ void ExecutionSystem::execute()
     executionGroup->setChunksize(this->m_context.getChunksize());
     executionGroup->initExecution();
   }
+  if (use_cache) {
+    cache.skipRestoredGroups();
+  }
 
   WorkScheduler::start(this->m_context);
 
   executeGroups(COM_PRIORITY_HIGH);
-  if (!this->getContext().isFastCalculation()) {
+  /* A reduced resolution pass only updates the viewers, the full pass follows right after. */
+  if (!this->getContext().isFastCalculation() && this->getContext().getResolutionDivider() == 1) {
     executeGroups(COM_PRIORITY_MEDIUM);
     executeGroups(COM_PRIORITY_LOW);
   }
@@ -188,6 +202,11 @@ void ExecutionSystem::execute()
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  updateNodeExecutionStats();
+  if (use_cache) {
+    cache.storeBuffers(this);
+  }
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -199,6 +218,43 @@ void ExecutionSystem::execute()
   }
 }
 
+/* Clear the stats of the previous execution, including the nodes inside groups. */
+static void clear_node_execution_stats(const bNodeTree *ntree)
+{
+  LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+    node->exec_time = 0.0f;
+    node->exec_memory = 0.0f;
+    if (node->type == NODE_GROUP && node->id) {
+      clear_node_execution_stats((const bNodeTree *)node->id);
+    }
+  }
+}
+
+/* Group nodes show the sum of the nodes inside them. */
+static void sum_group_execution_stats(const bNodeTree *ntree)
+{
+  LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+    if (node->type == NODE_GROUP && node->id) {
+      const bNodeTree *group_tree = (const bNodeTree *)node->id;
+      sum_group_execution_stats(group_tree);
+      LISTBASE_FOREACH (const bNode *, group_node, &group_tree->nodes) {
+        node->exec_time += group_node->exec_time;
+        node->exec_memory += group_node->exec_memory;
+      }
+    }
+  }
+}
+
+void ExecutionSystem::updateNodeExecutionStats()
+{
+  const bNodeTree *editingtree = this->m_context.getbNodeTree();
+  clear_node_execution_stats(editingtree);
+  for (ExecutionGroup *group : this->m_groups) {
+    group->updateNodeExecutionStats();
+  }
+  sum_group_execution_stats(editingtree);
+}
+
 void ExecutionSystem::executeGroups(CompositorPriority priority)
 {
   unsigned int index;
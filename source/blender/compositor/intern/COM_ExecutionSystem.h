@@ -152,12 +152,14 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param resolution_divider: viewers calculate every n-th pixel, 1 for full resolution.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
                   bNodeTree *editingtree,
                   bool rendering,
                   bool fastcalculation,
+                  int resolution_divider,
                   const ColorManagedViewSettings *viewSettings,
                   const ColorManagedDisplaySettings *displaySettings,
                   const char *viewName);
@@ -188,8 +190,15 @@ class ExecutionSystem {
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief store the execution time and memory of the executed groups in the nodes.
+   * \note must be called before the buffers are freed or given to the BufferCache.
+   */
+  void updateNodeExecutionStats();
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
+  friend class BufferCache;
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:ExecutionSystem")
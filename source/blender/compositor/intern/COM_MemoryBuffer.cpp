@@ -17,6 +17,7 @@
  */
 
 #include "COM_MemoryBuffer.h"
+#include "COM_MemoryBufferPool.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -58,8 +59,8 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = chunkNumber;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = MemoryBufferPool::allocate(sizeof(float) * determineBufferSize() *
+                                              this->m_num_channels);
   this->m_state = COM_MB_ALLOCATED;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -72,8 +73,8 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = MemoryBufferPool::allocate(sizeof(float) * determineBufferSize() *
+                                              this->m_num_channels);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -86,8 +87,8 @@ MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
   this->m_memoryProxy = nullptr;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(dataType);
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = MemoryBufferPool::allocate(sizeof(float) * determineBufferSize() *
+                                              this->m_num_channels);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = dataType;
 }
@@ -104,6 +105,19 @@ void MemoryBuffer::clear()
   memset(this->m_buffer, 0, this->determineBufferSize() * this->m_num_channels * sizeof(float));
 }
 
+void MemoryBuffer::fill(const rcti *area, const float *value)
+{
+  const size_t pixel_size = sizeof(float) * this->m_num_channels;
+  for (int y = area->ymin; y < area->ymax; y++) {
+    float *buffer = this->m_buffer + ((y - this->m_rect.ymin) * this->m_width + area->xmin -
+                                      this->m_rect.xmin) *
+                                         this->m_num_channels;
+    for (int x = area->xmin; x < area->xmax; x++, buffer += this->m_num_channels) {
+      memcpy(buffer, value, pixel_size);
+    }
+  }
+}
+
 float MemoryBuffer::getMaximumValue()
 {
   float result = this->m_buffer[0];
@@ -144,7 +158,7 @@ float MemoryBuffer::getMaximumValue(rcti *rect)
 MemoryBuffer::~MemoryBuffer()
 {
   if (this->m_buffer) {
-    MEM_freeN(this->m_buffer);
+    MemoryBufferPool::release(this->m_buffer);
     this->m_buffer = nullptr;
   }
 }
@@ -344,6 +344,11 @@ class MemoryBuffer {
    */
   void clear();
 
+  /**
+   * \brief set all pixels of \a area to \a value, which has a value per channel.
+   */
+  void fill(const rcti *area, const float *value);
+
   MemoryBuffer *duplicate();
 
   float getMaximumValue();
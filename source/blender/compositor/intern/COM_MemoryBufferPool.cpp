@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <map>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_threads.h"
+
+#include "COM_BufferCache.h"
+#include "COM_MemoryBufferPool.h"
+
+/** Arrays not in use, by their size in bytes. */
+static std::map<size_t, std::vector<float *>> s_free_buffers;
+static ThreadMutex s_lock = BLI_MUTEX_INITIALIZER;
+static size_t s_limit = 0;
+/** Bytes of the arrays handed out, including the ones owned by BufferCache. */
+static size_t s_used_size = 0;
+/** Bytes of the arrays in #s_free_buffers. */
+static size_t s_free_size = 0;
+
+/* Free kept arrays until all arrays fit in \a limit, must be called with #s_lock held. */
+static void free_buffers_until(size_t limit)
+{
+  std::map<size_t, std::vector<float *>>::iterator it = s_free_buffers.begin();
+  while (s_used_size + s_free_size > limit && it != s_free_buffers.end()) {
+    for (float *buffer : it->second) {
+      MEM_freeN(buffer);
+      s_free_size -= it->first;
+    }
+    it = s_free_buffers.erase(it);
+  }
+}
+
+float *MemoryBufferPool::allocate(size_t size)
+{
+  float *buffer = nullptr;
+  bool over_limit = false;
+
+  BLI_mutex_lock(&s_lock);
+  std::map<size_t, std::vector<float *>>::iterator found = s_free_buffers.find(size);
+  if (found != s_free_buffers.end()) {
+    buffer = found->second.back();
+    found->second.pop_back();
+    if (found->second.empty()) {
+      s_free_buffers.erase(found);
+    }
+    s_free_size -= size;
+  }
+  else if (s_limit) {
+    if (s_used_size + s_free_size + size > s_limit) {
+      free_buffers_until(s_limit > size ? s_limit - size : 0);
+    }
+    over_limit = s_used_size + size > s_limit;
+  }
+  s_used_size += size;
+  BLI_mutex_unlock(&s_lock);
+
+  if (over_limit) {
+    /* Cached results free their arrays through #release, so this can't be done holding the lock. */
+    BufferCache::freeUnused(size);
+  }
+  if (buffer == nullptr) {
+    buffer = (float *)MEM_mallocN_aligned(size, 16, "COM_MemoryBuffer");
+  }
+  return buffer;
+}
+
+void MemoryBufferPool::release(float *buffer)
+{
+  const size_t size = MEM_allocN_len(buffer);
+
+  BLI_mutex_lock(&s_lock);
+  s_used_size -= size;
+  if (s_limit == 0 || s_used_size + s_free_size + size <= s_limit) {
+    s_free_buffers[size].push_back(buffer);
+    s_free_size += size;
+    buffer = nullptr;
+  }
+  BLI_mutex_unlock(&s_lock);
+
+  if (buffer) {
+    MEM_freeN(buffer);
+  }
+}
+
+void MemoryBufferPool::setLimit(size_t limit)
+{
+  BLI_mutex_lock(&s_lock);
+  s_limit = limit;
+  BLI_mutex_unlock(&s_lock);
+}
+
+void MemoryBufferPool::trim()
+{
+  BLI_mutex_lock(&s_lock);
+  free_buffers_until(s_limit);
+  BLI_mutex_unlock(&s_lock);
+}
+
+void MemoryBufferPool::clear()
+{
+  BLI_mutex_lock(&s_lock);
+  free_buffers_until(0);
+  BLI_mutex_unlock(&s_lock);
+}
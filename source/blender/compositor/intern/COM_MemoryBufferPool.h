@@ -0,0 +1,60 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * \brief Recycles the pixel arrays of MemoryBuffers within a memory budget.
+ *
+ * Freed arrays are kept for the next MemoryBuffer of the same size, so temporary buffers
+ * created per chunk don't go through the allocator every time. When the memory used by the
+ * compositor passes the budget, kept arrays are freed first and then the results cached by
+ * BufferCache. The budget is a soft limit, buffers needed by the execution are always allocated.
+ * \ingroup Memory
+ */
+class MemoryBufferPool {
+ public:
+  /**
+   * \brief allocate an array of \a size bytes, aligned for SSE.
+   * \note can be called from any thread, like #release.
+   */
+  static float *allocate(size_t size);
+
+  /**
+   * \brief give an array back to the pool.
+   */
+  static void release(float *buffer);
+
+  /**
+   * \brief set the budget in bytes, zero for no limit.
+   * Without a limit the kept arrays are freed after every execution.
+   */
+  static void setLimit(size_t limit);
+
+  /**
+   * \brief called after an execution to free the kept arrays not allowed by the budget.
+   */
+  static void trim();
+
+  /**
+   * \brief free all kept arrays.
+   */
+  static void clear();
+};
@@ -112,6 +112,16 @@ class MemoryProxy {
    */
   void free();
 
+  /**
+   * \brief take over the allocated memory, it won't be freed by this proxy anymore
+   */
+  MemoryBuffer *releaseBuffer()
+  {
+    MemoryBuffer *buffer = this->m_buffer;
+    this->m_buffer = nullptr;
+    return buffer;
+  }
+
   /**
    * \brief get the allocated memory
    */
@@ -17,6 +17,7 @@
  */
 
 #include <cstdio>
+#include <cstring>
 #include <typeinfo>
 
 #include "COM_ExecutionSystem.h"
@@ -37,6 +38,8 @@ NodeOperation::NodeOperation()
   this->m_isResolutionSet = false;
   this->m_openCL = false;
   this->m_btree = nullptr;
+  this->m_bnode = nullptr;
+  this->m_node_operation_index = 0;
 }
 
 NodeOperation::~NodeOperation()
@@ -149,6 +152,33 @@ NodeOperation *NodeOperation::getInputOperation(unsigned int inputSocketIndex)
   return nullptr;
 }
 
+void NodeOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  const rcti *rect = output->getRect();
+  const int num_channels = output->get_num_channels();
+  float *buffer = output->getBuffer();
+  for (int y = area->ymin; y < area->ymax; y++) {
+    int offset = ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * num_channels;
+    for (int x = area->xmin; x < area->xmax; x++) {
+      /* Sample into a full color, operations may write all channels regardless of their type. */
+      float color[4];
+      this->executePixelSampled(color, x, y, COM_PS_NEAREST);
+      memcpy(&buffer[offset], color, sizeof(float) * num_channels);
+      offset += num_channels;
+    }
+  }
+}
+
+MemoryBuffer *NodeOperation::readInputArea(unsigned int inputSocketIndex, const rcti *area)
+{
+  NodeOperation *input = this->getInputOperation(inputSocketIndex);
+  rcti buffer_rect = *area;
+  MemoryBuffer *buffer = new MemoryBuffer(getInputSocket(inputSocketIndex)->getDataType(),
+                                          &buffer_rect);
+  input->executeArea(buffer, area);
+  return buffer;
+}
+
 void NodeOperation::getConnectedInputSockets(Inputs *sockets)
 {
   for (Inputs::const_iterator it = m_inputs.begin(); it != m_inputs.end(); ++it) {
@@ -37,6 +37,7 @@ using std::list;
 using std::max;
 using std::min;
 
+class BufferCacheKey;
 class OpenCLDevice;
 class ReadBufferOperation;
 class WriteBufferOperation;
@@ -123,6 +124,18 @@ class NodeOperation : public SocketReader {
    */
   bool m_isResolutionSet;
 
+  /**
+   * \brief the node this operation was created for, if any
+   */
+  bNode *m_bnode;
+
+  /**
+   * \brief index among the operations created for the same node, tells apart operations of the
+   * same type which only differ in their members
+   * \see BufferCache
+   */
+  int m_node_operation_index;
+
  public:
   virtual ~NodeOperation();
 
@@ -187,6 +200,33 @@ class NodeOperation : public SocketReader {
   {
     this->m_btree = tree;
   }
+
+  void setbNode(bNode *node)
+  {
+    this->m_bnode = node;
+  }
+  bNode *getbNode() const
+  {
+    return this->m_bnode;
+  }
+
+  void setNodeOperationIndex(int index)
+  {
+    this->m_node_operation_index = index;
+  }
+  int getNodeOperationIndex() const
+  {
+    return this->m_node_operation_index;
+  }
+
+  /**
+   * \brief add the parameters of this operation that don't come from its node to \a key
+   * \see BufferCache
+   */
+  virtual void hashParameters(BufferCacheKey & /*key*/) const
+  {
+  }
+
   virtual void initExecution();
 
   /**
@@ -200,6 +240,19 @@ class NodeOperation : public SocketReader {
   {
   }
 
+  /**
+   * \brief calculate the output of this operation for a whole area at once
+   * \ingroup execution
+   * \param output: buffer to write to, its rect must contain \a area
+   * \param area: the area to calculate
+   *
+   * The default implementation samples the operation pixel by pixel. Operations overriding this
+   * process whole rows at a time, reading their inputs with #readInputArea, so the per pixel
+   * virtual calls are only paid at the boundaries of the operations that don't.
+   * \note only called for operations that are not complex.
+   */
+  virtual void executeArea(MemoryBuffer *output, const rcti *area);
+
   /**
    * \brief when a chunk is executed by an OpenCLDevice, this method is called
    * \ingroup execution
@@ -396,6 +449,12 @@ class NodeOperation : public SocketReader {
   SocketReader *getInputSocketReader(unsigned int inputSocketindex);
   NodeOperation *getInputOperation(unsigned int inputSocketindex);
 
+  /**
+   * \brief calculate the given input for \a area into a new buffer, see #executeArea
+   * \note the caller owns the returned buffer.
+   */
+  MemoryBuffer *readInputArea(unsigned int inputSocketIndex, const rcti *area);
+
   void deinitMutex();
   void initMutex();
   void lockMutex();
@@ -422,6 +481,7 @@ class NodeOperation : public SocketReader {
 
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
+  friend class BufferCache;
 
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:NodeOperation")
@@ -57,8 +57,14 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
     m_current_node = node;
 
+    const int operations_start = (int)m_operations.size();
     DebugInfo::node_to_operations(node);
     node->convertToOperations(converter, *m_context);
+
+    /* Numbered before pruning, so that the index only depends on the node. */
+    for (int op_index = operations_start; op_index < (int)m_operations.size(); op_index++) {
+      m_operations[op_index]->setNodeOperationIndex(op_index - operations_start);
+    }
   }
 
   m_current_node = nullptr;
@@ -125,6 +131,9 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  if (m_current_node) {
+    operation->setbNode(m_current_node->getbNode());
+  }
   m_operations.push_back(operation);
 }
 
@@ -19,6 +19,8 @@
 #include "COM_OpenCLDevice.h"
 #include "COM_WorkScheduler.h"
 
+#include "PIL_time.h"
+
 enum COM_VendorID { NVIDIA = 0x10DE, AMD = 0x1002 };
 const cl_image_format IMAGE_FORMAT_COLOR = {
     CL_RGBA,
@@ -69,13 +71,25 @@ void OpenCLDevice::execute(WorkPackage *work)
   MemoryBuffer **inputBuffers = executionGroup->getInputBuffersOpenCL(chunkNumber);
   MemoryBuffer *outputBuffer = executionGroup->allocateOutputBuffer(chunkNumber, &rect);
 
+  const double start_time = PIL_check_seconds_timer();
   executionGroup->getOutputOperation()->executeOpenCLRegion(
       this, &rect, chunkNumber, inputBuffers, outputBuffer);
+  executionGroup->addExecutionTime(PIL_check_seconds_timer() - start_time);
 
   delete outputBuffer;
 
   executionGroup->finalizeChunkExecution(chunkNumber, inputBuffers);
 }
+void OpenCLDevice::releaseResidentBuffers()
+{
+  for (map<MemoryBuffer *, cl_mem>::iterator it = this->m_resident_buffers.begin();
+       it != this->m_resident_buffers.end();
+       ++it) {
+    clReleaseMemObject(it->second);
+  }
+  this->m_resident_buffers.clear();
+}
+
 cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
                                                                int parameterIndex,
                                                                int offsetIndex,
@@ -119,22 +133,37 @@ cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
 
   MemoryBuffer *result = reader->getInputMemoryBuffer(inputMemoryBuffers);
 
-  const cl_image_format *imageFormat = determineImageFormat(result);
+  /* Complete buffers (see #ExecutionGroup::getInputBuffersOpenCL) stay on the device for all
+   * chunks reading from them, instead of being transferred again for every chunk. */
+  const bool resident = !result->isTemporarily();
+  map<MemoryBuffer *, cl_mem>::iterator found = this->m_resident_buffers.find(result);
+  cl_mem clBuffer;
+  if (resident && found != this->m_resident_buffers.end()) {
+    clBuffer = found->second;
+  }
+  else {
+    const cl_image_format *imageFormat = determineImageFormat(result);
 
-  cl_mem clBuffer = clCreateImage2D(this->m_context,
-                                    CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                    imageFormat,
-                                    result->getWidth(),
-                                    result->getHeight(),
-                                    0,
-                                    result->getBuffer(),
-                                    &error);
+    clBuffer = clCreateImage2D(this->m_context,
+                               CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                               imageFormat,
+                               result->getWidth(),
+                               result->getHeight(),
+                               0,
+                               result->getBuffer(),
+                               &error);
 
-  if (error != CL_SUCCESS) {
-    printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
-  }
-  if (error == CL_SUCCESS) {
-    cleanup->push_back(clBuffer);
+    if (error != CL_SUCCESS) {
+      printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
+    }
+    if (error == CL_SUCCESS) {
+      if (resident) {
+        this->m_resident_buffers[result] = clBuffer;
+      }
+      else {
+        cleanup->push_back(clBuffer);
+      }
+    }
   }
 
   error = clSetKernelArg(kernel, parameterIndex, sizeof(cl_mem), &clBuffer);
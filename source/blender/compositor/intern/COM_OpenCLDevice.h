@@ -25,7 +25,10 @@ class OpenCLDevice;
 #include "COM_WorkScheduler.h"
 #include "clew.h"
 
+#include <map>
+
 using std::list;
+using std::map;
 
 /**
  * \brief device representing an GPU OpenCL device.
@@ -58,6 +61,12 @@ class OpenCLDevice : public Device {
    */
   cl_int m_vendorID;
 
+  /**
+   * \brief images of complete input buffers, uploaded once and shared by all chunks
+   * \see releaseResidentBuffers
+   */
+  map<MemoryBuffer *, cl_mem> m_resident_buffers;
+
  public:
   /**
    * \brief constructor with opencl device
@@ -88,6 +97,12 @@ class OpenCLDevice : public Device {
    */
   void execute(WorkPackage *work);
 
+  /**
+   * \brief release the images kept on the device during an execution
+   * \note must be called when the execution has finished, the buffers are freed afterwards.
+   */
+  void releaseResidentBuffers();
+
   /**
    * \brief determine an image format
    * \param memorybuffer:
@@ -29,6 +29,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_assert.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "PIL_time.h"
 
@@ -39,6 +41,8 @@
 #    warning COM_CURRENT_THREADING_MODEL COM_TM_NOTHREAD is activated. Use only for debugging.
 #  endif
 #elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+/* do nothing */
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASKPOOL
 /* do nothing - default */
 #else
 #  error COM_CURRENT_THREADING_MODEL No threading model selected
@@ -48,12 +52,21 @@
 static vector<CPUDevice *> g_cpudevices;
 static ThreadLocal(CPUDevice *) g_thread_device;
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-/** \brief list of all thread for every CPUDevice in cpudevices a thread exists. */
-static ListBase g_cputhreads;
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 static bool g_cpuInitialized = false;
 /** \brief all scheduled work for the cpu */
 static ThreadQueue *g_cpuqueue;
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+/** \brief list of all thread for every CPUDevice in cpudevices a thread exists. */
+static ListBase g_cputhreads;
+#  else
+/**
+ * \brief pool with at most one task per CPUDevice, executing the scheduled work.
+ * The number of devices is the configured number of render threads, which bounds the
+ * concurrency of the compositor, and the thread id of a device is unique among the tasks.
+ */
+static TaskPool *g_cpupool;
+#  endif
 static ThreadQueue *g_gpuqueue;
 #  ifdef COM_OPENCL_ENABLED
 static cl_context g_context;
@@ -69,7 +82,8 @@ static bool g_openclInitialized = false;
 #  endif
 #endif
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
 void *WorkScheduler::thread_execute_cpu(void *data)
 {
   CPUDevice *device = (CPUDevice *)data;
@@ -82,6 +96,21 @@ void *WorkScheduler::thread_execute_cpu(void *data)
 
   return nullptr;
 }
+#  else
+void WorkScheduler::thread_execute_cpu_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  CPUDevice *device = (CPUDevice *)taskdata;
+  WorkPackage *work;
+  /* The threads of the task scheduler are shared, restore the device of an outer task. */
+  CPUDevice *outer_device = (CPUDevice *)BLI_thread_local_get(g_thread_device);
+  BLI_thread_local_set(g_thread_device, device);
+  while ((work = (WorkPackage *)BLI_thread_queue_pop_timeout(g_cpuqueue, 0))) {
+    device->execute(work);
+    delete work;
+  }
+  BLI_thread_local_set(g_thread_device, outer_device);
+}
+#  endif
 
 void *WorkScheduler::thread_execute_gpu(void *data)
 {
@@ -104,30 +133,32 @@ void WorkScheduler::schedule(ExecutionGroup *group, int chunkNumber)
   CPUDevice device(0);
   device.execute(package);
   delete package;
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#else
 #  ifdef COM_OPENCL_ENABLED
   if (group->isOpenCL() && g_openclActive) {
     BLI_thread_queue_push(g_gpuqueue, package);
+    return;
   }
-  else {
-    BLI_thread_queue_push(g_cpuqueue, package);
-  }
-#  else
-  BLI_thread_queue_push(g_cpuqueue, package);
 #  endif
+  /* With the task pool, the work is executed by #finish. */
+  BLI_thread_queue_push(g_cpuqueue, package);
 #endif
 }
 
 void WorkScheduler::start(CompositorContext &context)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   unsigned int index;
   g_cpuqueue = BLI_thread_queue_init();
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   BLI_threadpool_init(&g_cputhreads, thread_execute_cpu, g_cpudevices.size());
   for (index = 0; index < g_cpudevices.size(); index++) {
     Device *device = g_cpudevices[index];
     BLI_threadpool_insert(&g_cputhreads, device);
   }
+#  else
+  g_cpupool = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+#  endif
 #  ifdef COM_OPENCL_ENABLED
   if (context.getHasActiveOpenCLDevices()) {
     g_gpuqueue = BLI_thread_queue_init();
@@ -146,25 +177,35 @@ void WorkScheduler::start(CompositorContext &context)
 }
 void WorkScheduler::finish()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_wait_finish(g_gpuqueue);
-    BLI_thread_queue_wait_finish(g_cpuqueue);
-  }
-  else {
-    BLI_thread_queue_wait_finish(g_cpuqueue);
   }
+#  endif
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+  BLI_thread_queue_wait_finish(g_cpuqueue);
 #  else
-  BLI_thread_queue_wait_finish(cpuqueue);
+  /* One task per device at most, each executes work until the queue is empty. */
+  const int num_tasks = MIN2((int)g_cpudevices.size(), BLI_thread_queue_len(g_cpuqueue));
+  for (int index = 0; index < num_tasks; index++) {
+    BLI_task_pool_push(g_cpupool, thread_execute_cpu_task, g_cpudevices[index], false, nullptr);
+  }
+  BLI_task_pool_work_and_wait(g_cpupool);
 #  endif
 #endif
 }
 void WorkScheduler::stop()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   BLI_thread_queue_nowait(g_cpuqueue);
   BLI_threadpool_end(&g_cputhreads);
+#  else
+  finish();
+  BLI_task_pool_free(g_cpupool);
+  g_cpupool = nullptr;
+#  endif
   BLI_thread_queue_free(g_cpuqueue);
   g_cpuqueue = nullptr;
 #  ifdef COM_OPENCL_ENABLED
@@ -173,6 +214,9 @@ void WorkScheduler::stop()
     BLI_threadpool_end(&g_gputhreads);
     BLI_thread_queue_free(g_gpuqueue);
     g_gpuqueue = nullptr;
+    for (OpenCLDevice *device : g_gpudevices) {
+      device->releaseResidentBuffers();
+    }
   }
 #  endif
 #endif
@@ -180,7 +224,7 @@ void WorkScheduler::stop()
 
 bool WorkScheduler::hasGPUDevices()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 #  ifdef COM_OPENCL_ENABLED
   return !g_gpudevices.empty();
 #  else
@@ -191,7 +235,7 @@ bool WorkScheduler::hasGPUDevices()
 #endif
 }
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
 static void CL_CALLBACK clContextError(const char *errinfo,
                                        const void * /*private_info*/,
                                        size_t /*cb*/,
@@ -203,7 +247,7 @@ static void CL_CALLBACK clContextError(const char *errinfo,
 
 void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   /* deinitialize if number of threads doesn't match */
   if (g_cpudevices.size() != num_cpu_threads) {
     Device *device;
@@ -325,7 +369,7 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
 
 void WorkScheduler::deinitialize()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   /* deinitialize CPU threads */
   if (g_cpuInitialized) {
     Device *device;
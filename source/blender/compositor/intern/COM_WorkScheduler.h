@@ -20,6 +20,7 @@
 
 #include "COM_ExecutionGroup.h"
 
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "COM_Device.h"
@@ -31,17 +32,24 @@
  */
 class WorkScheduler {
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL != COM_TM_NOTHREAD
   /**
    * \brief are we being stopped.
    */
   static bool isStopping();
 
+#  if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
   /**
    * \brief main thread loop for cpudevices
    * inside this loop new work is queried and being executed
    */
   static void *thread_execute_cpu(void *data);
+#  else
+  /**
+   * \brief task executing WorkPackages from the queue on its CPUDevice until it's empty
+   */
+  static void thread_execute_cpu_task(TaskPool *__restrict pool, void *taskdata);
+#  endif
 
   /**
    * \brief main thread loop for gpudevices
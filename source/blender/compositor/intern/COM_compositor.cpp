@@ -23,7 +23,9 @@
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "COM_BufferCache.h"
 #include "COM_ExecutionSystem.h"
+#include "COM_MemoryBufferPool.h"
 #include "COM_MovieDistortionOperation.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
@@ -79,32 +81,44 @@ void COM_execute(RenderData *rd,
   /* initialize workscheduler, will check if already done. TODO deinitialize somewhere */
   bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
   WorkScheduler::initialize(use_opencl, BKE_render_num_threads(rd));
+  MemoryBufferPool::setLimit((size_t)editingtree->memory_limit * 1024 * 1024);
 
   /* set progress bar to 0% and status to init compositing */
   editingtree->progress(editingtree->prh, 0.0);
   editingtree->stats_draw(editingtree->sdh, IFACE_("Compositing"));
 
   bool twopass = (editingtree->flag & NTREE_TWO_PASS) && !rendering;
+  bool preview_resolution = (editingtree->flag & NTREE_PREVIEW_RESOLUTION) && !rendering;
   /* initialize execution system */
-  if (twopass) {
+  if (twopass || preview_resolution) {
     ExecutionSystem *system = new ExecutionSystem(
-        rd, scene, editingtree, rendering, twopass, viewSettings, displaySettings, viewName);
+        rd,
+        scene,
+        editingtree,
+        rendering,
+        twopass,
+        preview_resolution ? COM_PREVIEW_RESOLUTION_DIVIDER : 1,
+        viewSettings,
+        displaySettings,
+        viewName);
     system->execute();
     delete system;
 
     if (editingtree->test_break(editingtree->tbh)) {
       // during editing multiple calls to this method can be triggered.
       // make sure one the last one will be doing the work.
+      MemoryBufferPool::trim();
       BLI_mutex_unlock(&s_compositorMutex);
       return;
     }
   }
 
   ExecutionSystem *system = new ExecutionSystem(
-      rd, scene, editingtree, rendering, false, viewSettings, displaySettings, viewName);
+      rd, scene, editingtree, rendering, false, 1, viewSettings, displaySettings, viewName);
   system->execute();
   delete system;
 
+  MemoryBufferPool::trim();
   BLI_mutex_unlock(&s_compositorMutex);
 }
 
@@ -113,8 +127,15 @@ void COM_deinitialize()
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
+    BufferCache::clear();
+    MemoryBufferPool::clear();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
     BLI_mutex_end(&s_compositorMutex);
   }
 }
+
+void COM_clearCaches()
+{
+  BufferCache::invalidate();
+}
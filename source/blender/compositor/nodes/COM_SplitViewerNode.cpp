@@ -63,6 +63,7 @@ void SplitViewerNode::convertToOperations(NodeConverter &converter,
   viewerOperation->setChunkOrder(COM_ORDER_OF_CHUNKS_DEFAULT);
   viewerOperation->setCenterX(0.5f);
   viewerOperation->setCenterY(0.5f);
+  viewerOperation->setResolutionDivider(context.getResolutionDivider());
 
   converter.addOperation(viewerOperation);
   converter.addLink(splitViewerOperation->getOutputSocket(), viewerOperation->getInputSocket(0));
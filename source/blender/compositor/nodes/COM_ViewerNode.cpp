@@ -50,6 +50,7 @@ void ViewerNode::convertToOperations(NodeConverter &converter,
   viewerOperation->setChunkOrder((OrderOfChunks)editorNode->custom1);
   viewerOperation->setCenterX(editorNode->custom3);
   viewerOperation->setCenterY(editorNode->custom4);
+  viewerOperation->setResolutionDivider(context.getResolutionDivider());
   /* alpha socket gives either 1 or a custom alpha value if "use alpha" is enabled */
   viewerOperation->setUseAlphaInput(ignore_alpha || alphaSocket->isLinked());
   viewerOperation->setRenderData(context.getRenderData());
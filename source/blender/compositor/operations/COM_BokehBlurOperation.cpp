@@ -39,6 +39,7 @@ BokehBlurOperation::BokehBlurOperation()
   this->m_inputBoundingBoxReader = nullptr;
 
   this->m_extend_bounds = false;
+  this->m_kernel_radius = 0;
 }
 
 void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
@@ -47,6 +48,9 @@ void *BokehBlurOperation::initializeTileData(rcti * /*rect*/)
   if (!this->m_sizeavailable) {
     updateSize();
   }
+  if (this->m_kernel_radius == 0) {
+    updateKernel();
+  }
   void *buffer = getInputOperation(0)->initializeTileData(nullptr);
   unlockMutex();
   return buffer;
@@ -108,16 +112,35 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
     int offsetadd = getOffsetAdd() * COM_NUM_CHANNELS_COLOR;
 
     float m = this->m_bokehDimension / pixelSize;
-    for (int ny = miny; ny < maxy; ny += step) {
-      int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
-                        ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
-      for (int nx = minx; nx < maxx; nx += step) {
-        float u = this->m_bokehMidX - (nx - x) * m;
-        float v = this->m_bokehMidY - (ny - y) * m;
-        this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
-        madd_v4_v4v4(color_accum, bokeh, &buffer[bufferindex]);
-        add_v4_v4(multiplier_accum, bokeh);
-        bufferindex += offsetadd;
+    if (pixelSize == this->m_kernel_radius) {
+      for (int ny = miny; ny < maxy; ny++) {
+        const int row = ny - y + pixelSize;
+        const float *buffer_row = &buffer[(ny - bufferstarty) * COM_NUM_CHANNELS_COLOR *
+                                          bufferwidth];
+        for (int tap = this->m_kernel_rows[row]; tap < this->m_kernel_rows[row + 1]; tap++) {
+          const KernelTap &kernel_tap = this->m_kernel_taps[tap];
+          const int nx = x + kernel_tap.dx;
+          if (nx >= minx && nx < maxx) {
+            madd_v4_v4v4(color_accum,
+                         kernel_tap.weight,
+                         &buffer_row[(nx - bufferstartx) * COM_NUM_CHANNELS_COLOR]);
+            add_v4_v4(multiplier_accum, kernel_tap.weight);
+          }
+        }
+      }
+    }
+    else {
+      for (int ny = miny; ny < maxy; ny += step) {
+        int bufferindex = ((minx - bufferstartx) * COM_NUM_CHANNELS_COLOR) +
+                          ((ny - bufferstarty) * COM_NUM_CHANNELS_COLOR * bufferwidth);
+        for (int nx = minx; nx < maxx; nx += step) {
+          float u = this->m_bokehMidX - (nx - x) * m;
+          float v = this->m_bokehMidY - (ny - y) * m;
+          this->m_inputBokehProgram->readSampled(bokeh, u, v, COM_PS_NEAREST);
+          madd_v4_v4v4(color_accum, bokeh, &buffer[bufferindex]);
+          add_v4_v4(multiplier_accum, bokeh);
+          bufferindex += offsetadd;
+        }
       }
     }
     output[0] = color_accum[0] * (1.0f / multiplier_accum[0]);
@@ -130,12 +153,45 @@ void BokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
   }
 }
 
+void BokehBlurOperation::updateKernel()
+{
+  /* The kernel only matches the sampling of #executePixel when every pixel is read. */
+  const float max_dim = max(this->getWidth(), this->getHeight());
+  const int pixelSize = this->m_size * max_dim / 100.0f;
+  if (getStep() != 1 || pixelSize < 2) {
+    this->m_kernel_radius = -1;
+    return;
+  }
+
+  const float m = this->m_bokehDimension / pixelSize;
+  this->m_kernel_taps.clear();
+  this->m_kernel_rows.clear();
+  for (int dy = -pixelSize; dy < pixelSize; dy++) {
+    this->m_kernel_rows.push_back(this->m_kernel_taps.size());
+    for (int dx = -pixelSize; dx < pixelSize; dx++) {
+      KernelTap tap;
+      tap.dx = dx;
+      this->m_inputBokehProgram->readSampled(
+          tap.weight, this->m_bokehMidX - dx * m, this->m_bokehMidY - dy * m, COM_PS_NEAREST);
+      /* Taps outside of the bokeh shape add nothing. */
+      if (!is_zero_v4(tap.weight)) {
+        this->m_kernel_taps.push_back(tap);
+      }
+    }
+  }
+  this->m_kernel_rows.push_back(this->m_kernel_taps.size());
+  this->m_kernel_radius = pixelSize;
+}
+
 void BokehBlurOperation::deinitExecution()
 {
   deinitMutex();
   this->m_inputProgram = nullptr;
   this->m_inputBokehProgram = nullptr;
   this->m_inputBoundingBoxReader = nullptr;
+  this->m_kernel_taps.clear();
+  this->m_kernel_rows.clear();
+  this->m_kernel_radius = 0;
 }
 
 bool BokehBlurOperation::determineDependingAreaOfInterest(rcti *input,
@@ -34,6 +34,21 @@ class BokehBlurOperation : public NodeOperation, public QualityStepHelper {
   float m_bokehDimension;
   bool m_extend_bounds;
 
+  /**
+   * Taps of the bokeh with a non zero weight, sorted by row of the kernel.
+   * Used at full quality instead of sampling the bokeh image for every tap of every pixel.
+   */
+  struct KernelTap {
+    int dx;
+    float weight[4];
+  };
+  vector<KernelTap> m_kernel_taps;
+  /* Index of the first tap of each row, the last item is the number of taps. */
+  vector<int> m_kernel_rows;
+  /* Radius the kernel has been built for, zero when not built. */
+  int m_kernel_radius;
+  void updateKernel();
+
  public:
   BokehBlurOperation();
 
@@ -79,6 +79,34 @@ void ColorBalanceLGGOperation::executePixelSampled(float output[4],
   output[3] = inputColor[3];
 }
 
+void ColorBalanceLGGOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  MemoryBuffer *value_input = this->readInputArea(0, area);
+  MemoryBuffer *color_input = this->readInputArea(1, area);
+  const rcti *rect = output->getRect();
+  const int width = BLI_rcti_size_x(area);
+  const float *value = value_input->getBuffer();
+  const float *color = color_input->getBuffer();
+
+  for (int y = area->ymin; y < area->ymax; y++) {
+    float *dst = output->getBuffer() +
+                 ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * 4;
+    for (int x = 0; x < width; x++, dst += 4, color += 4, value++) {
+      const float fac = min(1.0f, value[0]);
+      const float mfac = 1.0f - fac;
+      for (int i = 0; i < 3; i++) {
+        dst[i] = mfac * color[i] +
+                 fac * colorbalance_lgg(
+                           color[i], this->m_lift[i], this->m_gamma_inv[i], this->m_gain[i]);
+      }
+      dst[3] = color[3];
+    }
+  }
+
+  delete value_input;
+  delete color_input;
+}
+
 void ColorBalanceLGGOperation::deinitExecution()
 {
   this->m_inputValueOperation = nullptr;
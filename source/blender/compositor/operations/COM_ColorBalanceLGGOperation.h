@@ -46,6 +46,7 @@ class ColorBalanceLGGOperation : public NodeOperation {
    * The inner loop of this operation.
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 
   /**
    * Initialize the execution
@@ -38,6 +38,16 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
   void *initializeTileData(rcti *rect);
   void deinitExecution();
   void initExecution();
+
+  /**
+   * The blur is calculated once for the whole image, filtering the rows and columns in
+   * parallel. A single chunk keeps the other threads free for that instead of waiting on the
+   * mutex.
+   */
+  int isSingleThreaded()
+  {
+    return true;
+  }
 };
 
 enum {
@@ -78,4 +88,9 @@ class FastGaussianBlurValueOperation : public NodeOperation {
   {
     this->m_overlay = overlay;
   }
+
+  int isSingleThreaded()
+  {
+    return true;
+  }
 };
@@ -49,6 +49,31 @@ void GammaOperation::executePixelSampled(float output[4], float x, float y, Pixe
   output[3] = inputValue[3];
 }
 
+void GammaOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  MemoryBuffer *input = this->readInputArea(0, area);
+  MemoryBuffer *gamma_input = this->readInputArea(1, area);
+  const rcti *rect = output->getRect();
+  const int width = BLI_rcti_size_x(area);
+  const float *color = input->getBuffer();
+  const float *gamma = gamma_input->getBuffer();
+
+  for (int y = area->ymin; y < area->ymax; y++) {
+    float *dst = output->getBuffer() +
+                 ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * 4;
+    for (int x = 0; x < width; x++, dst += 4, color += 4, gamma++) {
+      /* check for negative to avoid nan's */
+      for (int i = 0; i < 3; i++) {
+        dst[i] = color[i] > 0.0f ? powf(color[i], gamma[0]) : color[i];
+      }
+      dst[3] = color[3];
+    }
+  }
+
+  delete input;
+  delete gamma_input;
+}
+
 void GammaOperation::deinitExecution()
 {
   this->m_inputProgram = nullptr;
@@ -35,6 +35,7 @@ class GammaOperation : public NodeOperation {
    * The inner loop of this operation.
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 
   /**
    * Initialize the execution
@@ -19,6 +19,8 @@
 #include "COM_GlareFogGlowOperation.h"
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.h"
+
 /*
  *  2D Fast Hartley Transform, used for convolution
  */
@@ -123,6 +125,30 @@ static void FHT(fREAL *data, unsigned int M, unsigned int inverse)
   }
 }
 //------------------------------------------------------------------------------
+struct FHTRowsData {
+  fREAL *data;
+  unsigned int M;
+  unsigned int inverse;
+};
+
+static void fht_row_task(void *__restrict userdata,
+                         const int row,
+                         const TaskParallelTLS *__restrict /*tls*/)
+{
+  const FHTRowsData *rows = (const FHTRowsData *)userdata;
+  FHT(&rows->data[(size_t)row << rows->M], rows->M, rows->inverse);
+}
+
+/* Transform the first \a num_rows rows of width 2^M, in parallel as they are independent. */
+static void FHT_rows(fREAL *data, unsigned int M, unsigned int num_rows, unsigned int inverse)
+{
+  FHTRowsData rows = {data, M, inverse};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, num_rows, &rows, fht_row_task, &settings);
+}
+//------------------------------------------------------------------------------
 /* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
  * nzp -> the row where zero pad data starts,
  * inverse -> see above */
@@ -136,9 +162,7 @@ static void FHT2D(
 
   // rows (forward transform skips 0 pad data)
   maxy = inverse ? Ny : nzp;
-  for (j = 0; j < maxy; j++) {
-    FHT(&data[Nx * j], Mx, inverse);
-  }
+  FHT_rows(data, Mx, maxy, inverse);
 
   // transpose data
   if (Nx == Ny) {  // square
@@ -171,9 +195,7 @@ static void FHT2D(
   SWAP(unsigned int, Mx, My);
 
   // now columns == transposed rows
-  for (j = 0; j < Ny; j++) {
-    FHT(&data[Nx * j], Mx, inverse);
-  }
+  FHT_rows(data, Mx, Ny, inverse);
 
   // finalize
   for (j = 0; j <= (Ny >> 1); j++) {
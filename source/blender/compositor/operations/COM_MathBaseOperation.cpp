@@ -20,6 +20,10 @@
 
 #include "BLI_math.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 MathBaseOperation::MathBaseOperation()
 {
   this->addInputSocket(COM_DT_VALUE);
@@ -71,6 +75,43 @@ void MathBaseOperation::clampIfNeeded(float *color)
   }
 }
 
+static void math_clamp_row(float *output, int width)
+{
+  int i = 0;
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (; i + 4 <= width; i += 4) {
+    _mm_storeu_ps(&output[i], _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&output[i]), zero), one));
+  }
+#endif
+  for (; i < width; i++) {
+    CLAMP(output[i], 0.0f, 1.0f);
+  }
+}
+
+void MathBaseOperation::executeAreaRows(MemoryBuffer *output,
+                                        const rcti *area,
+                                        MathRowFunc math_row)
+{
+  MemoryBuffer *value1 = this->readInputArea(0, area);
+  MemoryBuffer *value2 = this->readInputArea(1, area);
+  const rcti *rect = output->getRect();
+  const int width = BLI_rcti_size_x(area);
+
+  for (int y = area->ymin, row = 0; y < area->ymax; y++, row++) {
+    float *dst = output->getBuffer() +
+                 (y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin;
+    math_row(dst, value1->getBuffer() + row * width, value2->getBuffer() + row * width, width);
+    if (this->m_useClamp) {
+      math_clamp_row(dst, width);
+    }
+  }
+
+  delete value1;
+  delete value2;
+}
+
 void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputValue1[4];
@@ -84,6 +125,26 @@ void MathAddOperation::executePixelSampled(float output[4], float x, float y, Pi
   clampIfNeeded(output);
 }
 
+static void math_add_row(float *output, const float *value1, const float *value2, int width)
+{
+  int i = 0;
+#ifdef __SSE2__
+  for (; i + 4 <= width; i += 4) {
+    const __m128 a = _mm_loadu_ps(&value1[i]);
+    const __m128 b = _mm_loadu_ps(&value2[i]);
+    _mm_storeu_ps(&output[i], _mm_add_ps(a, b));
+  }
+#endif
+  for (; i < width; i++) {
+    output[i] = value1[i] + value2[i];
+  }
+}
+
+void MathAddOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, math_add_row);
+}
+
 void MathSubtractOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -100,6 +161,26 @@ void MathSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void math_subtract_row(float *output, const float *value1, const float *value2, int width)
+{
+  int i = 0;
+#ifdef __SSE2__
+  for (; i + 4 <= width; i += 4) {
+    const __m128 a = _mm_loadu_ps(&value1[i]);
+    const __m128 b = _mm_loadu_ps(&value2[i]);
+    _mm_storeu_ps(&output[i], _mm_sub_ps(a, b));
+  }
+#endif
+  for (; i < width; i++) {
+    output[i] = value1[i] - value2[i];
+  }
+}
+
+void MathSubtractOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, math_subtract_row);
+}
+
 void MathMultiplyOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -116,6 +197,26 @@ void MathMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void math_multiply_row(float *output, const float *value1, const float *value2, int width)
+{
+  int i = 0;
+#ifdef __SSE2__
+  for (; i + 4 <= width; i += 4) {
+    const __m128 a = _mm_loadu_ps(&value1[i]);
+    const __m128 b = _mm_loadu_ps(&value2[i]);
+    _mm_storeu_ps(&output[i], _mm_mul_ps(a, b));
+  }
+#endif
+  for (; i < width; i++) {
+    output[i] = value1[i] * value2[i];
+  }
+}
+
+void MathMultiplyOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, math_multiply_row);
+}
+
 void MathDivideOperation::executePixelSampled(float output[4],
                                               float x,
                                               float y,
@@ -137,6 +238,28 @@ void MathDivideOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void math_divide_row(float *output, const float *value1, const float *value2, int width)
+{
+  int i = 0;
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= width; i += 4) {
+    const __m128 a = _mm_loadu_ps(&value1[i]);
+    const __m128 b = _mm_loadu_ps(&value2[i]);
+    /* We don't want to divide by zero, mask those results to zero. */
+    _mm_storeu_ps(&output[i], _mm_and_ps(_mm_cmpneq_ps(b, zero), _mm_div_ps(a, b)));
+  }
+#endif
+  for (; i < width; i++) {
+    output[i] = (value2[i] == 0) ? 0.0f : value1[i] / value2[i];
+  }
+}
+
+void MathDivideOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, math_divide_row);
+}
+
 void MathSineOperation::executePixelSampled(float output[4],
                                             float x,
                                             float y,
@@ -43,6 +43,17 @@ class MathBaseOperation : public NodeOperation {
 
   void clampIfNeeded(float color[4]);
 
+  /**
+   * Calculates a row of \a width values from the first two inputs.
+   */
+  typedef void (*MathRowFunc)(float *output, const float *value1, const float *value2, int width);
+
+  /**
+   * Implements #executeArea for operations with a row kernel: reads the first two inputs for
+   * \a area and calculates them a row at a time, clamping afterwards when needed.
+   */
+  void executeAreaRows(MemoryBuffer *output, const rcti *area, MathRowFunc math_row);
+
  public:
   /**
    * The inner loop of this operation.
@@ -76,6 +87,7 @@ class MathAddOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
@@ -83,6 +95,7 @@ class MathSubtractOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
@@ -90,6 +103,7 @@ class MathMultiplyOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
@@ -97,6 +111,7 @@ class MathDivideOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 class MathSineOperation : public MathBaseOperation {
  public:
@@ -20,6 +20,10 @@
 
 #include "BLI_math.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -63,6 +67,50 @@ void MixBaseOperation::executePixelSampled(float output[4], float x, float y, Pi
   output[3] = inputColor1[3];
 }
 
+static void mix_clamp_row(float *output, int width)
+{
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (int i = 0; i < width; i++, output += 4) {
+    _mm_storeu_ps(output, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(output), zero), one));
+  }
+#else
+  for (int i = 0; i < width; i++, output += 4) {
+    clamp_v4(output, 0.0f, 1.0f);
+  }
+#endif
+}
+
+void MixBaseOperation::executeAreaRows(MemoryBuffer *output,
+                                       const rcti *area,
+                                       BlendRowFunc blend_row)
+{
+  MemoryBuffer *value = this->readInputArea(0, area);
+  MemoryBuffer *color1 = this->readInputArea(1, area);
+  MemoryBuffer *color2 = this->readInputArea(2, area);
+  const rcti *rect = output->getRect();
+  const int width = BLI_rcti_size_x(area);
+
+  for (int y = area->ymin, row = 0; y < area->ymax; y++, row++) {
+    float *dst = output->getBuffer() +
+                 ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * 4;
+    blend_row(dst,
+              value->getBuffer() + row * width,
+              color1->getBuffer() + row * width * 4,
+              color2->getBuffer() + row * width * 4,
+              width,
+              this->m_valueAlphaMultiply);
+    if (this->m_useClamp) {
+      mix_clamp_row(dst, width);
+    }
+  }
+
+  delete value;
+  delete color1;
+  delete color2;
+}
+
 void MixBaseOperation::determineResolution(unsigned int resolution[2],
                                            unsigned int preferredResolution[2])
 {
@@ -124,6 +172,33 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
   clampIfNeeded(output);
 }
 
+static void mix_add_row(float *output,
+                        const float *value,
+                        const float *color1,
+                        const float *color2,
+                        int width,
+                        bool fac_alpha)
+{
+  for (int i = 0; i < width; i++, output += 4, color1 += 4, color2 += 4) {
+    const float fac = fac_alpha ? value[i] * color2[3] : value[i];
+#ifdef __SSE2__
+    const __m128 c1 = _mm_loadu_ps(color1);
+    const __m128 c2 = _mm_loadu_ps(color2);
+    _mm_storeu_ps(output, _mm_add_ps(c1, _mm_mul_ps(_mm_set1_ps(fac), c2)));
+#else
+    output[0] = color1[0] + fac * color2[0];
+    output[1] = color1[1] + fac * color2[1];
+    output[2] = color1[2] + fac * color2[2];
+#endif
+    output[3] = color1[3];
+  }
+}
+
+void MixAddOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, mix_add_row);
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation()
@@ -158,6 +233,35 @@ void MixBlendOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void mix_blend_row(float *output,
+                          const float *value,
+                          const float *color1,
+                          const float *color2,
+                          int width,
+                          bool fac_alpha)
+{
+  for (int i = 0; i < width; i++, output += 4, color1 += 4, color2 += 4) {
+    const float fac = fac_alpha ? value[i] * color2[3] : value[i];
+#ifdef __SSE2__
+    const __m128 c1 = _mm_loadu_ps(color1);
+    const __m128 c2 = _mm_loadu_ps(color2);
+    const __m128 facm = _mm_set1_ps(1.0f - fac);
+    _mm_storeu_ps(output, _mm_add_ps(_mm_mul_ps(facm, c1), _mm_mul_ps(_mm_set1_ps(fac), c2)));
+#else
+    const float facm = 1.0f - fac;
+    output[0] = facm * color1[0] + fac * color2[0];
+    output[1] = facm * color1[1] + fac * color2[1];
+    output[2] = facm * color1[2] + fac * color2[2];
+#endif
+    output[3] = color1[3];
+  }
+}
+
+void MixBlendOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, mix_blend_row);
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixColorBurnOperation::MixColorBurnOperation()
@@ -705,6 +809,35 @@ void MixMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void mix_multiply_row(float *output,
+                             const float *value,
+                             const float *color1,
+                             const float *color2,
+                             int width,
+                             bool fac_alpha)
+{
+  for (int i = 0; i < width; i++, output += 4, color1 += 4, color2 += 4) {
+    const float fac = fac_alpha ? value[i] * color2[3] : value[i];
+#ifdef __SSE2__
+    const __m128 c1 = _mm_loadu_ps(color1);
+    const __m128 c2 = _mm_loadu_ps(color2);
+    const __m128 facm = _mm_set1_ps(1.0f - fac);
+    _mm_storeu_ps(output, _mm_mul_ps(c1, _mm_add_ps(facm, _mm_mul_ps(_mm_set1_ps(fac), c2))));
+#else
+    const float facm = 1.0f - fac;
+    output[0] = color1[0] * (facm + fac * color2[0]);
+    output[1] = color1[1] * (facm + fac * color2[1]);
+    output[2] = color1[2] * (facm + fac * color2[2]);
+#endif
+    output[3] = color1[3];
+  }
+}
+
+void MixMultiplyOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, mix_multiply_row);
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation()
@@ -909,6 +1042,33 @@ void MixSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+static void mix_subtract_row(float *output,
+                             const float *value,
+                             const float *color1,
+                             const float *color2,
+                             int width,
+                             bool fac_alpha)
+{
+  for (int i = 0; i < width; i++, output += 4, color1 += 4, color2 += 4) {
+    const float fac = fac_alpha ? value[i] * color2[3] : value[i];
+#ifdef __SSE2__
+    const __m128 c1 = _mm_loadu_ps(color1);
+    const __m128 c2 = _mm_loadu_ps(color2);
+    _mm_storeu_ps(output, _mm_sub_ps(c1, _mm_mul_ps(_mm_set1_ps(fac), c2)));
+#else
+    output[0] = color1[0] - fac * color2[0];
+    output[1] = color1[1] - fac * color2[1];
+    output[2] = color1[2] - fac * color2[2];
+#endif
+    output[3] = color1[3];
+  }
+}
+
+void MixSubtractOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  executeAreaRows(output, area, mix_subtract_row);
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation()
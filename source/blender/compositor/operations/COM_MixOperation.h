@@ -43,6 +43,23 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Blends a row of \a width pixels, \a value has one channel and the colors four.
+   * \a fac_alpha tells whether the factor is multiplied by the alpha of \a color2.
+   */
+  typedef void (*BlendRowFunc)(float *output,
+                               const float *value,
+                               const float *color1,
+                               const float *color2,
+                               int width,
+                               bool fac_alpha);
+
+  /**
+   * Implements #executeArea for operations with a row kernel: reads the inputs for \a area
+   * and blends them a row at a time, clamping afterwards when needed.
+   */
+  void executeAreaRows(MemoryBuffer *output, const rcti *area, BlendRowFunc blend_row);
+
  public:
   /**
    * Default constructor
@@ -84,12 +101,14 @@ class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +175,7 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -186,6 +206,7 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 };
 
 class MixValueOperation : public MixBaseOperation {
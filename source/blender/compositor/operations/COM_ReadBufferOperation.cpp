@@ -107,6 +107,50 @@ void ReadBufferOperation::executePixelFiltered(
   }
 }
 
+void ReadBufferOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  const rcti *rect = output->getRect();
+  const int num_channels = output->get_num_channels();
+  const int width = BLI_rcti_size_x(area);
+  const size_t pixel_size = sizeof(float) * num_channels;
+  BLI_assert(num_channels == (int)m_buffer->get_num_channels());
+
+  if (m_single_value) {
+    /* write buffer has a single value stored at (0,0) */
+    float value[4];
+    m_buffer->read(value, 0, 0);
+    for (int y = area->ymin; y < area->ymax; y++) {
+      float *dst = output->getBuffer() +
+                   ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) *
+                       num_channels;
+      for (int x = 0; x < width; x++, dst += num_channels) {
+        memcpy(dst, value, pixel_size);
+      }
+    }
+    return;
+  }
+
+  /* Copy the rows overlapping the buffer, the area outside of it is clipped to zero like
+   * #MemoryBuffer::read does. */
+  const rcti *src_rect = m_buffer->getRect();
+  const int xmin = max_ii(area->xmin, src_rect->xmin);
+  const int xmax = min_ii(area->xmax, src_rect->xmax);
+  for (int y = area->ymin; y < area->ymax; y++) {
+    float *dst = output->getBuffer() +
+                 ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * num_channels;
+    if (y < src_rect->ymin || y >= src_rect->ymax || xmin >= xmax) {
+      memset(dst, 0, pixel_size * width);
+      continue;
+    }
+    const float *src = m_buffer->getBuffer() +
+                       ((y - src_rect->ymin) * m_buffer->getWidth() + xmin - src_rect->xmin) *
+                           num_channels;
+    memset(dst, 0, pixel_size * (xmin - area->xmin));
+    memcpy(dst + (xmin - area->xmin) * num_channels, src, pixel_size * (xmax - xmin));
+    memset(dst + (xmax - area->xmin) * num_channels, 0, pixel_size * (area->xmax - xmax));
+  }
+}
+
 bool ReadBufferOperation::determineDependingAreaOfInterest(rcti *input,
                                                            ReadBufferOperation *readOperation,
                                                            rcti *output)
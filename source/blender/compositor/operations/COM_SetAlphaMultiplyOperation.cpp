@@ -48,6 +48,27 @@ void SetAlphaMultiplyOperation::executePixelSampled(float output[4],
   mul_v4_v4fl(output, color_input, alpha_input[0]);
 }
 
+void SetAlphaMultiplyOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  MemoryBuffer *color_input = this->readInputArea(0, area);
+  MemoryBuffer *alpha_input = this->readInputArea(1, area);
+  const rcti *rect = output->getRect();
+  const int width = BLI_rcti_size_x(area);
+  const float *color = color_input->getBuffer();
+  const float *alpha = alpha_input->getBuffer();
+
+  for (int y = area->ymin; y < area->ymax; y++) {
+    float *dst = output->getBuffer() +
+                 ((y - rect->ymin) * output->getWidth() + area->xmin - rect->xmin) * 4;
+    for (int x = 0; x < width; x++, dst += 4, color += 4, alpha++) {
+      mul_v4_v4fl(dst, color, alpha[0]);
+    }
+  }
+
+  delete color_input;
+  delete alpha_input;
+}
+
 void SetAlphaMultiplyOperation::deinitExecution()
 {
   this->m_inputColor = nullptr;
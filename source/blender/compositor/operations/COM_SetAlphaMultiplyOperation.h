@@ -34,6 +34,7 @@ class SetAlphaMultiplyOperation : public NodeOperation {
   SetAlphaMultiplyOperation();
 
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeArea(MemoryBuffer *output, const rcti *area) override;
 
   void initExecution();
   void deinitExecution();
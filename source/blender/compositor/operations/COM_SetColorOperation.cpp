@@ -17,6 +17,7 @@
  */
 
 #include "COM_SetColorOperation.h"
+#include "COM_BufferCache.h"
 
 SetColorOperation::SetColorOperation()
 {
@@ -31,6 +32,16 @@ void SetColorOperation::executePixelSampled(float output[4],
   copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  output->fill(area, this->m_color);
+}
+
+void SetColorOperation::hashParameters(BufferCacheKey &key) const
+{
+  key.add(this->m_color);
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
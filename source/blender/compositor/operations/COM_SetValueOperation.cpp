@@ -17,6 +17,7 @@
  */
 
 #include "COM_SetValueOperation.h"
+#include "COM_BufferCache.h"
 
 SetValueOperation::SetValueOperation()
 {
@@ -31,6 +32,17 @@ void SetValueOperation::executePixelSampled(float output[4],
   output[0] = this->m_value;
 }
 
+void SetValueOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  const float value[4] = {this->m_value, this->m_value, this->m_value, this->m_value};
+  output->fill(area, value);
+}
+
+void SetValueOperation::hashParameters(BufferCacheKey &key) const
+{
+  key.add(this->m_value);
+}
+
 void SetValueOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
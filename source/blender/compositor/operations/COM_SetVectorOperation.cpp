@@ -17,6 +17,7 @@
  */
 
 #include "COM_SetVectorOperation.h"
+#include "COM_BufferCache.h"
 #include "COM_defines.h"
 
 SetVectorOperation::SetVectorOperation()
@@ -34,6 +35,19 @@ void SetVectorOperation::executePixelSampled(float output[4],
   output[2] = this->m_z;
 }
 
+void SetVectorOperation::executeArea(MemoryBuffer *output, const rcti *area)
+{
+  const float vector[4] = {this->m_x, this->m_y, this->m_z, 0.0f};
+  output->fill(area, vector);
+}
+
+void SetVectorOperation::hashParameters(BufferCacheKey &key) const
+{
+  key.add(this->m_x);
+  key.add(this->m_y);
+  key.add(this->m_z);
+}
+
 void SetVectorOperation::determineResolution(unsigned int resolution[2],
                                              unsigned int preferredResolution[2])
 {
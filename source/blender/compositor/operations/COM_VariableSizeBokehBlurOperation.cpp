@@ -138,6 +138,14 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
     const int addXStepColor = addXStepValue * COM_NUM_CHANNELS_COLOR;
 
     if (size_center > this->m_threshold) {
+      /* Neighbors only contribute within their own size, which is limited by the size of this
+       * pixel, so the search area can be shrunk to it while staying on the same sample grid. */
+      const int radius = min(maxBlurScalar, (int)ceilf(size_center));
+      minx += max(x - radius - minx, 0) / addXStepValue * addXStepValue;
+      miny += max(y - radius - miny, 0) / addYStepValue * addYStepValue;
+      maxx = min(maxx, x + radius + 1);
+      maxy = min(maxy, y + radius + 1);
+
       for (int ny = miny; ny < maxy; ny += addYStepValue) {
         float dy = ny - y;
         int offsetValueNy = ny * inputSizeBuffer->getWidth();
@@ -43,6 +43,7 @@ ViewerOperation::ViewerOperation()
   this->m_viewSettings = nullptr;
   this->m_displaySettings = nullptr;
   this->m_useAlphaInput = false;
+  this->m_resolutionDivider = 1;
 
   this->addInputSocket(COM_DT_COLOR);
   this->addInputSocket(COM_DT_VALUE);
@@ -96,6 +97,38 @@ void ViewerOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/)
   int y;
   bool breaked = false;
 
+  if (this->m_resolutionDivider > 1) {
+    /* Calculate one pixel per block and fill the block with it. */
+    const int step = this->m_resolutionDivider;
+    const int width = this->getWidth();
+    float color[4];
+    for (y = y1; y < y2 && (!breaked); y += step) {
+      const int block_y2 = min_ii(y + step, y2);
+      for (x = x1; x < x2; x += step) {
+        const int block_x2 = min_ii(x + step, x2);
+        this->m_imageInput->readSampled(color, x, y, COM_PS_NEAREST);
+        if (this->m_useAlphaInput) {
+          this->m_alphaInput->readSampled(alpha, x, y, COM_PS_NEAREST);
+          color[3] = alpha[0];
+        }
+        this->m_depthInput->readSampled(depth, x, y, COM_PS_NEAREST);
+
+        for (int block_y = y; block_y < block_y2; block_y++) {
+          for (int block_x = x; block_x < block_x2; block_x++) {
+            offset = block_y * width + block_x;
+            copy_v4_v4(&buffer[offset * 4], color);
+            depthbuffer[offset] = depth[0];
+          }
+        }
+      }
+      if (isBraked()) {
+        breaked = true;
+      }
+    }
+    updateImage(rect);
+    return;
+  }
+
   for (y = y1; y < y2 && (!breaked); y++) {
     for (x = x1; x < x2; x++) {
       this->m_imageInput->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
@@ -33,6 +33,7 @@ class ViewerOperation : public NodeOperation {
   float m_centerX;
   float m_centerY;
   OrderOfChunks m_chunkOrder;
+  int m_resolutionDivider;
   bool m_doDepthBuffer;
   ImBuf *m_ibuf;
   bool m_useAlphaInput;
@@ -86,6 +87,13 @@ class ViewerOperation : public NodeOperation {
   {
     this->m_chunkOrder = tileOrder;
   }
+  /**
+   * \brief only calculate every n-th pixel in both directions and fill the pixels in between.
+   */
+  void setResolutionDivider(int resolutionDivider)
+  {
+    this->m_resolutionDivider = resolutionDivider;
+  }
   float getCenterX() const
   {
     return this->m_centerX;
@@ -86,22 +86,16 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
     }
   }
   else {
-    int x1 = rect->xmin;
-    int y1 = rect->ymin;
-    int x2 = rect->xmax;
-    int y2 = rect->ymax;
-
-    int x;
-    int y;
-    bool breaked = false;
-    for (y = y1; y < y2 && (!breaked); y++) {
-      int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
-      }
+    /* Evaluate the chunk in bands of rows, so cancelling stops before the whole chunk is done.
+     * Bands are large enough for operations that read their inputs as areas to stay efficient. */
+    const int band_rows = 16;
+    rcti band = *rect;
+    for (int y = rect->ymin; y < rect->ymax; y += band_rows) {
+      band.ymin = y;
+      band.ymax = MIN2(y + band_rows, rect->ymax);
+      this->m_input->executeArea(memoryBuffer, &band);
       if (isBraked()) {
-        breaked = true;
+        break;
       }
     }
   }
@@ -161,6 +161,29 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float ctime);
 /* Data changed recalculation entry point. */
 void DEG_evaluate_on_refresh(Depsgraph *graph);
 
+/* Playback Prefetch  ---------------------------- */
+
+/* Evaluate frames following the given one in the background while animation is playing, so
+ * evaluation of those frames can use the prefetched meshes instead of evaluating modifiers.
+ * To be called from the main thread on every frame step of the playback. */
+void DEG_playback_prefetch_update(Depsgraph *graph, int frame, int step);
+/* Stop prefetching and free all prefetched data, needed when playback stops or when the
+ * original data-blocks are about to be changed or freed. */
+void DEG_playback_prefetch_stop(Depsgraph *graph);
+void DEG_playback_prefetch_stop_all(struct Main *bmain);
+
+struct CustomData_MeshMasks;
+struct Mesh;
+struct Object;
+
+/* Take ownership of the meshes prefetched for the object at the current frame of the graph.
+ * The result of the deform modifiers is stored in r_mesh_deform, it can be NULL. */
+struct Mesh *DEG_playback_prefetch_mesh_pop(const Depsgraph *graph,
+                                            const struct Object *object,
+                                            const struct CustomData_MeshMasks *data_mask,
+                                            bool need_mapping,
+                                            struct Mesh **r_mesh_deform);
+
 /* Editors Integration  -------------------------- */
 
 /* Mechanism to allow editors to be informed of depsgraph updates,
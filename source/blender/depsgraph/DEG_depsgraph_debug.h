@@ -62,6 +62,22 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Profiling */
+
+/* Gather timing of every operation for the last few evaluations of the graph.
+ * Disabling the profiling frees the gathered samples. */
+void DEG_debug_profile_enable(struct Depsgraph *depsgraph, bool enable);
+bool DEG_debug_profile_is_enabled(const struct Depsgraph *depsgraph);
+
+/* Write the gathered samples in the Chrome trace event format (`chrome://tracing`). */
+void DEG_debug_profile_chrome_trace(const struct Depsgraph *depsgraph, FILE *fp);
+
+/* Human readable list of the slowest operations, as much as fits into the result. */
+void DEG_debug_profile_summary(const struct Depsgraph *depsgraph,
+                               char *result,
+                               size_t result_maxncpy);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -0,0 +1,269 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_profile.h"
+
+#include <algorithm>
+
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "atomic_ops.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+
+DepsgraphProfile::DepsgraphProfile()
+    : is_enabled_(false),
+      num_evaluations_(0),
+      next_evaluation_index_(0),
+      current_evaluation_(nullptr)
+{
+}
+
+void DepsgraphProfile::set_enabled(bool enabled)
+{
+  is_enabled_ = enabled;
+  if (!enabled) {
+    clear();
+  }
+}
+
+void DepsgraphProfile::begin_evaluation(int num_operations)
+{
+  BLI_assert(current_evaluation_ == nullptr);
+  Evaluation &evaluation = evaluations_[next_evaluation_index_];
+  /* Storage of the evaluation which is overwritten is re-used. */
+  evaluation.samples.resize(num_operations);
+  evaluation.num_samples = 0;
+  evaluation.start_time = PIL_check_seconds_timer();
+  evaluation.duration = 0.0;
+  current_evaluation_ = &evaluation;
+}
+
+void DepsgraphProfile::end_evaluation()
+{
+  BLI_assert(current_evaluation_ != nullptr);
+  current_evaluation_->duration = PIL_check_seconds_timer() - current_evaluation_->start_time;
+  current_evaluation_ = nullptr;
+
+  ++next_evaluation_index_;
+  if (next_evaluation_index_ == MAX_EVALUATIONS) {
+    next_evaluation_index_ = 0;
+  }
+  if (num_evaluations_ != MAX_EVALUATIONS) {
+    ++num_evaluations_;
+  }
+}
+
+void DepsgraphProfile::add_sample(const OperationNode *operation,
+                                  double start_time,
+                                  double duration)
+{
+  Evaluation *evaluation = current_evaluation_;
+  BLI_assert(evaluation != nullptr);
+  const uint32_t index = atomic_fetch_and_add_uint32(&evaluation->num_samples, 1);
+  if (index >= evaluation->samples.size()) {
+    /* Should not happen since every operation is evaluated once, but be safe. */
+    atomic_sub_and_fetch_uint32(&evaluation->num_samples, 1);
+    return;
+  }
+  Sample &sample = evaluation->samples[index];
+  sample.operation = operation;
+  sample.thread = thread_index();
+  sample.start_time = start_time - evaluation->start_time;
+  sample.duration = duration;
+}
+
+void DepsgraphProfile::clear()
+{
+  BLI_assert(current_evaluation_ == nullptr);
+  for (Evaluation &evaluation : evaluations_) {
+    evaluation.samples.clear_and_make_inline();
+    evaluation.num_samples = 0;
+  }
+  num_evaluations_ = 0;
+  next_evaluation_index_ = 0;
+}
+
+const DepsgraphProfile::Evaluation &DepsgraphProfile::evaluation(int index) const
+{
+  BLI_assert(index >= 0 && index < num_evaluations_);
+  const int first_index = (num_evaluations_ == MAX_EVALUATIONS) ? next_evaluation_index_ : 0;
+  return evaluations_[(first_index + index) % MAX_EVALUATIONS];
+}
+
+int DepsgraphProfile::thread_index()
+{
+  static uint32_t num_threads = 0;
+  static thread_local int index = int(atomic_fetch_and_add_uint32(&num_threads, 1));
+  return index;
+}
+
+namespace {
+
+string json_escape(const string &str)
+{
+  string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      char buffer[8];
+      BLI_snprintf(buffer, sizeof(buffer), "\\u%04x", (int)c);
+      result += buffer;
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+struct OperationProfileEntry {
+  const OperationNode *operation;
+  double total_time;
+  double max_time;
+  int num_samples;
+};
+
+}  // namespace
+
+}  // namespace blender::deg
+
+void DEG_debug_profile_enable(Depsgraph *depsgraph, bool enable)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  deg_graph->debug.profile.set_enabled(enable);
+}
+
+bool DEG_debug_profile_is_enabled(const Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  return deg_graph->debug.profile.is_enabled();
+}
+
+void DEG_debug_profile_chrome_trace(const Depsgraph *depsgraph, FILE *fp)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  const deg::DepsgraphProfile &profile = deg_graph->debug.profile;
+
+  fprintf(fp, "{\"traceEvents\":[\n");
+  bool is_first = true;
+  if (profile.num_evaluations() != 0) {
+    const double trace_start_time = profile.evaluation(0).start_time;
+    for (int i = 0; i < profile.num_evaluations(); i++) {
+      const deg::DepsgraphProfile::Evaluation &evaluation = profile.evaluation(i);
+      const double evaluation_time = evaluation.start_time - trace_start_time;
+      /* Whole evaluation goes to its own track, operations to a track per thread. */
+      fprintf(fp,
+              "%s{\"name\":\"Evaluation %d\",\"cat\":\"depsgraph\",\"ph\":\"X\","
+              "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}",
+              is_first ? "" : ",\n",
+              i,
+              evaluation_time * 1e6,
+              evaluation.duration * 1e6);
+      is_first = false;
+      for (uint32_t j = 0; j < evaluation.num_samples; j++) {
+        const deg::DepsgraphProfile::Sample &sample = evaluation.samples[j];
+        const deg::OperationNode *operation = sample.operation;
+        fprintf(fp,
+                ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                deg::json_escape(operation->full_identifier()).c_str(),
+                deg::json_escape(operation->owner->owner->name).c_str(),
+                (evaluation_time + sample.start_time) * 1e6,
+                sample.duration * 1e6,
+                sample.thread + 1);
+      }
+    }
+  }
+  fprintf(fp, "\n]}\n");
+}
+
+void DEG_debug_profile_summary(const Depsgraph *depsgraph, char *result, size_t result_maxncpy)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  const deg::DepsgraphProfile &profile = deg_graph->debug.profile;
+  const int num_evaluations = profile.num_evaluations();
+
+  blender::Map<const deg::OperationNode *, deg::OperationProfileEntry> entries;
+  double total_time = 0.0;
+  for (int i = 0; i < num_evaluations; i++) {
+    const deg::DepsgraphProfile::Evaluation &evaluation = profile.evaluation(i);
+    total_time += evaluation.duration;
+    for (uint32_t j = 0; j < evaluation.num_samples; j++) {
+      const deg::DepsgraphProfile::Sample &sample = evaluation.samples[j];
+      deg::OperationProfileEntry &entry = entries.lookup_or_add(
+          sample.operation, {sample.operation, 0.0, 0.0, 0});
+      entry.total_time += sample.duration;
+      entry.max_time = std::max(entry.max_time, sample.duration);
+      entry.num_samples++;
+    }
+  }
+
+  blender::Vector<deg::OperationProfileEntry> sorted_entries;
+  for (const deg::OperationProfileEntry &entry : entries.values()) {
+    sorted_entries.append(entry);
+  }
+  std::sort(sorted_entries.begin(),
+            sorted_entries.end(),
+            [](const deg::OperationProfileEntry &a, const deg::OperationProfileEntry &b) {
+              return a.total_time > b.total_time;
+            });
+
+  size_t offset = BLI_snprintf_rlen(result,
+                                    result_maxncpy,
+                                    "%d evaluations, %.3f ms on average\n",
+                                    num_evaluations,
+                                    num_evaluations ? total_time * 1e3 / num_evaluations : 0.0);
+  /* Slowest operations first, as many as fits. */
+  for (const deg::OperationProfileEntry &entry : sorted_entries) {
+    char line[512];
+    const size_t line_len = BLI_snprintf_rlen(line,
+                                              sizeof(line),
+                                              "%.3f ms average, %.3f ms max, %d times: %s\n",
+                                              entry.total_time * 1e3 / entry.num_samples,
+                                              entry.max_time * 1e3,
+                                              entry.num_samples,
+                                              entry.operation->full_identifier().c_str());
+    if (offset + line_len >= result_maxncpy) {
+      break;
+    }
+    memcpy(result + offset, line, line_len + 1);
+    offset += line_len;
+  }
+}
@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include <cstdio>
+
+#include "intern/depsgraph_type.h"
+
+namespace blender {
+namespace deg {
+
+struct OperationNode;
+
+/* Per-operation timing of the last few evaluations of a dependency graph.
+ *
+ * Gathering is cheap enough to be enabled at run-time in release builds: samples are stored into
+ * storage which is allocated before the evaluation starts, so adding a sample is a single atomic
+ * increment. */
+class DepsgraphProfile {
+ public:
+  struct Sample {
+    const OperationNode *operation;
+    /* Index of the thread which evaluated the operation, see #thread_index(). */
+    int thread;
+    /* Time relative to the start of the evaluation, in seconds. */
+    double start_time;
+    double duration;
+  };
+
+  struct Evaluation {
+    /* Absolute start time and duration of the whole evaluation, in seconds. */
+    double start_time;
+    double duration;
+    Vector<Sample> samples;
+    uint32_t num_samples;
+  };
+
+  /* Number of the most recent evaluations which are kept. */
+  static const constexpr int MAX_EVALUATIONS = 16;
+
+  DepsgraphProfile();
+
+  bool is_enabled() const
+  {
+    return is_enabled_;
+  }
+  void set_enabled(bool enabled);
+
+  /* Prepare storage for an evaluation of at most num_operations operations. */
+  void begin_evaluation(int num_operations);
+  void end_evaluation();
+
+  /* Thread-safe, called for every evaluated operation between begin_evaluation() and
+   * end_evaluation(). */
+  void add_sample(const OperationNode *operation, double start_time, double duration);
+
+  /* Remove all samples, needed when operation nodes of the graph are freed. */
+  void clear();
+
+  int num_evaluations() const
+  {
+    return num_evaluations_;
+  }
+  /* Evaluations from the oldest to the most recent one. */
+  const Evaluation &evaluation(int index) const;
+
+  /* Small index of the calling thread, stable for the lifetime of the thread. */
+  static int thread_index();
+
+ protected:
+  bool is_enabled_;
+  Evaluation evaluations_[MAX_EVALUATIONS];
+  int num_evaluations_;
+  int next_evaluation_index_;
+  Evaluation *current_evaluation_;
+};
+
+}  // namespace deg
+}  // namespace blender
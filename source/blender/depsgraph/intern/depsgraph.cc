@@ -47,6 +47,7 @@
 #include "intern/depsgraph_update.h"
 
 #include "intern/eval/deg_eval_copy_on_write.h"
+#include "intern/eval/deg_eval_playback_prefetch.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -62,6 +63,7 @@ namespace blender::deg {
 Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluationMode mode)
     : time_source(nullptr),
       need_update(true),
+      is_time_dependent_update(false),
       bmain(bmain),
       scene(scene),
       view_layer(view_layer),
@@ -69,6 +71,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       ctime(BKE_scene_frame_get(scene)),
       scene_cow(nullptr),
       is_active(false),
+      playback_prefetch(nullptr),
       is_evaluating(false),
       is_render_pipeline_depsgraph(false)
 {
@@ -82,6 +85,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
 
 Depsgraph::~Depsgraph()
 {
+  delete playback_prefetch;
   clear_id_nodes();
   delete time_source;
   BLI_spin_end(&lock);
@@ -240,7 +244,16 @@ void Depsgraph::add_entry_tag(OperationNode *node)
 
 void Depsgraph::clear_all_nodes()
 {
+  /* Prefetched results no longer match the relations which are being rebuilt. */
+  if (playback_prefetch != nullptr) {
+    playback_prefetch->stop();
+  }
   clear_id_nodes();
+  time_dependent_operations.clear();
+  time_dependent_components.clear();
+  time_dependent_id_nodes.clear();
+  /* Samples point to the operations which are freed. */
+  debug.profile.clear();
   delete time_source;
   time_source = nullptr;
 }
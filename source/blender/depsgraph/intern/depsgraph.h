@@ -52,9 +52,11 @@ struct ViewLayer;
 namespace blender {
 namespace deg {
 
+struct ComponentNode;
 struct IDNode;
 struct Node;
 struct OperationNode;
+class PlaybackPrefetch;
 struct Relation;
 struct TimeSourceNode;
 
@@ -121,6 +123,18 @@ struct Depsgraph {
   /* Nodes which have been tagged as "directly modified". */
   Set<OperationNode *> entry_tags;
 
+  /* Part of the graph which is tagged for update by flushing from the time source only, built
+   * together with relations. Frame changes which are not accompanied by any other tag use it
+   * directly instead of flushing updates over the whole graph.
+   * See deg_graph_build_time_dependent_subgraph(). */
+  Vector<OperationNode *> time_dependent_operations;
+  Vector<ComponentNode *> time_dependent_components;
+  Vector<IDNode *> time_dependent_id_nodes;
+
+  /* Set when the current update only involves time_dependent_operations, so evaluation does not
+   * need to visit other operations. Cleared together with the tags. */
+  bool is_time_dependent_update;
+
   /* Convenience Data ................... */
 
   /* XXX: should be collected after building (if actually needed?) */
@@ -155,6 +169,9 @@ struct Depsgraph {
 
   DepsgraphDebug debug;
 
+  /* Evaluation of upcoming frames during playback, created on demand. */
+  PlaybackPrefetch *playback_prefetch;
+
   bool is_evaluating;
 
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
@@ -25,11 +25,14 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -68,9 +71,27 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
+/* Context of scheduling children of an operation evaluated by a task: the most critical of the
+ * operations which became ready is kept and evaluated by the same task right away, all other ones
+ * are pushed to the pool. This way the longest chains of operations never wait in the pool behind
+ * less important work. */
+struct TaskScheduleContext {
+  TaskPool *pool;
+  OperationNode *next_node;
+};
+
+void schedule_node_to_task(OperationNode *node,
+                           const int UNUSED(thread_id),
+                           TaskScheduleContext *context)
 {
-  BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  if (context->next_node == nullptr) {
+    context->next_node = node;
+    return;
+  }
+  if (node->critical_path_time > context->next_node->critical_path_time) {
+    std::swap(node, context->next_node);
+  }
+  BLI_task_pool_push(context->pool, deg_task_run_func, node, false, nullptr);
 }
 
 /* Denotes which part of dependency graph is being evaluated. */
@@ -92,7 +113,11 @@ enum class EvaluationStage {
 
 struct DepsgraphEvalState {
   Depsgraph *graph;
+  /* Operations which might need evaluation: either all of them, or only the time dependent ones
+   * on frame change. */
+  Span<OperationNode *> operations;
   bool do_stats;
+  bool do_profile;
   EvaluationStage stage;
   bool need_single_thread_pass;
 };
@@ -103,14 +128,24 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. The time is always measured, it is used to prioritize the operation in the
+   * following evaluations. */
+  const bool do_trace = BLI_trace_is_enabled();
+  if (do_trace) {
+    BLI_trace_zone_begin(operation_node->full_identifier().c_str());
+  }
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double eval_time = PIL_check_seconds_timer() - start_time;
+  if (do_trace) {
+    BLI_trace_zone_end();
+  }
+  operation_node->eval_time = eval_time;
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += eval_time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (state->do_profile) {
+    state->graph->debug.profile.add_sample(operation_node, start_time, eval_time);
   }
 }
 
@@ -119,12 +154,16 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children, continue with the most critical one. */
+    TaskScheduleContext context = {pool, nullptr};
+    schedule_children(state, operation_node, schedule_node_to_task, &context);
+    operation_node = context.next_node;
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -170,20 +209,77 @@ void calculate_pending_parents_for_node(OperationNode *node)
   }
 }
 
-void calculate_pending_parents(Depsgraph *graph)
+void calculate_pending_parents(Span<OperationNode *> operations)
 {
-  for (OperationNode *node : graph->operations) {
+  for (OperationNode *node : operations) {
     calculate_pending_parents_for_node(node);
   }
 }
 
-void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
+/* Cost which is added to the measured time of every operation, so that the number of operations in
+ * a chain is taken into account when there are no timings yet (or they are all tiny). */
+const double operation_schedule_cost = 1e-6;
+
+bool is_operation_to_be_evaluated(OperationNode *node)
+{
+  return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && check_operation_node_visible(node);
+}
+
+/* Estimate the time of the longest chain of operations starting at every operation which is to be
+ * evaluated, based on the timing of the previous evaluations.
+ *
+ * Operations are visited in reverse topological order, with custom_flags counting the children
+ * which are not visited yet. Cyclic relations are ignored, same as for scheduling. */
+void calculate_critical_path(Span<OperationNode *> operations)
+{
+  Vector<OperationNode *> stack;
+  for (OperationNode *node : operations) {
+    node->critical_path_time = node->eval_time + operation_schedule_cost;
+    node->custom_flags = 0;
+    if (!is_operation_to_be_evaluated(node)) {
+      continue;
+    }
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && is_operation_to_be_evaluated(child)) {
+        ++node->custom_flags;
+      }
+    }
+    if (node->custom_flags == 0) {
+      stack.append(node);
+    }
+  }
+  while (!stack.is_empty()) {
+    OperationNode *node = stack.pop_last();
+    double children_time = 0.0;
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && is_operation_to_be_evaluated(child)) {
+        children_time = max(children_time, child->critical_path_time);
+      }
+    }
+    node->critical_path_time += children_time;
+    for (Relation *rel : node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
+      OperationNode *parent = (OperationNode *)rel->from;
+      if (is_operation_to_be_evaluated(parent) && --parent->custom_flags == 0) {
+        stack.append(parent);
+      }
+    }
+  }
+}
+
+void initialize_execution(DepsgraphEvalState *state)
 {
   const bool do_stats = state->do_stats;
-  calculate_pending_parents(graph);
-  /* Clear tags and other things which needs to be clear. */
-  for (OperationNode *node : graph->operations) {
-    if (do_stats) {
+  calculate_pending_parents(state->operations);
+  calculate_critical_path(state->operations);
+  /* Clear tags and other things which needs to be clear. Statistics are only aggregated from the
+   * operations of this evaluation, see #deg_eval_stats_aggregate. */
+  if (do_stats) {
+    for (OperationNode *node : state->operations) {
       node->stats.reset_current();
     }
   }
@@ -280,7 +376,7 @@ void schedule_graph(DepsgraphEvalState *state,
                     ScheduleFunction *schedule_function,
                     ScheduleFunctionArgs... schedule_function_args)
 {
-  for (OperationNode *node : state->graph->operations) {
+  for (OperationNode *node : state->operations) {
     schedule_node(state, node, false, schedule_function, schedule_function_args...);
   }
 }
@@ -306,6 +402,27 @@ void schedule_children(DepsgraphEvalState *state,
   }
 }
 
+void schedule_node_to_vector(OperationNode *node,
+                             const int /*thread_id*/,
+                             Vector<OperationNode *> *nodes)
+{
+  nodes->append(node);
+}
+
+/* Schedule all operations which are ready for evaluation, the ones at the beginning of the longest
+ * chains first. */
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  Vector<OperationNode *> nodes;
+  schedule_graph(state, schedule_node_to_vector, &nodes);
+  std::sort(nodes.begin(), nodes.end(), [](const OperationNode *a, const OperationNode *b) {
+    return a->critical_path_time > b->critical_path_time;
+  });
+  for (OperationNode *node : nodes) {
+    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  }
+}
+
 void schedule_node_to_queue(OperationNode *node,
                             const int /*thread_id*/,
                             GSQueue *evaluation_queue)
@@ -371,29 +488,37 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
 
   graph->debug.begin_graph_evaluation();
+  BLI_trace_zone_begin("Depsgraph Evaluation");
 
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
+  state.operations = graph->is_time_dependent_update ?
+                         graph->time_dependent_operations.as_span() :
+                         graph->operations.as_span();
   state.do_stats = graph->debug.do_time_debug();
+  state.do_profile = graph->debug.profile.is_enabled();
   state.need_single_thread_pass = false;
   /* Prepare all nodes for evaluation. */
-  initialize_execution(&state, graph);
+  initialize_execution(&state);
+  if (state.do_profile) {
+    graph->debug.profile.begin_evaluation(graph->operations.size());
+  }
 
   /* Do actual evaluation now. */
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
@@ -408,10 +533,18 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.do_profile) {
+    graph->debug.profile.end_evaluation();
+  }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
 
+  BLI_trace_zone_end();
+  /* Summing the memory in use is not free, so only do it when the counter is recorded. */
+  if (BLI_trace_is_enabled()) {
+    BLI_trace_counter("Memory In Use", (int64_t)MEM_get_memory_in_use());
+  }
   graph->debug.end_graph_evaluation();
 }
 
@@ -49,6 +49,7 @@
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_type.h"
 #include "intern/depsgraph_update.h"
+#include "intern/eval/deg_eval_playback_prefetch.h"
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_factory.h"
@@ -217,69 +218,117 @@ void flush_engine_data_update(ID *id)
 }
 
 /* NOTE: It will also accumulate flags from changed components. */
+void flush_editors_id_node_update(Depsgraph *graph,
+                                  const DEGEditorUpdateContext *update_ctx,
+                                  IDNode *id_node)
+{
+  DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id_node->id_orig->name));
+  /* TODO(sergey): Do we need to pass original or evaluated ID here? */
+  ID *id_orig = id_node->id_orig;
+  ID *id_cow = id_node->id_cow;
+  /* Gather recalc flags from all changed components. */
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    if (comp_node->custom_flags != COMPONENT_STATE_DONE) {
+      continue;
+    }
+    DepsNodeFactory *factory = type_get_factory(comp_node->type);
+    BLI_assert(factory != nullptr);
+    id_cow->recalc |= factory->id_recalc_tag();
+  }
+  DEG_DEBUG_PRINTF((::Depsgraph *)graph,
+                   EVAL,
+                   "Accumulated recalc bits for %s: %u\n",
+                   id_orig->name,
+                   (unsigned int)id_cow->recalc);
+
+  /* Inform editors. Only if the data-block is being evaluated a second
+   * time, to distinguish between user edits and initial evaluation when
+   * the data-block becomes visible.
+   *
+   * TODO: image data-blocks do not use COW, so might not be detected
+   * correctly. */
+  if (deg_copy_on_write_is_expanded(id_cow)) {
+    if (graph->is_active && id_node->is_user_modified) {
+      deg_editors_id_update(update_ctx, id_orig);
+
+      /* We only want to tag an ID for lib-override auto-refresh if it was actually tagged as
+       * changed. CoW IDs indirectly modified because of changes in other IDs should never
+       * require a lib-override diffing. */
+      if (ID_IS_OVERRIDE_LIBRARY_REAL(id_orig)) {
+        id_orig->tag |= LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
+      }
+      else if (ID_IS_OVERRIDE_LIBRARY_VIRTUAL(id_orig)) {
+        switch (GS(id_orig->name)) {
+          case ID_KE:
+            ((Key *)id_orig)->from->tag |= LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
+            break;
+          case ID_GR:
+            BLI_assert(id_orig->flag & LIB_EMBEDDED_DATA);
+            /* TODO. */
+            break;
+          case ID_NT:
+            BLI_assert(id_orig->flag & LIB_EMBEDDED_DATA);
+            /* TODO. */
+            break;
+          default:
+            BLI_assert(0);
+        }
+      }
+    }
+    /* Inform draw engines that something was changed. */
+    flush_engine_data_update(id_cow);
+  }
+}
+
 void flush_editors_id_update(Depsgraph *graph, const DEGEditorUpdateContext *update_ctx)
 {
   for (IDNode *id_node : graph->id_nodes) {
     if (id_node->custom_flags != ID_STATE_MODIFIED) {
       continue;
     }
-    DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id_node->id_orig->name));
-    /* TODO(sergey): Do we need to pass original or evaluated ID here? */
-    ID *id_orig = id_node->id_orig;
-    ID *id_cow = id_node->id_cow;
-    /* Gather recalc flags from all changed components. */
+    flush_editors_id_node_update(graph, update_ctx, id_node);
+  }
+}
+
+/* Apply result of flushing from the time source, which is known in advance, without traversing
+ * the graph. Only ID and component nodes of the time dependent subgraph get their state updated,
+ * so only those are to be looked at afterwards. */
+void flush_time_dependent_updates(Depsgraph *graph, const DEGEditorUpdateContext *update_ctx)
+{
+  for (IDNode *id_node : graph->time_dependent_id_nodes) {
+    id_node->custom_flags = ID_STATE_MODIFIED;
     for (ComponentNode *comp_node : id_node->components.values()) {
-      if (comp_node->custom_flags != COMPONENT_STATE_DONE) {
-        continue;
-      }
-      DepsNodeFactory *factory = type_get_factory(comp_node->type);
-      BLI_assert(factory != nullptr);
-      id_cow->recalc |= factory->id_recalc_tag();
+      comp_node->custom_flags = COMPONENT_STATE_NONE;
     }
-    DEG_DEBUG_PRINTF((::Depsgraph *)graph,
-                     EVAL,
-                     "Accumulated recalc bits for %s: %u\n",
-                     id_orig->name,
-                     (unsigned int)id_cow->recalc);
-
-    /* Inform editors. Only if the data-block is being evaluated a second
-     * time, to distinguish between user edits and initial evaluation when
-     * the data-block becomes visible.
-     *
-     * TODO: image data-blocks do not use COW, so might not be detected
-     * correctly. */
-    if (deg_copy_on_write_is_expanded(id_cow)) {
-      if (graph->is_active && id_node->is_user_modified) {
-        deg_editors_id_update(update_ctx, id_orig);
-
-        /* We only want to tag an ID for lib-override auto-refresh if it was actually tagged as
-         * changed. CoW IDs indirectly modified because of changes in other IDs should never
-         * require a lib-override diffing. */
-        if (ID_IS_OVERRIDE_LIBRARY_REAL(id_orig)) {
-          id_orig->tag |= LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
-        }
-        else if (ID_IS_OVERRIDE_LIBRARY_VIRTUAL(id_orig)) {
-          switch (GS(id_orig->name)) {
-            case ID_KE:
-              ((Key *)id_orig)->from->tag |= LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
-              break;
-            case ID_GR:
-              BLI_assert(id_orig->flag & LIB_EMBEDDED_DATA);
-              /* TODO. */
-              break;
-            case ID_NT:
-              BLI_assert(id_orig->flag & LIB_EMBEDDED_DATA);
-              /* TODO. */
-              break;
-            default:
-              BLI_assert(0);
-          }
-        }
-      }
-      /* Inform draw engines that something was changed. */
-      flush_engine_data_update(id_cow);
+  }
+  for (ComponentNode *comp_node : graph->time_dependent_components) {
+    comp_node->custom_flags = COMPONENT_STATE_DONE;
+  }
+  for (OperationNode *op_node : graph->time_dependent_operations) {
+    op_node->flag |= DEPSOP_FLAG_NEEDS_UPDATE;
+  }
+  for (IDNode *id_node : graph->time_dependent_id_nodes) {
+    flush_editors_id_node_update(graph, update_ctx, id_node);
+  }
+  graph->is_time_dependent_update = true;
+}
+
+/* Add operations which get tagged when the time source tags the given node. */
+void time_source_tagged_operations(Node *node, Vector<OperationNode *> *r_operations)
+{
+  if (node->type == NodeType::OPERATION) {
+    r_operations->append((OperationNode *)node);
+  }
+  else if (node->type == NodeType::ID_REF) {
+    IDNode *id_node = (IDNode *)node;
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      time_source_tagged_operations(comp_node, r_operations);
     }
   }
+  else {
+    ComponentNode *comp_node = (ComponentNode *)node;
+    r_operations->extend(comp_node->operations);
+  }
 }
 
 #ifdef INVALIDATE_ON_FLUSH
@@ -346,6 +395,72 @@ void invalidate_tagged_evaluated_data(Depsgraph *graph)
 
 }  // namespace
 
+/* Gather nodes which get tagged when flushing from the time source only. This mirrors what
+ * deg_graph_flush_updates() does, without modifying any tags of the graph. */
+void deg_graph_build_time_dependent_subgraph(Depsgraph *graph)
+{
+  graph->time_dependent_operations.clear();
+  graph->time_dependent_components.clear();
+  graph->time_dependent_id_nodes.clear();
+  if (graph->time_source == nullptr) {
+    return;
+  }
+
+  Vector<OperationNode *> entry_operations;
+  for (Relation *rel : graph->time_source->outlinks) {
+    time_source_tagged_operations(rel->to, &entry_operations);
+  }
+
+  VectorSet<OperationNode *> tagged_operations;
+  VectorSet<ComponentNode *> tagged_components;
+  VectorSet<IDNode *> tagged_id_nodes;
+  Set<OperationNode *> scheduled_operations;
+  FlushQueue queue;
+  for (OperationNode *op_node : entry_operations) {
+    if (scheduled_operations.add(op_node)) {
+      queue.push_back(op_node);
+    }
+  }
+  while (!queue.empty()) {
+    OperationNode *op_node = queue.front();
+    queue.pop_front();
+    tagged_operations.add(op_node);
+    ComponentNode *comp_node = op_node->owner;
+    IDNode *id_node = comp_node->owner;
+    tagged_id_nodes.add(id_node);
+    if (tagged_components.add(comp_node)) {
+      if (!ELEM(comp_node->type, NodeType::PARTICLE_SETTINGS, NodeType::PARTICLE_SYSTEM)) {
+        for (OperationNode *op : comp_node->operations) {
+          tagged_operations.add(op);
+        }
+      }
+      if (comp_node->type == NodeType::BONE) {
+        ComponentNode *pose_comp = id_node->find_component(NodeType::EVAL_POSE);
+        BLI_assert(pose_comp != nullptr);
+        OperationNode *pose_entry = pose_comp->get_entry_operation();
+        if (scheduled_operations.add(pose_entry)) {
+          queue.push_front(pose_entry);
+        }
+      }
+    }
+    for (Relation *rel : op_node->outlinks) {
+      /* Time source never causes user modification, so relations which only flush user edits
+       * are skipped as well. */
+      if (rel->flag & (RELATION_FLAG_NO_FLUSH | RELATION_FLAG_FLUSH_USER_EDIT_ONLY)) {
+        continue;
+      }
+      OperationNode *to_node = (OperationNode *)rel->to;
+      if (scheduled_operations.add(to_node)) {
+        queue.push_front(to_node);
+      }
+    }
+  }
+
+  graph->time_dependent_operations.extend(tagged_operations.as_span());
+  graph->time_dependent_components.extend(tagged_components.as_span());
+  graph->time_dependent_id_nodes.extend(tagged_id_nodes.as_span());
+}
+
 /* Flush updates from tagged nodes outwards until all affected nodes
  * are tagged.
  */
@@ -355,23 +470,43 @@ void deg_graph_flush_updates(Depsgraph *graph)
   BLI_assert(graph != nullptr);
   Main *bmain = graph->bmain;
 
+  /* When nothing but the time source is tagged the result of the flush is known in advance. */
+  bool is_time_dependent_update = graph->entry_tags.is_empty() &&
+                                  graph->time_source->tagged_for_update;
+#ifdef INVALIDATE_ON_FLUSH
+  is_time_dependent_update = false;
+#endif
+
   graph->time_source->flush_update_tag(graph);
 
   /* Nothing to update, early out. */
   if (graph->entry_tags.is_empty()) {
     return;
   }
-  /* Reset all flags, get ready for the flush. */
-  flush_prepare(graph);
-  /* Starting from the tagged "entry" nodes, flush outwards. */
-  FlushQueue queue;
-  flush_schedule_entrypoints(graph, &queue);
   /* Prepare update context for editors. */
   DEGEditorUpdateContext update_ctx;
   update_ctx.bmain = bmain;
   update_ctx.depsgraph = (::Depsgraph *)graph;
   update_ctx.scene = graph->scene;
   update_ctx.view_layer = graph->view_layer;
+  if (is_time_dependent_update) {
+    flush_time_dependent_updates(graph, &update_ctx);
+    return;
+  }
+  /* Frames evaluated in advance do not include changes done by the user. */
+  if (graph->playback_prefetch != nullptr) {
+    for (OperationNode *op_node : graph->entry_tags) {
+      if (op_node->flag & DEPSOP_FLAG_USER_MODIFIED) {
+        graph->playback_prefetch->stop();
+        break;
+      }
+    }
+  }
+  /* Reset all flags, get ready for the flush. */
+  flush_prepare(graph);
+  /* Starting from the tagged "entry" nodes, flush outwards. */
+  FlushQueue queue;
+  flush_schedule_entrypoints(graph, &queue);
   /* Do actual flush. */
   while (!queue.empty()) {
     OperationNode *op_node = queue.front();
@@ -398,11 +533,16 @@ void deg_graph_flush_updates(Depsgraph *graph)
 /* Clear tags from all operation nodes. */
 void deg_graph_clear_tags(Depsgraph *graph)
 {
-  /* Go over all operation nodes, clearing tags. */
-  for (OperationNode *node : graph->operations) {
+  /* Go over all operation nodes, clearing tags. Only time dependent operations could have been
+   * tagged by the time dependent update. */
+  Span<OperationNode *> operations = graph->is_time_dependent_update ?
+                                         graph->time_dependent_operations.as_span() :
+                                         graph->operations.as_span();
+  for (OperationNode *node : operations) {
     node->flag &= ~(DEPSOP_FLAG_DIRECTLY_MODIFIED | DEPSOP_FLAG_NEEDS_UPDATE |
                     DEPSOP_FLAG_USER_MODIFIED);
   }
+  graph->is_time_dependent_update = false;
   /* Clear any entry tags which haven't been flushed. */
   graph->entry_tags.clear();
 
@@ -35,6 +35,10 @@ struct Depsgraph;
  */
 void deg_graph_flush_updates(struct Depsgraph *graph);
 
+/* Gather the part of the graph which flush from the time source tags for update, used by
+ * deg_graph_flush_updates() on frame change. To be called once relations are built. */
+void deg_graph_build_time_dependent_subgraph(struct Depsgraph *graph);
+
 /* Clear tags from all operation nodes. */
 void deg_graph_clear_tags(struct Depsgraph *graph);
 
@@ -0,0 +1,379 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_playback_prefetch.h"
+
+#include "BLI_system.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_geometry_set.hh"
+#include "BKE_lib_id.h"
+#include "BKE_lib_query.h"
+#include "BKE_mesh.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+#include "intern/builder/pipeline_view_layer.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_registry.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+
+namespace {
+
+int remap_id_to_original_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  ID **id_p = cb_data->id_pointer;
+  if (*id_p != nullptr && (*id_p)->orig_id != nullptr) {
+    *id_p = (*id_p)->orig_id;
+  }
+  return IDWALK_RET_NOP;
+}
+
+int remap_id_to_cow_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  ID **id_p = cb_data->id_pointer;
+  const Depsgraph *graph = static_cast<const Depsgraph *>(cb_data->user_data);
+  if (*id_p != nullptr) {
+    *id_p = graph->get_cow_id(*id_p);
+  }
+  return IDWALK_RET_NOP;
+}
+
+Mesh *mesh_copy_for_cache(const Mesh *mesh_eval)
+{
+  if (mesh_eval == nullptr) {
+    return nullptr;
+  }
+  Mesh *mesh = BKE_mesh_copy_for_eval((Mesh *)mesh_eval, false);
+  BKE_library_foreach_ID_link(nullptr, &mesh->id, remap_id_to_original_cb, nullptr, IDWALK_NOP);
+  return mesh;
+}
+
+void mesh_remap_to_graph(Mesh *mesh, const Depsgraph *graph)
+{
+  if (mesh != nullptr) {
+    BKE_library_foreach_ID_link(
+        nullptr, &mesh->id, remap_id_to_cow_cb, (void *)graph, IDWALK_NOP);
+  }
+}
+
+}  // namespace
+
+PlaybackPrefetch::PlaybackPrefetch(Depsgraph *graph)
+    : graph_(graph),
+      threads_{nullptr, nullptr},
+      is_started_(false),
+      do_stop_(false),
+      current_frame_(0),
+      next_frame_(0),
+      step_(0),
+      start_frame_(0),
+      end_frame_(0)
+{
+  BLI_mutex_init(&mutex_);
+  BLI_condition_init(&condition_);
+}
+
+PlaybackPrefetch::~PlaybackPrefetch()
+{
+  stop();
+  BLI_condition_end(&condition_);
+  BLI_mutex_end(&mutex_);
+}
+
+bool PlaybackPrefetch::start()
+{
+  BLI_assert(workers_.is_empty());
+  /* Each of the graphs is evaluated using multiple threads already, so only use few of them. */
+  const int num_workers = max_ii(1, min_ii(4, BLI_system_thread_count() / 8));
+  for (int i = 0; i < num_workers; i++) {
+    Worker *worker = new Worker();
+    worker->prefetch = this;
+    worker->graph = new Depsgraph(
+        graph_->bmain, graph_->scene, graph_->view_layer, graph_->mode);
+    worker->graph->debug.name = "PLAYBACK PREFETCH";
+    ViewLayerBuilderPipeline builder(reinterpret_cast<::Depsgraph *>(worker->graph));
+    builder.build();
+    workers_.append(worker);
+    for (IDNode *id_node : worker->graph->id_nodes) {
+      /* Objects in edit or paint modes use original data which is modified by the main thread. */
+      if (GS(id_node->id_orig->name) == ID_OB &&
+          ((Object *)id_node->id_orig)->mode != OB_MODE_OBJECT) {
+        return false;
+      }
+    }
+    for (ComponentNode *comp_node : worker->graph->time_dependent_components) {
+      if (comp_node->type == NodeType::GEOMETRY && GS(comp_node->owner->id_orig->name) == ID_OB) {
+        worker->id_nodes.append(comp_node->owner);
+      }
+    }
+    if (worker->id_nodes.is_empty()) {
+      /* No animated geometry, nothing to gain from evaluating frames in advance. */
+      return false;
+    }
+  }
+
+  do_stop_ = false;
+  BLI_threadpool_init(&threads_, worker_thread, workers_.size());
+  for (Worker *worker : workers_) {
+    BLI_threadpool_insert(&threads_, worker);
+  }
+  return true;
+}
+
+void PlaybackPrefetch::stop()
+{
+  if (threads_.first != nullptr) {
+    BLI_mutex_lock(&mutex_);
+    do_stop_ = true;
+    BLI_condition_notify_all(&condition_);
+    BLI_mutex_unlock(&mutex_);
+    BLI_threadpool_end(&threads_);
+    BLI_listbase_clear(&threads_);
+  }
+  free_workers();
+  free_cache(false);
+  is_started_ = false;
+}
+
+void PlaybackPrefetch::free_workers()
+{
+  for (Worker *worker : workers_) {
+    delete worker->graph;
+    delete worker;
+  }
+  workers_.clear();
+}
+
+void PlaybackPrefetch::update(int frame, int step)
+{
+  BLI_mutex_lock(&mutex_);
+  current_frame_ = frame;
+  step_ = step;
+  start_frame_ = graph_->scene->r.sfra;
+  end_frame_ = graph_->scene->r.efra;
+  /* Continue after the frames which are evaluated already, unless playback jumped. */
+  const int distance = (next_frame_ - current_frame_) * step_;
+  if (distance <= 0 || distance > NUM_FRAMES) {
+    next_frame_ = current_frame_ + step_;
+  }
+  free_cache(true);
+  BLI_condition_notify_all(&condition_);
+  BLI_mutex_unlock(&mutex_);
+
+  if (!is_started_) {
+    is_started_ = true;
+    if (!start()) {
+      /* Keep is_started_ set, so there is no attempt to start on every frame. */
+      free_workers();
+    }
+  }
+}
+
+Mesh *PlaybackPrefetch::mesh_pop(const Object *object_orig,
+                                 float ctime,
+                                 const CustomData_MeshMasks *data_mask,
+                                 bool need_mapping,
+                                 Mesh **r_mesh_deform)
+{
+  *r_mesh_deform = nullptr;
+  const int frame = (int)ctime;
+  if ((float)frame != ctime) {
+    return nullptr;
+  }
+  BLI_mutex_lock(&mutex_);
+  const CacheKey key(object_orig, frame);
+  const CachedMesh *cached_mesh_ptr = cache_.lookup_ptr(key);
+  if (cached_mesh_ptr == nullptr) {
+    BLI_mutex_unlock(&mutex_);
+    return nullptr;
+  }
+  const CachedMesh cached_mesh = *cached_mesh_ptr;
+  cache_.remove_contained(key);
+  BLI_mutex_unlock(&mutex_);
+
+  if (!CustomData_MeshMasks_are_matching(&cached_mesh.data_mask, data_mask) ||
+      (need_mapping && !cached_mesh.need_mapping)) {
+    cached_mesh_free(cached_mesh);
+    return nullptr;
+  }
+  mesh_remap_to_graph(cached_mesh.mesh, graph_);
+  mesh_remap_to_graph(cached_mesh.mesh_deform, graph_);
+  *r_mesh_deform = cached_mesh.mesh_deform;
+  return cached_mesh.mesh;
+}
+
+void *PlaybackPrefetch::worker_thread(void *worker_v)
+{
+  Worker *worker = static_cast<Worker *>(worker_v);
+  PlaybackPrefetch *prefetch = worker->prefetch;
+  ::Depsgraph *graph = reinterpret_cast<::Depsgraph *>(worker->graph);
+
+  BLI_mutex_lock(&prefetch->mutex_);
+  while (!prefetch->do_stop_) {
+    int frame;
+    if (!prefetch->pop_frame_to_evaluate(&frame)) {
+      BLI_condition_wait(&prefetch->condition_, &prefetch->mutex_);
+      continue;
+    }
+    BLI_mutex_unlock(&prefetch->mutex_);
+    DEG_evaluate_on_framechange(graph, (float)frame);
+    prefetch->store_evaluated_meshes(worker, frame);
+    BLI_mutex_lock(&prefetch->mutex_);
+  }
+  BLI_mutex_unlock(&prefetch->mutex_);
+  return nullptr;
+}
+
+/* NOTE: Expects the mutex to be locked. */
+bool PlaybackPrefetch::pop_frame_to_evaluate(int *r_frame)
+{
+  if (!is_frame_needed(next_frame_)) {
+    return false;
+  }
+  *r_frame = next_frame_;
+  next_frame_ += step_;
+  return true;
+}
+
+/* NOTE: Expects the mutex to be locked. */
+bool PlaybackPrefetch::is_frame_needed(int frame) const
+{
+  const int distance = (frame - current_frame_) * step_;
+  return distance > 0 && distance <= NUM_FRAMES && frame >= start_frame_ && frame <= end_frame_;
+}
+
+void PlaybackPrefetch::store_evaluated_meshes(Worker *worker, int frame)
+{
+  for (IDNode *id_node : worker->id_nodes) {
+    const Object *object = reinterpret_cast<const Object *>(id_node->id_cow);
+    const ID *data_eval = object->runtime.data_eval;
+    if (data_eval == nullptr || GS(data_eval->name) != ID_ME) {
+      continue;
+    }
+    /* Only the meshes are passed to the playing graph, so skip results with other geometry. */
+    const GeometrySet *geometry_set = object->runtime.geometry_set_eval;
+    if (geometry_set != nullptr && (geometry_set->has_instances() ||
+                                    geometry_set->has_pointcloud() ||
+                                    geometry_set->has_volume())) {
+      continue;
+    }
+    CachedMesh cached_mesh;
+    cached_mesh.mesh = mesh_copy_for_cache((const Mesh *)data_eval);
+    cached_mesh.mesh_deform = mesh_copy_for_cache(object->runtime.mesh_deform_eval);
+    cached_mesh.data_mask = object->runtime.last_data_mask;
+    cached_mesh.need_mapping = object->runtime.last_need_mapping;
+
+    BLI_mutex_lock(&mutex_);
+    if (!is_frame_needed(frame)) {
+      /* Playback went past the frame meanwhile. */
+      BLI_mutex_unlock(&mutex_);
+      cached_mesh_free(cached_mesh);
+      return;
+    }
+    const CacheKey key((const Object *)id_node->id_orig, frame);
+    CachedMesh *existing_mesh = cache_.lookup_ptr(key);
+    if (existing_mesh != nullptr) {
+      cached_mesh_free(*existing_mesh);
+      *existing_mesh = cached_mesh;
+    }
+    else {
+      cache_.add_new(key, cached_mesh);
+    }
+    BLI_mutex_unlock(&mutex_);
+  }
+}
+
+void PlaybackPrefetch::cached_mesh_free(const CachedMesh &cached_mesh)
+{
+  BKE_id_free(nullptr, cached_mesh.mesh);
+  if (cached_mesh.mesh_deform != nullptr) {
+    BKE_id_free(nullptr, cached_mesh.mesh_deform);
+  }
+}
+
+/* NOTE: Expects the mutex to be locked, or the worker threads to be stopped. */
+void PlaybackPrefetch::free_cache(bool only_unneeded)
+{
+  Vector<CacheKey> keys_to_remove;
+  for (const auto item : cache_.items()) {
+    if (!only_unneeded || !is_frame_needed(item.key.second)) {
+      cached_mesh_free(item.value);
+      keys_to_remove.append(item.key);
+    }
+  }
+  for (const CacheKey &key : keys_to_remove) {
+    cache_.remove_contained(key);
+  }
+}
+
+}  // namespace blender::deg
+
+void DEG_playback_prefetch_update(Depsgraph *depsgraph, int frame, int step)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  if (deg_graph->playback_prefetch == nullptr) {
+    deg_graph->playback_prefetch = new deg::PlaybackPrefetch(deg_graph);
+  }
+  deg_graph->playback_prefetch->update(frame, step);
+}
+
+void DEG_playback_prefetch_stop(Depsgraph *depsgraph)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  delete deg_graph->playback_prefetch;
+  deg_graph->playback_prefetch = nullptr;
+}
+
+void DEG_playback_prefetch_stop_all(Main *bmain)
+{
+  for (deg::Depsgraph *deg_graph : deg::get_all_registered_graphs(bmain)) {
+    DEG_playback_prefetch_stop(reinterpret_cast<Depsgraph *>(deg_graph));
+  }
+}
+
+Mesh *DEG_playback_prefetch_mesh_pop(const Depsgraph *depsgraph,
+                                     const Object *object,
+                                     const CustomData_MeshMasks *data_mask,
+                                     bool need_mapping,
+                                     Mesh **r_mesh_deform)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  if (deg_graph->playback_prefetch == nullptr) {
+    *r_mesh_deform = nullptr;
+    return nullptr;
+  }
+  const Object *object_orig = (const Object *)DEG_get_original_id((ID *)&object->id);
+  return deg_graph->playback_prefetch->mesh_pop(
+      object_orig, deg_graph->ctime, data_mask, need_mapping, r_mesh_deform);
+}
@@ -0,0 +1,122 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "BLI_threads.h"
+
+#include "DNA_customdata_types.h"
+
+#include "intern/depsgraph_type.h"
+
+struct Mesh;
+struct Object;
+
+namespace blender {
+namespace deg {
+
+struct Depsgraph;
+struct IDNode;
+
+/* Evaluation of the frames following the current one during animation playback.
+ *
+ * Frames are evaluated by dependency graphs which are private to the prefetch, each of them
+ * evaluated by its own thread. Evaluated meshes of objects which have time dependent geometry are
+ * kept, so evaluation of the frame in the playing dependency graph can use them instead of
+ * evaluating the modifier stack. */
+class PlaybackPrefetch {
+ public:
+  PlaybackPrefetch(Depsgraph *graph);
+  ~PlaybackPrefetch();
+
+  /* Called from the main thread whenever playback changes the frame. step is the frame increment
+   * of the playback, negative when playing backwards. */
+  void update(int frame, int step);
+
+  /* Stop evaluation and free all cached data. The next update() starts again using the current
+   * state of the original data-blocks. */
+  void stop();
+
+  /* Take ownership of the meshes evaluated for the given original object at the given frame, the
+   * final one is returned and the deform-only one is stored in r_mesh_deform. Their ID pointers
+   * point to the data-blocks of the playing graph. Returns nullptr when there is no such mesh, or
+   * it has not all the required data layers. */
+  Mesh *mesh_pop(const Object *object_orig,
+                 float ctime,
+                 const CustomData_MeshMasks *data_mask,
+                 bool need_mapping,
+                 Mesh **r_mesh_deform);
+
+ protected:
+  struct Worker {
+    PlaybackPrefetch *prefetch;
+    Depsgraph *graph;
+    /* Objects of the worker's graph with time dependent geometry. */
+    Vector<IDNode *> id_nodes;
+  };
+
+  /* ID pointers of the meshes point to original data-blocks, the copies of the worker graphs are
+   * freed when the prefetch stops. */
+  struct CachedMesh {
+    Mesh *mesh;
+    /* Result of the deform modifiers only, can be nullptr. */
+    Mesh *mesh_deform;
+    CustomData_MeshMasks data_mask;
+    bool need_mapping;
+  };
+
+  using CacheKey = std::pair<const Object *, int>;
+
+  /* Number of frames ahead of the current one which are evaluated. */
+  static const constexpr int NUM_FRAMES = 8;
+
+  bool start();
+  void free_workers();
+  static void *worker_thread(void *worker_v);
+  bool pop_frame_to_evaluate(int *r_frame);
+  bool is_frame_needed(int frame) const;
+  void store_evaluated_meshes(Worker *worker, int frame);
+  void free_cache(bool only_unneeded);
+  static void cached_mesh_free(const CachedMesh &cached_mesh);
+
+  Depsgraph *graph_;
+
+  Vector<Worker *> workers_;
+  ListBase threads_;
+  /* Start was attempted, it does not happen when there is nothing to be prefetched. */
+  bool is_started_;
+
+  /* Protects everything below, which is shared with the worker threads. */
+  ThreadMutex mutex_;
+  ThreadCondition condition_;
+  bool do_stop_;
+  int current_frame_;
+  int next_frame_;
+  int step_;
+  int start_frame_;
+  int end_frame_;
+  Map<CacheKey, CachedMesh> cache_;
+};
+
+}  // namespace deg
+}  // namespace blender
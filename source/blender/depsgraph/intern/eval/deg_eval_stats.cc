@@ -36,6 +36,23 @@ namespace blender::deg {
 
 void deg_eval_stats_aggregate(Depsgraph *graph)
 {
+  if (graph->is_time_dependent_update) {
+    /* Only the time dependent part of the graph was evaluated, the stats of the other nodes are
+     * the ones of the evaluation they were last part of. */
+    for (ComponentNode *comp_node : graph->time_dependent_components) {
+      comp_node->stats.reset_current();
+    }
+    for (IDNode *id_node : graph->time_dependent_id_nodes) {
+      id_node->stats.reset_current();
+    }
+    for (OperationNode *op_node : graph->time_dependent_operations) {
+      ComponentNode *comp_node = op_node->owner;
+      IDNode *id_node = comp_node->owner;
+      id_node->stats.current_time += op_node->stats.current_time;
+      comp_node->stats.current_time += op_node->stats.current_time;
+    }
+    return;
+  }
   /* Reset current evaluation stats for ID and component nodes.
    * Those are not filled in by the evaluation engine. */
   for (Node *node : graph->id_nodes) {
@@ -273,6 +273,13 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Time spent on evaluating this operation the last time it was evaluated. Unlike stats this is
+   * always gathered, and is kept across evaluations so it can be used for scheduling. */
+  double eval_time;
+  /* Estimated time needed to evaluate the longest chain of tagged operations which starts at this
+   * one, this operation included. Operations on the critical path are scheduled first. */
+  double critical_path_time;
+
   DEG_DEPSNODE_DECLARE;
 };
 
@@ -75,6 +75,10 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Number of irradiance samples rendered with the same draw cache. Kept low because the drawing
+ * of the viewports is locked while the samples are rendered. */
+#define IRRADIANCE_SAMPLE_BATCH_LEN 8
+
 /* TODO should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -129,6 +133,8 @@ typedef struct EEVEE_LightBake {
   int total_irr_samples;
   /** Nth sample of the current grid being rendered. */
   int grid_sample;
+  /** Number of samples rendered from #grid_sample with the same draw cache. */
+  int grid_sample_batch_len;
   /** Total number of samples for the current grid. */
   int grid_sample_len;
   /** Nth grid in the cache being rendered. */
@@ -1104,12 +1110,10 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, const int local_cell[3
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample(EEVEE_Data *vedata, EEVEE_LightBake *lbake)
 {
-  EEVEE_Data *vedata = (EEVEE_Data *)ved;
-  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
+  EEVEE_ViewLayerData *sldata = lbake->sldata;
   EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
-  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   EEVEE_LightGrid *egrid = lbake->grid;
   LightProbe *prb = *lbake->probe;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
@@ -1125,10 +1129,6 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   /* Use the previous bounce for rendering this bounce. */
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  /* TODO do this once for the whole bake when we have independent DRWManagers.
-   * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Compute sample position */
   compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
   sample_offset = egrid->offset + sample_id;
@@ -1189,6 +1189,34 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
 }
 
+/* Render a batch of samples of the same grid and bounce. The scene and the visibility
+ * collection of the probe are the same for all of them, so they share the draw cache. */
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
+{
+  EEVEE_Data *vedata = (EEVEE_Data *)ved;
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
+
+  /* No bias for rendering the probe. */
+  lbake->grid->level_bias = 1.0f;
+
+  /* The previous bounce is referenced by the draw cache, see the sample rendering. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  /* TODO do this once for the whole bake when we have independent DRWManagers.
+   * Warning: Some of the things above require this. */
+  eevee_lightbake_cache_create(vedata, lbake);
+
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  const int grid_sample_first = lbake->grid_sample;
+  for (int i = 0; i < lbake->grid_sample_batch_len; i++) {
+    lbake->grid_sample = grid_sample_first + i;
+    eevee_lightbake_render_grid_sample(vedata, lbake);
+  }
+}
+
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
@@ -1345,7 +1373,8 @@ void EEVEE_lightbake_update(void *custom_data)
 }
 
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                int sample_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1356,7 +1385,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instanciable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += sample_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1420,7 +1449,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
@@ -1434,9 +1463,13 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
-        for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+        for (int sample = 0; sample < lbake->grid_sample_len;
+             sample += IRRADIANCE_SAMPLE_BATCH_LEN) {
+          lbake->grid_sample = sample;
+          lbake->grid_sample_batch_len = min_ii(IRRADIANCE_SAMPLE_BATCH_LEN,
+                                                lbake->grid_sample_len - sample);
+          lightbake_do_sample(
+              lbake, eevee_lightbake_render_grid_samples, lbake->grid_sample_batch_len);
         }
       }
     }
@@ -1449,7 +1482,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample, 1);
     }
   }
 
@@ -323,8 +323,9 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   DRW_stats_group_start("Cube Shadow Maps");
   {
     for (int cube = 0; cube < linfo->cube_len; cube++) {
-      if (BLI_BITMAP_TEST(cube_visible, cube) && BLI_BITMAP_TEST(linfo->sh_cube_update, cube)) {
-        EEVEE_shadows_draw_cubemap(sldata, vedata, cube);
+      if (BLI_BITMAP_TEST(cube_visible, cube) && (BLI_BITMAP_TEST(linfo->sh_cube_update, cube) ||
+                                                  linfo->sh_cube_face_update[cube] != 0)) {
+        EEVEE_shadows_draw_cubemap(sldata, vedata, view, cube);
       }
     }
   }
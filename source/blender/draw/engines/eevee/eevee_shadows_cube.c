@@ -178,7 +178,12 @@ static bool spot_angle_fit_single_face(const EEVEE_Light *evli)
   return cos_beta > cosf(DEG2RADF(42.0f));
 }
 
-void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index)
+/* Only render the faces visible in the given view, the others are rendered when they become
+ * visible, unless the cube has been updated in between. */
+void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata,
+                                EEVEE_Data *vedata,
+                                DRWView *view,
+                                int cube_index)
 {
   EEVEE_PassList *psl = vedata->psl;
   EEVEE_StorageList *stl = vedata->stl;
@@ -195,23 +200,38 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
                           cube_data->shadowmat,
                           g_data->cube_views);
 
+  uchar *face_update = &linfo->sh_cube_face_update[cube_index];
+  if (BLI_BITMAP_TEST(&linfo->sh_cube_update[0], cube_index)) {
+    *face_update = (1 << 6) - 1;
+    BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  }
+
   /* Render shadow cube */
   /* Render 6 faces separately: seems to be faster for the general case.
    * The only time it's more beneficial is when the CPU culling overhead
    * outweigh the instancing overhead. which is rarely the case. */
   for (int j = 0; j < 6; j++) {
+    if ((*face_update & (1 << j)) == 0) {
+      continue;
+    }
     /* Optimization: Only render the needed faces. */
     /* Skip all but -Z face. */
     if (evli->light_type == LA_SPOT && j != 5 && spot_angle_fit_single_face(evli)) {
+      *face_update &= ~(1 << j);
       continue;
     }
     /* Skip +Z face. */
     if (evli->light_type != LA_LOCAL && j == 4) {
+      *face_update &= ~(1 << j);
       continue;
     }
-    /* TODO(fclem): some cube sides can be invisible in the main views. Cull them. */
-    // if (frustum_intersect(g_data->cube_views[j], main_view))
-    //   continue;
+    /* Skip faces that are invisible in the view, they keep their update bit. */
+    BoundBox face_corners;
+    DRW_view_frustum_corners_get(g_data->cube_views[j], &face_corners);
+    if (!DRW_culling_box_test(view, &face_corners)) {
+      continue;
+    }
+    *face_update &= ~(1 << j);
 
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
@@ -220,6 +240,4 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
   }
-
-  BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
 }
@@ -202,12 +202,12 @@ static void select_cache_init(void *vedata)
   e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
+    /* Check if any of the drawn objects have been transformed or edited. */
     Object **ob = &e_data.context.objects_drawn[0];
     for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
       DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+      if (data && (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+        data->recalc &= ~(ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
         e_data.context.is_dirty = true;
       }
     }
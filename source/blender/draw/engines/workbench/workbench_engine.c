@@ -194,6 +194,9 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
         }
       }
     }
+    else if (ob->type == OB_MESH && U.experimental.use_viewport_lod) {
+      geom = DRW_cache_mesh_surface_lod_get(ob);
+    }
     else {
       geom = DRW_cache_object_surface_get(ob);
     }
@@ -38,6 +38,8 @@
 #include "BKE_object.h"
 #include "BKE_paint.h"
 
+#include "ED_view3d.h"
+
 #include "GPU_batch.h"
 #include "GPU_batch_utils.h"
 
@@ -2855,6 +2857,54 @@ GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
+/* Meshes with less faces than this are always drawn at full resolution. */
+#define MESH_LOD_POLY_LEN_MIN 4096
+
+/* Return the decimated level of detail to draw the object with, or -1 for full resolution. */
+static int drw_cache_mesh_lod_level_get(Object *ob)
+{
+  const DRWContextState *draw_ctx = DRW_context_state_get();
+  const Mesh *me = ob->data;
+  /* Only in the viewport, and not while the object is being edited or painted on. */
+  if (draw_ctx->rv3d == NULL || ob->mode != OB_MODE_OBJECT || me->edit_mesh != NULL ||
+      me->totpoly < MESH_LOD_POLY_LEN_MIN) {
+    return -1;
+  }
+  BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return -1;
+  }
+  float min[3], max[3], center[3];
+  mul_v3_m4v3(min, ob->obmat, bb->vec[0]);
+  mul_v3_m4v3(max, ob->obmat, bb->vec[6]);
+  mid_v3_v3v3(center, min, max);
+  const float pixel_size = fabsf(ED_view3d_pixel_size(draw_ctx->rv3d, center));
+  if (pixel_size == 0.0f) {
+    return -1;
+  }
+  /* Diameter of the bounds in pixels. */
+  const float screen_size = len_v3v3(min, max) / pixel_size;
+  if (screen_size < 32.0f) {
+    return 1;
+  }
+  if (screen_size < 128.0f) {
+    return 0;
+  }
+  return -1;
+}
+
+/* Same as #DRW_cache_mesh_surface_get but uses decimated geometry when the object is small on
+ * screen. Uses the same vertex buffers, so only the index buffer is duplicated. */
+GPUBatch *DRW_cache_mesh_surface_lod_get(Object *ob)
+{
+  BLI_assert(ob->type == OB_MESH);
+  const int lod = drw_cache_mesh_lod_level_get(ob);
+  if (lod == -1) {
+    return DRW_mesh_batch_cache_get_surface(ob->data);
+  }
+  return DRW_mesh_batch_cache_get_surface_lod(ob->data, lod);
+}
+
 GPUBatch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
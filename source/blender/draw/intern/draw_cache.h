@@ -137,6 +137,7 @@ struct GPUBatch *DRW_cache_mesh_all_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_loose_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_edge_detection_get(struct Object *ob, bool *r_is_manifold);
 struct GPUBatch *DRW_cache_mesh_surface_get(struct Object *ob);
+struct GPUBatch *DRW_cache_mesh_surface_lod_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_surface_edges_get(struct Object *ob);
 struct GPUBatch **DRW_cache_mesh_surface_shaded_get(struct Object *ob,
                                                     struct GPUMaterial **gpumat_array,
@@ -91,6 +91,9 @@ BLI_INLINE int mesh_render_mat_len_get(Mesh *me)
   return MAX2(1, me->totcol);
 }
 
+/* Number of decimated levels of detail of the surface batch. */
+#define MBC_LOD_LEN 2
+
 typedef struct MeshBufferCache {
   /* Every VBO below contains at least enough
    * data for every loops in the mesh (except fdots and skin roots).
@@ -129,6 +132,7 @@ typedef struct MeshBufferCache {
   struct {
     /* Indices to vloops. */
     GPUIndexBuf *tris;        /* Ordered per material. */
+    GPUIndexBuf *tris_lod[MBC_LOD_LEN]; /* Decimated `tris`, not ordered per material. */
     GPUIndexBuf *lines;       /* Loose edges last. */
     GPUIndexBuf *lines_loose; /* sub buffer of `lines` only containing the loose edges. */
     GPUIndexBuf *points;
@@ -175,6 +179,7 @@ typedef enum DRWBatchFlag {
   MBC_WIRE_LOOPS_UVS = (1 << 25),
   MBC_SKIN_ROOTS = (1 << 26),
   MBC_SCULPT_OVERLAYS = (1 << 27),
+  MBC_SURFACE_LOD = (1 << 28),
 } DRWBatchFlag;
 
 #define MBC_EDITUV \
@@ -195,6 +200,8 @@ typedef struct MeshBatchCache {
     /* Surfaces / Render */
     GPUBatch *surface;
     GPUBatch *surface_weights;
+    /* Decimated versions of `surface`, see #DRW_mesh_batch_cache_get_surface_lod. */
+    GPUBatch *surface_lod[MBC_LOD_LEN];
     /* Edit mode */
     GPUBatch *edit_triangles;
     GPUBatch *edit_vertices;
@@ -763,6 +763,14 @@ typedef void(ExtractFinishFn)(const MeshRenderData *mr,
                               struct MeshBatchCache *cache,
                               void *buffer,
                               void *data);
+typedef void *(ExtractTaskInitFn)(const MeshRenderData *mr,
+                                  const eMRIterType iter_type,
+                                  const int start,
+                                  void *data);
+typedef void(ExtractTaskFinishFn)(const MeshRenderData *mr, void *data, void *task_data);
+
+/** Number of elements iterated by each task of a multi-threaded extraction. */
+#define EXTRACT_RANGE_LEN 8192
 
 typedef struct MeshExtract {
   /** Executed on main thread and return user data for iteration functions. */
@@ -778,6 +786,15 @@ typedef struct MeshExtract {
   ExtractLVertMeshFn *iter_lvert_mesh;
   /** Executed on one worker thread after all elements iterations. */
   ExtractFinishFn *finish;
+  /**
+   * Optional, creates data for a single task which is passed to the iteration functions instead
+   * of the shared data. Allows multi-threading extractors that can't write to the shared data
+   * from multiple threads, by writing to partial buffers instead. Executed on the worker thread
+   * before iterating the task range, \a start is the first element index of that range.
+   */
+  ExtractTaskInitFn *task_init;
+  /** Merges the data of one task into the shared data, executed in task order before #finish. */
+  ExtractTaskFinishFn *task_finish;
   /** Used to request common data. */
   const eMRDataType data_flag;
   /** Used to know if the element callbacks are thread-safe and can be parallelized. */
@@ -794,6 +811,26 @@ BLI_INLINE eMRIterType mesh_extract_iter_type(const MeshExtract *ext)
   return type;
 }
 
+/**
+ * Task functions for extractors that only use a #GPUIndexBufBuilder as data and set elements at
+ * known indices, every task gets its own sub-builder.
+ */
+static void *extract_elb_task_init(const MeshRenderData *UNUSED(mr),
+                                   const eMRIterType UNUSED(iter_type),
+                                   const int UNUSED(start),
+                                   void *elb)
+{
+  GPUIndexBufBuilder *sub_builder = MEM_mallocN(sizeof(*sub_builder), __func__);
+  GPU_indexbuf_subbuilder_init(elb, sub_builder);
+  return sub_builder;
+}
+
+static void extract_elb_task_finish(const MeshRenderData *UNUSED(mr), void *elb, void *sub_builder)
+{
+  GPU_indexbuf_join(elb, sub_builder);
+  MEM_freeN(sub_builder);
+}
+
 /** \} */
 
 /* ---------------------------------------------------------------------- */
@@ -804,68 +841,114 @@ typedef struct MeshExtract_Tri_Data {
   GPUIndexBufBuilder elb;
   int *tri_mat_start;
   int *tri_mat_end;
+  /**
+   * Index of the first triangle of every material in each range of #EXTRACT_RANGE_LEN looptris,
+   * so ranges can be extracted in parallel while keeping triangles sorted by material.
+   */
+  int *tri_range_mat_start;
 } MeshExtract_Tri_Data;
 
+typedef struct MeshExtract_Tri_TaskData {
+  GPUIndexBufBuilder elb;
+  /** Index of the next triangle for every material. */
+  int *tri_mat_ofs;
+} MeshExtract_Tri_TaskData;
+
 static void *extract_tris_init(const MeshRenderData *mr,
                                struct MeshBatchCache *UNUSED(cache),
                                void *UNUSED(ibo))
 {
   MeshExtract_Tri_Data *data = MEM_callocN(sizeof(*data), __func__);
 
+  const int range_len = max_ii(1, divide_ceil_u(mr->tri_len, EXTRACT_RANGE_LEN));
   size_t mat_tri_idx_size = sizeof(int) * mr->mat_len;
   data->tri_mat_start = MEM_callocN(mat_tri_idx_size, __func__);
   data->tri_mat_end = MEM_callocN(mat_tri_idx_size, __func__);
+  data->tri_range_mat_start = MEM_callocN(mat_tri_idx_size * range_len, __func__);
 
-  int *mat_tri_len = data->tri_mat_start;
-  /* Count how many triangle for each material. */
+  const int mat_last = mr->mat_len - 1;
+  int *range_mat_tri_len = data->tri_range_mat_start;
+  /* Count how many triangle for each material in every range. */
   if (mr->extract_type == MR_EXTRACT_BMESH) {
-    BMIter iter;
-    BMFace *efa;
-    BM_ITER_MESH (efa, &iter, mr->bm, BM_FACES_OF_MESH) {
+    BMLoop *(*looptris)[3] = mr->edit_bmesh->looptris;
+    for (int tri_index = 0; tri_index < mr->tri_len; tri_index++) {
+      const BMFace *efa = looptris[tri_index][0]->f;
       if (!BM_elem_flag_test(efa, BM_ELEM_HIDDEN)) {
-        int mat = min_ii(efa->mat_nr, mr->mat_len - 1);
-        mat_tri_len[mat] += efa->len - 2;
+        const int mat = min_ii(efa->mat_nr, mat_last);
+        range_mat_tri_len[(tri_index / EXTRACT_RANGE_LEN) * mr->mat_len + mat]++;
       }
     }
   }
   else {
-    const MPoly *mp = mr->mpoly;
-    for (int mp_index = 0; mp_index < mr->poly_len; mp_index++, mp++) {
+    for (int tri_index = 0; tri_index < mr->tri_len; tri_index++) {
+      const MPoly *mp = &mr->mpoly[mr->mlooptri[tri_index].poly];
       if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
-        int mat = min_ii(mp->mat_nr, mr->mat_len - 1);
-        mat_tri_len[mat] += mp->totloop - 2;
+        const int mat = min_ii(mp->mat_nr, mat_last);
+        range_mat_tri_len[(tri_index / EXTRACT_RANGE_LEN) * mr->mat_len + mat]++;
       }
     }
   }
-  /* Accumulate triangle lengths per material to have correct offsets. */
-  int ofs = mat_tri_len[0];
-  mat_tri_len[0] = 0;
-  for (int i = 1; i < mr->mat_len; i++) {
-    int tmp = mat_tri_len[i];
-    mat_tri_len[i] = ofs;
-    ofs += tmp;
+  /* Accumulate triangle lengths per material and range to have correct offsets. */
+  int ofs = 0;
+  for (int mat = 0; mat < mr->mat_len; mat++) {
+    data->tri_mat_start[mat] = ofs;
+    for (int range = 0; range < range_len; range++) {
+      int *range_mat_ofs = &range_mat_tri_len[range * mr->mat_len + mat];
+      const int tmp = *range_mat_ofs;
+      *range_mat_ofs = ofs;
+      ofs += tmp;
+    }
+    data->tri_mat_end[mat] = ofs;
   }
 
-  memcpy(data->tri_mat_end, mat_tri_len, mat_tri_idx_size);
-
   int visible_tri_tot = ofs;
   GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, visible_tri_tot, mr->loop_len);
 
   return data;
 }
 
+static void *extract_tris_task_init(const MeshRenderData *mr,
+                                    const eMRIterType UNUSED(iter_type),
+                                    const int start,
+                                    void *_data)
+{
+  MeshExtract_Tri_Data *data = _data;
+  BLI_assert(start % EXTRACT_RANGE_LEN == 0);
+  const size_t mat_tri_idx_size = sizeof(int) * mr->mat_len;
+  MeshExtract_Tri_TaskData *task_data = MEM_mallocN(sizeof(*task_data) + mat_tri_idx_size,
+                                                    __func__);
+  GPU_indexbuf_subbuilder_init(&data->elb, &task_data->elb);
+  task_data->tri_mat_ofs = (int *)(task_data + 1);
+  /* Ranges that extend over multiple ranges of #EXTRACT_RANGE_LEN continue at the offsets of the
+   * next range, so only the offsets of the first one are needed. */
+  memcpy(task_data->tri_mat_ofs,
+         &data->tri_range_mat_start[(start / EXTRACT_RANGE_LEN) * mr->mat_len],
+         mat_tri_idx_size);
+  return task_data;
+}
+
+static void extract_tris_task_finish(const MeshRenderData *UNUSED(mr),
+                                     void *_data,
+                                     void *_task_data)
+{
+  MeshExtract_Tri_Data *data = _data;
+  MeshExtract_Tri_TaskData *task_data = _task_data;
+  GPU_indexbuf_join(&data->elb, &task_data->elb);
+  MEM_freeN(task_data);
+}
+
 static void extract_tris_iter_looptri_bm(const MeshRenderData *mr,
                                          const struct ExtractTriBMesh_Params *params,
-                                         void *_data)
+                                         void *_task_data)
 {
-  MeshExtract_Tri_Data *data = _data;
+  MeshExtract_Tri_TaskData *task_data = _task_data;
   const int mat_last = mr->mat_len - 1;
   EXTRACT_TRIS_LOOPTRI_FOREACH_BM_BEGIN(elt, _elt_index, params)
   {
     if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
-      int *mat_tri_ofs = data->tri_mat_end;
+      int *mat_tri_ofs = task_data->tri_mat_ofs;
       const int mat = min_ii(elt[0]->f->mat_nr, mat_last);
-      GPU_indexbuf_set_tri_verts(&data->elb,
+      GPU_indexbuf_set_tri_verts(&task_data->elb,
                                  mat_tri_ofs[mat]++,
                                  BM_elem_index_get(elt[0]),
                                  BM_elem_index_get(elt[1]),
@@ -877,18 +960,18 @@ static void extract_tris_iter_looptri_bm(const MeshRenderData *mr,
 
 static void extract_tris_iter_looptri_mesh(const MeshRenderData *mr,
                                            const struct ExtractTriMesh_Params *params,
-                                           void *_data)
+                                           void *_task_data)
 {
-  MeshExtract_Tri_Data *data = _data;
+  MeshExtract_Tri_TaskData *task_data = _task_data;
   const int mat_last = mr->mat_len - 1;
   EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_BEGIN(mlt, _mlt_index, params)
   {
     const MPoly *mp = &mr->mpoly[mlt->poly];
     if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
-      int *mat_tri_ofs = data->tri_mat_end;
+      int *mat_tri_ofs = task_data->tri_mat_ofs;
       const int mat = min_ii(mp->mat_nr, mat_last);
       GPU_indexbuf_set_tri_verts(
-          &data->elb, mat_tri_ofs[mat]++, mlt->tri[0], mlt->tri[1], mlt->tri[2]);
+          &task_data->elb, mat_tri_ofs[mat]++, mlt->tri[0], mlt->tri[1], mlt->tri[2]);
     }
   }
   EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_END;
@@ -922,6 +1005,7 @@ static void extract_tris_finish(const MeshRenderData *mr,
   }
   MEM_freeN(data->tri_mat_start);
   MEM_freeN(data->tri_mat_end);
+  MEM_freeN(data->tri_range_mat_start);
   MEM_freeN(data);
 }
 
@@ -930,10 +1014,204 @@ static const MeshExtract extract_tris = {
     .iter_looptri_bm = extract_tris_iter_looptri_bm,
     .iter_looptri_mesh = extract_tris_iter_looptri_mesh,
     .finish = extract_tris_finish,
+    .task_init = extract_tris_task_init,
+    .task_finish = extract_tris_task_finish,
+    .data_flag = 0,
+    .use_threading = true,
+};
+
+/** \} */
+
+/* ---------------------------------------------------------------------- */
+/** \name Extract Decimated Triangle Indices
+ *
+ * Simplified version of `ibo.tris` used to draw objects that are small on screen. Vertices are
+ * clustered on a regular grid fitted to the mesh bounds and every triangle is remapped to one
+ * representative loop per cluster. Triangles that collapse are skipped, so the index buffer can
+ * be used with the same vertex buffers as the full resolution surface.
+ * \{ */
+
+/* Number of clusters along the largest axis of the mesh bounds, per level of detail. */
+static const int extract_tris_lod_resolution[MBC_LOD_LEN] = {48, 12};
+
+typedef struct MeshExtract_TriLOD_Data {
+  GPUIndexBufBuilder elb;
+  /* Representative loop of the cluster of each vertex. */
+  int *vert_loop;
+} MeshExtract_TriLOD_Data;
+
+static void *extract_tris_lod_init_ex(const MeshRenderData *mr, const int resolution)
+{
+  MeshExtract_TriLOD_Data *data = MEM_mallocN(sizeof(*data), __func__);
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+  data->vert_loop = MEM_mallocN(sizeof(int) * max_ii(mr->vert_len, 1), __func__);
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    BM_ITER_MESH (eve, &iter, mr->bm, BM_VERTS_OF_MESH) {
+      minmax_v3v3_v3(min, max, bm_vert_co_get(mr, eve));
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      minmax_v3v3_v3(min, max, mr->mvert[v].co);
+    }
+  }
+
+  float size[3];
+  sub_v3_v3v3(size, max, min);
+  const float max_size = max_fff(size[0], size[1], size[2]);
+  const float cell_size_inv = (max_size > 0.0f) ? (resolution / max_size) : 0.0f;
+  int dims[3];
+  for (int i = 0; i < 3; i++) {
+    dims[i] = clamp_i((int)(size[i] * cell_size_inv) + 1, 1, resolution + 1);
+  }
+
+  /* First store the cluster of each vertex, then replace it by the first loop found in it. */
+#define CELL_INDEX(co) \
+  ((min_ii((int)(((co)[0] - min[0]) * cell_size_inv), dims[0] - 1) * dims[1] + \
+    min_ii((int)(((co)[1] - min[1]) * cell_size_inv), dims[1] - 1)) * \
+       dims[2] + \
+   min_ii((int)(((co)[2] - min[2]) * cell_size_inv), dims[2] - 1))
+
+  const int cell_len = dims[0] * dims[1] * dims[2];
+  int *cell_loop = MEM_mallocN(sizeof(int) * cell_len, __func__);
+  copy_vn_i(cell_loop, cell_len, -1);
+
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    int v;
+    BM_ITER_MESH_INDEX (eve, &iter, mr->bm, BM_VERTS_OF_MESH, v) {
+      data->vert_loop[v] = CELL_INDEX(bm_vert_co_get(mr, eve));
+    }
+    BMFace *efa;
+    BM_ITER_MESH (efa, &iter, mr->bm, BM_FACES_OF_MESH) {
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+      do {
+        int *loop = &cell_loop[data->vert_loop[BM_elem_index_get(l_iter->v)]];
+        if (*loop == -1) {
+          *loop = BM_elem_index_get(l_iter);
+        }
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      data->vert_loop[v] = CELL_INDEX(mr->mvert[v].co);
+    }
+    for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
+      int *loop = &cell_loop[data->vert_loop[mr->mloop[ml_index].v]];
+      if (*loop == -1) {
+        *loop = ml_index;
+      }
+    }
+  }
+#undef CELL_INDEX
+
+  /* Loose vertices get -1, they are never used by triangles. */
+  for (int v = 0; v < mr->vert_len; v++) {
+    data->vert_loop[v] = cell_loop[data->vert_loop[v]];
+  }
+  MEM_freeN(cell_loop);
+  return data;
+}
+
+static void *extract_tris_lod0_init(const MeshRenderData *mr,
+                                    struct MeshBatchCache *UNUSED(cache),
+                                    void *UNUSED(ibo))
+{
+  return extract_tris_lod_init_ex(mr, extract_tris_lod_resolution[0]);
+}
+
+static void *extract_tris_lod1_init(const MeshRenderData *mr,
+                                    struct MeshBatchCache *UNUSED(cache),
+                                    void *UNUSED(ibo))
+{
+  return extract_tris_lod_init_ex(mr, extract_tris_lod_resolution[1]);
+}
+
+BLI_INLINE void extract_tris_lod_add(MeshExtract_TriLOD_Data *data, int v1, int v2, int v3)
+{
+  const int l1 = data->vert_loop[v1];
+  const int l2 = data->vert_loop[v2];
+  const int l3 = data->vert_loop[v3];
+  if (l1 != l2 && l2 != l3 && l3 != l1) {
+    GPU_indexbuf_add_tri_verts(&data->elb, l1, l2, l3);
+  }
+}
+
+static void extract_tris_lod_iter_looptri_bm(const MeshRenderData *UNUSED(mr),
+                                             const struct ExtractTriBMesh_Params *params,
+                                             void *data)
+{
+  EXTRACT_TRIS_LOOPTRI_FOREACH_BM_BEGIN(elt, _elt_index, params)
+  {
+    if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+      extract_tris_lod_add(data,
+                           BM_elem_index_get(elt[0]->v),
+                           BM_elem_index_get(elt[1]->v),
+                           BM_elem_index_get(elt[2]->v));
+    }
+  }
+  EXTRACT_TRIS_LOOPTRI_FOREACH_BM_END;
+}
+
+static void extract_tris_lod_iter_looptri_mesh(const MeshRenderData *mr,
+                                               const struct ExtractTriMesh_Params *params,
+                                               void *data)
+{
+  EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_BEGIN(mlt, _mlt_index, params)
+  {
+    const MPoly *mp = &mr->mpoly[mlt->poly];
+    if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
+      extract_tris_lod_add(data,
+                           mr->mloop[mlt->tri[0]].v,
+                           mr->mloop[mlt->tri[1]].v,
+                           mr->mloop[mlt->tri[2]].v);
+    }
+  }
+  EXTRACT_TRIS_LOOPTRI_FOREACH_MESH_END;
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr),
+                                    struct MeshBatchCache *UNUSED(cache),
+                                    void *ibo,
+                                    void *_data)
+{
+  MeshExtract_TriLOD_Data *data = _data;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->vert_loop);
+  MEM_freeN(data);
+}
+
+static const MeshExtract extract_tris_lod0 = {
+    .init = extract_tris_lod0_init,
+    .iter_looptri_bm = extract_tris_lod_iter_looptri_bm,
+    .iter_looptri_mesh = extract_tris_lod_iter_looptri_mesh,
+    .finish = extract_tris_lod_finish,
     .data_flag = 0,
     .use_threading = false,
 };
 
+static const MeshExtract extract_tris_lod1 = {
+    .init = extract_tris_lod1_init,
+    .iter_looptri_bm = extract_tris_lod_iter_looptri_bm,
+    .iter_looptri_mesh = extract_tris_lod_iter_looptri_mesh,
+    .finish = extract_tris_lod_finish,
+    .data_flag = 0,
+    .use_threading = false,
+};
+
+static const MeshExtract *extract_tris_lod[MBC_LOD_LEN] = {
+    &extract_tris_lod0,
+    &extract_tris_lod1,
+};
+
 /** \} */
 
 /* ---------------------------------------------------------------------- */
@@ -1247,8 +1525,10 @@ static const MeshExtract extract_points = {
     .iter_lvert_bm = extract_points_iter_lvert_bm,
     .iter_lvert_mesh = extract_points_iter_lvert_mesh,
     .finish = extract_points_finish,
+    .task_init = extract_elb_task_init,
+    .task_finish = extract_elb_task_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -1328,8 +1608,10 @@ static const MeshExtract extract_fdots = {
     .iter_poly_bm = extract_fdots_iter_poly_bm,
     .iter_poly_mesh = extract_fdots_iter_poly_mesh,
     .finish = extract_fdots_finish,
+    .task_init = extract_elb_task_init,
+    .task_finish = extract_elb_task_finish,
     .data_flag = 0,
-    .use_threading = false,
+    .use_threading = true,
 };
 
 /** \} */
@@ -1922,7 +2204,10 @@ static void *extract_pos_nor_init(const MeshRenderData *mr,
     GPU_vertformat_alias_add(&format, "vnor");
   }
   GPUVertBuf *vbo = buf;
-  GPU_vertbuf_init_with_format(vbo, &format);
+  /* Edit-mode updates often only move a few vertices, keep the data around so only the changed
+   * ranges are uploaded on the next update, see #DRW_mesh_batch_cache_validate. */
+  GPU_vertbuf_init_with_format_ex(
+      vbo, &format, (mr->edit_bmesh != NULL) ? GPU_USAGE_DYNAMIC : GPU_USAGE_STATIC);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
 
   /* Pack normals per vert, reduce amount of computation. */
@@ -2106,7 +2391,10 @@ static void *extract_pos_nor_hq_init(const MeshRenderData *mr,
     GPU_vertformat_alias_add(&format, "vnor");
   }
   GPUVertBuf *vbo = buf;
-  GPU_vertbuf_init_with_format(vbo, &format);
+  /* Edit-mode updates often only move a few vertices, keep the data around so only the changed
+   * ranges are uploaded on the next update, see #DRW_mesh_batch_cache_validate. */
+  GPU_vertbuf_init_with_format_ex(
+      vbo, &format, (mr->edit_bmesh != NULL) ? GPU_USAGE_DYNAMIC : GPU_USAGE_STATIC);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
 
   /* Pack normals per vert, reduce amount of computation. */
@@ -5503,6 +5791,9 @@ static const MeshExtract extract_fdot_idx = {
  * \{ */
 typedef struct ExtractUserData {
   void *user_data;
+  /** Data of every range task, see #MeshExtract.task_init. */
+  void **task_user_datas;
+  int task_len;
 } ExtractUserData;
 
 typedef enum ExtractTaskDataType {
@@ -5518,6 +5809,8 @@ typedef struct ExtractTaskData {
   ExtractTaskDataType tasktype;
   eMRIterType iter_type;
   int start, end;
+  /** Index of the range task in #ExtractUserData.task_user_datas. */
+  int task_index;
   /** Decremented each time a task is finished. */
   int32_t *task_counter;
   void *buf;
@@ -5550,6 +5843,7 @@ static ExtractTaskData *extract_task_data_create_mesh_extract(const MeshRenderDa
   taskdata->task_counter = task_counter;
   taskdata->start = 0;
   taskdata->end = INT_MAX;
+  taskdata->task_index = 0;
   return taskdata;
 }
 
@@ -5566,7 +5860,10 @@ static ExtractTaskData *extract_task_data_create_lines_loose(const MeshRenderDat
 static void extract_task_data_free(void *data)
 {
   ExtractTaskData *task_data = data;
-  MEM_SAFE_FREE(task_data->user_data);
+  if (task_data->user_data) {
+    MEM_SAFE_FREE(task_data->user_data->task_user_datas);
+    MEM_freeN(task_data->user_data);
+  }
   MEM_freeN(task_data);
 }
 
@@ -5659,17 +5956,40 @@ static void extract_run(void *__restrict taskdata)
 {
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
   if (data->tasktype == EXTRACT_MESH_EXTRACT) {
-    mesh_extract_iter(data->mr,
-                      data->iter_type,
-                      data->start,
-                      data->end,
-                      data->extract,
-                      data->user_data->user_data);
+    const MeshExtract *extract = data->extract;
+    ExtractUserData *user_data = data->user_data;
+
+    void *task_user_data = user_data->user_data;
+    if (extract->task_init) {
+      task_user_data = extract->task_init(
+          data->mr, data->iter_type, data->start, user_data->user_data);
+    }
+
+    mesh_extract_iter(
+        data->mr, data->iter_type, data->start, data->end, extract, task_user_data);
+
+    if (extract->task_init) {
+      if (user_data->task_user_datas) {
+        user_data->task_user_datas[data->task_index] = task_user_data;
+      }
+      else {
+        /* Not split in range tasks. */
+        extract->task_finish(data->mr, user_data->user_data, task_user_data);
+      }
+    }
 
     /* If this is the last task, we do the finish function. */
     int remainin_tasks = atomic_sub_and_fetch_int32(data->task_counter, 1);
-    if (remainin_tasks == 0 && data->extract->finish != NULL) {
-      data->extract->finish(data->mr, data->cache, data->buf, data->user_data->user_data);
+    if (remainin_tasks == 0) {
+      if (user_data->task_user_datas) {
+        /* Merge in task order to keep the result independent of the scheduling. */
+        for (int i = 0; i < user_data->task_len; i++) {
+          extract->task_finish(data->mr, user_data->user_data, user_data->task_user_datas[i]);
+        }
+      }
+      if (extract->finish != NULL) {
+        extract->finish(data->mr, data->cache, data->buf, user_data->user_data);
+      }
     }
   }
   else if (data->tasktype == EXTRACT_LINES_LOOSE) {
@@ -5823,8 +6143,10 @@ static void extract_range_task_create(struct TaskGraph *task_graph,
                                       int start,
                                       int length)
 {
+  const int task_index = taskdata->user_data->task_len++;
   taskdata = MEM_dupallocN(taskdata);
   atomic_add_and_fetch_int32(taskdata->task_counter, 1);
+  taskdata->task_index = task_index;
   taskdata->iter_type = type;
   taskdata->start = start;
   taskdata->end = start + length;
@@ -5868,7 +6190,7 @@ static void extract_task_create(struct TaskGraph *task_graph,
       mr, cache, extract, buf, task_counter);
 
   /* Simple heuristic. */
-  const int chunk_size = 8192;
+  const int chunk_size = EXTRACT_RANGE_LEN;
   const bool use_thread = (mr->loop_len + mr->loop_loose_len) > chunk_size;
   if (use_thread && extract->use_threading) {
 
@@ -5897,6 +6219,10 @@ static void extract_task_create(struct TaskGraph *task_graph,
             task_graph, task_node_user_data_init, taskdata, MR_ITER_LVERT, i, chunk_size);
       }
     }
+    if (extract->task_init && taskdata->user_data->task_len > 0) {
+      ExtractUserData *user_data = taskdata->user_data;
+      user_data->task_user_datas = MEM_callocN(sizeof(void *) * user_data->task_len, __func__);
+    }
     BLI_addtail(user_data_init_task_datas, taskdata);
   }
   else if (use_thread) {
@@ -5998,6 +6324,11 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   TEST_ASSIGN(VBO, vbo, skin_roots);
 
   TEST_ASSIGN(IBO, ibo, tris);
+  for (int lod = 0; lod < MBC_LOD_LEN; lod++) {
+    if (DRW_TEST_ASSIGN_IBO(mbc.ibo.tris_lod[lod])) {
+      iter_flag |= mesh_extract_iter_type(extract_tris_lod[lod]);
+    }
+  }
   TEST_ASSIGN(IBO, ibo, lines);
   TEST_ASSIGN(IBO, ibo, points);
   TEST_ASSIGN(IBO, ibo, fdots);
@@ -6092,6 +6423,21 @@ void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   EXTRACT(vbo, skin_roots);
 
   EXTRACT(ibo, tris);
+  for (int lod = 0; lod < MBC_LOD_LEN; lod++) {
+    if (mbc.ibo.tris_lod[lod]) {
+      extract_task_create(task_graph,
+                          task_node_mesh_render_data,
+                          task_node_user_data_init,
+                          &single_threaded_task_data->task_datas,
+                          &user_data_init_task_data->task_datas,
+                          scene,
+                          mr,
+                          cache,
+                          extract_tris_lod[lod],
+                          mbc.ibo.tris_lod[lod],
+                          &task_counters[counter_used++]);
+    }
+  }
   if (mbc.ibo.lines) {
     /* When `lines` and `lines_loose` are requested, schedule lines extraction that also creates
      * the `lines_loose` sub-buffer. */
@@ -294,40 +294,57 @@ BLI_INLINE int32_t pack_rotation_aspect_hardness(float rot, float asp, float har
   return packed;
 }
 
+/* Vertex data shared by all points of a stroke. */
+typedef struct gpStrokeVertCommon {
+  bool round_cap0;
+  bool round_cap1;
+  int mat;
+  float fcol[4];
+  float aspect_ratio;
+} gpStrokeVertCommon;
+
+static void gpencil_buffer_stroke_common_init(gpStrokeVertCommon *common, const bGPDstroke *gps)
+{
+  /* Note: we use the sign of strength and thickness to pass cap flag. */
+  common->round_cap0 = (gps->caps[0] == GP_STROKE_CAP_ROUND);
+  common->round_cap1 = (gps->caps[1] == GP_STROKE_CAP_ROUND);
+  common->mat = gps->mat_nr % GP_MATERIAL_BUFFER_LEN;
+  copy_v4_v4(common->fcol, gps->vert_color_fill);
+
+  /* Encode fill opacity defined by opacity modifier in vertex color alpha. If
+   * no opacity modifier, the value will be always 1.0f. The opacity factor can be any
+   * value between 0.0f and 2.0f */
+  common->fcol[3] = (((int)(common->fcol[3] * 10000.0f)) * 10.0f) + gps->fill_opacity_fac;
+
+  common->aspect_ratio = gps->aspect_ratio[0] / max_ff(gps->aspect_ratio[1], 1e-8);
+}
+
 static void gpencil_buffer_add_point(gpStrokeVert *verts,
                                      gpColorVert *cols,
                                      const bGPDstroke *gps,
+                                     const gpStrokeVertCommon *common,
                                      const bGPDspoint *pt,
                                      int v,
                                      bool is_endpoint)
 {
-  /* Note: we use the sign of strength and thickness to pass cap flag. */
-  const bool round_cap0 = (gps->caps[0] == GP_STROKE_CAP_ROUND);
-  const bool round_cap1 = (gps->caps[1] == GP_STROKE_CAP_ROUND);
   gpStrokeVert *vert = &verts[v];
   gpColorVert *col = &cols[v];
   copy_v3_v3(vert->pos, &pt->x);
   copy_v2_v2(vert->uv_fill, pt->uv_fill);
   copy_v4_v4(col->vcol, pt->vert_color);
-  copy_v4_v4(col->fcol, gps->vert_color_fill);
-
-  /* Encode fill opacity defined by opacity modifier in vertex color alpha. If
-   * no opacity modifier, the value will be always 1.0f. The opacity factor can be any
-   * value between 0.0f and 2.0f */
-  col->fcol[3] = (((int)(col->fcol[3] * 10000.0f)) * 10.0f) + gps->fill_opacity_fac;
+  copy_v4_v4(col->fcol, common->fcol);
 
-  vert->strength = (round_cap0) ? pt->strength : -pt->strength;
+  vert->strength = (common->round_cap0) ? pt->strength : -pt->strength;
   vert->u_stroke = pt->uv_fac;
   vert->stroke_id = gps->runtime.stroke_start;
   vert->point_id = v;
-  vert->thickness = max_ff(0.0f, gps->thickness * pt->pressure) * (round_cap1 ? 1.0f : -1.0f);
+  vert->thickness = max_ff(0.0f, gps->thickness * pt->pressure) *
+                    (common->round_cap1 ? 1.0f : -1.0f);
   /* Tag endpoint material to -1 so they get discarded by vertex shader. */
-  vert->mat = (is_endpoint) ? -1 : (gps->mat_nr % GP_MATERIAL_BUFFER_LEN);
-
-  float aspect_ratio = gps->aspect_ratio[0] / max_ff(gps->aspect_ratio[1], 1e-8);
+  vert->mat = (is_endpoint) ? -1 : common->mat;
 
   vert->packed_asp_hard_rot = pack_rotation_aspect_hardness(
-      pt->uv_rot, aspect_ratio, gps->hardeness);
+      pt->uv_rot, common->aspect_ratio, gps->hardeness);
 }
 
 static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
@@ -339,20 +356,23 @@ static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
   bool is_cyclic = gpencil_stroke_is_cyclic(gps);
   int v = gps->runtime.stroke_start;
 
+  gpStrokeVertCommon common;
+  gpencil_buffer_stroke_common_init(&common, gps);
+
   /* First point for adjacency (not drawn). */
   int adj_idx = (is_cyclic) ? (pts_len - 1) : min_ii(pts_len - 1, 1);
-  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(verts, cols, gps, &common, &pts[adj_idx], v++, true);
 
   for (int i = 0; i < pts_len; i++) {
-    gpencil_buffer_add_point(verts, cols, gps, &pts[i], v++, false);
+    gpencil_buffer_add_point(verts, cols, gps, &common, &pts[i], v++, false);
   }
   /* Draw line to first point to complete the loop for cyclic strokes. */
   if (is_cyclic) {
-    gpencil_buffer_add_point(verts, cols, gps, &pts[0], v++, false);
+    gpencil_buffer_add_point(verts, cols, gps, &common, &pts[0], v++, false);
   }
   /* Last adjacency point (not drawn). */
   adj_idx = (is_cyclic) ? 1 : max_ii(0, pts_len - 2);
-  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(verts, cols, gps, &common, &pts[adj_idx], v++, true);
 }
 
 static void gpencil_buffer_add_fill(GPUIndexBufBuilder *ibo, const bGPDstroke *gps)
@@ -511,8 +511,27 @@ static void mesh_batch_cache_init(Mesh *me)
 void DRW_mesh_batch_cache_validate(Mesh *me)
 {
   if (!mesh_batch_cache_valid(me)) {
+    MeshBatchCache *cache = me->runtime.batch_cache;
+    /* Edit-mode updates usually keep the size of the buffers and only change a few elements.
+     * Keep the GPU storage of the positions so only the changed ranges are uploaded again. */
+    GPUVertBuf *pos_nor_final = NULL, *pos_nor_cage = NULL;
+    if (cache && cache->is_editmode && me->edit_mesh != NULL) {
+      SWAP(GPUVertBuf *, pos_nor_final, cache->final.vbo.pos_nor);
+      SWAP(GPUVertBuf *, pos_nor_cage, cache->cage.vbo.pos_nor);
+    }
+
     mesh_batch_cache_clear(me);
     mesh_batch_cache_init(me);
+
+    cache = me->runtime.batch_cache;
+    if (pos_nor_final) {
+      GPU_vertbuf_clear_keep_storage(pos_nor_final);
+      cache->final.vbo.pos_nor = pos_nor_final;
+    }
+    if (pos_nor_cage) {
+      GPU_vertbuf_clear_keep_storage(pos_nor_cage);
+      cache->cage.vbo.pos_nor = pos_nor_cage;
+    }
   }
 }
 
@@ -551,7 +570,10 @@ static void mesh_batch_cache_discard_surface_batches(MeshBatchCache *cache)
   for (int i = 0; i < cache->mat_len; i++) {
     GPU_BATCH_DISCARD_SAFE(cache->surface_per_mat[i]);
   }
-  cache->batch_ready &= ~MBC_SURFACE;
+  for (int lod = 0; lod < MBC_LOD_LEN; lod++) {
+    GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod[lod]);
+  }
+  cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD);
 }
 
 static void mesh_batch_cache_discard_shaded_tri(MeshBatchCache *cache)
@@ -798,6 +820,14 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return cache->batch.surface;
 }
 
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me, int lod)
+{
+  BLI_assert(lod >= 0 && lod < MBC_LOD_LEN);
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod[lod]);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1229,7 +1259,7 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   }
 
   if (batch_requested &
-      (MBC_SURFACE | MBC_WIRE_LOOPS_UVS | MBC_EDITUV_FACES_STRETCH_AREA |
+      (MBC_SURFACE | MBC_SURFACE_LOD | MBC_WIRE_LOOPS_UVS | MBC_EDITUV_FACES_STRETCH_AREA |
        MBC_EDITUV_FACES_STRETCH_ANGLE | MBC_EDITUV_FACES | MBC_EDITUV_EDGES | MBC_EDITUV_VERTS)) {
     /* Modifiers will only generate an orco layer if the mesh is deformed. */
     if (cache->cd_needed.orco != 0) {
@@ -1274,7 +1304,10 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
         GPU_BATCH_CLEAR_SAFE(cache->surface_per_mat[i]);
       }
       GPU_BATCH_CLEAR_SAFE(cache->batch.surface);
-      cache->batch_ready &= ~(MBC_SURFACE);
+      for (int lod = 0; lod < MBC_LOD_LEN; lod++) {
+        GPU_BATCH_CLEAR_SAFE(cache->batch.surface_lod[lod]);
+      }
+      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD);
 
       mesh_cd_layers_type_merge(&cache->cd_used, cache->cd_needed);
     }
@@ -1350,6 +1383,21 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
       DRW_vbo_request(cache->batch.surface, &mbufcache->vbo.vcol);
     }
   }
+  for (int lod = 0; lod < MBC_LOD_LEN; lod++) {
+    GPUBatch *batch = cache->batch.surface_lod[lod];
+    if (DRW_batch_requested(batch, GPU_PRIM_TRIS)) {
+      DRW_ibo_request(batch, &mbufcache->ibo.tris_lod[lod]);
+      /* Same attributes as the full resolution surface. */
+      DRW_vbo_request(batch, &mbufcache->vbo.lnor);
+      DRW_vbo_request(batch, &mbufcache->vbo.pos_nor);
+      if (cache->cd_used.uv != 0) {
+        DRW_vbo_request(batch, &mbufcache->vbo.uv);
+      }
+      if (cache->cd_used.vcol != 0 || cache->cd_used.sculpt_vcol != 0) {
+        DRW_vbo_request(batch, &mbufcache->vbo.vcol);
+      }
+    }
+  }
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbufcache->vbo.pos_nor);
   }
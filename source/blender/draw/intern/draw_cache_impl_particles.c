@@ -30,6 +30,7 @@
 #include "BLI_ghash.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_customdata_types.h"
@@ -607,36 +608,78 @@ static int particle_batch_cache_fill_segments(ParticleSystem *psys,
   return curr_point;
 }
 
+typedef struct ParticleProcPosData {
+  ParticleCacheKey **path_cache;
+  /** First point of each path in the buffer. */
+  const int *path_point_offsets;
+  unsigned char *data;
+  uint stride;
+} ParticleProcPosData;
+
+static void particle_batch_cache_fill_segments_proc_pos_fn(
+    void *__restrict userdata, const int i, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ParticleProcPosData *data = userdata;
+  ParticleCacheKey *path = data->path_cache[i];
+  if (path->segments <= 0) {
+    return;
+  }
+  unsigned char *path_data = data->data + (size_t)data->path_point_offsets[i] * data->stride;
+  float total_len = 0.0f;
+  float *co_prev = NULL;
+  for (int j = 0; j <= path->segments; j++) {
+    float *seg_data = (float *)(path_data + (size_t)j * data->stride);
+    copy_v3_v3(seg_data, path[j].co);
+    if (co_prev) {
+      total_len += len_v3v3(co_prev, path[j].co);
+    }
+    seg_data[3] = total_len;
+    co_prev = path[j].co;
+  }
+  if (total_len > 0.0f) {
+    /* Divide by total length to have a [0-1] number. */
+    for (int j = 0; j <= path->segments; j++) {
+      float *seg_data = (float *)(path_data + (size_t)j * data->stride);
+      seg_data[3] /= total_len;
+    }
+  }
+}
+
 static void particle_batch_cache_fill_segments_proc_pos(ParticleCacheKey **path_cache,
                                                         const int num_path_keys,
                                                         GPUVertBufRaw *attr_step)
 {
+  if (num_path_keys <= 0) {
+    return;
+  }
+  /* The points of each path are written at known offsets, so that the paths, which can be
+   * millions with children, are filled in parallel. */
+  int *path_point_offsets = MEM_malloc_arrayN(num_path_keys, sizeof(int), __func__);
+  int point_len = 0;
   for (int i = 0; i < num_path_keys; i++) {
-    ParticleCacheKey *path = path_cache[i];
-    if (path->segments <= 0) {
-      continue;
-    }
-    float total_len = 0.0f;
-    float *co_prev = NULL, *seg_data_first;
-    for (int j = 0; j <= path->segments; j++) {
-      float *seg_data = (float *)GPU_vertbuf_raw_step(attr_step);
-      copy_v3_v3(seg_data, path[j].co);
-      if (co_prev) {
-        total_len += len_v3v3(co_prev, path[j].co);
-      }
-      else {
-        seg_data_first = seg_data;
-      }
-      seg_data[3] = total_len;
-      co_prev = path[j].co;
-    }
-    if (total_len > 0.0f) {
-      /* Divide by total length to have a [0-1] number. */
-      for (int j = 0; j <= path->segments; j++, seg_data_first += 4) {
-        seg_data_first[3] /= total_len;
-      }
+    path_point_offsets[i] = point_len;
+    if (path_cache[i]->segments > 0) {
+      point_len += path_cache[i]->segments + 1;
     }
   }
+
+  ParticleProcPosData data = {
+      .path_cache = path_cache,
+      .path_point_offsets = path_point_offsets,
+      .data = attr_step->data,
+      .stride = attr_step->stride,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, num_path_keys, &data, particle_batch_cache_fill_segments_proc_pos_fn, &settings);
+
+  MEM_freeN(path_point_offsets);
+
+  /* Advance past the written points, like stepping through every point would. */
+  attr_step->data += (size_t)point_len * attr_step->stride;
+  BLI_assert(attr_step->data <= attr_step->_data_end);
 }
 
 static float particle_key_weight(const ParticleData *particle, int strand, float t)
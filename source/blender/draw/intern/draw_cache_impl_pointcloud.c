@@ -29,6 +29,7 @@
 
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -148,6 +149,22 @@ void DRW_pointcloud_batch_cache_free(PointCloud *pointcloud)
   MEM_SAFE_FREE(pointcloud->batch_cache);
 }
 
+typedef struct PointCloudPosRadiusData {
+  const PointCloud *pointcloud;
+  float (*vbo_data)[4];
+} PointCloudPosRadiusData;
+
+static void pointcloud_pos_radius_fill_fn(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PointCloudPosRadiusData *data = userdata;
+  copy_v3_v3(data->vbo_data[i], data->pointcloud->co[i]);
+  /* TODO(fclem): remove multiplication here.
+   * Here only for keeping the size correct for now. */
+  data->vbo_data[i][3] = data->pointcloud->radius[i] * 100.0f;
+}
+
 static void pointcloud_batch_cache_ensure_pos(Object *ob, PointCloudBatchCache *cache)
 {
   if (cache->pos != NULL) {
@@ -176,13 +193,16 @@ static void pointcloud_batch_cache_ensure_pos(Object *ob, PointCloudBatchCache *
   GPU_vertbuf_data_alloc(cache->pos, pointcloud->totpoint);
 
   if (has_radius) {
-    float(*vbo_data)[4] = (float(*)[4])GPU_vertbuf_get_data(cache->pos);
-    for (int i = 0; i < pointcloud->totpoint; i++) {
-      copy_v3_v3(vbo_data[i], pointcloud->co[i]);
-      /* TODO(fclem): remove multiplication here.
-       * Here only for keeping the size correct for now. */
-      vbo_data[i][3] = pointcloud->radius[i] * 100.0f;
-    }
+    /* Point clouds can have many millions of points, fill the buffer in parallel. */
+    PointCloudPosRadiusData data = {
+        .pointcloud = pointcloud,
+        .vbo_data = (float(*)[4])GPU_vertbuf_get_data(cache->pos),
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 4096;
+    BLI_task_parallel_range(
+        0, pointcloud->totpoint, &data, pointcloud_pos_radius_fill_fn, &settings);
   }
   else {
     GPU_vertbuf_attr_fill(cache->pos, pos, pointcloud->co);
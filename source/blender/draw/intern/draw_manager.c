@@ -29,6 +29,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -1535,6 +1536,8 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   ViewLayer *view_layer = DEG_get_evaluated_view_layer(depsgraph);
   RegionView3D *rv3d = region->regiondata;
 
+  BLI_trace_zone_begin("Draw Viewport");
+
   DST.draw_ctx.evil_C = evil_C;
   DST.viewport = viewport;
   /* Setup viewport */
@@ -1659,6 +1662,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* Avoid accidental reuse. */
   drw_state_ensure_not_reused(&DST);
 #endif
+  BLI_trace_zone_end();
 }
 
 void DRW_draw_render_loop(struct Depsgraph *depsgraph,
@@ -86,6 +86,88 @@ static void draw_call_sort(DRWCommand *array, DRWCommand *array_tmp, int array_l
   memcpy(array, array_tmp, sizeof(*array) * array_len);
 }
 
+typedef struct DRWCallSortItem {
+  uintptr_t batch;
+  uint32_t resource_chunk;
+  uint32_t neg_scale;
+  /** Original position, keeps the order of the resource ID's of the same batch. */
+  int index;
+} DRWCallSortItem;
+
+static int draw_call_sort_item_cmp(const void *a_, const void *b_)
+{
+  const DRWCallSortItem *a = a_;
+  const DRWCallSortItem *b = b_;
+  if (a->resource_chunk != b->resource_chunk) {
+    return (a->resource_chunk < b->resource_chunk) ? -1 : 1;
+  }
+  if (a->neg_scale != b->neg_scale) {
+    return (a->neg_scale < b->neg_scale) ? -1 : 1;
+  }
+  if (a->batch != b->batch) {
+    return (a->batch < b->batch) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : (a->index > b->index);
+}
+
+/**
+ * Sort the draw calls of shading groups spanning multiple command chunks, which #draw_call_sort
+ * can only sort per chunk. Calls of the same batch and resource chunk become adjacent so they
+ * are merged into the same multi-draw-indirect list during drawing, even when objects using
+ * different batches were added one after the other.
+ */
+static void draw_shgroup_calls_sort(DRWShadingGroup *shgroup)
+{
+  DRWCommandChunk *first = shgroup->cmd.first;
+  if (first == NULL || first->next == NULL) {
+    return;
+  }
+
+  int calls_len = 0;
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    /* We can only sort chunks that contain #DRWCommandDraw only. */
+    for (int i = 0; i < ARRAY_SIZE(chunk->command_type); i++) {
+      if (chunk->command_type[i] != 0) {
+        return;
+      }
+    }
+    calls_len += chunk->command_used;
+  }
+
+  DRWCallSortItem *items = MEM_mallocN(sizeof(*items) * calls_len, __func__);
+  DRWCommand *calls = MEM_mallocN(sizeof(*calls) * calls_len, __func__);
+
+  int index = 0;
+  bool is_sorted = true;
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    for (int i = 0; i < chunk->command_used; i++, index++) {
+      const DRWCommandDraw *call = &chunk->commands[i].draw;
+      DRWCallSortItem *item = &items[index];
+      item->batch = (uintptr_t)call->batch;
+      item->resource_chunk = DRW_handle_chunk_get(&call->handle);
+      item->neg_scale = DRW_handle_negative_scale_get(&call->handle);
+      item->index = index;
+      calls[index] = chunk->commands[i];
+      if (index > 0 && draw_call_sort_item_cmp(&items[index - 1], item) > 0) {
+        is_sorted = false;
+      }
+    }
+  }
+
+  if (!is_sorted) {
+    qsort(items, calls_len, sizeof(*items), draw_call_sort_item_cmp);
+    index = 0;
+    for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+      for (int i = 0; i < chunk->command_used; i++, index++) {
+        chunk->commands[i] = calls[items[index].index];
+      }
+    }
+  }
+
+  MEM_freeN(items);
+  MEM_freeN(calls);
+}
+
 void drw_resource_buffer_finish(ViewportMemoryPool *vmempool)
 {
   int chunk_id = DRW_handle_chunk_get(&DST.resource_handle);
@@ -148,6 +230,12 @@ void drw_resource_buffer_finish(ViewportMemoryPool *vmempool)
     }
   }
   MEM_freeN(chunk_tmp);
+
+  DRWShadingGroup *shgroup;
+  BLI_memblock_iternew(vmempool->shgroups, &iter);
+  while ((shgroup = BLI_memblock_iterstep(&iter))) {
+    draw_shgroup_calls_sort(shgroup);
+  }
 }
 
 /** \} */
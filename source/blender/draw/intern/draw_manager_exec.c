@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -485,20 +486,17 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
-static void draw_compute_culling(DRWView *view)
+static void draw_compute_culling_chunk(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  view = view->parent ? view->parent : view;
+  DRWView *view = userdata;
+  const int elem_len = (chunk == DRW_handle_chunk_get(&DST.resource_handle)) ?
+                           DRW_handle_id_get(&DST.resource_handle) :
+                           DRW_RESOURCE_CHUNK_LEN;
 
-  /* TODO(fclem): multi-thread this. */
-  /* TODO(fclem): compute all dirty views at once. */
-  if (!view->is_dirty) {
-    return;
-  }
-
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
+  for (int elem = 0; elem < elem_len; elem++) {
+    DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, elem);
     if (cull->bsphere.radius < 0.0) {
       cull->mask = 0;
     }
@@ -526,6 +524,30 @@ static void draw_compute_culling(DRWView *view)
       SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
     }
   }
+}
+
+static void draw_compute_culling(DRWView *view)
+{
+  view = view->parent ? view->parent : view;
+
+  /* TODO(fclem): compute all dirty views at once. */
+  if (!view->is_dirty) {
+    return;
+  }
+
+  /* Culling states are allocated in chunks of #DRW_RESOURCE_CHUNK_LEN, one per resource
+   * handle. Each chunk is tested on its own thread. */
+  const int chunk_len = DRW_handle_chunk_get(&DST.resource_handle) +
+                        ((DRW_handle_id_get(&DST.resource_handle) > 0) ? 1 : 0);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+#ifdef DRW_DEBUG_CULLING
+  /* Debug drawing isn't thread-safe. */
+  settings.use_threading = false;
+#endif
+  BLI_task_parallel_range(0, chunk_len, view, draw_compute_culling_chunk, &settings);
 
   view->is_dirty = false;
 }
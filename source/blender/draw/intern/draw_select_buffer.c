@@ -527,6 +527,14 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 {
   struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
+  /* Keep the ID buffer of the previous context when the same objects are drawn the same way.
+   * The engine still redraws it when the view changes or when drawn objects are updated. */
+  bool is_same_context = (select_ctx->objects_len == bases_len) &&
+                         (select_ctx->select_mode == select_mode) && (select_mode != -1);
+  for (uint base_index = 0; is_same_context && base_index < bases_len; base_index++) {
+    is_same_context = select_ctx->objects[base_index] == bases[base_index]->object;
+  }
+
   select_ctx->objects = MEM_reallocN(select_ctx->objects,
                                      sizeof(*select_ctx->objects) * bases_len);
 
@@ -546,6 +554,8 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 
   select_ctx->objects_len = bases_len;
   select_ctx->select_mode = select_mode;
-  memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  if (!is_same_context) {
+    memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  }
 }
 /** \} */
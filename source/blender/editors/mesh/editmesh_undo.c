@@ -68,7 +68,7 @@
 #  define USE_ARRAY_STORE_THREAD
 #endif
 
-#ifdef USE_ARRAY_STORE_THREAD
+#ifdef USE_ARRAY_STORE
 #  include "BLI_task.h"
 #endif
 
@@ -416,14 +416,39 @@ static void um_arraystore_expand_clear(UndoMesh *um)
   um_arraystore_compact_ex(um, NULL, false);
 }
 
+static void um_arraystore_expand_cd_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  UndoMesh *um = userdata;
+  Mesh *me = &um->me;
+
+  switch (i) {
+    case 0:
+      um_arraystore_cd_expand(um->store.vdata, &me->vdata, me->totvert);
+      break;
+    case 1:
+      um_arraystore_cd_expand(um->store.edata, &me->edata, me->totedge);
+      break;
+    case 2:
+      um_arraystore_cd_expand(um->store.ldata, &me->ldata, me->totloop);
+      break;
+    case 3:
+      um_arraystore_cd_expand(um->store.pdata, &me->pdata, me->totpoly);
+      break;
+  }
+}
+
 static void um_arraystore_expand(UndoMesh *um)
 {
   Mesh *me = &um->me;
 
-  um_arraystore_cd_expand(um->store.vdata, &me->vdata, me->totvert);
-  um_arraystore_cd_expand(um->store.edata, &me->edata, me->totedge);
-  um_arraystore_cd_expand(um->store.ldata, &me->ldata, me->totloop);
-  um_arraystore_cd_expand(um->store.pdata, &me->pdata, me->totpoly);
+  /* Reading the array store doesn't modify it, so the custom-data of each element type can be
+   * expanded at once. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (me->totloop > 10000);
+  BLI_task_parallel_range(0, 4, um, um_arraystore_expand_cd_cb, &settings);
 
   if (um->store.keyblocks) {
     const size_t stride = me->key->elemsize;
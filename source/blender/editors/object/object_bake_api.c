@@ -1157,7 +1157,19 @@ static void bake_targets_free(BakeTargets *targets)
 
 /* Main Bake Logic */
 
+/* We build a depsgraph for the baking,
+ * so we don't need to change the original data to adjust visibility and modifiers.
+ * When baking multiple objects to their own targets the depsgraph is shared between them, so
+ * the scene is only evaluated once and render engines can keep their scene data in between. */
+static Depsgraph *bake_depsgraph_new(const BakeAPIRender *bkr)
+{
+  Depsgraph *depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(depsgraph);
+  return depsgraph;
+}
+
 static int bake(const BakeAPIRender *bkr,
+                Depsgraph *depsgraph,
                 Object *ob_low,
                 const ListBase *selected_objects,
                 ReportList *reports)
@@ -1165,12 +1177,6 @@ static int bake(const BakeAPIRender *bkr,
   Render *re = bkr->render;
   Main *bmain = bkr->main;
   Scene *scene = bkr->scene;
-  ViewLayer *view_layer = bkr->view_layer;
-
-  /* We build a depsgraph for the baking,
-   * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1255,6 +1261,8 @@ static int bake(const BakeAPIRender *bkr,
     if (mmd_low) {
       mmd_flags_low = mmd_low->flags;
       mmd_low->uv_smooth = SUBSURF_UV_SMOOTH_NONE;
+      /* The depsgraph may already be evaluated for a previously baked object. */
+      DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
     }
   }
 
@@ -1517,6 +1525,7 @@ cleanup:
 
   if (mmd_low) {
     mmd_low->flags = mmd_flags_low;
+    DEG_id_tag_update(&ob_low->id, ID_RECALC_GEOMETRY);
   }
 
   if (pixel_array_low) {
@@ -1537,8 +1546,6 @@ cleanup:
     BKE_id_free(NULL, &me_cage->id);
   }
 
-  DEG_graph_free(depsgraph);
-
   return op_result;
 }
 
@@ -1644,18 +1651,22 @@ static int bake_exec(bContext *C, wmOperator *op)
 
   RE_SetReports(re, bkr.reports);
 
+  Depsgraph *depsgraph = bake_depsgraph_new(&bkr);
+
   if (bkr.is_selected_to_active) {
-    result = bake(&bkr, bkr.ob, &bkr.selected_objects, bkr.reports);
+    result = bake(&bkr, depsgraph, bkr.ob, &bkr.selected_objects, bkr.reports);
   }
   else {
     CollectionPointerLink *link;
     bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
     for (link = bkr.selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      result = bake(&bkr, ob_iter, NULL, bkr.reports);
+      result = bake(&bkr, depsgraph, ob_iter, NULL, bkr.reports);
     }
   }
 
+  DEG_graph_free(depsgraph);
+
   RE_SetReports(re, NULL);
 
 finally:
@@ -1696,22 +1707,27 @@ static void bake_startjob(void *bkv, short *UNUSED(stop), short *do_update, floa
     bake_targets_clear(bkr->main, is_tangent);
   }
 
+  Depsgraph *depsgraph = bake_depsgraph_new(bkr);
+
   if (bkr->is_selected_to_active) {
-    bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, bkr->reports);
+    bkr->result = bake(bkr, depsgraph, bkr->ob, &bkr->selected_objects, bkr->reports);
   }
   else {
     CollectionPointerLink *link;
     bkr->is_clear = bkr->is_clear && BLI_listbase_is_single(&bkr->selected_objects);
     for (link = bkr->selected_objects.first; link; link = link->next) {
       Object *ob_iter = link->ptr.data;
-      bkr->result = bake(bkr, ob_iter, NULL, bkr->reports);
+      bkr->result = bake(bkr, depsgraph, ob_iter, NULL, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
+        DEG_graph_free(depsgraph);
         return;
       }
     }
   }
 
+  DEG_graph_free(depsgraph);
+
   RE_SetReports(bkr->render, NULL);
 }
 
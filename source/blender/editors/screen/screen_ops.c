@@ -4544,6 +4544,10 @@ static int screen_animation_step_invoke(bContext *C, wmOperator *UNUSED(op), con
 
   /* since we follow drawflags, we can't send notifier but tag regions ourselves */
   if (depsgraph != NULL) {
+    if (U.experimental.use_playback_prefetch) {
+      DEG_playback_prefetch_update(
+          depsgraph, scene->r.cfra, (sad->flag & ANIMPLAY_FLAG_REVERSE) ? -1 : 1);
+    }
     ED_update_for_newframe(bmain, depsgraph);
   }
 
@@ -4643,6 +4647,7 @@ int ED_screen_animation_play(bContext *C, int sync, int mode)
     /* stop playback now */
     ED_screen_animation_timer(C, 0, 0, 0);
     BKE_sound_stop_scene(scene_eval);
+    DEG_playback_prefetch_stop_all(CTX_data_main(C));
 
     WM_event_add_notifier(C, NC_SCENE | ND_FRAME, scene);
   }
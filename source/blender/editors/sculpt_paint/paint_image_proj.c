@@ -3782,54 +3782,86 @@ static void proj_paint_state_viewport_init(ProjPaintState *ps, const char symmet
   add_v3_v3(ps->viewPos, ps->obmat_imat[3]);
 }
 
-static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
+typedef struct ProjPaintScreenCoordsMinMax {
+  float min[2], max[2];
+} ProjPaintScreenCoordsMinMax;
+
+static void proj_paint_state_screen_coords_init_fn(void *__restrict userdata,
+                                                   const int a,
+                                                   const TaskParallelTLS *__restrict tls)
 {
-  const MVert *mv;
-  float *projScreenCo;
-  float projMargin;
-  int a;
+  const ProjPaintState *ps = userdata;
+  ProjPaintScreenCoordsMinMax *minmax = tls->userdata_chunk;
+  const MVert *mv = &ps->mvert_eval[a];
+  float *projScreenCo = ps->screenCoords[a];
 
-  INIT_MINMAX2(ps->screenMin, ps->screenMax);
+  if (ps->is_ortho) {
+    mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
 
-  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
-  projScreenCo = *ps->screenCoords;
+    /* screen space, not clamped */
+    projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
+    projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
+    minmax_v2v2_v2(minmax->min, minmax->max, projScreenCo);
+  }
+  else {
+    copy_v3_v3(projScreenCo, mv->co);
+    projScreenCo[3] = 1.0f;
 
-  if (ps->is_ortho) {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
+    mul_m4_v4(ps->projectMat, projScreenCo);
 
+    if (projScreenCo[3] > ps->clip_start) {
       /* screen space, not clamped */
-      projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
-      projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
-      minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
+      projScreenCo[0] = (float)(ps->winx * 0.5f) +
+                        (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
+      projScreenCo[1] = (float)(ps->winy * 0.5f) +
+                        (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
+      /* Use the depth for bucket point occlusion */
+      projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
+      minmax_v2v2_v2(minmax->min, minmax->max, projScreenCo);
     }
-  }
-  else {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      copy_v3_v3(projScreenCo, mv->co);
-      projScreenCo[3] = 1.0f;
-
-      mul_m4_v4(ps->projectMat, projScreenCo);
-
-      if (projScreenCo[3] > ps->clip_start) {
-        /* screen space, not clamped */
-        projScreenCo[0] = (float)(ps->winx * 0.5f) +
-                          (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
-        projScreenCo[1] = (float)(ps->winy * 0.5f) +
-                          (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
-        /* Use the depth for bucket point occlusion */
-        projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
-        minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-      }
-      else {
-        /* TODO - deal with cases where 1 side of a face goes behind the view ?
-         *
-         * After some research this is actually very tricky, only option is to
-         * clip the derived mesh before painting, which is a Pain */
-        projScreenCo[0] = FLT_MAX;
-      }
+    else {
+      /* TODO - deal with cases where 1 side of a face goes behind the view ?
+       *
+       * After some research this is actually very tricky, only option is to
+       * clip the derived mesh before painting, which is a Pain */
+      projScreenCo[0] = FLT_MAX;
     }
   }
+}
+
+static void proj_paint_state_screen_coords_reduce(const void *__restrict UNUSED(userdata),
+                                                  void *__restrict chunk_join,
+                                                  void *__restrict chunk)
+{
+  ProjPaintScreenCoordsMinMax *join = chunk_join;
+  const ProjPaintScreenCoordsMinMax *minmax = chunk;
+  for (int i = 0; i < 2; i++) {
+    join->min[i] = min_ff(join->min[i], minmax->min[i]);
+    join->max[i] = max_ff(join->max[i], minmax->max[i]);
+  }
+}
+
+static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
+{
+  float projMargin;
+
+  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
+
+  /* Dense meshes are projected in parallel, to reduce the delay at the start of strokes. */
+  ProjPaintScreenCoordsMinMax minmax;
+  INIT_MINMAX2(minmax.min, minmax.max);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (ps->totvert_eval > 10000);
+  settings.userdata_chunk = &minmax;
+  settings.userdata_chunk_size = sizeof(minmax);
+  settings.func_reduce = proj_paint_state_screen_coords_reduce;
+  BLI_task_parallel_range(
+      0, ps->totvert_eval, ps, proj_paint_state_screen_coords_init_fn, &settings);
+
+  copy_v2_v2(ps->screenMin, minmax.min);
+  copy_v2_v2(ps->screenMax, minmax.max);
 
   /* If this border is not added we get artifacts for faces that
    * have a parallel edge and at the bounds of the 2D projected verts eg
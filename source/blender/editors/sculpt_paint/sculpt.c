@@ -2448,6 +2448,33 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   float rgba[4];
   float point[3];
 
+  /* Hardness. */
+  float final_len = len;
+  const float hardness = cache->paint_brush.hardness;
+  float p = len / cache->radius;
+  if (p < hardness) {
+    final_len = 0.0f;
+  }
+  else if (hardness == 1.0f) {
+    final_len = cache->radius;
+  }
+  else {
+    p = (p - hardness) / (1.0f - hardness);
+    final_len = p * cache->radius;
+  }
+
+  /* The factors not depending on the texture are evaluated first, so vertices they exclude
+   * (masked, auto-masked, facing away or outside of the falloff) don't sample the texture. */
+  const float curve_factor = BKE_brush_curve_strength(br, final_len, cache->radius);
+  const float frontface_factor = frontface(br, cache->view_normal, vno, fno);
+  const float mask_factor = 1.0f - mask;
+  const float automasking_factor = SCULPT_automasking_factor_get(
+      cache->automasking, ss, vertex_index);
+  if (curve_factor == 0.0f || frontface_factor == 0.0f || mask_factor == 0.0f ||
+      automasking_factor == 0.0f) {
+    return 0.0f;
+  }
+
   sub_v3_v3v3(point, brush_point, cache->plane_offset);
 
   if (!mtex->tex) {
@@ -2500,30 +2527,15 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
-  const float hardness = cache->paint_brush.hardness;
-  float p = len / cache->radius;
-  if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
-  }
-
   /* Falloff curve. */
-  avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
-  avg *= frontface(br, cache->view_normal, vno, fno);
+  avg *= curve_factor;
+  avg *= frontface_factor;
 
   /* Paint mask. */
-  avg *= 1.0f - mask;
+  avg *= mask_factor;
 
   /* Auto-masking. */
-  avg *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
+  avg *= automasking_factor;
 
   return avg;
 }
@@ -7701,6 +7713,9 @@ void SCULPT_flush_update_step(bContext *C, SculptUpdateType update_flags)
      * only the part of the 3D viewport where changes happened. */
     rcti r;
 
+    /* Nodes are updated at every step, only upload the parts of their buffers that changed. */
+    BKE_pbvh_draw_buffers_keep_data_set(ss->pbvh, true);
+
     if (update_flags & SCULPT_UPDATE_COORDS) {
       BKE_pbvh_update_bounds(ss->pbvh, PBVH_UpdateBB);
       /* Update the object's bounding box too so that the object
@@ -7785,6 +7800,8 @@ void SCULPT_flush_update_done(const bContext *C, Object *ob, SculptUpdateType up
     BKE_pbvh_bmesh_after_stroke(ss->pbvh);
   }
 
+  BKE_pbvh_draw_buffers_keep_data_set(ss->pbvh, false);
+
   /* Optimization: if there is locked key and active modifiers present in */
   /* the stack, keyblock is updating at each step. otherwise we could update */
   /* keyblock only when stroke is finished. */
@@ -45,6 +45,7 @@
 #include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_key.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_mesh.h"
 #include "BKE_multires.h"
@@ -1407,6 +1408,81 @@ void SCULPT_undo_push_end(void)
   SCULPT_undo_push_end_ex(false);
 }
 
+static void *sculpt_undo_array_shrink(UndoSculpt *usculpt, void *array, const size_t size)
+{
+  usculpt->undo_size -= MEM_allocN_len(array);
+  if (size == 0) {
+    MEM_freeN(array);
+    return NULL;
+  }
+  array = MEM_reallocN(array, size);
+  usculpt->undo_size += MEM_allocN_len(array);
+  return array;
+}
+
+/**
+ * Drop the vertices of a regular mesh coordinate or mask node that weren't changed since the node
+ * was pushed, swapping them on undo and redo wouldn't do anything.
+ *
+ * \note Only valid once the step won't be added to anymore, the original data of the stroke is
+ * looked up by the index of the vertex in the #PBVHNode.
+ */
+static void sculpt_undo_compact_node(UndoSculpt *usculpt, SculptUndoNode *unode)
+{
+  if (!ELEM(unode->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK) || unode->maxvert == 0 ||
+      unode->orig_co || unode->shapeName[0] != '\0') {
+    return;
+  }
+
+  Object *ob = (Object *)BKE_libblock_find_name(G_MAIN, ID_OB, unode->idname + 2);
+  SculptSession *ss = ob ? ob->sculpt : NULL;
+  if (ss == NULL || ss->bm || ss->totvert != unode->maxvert) {
+    return;
+  }
+
+  int totvert = 0;
+  if (unode->type == SCULPT_UNDO_COORDS) {
+    if (ss->mvert == NULL) {
+      return;
+    }
+    for (int i = 0; i < unode->totvert; i++) {
+      /* Compare memory as the restore does, see #test_swap_v3_v3. */
+      if (memcmp(ss->mvert[unode->index[i]].co, unode->co[i], sizeof(float[3])) != 0) {
+        unode->index[totvert] = unode->index[i];
+        copy_v3_v3(unode->co[totvert], unode->co[i]);
+        totvert++;
+      }
+    }
+  }
+  else {
+    if (ss->vmask == NULL) {
+      return;
+    }
+    for (int i = 0; i < unode->totvert; i++) {
+      if (ss->vmask[unode->index[i]] != unode->mask[i]) {
+        unode->index[totvert] = unode->index[i];
+        unode->mask[totvert] = unode->mask[i];
+        totvert++;
+      }
+    }
+  }
+
+  if (totvert == unode->totvert) {
+    return;
+  }
+
+  unode->totvert = totvert;
+  unode->index = sculpt_undo_array_shrink(
+      usculpt, unode->index, sizeof(*unode->index) * (size_t)totvert);
+  if (unode->type == SCULPT_UNDO_COORDS) {
+    unode->co = sculpt_undo_array_shrink(usculpt, unode->co, sizeof(*unode->co) * (size_t)totvert);
+  }
+  else {
+    unode->mask = sculpt_undo_array_shrink(
+        usculpt, unode->mask, sizeof(*unode->mask) * (size_t)totvert);
+  }
+}
+
 void SCULPT_undo_push_end_ex(const bool use_nested_undo)
 {
   UndoSculpt *usculpt = sculpt_undo_get_nodes();
@@ -1424,6 +1500,12 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = G_MAIN->wm.first;
   if (wm->op_undo_depth == 0 || use_nested_undo) {
+    /* Strokes usually touch a fraction of the vertices of the nodes they push, only keep the
+     * changed ones in the stack. */
+    for (unode = usculpt->nodes.first; unode; unode = unode->next) {
+      sculpt_undo_compact_node(usculpt, unode);
+    }
+
     UndoStack *ustack = ED_undo_stack_get();
     BKE_undosys_step_push(ustack, NULL, NULL);
     if (wm->op_undo_depth == 0) {
@@ -948,9 +948,10 @@ void ED_spacetype_file(void)
 
 void ED_file_init(void)
 {
-  ED_file_read_bookmarks();
-
+  /* Only the file browser uses the bookmarks. Reading the system ones checks every mount point
+   * and user directory, which can stall start-up of background jobs on network file systems. */
   if (G.background == false) {
+    ED_file_read_bookmarks();
     filelist_init_icons();
   }
 
@@ -1117,6 +1117,31 @@ void node_draw_sockets(const View2D *v2d,
   GPU_blend(GPU_BLEND_NONE);
 }
 
+/* Time and memory of the last compositor execution, above the header. */
+static void node_draw_exec_stats(const bNode *node, const rctf *rct)
+{
+  if (node->exec_time <= 0.0f && node->exec_memory <= 0.0f) {
+    return;
+  }
+
+  char str[64];
+  BLI_snprintf(str, sizeof(str), TIP_("%.1f ms, %.1f MB"), node->exec_time, node->exec_memory);
+  uiDefBut(node->block,
+           UI_BTYPE_LABEL,
+           0,
+           str,
+           (int)(rct->xmin + NODE_MARGIN_X),
+           (int)rct->ymax,
+           (short)(BLI_rctf_size_x(rct) - NODE_MARGIN_X),
+           (short)NODE_DY,
+           NULL,
+           0,
+           0,
+           0,
+           0,
+           "");
+}
+
 static void node_draw_basis(const bContext *C,
                             const View2D *v2d,
                             const SpaceNode *snode,
@@ -1292,6 +1317,10 @@ static void node_draw_basis(const bContext *C,
     UI_but_flag_enable(but, UI_BUT_INACTIVE);
   }
 
+  if ((snode->flag & SNODE_SHOW_EXEC_STATS) && ntree->type == NTREE_COMPOSIT) {
+    node_draw_exec_stats(node, rct);
+  }
+
   /* body */
   if (nodeTypeUndefined(node)) {
     /* use warning color to indicate undefined types */
@@ -129,11 +129,22 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
             ED_region_tag_redraw_no_rebuild(region);
           }
           break;
+        case ND_FRAME:
+          /* Only the values shown in the Data API view and the object state filters (animated
+           * visibility) depend on the frame, other trees don't need to be rebuilt on every frame
+           * of the playback. */
+          if (space_outliner->outlinevis == SO_DATA_API ||
+              space_outliner->filter_state != SO_FILTER_OB_ALL) {
+            ED_region_tag_redraw(region);
+          }
+          else {
+            ED_region_tag_redraw_no_rebuild(region);
+          }
+          break;
         case ND_OB_VISIBLE:
         case ND_OB_RENDER:
         case ND_MODE:
         case ND_KEYINGSET:
-        case ND_FRAME:
         case ND_RENDER_OPTIONS:
         case ND_SEQUENCER:
         case ND_LAYER_CONTENT:
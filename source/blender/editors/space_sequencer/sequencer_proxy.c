@@ -25,9 +25,14 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_math_base.h"
+#include "BLI_threads.h"
 #include "BLI_timecode.h"
 
+#include "PIL_time.h"
+
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_context.h"
 #include "BKE_global.h"
@@ -44,6 +49,8 @@
 
 #include "RNA_define.h"
 
+#include "atomic_ops.h"
+
 /* For menu, popup, icons, etc. */
 #include "ED_screen.h"
 
@@ -54,39 +61,125 @@
 /** \name Proxy Job Manager
  * \{ */
 
+#define PROXY_BUILD_JOBS_MAX 16
+
 typedef struct ProxyBuildJob {
   struct Main *main;
   struct Depsgraph *depsgraph;
   Scene *scene;
   ListBase queue;
   int stop;
+
+  /** Guards #queue and #last_started, the queue is shared by all workers and strips can be
+   * added to it while the job runs. */
+  ThreadMutex queue_lock;
+  LinkData *last_started;
+  int num_done;
+  int num_workers_running;
+  short *stop_flag;
+  short *do_update;
 } ProxyJob;
 
+/* Builds the proxies of one strip at a time, taken from the queue until it is empty. */
+typedef struct ProxyBuildWorker {
+  ProxyJob *pj;
+  float progress;
+} ProxyBuildWorker;
+
 static void proxy_freejob(void *pjv)
 {
   ProxyJob *pj = pjv;
 
   BLI_freelistN(&pj->queue);
+  BLI_mutex_end(&pj->queue_lock);
 
   MEM_freeN(pj);
 }
 
+/* Every strip already runs a threaded decode and encode, a quarter of the threads is enough to
+ * keep the system busy without the strips starving each other. */
+static int proxy_build_jobs_num(void)
+{
+  if (U.sequencer_proxy_build_jobs > 0) {
+    return min_ii(U.sequencer_proxy_build_jobs, PROXY_BUILD_JOBS_MAX);
+  }
+  return clamp_i(BLI_system_thread_count() / 4, 1, PROXY_BUILD_JOBS_MAX);
+}
+
+static LinkData *proxy_job_next(ProxyJob *pj)
+{
+  BLI_mutex_lock(&pj->queue_lock);
+  /* Strips can be added to the queue while the job is running. */
+  LinkData *link = pj->last_started ? pj->last_started->next : pj->queue.first;
+  if (link) {
+    pj->last_started = link;
+  }
+  BLI_mutex_unlock(&pj->queue_lock);
+  return link;
+}
+
+static int proxy_job_queue_len(ProxyJob *pj)
+{
+  BLI_mutex_lock(&pj->queue_lock);
+  const int len = BLI_listbase_count(&pj->queue);
+  BLI_mutex_unlock(&pj->queue_lock);
+  return len;
+}
+
+static void *proxy_build_worker(void *worker_v)
+{
+  ProxyBuildWorker *worker = worker_v;
+  ProxyJob *pj = worker->pj;
+  LinkData *link;
+
+  while (!*pj->stop_flag && (link = proxy_job_next(pj))) {
+    SEQ_proxy_rebuild(link->data, pj->stop_flag, pj->do_update, &worker->progress);
+    atomic_add_and_fetch_int32(&pj->num_done, 1);
+    worker->progress = 0.0f;
+  }
+
+  atomic_sub_and_fetch_int32(&pj->num_workers_running, 1);
+  return NULL;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
-  LinkData *link;
+  ProxyBuildWorker workers[PROXY_BUILD_JOBS_MAX];
+  ListBase threads;
+  const int num_workers = min_ii(proxy_build_jobs_num(), proxy_job_queue_len(pj));
 
-  for (link = pj->queue.first; link; link = link->next) {
-    struct SeqIndexBuildContext *context = link->data;
+  if (num_workers == 0) {
+    return;
+  }
+
+  pj->stop_flag = stop;
+  pj->do_update = do_update;
+  pj->num_workers_running = num_workers;
+
+  BLI_threadpool_init(&threads, proxy_build_worker, num_workers);
+  for (int i = 0; i < num_workers; i++) {
+    workers[i].pj = pj;
+    workers[i].progress = 0.0f;
+    BLI_threadpool_insert(&threads, &workers[i]);
+  }
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+  while (atomic_add_and_fetch_int32(&pj->num_workers_running, 0) > 0) {
+    PIL_sleep_ms(50);
 
-    if (*stop) {
-      pj->stop = 1;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
-      break;
+    float done = (float)atomic_add_and_fetch_int32(&pj->num_done, 0);
+    for (int i = 0; i < num_workers; i++) {
+      done += workers[i].progress;
     }
+    *progress = min_ff(done / proxy_job_queue_len(pj), 1.0f);
+  }
+
+  BLI_threadpool_end(&threads);
+
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
   }
 }
 
@@ -135,6 +228,7 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
     pj->depsgraph = depsgraph;
     pj->scene = scene;
     pj->main = CTX_data_main(C);
+    BLI_mutex_init(&pj->queue_lock);
 
     WM_jobs_customdata_set(wm_job, pj, proxy_freejob);
     WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_SEQUENCER, NC_SCENE | ND_SEQUENCER);
@@ -143,6 +237,8 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
 
   file_list = BLI_gset_new(BLI_ghashutil_strhash_p, BLI_ghashutil_strcmp, "file list");
   bool selected = false; /* Check for no selected strips */
+  /* Contexts are created without the lock, then added to the job's queue at once. */
+  ListBase queue = {NULL, NULL};
 
   SEQ_CURRENT_BEGIN (ed, seq) {
     if (!ELEM(seq->type, SEQ_TYPE_MOVIE, SEQ_TYPE_IMAGE) || (seq->flag & SELECT) == 0) {
@@ -160,7 +256,7 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
     }
 
     bool success = SEQ_proxy_rebuild_context(
-        pj->main, pj->depsgraph, pj->scene, seq, file_list, &pj->queue);
+        pj->main, pj->depsgraph, pj->scene, seq, file_list, &queue);
 
     if (!success && (seq->strip->proxy->build_flags & SEQ_PROXY_SKIP_EXISTING) != 0) {
       BKE_reportf(reports, RPT_WARNING, "Overwrite is not checked for %s, skipping", seq->name);
@@ -168,6 +264,10 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
   }
   SEQ_CURRENT_END;
 
+  BLI_mutex_lock(&pj->queue_lock);
+  BLI_movelisttolist(&pj->queue, &queue);
+  BLI_mutex_unlock(&pj->queue_lock);
+
   BLI_gset_free(file_list, MEM_freeN);
 
   if (!selected) {
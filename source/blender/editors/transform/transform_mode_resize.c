@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_unit.h"
@@ -75,6 +76,24 @@ static void ApplySnapResize(TransInfo *t, float vec[3])
   }
 }
 
+typedef struct TransDataArgs_Resize {
+  TransInfo *t;
+  TransDataContainer *tc;
+  float (*mat)[3];
+} TransDataArgs_Resize;
+
+static void transdata_elem_resize_fn(void *__restrict iter_data_v,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransDataArgs_Resize *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  ElementResize(data->t, data->tc, td, data->mat);
+}
+
 static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
 {
   float mat[3][3];
@@ -121,14 +140,29 @@ static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
 
   copy_m3_m3(t->mat, mat); /* used in gizmo */
 
+  /* Grease pencil strokes update the transform values from #ElementResize. */
+  const bool use_threading = (t->options & CTX_GPENCIL_STROKES) == 0;
+
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransData *td = tc->data;
-    for (i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_SKIP) {
-        continue;
-      }
+    if (!use_threading || tc->data_len < TRANSDATA_THREAD_LIMIT) {
+      TransData *td = tc->data;
+      for (i = 0; i < tc->data_len; i++, td++) {
+        if (td->flag & TD_SKIP) {
+          continue;
+        }
 
-      ElementResize(t, tc, td, mat);
+        ElementResize(t, tc, td, mat);
+      }
+    }
+    else {
+      TransDataArgs_Resize data = {
+          .t = t,
+          .tc = tc,
+          .mat = mat,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, transdata_elem_resize_fn, &settings);
     }
   }
 
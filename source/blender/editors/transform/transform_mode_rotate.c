@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_unit.h"
@@ -113,13 +114,102 @@ static float large_rotation_limit(float angle)
   return angle;
 }
 
+static void transdata_elem_rotate(TransInfo *t,
+                                  TransDataContainer *tc,
+                                  TransData *td,
+                                  const float mat_common[3][3],
+                                  const float axis_common[3],
+                                  const float angle,
+                                  const float angle_step,
+                                  const bool is_large_rotation)
+{
+  float axis[3];
+  float mat[3][3];
+  /* Whether the rotation matrix differs from the one shared by all elements. */
+  bool do_update_matrix = false;
+
+  copy_v3_v3(axis, axis_common);
+
+  float angle_final = angle;
+  if (t->con.applyRot) {
+    t->con.applyRot(t, tc, td, axis, NULL);
+    angle_final = angle * td->factor;
+    /* Even though final angle might be identical to orig value,
+     * we have to update the rotation matrix in that case... */
+    do_update_matrix = true;
+  }
+  else if (t->flag & T_PROP_EDIT) {
+    angle_final = angle * td->factor;
+  }
+
+  /* Rotation is very likely to be above 180°, we need to do rotation by steps.
+   * Note that this is only needed when doing 'absolute' rotation
+   * (i.e. from initial rotation again, typically when using numinput).
+   * regular incremental rotation (from mouse/widget/...) will be called often enough,
+   * hence steps are small enough to be properly handled without that complicated trick.
+   * Note that we can only do that kind of stepped rotation if we have initial rotation values
+   * (and access to some actual rotation value storage).
+   * Otherwise, just assume it's useless (e.g. in case of mesh/UV/etc. editing).
+   * Also need to be in Euler rotation mode, the others never allow more than one turn anyway.
+   */
+  if (is_large_rotation && td->ext != NULL && td->ext->rotOrder == ROT_MODE_EUL) {
+    copy_v3_v3(td->ext->rot, td->ext->irot);
+    for (float angle_progress = angle_step; fabsf(angle_progress) < fabsf(angle_final);
+         angle_progress += angle_step) {
+      axis_angle_normalized_to_mat3(mat, axis, angle_progress);
+      ElementRotation(t, tc, td, mat, t->around);
+    }
+    do_update_matrix = true;
+  }
+  else if (angle_final != angle) {
+    do_update_matrix = true;
+  }
+
+  if (do_update_matrix) {
+    axis_angle_normalized_to_mat3(mat, axis, angle_final);
+  }
+  else {
+    copy_m3_m3(mat, mat_common);
+  }
+
+  ElementRotation(t, tc, td, mat, t->around);
+}
+
+typedef struct TransDataArgs_Rotate {
+  TransInfo *t;
+  TransDataContainer *tc;
+  const float (*mat)[3];
+  const float *axis;
+  float angle;
+  float angle_step;
+  bool is_large_rotation;
+} TransDataArgs_Rotate;
+
+static void transdata_elem_rotate_fn(void *__restrict iter_data_v,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransDataArgs_Rotate *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  transdata_elem_rotate(data->t,
+                        data->tc,
+                        td,
+                        data->mat,
+                        data->axis,
+                        data->angle,
+                        data->angle_step,
+                        data->is_large_rotation);
+}
+
 static void applyRotationValue(TransInfo *t,
                                float angle,
                                float axis[3],
                                const bool is_large_rotation)
 {
   float mat[3][3];
-  int i;
 
   const float angle_sign = angle < 0.0f ? -1.0f : 1.0f;
   /* We cannot use something too close to 180°, or 'continuous' rotation may fail
@@ -133,59 +223,30 @@ static void applyRotationValue(TransInfo *t,
   }
 
   axis_angle_normalized_to_mat3(mat, axis, angle);
-  /* Counter for needed updates (when we need to update to non-default matrix,
-   * we also need another update on next iteration to go back to default matrix,
-   * hence the '2' value used here, instead of a mere boolean). */
-  short do_update_matrix = 0;
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransData *td = tc->data;
-    for (i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_SKIP) {
-        continue;
-      }
-
-      float angle_final = angle;
-      if (t->con.applyRot) {
-        t->con.applyRot(t, tc, td, axis, NULL);
-        angle_final = angle * td->factor;
-        /* Even though final angle might be identical to orig value,
-         * we have to update the rotation matrix in that case... */
-        do_update_matrix = 2;
-      }
-      else if (t->flag & T_PROP_EDIT) {
-        angle_final = angle * td->factor;
-      }
-
-      /* Rotation is very likely to be above 180°, we need to do rotation by steps.
-       * Note that this is only needed when doing 'absolute' rotation
-       * (i.e. from initial rotation again, typically when using numinput).
-       * regular incremental rotation (from mouse/widget/...) will be called often enough,
-       * hence steps are small enough to be properly handled without that complicated trick.
-       * Note that we can only do that kind of stepped rotation if we have initial rotation values
-       * (and access to some actual rotation value storage).
-       * Otherwise, just assume it's useless (e.g. in case of mesh/UV/etc. editing).
-       * Also need to be in Euler rotation mode, the others never allow more than one turn anyway.
-       */
-      if (is_large_rotation && td->ext != NULL && td->ext->rotOrder == ROT_MODE_EUL) {
-        copy_v3_v3(td->ext->rot, td->ext->irot);
-        for (float angle_progress = angle_step; fabsf(angle_progress) < fabsf(angle_final);
-             angle_progress += angle_step) {
-          axis_angle_normalized_to_mat3(mat, axis, angle_progress);
-          ElementRotation(t, tc, td, mat, t->around);
+    if (tc->data_len < TRANSDATA_THREAD_LIMIT) {
+      TransData *td = tc->data;
+      for (int i = 0; i < tc->data_len; i++, td++) {
+        if (td->flag & TD_SKIP) {
+          continue;
         }
-        do_update_matrix = 2;
-      }
-      else if (angle_final != angle) {
-        do_update_matrix = 2;
-      }
-
-      if (do_update_matrix > 0) {
-        axis_angle_normalized_to_mat3(mat, axis, angle_final);
-        do_update_matrix--;
+        transdata_elem_rotate(t, tc, td, mat, axis, angle, angle_step, is_large_rotation);
       }
-
-      ElementRotation(t, tc, td, mat, t->around);
+    }
+    else {
+      TransDataArgs_Rotate data = {
+          .t = t,
+          .tc = tc,
+          .mat = mat,
+          .axis = axis,
+          .angle = angle,
+          .angle_step = angle_step,
+          .is_large_rotation = is_large_rotation,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, transdata_elem_rotate_fn, &settings);
     }
   }
 }
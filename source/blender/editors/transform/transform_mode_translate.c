@@ -29,6 +29,7 @@
 
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_report.h"
@@ -257,99 +258,143 @@ static void ApplySnapTranslation(TransInfo *t, float vec[3])
   }
 }
 
-static void applyTranslationValue(TransInfo *t, const float vec[3])
+static void transdata_elem_translate(TransInfo *t,
+                                     TransDataContainer *tc,
+                                     TransData *td,
+                                     const float vec[3],
+                                     const float pivot[3],
+                                     const bool apply_snap_align_rotation)
 {
-  const bool apply_snap_align_rotation = usingSnappingNormal(
-      t);  // && (t->tsnap.status & POINT_INIT);
   float tvec[3];
+  float rotate_offset[3] = {0};
+  bool use_rotate_offset = false;
 
-  /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
-   * so, maybe inside this function is not the best place to apply this rotation.
-   * but you need "handle snapping rotation before doing the translation" (really?) */
-  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+  /* handle snapping rotation before doing the translation */
+  if (apply_snap_align_rotation) {
+    float mat[3][3];
 
-    float pivot[3];
-    if (apply_snap_align_rotation) {
-      copy_v3_v3(pivot, t->tsnap.snapTarget);
-      /* The pivot has to be in local-space (see T49494) */
-      if (tc->use_local_mat) {
-        mul_m4_v3(tc->imat, pivot);
-      }
-    }
+    if (validSnappingNormal(t)) {
+      const float *original_normal;
 
-    TransData *td = tc->data;
-    for (int i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_SKIP) {
-        continue;
+      /* In pose mode, we want to align normals with Y axis of bones... */
+      if (t->flag & T_POSE) {
+        original_normal = td->axismtx[1];
+      }
+      else {
+        original_normal = td->axismtx[2];
       }
 
-      float rotate_offset[3] = {0};
-      bool use_rotate_offset = false;
+      rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
+    }
+    else {
+      unit_m3(mat);
+    }
 
-      /* handle snapping rotation before doing the translation */
-      if (apply_snap_align_rotation) {
-        float mat[3][3];
+    ElementRotation_ex(t, tc, td, mat, pivot);
 
-        if (validSnappingNormal(t)) {
-          const float *original_normal;
+    if (td->loc) {
+      use_rotate_offset = true;
+      sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
+    }
+  }
 
-          /* In pose mode, we want to align normals with Y axis of bones... */
-          if (t->flag & T_POSE) {
-            original_normal = td->axismtx[1];
-          }
-          else {
-            original_normal = td->axismtx[2];
-          }
+  if (t->con.applyVec) {
+    t->con.applyVec(t, tc, td, vec, tvec);
+  }
+  else {
+    copy_v3_v3(tvec, vec);
+  }
 
-          rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
-        }
-        else {
-          unit_m3(mat);
-        }
+  mul_m3_v3(td->smtx, tvec);
 
-        ElementRotation_ex(t, tc, td, mat, pivot);
+  if (use_rotate_offset) {
+    add_v3_v3(tvec, rotate_offset);
+  }
 
-        if (td->loc) {
-          use_rotate_offset = true;
-          sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
-        }
-      }
+  if (t->options & CTX_GPENCIL_STROKES) {
+    /* grease pencil multiframe falloff */
+    bGPDstroke *gps = (bGPDstroke *)td->extra;
+    if (gps != NULL) {
+      mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
+    }
+    else {
+      mul_v3_fl(tvec, td->factor);
+    }
+  }
+  else {
+    /* proportional editing falloff */
+    mul_v3_fl(tvec, td->factor);
+  }
 
-      if (t->con.applyVec) {
-        t->con.applyVec(t, tc, td, vec, tvec);
-      }
-      else {
-        copy_v3_v3(tvec, vec);
-      }
+  protectedTransBits(td->protectflag, tvec);
 
-      mul_m3_v3(td->smtx, tvec);
+  if (td->loc) {
+    add_v3_v3v3(td->loc, td->iloc, tvec);
+  }
 
-      if (use_rotate_offset) {
-        add_v3_v3(tvec, rotate_offset);
-      }
+  constraintTransLim(t, td);
+}
 
-      if (t->options & CTX_GPENCIL_STROKES) {
-        /* grease pencil multiframe falloff */
-        bGPDstroke *gps = (bGPDstroke *)td->extra;
-        if (gps != NULL) {
-          mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
-        }
-        else {
-          mul_v3_fl(tvec, td->factor);
-        }
-      }
-      else {
-        /* proportional editing falloff */
-        mul_v3_fl(tvec, td->factor);
-      }
+typedef struct TransDataArgs_Translate {
+  TransInfo *t;
+  TransDataContainer *tc;
+  const float *vec;
+  const float *pivot;
+  bool apply_snap_align_rotation;
+} TransDataArgs_Translate;
+
+static void transdata_elem_translate_fn(void *__restrict iter_data_v,
+                                        const int iter,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransDataArgs_Translate *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  transdata_elem_translate(
+      data->t, data->tc, td, data->vec, data->pivot, data->apply_snap_align_rotation);
+}
 
-      protectedTransBits(td->protectflag, tvec);
+static void applyTranslationValue(TransInfo *t, const float vec[3])
+{
+  const bool apply_snap_align_rotation = usingSnappingNormal(
+      t);  // && (t->tsnap.status & POINT_INIT);
 
-      if (td->loc) {
-        add_v3_v3v3(td->loc, td->iloc, tvec);
+  /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
+   * so, maybe inside this function is not the best place to apply this rotation.
+   * but you need "handle snapping rotation before doing the translation" (really?) */
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+
+    float pivot[3];
+    if (apply_snap_align_rotation) {
+      copy_v3_v3(pivot, t->tsnap.snapTarget);
+      /* The pivot has to be in local-space (see T49494) */
+      if (tc->use_local_mat) {
+        mul_m4_v3(tc->imat, pivot);
       }
+    }
 
-      constraintTransLim(t, td);
+    if (tc->data_len < TRANSDATA_THREAD_LIMIT) {
+      TransData *td = tc->data;
+      for (int i = 0; i < tc->data_len; i++, td++) {
+        if (td->flag & TD_SKIP) {
+          continue;
+        }
+        transdata_elem_translate(t, tc, td, vec, pivot, apply_snap_align_rotation);
+      }
+    }
+    else {
+      TransDataArgs_Translate data = {
+          .t = t,
+          .tc = tc,
+          .vec = vec,
+          .pivot = pivot,
+          .apply_snap_align_rotation = apply_snap_align_rotation,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, tc->data_len, &data, transdata_elem_translate_fn, &settings);
     }
   }
 }
@@ -182,6 +182,9 @@ static void memfile_undosys_step_decode(struct bContext *C,
     }
   }
 
+  /* Prefetched data of the current depsgraphs is invalid once the undo step is read. */
+  DEG_playback_prefetch_stop_all(bmain);
+
   /* Extract depsgraphs from current bmain (which may be freed during undo step reading),
    * and store them for re-use. */
   GHash *depsgraphs = NULL;
@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -4594,51 +4595,87 @@ void param_construct_end(ParamHandle *handle, ParamBool fill, ParamBool topology
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
+/* Charts don't share any data, so they are solved in parallel. */
+typedef struct PChartsTaskData {
+  PHandle *phandle;
+  PBool live, abf;
+  bool ignore_pinned;
+} PChartsTaskData;
+
+static void p_charts_task_settings_init(PHandle *phandle, TaskParallelSettings *settings)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = (phandle->ncharts > 1);
+  /* Chart sizes vary a lot, avoid one thread getting all the big ones. */
+  settings->min_iter_per_thread = 1;
+}
+
+static void param_lscm_begin_chart_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PChartsTaskData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  PFace *f;
+
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
+
 void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PFace *f;
-  int i;
 
   param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
   phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
+  PChartsTaskData data = {
+      .phandle = phandle,
+      .live = (PBool)live,
+      .abf = (PBool)abf,
+  };
+  TaskParallelSettings settings;
+  p_charts_task_settings_init(phandle, &settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, param_lscm_begin_chart_cb, &settings);
+}
+
+static void param_lscm_solve_chart_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PChartsTaskData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  PBool result;
+
+  if (chart->u.lscm.context) {
+    result = p_chart_lscm_solve(data->phandle, chart);
+
+    if (result && !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_rotate_minimum_area(chart);
+    }
+    else if (result && chart->u.lscm.single_pin) {
+      p_chart_rotate_fit_aabb(chart);
+      p_chart_lscm_transform_single_pin(chart);
+    }
+
+    if (!result || !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_lscm_end(chart);
     }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
   }
 }
 
 void param_lscm_solve(ParamHandle *handle)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
-  PBool result;
 
   param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
-
-    if (chart->u.lscm.context) {
-      result = p_chart_lscm_solve(phandle, chart);
-
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
-
-      if (!result || !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_lscm_end(chart);
-      }
-    }
-  }
+  PChartsTaskData data = {.phandle = phandle};
+  TaskParallelSettings settings;
+  p_charts_task_settings_init(phandle, &settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, param_lscm_solve_chart_cb, &settings);
 }
 
 void param_lscm_end(ParamHandle *handle)
@@ -4741,22 +4778,28 @@ void param_smooth_area(ParamHandle *handle)
 }
 
 /* don't pack, just rotate (used for better packing) */
-static void param_pack_rotate(ParamHandle *handle, bool ignore_pinned)
+static void param_pack_rotate_chart_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  PChart *chart;
-  int i;
+  const PChartsTaskData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
 
-  PHandle *phandle = (PHandle *)handle;
+  if (data->ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
+    return;
+  }
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
+  p_chart_rotate_fit_aabb(chart);
+}
 
-    if (ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
-      continue;
-    }
+static void param_pack_rotate(ParamHandle *handle, bool ignore_pinned)
+{
+  PHandle *phandle = (PHandle *)handle;
 
-    p_chart_rotate_fit_aabb(chart);
-  }
+  PChartsTaskData data = {.phandle = phandle, .ignore_pinned = ignore_pinned};
+  TaskParallelSettings settings;
+  p_charts_task_settings_init(phandle, &settings);
+  BLI_task_parallel_range(0, phandle->ncharts, &data, param_pack_rotate_chart_cb, &settings);
 }
 
 void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned)
@@ -49,6 +49,31 @@ static const Global &_global = G;
 
 using namespace std;
 
+// Collect the faces sharing a non-boundary vertex with the face of a smooth edge, sorted so that
+// every occluder can be tested against them with a binary search, instead of iterating over the
+// edges of all face vertices again for every occluder.
+static void findAdjacentFaces(const vector<WVertex *> &faceVertices,
+                              vector<WFace *> &adjacentFaces)
+{
+  for (vector<WVertex *>::const_iterator fv = faceVertices.begin(), fvend = faceVertices.end();
+       fv != fvend;
+       ++fv) {
+    if ((*fv)->isBoundary()) {
+      continue;
+    }
+    WVertex::incoming_edge_iterator iebegin = (*fv)->incoming_edges_begin();
+    WVertex::incoming_edge_iterator ieend = (*fv)->incoming_edges_end();
+    for (WVertex::incoming_edge_iterator ie = iebegin; ie != ieend; ++ie) {
+      if ((*ie) == nullptr) {
+        continue;
+      }
+      adjacentFaces.push_back((*ie)->GetbFace());
+    }
+  }
+  sort(adjacentFaces.begin(), adjacentFaces.end());
+  adjacentFaces.erase(unique(adjacentFaces.begin(), adjacentFaces.end()), adjacentFaces.end());
+}
+
 template<typename G, typename I>
 static void findOccludee(FEdge *fe,
                          G & /*grid*/,
@@ -59,7 +84,8 @@ static void findOccludee(FEdge *fe,
                          Vec3r &A,
                          Vec3r &origin,
                          Vec3r &edgeDir,
-                         vector<WVertex *> &faceVertices)
+                         vector<WVertex *> &faceVertices,
+                         const vector<WFace *> &adjacentFaces)
 {
   WFace *face = nullptr;
   if (fe->isSmooth()) {
@@ -67,9 +93,6 @@ static void findOccludee(FEdge *fe,
     face = (WFace *)fes->face();
   }
   WFace *oface;
-  bool skipFace;
-
-  WVertex::incoming_edge_iterator ie;
 
   *oaWFace = nullptr;
   if (((fe)->getNature() & Nature::SILHOUETTE) || ((fe)->getNature() & Nature::BORDER)) {
@@ -91,8 +114,6 @@ static void findOccludee(FEdge *fe,
       real t, t_u, t_v;
 
       if (nullptr != face) {
-        skipFace = false;
-
         if (face == oface) {
           continue;
         }
@@ -101,30 +122,7 @@ static void findOccludee(FEdge *fe,
           continue;
         }
 
-        for (vector<WVertex *>::iterator fv = faceVertices.begin(), fvend = faceVertices.end();
-             fv != fvend;
-             ++fv) {
-          if ((*fv)->isBoundary()) {
-            continue;
-          }
-          WVertex::incoming_edge_iterator iebegin = (*fv)->incoming_edges_begin();
-          WVertex::incoming_edge_iterator ieend = (*fv)->incoming_edges_end();
-          for (ie = iebegin; ie != ieend; ++ie) {
-            if ((*ie) == nullptr) {
-              continue;
-            }
-
-            WFace *sface = (*ie)->GetbFace();
-            if (sface == oface) {
-              skipFace = true;
-              break;
-            }
-          }
-          if (skipFace) {
-            break;
-          }
-        }
-        if (skipFace) {
+        if (binary_search(adjacentFaces.begin(), adjacentFaces.end(), oface)) {
           continue;
         }
       }
@@ -204,12 +202,15 @@ static void findOccludee(FEdge *fe, G &grid, real epsilon, ViewEdge * /*ve*/, WF
     face = (WFace *)fes->face();
   }
 
+  vector<WFace *> adjacentFaces;
   if (face) {
     face->RetrieveVertexList(faceVertices);
+    findAdjacentFaces(faceVertices, adjacentFaces);
   }
 
   I occluders(grid, A, epsilon);
-  findOccludee<G, I>(fe, grid, occluders, epsilon, oaFace, u, A, origin, edgeDir, faceVertices);
+  findOccludee<G, I>(
+      fe, grid, occluders, epsilon, oaFace, u, A, origin, edgeDir, faceVertices, adjacentFaces);
 }
 
 // computeVisibility takes a pointer to foundOccluders, instead of using a reference,
@@ -251,13 +252,13 @@ static int computeVisibility(ViewMap *viewMap,
     face = (WFace *)fes->face();
   }
   vector<WVertex *> faceVertices;
-  WVertex::incoming_edge_iterator ie;
+  vector<WFace *> adjacentFaces;
 
   WFace *oface;
-  bool skipFace;
 
   if (face) {
     face->RetrieveVertexList(faceVertices);
+    findAdjacentFaces(faceVertices, adjacentFaces);
   }
 
   I occluders(grid, center, epsilon);
@@ -309,8 +310,6 @@ static int computeVisibility(ViewMap *viewMap,
         cout << "\t\tDetermining face adjacency...";
       }
 #endif
-      skipFace = false;
-
       if (face == oface) {
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
@@ -320,33 +319,7 @@ static int computeVisibility(ViewMap *viewMap,
         continue;
       }
 
-      for (vector<WVertex *>::iterator fv = faceVertices.begin(), fvend = faceVertices.end();
-           fv != fvend;
-           ++fv) {
-        if ((*fv)->isBoundary()) {
-          continue;
-        }
-
-        WVertex::incoming_edge_iterator iebegin = (*fv)->incoming_edges_begin();
-        WVertex::incoming_edge_iterator ieend = (*fv)->incoming_edges_end();
-        for (ie = iebegin; ie != ieend; ++ie) {
-          if ((*ie) == nullptr) {
-            continue;
-          }
-
-          WFace *sface = (*ie)->GetbFace();
-          // WFace *sfacea = (*ie)->GetaFace();
-          // if ((sface == oface) || (sfacea == oface))
-          if (sface == oface) {
-            skipFace = true;
-            break;
-          }
-        }
-        if (skipFace) {
-          break;
-        }
-      }
-      if (skipFace) {
+      if (binary_search(adjacentFaces.begin(), adjacentFaces.end(), oface)) {
 #if LOGGING
         if (_global.debug & G_DEBUG_FREESTYLE) {
           cout << "  Rejecting occluder for face adjacency." << endl;
@@ -417,8 +390,17 @@ static int computeVisibility(ViewMap *viewMap,
   }
 
   // Find occludee
-  findOccludee<G, I>(
-      fe, grid, occluders, epsilon, oaWFace, u, center, origin, edgeDir, faceVertices);
+  findOccludee<G, I>(fe,
+                     grid,
+                     occluders,
+                     epsilon,
+                     oaWFace,
+                     u,
+                     center,
+                     origin,
+                     edgeDir,
+                     faceVertices,
+                     adjacentFaces);
 
   return qi;
 }
@@ -28,6 +28,8 @@
  * - Avoids data copies in many cases.
  * - Every node is executed at most once.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ * - Large ranges are evaluated in chunks, so that temporary buffers stay small enough to remain
+ *   in the cache between the evaluation of successive nodes.
  *
  * Possible improvements:
  * - Cache and reuse buffers.
@@ -135,12 +137,97 @@ MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
   }
 }
 
+/**
+ * Number of elements that are evaluated at once, when the network is called on a large range.
+ * The temporary buffers of element-wise chains then fit into the cache, instead of every
+ * intermediate result being written to and read from main memory.
+ */
+static constexpr int64_t evaluation_chunk_size = 4096;
+
 void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.size() == 0) {
     return;
   }
 
+  if (mask.size() > evaluation_chunk_size && mask.is_range() &&
+      this->can_evaluate_in_chunks(params)) {
+    this->evaluate_in_chunks(mask.as_range(), params, context);
+    return;
+  }
+
+  this->evaluate(mask, params, context);
+}
+
+/**
+ * Only single values can be passed to a chunk without copying them, because #GVectorArray can't
+ * be sliced and the pointers of a pointer array can't be offset from outside the span.
+ */
+bool MFNetworkEvaluator::can_evaluate_in_chunks(MFParams params) const
+{
+  for (int param_index : this->param_indices()) {
+    switch (this->param_type(param_index).category()) {
+      case MFParamType::SingleInput: {
+        GVSpan span = params.readonly_single_input(param_index);
+        if (!span.is_single_element() && !span.is_full_array()) {
+          return false;
+        }
+        break;
+      }
+      case MFParamType::SingleOutput:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+static GVSpan slice_virtual_span(const GVSpan &span, IndexRange range)
+{
+  if (span.is_single_element()) {
+    return GVSpan::FromSingle(span.type(), span.as_single_element(), range.size());
+  }
+  BLI_assert(span.is_full_array());
+  return GSpan(span.type(), span[range.start()], range.size());
+}
+
+void MFNetworkEvaluator::evaluate_in_chunks(IndexRange range,
+                                            MFParams params,
+                                            MFContext context) const
+{
+  for (int64_t chunk_start = range.start(); chunk_start < range.one_after_last();
+       chunk_start += evaluation_chunk_size) {
+    const IndexRange chunk_range{
+        chunk_start, std::min(evaluation_chunk_size, range.one_after_last() - chunk_start)};
+
+    /* Offset all parameters, so that the chunk can be evaluated like a range starting at zero.
+     * This way the temporary buffers only have the size of the chunk. */
+    MFParamsBuilder chunk_params{*this, chunk_range.size()};
+    for (int param_index : this->param_indices()) {
+      switch (this->param_type(param_index).category()) {
+        case MFParamType::SingleInput: {
+          GVSpan span = params.readonly_single_input(param_index);
+          chunk_params.add_readonly_single_input(slice_virtual_span(span, chunk_range));
+          break;
+        }
+        case MFParamType::SingleOutput: {
+          GMutableSpan span = params.uninitialized_single_output(param_index);
+          chunk_params.add_uninitialized_single_output(
+              GMutableSpan(span.type(), span[chunk_range.start()], chunk_range.size()));
+          break;
+        }
+        default:
+          BLI_assert(false);
+          break;
+      }
+    }
+    this->evaluate(IndexMask(chunk_range.size()), chunk_params, context);
+  }
+}
+
+void MFNetworkEvaluator::evaluate(IndexMask mask, MFParams params, MFContext context) const
+{
   const MFNetwork &network = outputs_[0]->node().network();
   Storage storage(mask, network.socket_id_amount());
 
@@ -65,6 +65,51 @@ TEST(multi_function_network, Test1)
   }
 }
 
+TEST(multi_function_network, LargeRange)
+{
+  CustomMF_SI_SO<int, int> add_10_fn("add 10", [](int value) { return value + 10; });
+  CustomMF_SI_SI_SO<int, int, int> multiply_fn("multiply", [](int a, int b) { return a * b; });
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_10_fn);
+  MFNode &node2 = network.add_function(multiply_fn);
+  MFOutputSocket &input_a = network.add_input("A", MFDataType::ForSingle<int>());
+  MFOutputSocket &input_b = network.add_input("B", MFDataType::ForSingle<int>());
+  MFInputSocket &output_socket = network.add_output("Output", MFDataType::ForSingle<int>());
+  network.add_link(input_a, node1.input(0));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(input_b, node2.input(1));
+  network.add_link(node2.output(0), output_socket);
+
+  MFNetworkEvaluator network_fn{{&input_a, &input_b}, {&output_socket}};
+
+  /* Large enough to be evaluated in multiple chunks, with a range not starting at zero. */
+  const int size = 10000;
+  Array<int> values(size);
+  for (const int i : values.index_range()) {
+    values[i] = i;
+  }
+  const int factor = 2;
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values.as_span());
+  params.add_readonly_single_input(&factor);
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+
+  network_fn.call(IndexRange(5, size - 5), params, context);
+
+  for (const int i : IndexRange(5)) {
+    EXPECT_EQ(results[i], -1);
+  }
+  for (const int i : IndexRange(5, size - 5)) {
+    EXPECT_EQ(results[i], (i + 10) * 2);
+  }
+}
+
 class ConcatVectorsFunction : public MultiFunction {
  public:
   ConcatVectorsFunction()
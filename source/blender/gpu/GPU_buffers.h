@@ -73,6 +73,9 @@ enum {
   GPU_PBVH_BUFFERS_SHOW_MASK = (1 << 1),
   GPU_PBVH_BUFFERS_SHOW_VCOL = (1 << 2),
   GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS = (1 << 3),
+  /* Keep the vertex data after uploading it, so that the next update of mesh and grid nodes
+   * only uploads the ranges that changed. Used while the nodes are updated repeatedly. */
+  GPU_PBVH_BUFFERS_KEEP_DATA = (1 << 4),
 };
 
 void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
@@ -107,6 +110,9 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 /* Finish update. Not thread safe, must run in OpenGL main thread. */
 void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers);
 
+/* Free the vertex data kept with #GPU_PBVH_BUFFERS_KEEP_DATA, the GPU storage is kept. */
+void GPU_pbvh_buffers_release_data(GPU_PBVH_Buffers *buffers);
+
 /* Free buffers.  Not thread safe, must run in OpenGL main thread. */
 void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers);
 
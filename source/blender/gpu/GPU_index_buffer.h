@@ -67,6 +67,12 @@ void GPU_indexbuf_set_point_restart(GPUIndexBufBuilder *builder, uint elem);
 void GPU_indexbuf_set_line_restart(GPUIndexBufBuilder *builder, uint elem);
 void GPU_indexbuf_set_tri_restart(GPUIndexBufBuilder *builder, uint elem);
 
+/* Builders writing to disjoint elements of the same index data from different threads.
+ * Each thread sets elements on its own sub-builder, which are joined afterwards. */
+void GPU_indexbuf_subbuilder_init(const GPUIndexBufBuilder *builder,
+                                  GPUIndexBufBuilder *r_sub_builder);
+void GPU_indexbuf_join(GPUIndexBufBuilder *builder, const GPUIndexBufBuilder *sub_builder);
+
 GPUIndexBuf *GPU_indexbuf_build(GPUIndexBufBuilder *);
 void GPU_indexbuf_build_in_place(GPUIndexBufBuilder *, GPUIndexBuf *);
 
@@ -72,6 +72,12 @@ GPUVertBuf *GPU_vertbuf_create_with_format_ex(const GPUVertFormat *, GPUUsageTyp
 
 void GPU_vertbuf_clear(GPUVertBuf *verts);
 void GPU_vertbuf_discard(GPUVertBuf *);
+/**
+ * Clear the vertex buffer to fill it again, but keep its GPU storage and the last uploaded data.
+ * If it's filled with data of the same size, only the ranges that changed are uploaded.
+ * The uploaded data is only available for #GPU_USAGE_DYNAMIC buffers, others are cleared.
+ */
+void GPU_vertbuf_clear_keep_storage(GPUVertBuf *verts);
 
 /* Avoid GPUVertBuf datablock being free but not its data. */
 void GPU_vertbuf_handle_ref_add(GPUVertBuf *verts);
@@ -96,6 +96,9 @@ struct GPU_PBVH_Buffers {
   bool smooth;
 
   bool show_overlay;
+
+  /* The vertex data is kept after the upload, see #GPU_PBVH_BUFFERS_KEEP_DATA. */
+  bool keep_data;
 };
 
 static struct {
@@ -133,8 +136,15 @@ void gpu_pbvh_exit()
 }
 
 /* Allocates a non-initialized buffer to be sent to GPU.
- * Return is false it indicates that the memory map failed. */
-static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
+ * Return is false it indicates that the memory map failed.
+ *
+ * Mesh and grid nodes use #GPU_USAGE_DYNAMIC buffers: brush strokes usually only change part of
+ * a node, so while the node is updated with #GPU_PBVH_BUFFERS_KEEP_DATA the data of the previous
+ * upload is kept and only the changed ranges are uploaded again,
+ * see #GPU_vertbuf_clear_keep_storage. Otherwise the data is freed once uploaded. */
+static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers,
+                                       uint vert_len,
+                                       GPUUsageType usage)
 {
   /* Keep so we can test #GPU_USAGE_DYNAMIC buffer use.
    * Not that format initialization match in both blocks.
@@ -151,7 +161,14 @@ static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
 #else
   if (buffers->vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
+    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, usage);
+  }
+  else if (usage == GPU_USAGE_DYNAMIC &&
+           (GPU_vertbuf_get_status(buffers->vert_buf) & GPU_VERTBUF_DATA_UPLOADED) &&
+           GPU_vertbuf_get_vertex_len(buffers->vert_buf) == vert_len) {
+    /* Keeps the GPU buffer the batches use. */
+    GPU_vertbuf_clear_keep_storage(buffers->vert_buf);
+    GPU_vertbuf_init_with_format_ex(buffers->vert_buf, &g_vbo_id.format, usage);
   }
   if (GPU_vertbuf_get_data(buffers->vert_buf) == NULL ||
       GPU_vertbuf_get_vertex_len(buffers->vert_buf) != vert_len) {
@@ -223,11 +240,13 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
   bool empty_mask = true;
   bool default_face_set = true;
 
+  buffers->keep_data = (update_flags & GPU_PBVH_BUFFERS_KEEP_DATA) != 0;
+
   {
     const int totelem = buffers->tot_tri * 3;
 
     /* Build VBO */
-    if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
+    if (gpu_pbvh_vert_buf_data_set(buffers, totelem, GPU_USAGE_DYNAMIC)) {
       GPUVertBufRaw pos_step = {0};
       GPUVertBufRaw nor_step = {0};
       GPUVertBufRaw msk_step = {0};
@@ -606,6 +625,8 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 
   int i, j, k, x, y;
 
+  buffers->keep_data = (update_flags & GPU_PBVH_BUFFERS_KEEP_DATA) != 0;
+
   /* Build VBO */
   const int has_mask = key->has_mask;
 
@@ -634,7 +655,7 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 
   uint vbo_index_offset = 0;
   /* Build VBO */
-  if (gpu_pbvh_vert_buf_data_set(buffers, vert_count)) {
+  if (gpu_pbvh_vert_buf_data_set(buffers, vert_count, GPU_USAGE_DYNAMIC)) {
     GPUIndexBufBuilder elb_lines;
 
     if (buffers->index_lines_buf == NULL) {
@@ -920,7 +941,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const int cd_vert_mask_offset = CustomData_get_offset(&bm->vdata, CD_PAINT_MASK);
 
   /* Fill vertex buffer */
-  if (!gpu_pbvh_vert_buf_data_set(buffers, totvert)) {
+  if (!gpu_pbvh_vert_buf_data_set(buffers, totvert, GPU_USAGE_STATIC)) {
     /* Memory map failed */
     return;
   }
@@ -1104,7 +1125,20 @@ void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
   /* Force flushing to the GPU. */
   if (buffers->vert_buf && GPU_vertbuf_get_data(buffers->vert_buf)) {
     GPU_vertbuf_use(buffers->vert_buf);
+
+    if (!buffers->keep_data) {
+      GPU_pbvh_buffers_release_data(buffers);
+    }
+  }
+}
+
+void GPU_pbvh_buffers_release_data(GPU_PBVH_Buffers *buffers)
+{
+  if (buffers->vert_buf && GPU_vertbuf_get_data(buffers->vert_buf) &&
+      (GPU_vertbuf_get_status(buffers->vert_buf) & GPU_VERTBUF_DATA_DIRTY) == 0) {
+    MEM_freeN(GPU_vertbuf_steal_data(buffers->vert_buf));
   }
+  buffers->keep_data = false;
 }
 
 void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers)
@@ -204,6 +204,19 @@ void GPU_indexbuf_set_tri_restart(GPUIndexBufBuilder *builder, uint elem)
   }
 }
 
+void GPU_indexbuf_subbuilder_init(const GPUIndexBufBuilder *builder,
+                                  GPUIndexBufBuilder *r_sub_builder)
+{
+  /* Shares the data of the parent builder, only the used length is tracked separately. */
+  *r_sub_builder = *builder;
+}
+
+void GPU_indexbuf_join(GPUIndexBufBuilder *builder, const GPUIndexBufBuilder *sub_builder)
+{
+  BLI_assert(builder->data == sub_builder->data);
+  builder->index_len = MAX2(builder->index_len, sub_builder->index_len);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -72,6 +72,17 @@ void VertBuf::clear()
   flag = GPU_VERTBUF_INVALID;
 }
 
+void VertBuf::clear_keep_storage()
+{
+  if (usage_ == GPU_USAGE_DYNAMIC && (flag & GPU_VERTBUF_DATA_UPLOADED)) {
+    this->release_data_keep_storage();
+  }
+  else {
+    this->release_data();
+  }
+  flag = GPU_VERTBUF_INVALID;
+}
+
 VertBuf *VertBuf::duplicate()
 {
   VertBuf *dst = GPUBackend::get()->vertbuf_alloc();
@@ -155,6 +166,11 @@ void GPU_vertbuf_clear(GPUVertBuf *verts)
   unwrap(verts)->clear();
 }
 
+void GPU_vertbuf_clear_keep_storage(GPUVertBuf *verts)
+{
+  unwrap(verts)->clear_keep_storage();
+}
+
 void GPU_vertbuf_discard(GPUVertBuf *verts)
 {
   unwrap(verts)->clear();
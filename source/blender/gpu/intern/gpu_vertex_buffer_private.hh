@@ -61,6 +61,7 @@ class VertBuf {
 
   void init(const GPUVertFormat *format, GPUUsageType usage);
   void clear(void);
+  void clear_keep_storage(void);
 
   /* Data manament */
   void allocate(uint vert_len);
@@ -101,6 +102,8 @@ class VertBuf {
   virtual void acquire_data(void) = 0;
   virtual void resize_data(void) = 0;
   virtual void release_data(void) = 0;
+  /** Release the data but keep the GPU storage and a copy of the uploaded data. */
+  virtual void release_data_keep_storage(void) = 0;
   virtual void upload_data(void) = 0;
   virtual void duplicate_data(VertBuf *dst) = 0;
 };
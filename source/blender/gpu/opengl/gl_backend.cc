@@ -226,6 +226,7 @@ static void detect_workarounds()
     GLContext::fixed_restart_index_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
+    GLContext::program_binary_support = false;
     GLContext::shader_draw_parameters_support = false;
     GLContext::texture_cube_map_array_support = false;
     GLContext::texture_filter_anisotropic_support = false;
@@ -393,6 +394,7 @@ bool GLContext::direct_state_access_support = false;
 bool GLContext::fixed_restart_index_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::shader_draw_parameters_support = false;
 bool GLContext::texture_cube_map_array_support = false;
 bool GLContext::texture_filter_anisotropic_support = false;
@@ -428,6 +430,11 @@ void GLBackend::capabilities_init()
   GLContext::fixed_restart_index_support = GLEW_ARB_ES3_compatibility;
   GLContext::multi_bind_support = GLEW_ARB_multi_bind;
   GLContext::multi_draw_indirect_support = GLEW_ARB_multi_draw_indirect;
+  if (GLEW_ARB_get_program_binary) {
+    GLint binary_format_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_format_len);
+    GLContext::program_binary_support = binary_format_len > 0;
+  }
   GLContext::shader_draw_parameters_support = GLEW_ARB_shader_draw_parameters;
   GLContext::texture_cube_map_array_support = GLEW_ARB_texture_cube_map_array;
   GLContext::texture_filter_anisotropic_support = GLEW_EXT_texture_filter_anisotropic;
@@ -441,6 +448,10 @@ void GLBackend::capabilities_init()
     GLContext::debug_layer_support = false;
     GLContext::debug_layer_workaround = false;
   }
+  /* Always compile from source when debugging so the compilation logs are printed. */
+  if (G.debug & G_DEBUG_GPU) {
+    GLContext::program_binary_support = false;
+  }
 }
 
 /** \} */
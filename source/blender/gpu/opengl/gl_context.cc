@@ -113,6 +113,8 @@ GLContext::~GLContext()
     cache->clear();
   }
   glDeleteBuffers(1, &default_attr_vbo_);
+  /* Invalid handles are silently ignored. */
+  glDeleteBuffers(ARRAY_SIZE(unpack_buffers_), unpack_buffers_);
 }
 
 /** \} */
@@ -304,6 +306,34 @@ void GLContext::vao_cache_unregister(GLVaoCache *cache)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Texture upload staging
+ *
+ * Uploading from client memory makes the driver copy the pixels before the upload call returns,
+ * and stall if the texture is still in use by the GPU. Copying to a pixel unpack buffer first
+ * lets the transfer to the texture happen asynchronously.
+ * \{ */
+
+/**
+ * Copy \a data to the next staging buffer and leave it bound to #GL_PIXEL_UNPACK_BUFFER.
+ * Texture updates then need to use a null data pointer (offset 0 in the buffer) and unbind the
+ * buffer afterwards.
+ */
+void GLContext::unpack_buffer_push(const void *data, size_t size)
+{
+  GLuint &buffer = unpack_buffers_[unpack_buffer_index_];
+  unpack_buffer_index_ = (unpack_buffer_index_ + 1) % ARRAY_SIZE(unpack_buffers_);
+  if (buffer == 0) {
+    glGenBuffers(1, &buffer);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+  /* Orphan the previous storage so this never waits for an upload that is still in flight. */
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, data);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Memory statistics
  * \{ */
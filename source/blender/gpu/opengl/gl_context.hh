@@ -69,6 +69,7 @@ class GLContext : public Context {
   static bool fixed_restart_index_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool texture_cube_map_array_support;
   static bool texture_filter_anisotropic_support;
@@ -85,6 +86,9 @@ class GLContext : public Context {
   /** Used for debugging purpose. Bitflags of all bound slots. */
   uint16_t bound_ubo_slots;
 
+  /** Texture updates larger than this are uploaded through #unpack_buffer_push(). */
+  static constexpr size_t unpack_buffer_min_size = 1024 * 1024;
+
  private:
   /**
    * GPUBatch & GPUFramebuffer have references to the context they are from, in the case the
@@ -99,6 +103,9 @@ class GLContext : public Context {
   Vector<GLuint> orphaned_framebuffers_;
   /** GLBackend onws this data. */
   GLSharedOrphanLists &shared_orphan_list_;
+  /** Ring of staging buffers for texture uploads. Buffers are created on first use. */
+  GLuint unpack_buffers_[3] = {0};
+  int unpack_buffer_index_ = 0;
 
  public:
   GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list);
@@ -132,6 +139,8 @@ class GLContext : public Context {
   static void buf_free(GLuint buf_id);
   static void tex_free(GLuint tex_id);
 
+  void unpack_buffer_push(const void *data, size_t size);
+
   void vao_cache_register(GLVaoCache *cache);
   void vao_cache_unregister(GLVaoCache *cache);
 
@@ -21,11 +21,25 @@
  * \ingroup gpu
  */
 
+#include <algorithm>
+#include <mutex>
+#include <sys/stat.h>
+
+#include "BKE_appdir.h"
+#include "BKE_blender_version.h"
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#endif
+
 #include "GPU_platform.h"
 
 #include "gl_backend.hh"
@@ -120,9 +134,6 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get();
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
 
@@ -157,27 +168,52 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+GLuint &GLShader::stage_handle_get(GLenum gl_stage)
+{
+  switch (gl_stage) {
+    case GL_GEOMETRY_SHADER:
+      return geom_shader_;
+    case GL_FRAGMENT_SHADER:
+      return frag_shader_;
+    default:
+      BLI_assert(gl_stage == GL_VERTEX_SHADER);
+      return vert_shader_;
+  }
+}
+
+void GLShader::stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get();
+
+  if (GLContext::program_binary_support) {
+    std::string source;
+    for (const char *src : sources) {
+      source += src;
+    }
+    deferred_stages_.append({gl_stage, std::move(source)});
+    return;
+  }
+  this->stage_handle_get(gl_stage) = this->create_shader_stage(gl_stage, sources);
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  this->stage_from_glsl(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  this->stage_from_glsl(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  this->stage_from_glsl(GL_FRAGMENT_SHADER, sources);
 }
 
-bool GLShader::finalize()
+bool GLShader::link_program()
 {
-  if (compilation_failed_) {
-    return false;
-  }
-
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -189,6 +225,222 @@ bool GLShader::finalize()
     this->print_log(sources, log, "Linking", true);
     return false;
   }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are stored on disk using `GL_ARB_get_program_binary`, in a directory of the
+ * user's configuration that only the user can access. The file name is a hash of the patched
+ * sources of every stage and of the driver identification, so a driver update or any change in
+ * the generated code simply results in a cache miss. Files that the driver refuses to load are
+ * recompiled from source and overwritten. The oldest files are removed on startup when the
+ * cache grows over #PROGRAM_BINARY_CACHE_SIZE_MAX.
+ * \{ */
+
+#define PROGRAM_BINARY_MAGIC "BPB2"
+#define PROGRAM_BINARY_CACHE_SIZE_MAX ((size_t)256 * 1024 * 1024)
+
+struct ProgramBinaryHeader {
+  char magic[4];
+  GLenum format;
+  /** Hash of the driver identification and Blender version the binary was written by. */
+  uchar driver_digest[16];
+};
+
+static const std::string &program_binary_driver_id_get()
+{
+  static std::string driver_id;
+  static std::once_flag driver_id_once;
+  std::call_once(driver_id_once, []() {
+    const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (GLenum name : names) {
+      const char *str = (const char *)glGetString(name);
+      driver_id += (str) ? str : "";
+      driver_id += '\n';
+    }
+    driver_id += std::to_string(BLENDER_VERSION) + "." + std::to_string(BLENDER_FILE_SUBVERSION);
+  });
+  return driver_id;
+}
+
+static const uchar *program_binary_driver_digest_get()
+{
+  static uchar digest[16];
+  static std::once_flag digest_once;
+  std::call_once(digest_once, []() {
+    const std::string &driver_id = program_binary_driver_id_get();
+    BLI_hash_md5_buffer(driver_id.data(), driver_id.size(), digest);
+  });
+  return digest;
+}
+
+/* Remove the least recently written files until the cache is well below its maximum size. */
+static void program_binary_cache_trim(const char *dir)
+{
+  struct direntry *files;
+  const uint files_len = BLI_filelist_dir_contents(dir, &files);
+
+  Vector<const direntry *> binaries;
+  size_t size = 0;
+  for (uint i = 0; i < files_len; i++) {
+    if (S_ISREG(files[i].type)) {
+      binaries.append(&files[i]);
+      size += (size_t)files[i].s.st_size;
+    }
+  }
+
+  if (size > PROGRAM_BINARY_CACHE_SIZE_MAX) {
+    std::sort(binaries.begin(), binaries.end(), [](const direntry *a, const direntry *b) {
+      return a->s.st_mtime < b->s.st_mtime;
+    });
+    for (const direntry *file : binaries) {
+      if (size <= PROGRAM_BINARY_CACHE_SIZE_MAX / 2) {
+        break;
+      }
+      if (BLI_delete(file->path, false, false) == 0) {
+        size -= (size_t)file->s.st_size;
+      }
+    }
+  }
+
+  BLI_filelist_free(files, files_len);
+}
+
+static const char *program_binary_cache_dir_get()
+{
+  static char dir[FILE_MAX] = "";
+  static std::once_flag dir_once;
+  std::call_once(dir_once, []() {
+    const char *cache_dir = BKE_appdir_folder_id_create(BLENDER_USER_DATAFILES, "shader_cache");
+    if (cache_dir == nullptr || !BLI_is_dir(cache_dir)) {
+      return;
+    }
+#ifndef WIN32
+    /* Binaries are loaded without any verification by the driver, other users must not be able
+     * to put files in the cache. */
+    if (chmod(cache_dir, S_IRWXU) != 0) {
+      return;
+    }
+#endif
+    BLI_strncpy(dir, cache_dir, sizeof(dir));
+    program_binary_cache_trim(dir);
+  });
+  return dir;
+}
+
+/* Return false if the cache directory is not available. */
+static bool program_binary_filepath_get(Span<std::string> stage_sources, char r_filepath[FILE_MAX])
+{
+  const char *dir = program_binary_cache_dir_get();
+  if (dir[0] == '\0') {
+    return false;
+  }
+  std::string key = program_binary_driver_id_get();
+  for (const std::string &source : stage_sources) {
+    key += source;
+    /* Separate the stages so that moving code from one stage to the next changes the key. */
+    key += '\0';
+  }
+  uchar digest[16];
+  char digest_hex[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, digest_hex);
+
+  BLI_path_join(r_filepath, FILE_MAX, dir, digest_hex, NULL);
+  return true;
+}
+
+static bool program_binary_load(GLuint program, const char *filepath)
+{
+  size_t size = 0;
+  char *data = (char *)BLI_file_read_binary_as_mem(filepath, 0, &size);
+  if (data == nullptr) {
+    return false;
+  }
+  GLint status = 0;
+  const ProgramBinaryHeader *header = (const ProgramBinaryHeader *)data;
+  if (size > sizeof(*header) && STREQLEN(header->magic, PROGRAM_BINARY_MAGIC, 4) &&
+      memcmp(header->driver_digest, program_binary_driver_digest_get(), 16) == 0) {
+    glProgramBinary(program, header->format, data + sizeof(*header), size - sizeof(*header));
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+  }
+  MEM_freeN(data);
+  return status != 0;
+}
+
+static void program_binary_save(GLuint program, const char *filepath)
+{
+  GLint binary_len = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+  const size_t size = sizeof(ProgramBinaryHeader) + binary_len;
+  char *data = (char *)MEM_mallocN(size, __func__);
+  ProgramBinaryHeader *header = (ProgramBinaryHeader *)data;
+  memcpy(header->magic, PROGRAM_BINARY_MAGIC, sizeof(header->magic));
+  memcpy(header->driver_digest, program_binary_driver_digest_get(), sizeof(header->driver_digest));
+  glGetProgramBinary(program, binary_len, nullptr, &header->format, data + sizeof(*header));
+
+  /* Write to a temporary file first so that other sessions never read a partial binary. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)data);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file) {
+    const bool written = fwrite(data, size, 1, file) == 1;
+    fclose(file);
+    if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+      BLI_delete(filepath_tmp, false, false);
+    }
+  }
+  MEM_freeN(data);
+}
+
+bool GLShader::finalize()
+{
+  if (compilation_failed_) {
+    return false;
+  }
+
+  if (!deferred_stages_.is_empty()) {
+    Vector<std::string> stage_sources;
+    for (DeferredStage &stage : deferred_stages_) {
+      stage_sources.append(std::to_string(stage.gl_stage) + stage.source);
+    }
+    char filepath[FILE_MAX];
+    const bool use_cache = program_binary_filepath_get(stage_sources, filepath);
+
+    if (use_cache && program_binary_load(shader_program_, filepath)) {
+      deferred_stages_.clear_and_make_inline();
+      interface = new GLShaderInterface(shader_program_);
+      return true;
+    }
+
+    for (DeferredStage &stage : deferred_stages_) {
+      const char *source = stage.source.c_str();
+      this->stage_handle_get(stage.gl_stage) = this->create_shader_stage(
+          stage.gl_stage, MutableSpan<const char *>(&source, 1));
+    }
+    deferred_stages_.clear_and_make_inline();
+    if (compilation_failed_) {
+      return false;
+    }
+
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    if (!this->link_program()) {
+      return false;
+    }
+    if (use_cache) {
+      program_binary_save(shader_program_, filepath);
+    }
+  }
+  else if (!this->link_program()) {
+    return false;
+  }
 
   interface = new GLShaderInterface(shader_program_);
 
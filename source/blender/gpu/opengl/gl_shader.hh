@@ -23,8 +23,12 @@
 
 #pragma once
 
+#include <string>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
 #include "gpu_shader_private.hh"
@@ -46,6 +50,16 @@ class GLShader : public Shader {
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
 
+  struct DeferredStage {
+    GLenum gl_stage;
+    std::string source;
+  };
+  /**
+   * Patched sources of each stage, only used with the program binary cache.
+   * Compilation is deferred to #finalize() so it can be skipped entirely on a cache hit.
+   */
+  Vector<DeferredStage> deferred_stages_;
+
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
  public:
@@ -78,6 +92,9 @@ class GLShader : public Shader {
   char *glsl_patch_get(void);
 
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint &stage_handle_get(GLenum gl_stage);
+  void stage_from_glsl(GLenum gl_stage, MutableSpan<const char *> sources);
+  bool link_program(void);
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
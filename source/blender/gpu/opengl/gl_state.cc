@@ -553,6 +553,7 @@ void GLStateManager::texture_bind_apply()
 void GLStateManager::texture_unpack_row_length_set(uint len)
 {
   glPixelStorei(GL_UNPACK_ROW_LENGTH, len);
+  unpack_row_length_ = len;
 }
 
 uint64_t GLStateManager::bound_texture_slots()
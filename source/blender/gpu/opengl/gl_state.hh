@@ -68,6 +68,9 @@ class GLStateManager : public StateManager {
   GLenum formats_[8] = {0};
   uint8_t dirty_image_binds_ = 0;
 
+  /** Current GL_UNPACK_ROW_LENGTH, needed to know the size of texture update data. */
+  uint unpack_row_length_ = 0;
+
  public:
   GLStateManager();
 
@@ -86,6 +89,10 @@ class GLStateManager : public StateManager {
   void image_unbind_all(void) override;
 
   void texture_unpack_row_length_set(uint len) override;
+  uint texture_unpack_row_length_get(void) const
+  {
+    return unpack_row_length_;
+  }
 
   uint64_t bound_texture_slots(void);
   uint8_t bound_image_slots(void);
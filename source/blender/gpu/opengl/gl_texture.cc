@@ -227,6 +227,32 @@ void GLTexture::update_sub_direct_state_access(
   }
 }
 
+/* Copy the update data to a staging buffer if it is large enough to be worth it.
+ * On success, \a r_data is replaced by the offset in the bound buffer. */
+bool GLTexture::update_sub_staging_begin(int extent[3], eGPUDataFormat type, const void **r_data)
+{
+  if ((format_flag_ & GPU_FORMAT_COMPRESSED) || type_ == GPU_TEXTURE_CUBE) {
+    return false;
+  }
+  GLContext *ctx = GLContext::get();
+  if (ctx == nullptr) {
+    return false;
+  }
+  /* Rows can be longer than the updated region when updating part of a larger image. */
+  const uint row_length = static_cast<GLStateManager *>(ctx->state_manager)
+                              ->texture_unpack_row_length_get();
+  const size_t row_len = (row_length != 0) ? row_length : extent[0];
+  const int dimensions = this->dimensions_count();
+  const size_t rows_len = ((dimensions > 1) ? extent[1] : 1) * ((dimensions > 2) ? extent[2] : 1);
+  const size_t size = (row_len * (rows_len - 1) + extent[0]) * to_bytesize(format_, type);
+  if (size < GLContext::unpack_buffer_min_size) {
+    return false;
+  }
+  ctx->unpack_buffer_push(*r_data, size);
+  *r_data = nullptr;
+  return true;
+}
+
 void GLTexture::update_sub(
     int mip, int offset[3], int extent[3], eGPUDataFormat type, const void *data)
 {
@@ -244,9 +270,16 @@ void GLTexture::update_sub(
   GLenum gl_format = to_gl_data_format(format_);
   GLenum gl_type = to_gl(type);
 
+  /* Upload large images through a staging buffer to not stall drawing, see
+   * #GLContext::unpack_buffer_push. */
+  const bool use_staging_buffer = this->update_sub_staging_begin(extent, type, &data);
+
   /* Some drivers have issues with cubemap & glTextureSubImage3D even if it is correct. */
   if (GLContext::direct_state_access_support && (type_ != GPU_TEXTURE_CUBE)) {
     this->update_sub_direct_state_access(mip, offset, extent, gl_format, gl_type, data);
+    if (use_staging_buffer) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
     return;
   }
 
@@ -288,6 +321,9 @@ void GLTexture::update_sub(
         break;
     }
   }
+  if (use_staging_buffer) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
 }
 
 /** This will create the mipmap images and populate them with filtered data from base level.
@@ -92,6 +92,7 @@ class GLTexture : public Texture {
  private:
   bool proxy_check(int mip);
   void ensure_mipmaps(int mip);
+  bool update_sub_staging_begin(int extent[3], eGPUDataFormat type, const void **r_data);
   void update_sub_direct_state_access(
       int mip, int offset[3], int extent[3], GLenum gl_format, GLenum gl_type, const void *data);
   GPUFrameBuffer *framebuffer_get(void);
@@ -32,6 +32,11 @@ void GLVertBuf::acquire_data()
   /* Discard previous data if any. */
   MEM_SAFE_FREE(data);
   data = (uchar *)MEM_mallocN(sizeof(uchar) * this->size_alloc_get(), __func__);
+  /* When filled again with the same size, start from the uploaded data so the parts the caller
+   * doesn't write aren't uploaded again, see #upload_changed_ranges. */
+  if (data_uploaded_ != nullptr && vbo_size_ == this->size_alloc_get()) {
+    memcpy(data, data_uploaded_, vbo_size_);
+  }
 }
 
 void GLVertBuf::resize_data()
@@ -45,9 +50,18 @@ void GLVertBuf::release_data()
     GLContext::buf_free(vbo_id_);
     vbo_id_ = 0;
     memory_usage -= vbo_size_;
+    vbo_size_ = 0;
   }
 
   MEM_SAFE_FREE(data);
+  MEM_SAFE_FREE(data_uploaded_);
+}
+
+void GLVertBuf::release_data_keep_storage()
+{
+  MEM_SAFE_FREE(data_uploaded_);
+  data_uploaded_ = data;
+  data = nullptr;
 }
 
 void GLVertBuf::duplicate_data(VertBuf *dst_)
@@ -55,6 +69,7 @@ void GLVertBuf::duplicate_data(VertBuf *dst_)
   BLI_assert(GLContext::get() != nullptr);
   GLVertBuf *src = this;
   GLVertBuf *dst = static_cast<GLVertBuf *>(dst_);
+  dst->data_uploaded_ = nullptr;
 
   if (src->vbo_id_ != 0) {
     dst->vbo_size_ = src->size_used_get();
@@ -91,12 +106,19 @@ void GLVertBuf::bind()
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id_);
 
   if (flag & GPU_VERTBUF_DATA_DIRTY) {
-    vbo_size_ = this->size_used_get();
-    /* Orphan the vbo to avoid sync then upload data. */
-    glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
-
-    memory_usage += vbo_size_;
+    if (data_uploaded_ != nullptr && vbo_size_ == this->size_used_get()) {
+      this->upload_changed_ranges();
+    }
+    else {
+      memory_usage -= vbo_size_;
+      vbo_size_ = this->size_used_get();
+      /* Orphan the vbo to avoid sync then upload data. */
+      glBufferData(GL_ARRAY_BUFFER, vbo_size_, nullptr, to_gl(usage_));
+      glBufferSubData(GL_ARRAY_BUFFER, 0, vbo_size_, data);
+
+      memory_usage += vbo_size_;
+    }
+    MEM_SAFE_FREE(data_uploaded_);
 
     if (usage_ == GPU_USAGE_STATIC) {
       MEM_SAFE_FREE(data);
@@ -106,6 +128,32 @@ void GLVertBuf::bind()
   }
 }
 
+/**
+ * Compare the data with the previously uploaded data in blocks, and only upload the blocks that
+ * differ. Adjacent changed blocks are uploaded together.
+ */
+void GLVertBuf::upload_changed_ranges()
+{
+  const size_t block_size = 16 * 1024;
+  size_t range_start = 0;
+  bool in_range = false;
+  for (size_t offset = 0; offset < vbo_size_; offset += block_size) {
+    const size_t len = MIN2(block_size, vbo_size_ - offset);
+    const bool changed = memcmp(data + offset, data_uploaded_ + offset, len) != 0;
+    if (changed && !in_range) {
+      range_start = offset;
+      in_range = true;
+    }
+    else if (!changed && in_range) {
+      glBufferSubData(GL_ARRAY_BUFFER, range_start, offset - range_start, data + range_start);
+      in_range = false;
+    }
+  }
+  if (in_range) {
+    glBufferSubData(GL_ARRAY_BUFFER, range_start, vbo_size_ - range_start, data + range_start);
+  }
+}
+
 void GLVertBuf::update_sub(uint start, uint len, void *data)
 {
   glBufferSubData(GL_ARRAY_BUFFER, start, len, data);
@@ -41,6 +41,11 @@ class GLVertBuf : public VertBuf {
   GLuint vbo_id_ = 0;
   /** Size on the GPU. */
   size_t vbo_size_ = 0;
+  /**
+   * Copy of the data on the GPU, kept by #release_data_keep_storage so the next upload of the
+   * same size only updates the ranges that changed.
+   */
+  uchar *data_uploaded_ = nullptr;
 
  public:
   void bind(void);
@@ -51,9 +56,13 @@ class GLVertBuf : public VertBuf {
   void acquire_data(void) override;
   void resize_data(void) override;
   void release_data(void) override;
+  void release_data_keep_storage(void) override;
   void upload_data(void) override;
   void duplicate_data(VertBuf *dst) override;
 
+ private:
+  void upload_changed_ranges(void);
+
   MEM_CXX_CLASS_ALLOC_FUNCS("GLVertBuf");
 };
 
@@ -172,6 +172,10 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Decode movies on the GPU when FFmpeg has a hardware decoder for them. */
+  IB_animhwdecode = 1 << 19,
+  /** Don't read the passes of multilayer EXR files, see #IMB_exr_open_deferred. */
+  IB_multilayer_deferred = 1 << 20,
 } eImBufFlags;
 
 /** \} */
@@ -80,6 +80,9 @@
 
 #define MAXNUMSTREAMS 50
 
+/* Number of decoded frames kept per movie, see #anim.frame_ring. */
+#define ANIM_FRAME_RING_SIZE 4
+
 struct IDProperty;
 struct _AviMovie;
 struct anim_index;
@@ -130,12 +133,31 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /** Source format of #img_convert_ctx, hardware decoded frames can differ from the codec. */
+  enum AVPixelFormat img_convert_pix_fmt;
   int videoStream;
 
+  /** Hardware decoder device, only with #IB_animhwdecode. */
+  AVBufferRef *hw_device_ctx;
+  enum AVPixelFormat hw_pix_fmt;
+  /** Hardware decoded frames copied to system memory. */
+  AVFrame *pFrameHWTransfer;
+
   struct ImBuf *last_frame;
   int64_t last_pts;
   int64_t next_pts;
   AVPacket next_packet;
+  /* Position of #last_frame, where the decoder continues from. Differs from #curposition when
+   * the returned frame came from the frame ring. */
+  int decoder_position;
+
+  /* Recently decoded frames, so scrubbing back doesn't seek and decode a whole GOP again. */
+  struct {
+    struct ImBuf *ibuf;
+    int64_t pts;
+    int64_t next_pts;
+  } frame_ring[ANIM_FRAME_RING_SIZE];
+  int frame_ring_next;
 #endif
 
   char index_dir[768];
@@ -151,3 +173,9 @@ struct anim {
 
   struct IDProperty *metadata;
 };
+
+#ifdef WITH_FFMPEG
+void ffmpeg_codec_context_set_threads(AVCodecContext *codec_ctx,
+                                      const AVCodec *codec,
+                                      const bool use_frame_threads);
+#endif
@@ -55,6 +55,7 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -82,6 +83,10 @@
 #  include <libswscale/swscale.h>
 
 #  include "ffmpeg_compat.h"
+
+#  ifdef FFMPEG_HAVE_HW_CONFIG
+#    include <libavutil/hwcontext.h>
+#  endif
 #endif /* WITH_FFMPEG */
 
 int ismovie(const char *UNUSED(filepath))
@@ -505,6 +510,135 @@ BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
   return (anim->x & 31) != 0;
 }
 
+/* Let FFmpeg decode or encode with all threads. Frame threading scales better than slice
+ * threading for long GOP codecs, but delays the output by a frame per thread. */
+void ffmpeg_codec_context_set_threads(AVCodecContext *codec_ctx,
+                                      const AVCodec *codec,
+                                      const bool use_frame_threads)
+{
+  if (codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+    codec_ctx->thread_count = 0;
+  }
+  else {
+    codec_ctx->thread_count = BLI_system_thread_count();
+  }
+
+  if (use_frame_threads && (codec->capabilities & AV_CODEC_CAP_FRAME_THREADS)) {
+    codec_ctx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
+    codec_ctx->thread_type = FF_THREAD_SLICE;
+  }
+}
+
+#  ifdef FFMPEG_HAVE_HW_CONFIG
+static enum AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *codec_ctx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  const struct anim *anim = codec_ctx->opaque;
+
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The device can't decode this stream (profile, bit depth...), decode it in software. */
+  return avcodec_default_get_format(codec_ctx, pix_fmts);
+}
+#  endif
+
+/* Use the first hardware device FFmpeg can decode this codec with, returns false when there is
+ * none and the codec decodes in software. */
+static bool ffmpeg_hw_decoder_init(struct anim *anim,
+                                   AVCodecContext *codec_ctx,
+                                   const AVCodec *codec)
+{
+#  ifdef FFMPEG_HAVE_HW_CONFIG
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+    if (config == NULL) {
+      return false;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+    if (av_hwdevice_ctx_create(&anim->hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    anim->hw_pix_fmt = config->pix_fmt;
+    codec_ctx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+    codec_ctx->opaque = anim;
+    codec_ctx->get_format = ffmpeg_get_hw_format;
+    /* The device decodes in parallel itself, decoder threads would only add latency. */
+    codec_ctx->thread_count = 1;
+    return true;
+  }
+#  else
+  UNUSED_VARS(anim, codec_ctx, codec);
+  return false;
+#  endif
+}
+
+static struct SwsContext *ffmpeg_sws_context_create(struct anim *anim,
+                                                    enum AVPixelFormat pix_fmt)
+{
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+#  endif
+
+  struct SwsContext *sws_ctx = sws_getContext(anim->x,
+                                              anim->y,
+                                              pix_fmt,
+                                              anim->x,
+                                              anim->y,
+                                              AV_PIX_FMT_RGBA,
+                                              SWS_FAST_BILINEAR | SWS_PRINT_INFO |
+                                                  SWS_FULL_CHR_H_INT,
+                                              NULL,
+                                              NULL,
+                                              NULL);
+  if (!sws_ctx) {
+    return NULL;
+  }
+
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(sws_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(sws_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+#  endif
+
+  anim->img_convert_pix_fmt = pix_fmt;
+  return sws_ctx;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -518,13 +652,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-#  endif
-
   if (anim == NULL) {
     return (-1);
   }
@@ -572,13 +699,23 @@ static int startffmpeg(struct anim *anim)
   }
 
   pCodecCtx->workaround_bugs = 1;
+  ffmpeg_codec_context_set_threads(pCodecCtx, pCodec, true);
+
+  anim->hw_device_ctx = NULL;
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  /* Deinterlacing works on the codec pixel format, hardware frames are transferred to another. */
+  if ((anim->ib_flags & IB_animhwdecode) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decoder_init(anim, pCodecCtx, pCodec);
+  }
 
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_close(anim->pCodecCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -636,6 +773,7 @@ static int startffmpeg(struct anim *anim)
   anim->framesize = anim->x * anim->y * 4;
 
   anim->curposition = -1;
+  anim->decoder_position = -1;
   anim->last_frame = 0;
   anim->last_pts = -1;
   anim->next_pts = -1;
@@ -645,6 +783,7 @@ static int startffmpeg(struct anim *anim)
   anim->pFrameComplete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
+  anim->pFrameHWTransfer = av_frame_alloc();
 
   if (need_aligned_ffmpeg_buffer(anim)) {
     anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
@@ -658,6 +797,8 @@ static int startffmpeg(struct anim *anim)
       av_frame_free(&anim->pFrameRGB);
       av_frame_free(&anim->pFrameDeinterlaced);
       av_frame_free(&anim->pFrame);
+      av_frame_free(&anim->pFrameHWTransfer);
+      av_buffer_unref(&anim->hw_device_ctx);
       anim->pCodecCtx = NULL;
       return -1;
     }
@@ -670,6 +811,8 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHWTransfer);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -692,16 +835,7 @@ static int startffmpeg(struct anim *anim)
     anim->preseek = 0;
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_FAST_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -710,39 +844,12 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHWTransfer);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-#  endif
-
   return 0;
 }
 
@@ -762,6 +869,25 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+#  ifdef FFMPEG_HAVE_HW_CONFIG
+  if (input->format == anim->hw_pix_fmt && anim->hw_device_ctx) {
+    av_frame_unref(anim->pFrameHWTransfer);
+    if (av_hwframe_transfer_data(anim->pFrameHWTransfer, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not transfer the hardware frame...\n");
+      return;
+    }
+    input = anim->pFrameHWTransfer;
+  }
+#  endif
+
+  if (input->format != anim->img_convert_pix_fmt) {
+    sws_freeContext(anim->img_convert_ctx);
+    anim->img_convert_ctx = ffmpeg_sws_context_create(anim, input->format);
+    if (!anim->img_convert_ctx) {
+      return;
+    }
+  }
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -1045,6 +1171,41 @@ static int ffmpeg_seek_by_byte(AVFormatContext *pFormatCtx)
   return false;
 }
 
+static ImBuf *ffmpeg_frame_ring_lookup(struct anim *anim, int64_t pts)
+{
+  for (int i = 0; i < ANIM_FRAME_RING_SIZE; i++) {
+    if (anim->frame_ring[i].ibuf && anim->frame_ring[i].pts <= pts &&
+        anim->frame_ring[i].next_pts > pts) {
+      return anim->frame_ring[i].ibuf;
+    }
+  }
+  return NULL;
+}
+
+static void ffmpeg_frame_ring_add(struct anim *anim, ImBuf *ibuf, int64_t pts, int64_t next_pts)
+{
+  if (ffmpeg_frame_ring_lookup(anim, pts)) {
+    return;
+  }
+
+  const int index = anim->frame_ring_next;
+  IMB_freeImBuf(anim->frame_ring[index].ibuf);
+  IMB_refImBuf(ibuf);
+  anim->frame_ring[index].ibuf = ibuf;
+  anim->frame_ring[index].pts = pts;
+  /* The next frame isn't known at the end of the stream. */
+  anim->frame_ring[index].next_pts = (next_pts > pts) ? next_pts : pts + 1;
+  anim->frame_ring_next = (index + 1) % ANIM_FRAME_RING_SIZE;
+}
+
+static void ffmpeg_frame_ring_free(struct anim *anim)
+{
+  for (int i = 0; i < ANIM_FRAME_RING_SIZE; i++) {
+    IMB_freeImBuf(anim->frame_ring[i].ibuf);
+    anim->frame_ring[i].ibuf = NULL;
+  }
+}
+
 static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Type tc)
 {
   int64_t pts_to_search = 0;
@@ -1075,7 +1236,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
   if (tc_index) {
     new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
-    old_frame_index = IMB_indexer_get_frame_index(tc_index, anim->curposition);
+    old_frame_index = IMB_indexer_get_frame_index(tc_index, anim->decoder_position);
     pts_to_search = IMB_indexer_get_pts(tc_index, new_frame_index);
   }
   else {
@@ -1103,11 +1264,21 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
            (int64_t)anim->next_pts);
     IMB_refImBuf(anim->last_frame);
     anim->curposition = position;
+    anim->decoder_position = position;
     return anim->last_frame;
   }
 
-  if (position > anim->curposition + 1 && anim->preseek && !tc_index &&
-      position - (anim->curposition + 1) < anim->preseek) {
+  /* The decoder state stays where it is, only the current position changes. */
+  ImBuf *ring_frame = ffmpeg_frame_ring_lookup(anim, pts_to_search);
+  if (ring_frame) {
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: frame ring hit\n");
+    IMB_refImBuf(ring_frame);
+    anim->curposition = position;
+    return ring_frame;
+  }
+
+  if (position > anim->decoder_position + 1 && anim->preseek && !tc_index &&
+      position - (anim->decoder_position + 1) < anim->preseek) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: within preseek interval (no index)\n");
 
     ffmpeg_decode_video_frame_scan(anim, pts_to_search);
@@ -1120,7 +1291,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
     ffmpeg_decode_video_frame_scan(anim, pts_to_search);
   }
-  else if (position != anim->curposition + 1) {
+  else if (position != anim->decoder_position + 1) {
     long long pos;
     int ret;
 
@@ -1193,7 +1364,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
       ffmpeg_decode_video_frame_scan(anim, pts_to_search);
     }
   }
-  else if (position == 0 && anim->curposition == -1) {
+  else if (position == 0 && anim->decoder_position == -1) {
     /* first frame without seeking special case... */
     ffmpeg_decode_video_frame(anim);
   }
@@ -1233,7 +1404,10 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
   ffmpeg_decode_video_frame(anim);
 
+  ffmpeg_frame_ring_add(anim, anim->last_frame, anim->last_pts, anim->next_pts);
+
   anim->curposition = position;
+  anim->decoder_position = position;
 
   IMB_refImBuf(anim->last_frame);
 
@@ -1267,9 +1441,12 @@ static void free_anim_ffmpeg(struct anim *anim)
     }
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHWTransfer);
+    av_buffer_unref(&anim->hw_device_ctx);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->last_frame);
+    ffmpeg_frame_ring_free(anim);
     if (anim->next_packet.stream_index != -1) {
       av_free_packet(&anim->next_packet);
     }
@@ -1426,10 +1603,8 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
 #endif
 #ifdef WITH_FFMPEG
     case ANIM_FFMPEG:
+      /* Sets the current position itself, it also tracks the decoder position separately. */
       ibuf = ffmpeg_fetchibuf(anim, position, tc);
-      if (ibuf) {
-        anim->curposition = position;
-      }
       filter_y = 0; /* done internally */
       break;
 #endif
@@ -1439,7 +1614,7 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
     if (filter_y) {
       IMB_filtery(ibuf);
     }
-    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, anim->curposition + 1);
+    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, position + 1);
   }
   return ibuf;
 }
@@ -27,6 +27,10 @@
 #include <math.h>
 #include <string.h>
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
 #include "DNA_movieclip_types.h"
@@ -45,8 +49,10 @@
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
 #include "BLI_math_color.h"
+#include "BLI_rand.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_appdir.h"
@@ -104,6 +110,10 @@ typedef struct ColormanageProcessor {
   OCIO_ConstProcessorRcPtr *processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+
+  /* Optional baked LUT for display transforms, see #display_lut_acquire. */
+  struct DisplayLUT *display_lut;
+  float exposure_gain;
 } ColormanageProcessor;
 
 static struct global_glsl_state {
@@ -138,6 +148,8 @@ static struct global_color_picking_state {
   bool failed;
 } global_color_picking_state = {NULL};
 
+static void display_lut_exit(void);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -755,6 +767,8 @@ void colormanagement_exit(void)
     OCIO_processorRelease(global_color_picking_state.processor_from);
   }
 
+  display_lut_exit();
+
   memset(&global_glsl_state, 0, sizeof(global_glsl_state));
   memset(&global_color_picking_state, 0, sizeof(global_color_picking_state));
 
@@ -1481,6 +1495,399 @@ const float *IMB_colormangement_get_xyz_to_rgb()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Baked Display LUT
+ *
+ * Display transforms of full buffers which end up in 8 bit display buffers can use a 3D LUT
+ * baked from the OCIO processor instead of evaluating the processor for every pixel.
+ * The LUT is indexed through a logarithmic shaper, so scene linear values up to about 1000 are
+ * covered and 1.0 lands exactly on a grid point, where the Standard view transform clips.
+ * Pixels outside of the covered range use the exact processor, and the LUT is not used at all
+ * when it doesn't match the processor within #DISPLAY_LUT_TOLERANCE.
+ *
+ * Exposure is applied before the lookup instead of being baked, so changing it doesn't
+ * invalidate the LUT. Only the most recently used LUT is kept.
+ * \{ */
+
+#define DISPLAY_LUT_SIZE 65
+/* Offset of the shaper, values below it are sampled about linearly. */
+#define DISPLAY_LUT_OFFSET (1.0f / 1024.0f)
+/* Grid point of 1.0, which puts the end of the shaper range at about 1026. */
+#define DISPLAY_LUT_ONE_INDEX 32
+#define DISPLAY_LUT_TOLERANCE (0.5f / 255.0f)
+/* Don't bake a LUT for buffers with less pixels than the LUT has entries. */
+#define DISPLAY_LUT_MIN_PIXELS (DISPLAY_LUT_SIZE * DISPLAY_LUT_SIZE * DISPLAY_LUT_SIZE)
+
+typedef struct DisplayLUT {
+  /* Settings the LUT has been baked for. */
+  char look[MAX_COLORSPACE_NAME];
+  char view[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  float gamma;
+
+  /* Shaper mapping of scene linear values to the [0, 1] range of the grid. */
+  float shaper_log_min, shaper_inv_range, max_value;
+
+  /* RGB triplets with red varying fastest, followed by one float of padding so the last
+   * entry can be loaded in a SIMD register. NULL when the LUT isn't accurate enough. */
+  float *table;
+
+  /* Processors using the LUT, protected by #processor_lock. */
+  int users;
+} DisplayLUT;
+
+/* Most recently baked LUT, protected by #processor_lock. */
+static DisplayLUT *global_display_lut = NULL;
+
+BLI_INLINE float display_lut_shaper(const DisplayLUT *lut, float value)
+{
+  return (log2f(value + DISPLAY_LUT_OFFSET) - lut->shaper_log_min) * lut->shaper_inv_range;
+}
+
+BLI_INLINE float display_lut_shaper_inverse(const DisplayLUT *lut, float value)
+{
+  return exp2f(value / lut->shaper_inv_range + lut->shaper_log_min) - DISPLAY_LUT_OFFSET;
+}
+
+#ifdef __SSE2__
+/* Polynomial approximation of log2 for positive normalized values, accurate to about 1e-5,
+ * which is plenty for placing a value on the grid. */
+BLI_INLINE __m128 display_lut_fast_log2(__m128 value)
+{
+  const __m128i bits = _mm_castps_si128(value);
+  const __m128 exponent = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+  const __m128 mantissa = _mm_or_ps(
+      _mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(1.0f));
+
+  __m128 poly = _mm_set1_ps(-3.4436006e-2f);
+  poly = _mm_add_ps(_mm_mul_ps(poly, mantissa), _mm_set1_ps(3.1821337e-1f));
+  poly = _mm_add_ps(_mm_mul_ps(poly, mantissa), _mm_set1_ps(-1.2315303f));
+  poly = _mm_add_ps(_mm_mul_ps(poly, mantissa), _mm_set1_ps(2.5988452f));
+  poly = _mm_add_ps(_mm_mul_ps(poly, mantissa), _mm_set1_ps(-3.3241990f));
+  poly = _mm_add_ps(_mm_mul_ps(poly, mantissa), _mm_set1_ps(3.1157899f));
+
+  return _mm_add_ps(_mm_mul_ps(poly, _mm_sub_ps(mantissa, _mm_set1_ps(1.0f))), exponent);
+}
+#endif
+
+/* Look up \a rgb with trilinear interpolation, returns false when it's outside of the LUT. */
+BLI_INLINE bool display_lut_evaluate(const DisplayLUT *lut, const float rgb[3], float r_rgb[3])
+{
+  const int size = DISPLAY_LUT_SIZE;
+  int index[3];
+  float fac[3];
+
+#ifdef __SSE2__
+  const __m128 value = _mm_set_ps(0.0f, rgb[2], rgb[1], rgb[0]);
+  /* Also rejects NaN. */
+  const __m128 in_range = _mm_and_ps(_mm_cmpge_ps(value, _mm_setzero_ps()),
+                                     _mm_cmple_ps(value, _mm_set1_ps(lut->max_value)));
+  if (_mm_movemask_ps(in_range) != 0xF) {
+    return false;
+  }
+  float position[4];
+  _mm_storeu_ps(position,
+                _mm_mul_ps(_mm_sub_ps(display_lut_fast_log2(
+                                          _mm_add_ps(value, _mm_set1_ps(DISPLAY_LUT_OFFSET))),
+                                      _mm_set1_ps(lut->shaper_log_min)),
+                           _mm_set1_ps(lut->shaper_inv_range * (size - 1))));
+  for (int i = 0; i < 3; i++) {
+    index[i] = min_ii((int)position[i], size - 2);
+    fac[i] = position[i] - index[i];
+  }
+#else
+  for (int i = 0; i < 3; i++) {
+    /* Also rejects NaN. */
+    if (!(rgb[i] >= 0.0f && rgb[i] <= lut->max_value)) {
+      return false;
+    }
+    const float position = display_lut_shaper(lut, rgb[i]) * (size - 1);
+    index[i] = min_ii((int)position, size - 2);
+    fac[i] = position - index[i];
+  }
+#endif
+
+  const size_t stride_g = 3 * size;
+  const size_t stride_b = stride_g * size;
+  const float *p = lut->table + 3 * (size_t)index[0] + stride_g * index[1] + stride_b * index[2];
+
+#ifdef __SSE2__
+  const __m128 fac_r = _mm_set1_ps(fac[0]);
+  const __m128 fac_g = _mm_set1_ps(fac[1]);
+  const __m128 fac_b = _mm_set1_ps(fac[2]);
+  __m128 c00 = _mm_loadu_ps(p);
+  __m128 c10 = _mm_loadu_ps(p + stride_g);
+  __m128 c01 = _mm_loadu_ps(p + stride_b);
+  __m128 c11 = _mm_loadu_ps(p + stride_b + stride_g);
+  c00 = _mm_add_ps(c00, _mm_mul_ps(fac_r, _mm_sub_ps(_mm_loadu_ps(p + 3), c00)));
+  c10 = _mm_add_ps(c10, _mm_mul_ps(fac_r, _mm_sub_ps(_mm_loadu_ps(p + stride_g + 3), c10)));
+  c01 = _mm_add_ps(c01, _mm_mul_ps(fac_r, _mm_sub_ps(_mm_loadu_ps(p + stride_b + 3), c01)));
+  c11 = _mm_add_ps(
+      c11, _mm_mul_ps(fac_r, _mm_sub_ps(_mm_loadu_ps(p + stride_b + stride_g + 3), c11)));
+  c00 = _mm_add_ps(c00, _mm_mul_ps(fac_g, _mm_sub_ps(c10, c00)));
+  c01 = _mm_add_ps(c01, _mm_mul_ps(fac_g, _mm_sub_ps(c11, c01)));
+  c00 = _mm_add_ps(c00, _mm_mul_ps(fac_b, _mm_sub_ps(c01, c00)));
+
+  float result[4];
+  _mm_storeu_ps(result, c00);
+  copy_v3_v3(r_rgb, result);
+#else
+  float c00[3], c10[3], c01[3], c11[3];
+  interp_v3_v3v3(c00, p, p + 3, fac[0]);
+  interp_v3_v3v3(c10, p + stride_g, p + stride_g + 3, fac[0]);
+  interp_v3_v3v3(c01, p + stride_b, p + stride_b + 3, fac[0]);
+  interp_v3_v3v3(c11, p + stride_b + stride_g, p + stride_b + stride_g + 3, fac[0]);
+  interp_v3_v3v3(c00, c00, c10, fac[1]);
+  interp_v3_v3v3(c01, c01, c11, fac[1]);
+  interp_v3_v3v3(r_rgb, c00, c01, fac[2]);
+#endif
+
+  return true;
+}
+
+typedef struct DisplayLUTBakeData {
+  const DisplayLUT *lut;
+  OCIO_ConstProcessorRcPtr *processor;
+  float grid_values[DISPLAY_LUT_SIZE];
+} DisplayLUTBakeData;
+
+static void display_lut_bake_slice(void *__restrict userdata,
+                                   const int index_b,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DisplayLUTBakeData *data = (DisplayLUTBakeData *)userdata;
+  const int size = DISPLAY_LUT_SIZE;
+  float *slice = data->lut->table + 3 * (size_t)size * size * index_b;
+  float *p = slice;
+
+  for (int index_g = 0; index_g < size; index_g++) {
+    for (int index_r = 0; index_r < size; index_r++, p += 3) {
+      p[0] = data->grid_values[index_r];
+      p[1] = data->grid_values[index_g];
+      p[2] = data->grid_values[index_b];
+    }
+  }
+
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(
+      slice, size, size, 3, sizeof(float), 3 * sizeof(float), 3 * sizeof(float) * size);
+  OCIO_processorApply(data->processor, img);
+  OCIO_PackedImageDescRelease(img);
+}
+
+/* Compare the LUT against the processor in between the grid points, where it is the least
+ * accurate. Only the range of byte buffers matters. */
+static bool display_lut_validate(const DisplayLUT *lut, OCIO_ConstProcessorRcPtr *processor)
+{
+  const int size = DISPLAY_LUT_SIZE;
+  const int steps = 2 * (size - 1);
+  RNG *rng = BLI_rng_new(size);
+
+  for (int i = 0; i < 4096; i++) {
+    float rgb[3], exact[3], baked[3];
+    for (int j = 0; j < 3; j++) {
+      /* Mostly the grey diagonal and halfway points, where the errors are the largest. */
+      const float position = (i < steps) ? i : (BLI_rng_get_int(rng) % steps);
+      rgb[j] = display_lut_shaper_inverse(lut, (position + 0.5f) / steps);
+    }
+    copy_v3_v3(exact, rgb);
+    OCIO_processorApplyRGB(processor, exact);
+    if (!display_lut_evaluate(lut, rgb, baked)) {
+      continue;
+    }
+    /* Byte buffers are clamped anyway. */
+    clamp_v3(exact, 0.0f, 1.0f);
+    clamp_v3(baked, 0.0f, 1.0f);
+    if (!compare_v3v3(exact, baked, DISPLAY_LUT_TOLERANCE)) {
+      BLI_rng_free(rng);
+      return false;
+    }
+  }
+
+  BLI_rng_free(rng);
+  return true;
+}
+
+static DisplayLUT *display_lut_bake(const ColorManagedViewSettings *view_settings,
+                                    const ColorManagedDisplaySettings *display_settings)
+{
+  const int size = DISPLAY_LUT_SIZE;
+  DisplayLUT *lut = MEM_callocN(sizeof(DisplayLUT), "display LUT");
+
+  STRNCPY(lut->look, view_settings->look);
+  STRNCPY(lut->view, view_settings->view_transform);
+  STRNCPY(lut->display, display_settings->display_device);
+  lut->gamma = view_settings->gamma;
+
+  lut->shaper_log_min = log2f(DISPLAY_LUT_OFFSET);
+  lut->shaper_inv_range = DISPLAY_LUT_ONE_INDEX / (float)(size - 1) /
+                          (log2f(1.0f + DISPLAY_LUT_OFFSET) - lut->shaper_log_min);
+  lut->max_value = display_lut_shaper_inverse(lut, 1.0f);
+
+  OCIO_ConstProcessorRcPtr *processor = create_display_buffer_processor(lut->look,
+                                                                        lut->view,
+                                                                        lut->display,
+                                                                        0.0f,
+                                                                        lut->gamma,
+                                                                        global_role_scene_linear,
+                                                                        false);
+  if (processor == NULL) {
+    return lut;
+  }
+
+  DisplayLUTBakeData data;
+  data.lut = lut;
+  data.processor = processor;
+  for (int i = 0; i < size; i++) {
+    data.grid_values[i] = display_lut_shaper_inverse(lut, i / (float)(size - 1));
+  }
+  data.grid_values[0] = 0.0f;
+  data.grid_values[DISPLAY_LUT_ONE_INDEX] = 1.0f;
+
+  lut->table = MEM_mallocN(sizeof(float) * (3 * (size_t)size * size * size + 1), "display LUT");
+  lut->table[3 * (size_t)size * size * size] = 0.0f;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, size, &data, display_lut_bake_slice, &settings);
+
+  if (!display_lut_validate(lut, processor)) {
+    MEM_SAFE_FREE(lut->table);
+  }
+
+  OCIO_processorRelease(processor);
+
+  return lut;
+}
+
+static void display_lut_free(DisplayLUT *lut)
+{
+  MEM_SAFE_FREE(lut->table);
+  MEM_freeN(lut);
+}
+
+static void display_lut_exit(void)
+{
+  if (global_display_lut && global_display_lut->users == 0) {
+    display_lut_free(global_display_lut);
+  }
+  global_display_lut = NULL;
+}
+
+static bool display_lut_matches(const DisplayLUT *lut,
+                                const ColorManagedViewSettings *view_settings,
+                                const ColorManagedDisplaySettings *display_settings)
+{
+  return STREQ(lut->look, view_settings->look) &&
+         STREQ(lut->view, view_settings->view_transform) &&
+         STREQ(lut->display, display_settings->display_device) &&
+         lut->gamma == view_settings->gamma;
+}
+
+/* Let the display processor of a buffer with \a num_pixels use a LUT, reusing the cached one
+ * when it has been baked for the same settings. */
+static void display_lut_acquire(ColormanageProcessor *cm_processor,
+                                const ColorManagedViewSettings *view_settings,
+                                const ColorManagedDisplaySettings *display_settings,
+                                size_t num_pixels)
+{
+  BLI_mutex_lock(&processor_lock);
+
+  DisplayLUT *lut = global_display_lut;
+  if (lut == NULL || !display_lut_matches(lut, view_settings, display_settings)) {
+    BLI_mutex_unlock(&processor_lock);
+    if (num_pixels < DISPLAY_LUT_MIN_PIXELS) {
+      return;
+    }
+
+    /* Bake without holding the lock, the bake is multi-threaded and other threads may need to
+     * create processors meanwhile. */
+    DisplayLUT *lut_baked = display_lut_bake(view_settings, display_settings);
+
+    BLI_mutex_lock(&processor_lock);
+    lut = global_display_lut;
+    if (lut && display_lut_matches(lut, view_settings, display_settings)) {
+      /* Another thread baked the same LUT meanwhile. */
+      display_lut_free(lut_baked);
+    }
+    else {
+      if (lut && lut->users == 0) {
+        display_lut_free(lut);
+      }
+      lut = global_display_lut = lut_baked;
+    }
+  }
+
+  if (lut->table) {
+    lut->users++;
+    cm_processor->display_lut = lut;
+    cm_processor->exposure_gain = powf(2.0f, view_settings->exposure);
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+}
+
+static void display_lut_release(DisplayLUT *lut)
+{
+  BLI_mutex_lock(&processor_lock);
+  lut->users--;
+  if (lut->users == 0 && lut != global_display_lut) {
+    display_lut_free(lut);
+  }
+  BLI_mutex_unlock(&processor_lock);
+}
+
+/* Same as #IMB_colormanagement_processor_apply, which is still used for the pixels the LUT
+ * doesn't cover. */
+static void display_lut_processor_apply(ColormanageProcessor *cm_processor,
+                                        float *buffer,
+                                        int width,
+                                        int height,
+                                        int channels,
+                                        bool predivide)
+{
+  const DisplayLUT *lut = cm_processor->display_lut;
+  const float gain = cm_processor->exposure_gain;
+  const size_t num_pixels = ((size_t)width) * height;
+  float *pixel = buffer;
+
+  BLI_assert(channels >= 3);
+
+  for (size_t i = 0; i < num_pixels; i++, pixel += channels) {
+    if (cm_processor->curve_mapping) {
+      curve_mapping_apply_pixel(cm_processor->curve_mapping, pixel, channels);
+    }
+
+    const float alpha = (channels == 4) ? pixel[3] : 1.0f;
+    const bool use_predivide = predivide && !ELEM(alpha, 0.0f, 1.0f);
+    float rgb[3];
+
+    if (use_predivide) {
+      mul_v3_v3fl(rgb, pixel, gain / alpha);
+    }
+    else {
+      mul_v3_v3fl(rgb, pixel, gain);
+    }
+
+    if (display_lut_evaluate(lut, rgb, rgb)) {
+      if (use_predivide) {
+        mul_v3_v3fl(pixel, rgb, alpha);
+      }
+      else {
+        copy_v3_v3(pixel, rgb);
+      }
+    }
+    else if (channels == 4 && predivide) {
+      OCIO_processorApplyRGBA_predivide(cm_processor->processor, pixel);
+    }
+    else {
+      OCIO_processorApplyRGB(cm_processor->processor, pixel);
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Threaded Display Buffer Transform Routines
  * \{ */
@@ -1702,6 +2109,10 @@ static void *do_display_buffer_apply_thread(void *handle_v)
        * only generate byte buffers
        */
     }
+    else if (cm_processor->display_lut && display_buffer == NULL) {
+      /* the LUT is only accurate enough for byte buffers */
+      display_lut_processor_apply(cm_processor, linear_buffer, width, height, channels, predivide);
+    }
     else {
       /* apply processor */
       IMB_colormanagement_processor_apply(
@@ -1828,6 +2239,11 @@ static void colormanage_display_buffer_process_ex(
 
   if (skip_transform == false) {
     cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+
+    if (display_buffer == NULL && view_settings && ibuf->channels >= 3) {
+      display_lut_acquire(
+          cm_processor, view_settings, display_settings, ((size_t)ibuf->x) * ibuf->y);
+    }
   }
 
   display_buffer_apply_threaded(ibuf,
@@ -3989,6 +4405,9 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->processor) {
     OCIO_processorRelease(cm_processor->processor);
   }
+  if (cm_processor->display_lut) {
+    display_lut_release(cm_processor->display_lut);
+  }
 
   MEM_freeN(cm_processor);
 }
@@ -35,6 +35,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /* -------------------------------------------------------------------- */
 /** \name Floyd-Steinberg dithering
  * \{ */
@@ -108,18 +112,46 @@ bool IMB_alpha_affects_rgb(const ImBuf *ibuf)
   return (ibuf->flags & IB_alphamode_channel_packed) == 0;
 }
 
-/* float to byte pixels, output 4-channel RGBA */
-void IMB_buffer_byte_from_float(uchar *rect_to,
-                                const float *rect_from,
-                                int channels_from,
-                                float dither,
-                                int profile_to,
-                                int profile_from,
-                                bool predivide,
-                                int width,
-                                int height,
-                                int stride_to,
-                                int stride_from)
+static void rgba_float_to_uchar_row(uchar *to, const float *from, int width)
+{
+  int x = 0;
+
+#ifdef __SSE2__
+  /* Same rounding and clamping as #unit_float_to_uchar_clamp, a pixel at a time. */
+  const __m128 scale = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 zero = _mm_setzero_ps();
+  for (; x < width; x++, from += 4, to += 4) {
+    __m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from), scale), half);
+    value = _mm_min_ps(_mm_max_ps(value, zero), scale);
+    __m128i value_i = _mm_cvttps_epi32(value);
+    value_i = _mm_packs_epi32(value_i, value_i);
+    value_i = _mm_packus_epi16(value_i, value_i);
+    *(int *)to = _mm_cvtsi128_si32(value_i);
+  }
+#endif
+
+  for (; x < width; x++, from += 4, to += 4) {
+    rgba_float_to_uchar(to, from);
+  }
+}
+
+/* Conversion of \a num_scanlines starting at \a start_scanline of an image \a height scanlines
+ * high, the buffers point to the first of the scanlines. The dither pattern depends on the
+ * position in the whole image. */
+static void buffer_byte_from_float_scanlines(uchar *rect_to,
+                                             const float *rect_from,
+                                             int channels_from,
+                                             float dither,
+                                             int profile_to,
+                                             int profile_from,
+                                             bool predivide,
+                                             int width,
+                                             int height,
+                                             int start_scanline,
+                                             int num_scanlines,
+                                             int stride_to,
+                                             int stride_from)
 {
   float tmp[4];
   int x, y;
@@ -135,8 +167,8 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
     di = create_dither_context(dither);
   }
 
-  for (y = 0; y < height; y++) {
-    float t = y * inv_height;
+  for (y = 0; y < num_scanlines; y++) {
+    float t = (start_scanline + y) * inv_height;
 
     if (channels_from == 1) {
       /* single channel input */
@@ -203,9 +235,7 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
           }
         }
         else {
-          for (x = 0; x < width; x++, from += 4, to += 4) {
-            rgba_float_to_uchar(to, from);
-          }
+          rgba_float_to_uchar_row(to, from, width);
         }
       }
       else if (profile_to == IB_PROFILE_SRGB) {
@@ -275,6 +305,34 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
   }
 }
 
+/* float to byte pixels, output 4-channel RGBA */
+void IMB_buffer_byte_from_float(uchar *rect_to,
+                                const float *rect_from,
+                                int channels_from,
+                                float dither,
+                                int profile_to,
+                                int profile_from,
+                                bool predivide,
+                                int width,
+                                int height,
+                                int stride_to,
+                                int stride_from)
+{
+  buffer_byte_from_float_scanlines(rect_to,
+                                   rect_from,
+                                   channels_from,
+                                   dither,
+                                   profile_to,
+                                   profile_from,
+                                   predivide,
+                                   width,
+                                   height,
+                                   0,
+                                   height,
+                                   stride_to,
+                                   stride_from);
+}
+
 /* float to byte pixels, output 4-channel RGBA */
 void IMB_buffer_byte_from_float_mask(uchar *rect_to,
                                      const float *rect_from,
@@ -717,9 +775,64 @@ void IMB_buffer_byte_from_byte(uchar *rect_to,
 /** \name ImBuf Conversion
  * \{ */
 
+typedef struct RectFromFloatThreadData {
+  ImBuf *ibuf;
+  struct ColormanageProcessor *cm_processor;
+  bool predivide;
+} RectFromFloatThreadData;
+
+static void imb_rect_from_float_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  RectFromFloatThreadData *data = (RectFromFloatThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+  const size_t offset = ((size_t)start_scanline) * ibuf->x;
+  const size_t size = sizeof(float) * ibuf->channels * ibuf->x * num_scanlines;
+  float *buffer = MEM_mallocN(size, __func__);
+  memcpy(buffer, ibuf->rect_float + offset * ibuf->channels, size);
+
+  /* first make float buffer in byte space */
+  if (data->cm_processor) {
+    IMB_colormanagement_processor_apply(
+        data->cm_processor, buffer, ibuf->x, num_scanlines, ibuf->channels, data->predivide);
+  }
+
+  /* convert from float's premul alpha to byte's straight alpha */
+  if (data->predivide) {
+    IMB_unpremultiply_rect_float(buffer, ibuf->channels, ibuf->x, num_scanlines);
+  }
+
+  /* convert float to byte */
+  buffer_byte_from_float_scanlines((unsigned char *)(ibuf->rect + offset),
+                                   buffer,
+                                   ibuf->channels,
+                                   ibuf->dither,
+                                   IB_PROFILE_SRGB,
+                                   IB_PROFILE_SRGB,
+                                   false,
+                                   ibuf->x,
+                                   ibuf->y,
+                                   start_scanline,
+                                   num_scanlines,
+                                   ibuf->x,
+                                   ibuf->x);
+
+  MEM_freeN(buffer);
+}
+
+static void imb_apply_threaded_scanlines(ImBuf *ibuf, ScanlineThreadFunc do_thread, void *data)
+{
+  if (((size_t)ibuf->x) * ibuf->y < 64 * 64) {
+    do_thread(data, 0, ibuf->y);
+  }
+  else {
+    IMB_processor_apply_threaded_scanlines(ibuf->y, do_thread, data);
+  }
+}
+
+/* The conversion runs over chunks of scanlines in parallel, each chunk doing all steps on a
+ * small copy of the float buffer while it is still in the cache. */
 void IMB_rect_from_float(ImBuf *ibuf)
 {
-  float *buffer;
   const char *from_colorspace;
 
   /* verify we have a float buffer */
@@ -741,40 +854,56 @@ void IMB_rect_from_float(ImBuf *ibuf)
     from_colorspace = ibuf->float_colorspace->name;
   }
 
-  buffer = MEM_dupallocN(ibuf->rect_float);
+  RectFromFloatThreadData data;
+  data.ibuf = ibuf;
+  data.predivide = IMB_alpha_affects_rgb(ibuf);
+  data.cm_processor = NULL;
+  if (from_colorspace[0] != '\0' && !STREQ(from_colorspace, ibuf->rect_colorspace->name)) {
+    data.cm_processor = IMB_colormanagement_colorspace_processor_new(
+        from_colorspace, ibuf->rect_colorspace->name);
+  }
 
-  /* first make float buffer in byte space */
-  const bool predivide = IMB_alpha_affects_rgb(ibuf);
-  IMB_colormanagement_transform(buffer,
-                                ibuf->x,
-                                ibuf->y,
-                                ibuf->channels,
-                                from_colorspace,
-                                ibuf->rect_colorspace->name,
-                                predivide);
+  imb_apply_threaded_scanlines(ibuf, imb_rect_from_float_thread_do, &data);
 
-  /* convert from float's premul alpha to byte's straight alpha */
-  if (IMB_alpha_affects_rgb(ibuf)) {
-    IMB_unpremultiply_rect_float(buffer, ibuf->channels, ibuf->x, ibuf->y);
+  if (data.cm_processor) {
+    IMB_colormanagement_processor_free(data.cm_processor);
   }
 
-  /* convert float to byte */
-  IMB_buffer_byte_from_float((unsigned char *)ibuf->rect,
-                             buffer,
-                             ibuf->channels,
-                             ibuf->dither,
+  /* ensure user flag is reset */
+  ibuf->userflags &= ~IB_RECT_INVALID;
+}
+
+typedef struct FloatFromRectThreadData {
+  ImBuf *ibuf;
+  float *rect_float;
+} FloatFromRectThreadData;
+
+static void imb_float_from_rect_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  FloatFromRectThreadData *data = (FloatFromRectThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+  const size_t offset = ((size_t)start_scanline) * ibuf->x;
+  float *rect_float = data->rect_float + offset * 4;
+
+  /* first, create float buffer in non-linear space */
+  IMB_buffer_float_from_byte(rect_float,
+                             (unsigned char *)(ibuf->rect + offset),
                              IB_PROFILE_SRGB,
                              IB_PROFILE_SRGB,
                              false,
                              ibuf->x,
-                             ibuf->y,
+                             num_scanlines,
                              ibuf->x,
                              ibuf->x);
 
-  MEM_freeN(buffer);
+  /* then make float be in linear space */
+  IMB_colormanagement_colorspace_to_scene_linear(
+      rect_float, ibuf->x, num_scanlines, 4, ibuf->rect_colorspace, false);
 
-  /* ensure user flag is reset */
-  ibuf->userflags &= ~IB_RECT_INVALID;
+  /* byte buffer is straight alpha, float should always be premul */
+  if (IMB_alpha_affects_rgb(ibuf)) {
+    IMB_premultiply_rect_float(rect_float, 4, ibuf->x, num_scanlines);
+  }
 }
 
 void IMB_float_from_rect(ImBuf *ibuf)
@@ -805,25 +934,10 @@ void IMB_float_from_rect(ImBuf *ibuf)
     }
   }
 
-  /* first, create float buffer in non-linear space */
-  IMB_buffer_float_from_byte(rect_float,
-                             (unsigned char *)ibuf->rect,
-                             IB_PROFILE_SRGB,
-                             IB_PROFILE_SRGB,
-                             false,
-                             ibuf->x,
-                             ibuf->y,
-                             ibuf->x,
-                             ibuf->x);
-
-  /* then make float be in linear space */
-  IMB_colormanagement_colorspace_to_scene_linear(
-      rect_float, ibuf->x, ibuf->y, ibuf->channels, ibuf->rect_colorspace, false);
-
-  /* byte buffer is straight alpha, float should always be premul */
-  if (IMB_alpha_affects_rgb(ibuf)) {
-    IMB_premultiply_rect_float(rect_float, ibuf->channels, ibuf->x, ibuf->y);
-  }
+  FloatFromRectThreadData data;
+  data.ibuf = ibuf;
+  data.rect_float = rect_float;
+  imb_apply_threaded_scanlines(ibuf, imb_float_from_rect_thread_do, &data);
 
   if (ibuf->rect_float == NULL) {
     ibuf->rect_float = rect_float;
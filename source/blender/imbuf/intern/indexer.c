@@ -542,6 +542,8 @@ static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(
     return 0;
   }
 
+  /* Delayed packets are flushed when the proxy is closed. */
+  ffmpeg_codec_context_set_threads(rv->c, rv->codec, true);
   avcodec_open2(rv->c, rv->codec, NULL);
 
   rv->orig_height = av_get_cropped_height_from_codec(st->codec);
@@ -779,6 +781,9 @@ static IndexBuildContext *index_ffmpeg_create_context(struct anim *anim,
   }
 
   context->iCodecCtx->workaround_bugs = 1;
+  /* Frame threading would delay decoded frames past the key frame the index stores them
+   * with, see #index_rebuild_ffmpeg_proc_decoded_frame. */
+  ffmpeg_codec_context_set_threads(context->iCodecCtx, context->iCodec, false);
 
   if (avcodec_open2(context->iCodecCtx, context->iCodec, NULL) < 0) {
     avformat_close_input(&context->iFormatCtx);
@@ -98,6 +98,7 @@ using namespace Imath;
 extern "C" {
 /* prototype */
 static struct ExrPass *imb_exr_get_pass(ListBase *lb, char *passname);
+static void imb_exr_pass_layout(struct ExrPass *pass, int width, float *rect);
 static bool exr_has_multiview(MultiPartInputFile &file);
 static bool exr_has_multipart_file(MultiPartInputFile &file);
 static bool exr_has_alpha(MultiPartInputFile &file);
@@ -624,6 +625,8 @@ bool imb_save_openexr(struct ImBuf *ibuf, const char *name, int flags)
  */
 
 static ListBase exrhandles = {nullptr, nullptr};
+/* Handles are opened and closed from render write threads too. */
+static ThreadMutex exrhandles_lock = BLI_MUTEX_INITIALIZER;
 
 struct ExrHandle {
   struct ExrHandle *next, *prev;
@@ -650,6 +653,14 @@ struct ExrHandle {
   ListBase layers;   /* hierarchical, pointing in end to ExrChannel */
 
   int num_half_channels; /* used during filr save, allows faster temporary buffers allocation */
+
+  /* Passes have no buffers, they are read with #IMB_exr_read_pass. */
+  bool is_deferred;
+  /* File the passes are read from, it's only open while reading a pass. */
+  char deferred_filepath[FILE_MAX];
+
+  /* Threads compressing the lines of written files, zero for OpenEXR's global thread count. */
+  int write_threads;
 };
 
 /* flattened out channel */
@@ -687,7 +698,8 @@ struct ExrLayer {
 
 /* ********************** */
 
-void *IMB_exr_get_handle(void)
+/* NOTE: Expects #exrhandles_lock to be locked. */
+static ExrHandle *imb_exr_handle_add(void)
 {
   ExrHandle *data = (ExrHandle *)MEM_callocN(sizeof(ExrHandle), "exr handle");
   data->multiView = new StringVector();
@@ -696,14 +708,35 @@ void *IMB_exr_get_handle(void)
   return data;
 }
 
+void *IMB_exr_get_handle(void)
+{
+  BLI_mutex_lock(&exrhandles_lock);
+  ExrHandle *data = imb_exr_handle_add();
+  BLI_mutex_unlock(&exrhandles_lock);
+  return data;
+}
+
+void IMB_exr_set_write_threads(void *handle, int num_threads)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  data->write_threads = num_threads;
+}
+
+static int imb_exr_write_threads(const ExrHandle *data)
+{
+  return (data->write_threads > 0) ? data->write_threads : globalThreadCount();
+}
+
 void *IMB_exr_get_handle_name(const char *name)
 {
+  BLI_mutex_lock(&exrhandles_lock);
   ExrHandle *data = (ExrHandle *)BLI_rfindstring(&exrhandles, name, offsetof(ExrHandle, name));
 
   if (data == nullptr) {
-    data = (ExrHandle *)IMB_exr_get_handle();
+    data = imb_exr_handle_add();
     BLI_strncpy(data->name, name, strlen(name) + 1);
   }
+  BLI_mutex_unlock(&exrhandles_lock);
   return data;
 }
 
@@ -883,7 +916,8 @@ int IMB_exr_begin_write(void *handle,
   /* manually create ofstream, so we can handle utf-8 filepaths on windows */
   try {
     data->ofile_stream = new OFileStream(filename);
-    data->ofile = new OutputFile(*(data->ofile_stream), header);
+    data->ofile = new OutputFile(
+        *(data->ofile_stream), header, imb_exr_write_threads(data));
   }
   catch (const std::exception &exc) {
     std::cerr << "IMB_exr_begin_write: ERROR: " << exc.what() << std::endl;
@@ -954,7 +988,11 @@ void IMB_exrtile_begin_write(
   /* manually create ofstream, so we can handle utf-8 filepaths on windows */
   try {
     data->ofile_stream = new OFileStream(filename);
-    data->mpofile = new MultiPartOutputFile(*(data->ofile_stream), &headers[0], headers.size());
+    data->mpofile = new MultiPartOutputFile(*(data->ofile_stream),
+                                            &headers[0],
+                                            headers.size(),
+                                            false,
+                                            imb_exr_write_threads(data));
   }
   catch (const std::exception &) {
     delete data->mpofile;
@@ -1209,17 +1247,93 @@ void IMB_exrtile_write_channels(
   }
 }
 
-void IMB_exr_read_channels(void *handle)
+/* Read the channels of \a part which have a buffer, only the ones of \a pass when it's not NULL.
+ * Returns false on errors. */
+static bool imb_exr_read_part(ExrHandle *data, int part, const ExrPass *pass, const bool flip)
 {
-  ExrHandle *data = (ExrHandle *)handle;
-  int numparts = data->ifile->parts();
+  /* Read part header. */
+  InputPart in(*data->ifile, part);
+  Header header = in.header();
+  Box2i dw = header.dataWindow();
+
+  /* Insert all matching channel into framebuffer. */
+  FrameBuffer frameBuffer;
+  ExrChannel *echan;
+
+  for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
+    if (echan->m->part_number != part) {
+      continue;
+    }
+    if (pass && std::find(pass->chan, pass->chan + pass->totchan, echan) ==
+                    pass->chan + pass->totchan) {
+      continue;
+    }
+
+    exr_printf("%d %-6s %-22s \"%s\"\n",
+               echan->m->part_number,
+               echan->m->view.c_str(),
+               echan->m->name.c_str(),
+               echan->m->internal_name.c_str());
+
+    if (echan->rect) {
+      float *rect = echan->rect;
+      size_t xstride = echan->xstride * sizeof(float);
+      size_t ystride = echan->ystride * sizeof(float);
+
+      if (!flip) {
+        /* Inverse correct first pixel for data-window coordinates. */
+        rect -= echan->xstride * (dw.min.x - dw.min.y * data->width);
+        /* move to last scanline to flip to Blender convention */
+        rect += echan->xstride * (data->height - 1) * data->width;
+        ystride = -ystride;
+      }
+      else {
+        /* Inverse correct first pixel for data-window coordinates. */
+        rect -= echan->xstride * (dw.min.x + dw.min.y * data->width);
+      }
 
-  /* Check if EXR was saved with previous versions of blender which flipped images. */
+      frameBuffer.insert(echan->m->internal_name,
+                         Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+    }
+    else if (pass == nullptr) {
+      printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+    }
+  }
+
+  if (pass && frameBuffer.begin() == frameBuffer.end()) {
+    /* The pass has no channels in this part. */
+    return true;
+  }
+
+  /* Read pixels. */
+  try {
+    in.setFrameBuffer(frameBuffer);
+    exr_printf("readPixels:readPixels[%d]: min.y: %d, max.y: %d\n", part, dw.min.y, dw.max.y);
+    in.readPixels(dw.min.y, dw.max.y);
+  }
+  catch (const std::exception &exc) {
+    std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/* Check if EXR was saved with previous versions of blender which flipped images. */
+static bool imb_exr_is_flipped(ExrHandle *data)
+{
   const StringAttribute *ta = data->ifile->header(0).findTypedAttribute<StringAttribute>(
       "BlenderMultiChannel");
 
   /* 'previous multilayer attribute, flipped. */
-  short flip = (ta && STRPREFIX(ta->value().c_str(), "Blender V2.43"));
+  return (ta && STRPREFIX(ta->value().c_str(), "Blender V2.43"));
+}
+
+void IMB_exr_read_channels(void *handle)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  int numparts = data->ifile->parts();
+  const bool flip = imb_exr_is_flipped(data);
 
   exr_printf(
       "\nIMB_exr_read_channels\n%s %-6s %-22s "
@@ -1230,62 +1344,142 @@ void IMB_exr_read_channels(void *handle)
       "internal_name");
 
   for (int i = 0; i < numparts; i++) {
-    /* Read part header. */
-    InputPart in(*data->ifile, i);
-    Header header = in.header();
-    Box2i dw = header.dataWindow();
+    if (!imb_exr_read_part(data, i, nullptr, flip)) {
+      break;
+    }
+  }
+}
 
-    /* Insert all matching channel into framebuffer. */
-    FrameBuffer frameBuffer;
-    ExrChannel *echan;
+bool IMB_exr_is_deferred(void *handle)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  return data->is_deferred;
+}
 
-    for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-      if (echan->m->part_number != i) {
-        continue;
-      }
+/* Open the file of a deferred handle for reading passes, the file could have changed since the
+ * layout was read so the size and channels are checked against the handle. */
+static bool imb_exr_deferred_file_open(ExrHandle *data)
+{
+  BLI_assert(data->is_deferred && data->ifile == nullptr);
 
-      exr_printf("%d %-6s %-22s \"%s\"\n",
-                 echan->m->part_number,
-                 echan->m->view.c_str(),
-                 echan->m->name.c_str(),
-                 echan->m->internal_name.c_str());
+  if (data->deferred_filepath[0] == '\0') {
+    return false;
+  }
 
-      if (echan->rect) {
-        float *rect = echan->rect;
-        size_t xstride = echan->xstride * sizeof(float);
-        size_t ystride = echan->ystride * sizeof(float);
-
-        if (!flip) {
-          /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x - dw.min.y * data->width);
-          /* move to last scanline to flip to Blender convention */
-          rect += echan->xstride * (data->height - 1) * data->width;
-          ystride = -ystride;
-        }
-        else {
-          /* Inverse correct first pixel for data-window coordinates. */
-          rect -= echan->xstride * (dw.min.x + dw.min.y * data->width);
-        }
+  try {
+    data->ifile_stream = new IFileStream(data->deferred_filepath);
+    data->ifile = new MultiPartInputFile(*(data->ifile_stream));
+  }
+  catch (const std::exception &exc) {
+    std::cerr << "OpenEXR-open: ERROR: " << exc.what() << std::endl;
+    delete data->ifile;
+    delete data->ifile_stream;
 
-        frameBuffer.insert(echan->m->internal_name,
-                           Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
-      }
-      else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+    data->ifile = nullptr;
+    data->ifile_stream = nullptr;
+    return false;
+  }
+
+  Box2i dw = data->ifile->header(0).dataWindow();
+  std::vector<MultiViewChannelName> channels;
+  GetChannelsInMultiPartFile(*data->ifile, channels);
+
+  bool is_valid = dw.max.x - dw.min.x + 1 == data->width &&
+                  dw.max.y - dw.min.y + 1 == data->height &&
+                  channels.size() == (size_t)BLI_listbase_count(&data->channels);
+
+  if (is_valid) {
+    ExrChannel *echan = (ExrChannel *)data->channels.first;
+    for (const MultiViewChannelName &channel : channels) {
+      if (channel.internal_name != echan->m->internal_name ||
+          channel.part_number != echan->m->part_number) {
+        is_valid = false;
+        break;
       }
+      echan = echan->next;
     }
+  }
 
-    /* Read pixels. */
-    try {
-      in.setFrameBuffer(frameBuffer);
-      exr_printf("readPixels:readPixels[%d]: min.y: %d, max.y: %d\n", i, dw.min.y, dw.max.y);
-      in.readPixels(dw.min.y, dw.max.y);
-    }
-    catch (const std::exception &exc) {
-      std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
+  if (!is_valid) {
+    printf("%s: '%s' changed since it was loaded\n", __func__, data->deferred_filepath);
+    delete data->ifile;
+    delete data->ifile_stream;
+
+    data->ifile = nullptr;
+    data->ifile_stream = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+/* Close the file again, so it isn't kept open (and locked on some platforms) between reads. */
+static void imb_exr_deferred_file_close(ExrHandle *data)
+{
+  delete data->ifile;
+  delete data->ifile_stream;
+
+  data->ifile = nullptr;
+  data->ifile_stream = nullptr;
+}
+
+bool IMB_exr_open_deferred(void *handle, const char *filepath)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  STRNCPY(data->deferred_filepath, filepath);
+
+  if (!imb_exr_deferred_file_open(data)) {
+    data->deferred_filepath[0] = '\0';
+    return false;
+  }
+
+  imb_exr_deferred_file_close(data);
+  return true;
+}
+
+float *IMB_exr_read_pass(void *handle,
+                         const char *layname,
+                         const char *passname,
+                         const char *viewname)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  ExrLayer *lay = (ExrLayer *)BLI_findstring(&data->layers, layname, offsetof(ExrLayer, name));
+  ExrPass *pass;
+
+  if (lay == nullptr) {
+    return nullptr;
+  }
+
+  for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+    if (STREQ(pass->internal_name, passname) && STREQ(pass->view, viewname)) {
       break;
     }
   }
+
+  if (pass == nullptr || pass->totchan == 0) {
+    return nullptr;
+  }
+
+  float *rect = (float *)MEM_callocN(
+      sizeof(float) * data->width * data->height * pass->totchan, "pass rect");
+
+  if (imb_exr_deferred_file_open(data)) {
+    const bool flip = imb_exr_is_flipped(data);
+    int numparts = data->ifile->parts();
+
+    imb_exr_pass_layout(pass, data->width, rect);
+    for (int i = 0; i < numparts; i++) {
+      if (!imb_exr_read_part(data, i, pass, flip)) {
+        break;
+      }
+    }
+    imb_exr_pass_layout(pass, data->width, nullptr);
+
+    imb_exr_deferred_file_close(data);
+  }
+
+  return rect;
 }
 
 void IMB_exr_multilayer_convert(void *handle,
@@ -1372,7 +1566,9 @@ void IMB_exr_close(void *handle)
   }
   BLI_freelistN(&data->layers);
 
+  BLI_mutex_lock(&exrhandles_lock);
   BLI_remlink(&exrhandles, data);
+  BLI_mutex_unlock(&exrhandles_lock);
   MEM_freeN(data);
 }
 
@@ -1528,17 +1724,76 @@ static ExrPass *imb_exr_get_pass(ListBase *lb, char *passname)
   return pass;
 }
 
+/* Assign the channels of \a pass to \a rect, or only set their IDs when \a rect is NULL. */
+static void imb_exr_pass_layout(ExrPass *pass, int width, float *rect)
+{
+  ExrChannel *echan;
+  int a;
+
+  if (pass->totchan == 1) {
+    echan = pass->chan[0];
+    echan->rect = rect;
+    echan->xstride = 1;
+    echan->ystride = width;
+    pass->chan_id[0] = echan->chan_id;
+  }
+  else {
+    char lookup[256];
+
+    memset(lookup, 0, sizeof(lookup));
+
+    /* we can have RGB(A), XYZ(W), UVA */
+    if (ELEM(pass->totchan, 3, 4)) {
+      if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
+          pass->chan[2]->chan_id == 'B') {
+        lookup[(unsigned int)'R'] = 0;
+        lookup[(unsigned int)'G'] = 1;
+        lookup[(unsigned int)'B'] = 2;
+        lookup[(unsigned int)'A'] = 3;
+      }
+      else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
+               pass->chan[2]->chan_id == 'Y') {
+        lookup[(unsigned int)'X'] = 0;
+        lookup[(unsigned int)'Y'] = 1;
+        lookup[(unsigned int)'Z'] = 2;
+        lookup[(unsigned int)'W'] = 3;
+      }
+      else {
+        lookup[(unsigned int)'U'] = 0;
+        lookup[(unsigned int)'V'] = 1;
+        lookup[(unsigned int)'A'] = 2;
+      }
+      for (a = 0; a < pass->totchan; a++) {
+        echan = pass->chan[a];
+        echan->rect = rect ? rect + lookup[(unsigned int)echan->chan_id] : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = width * pass->totchan;
+        pass->chan_id[(unsigned int)lookup[(unsigned int)echan->chan_id]] = echan->chan_id;
+      }
+    }
+    else { /* unknown */
+      for (a = 0; a < pass->totchan; a++) {
+        echan = pass->chan[a];
+        echan->rect = rect ? rect + a : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = width * pass->totchan;
+        pass->chan_id[a] = echan->chan_id;
+      }
+    }
+  }
+}
+
 /* creates channels, makes a hierarchy and assigns memory to channels */
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
                                          int width,
-                                         int height)
+                                         int height,
+                                         const bool deferred)
 {
   ExrLayer *lay;
   ExrPass *pass;
   ExrChannel *echan;
   ExrHandle *data = (ExrHandle *)IMB_exr_get_handle();
-  int a;
   char layname[EXR_TOT_MAXNAME], passname[EXR_TOT_MAXNAME];
 
   data->ifile_stream = &file_stream;
@@ -1603,63 +1858,17 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   for (lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
     for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
       if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(width * height * pass->totchan * sizeof(float),
-                                          "pass rect");
-        if (pass->totchan == 1) {
-          echan = pass->chan[0];
-          echan->rect = pass->rect;
-          echan->xstride = 1;
-          echan->ystride = width;
-          pass->chan_id[0] = echan->chan_id;
-        }
-        else {
-          char lookup[256];
-
-          memset(lookup, 0, sizeof(lookup));
-
-          /* we can have RGB(A), XYZ(W), UVA */
-          if (ELEM(pass->totchan, 3, 4)) {
-            if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
-                pass->chan[2]->chan_id == 'B') {
-              lookup[(unsigned int)'R'] = 0;
-              lookup[(unsigned int)'G'] = 1;
-              lookup[(unsigned int)'B'] = 2;
-              lookup[(unsigned int)'A'] = 3;
-            }
-            else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
-                     pass->chan[2]->chan_id == 'Y') {
-              lookup[(unsigned int)'X'] = 0;
-              lookup[(unsigned int)'Y'] = 1;
-              lookup[(unsigned int)'Z'] = 2;
-              lookup[(unsigned int)'W'] = 3;
-            }
-            else {
-              lookup[(unsigned int)'U'] = 0;
-              lookup[(unsigned int)'V'] = 1;
-              lookup[(unsigned int)'A'] = 2;
-            }
-            for (a = 0; a < pass->totchan; a++) {
-              echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[(unsigned int)echan->chan_id];
-              echan->xstride = pass->totchan;
-              echan->ystride = width * pass->totchan;
-              pass->chan_id[(unsigned int)lookup[(unsigned int)echan->chan_id]] = echan->chan_id;
-            }
-          }
-          else { /* unknown */
-            for (a = 0; a < pass->totchan; a++) {
-              echan = pass->chan[a];
-              echan->rect = pass->rect + a;
-              echan->xstride = pass->totchan;
-              echan->ystride = width * pass->totchan;
-              pass->chan_id[a] = echan->chan_id;
-            }
-          }
+        if (!deferred) {
+          pass->rect = (float *)MEM_callocN(width * height * pass->totchan * sizeof(float),
+                                            "pass rect");
         }
+        imb_exr_pass_layout(pass, width, pass->rect);
       }
     }
   }
 
+  data->is_deferred = deferred;
+
   return data;
 }
 
@@ -1971,10 +2180,20 @@ struct ImBuf *imb_load_openexr(const unsigned char *mem,
 
         /* Only enters with IB_multilayer flag set. */
         if (is_multi && ((flags & IB_thumbnail) == 0)) {
+          const bool deferred = (flags & IB_multilayer_deferred) != 0;
           /* constructs channels for reading, allocates memory in channels */
-          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
+          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height, deferred);
           if (handle) {
-            IMB_exr_read_channels(handle);
+            if (deferred) {
+              /* The memory is only valid while loading, the caller opens the file again. */
+              delete membuf;
+              delete file;
+              handle->ifile = nullptr;
+              handle->ifile_stream = nullptr;
+            }
+            else {
+              IMB_exr_read_channels(handle);
+            }
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
         }
@@ -59,6 +59,8 @@ int IMB_exr_begin_write(void *handle,
                         const struct StampData *stamp);
 void IMB_exrtile_begin_write(
     void *handle, const char *filename, int mipmap, int width, int height, int tilex, int tiley);
+/* Limit the threads used for compression, to be called before beginning to write. */
+void IMB_exr_set_write_threads(void *handle, int num_threads);
 
 void IMB_exr_set_channel(void *handle,
                          const char *layname,
@@ -72,6 +74,17 @@ float *IMB_exr_channel_rect(void *handle,
                             const char *view);
 
 void IMB_exr_read_channels(void *handle);
+
+/* Multilayer files loaded with #IB_multilayer_deferred have no pass buffers, passes are read
+ * when needed. #IMB_exr_open_deferred sets and checks the file, which is then only opened
+ * while reading a pass. */
+bool IMB_exr_is_deferred(void *handle);
+bool IMB_exr_open_deferred(void *handle, const char *filepath);
+float *IMB_exr_read_pass(void *handle,
+                         const char *layname,
+                         const char *passname,
+                         const char *viewname);
+
 void IMB_exr_write_channels(void *handle);
 void IMB_exrtile_write_channels(
     void *handle, int partx, int party, int level, const char *viewname, bool empty);
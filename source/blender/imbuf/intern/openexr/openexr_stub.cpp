@@ -59,6 +59,10 @@ int IMB_exr_begin_write(void * /*handle*/,
 {
   return 0;
 }
+void IMB_exr_set_write_threads(void * /*handle*/, int /*num_threads*/)
+{
+}
+
 void IMB_exrtile_begin_write(void * /*handle*/,
                              const char * /*filename*/,
                              int /*mipmap*/,
@@ -88,6 +92,23 @@ float *IMB_exr_channel_rect(void * /*handle*/,
 void IMB_exr_read_channels(void * /*handle*/)
 {
 }
+
+bool IMB_exr_is_deferred(void * /*handle*/)
+{
+  return false;
+}
+bool IMB_exr_open_deferred(void * /*handle*/, const char * /*filepath*/)
+{
+  return false;
+}
+float *IMB_exr_read_pass(void * /*handle*/,
+                         const char * /*layname*/,
+                         const char * /*passname*/,
+                         const char * /*viewname*/)
+{
+  return nullptr;
+}
+
 void IMB_exr_write_channels(void * /*handle*/)
 {
 }
@@ -908,54 +908,60 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* Small images aren't worth the overhead of the task pool. */
+static void scale_apply_scanlines(int total_scanlines,
+                                  size_t num_pixels,
+                                  ScanlineThreadFunc do_thread,
+                                  void *custom_data)
+{
+  if (num_pixels < 64 * 64) {
+    do_thread(custom_data, 0, total_scanlines);
+  }
+  else {
+    IMB_processor_apply_threaded_scanlines(total_scanlines, do_thread, custom_data);
+  }
+}
+
+typedef struct ScaleDownThreadData {
+  const ImBuf *ibuf;
+  int newsize;
+  float add;
+  uchar *newrect;
+  float *newrectf;
+} ScaleDownThreadData;
+
+/* Rows are scaled independently of each other. */
+static void scaledownx_thread_do(void *data_v, int start_scanline, int num_scanlines)
 {
+  const ScaleDownThreadData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
+  const int newx = data->newsize;
+  const float add = data->add;
+  const size_t offset = (size_t)start_scanline * ibuf->x * 4;
+  const size_t range_size = (size_t)num_scanlines * ibuf->x * 4;
+
+  uchar *rect, *newrect;
+  float *rectf, *newrectf;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
   int x, y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
+  rectf = newrectf = NULL;
+  rect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
-
   if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
+    rect = (uchar *)ibuf->rect + offset;
+    newrect = data->newrect + (size_t)start_scanline * newx * 4;
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  add = (ibuf->x - 0.01) / newx;
-
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
+    rectf = ibuf->rect_float + offset;
+    newrectf = data->newrectf + (size_t)start_scanline * newx * 4;
   }
 
-  for (y = ibuf->y; y > 0; y--) {
+  for (y = num_scanlines; y > 0; y--) {
     sample = 0.0f;
     val[0] = val[1] = val[2] = val[3] = 0.0f;
     valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
@@ -1029,73 +1035,89 @@ static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
     }
   }
 
+  /* see bug T26502. */
+  BLI_assert(!do_rect || (uchar *)rect - ((uchar *)ibuf->rect) == offset + range_size);
+  BLI_assert(!do_float || (rectf - ibuf->rect_float) == offset + range_size);
+  UNUSED_VARS_NDEBUG(range_size);
+}
+
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
+  ScaleDownThreadData data = {NULL};
+
+  if (!do_rect && !do_float) {
+    return ibuf;
+  }
+
+  if (do_rect) {
+    data.newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
+    if (data.newrect == NULL) {
+      return ibuf;
+    }
+  }
+  if (do_float) {
+    data.newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
+      }
+      return ibuf;
+    }
+  }
+
+  data.ibuf = ibuf;
+  data.newsize = newx;
+  data.add = (ibuf->x - 0.01) / newx;
+
+  scale_apply_scanlines(ibuf->y, (size_t)ibuf->x * ibuf->y, scaledownx_thread_do, &data);
+
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
+    ibuf->rect = (unsigned int *)data.newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    ibuf->rect_float = data.newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->x = newx;
   return ibuf;
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+/* Columns are scaled independently of each other, the "scanlines" here are columns. */
+static void scaledowny_thread_do(void *data_v, int start_scanline, int num_scanlines)
 {
+  const ScaleDownThreadData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
+  const int newy = data->newsize;
+  const float add = data->add;
+  const int skipx = 4 * ibuf->x;
   const size_t rect_size = ibuf->x * ibuf->y * 4;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
+  uchar *rect, *newrect;
+  float *rectf, *newrectf;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int x, y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
+  rectf = newrectf = NULL;
+  rect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
-
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
+  for (x = 4 * start_scanline; x < 4 * (start_scanline + num_scanlines); x += 4) {
     if (do_rect) {
       rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
+      newrect = data->newrect + x;
     }
     if (do_float) {
       rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+      newrectf = data->newrectf + x;
     }
 
     sample = 0.0f;
@@ -1169,23 +1191,56 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 
       sample -= 1.0f;
     }
+
+    /* see bug T26502. */
+    BLI_assert(!do_rect || (uchar *)rect - ((uchar *)ibuf->rect) == x + rect_size);
+    BLI_assert(!do_float || (rectf - ibuf->rect_float) == x + rect_size);
+  }
+  UNUSED_VARS_NDEBUG(rect_size);
+}
+
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
+  ScaleDownThreadData data = {NULL};
+
+  if (!do_rect && !do_float) {
+    return ibuf;
   }
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
+    data.newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
+    if (data.newrect == NULL) {
+      return ibuf;
+    }
+  }
+  if (do_float) {
+    data.newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
+      }
+      return ibuf;
+    }
+  }
+
+  data.ibuf = ibuf;
+  data.newsize = newy;
+  data.add = (ibuf->y - 0.01) / newy;
+
+  scale_apply_scanlines(ibuf->x, (size_t)ibuf->x * ibuf->y, scaledowny_thread_do, &data);
+
+  if (do_rect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
+    ibuf->rect = (unsigned int *)data.newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = data.newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->y = newy;
   return ibuf;
@@ -1661,23 +1716,55 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastThreadData {
+  const ImBuf *ibuf;
+  int newx;
+  size_t stepx, stepy;
+  unsigned int *newrect;
+  struct imbufRGBA *newrectf;
+} ScaleFastThreadData;
+
+static void scalefast_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  const ScaleFastThreadData *data = data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newx;
+  size_t ofsx, ofsy;
+  int x, y;
+
+  ofsy = 32768 + start_scanline * data->stepy;
+
+  for (y = start_scanline; y < start_scanline + num_scanlines; y++, ofsy += data->stepy) {
+    if (data->newrect) {
+      const unsigned int *rect = ibuf->rect + (ofsy >> 16) * ibuf->x;
+      unsigned int *newrect = data->newrect + (size_t)y * newx;
+      ofsx = 32768;
+
+      for (x = newx; x > 0; x--, ofsx += data->stepx) {
+        *newrect++ = rect[ofsx >> 16];
+      }
+    }
+
+    if (data->newrectf) {
+      const struct imbufRGBA *rectf = (struct imbufRGBA *)ibuf->rect_float +
+                                      (ofsy >> 16) * ibuf->x;
+      struct imbufRGBA *newrectf = data->newrectf + (size_t)y * newx;
+      ofsx = 32768;
+
+      for (x = newx; x > 0; x--, ofsx += data->stepx) {
+        *newrectf++ = rectf[ofsx >> 16];
+      }
+    }
+  }
+}
+
 /**
  * Return true if \a ibuf is modified.
  */
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  ScaleFastThreadData data = {NULL};
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1697,60 +1784,39 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
   }
 
   if (do_rect) {
-    _newrect = MEM_mallocN(newx * newy * sizeof(int), "scalefastimbuf");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(newx * newy * sizeof(int), "scalefastimbuf");
+    if (data.newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * newy, "scalefastimbuf f");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(sizeof(float[4]) * newx * newy, "scalefastimbuf f");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
-  stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
+  data.ibuf = ibuf;
+  data.newx = newx;
+  data.stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
+  data.stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
 
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  scale_apply_scanlines(newy, (size_t)newx * newy, scalefast_thread_do, &data);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = _newrect;
+    ibuf->rect = data.newrect;
   }
 
   if (do_float) {
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = (float *)data.newrectf;
   }
 
   scalefast_Z_ImBuf(ibuf, newx, newy);
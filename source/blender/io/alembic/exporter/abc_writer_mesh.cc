@@ -24,6 +24,8 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -454,11 +456,13 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  const MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  parallel_for(IndexRange(mesh->totvert), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -537,15 +541,27 @@ static void get_loop_normals(struct Mesh *mesh,
 
   normals.resize(mesh->totloop);
 
+  /* The loops of the polygons are not required to be stored in order, so find where the normals
+   * of each polygon start in the exported array before converting them in parallel. */
+  const MPoly *mpoly = mesh->mpoly;
+  Vector<int> poly_offsets(mesh->totpoly);
+  int offset = 0;
+  for (int i = 0, e = mesh->totpoly; i < e; i++) {
+    poly_offsets[i] = offset;
+    offset += mpoly[i].totloop;
+  }
+
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  parallel_for(IndexRange(mesh->totpoly), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &mpoly[i];
+      int abc_index = poly_offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
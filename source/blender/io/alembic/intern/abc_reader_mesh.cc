@@ -35,6 +35,7 @@
 #include "BLI_compiler_compat.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
 #include "BKE_main.h"
 #include "BKE_material.h"
@@ -130,17 +131,19 @@ static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &ceil_positions,
                                const float weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+  parallel_for(IndexRange(positions->size()), 2048, [&](IndexRange range) {
+    float tmp[3];
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
 
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
-    copy_zup_from_yup(mvert.co, tmp);
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
+      copy_zup_from_yup(mvert.co, tmp);
 
-    mvert.bweight = 0;
-  }
+      mvert.bweight = 0;
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -160,23 +163,25 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 
 void read_mverts(MVert *mverts, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  parallel_for(IndexRange(positions->size()), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      MVert &mvert = mverts[i];
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
+      copy_zup_from_yup(mvert.co, pos_in.getValue());
 
-    mvert.bweight = 0;
+      mvert.bweight = 0;
 
-    if (normals) {
-      Imath::V3f nor_in = (*normals)[i];
+      if (normals) {
+        Imath::V3f nor_in = (*normals)[i];
 
-      short no[3];
-      normal_float_to_short_v3(no, nor_in.getValue());
+        short no[3];
+        normal_float_to_short_v3(no, nor_in.getValue());
 
-      copy_zup_from_yup(mvert.no, no);
+        copy_zup_from_yup(mvert.no, no);
+      }
     }
-  }
+  });
 }
 
 static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -664,7 +669,10 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  /* Compare against the sample read above, #topology_changed() would read it again. */
+  if (positions->size() != existing_mesh->totvert ||
+      face_counts->size() != existing_mesh->totpoly ||
+      face_indices->size() != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
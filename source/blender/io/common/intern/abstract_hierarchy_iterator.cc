@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "BKE_anim_data.h"
 #include "BKE_duplilist.h"
@@ -304,19 +305,17 @@ void AbstractHierarchyIterator::export_graph_construct()
     ListBase *lb = object_duplilist(depsgraph_, scene, object);
     if (lb) {
       DupliParentFinder dupli_parent_finder;
+      std::vector<DupliObject *> visited_duplis;
 
       LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        PersistentID persistent_id(dupli_object);
         if (!should_visit_dupli_object(dupli_object)) {
           continue;
         }
         dupli_parent_finder.insert(dupli_object);
+        visited_duplis.push_back(dupli_object);
       }
 
-      LISTBASE_FOREACH (DupliObject *, dupli_object, lb) {
-        if (!should_visit_dupli_object(dupli_object)) {
-          continue;
-        }
+      for (DupliObject *dupli_object : visited_duplis) {
         visit_dupli_object(dupli_object, object, dupli_parent_finder);
       }
     }
@@ -331,21 +330,23 @@ void AbstractHierarchyIterator::connect_loose_objects()
   /* Find those objects whose parent is not part of the export graph; these
    * objects would be skipped when traversing the graph as a hierarchy.
    * These objects will have to be re-attached to some parent object in order to
-   * fit into the hierarchy. */
-  ExportGraph loose_objects_graph = export_graph_;
+   * fit into the hierarchy. Only the keys are collected, as copying the graph would also copy
+   * the children of every object. */
+  std::set<ObjectIdentifier> loose_keys;
+  for (const ExportGraph::value_type &map_iter : export_graph_) {
+    loose_keys.insert(loose_keys.end(), map_iter.first);
+  }
   for (const ExportGraph::value_type &map_iter : export_graph_) {
     for (const HierarchyContext *child : map_iter.second) {
       /* An object that is marked as a child of another object is not considered 'loose'. */
-      ObjectIdentifier child_oid = ObjectIdentifier::for_hierarchy_context(child);
-      loose_objects_graph.erase(child_oid);
+      loose_keys.erase(ObjectIdentifier::for_hierarchy_context(child));
     }
   }
   /* The root of the hierarchy is always found, so it's never considered 'loose'. */
-  loose_objects_graph.erase(ObjectIdentifier::for_graph_root());
+  loose_keys.erase(ObjectIdentifier::for_graph_root());
 
   /* Iterate over the loose objects and connect them to their export parent. */
-  for (const ExportGraph::value_type &map_iter : loose_objects_graph) {
-    const ObjectIdentifier &graph_key = map_iter.first;
+  for (const ObjectIdentifier &graph_key : loose_keys) {
     Object *object = graph_key.object;
 
     while (true) {
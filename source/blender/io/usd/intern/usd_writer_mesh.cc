@@ -25,6 +25,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -235,12 +236,16 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  usd_mesh_data.points.resize(mesh->totvert);
 
+  /* Get the pointer once, non-const access to a #pxr::VtArray checks whether it is shared. */
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
   const MVert *verts = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
-  }
+  parallel_for(IndexRange(mesh->totvert), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      points[i] = pxr::GfVec3f(verts[i].co);
+    }
+  });
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -633,6 +633,13 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe ending the segment found by the last evaluation (runtime, only used
+   * as a starting guess for the next evaluation so it doesn't need to be valid).
+   */
+  int eval_segment_hint;
+  char _pad2[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -301,6 +301,11 @@ typedef struct bNode {
    * needs to be a float to feed GPU_uniform.
    */
   float sss_id;
+
+  /** Runtime: compositor execution time summed over all threads, in milliseconds. */
+  float exec_time;
+  /** Runtime: memory of the compositor buffers written by this node, in megabytes. */
+  float exec_memory;
 } bNode;
 
 /* node->flag */
@@ -447,7 +452,6 @@ typedef struct bNodeTree {
   short is_updating;
   /** Generic temporary flag for recursion check (DFS/BFS). */
   short done;
-  char _pad2[4];
 
   /** Specific node type this tree is used for. */
   int nodetype DNA_DEPRECATED;
@@ -458,6 +462,8 @@ typedef struct bNodeTree {
   short render_quality;
   /** Tile size for compositor engine. */
   int chunksize;
+  /** Memory budget of the compositor engine in megabytes, zero for no limit. */
+  int memory_limit;
 
   rctf viewer_border;
 
@@ -517,6 +523,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_PREVIEW_RESOLUTION (1 << 6) /* viewers first calculate a reduced resolution */
 
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
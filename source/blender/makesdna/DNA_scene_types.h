@@ -2163,6 +2163,7 @@ enum {
   FFMPEG_AUTOSPLIT_OUTPUT = (1 << 1),
   FFMPEG_LOSSLESS_OUTPUT = (1 << 2),
   FFMPEG_USE_MAX_B_FRAMES = (1 << 3),
+  FFMPEG_USE_HW_ENCODER = (1 << 4),
 };
 
 /* Paint.flags */
@@ -644,7 +644,11 @@ typedef struct UserDef_Experimental {
   char use_switch_object_operator;
   char use_sculpt_tools_tilt;
   char use_asset_browser;
-  char _pad[7];
+  char use_undo_incremental;
+  char use_playback_prefetch;
+  char use_geometry_nodes_cache;
+  char use_viewport_lod;
+  char _pad[3];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -904,7 +908,10 @@ typedef struct UserDef {
   int sequencer_disk_cache_compression; /* eUserpref_DiskCacheCompression */
   int sequencer_disk_cache_size_limit;
   short sequencer_disk_cache_flag;
-  char _pad5[2];
+  short video_flag; /* eUserpref_VideoFlag */
+  /** Strips to build proxies for in parallel, zero for automatic. */
+  short sequencer_proxy_build_jobs;
+  char _pad5[6];
 
   float collection_instance_empty_size;
   char _pad10[3];
@@ -1364,8 +1371,14 @@ typedef enum eUserpref_DiskCacheCompression {
   USER_SEQ_DISK_CACHE_COMPRESSION_NONE = 0,
   USER_SEQ_DISK_CACHE_COMPRESSION_LOW = 1,
   USER_SEQ_DISK_CACHE_COMPRESSION_HIGH = 2,
+  USER_SEQ_DISK_CACHE_COMPRESSION_FAST = 3,
 } eUserpref_DiskCacheCompression;
 
+/** #UserDef.video_flag */
+typedef enum eUserpref_VideoFlag {
+  USER_VIDEO_HARDWARE_DECODE = (1 << 0),
+} eUserpref_VideoFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
@@ -156,6 +156,8 @@ typedef struct wmWindowManager {
 
   /** Refresh/redraw wmNotifier structs. */
   ListBase queue;
+  /** Lookup table for the notifiers in #queue, to quickly find duplicates (runtime). */
+  struct GSet *notifier_queue_set;
 
   /** Information and error reports. */
   struct ReportList reports;
@@ -252,6 +252,33 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static bool rna_Depsgraph_use_debug_profile_get(PointerRNA *ptr)
+{
+  Depsgraph *depsgraph = (Depsgraph *)ptr->data;
+  return DEG_debug_profile_is_enabled(depsgraph);
+}
+
+static void rna_Depsgraph_use_debug_profile_set(PointerRNA *ptr, bool value)
+{
+  Depsgraph *depsgraph = (Depsgraph *)ptr->data;
+  DEG_debug_profile_enable(depsgraph, value);
+}
+
+static void rna_Depsgraph_debug_profile_chrome_trace(Depsgraph *depsgraph, const char *filename)
+{
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) {
+    return;
+  }
+  DEG_debug_profile_chrome_trace(depsgraph, f);
+  fclose(f);
+}
+
+static void rna_Depsgraph_debug_profile_summary(Depsgraph *depsgraph, char *result)
+{
+  DEG_debug_profile_summary(depsgraph, result, STATS_MAX_SIZE);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -666,6 +693,29 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  prop = RNA_def_property(srna, "use_debug_profile", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_funcs(
+      prop, "rna_Depsgraph_use_debug_profile_get", "rna_Depsgraph_use_debug_profile_set");
+  RNA_def_property_ui_text(
+      prop,
+      "Profile Evaluation",
+      "Gather timing of every operation for the last few evaluations of the dependency graph");
+
+  func = RNA_def_function(
+      srna, "debug_profile_chrome_trace", "rna_Depsgraph_debug_profile_chrome_trace");
+  RNA_def_function_ui_description(
+      func, "Write the gathered evaluation profile as a Chrome trace event file");
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
+  func = RNA_def_function(srna, "debug_profile_summary", "rna_Depsgraph_debug_profile_summary");
+  RNA_def_function_ui_description(
+      func, "Report the slowest operations of the gathered evaluation profile");
+  parm = RNA_def_string(func, "result", NULL, STATS_MAX_SIZE, "result", "");
+  RNA_def_parameter_flags(parm, PROP_THICK_WRAP, 0); /* needed for string return value */
+  RNA_def_function_output(func, parm);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -52,6 +52,10 @@
 
 #  include "MEM_guardedalloc.h"
 
+#  ifdef WITH_PYTHON
+#    include "BPY_extern.h"
+#  endif
+
 static void rna_ImagePackedFile_save(ImagePackedFile *imapf, Main *bmain, ReportList *reports)
 {
   if (BKE_packedfile_write_to_file(
@@ -91,7 +95,17 @@ static void rna_Image_save_render(
       write_ibuf->planes = scene->r.im_format.planes;
       write_ibuf->dither = scene->r.dither_intensity;
 
-      if (!BKE_imbuf_write(write_ibuf, path, &scene->r.im_format)) {
+      bool ok;
+      /* Encoding and writing can take a while, let other Python threads run meanwhile. */
+#  ifdef WITH_PYTHON
+      BPy_BEGIN_ALLOW_THREADS;
+#  endif
+      ok = BKE_imbuf_write(write_ibuf, path, &scene->r.im_format);
+#  ifdef WITH_PYTHON
+      BPy_END_ALLOW_THREADS;
+#  endif
+
+      if (!ok) {
         BKE_reportf(reports, RPT_ERROR, "Could not write image: %s, '%s'", strerror(errno), path);
       }
 
@@ -120,7 +134,16 @@ static void rna_Image_save(Image *image, Main *bmain, bContext *C, ReportList *r
     /* note, we purposefully ignore packed files here,
      * developers need to explicitly write them via 'packed_files' */
 
-    if (IMB_saveiff(ibuf, filename, ibuf->flags)) {
+    bool ok;
+#  ifdef WITH_PYTHON
+    BPy_BEGIN_ALLOW_THREADS;
+#  endif
+    ok = IMB_saveiff(ibuf, filename, ibuf->flags);
+#  ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#  endif
+
+    if (ok) {
       image->type = IMA_TYPE_IMAGE;
 
       if (image->source == IMA_SRC_GENERATED) {
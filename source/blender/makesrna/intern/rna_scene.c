@@ -5862,6 +5862,15 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
       prop, "Encoding Speed", "Tradeoff between encoding speed and compression ratio");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_hardware_encoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", FFMPEG_USE_HW_ENCODER);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Encoding",
+                           "Encode on the GPU when a hardware encoder is available for the codec, "
+                           "falls back to the software encoder otherwise");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_autosplit", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flags", FFMPEG_AUTOSPLIT_OUTPUT);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -5334,6 +5334,11 @@ static void rna_def_userdef_system(BlenderRNA *brna)
        0,
        "None",
        "Requires fast storage, but uses minimum CPU resources"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_FAST,
+       "FAST",
+       0,
+       "Fast",
+       "Compresses less than Low, but is quick enough to keep up with playback"},
       {USER_SEQ_DISK_CACHE_COMPRESSION_LOW,
        "LOW",
        0,
@@ -5414,6 +5419,21 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Disk Cache Compression Level",
       "Smaller compression will result in larger files, but less decoding overhead");
 
+  prop = RNA_def_property(srna, "sequencer_proxy_build_jobs", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "sequencer_proxy_build_jobs");
+  RNA_def_property_range(prop, 0, 16);
+  RNA_def_property_ui_text(prop,
+                           "Proxy Build Jobs",
+                           "Number of strips to build proxies for at the same time, 0 to use a "
+                           "quarter of the system threads");
+
+  prop = RNA_def_property(srna, "use_hardware_video_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "video_flag", USER_VIDEO_HARDWARE_DECODE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movie strips and clips on the GPU when the codec is supported, "
+                           "applies to movies opened afterwards");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -6242,6 +6262,34 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop,
       "Asset Browser",
       "Enable Asset Browser editor and operators to manage data-blocks as asset");
+
+  prop = RNA_def_property(srna, "use_undo_incremental", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_incremental", 1);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Undo",
+                           "Only store geometry data-blocks tagged as changed in undo steps, "
+                           "reusing the previous undo step for all others");
+
+  prop = RNA_def_property(srna, "use_playback_prefetch", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_playback_prefetch", 1);
+  RNA_def_property_ui_text(prop,
+                           "Playback Prefetch",
+                           "Evaluate the animated meshes of upcoming frames in the background "
+                           "during animation playback");
+
+  prop = RNA_def_property(srna, "use_geometry_nodes_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_geometry_nodes_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Geometry Nodes Cache",
+                           "Keep the results of geometry nodes between evaluations, to skip "
+                           "evaluating nodes whose inputs did not change");
+
+  prop = RNA_def_property(srna, "use_viewport_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_viewport_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Level of Detail",
+                           "Draw dense meshes that are small on screen with automatically "
+                           "decimated geometry in solid mode");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
@@ -21,16 +21,22 @@
  * \ingroup modifiers
  */
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_float3.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -43,6 +49,7 @@
 #include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_customdata.h"
 #include "BKE_global.h"
@@ -212,10 +219,126 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return false;
 }
 
+/**
+ * Outputs of nodes from the previous evaluation of the modifier, stored in the runtime data of
+ * the evaluated modifier. Outputs are identified by a hash of everything that can influence
+ * them: the node type and settings and the hashes of all its inputs. That way unchanged parts of
+ * the tree are not evaluated again, when only nodes further down the tree have been changed.
+ */
+struct NodesModifierCache {
+  struct Outputs {
+    /** Everything the hash is computed from, compared on a hit to rule out hash collisions. */
+    std::string key;
+    /** Values of the available outputs of the node, owned by the cache. */
+    Vector<GMutablePointer> values;
+  };
+  Map<uint64_t, Outputs> outputs_by_hash;
+
+  ~NodesModifierCache()
+  {
+    for (Outputs &outputs : outputs_by_hash.values()) {
+      free_values(outputs.values);
+    }
+  }
+
+  static void free_values(Span<GMutablePointer> values)
+  {
+    for (GMutablePointer value : values) {
+      value.destruct();
+      MEM_freeN(value.get());
+    }
+  }
+};
+
+static uint64_t hash_combine(const uint64_t hash, const uint64_t value)
+{
+  /* Mix the bits of the value, since many default hashes are the identity function, which would
+   * make differently ordered inputs likely to have the same combined hash. */
+  uint64_t x = value + 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  x = x ^ (x >> 31);
+  return (hash ^ x) * 0x100000001b3ull;
+}
+
+static uint64_t hash_custom_data(const CustomData &data, const int size, uint64_t hash)
+{
+  for (const int i : IndexRange(data.totlayer)) {
+    const CustomDataLayer &layer = data.layers[i];
+    hash = hash_combine(hash, layer.type);
+    hash = hash_combine(hash, blender::hash_string(layer.name));
+    if (layer.data != nullptr) {
+      hash = hash_combine(hash,
+                          BLI_hash_mm2(static_cast<const unsigned char *>(layer.data),
+                                       (size_t)CustomData_sizeof(layer.type) * size,
+                                       0));
+    }
+  }
+  return hash;
+}
+
+/**
+ * Hash the content of the geometry the modifier is evaluated on. Only meshes are supported, the
+ * evaluation isn't cached for other geometry types.
+ */
+static std::optional<uint64_t> geometry_set_content_hash(const GeometrySet &geometry_set,
+                                                         const Object &object)
+{
+  if (geometry_set.has_pointcloud() || geometry_set.has_instances() ||
+      geometry_set.has_volume()) {
+    return std::nullopt;
+  }
+  uint64_t hash = 0;
+  /* Vertex group names are passed from the object to the mesh component. */
+  LISTBASE_FOREACH (const bDeformGroup *, defgroup, &object.defbase) {
+    hash = hash_combine(hash, blender::hash_string(defgroup->name));
+  }
+  const Mesh *mesh = geometry_set.get_mesh_for_read();
+  if (mesh == nullptr) {
+    return hash;
+  }
+  hash = hash_combine(hash, mesh->totvert);
+  hash = hash_combine(hash, mesh->totedge);
+  hash = hash_combine(hash, mesh->totloop);
+  hash = hash_combine(hash, mesh->totpoly);
+  hash = hash_custom_data(mesh->vdata, mesh->totvert, hash);
+  hash = hash_custom_data(mesh->edata, mesh->totedge, hash);
+  hash = hash_custom_data(mesh->ldata, mesh->totloop, hash);
+  hash = hash_custom_data(mesh->pdata, mesh->totpoly, hash);
+  return hash;
+}
+
+/**
+ * Evaluates the nodes that are required to compute the group outputs. Nodes are scheduled in a
+ * task pool as soon as all their linked inputs have been computed, so that independent branches
+ * of the tree are evaluated in parallel.
+ */
 class GeometryNodesEvaluator {
  private:
+  using NodeHash = std::optional<uint64_t>;
+
+  /** Evaluation state of a node that is required to compute the group outputs. */
+  struct NodeState {
+    /** Number of linked inputs whose value has not been computed yet. */
+    std::atomic<int> missing_inputs = 0;
+    /**
+     * Values computed while executing the node are allocated here, because the allocator is not
+     * thread-safe and nodes may be executed on different threads at the same time.
+     */
+    blender::LinearAllocator<> allocator;
+    /** Used to cache the outputs, unset when the outputs can't be cached. */
+    NodeHash hash;
+    /** Copies of the outputs that are stored in the cache after the evaluation. */
+    Vector<GMutablePointer> outputs_to_cache;
+  };
+
   blender::LinearAllocator<> allocator_;
+  /**
+   * Contains all inputs that are required to compute the group outputs. The map is filled
+   * before the evaluation starts, so that its values can be set from multiple threads.
+   */
   Map<const DInputSocket *, GMutablePointer> value_by_input_;
+  Map<const DNode *, std::unique_ptr<NodeState>> node_states_;
   Vector<const DInputSocket *> group_outputs_;
   blender::nodes::MultiFunctionByNode &mf_by_node_;
   const blender::nodes::DataTypeConversions &conversions_;
@@ -223,106 +346,411 @@ class GeometryNodesEvaluator {
   const Object *self_object_;
   Depsgraph *depsgraph_;
 
+  /** Outputs of the previous evaluation, null when caching is disabled. */
+  NodesModifierCache *cache_;
+  /** Hash of the geometry passed to the modifier, unset when it can't be hashed. */
+  NodeHash input_geometry_hash_;
+  Map<const DNode *, NodeHash> hash_by_node_;
+  /** Data the hashes of the nodes are computed from, only set for nodes that have a hash. */
+  Map<const DNode *, std::string> key_by_node_;
+  /** Nodes whose outputs are taken from the cache instead of executing them. */
+  Map<const DNode *, uint64_t> cached_nodes_;
+
  public:
   GeometryNodesEvaluator(const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
                          Vector<const DInputSocket *> group_outputs,
                          blender::nodes::MultiFunctionByNode &mf_by_node,
                          const PersistentDataHandleMap &handle_map,
                          const Object *self_object,
-                         Depsgraph *depsgraph)
+                         Depsgraph *depsgraph,
+                         NodesModifierCache *cache,
+                         NodeHash input_geometry_hash)
       : group_outputs_(std::move(group_outputs)),
         mf_by_node_(mf_by_node),
         conversions_(blender::nodes::get_implicit_type_conversions()),
         handle_map_(handle_map),
         self_object_(self_object),
-        depsgraph_(depsgraph)
+        depsgraph_(depsgraph),
+        cache_(cache),
+        input_geometry_hash_(input_geometry_hash)
   {
+    Vector<const DOutputSocket *> unavailable_outputs;
+    this->find_required_nodes(group_input_data, unavailable_outputs);
+
     for (auto item : group_input_data.items()) {
-      this->forward_to_inputs(*item.key, item.value);
+      this->forward_to_inputs(*item.key, item.value, allocator_);
+    }
+    for (auto item : cached_nodes_.items()) {
+      this->forward_cached_outputs(*item.key, cache_->outputs_by_hash.lookup(item.value).values);
+    }
+    for (const DOutputSocket *socket : unavailable_outputs) {
+      /* If the output is not available, use a default value. */
+      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket->typeinfo());
+      void *buffer = allocator_.allocate(type.size(), type.alignment());
+      type.copy_to_uninitialized(type.default_value(), buffer);
+      this->forward_to_inputs(*socket, {type, buffer}, allocator_);
     }
   }
 
   Vector<GMutablePointer> execute()
   {
+    TaskPool *task_pool = BLI_task_pool_create(this, TASK_PRIORITY_HIGH);
+    for (auto item : node_states_.items()) {
+      if (item.value->missing_inputs == 0) {
+        BLI_task_pool_push(task_pool, execute_node_task, (void *)item.key, false, nullptr);
+      }
+    }
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+
+    if (cache_ != nullptr) {
+      this->update_cache();
+    }
+
     Vector<GMutablePointer> results;
     for (const DInputSocket *group_output : group_outputs_) {
-      GMutablePointer result = this->get_input_value(*group_output);
+      GMutablePointer result = value_by_input_.lookup(group_output);
+      if (result.get() == nullptr) {
+        result = this->get_unlinked_input_value(*group_output, allocator_);
+      }
+      value_by_input_.remove(group_output);
       results.append(result);
     }
     for (GMutablePointer value : value_by_input_.values()) {
-      value.destruct();
+      if (value.get() != nullptr) {
+        value.destruct();
+      }
     }
     return results;
   }
 
  private:
-  GMutablePointer get_input_value(const DInputSocket &socket_to_compute)
+  /**
+   * Find the nodes that have to be executed to compute the group outputs, starting at the group
+   * outputs and following links backwards. Unused parts of the tree are never evaluated and
+   * unused outputs are freed right after the node computed them.
+   */
+  void find_required_nodes(const Map<const DOutputSocket *, GMutablePointer> &group_input_data,
+                           Vector<const DOutputSocket *> &r_unavailable_outputs)
   {
-    std::optional<GMutablePointer> value = value_by_input_.pop_try(&socket_to_compute);
-    if (value.has_value()) {
-      /* This input has been computed before, return it directly. */
-      return *value;
+    Vector<const DInputSocket *> sockets_to_check = group_outputs_;
+    Set<const DOutputSocket *> handled_unavailable_outputs;
+    while (!sockets_to_check.is_empty()) {
+      const DInputSocket &socket = *sockets_to_check.pop_last();
+      if (!value_by_input_.add(&socket, {})) {
+        continue;
+      }
+      BLI_assert(socket.linked_sockets().size() + socket.linked_group_inputs().size() <= 1);
+      if (socket.linked_sockets().is_empty()) {
+        /* The value is taken from the socket itself or from the group input it is linked to. */
+        continue;
+      }
+      const DOutputSocket &from_socket = *socket.linked_sockets()[0];
+      if (group_input_data.contains(&from_socket)) {
+        continue;
+      }
+      if (!from_socket.is_available()) {
+        if (handled_unavailable_outputs.add(&from_socket)) {
+          r_unavailable_outputs.append(&from_socket);
+        }
+        continue;
+      }
+      const DNode &from_node = from_socket.node();
+      if (node_states_.contains(&from_node) || cached_nodes_.contains(&from_node)) {
+        continue;
+      }
+      NodeHash hash;
+      if (cache_ != nullptr) {
+        hash = this->node_hash(from_node, group_input_data);
+        if (hash.has_value() && this->is_cached(from_node, *hash)) {
+          /* The inputs of the node don't have to be computed. */
+          cached_nodes_.add_new(&from_node, *hash);
+          continue;
+        }
+      }
+      std::unique_ptr<NodeState> state = std::make_unique<NodeState>();
+      state->hash = hash;
+      node_states_.add_new(&from_node, std::move(state));
+      for (const DInputSocket *input_socket : from_node.inputs()) {
+        if (input_socket->is_available()) {
+          sockets_to_check.append(input_socket);
+        }
+      }
     }
 
-    Span<const DOutputSocket *> from_sockets = socket_to_compute.linked_sockets();
-    Span<const DGroupInput *> from_group_inputs = socket_to_compute.linked_group_inputs();
-    const int total_inputs = from_sockets.size() + from_group_inputs.size();
-    BLI_assert(total_inputs <= 1);
-
-    if (total_inputs == 0) {
-      /* The input is not connected, use the value from the socket itself. */
-      return get_unlinked_input_value(socket_to_compute);
+    /* Count the inputs that are computed by other nodes during the evaluation. */
+    for (auto item : node_states_.items()) {
+      for (const DInputSocket *input_socket : item.key->inputs()) {
+        if (input_socket->is_available() && this->is_computed_by_node(*input_socket)) {
+          item.value->missing_inputs++;
+        }
+      }
     }
-    if (from_group_inputs.size() == 1) {
-      /* The input gets its value from the input of a group that is not further connected. */
-      return get_unlinked_input_value(socket_to_compute);
+  }
+
+  bool is_computed_by_node(const DInputSocket &socket) const
+  {
+    if (socket.linked_sockets().is_empty()) {
+      return false;
     }
+    const DOutputSocket &from_socket = *socket.linked_sockets()[0];
+    return from_socket.is_available() && node_states_.contains(&from_socket.node());
+  }
 
-    /* Compute the socket now. */
-    const DOutputSocket &from_socket = *from_sockets[0];
-    this->compute_output_and_forward(from_socket);
-    return value_by_input_.pop(&socket_to_compute);
+  NodeHash node_hash(const DNode &node,
+                     const Map<const DOutputSocket *, GMutablePointer> &group_input_data)
+  {
+    const NodeHash *hash = hash_by_node_.lookup_ptr(&node);
+    if (hash != nullptr) {
+      return *hash;
+    }
+    const NodeHash new_hash = this->compute_node_hash(node, group_input_data);
+    hash_by_node_.add_new(&node, new_hash);
+    return new_hash;
   }
 
-  void compute_output_and_forward(const DOutputSocket &socket_to_compute)
+  NodeHash compute_node_hash(const DNode &node,
+                             const Map<const DOutputSocket *, GMutablePointer> &group_input_data)
   {
-    const DNode &node = socket_to_compute.node();
+    /* The outputs of nodes referencing objects or collections depend on data outside of the node
+     * tree, so they can't be cached. */
+    for (const DInputSocket *socket : node.inputs()) {
+      if (ELEM(socket->bsocket()->type, SOCK_OBJECT, SOCK_COLLECTION)) {
+        return std::nullopt;
+      }
+    }
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (ELEM(socket->bsocket()->type, SOCK_OBJECT, SOCK_COLLECTION)) {
+        return std::nullopt;
+      }
+    }
+
     const bNode &bnode = *node.bnode();
+    std::string key = bnode.idname;
+    auto add_to_key = [&](const void *data, const size_t size) {
+      key.append(static_cast<const char *>(data), size);
+    };
+    add_to_key(&bnode.custom1, sizeof(bnode.custom1));
+    add_to_key(&bnode.custom2, sizeof(bnode.custom2));
+    add_to_key(&bnode.custom3, sizeof(bnode.custom3));
+    add_to_key(&bnode.custom4, sizeof(bnode.custom4));
+
+    uint64_t hash = blender::hash_string(bnode.idname);
+    hash = hash_combine(hash, bnode.custom1);
+    hash = hash_combine(hash, bnode.custom2);
+    hash = hash_combine(hash, blender::DefaultHash<float>{}(bnode.custom3));
+    hash = hash_combine(hash, blender::DefaultHash<float>{}(bnode.custom4));
+    if (bnode.storage != nullptr) {
+      const size_t storage_size = MEM_allocN_len(bnode.storage);
+      add_to_key(bnode.storage, storage_size);
+      hash = hash_combine(
+          hash,
+          BLI_hash_mm2(static_cast<const unsigned char *>(bnode.storage), storage_size, 0));
+    }
+    if (bnode.id != nullptr) {
+      /* The data-block referenced by the node (e.g. a texture) can change without the node
+       * changing. It is tagged for update in that case, then the outputs can't be reused. */
+      if (bnode.id->recalc != 0) {
+        return std::nullopt;
+      }
+      const uint session_uuid = DEG_get_original_id(bnode.id)->session_uuid;
+      add_to_key(&session_uuid, sizeof(session_uuid));
+      hash = hash_combine(hash, session_uuid);
+    }
+    for (const DInputSocket *socket : node.inputs()) {
+      if (socket->is_available()) {
+        const NodeHash input_hash = this->input_hash(*socket, group_input_data);
+        if (!input_hash.has_value()) {
+          return std::nullopt;
+        }
+        add_to_key(&*input_hash, sizeof(*input_hash));
+        hash = hash_combine(hash, *input_hash);
+      }
+    }
+    key_by_node_.add_new(&node, std::move(key));
+    return hash;
+  }
 
-    if (!socket_to_compute.is_available()) {
-      /* If the output is not available, use a default value. */
-      const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket_to_compute.typeinfo());
-      void *buffer = allocator_.allocate(type.size(), type.alignment());
-      type.copy_to_uninitialized(type.default_value(), buffer);
-      this->forward_to_inputs(socket_to_compute, {type, buffer});
-      return;
+  NodeHash input_hash(const DInputSocket &socket,
+                      const Map<const DOutputSocket *, GMutablePointer> &group_input_data)
+  {
+    if (socket.linked_sockets().is_empty()) {
+      if (socket.bsocket()->type == SOCK_GEOMETRY) {
+        /* Unlinked geometry inputs are empty. */
+        return 0;
+      }
+      GMutablePointer value = this->get_unlinked_input_value(socket, allocator_);
+      const uint64_t hash = value.type()->hash(value.get());
+      value.destruct();
+      return hash;
+    }
+    const DOutputSocket &from_socket = *socket.linked_sockets()[0];
+    const GMutablePointer *group_input_value = group_input_data.lookup_ptr(&from_socket);
+    if (group_input_value != nullptr) {
+      if (group_input_value->type()->is<GeometrySet>()) {
+        return input_geometry_hash_;
+      }
+      return group_input_value->type()->hash(group_input_value->get());
+    }
+    if (!from_socket.is_available()) {
+      return blender::hash_string(from_socket.idname());
+    }
+    const NodeHash from_node_hash = this->node_hash(from_socket.node(), group_input_data);
+    if (!from_node_hash.has_value()) {
+      return std::nullopt;
+    }
+    return hash_combine(*from_node_hash, from_socket.index());
+  }
+
+  static int available_outputs_num(const DNode &node)
+  {
+    int num = 0;
+    for (const DOutputSocket *socket : node.outputs()) {
+      if (socket->is_available()) {
+        num++;
+      }
+    }
+    return num;
+  }
+
+  bool is_cached(const DNode &node, const uint64_t hash) const
+  {
+    const NodesModifierCache::Outputs *outputs = cache_->outputs_by_hash.lookup_ptr(hash);
+    return outputs != nullptr && outputs->key == key_by_node_.lookup(&node) &&
+           outputs->values.size() == available_outputs_num(node);
+  }
+
+  void forward_cached_outputs(const DNode &node, Span<GMutablePointer> cached_values)
+  {
+    int value_index = 0;
+    for (const DOutputSocket *output_socket : node.outputs()) {
+      if (output_socket->is_available()) {
+        const GMutablePointer cached_value = cached_values[value_index++];
+        const CPPType &type = *cached_value.type();
+        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        type.copy_to_uninitialized(cached_value.get(), buffer);
+        this->forward_to_inputs(*output_socket, {type, buffer}, allocator_);
+      }
+    }
+  }
+
+  /**
+   * Only keep the outputs of nodes used in this evaluation, so that the cache doesn't grow while
+   * the node tree is changed.
+   */
+  void update_cache()
+  {
+    Map<uint64_t, NodesModifierCache::Outputs> new_outputs_by_hash;
+    for (const uint64_t hash : cached_nodes_.values()) {
+      if (!new_outputs_by_hash.contains(hash)) {
+        new_outputs_by_hash.add_new(hash, cache_->outputs_by_hash.pop(hash));
+      }
     }
+    for (auto item : node_states_.items()) {
+      NodeState &state = *item.value;
+      if (!state.hash.has_value()) {
+        continue;
+      }
+      if (new_outputs_by_hash.contains(*state.hash)) {
+        /* Another node computed the same values, or the hash collides. */
+        NodesModifierCache::free_values(state.outputs_to_cache);
+      }
+      else {
+        new_outputs_by_hash.add_new(
+            *state.hash,
+            {key_by_node_.lookup(item.key), std::move(state.outputs_to_cache)});
+      }
+    }
+    for (NodesModifierCache::Outputs &outputs : cache_->outputs_by_hash.values()) {
+      NodesModifierCache::free_values(outputs.values);
+    }
+    cache_->outputs_by_hash = std::move(new_outputs_by_hash);
+  }
+
+  static void execute_node_task(TaskPool *__restrict pool, void *taskdata)
+  {
+    GeometryNodesEvaluator &evaluator = *(GeometryNodesEvaluator *)BLI_task_pool_user_data(pool);
+    const DNode &node = *(const DNode *)taskdata;
+    evaluator.compute_node_and_forward(node);
+
+    /* Schedule the nodes that have all their inputs now. */
+    for (const DOutputSocket *output_socket : node.outputs()) {
+      if (!output_socket->is_available()) {
+        continue;
+      }
+      for (const DInputSocket *to_socket : output_socket->linked_sockets()) {
+        const std::unique_ptr<NodeState> *to_state = evaluator.node_states_.lookup_ptr(
+            &to_socket->node());
+        if (to_state == nullptr || !to_socket->is_available()) {
+          continue;
+        }
+        if ((*to_state)->missing_inputs.fetch_sub(1) == 1) {
+          BLI_task_pool_push(pool, execute_node_task, (void *)&to_socket->node(), false, nullptr);
+        }
+      }
+    }
+  }
+
+  GMutablePointer get_input_value(const DInputSocket &socket_to_compute,
+                                  blender::LinearAllocator<> &allocator)
+  {
+    GMutablePointer &value = value_by_input_.lookup(&socket_to_compute);
+    if (value.get() != nullptr) {
+      /* This input has been computed before, take it out of the map. */
+      GMutablePointer result = value;
+      value = {};
+      return result;
+    }
+
+    /* The input is not connected or gets its value from the input of a group that is not
+     * further connected, use the value from the socket itself. */
+    BLI_assert(!this->is_computed_by_node(socket_to_compute));
+    return this->get_unlinked_input_value(socket_to_compute, allocator);
+  }
+
+  void compute_node_and_forward(const DNode &node)
+  {
+    const bNode &bnode = *node.bnode();
+    NodeState &state = *node_states_.lookup(&node);
+    blender::LinearAllocator<> &allocator = state.allocator;
 
     /* Prepare inputs required to execute the node. */
-    GValueMap<StringRef> node_inputs_map{allocator_};
+    GValueMap<StringRef> node_inputs_map{allocator};
     for (const DInputSocket *input_socket : node.inputs()) {
       if (input_socket->is_available()) {
-        GMutablePointer value = this->get_input_value(*input_socket);
+        GMutablePointer value = this->get_input_value(*input_socket, allocator);
         node_inputs_map.add_new_direct(input_socket->identifier(), value);
       }
     }
 
     /* Execute the node. */
-    GValueMap<StringRef> node_outputs_map{allocator_};
+    GValueMap<StringRef> node_outputs_map{allocator};
     GeoNodeExecParams params{
         bnode, node_inputs_map, node_outputs_map, handle_map_, self_object_, depsgraph_};
-    this->execute_node(node, params);
+    this->execute_node(node, params, allocator);
 
     /* Forward computed outputs to linked input sockets. */
     for (const DOutputSocket *output_socket : node.outputs()) {
       if (output_socket->is_available()) {
         GMutablePointer value = node_outputs_map.extract(output_socket->identifier());
-        this->forward_to_inputs(*output_socket, value);
+        if (state.hash.has_value()) {
+          const CPPType &type = *value.type();
+          void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+          type.copy_to_uninitialized(value.get(), buffer);
+          if (type.is<GeometrySet>()) {
+            /* The geometry passed to the modifier is freed after the evaluation. */
+            static_cast<GeometrySet *>(buffer)->ensure_owns_direct_data();
+          }
+          state.outputs_to_cache.append({type, buffer});
+        }
+        this->forward_to_inputs(*output_socket, value, allocator);
       }
     }
   }
 
-  void execute_node(const DNode &node, GeoNodeExecParams params)
+  void execute_node(const DNode &node,
+                    GeoNodeExecParams params,
+                    blender::LinearAllocator<> &allocator)
   {
     const bNode &bnode = params.node();
 
@@ -335,7 +763,7 @@ class GeometryNodesEvaluator {
     /* Use the multi-function implementation if it exists. */
     const MultiFunction *multi_function = mf_by_node_.lookup_default(&node, nullptr);
     if (multi_function != nullptr) {
-      this->execute_multi_function_node(node, params, *multi_function);
+      this->execute_multi_function_node(node, params, *multi_function, allocator);
       return;
     }
 
@@ -345,7 +773,8 @@ class GeometryNodesEvaluator {
 
   void execute_multi_function_node(const DNode &node,
                                    GeoNodeExecParams params,
-                                   const MultiFunction &fn)
+                                   const MultiFunction &fn,
+                                   blender::LinearAllocator<> &allocator)
   {
     MFContextBuilder fn_context;
     MFParamsBuilder fn_params{fn, 1};
@@ -361,7 +790,7 @@ class GeometryNodesEvaluator {
     for (const DOutputSocket *dsocket : node.outputs()) {
       if (dsocket->is_available()) {
         const CPPType &type = *blender::nodes::socket_cpp_type_get(*dsocket->typeinfo());
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         fn_params.add_uninitialized_single_output(GMutableSpan(type, buffer, 1));
         output_data.append(GMutablePointer(type, buffer));
       }
@@ -391,7 +820,13 @@ class GeometryNodesEvaluator {
     }
   }
 
-  void forward_to_inputs(const DOutputSocket &from_socket, GMutablePointer value_to_forward)
+  /**
+   * Pass the value to all required inputs linked to the socket. The value is moved to one of
+   * them, so geometry that is used by a single node is never copied.
+   */
+  void forward_to_inputs(const DOutputSocket &from_socket,
+                         GMutablePointer value_to_forward,
+                         blender::LinearAllocator<> &allocator)
   {
     Span<const DInputSocket *> to_sockets_all = from_socket.linked_sockets();
 
@@ -399,19 +834,24 @@ class GeometryNodesEvaluator {
 
     Vector<const DInputSocket *> to_sockets_same_type;
     for (const DInputSocket *to_socket : to_sockets_all) {
+      GMutablePointer *to_value = value_by_input_.lookup_ptr(to_socket);
+      if (to_value == nullptr) {
+        /* This input is not used to compute the group outputs. */
+        continue;
+      }
       const CPPType &to_type = *blender::nodes::socket_cpp_type_get(*to_socket->typeinfo());
       if (from_type == to_type) {
         to_sockets_same_type.append(to_socket);
       }
       else {
-        void *buffer = allocator_.allocate(to_type.size(), to_type.alignment());
+        void *buffer = allocator.allocate(to_type.size(), to_type.alignment());
         if (conversions_.is_convertible(from_type, to_type)) {
           conversions_.convert(from_type, to_type, value_to_forward.get(), buffer);
         }
         else {
           to_type.copy_to_uninitialized(to_type.default_value(), buffer);
         }
-        value_by_input_.add_new(to_socket, GMutablePointer{to_type, buffer});
+        *to_value = GMutablePointer{to_type, buffer};
       }
     }
 
@@ -422,7 +862,7 @@ class GeometryNodesEvaluator {
     else if (to_sockets_same_type.size() == 1) {
       /* This value is only used on one input socket, no need to copy it. */
       const DInputSocket *to_socket = to_sockets_same_type[0];
-      value_by_input_.add_new(to_socket, value_to_forward);
+      value_by_input_.lookup(to_socket) = value_to_forward;
     }
     else {
       /* Multiple inputs use the value, make a copy for every input except for one. */
@@ -430,16 +870,17 @@ class GeometryNodesEvaluator {
       Span<const DInputSocket *> other_to_sockets = to_sockets_same_type.as_span().drop_front(1);
       const CPPType &type = *value_to_forward.type();
 
-      value_by_input_.add_new(first_to_socket, value_to_forward);
       for (const DInputSocket *to_socket : other_to_sockets) {
-        void *buffer = allocator_.allocate(type.size(), type.alignment());
+        void *buffer = allocator.allocate(type.size(), type.alignment());
         type.copy_to_uninitialized(value_to_forward.get(), buffer);
-        value_by_input_.add_new(to_socket, GMutablePointer{type, buffer});
+        value_by_input_.lookup(to_socket) = GMutablePointer{type, buffer};
       }
+      value_by_input_.lookup(first_to_socket) = value_to_forward;
     }
   }
 
-  GMutablePointer get_unlinked_input_value(const DInputSocket &socket)
+  GMutablePointer get_unlinked_input_value(const DInputSocket &socket,
+                                           blender::LinearAllocator<> &allocator)
   {
     bNodeSocket *bsocket;
     if (socket.linked_group_inputs().size() == 0) {
@@ -449,7 +890,7 @@ class GeometryNodesEvaluator {
       bsocket = socket.linked_group_inputs()[0]->bsocket();
     }
     const CPPType &type = *blender::nodes::socket_cpp_type_get(*socket.typeinfo());
-    void *buffer = allocator_.allocate(type.size(), type.alignment());
+    void *buffer = allocator.allocate(type.size(), type.alignment());
 
     if (bsocket->type == SOCK_OBJECT) {
       Object *object = ((bNodeSocketValueObject *)bsocket->default_value)->value;
@@ -885,8 +1326,7 @@ static void fill_data_handle_map(const NodesModifierSettings &settings,
 
 /**
  * Evaluate a node group to compute the output geometry.
- * Currently, this uses a fairly basic and inefficient algorithm that might compute things more
- * often than necessary. It's going to be replaced soon.
+ * Only the nodes which the output depends on are executed, each of them exactly once.
  */
 static GeometrySet compute_geometry(const DerivedNodeTree &tree,
                                     Span<const DOutputSocket *> group_input_sockets,
@@ -902,6 +1342,24 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   PersistentDataHandleMap handle_map;
   fill_data_handle_map(nmd->settings, tree, handle_map);
 
+  /* The cache is stored in the evaluated modifier, which is kept between evaluations. */
+  NodesModifierCache *cache = static_cast<NodesModifierCache *>(nmd->modifier.runtime);
+  if (USER_EXPERIMENTAL_TEST(&U, use_geometry_nodes_cache)) {
+    if (cache == nullptr) {
+      cache = new NodesModifierCache();
+      nmd->modifier.runtime = cache;
+    }
+  }
+  else if (cache != nullptr) {
+    delete cache;
+    cache = nullptr;
+    nmd->modifier.runtime = nullptr;
+  }
+  std::optional<uint64_t> input_geometry_hash;
+  if (cache != nullptr) {
+    input_geometry_hash = geometry_set_content_hash(input_geometry_set, *ctx->object);
+  }
+
   Map<const DOutputSocket *, GMutablePointer> group_inputs;
 
   if (group_input_sockets.size() > 0) {
@@ -929,8 +1387,14 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   Vector<const DInputSocket *> group_outputs;
   group_outputs.append(&socket_to_compute);
 
-  GeometryNodesEvaluator evaluator{
-      group_inputs, group_outputs, mf_by_node, handle_map, ctx->object, ctx->depsgraph};
+  GeometryNodesEvaluator evaluator{group_inputs,
+                                   group_outputs,
+                                   mf_by_node,
+                                   handle_map,
+                                   ctx->object,
+                                   ctx->depsgraph,
+                                   cache,
+                                   input_geometry_hash};
   Vector<GMutablePointer> results = evaluator.execute();
   BLI_assert(results.size() == 1);
   GMutablePointer result = results[0];
@@ -1181,6 +1645,11 @@ static void freeData(ModifierData *md)
   }
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  delete static_cast<NodesModifierCache *>(runtime_data);
+}
+
 static void requiredDataMask(Object *UNUSED(ob),
                              ModifierData *UNUSED(md),
                              CustomData_MeshMasks *r_cddata_masks)
@@ -1222,7 +1691,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ nullptr,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
@@ -320,6 +320,46 @@ static Mesh *generate_ocean_geometry(OceanModifierData *omd, Mesh *mesh_orig, co
   return result;
 }
 
+/* use cached & inverted value for speed
+ * expanded this would read...
+ *
+ * (axis / (omd->size * omd->spatial_size)) + 0.5f) */
+#  define OCEAN_CO(_size_co_inv, _v) ((_v * _size_co_inv) + 0.5f)
+
+typedef struct DisplaceGeometryData {
+  OceanModifierData *omd;
+  MVert *mverts;
+  float size_co_inv;
+  int cfra_for_cache;
+  bool use_cache;
+} DisplaceGeometryData;
+
+static void displace_geometry_vert(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DisplaceGeometryData *data = userdata;
+  OceanModifierData *omd = data->omd;
+  float *vco = data->mverts[i].co;
+  const float u = OCEAN_CO(data->size_co_inv, vco[0]);
+  const float v = OCEAN_CO(data->size_co_inv, vco[1]);
+  OceanResult ocr;
+
+  if (data->use_cache) {
+    BKE_ocean_cache_eval_uv(omd->oceancache, &ocr, data->cfra_for_cache, u, v);
+  }
+  else {
+    BKE_ocean_eval_uv_unlocked(omd->ocean, &ocr, u, v);
+  }
+
+  vco[2] += ocr.disp[1];
+
+  if (omd->chop_amount > 0.0f) {
+    vco[0] += ocr.disp[0];
+    vco[1] += ocr.disp[2];
+  }
+}
+
 static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
   OceanModifierData *omd = (OceanModifierData *)md;
@@ -338,12 +378,6 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
   int cfra_for_cache;
   int i, j;
 
-  /* use cached & inverted value for speed
-   * expanded this would read...
-   *
-   * (axis / (omd->size * omd->spatial_size)) + 0.5f) */
-#  define OCEAN_CO(_size_co_inv, _v) ((_v * _size_co_inv) + 0.5f)
-
   const float size_co_inv = 1.0f / (omd->size * omd->spatial_size);
 
   /* can happen in when size is small, avoid bad array lookups later and quit now */
@@ -455,29 +489,25 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
 
   /* displace the geometry */
 
-  /* Note: tried to parallelized that one and previous foam loop,
-   * but gives 20% slower results... odd. */
+  /* Note: parallelizing this while every sample locked the ocean was slower, so the lock is only
+   * taken once for all vertices. */
   {
-    const int num_verts = result->totvert;
-
-    for (i = 0; i < num_verts; i++) {
-      float *vco = mverts[i].co;
-      const float u = OCEAN_CO(size_co_inv, vco[0]);
-      const float v = OCEAN_CO(size_co_inv, vco[1]);
-
-      if (omd->oceancache && omd->cached == true) {
-        BKE_ocean_cache_eval_uv(omd->oceancache, &ocr, cfra_for_cache, u, v);
-      }
-      else {
-        BKE_ocean_eval_uv(omd->ocean, &ocr, u, v);
-      }
-
-      vco[2] += ocr.disp[1];
-
-      if (omd->chop_amount > 0.0f) {
-        vco[0] += ocr.disp[0];
-        vco[1] += ocr.disp[2];
-      }
+    DisplaceGeometryData data = {
+        .omd = omd,
+        .mverts = mverts,
+        .size_co_inv = size_co_inv,
+        .cfra_for_cache = cfra_for_cache,
+        .use_cache = (omd->oceancache && omd->cached == true),
+    };
+    if (!data.use_cache) {
+      BKE_ocean_read_lock(omd->ocean);
+    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (result->totvert > 1000);
+    BLI_task_parallel_range(0, result->totvert, &data, displace_geometry_vert, &settings);
+    if (!data.use_cache) {
+      BKE_ocean_read_unlock(omd->ocean);
     }
   }
 
@@ -486,8 +516,6 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
     omd->ocean = NULL;
   }
 
-#  undef OCEAN_CO
-
   return result;
 }
 #else  /* WITH_OCEANSIM */
@@ -21,6 +21,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -133,6 +134,496 @@ static int comp_float_int_pair(const void *a, const void *b)
   return (int)(x->angle > y->angle) - (int)(x->angle < y->angle);
 }
 
+/* Data to calculate the coordinates of the #EdgeGroup's of each original vertex in parallel. */
+typedef struct SolidifyEdgeGroupCoData {
+  const SolidifyModifierData *smd;
+  EdgeGroup **orig_vert_groups_arr;
+  const MEdge *orig_medge;
+  const MLoop *orig_mloop;
+  const uint *vm;
+  const float (*orig_mvert_co)[3];
+  const float (*poly_nors)[3];
+  const bool *null_faces;
+  const float *orig_edge_lengths;
+  const float *face_weight;
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool defgrp_invert;
+  bool do_flat_faces;
+  bool do_clamp;
+  bool do_angle_clamp;
+  float ofs_front_clamped;
+  float ofs_back_clamped;
+  float offset_fac_vg;
+  float offset_fac_vg_inv;
+  float offset;
+} SolidifyEdgeGroupCoData;
+
+/* NOLINTNEXTLINE: readability-function-size */
+static void solidify_edge_group_co_task_cb(void *__restrict userdata,
+                                           const int index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SolidifyEdgeGroupCoData *data = userdata;
+  const SolidifyModifierData *smd = data->smd;
+  const MEdge *orig_medge = data->orig_medge;
+  const MLoop *orig_mloop = data->orig_mloop;
+  const uint *vm = data->vm;
+  const float(*orig_mvert_co)[3] = data->orig_mvert_co;
+  const float(*poly_nors)[3] = data->poly_nors;
+  const bool *null_faces = data->null_faces;
+  const float *orig_edge_lengths = data->orig_edge_lengths;
+  const float *face_weight = data->face_weight;
+  const MDeformVert *dvert = data->dvert;
+  const int defgrp_index = data->defgrp_index;
+  const bool defgrp_invert = data->defgrp_invert;
+  const bool do_flat_faces = data->do_flat_faces;
+  const bool do_clamp = data->do_clamp;
+  const bool do_angle_clamp = data->do_angle_clamp;
+  const float ofs_front_clamped = data->ofs_front_clamped;
+  const float ofs_back_clamped = data->ofs_back_clamped;
+  const float offset_fac_vg = data->offset_fac_vg;
+  const float offset_fac_vg_inv = data->offset_fac_vg_inv;
+  const float offset = data->offset;
+  const uint i = (uint)index;
+  const MLoop *ml;
+
+  EdgeGroup *g = data->orig_vert_groups_arr[i];
+  if (g == NULL) {
+    return;
+  }
+  for (uint j = 0; g->valid; j++, g++) {
+    if (!g->is_singularity) {
+      float *nor = g->no;
+      float move_nor[3] = {0, 0, 0};
+      bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
+                                       MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
+                                   (g->is_orig_closed || g->split));
+      /* Constraints Method. */
+      if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS) {
+        NewEdgeRef *first_edge = NULL;
+        NewEdgeRef **edge_ptr = g->edges;
+        /* Contains normal and offset [nx, ny, nz, ofs]. */
+        float(*normals_queue)[4] = MEM_malloc_arrayN(
+            g->edges_len + 1, sizeof(*normals_queue), "normals_queue in solidify");
+        uint queue_index = 0;
+
+        float face_nors[3][3];
+        float nor_ofs[3];
+
+        const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+        for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+          if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+            NewEdgeRef *edge = *edge_ptr;
+            for (uint l = 0; l < 2; l++) {
+              NewFaceRef *face = edge->faces[l];
+              if (face && (first_edge == NULL ||
+                           (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
+                float ofs = face->reversed ? ofs_back_clamped : ofs_front_clamped;
+                /* Use face_weight here to make faces thinner. */
+                if (do_flat_faces) {
+                  ofs *= face_weight[face->index];
+                }
+
+                if (!null_faces[face->index]) {
+                  /* And normal to the queue. */
+                  mul_v3_v3fl(normals_queue[queue_index],
+                              poly_nors[face->index],
+                              face->reversed ? -1 : 1);
+                  normals_queue[queue_index++][3] = ofs;
+                }
+                else {
+                  /* Just use this approximate normal of the null face if there is no other
+                   * normal to use. */
+                  mul_v3_v3fl(face_nors[0], poly_nors[face->index], face->reversed ? -1 : 1);
+                  nor_ofs[0] = ofs;
+                }
+              }
+            }
+            if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+              first_edge = edge;
+            }
+          }
+        }
+        uint face_nors_len = 0;
+        const float stop_explosion = 0.999f - fabsf(smd->offset_fac) * 0.05f;
+        while (queue_index > 0) {
+          if (face_nors_len == 0) {
+            if (queue_index <= 2) {
+              for (uint k = 0; k < queue_index; k++) {
+                copy_v3_v3(face_nors[k], normals_queue[k]);
+                nor_ofs[k] = normals_queue[k][3];
+              }
+              face_nors_len = queue_index;
+              queue_index = 0;
+            }
+            else {
+              /* Find most different two normals. */
+              float min_p = 2;
+              uint min_n0 = 0;
+              uint min_n1 = 0;
+              for (uint k = 0; k < queue_index; k++) {
+                for (uint m = k + 1; m < queue_index; m++) {
+                  float p = dot_v3v3(normals_queue[k], normals_queue[m]);
+                  if (p <= min_p + FLT_EPSILON) {
+                    min_p = p;
+                    min_n0 = m;
+                    min_n1 = k;
+                  }
+                }
+              }
+              copy_v3_v3(face_nors[0], normals_queue[min_n0]);
+              copy_v3_v3(face_nors[1], normals_queue[min_n1]);
+              nor_ofs[0] = normals_queue[min_n0][3];
+              nor_ofs[1] = normals_queue[min_n1][3];
+              face_nors_len = 2;
+              queue_index--;
+              memmove(normals_queue + min_n0,
+                      normals_queue + min_n0 + 1,
+                      (queue_index - min_n0) * sizeof(*normals_queue));
+              queue_index--;
+              memmove(normals_queue + min_n1,
+                      normals_queue + min_n1 + 1,
+                      (queue_index - min_n1) * sizeof(*normals_queue));
+              min_p = 1;
+              min_n1 = 0;
+              float max_p = -1;
+              for (uint k = 0; k < queue_index; k++) {
+                max_p = -1;
+                for (uint m = 0; m < face_nors_len; m++) {
+                  float p = dot_v3v3(face_nors[m], normals_queue[k]);
+                  if (p > max_p + FLT_EPSILON) {
+                    max_p = p;
+                  }
+                }
+                if (max_p <= min_p + FLT_EPSILON) {
+                  min_p = max_p;
+                  min_n1 = k;
+                }
+              }
+              if (min_p < 0.8) {
+                copy_v3_v3(face_nors[2], normals_queue[min_n1]);
+                nor_ofs[2] = normals_queue[min_n1][3];
+                face_nors_len++;
+                queue_index--;
+                memmove(normals_queue + min_n1,
+                        normals_queue + min_n1 + 1,
+                        (queue_index - min_n1) * sizeof(*normals_queue));
+              }
+            }
+          }
+          else {
+            uint best = 0;
+            uint best_group = 0;
+            float best_p = -1.0f;
+            for (uint k = 0; k < queue_index; k++) {
+              for (uint m = 0; m < face_nors_len; m++) {
+                float p = dot_v3v3(face_nors[m], normals_queue[k]);
+                if (p > best_p + FLT_EPSILON) {
+                  best_p = p;
+                  best = m;
+                  best_group = k;
+                }
+              }
+            }
+            add_v3_v3(face_nors[best], normals_queue[best_group]);
+            normalize_v3(face_nors[best]);
+            nor_ofs[best] = (nor_ofs[best] + normals_queue[best_group][3]) * 0.5f;
+            queue_index--;
+            memmove(normals_queue + best_group,
+                    normals_queue + best_group + 1,
+                    (queue_index - best_group) * sizeof(*normals_queue));
+          }
+        }
+        MEM_freeN(normals_queue);
+
+        /* When up to 3 constraint normals are found. */
+        if (ELEM(face_nors_len, 2, 3)) {
+          const float q = dot_v3v3(face_nors[0], face_nors[1]);
+          float d = 1.0f - q * q;
+          cross_v3_v3v3(move_nor, face_nors[0], face_nors[1]);
+          if (d > FLT_EPSILON * 10 && q < stop_explosion) {
+            d = 1.0f / d;
+            mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
+            mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
+          }
+          else {
+            d = 1.0f / (fabsf(q) + 1.0f);
+            mul_v3_fl(face_nors[0], nor_ofs[0] * d);
+            mul_v3_fl(face_nors[1], nor_ofs[1] * d);
+          }
+          add_v3_v3v3(nor, face_nors[0], face_nors[1]);
+          if (face_nors_len == 3) {
+            float *free_nor = move_nor;
+            mul_v3_fl(face_nors[2], nor_ofs[2]);
+            d = dot_v3v3(face_nors[2], free_nor);
+            if (LIKELY(fabsf(d) > FLT_EPSILON)) {
+              sub_v3_v3v3(face_nors[0], nor, face_nors[2]); /* Override face_nor[0]. */
+              mul_v3_fl(free_nor, dot_v3v3(face_nors[2], face_nors[0]) / d);
+              sub_v3_v3(nor, free_nor);
+            }
+            disable_boundary_fix = true;
+          }
+        }
+        else {
+          BLI_assert(face_nors_len < 2);
+          mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
+          disable_boundary_fix = true;
+        }
+      }
+      /* Fixed/Even Method. */
+      else {
+        float total_angle = 0;
+        float total_angle_back = 0;
+        NewEdgeRef *first_edge = NULL;
+        NewEdgeRef **edge_ptr = g->edges;
+        float face_nor[3];
+        float nor_back[3] = {0, 0, 0};
+        bool has_back = false;
+        bool has_front = false;
+        bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
+        for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
+          if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
+            NewEdgeRef *edge = *edge_ptr;
+            for (uint l = 0; l < 2; l++) {
+              NewFaceRef *face = edge->faces[l];
+              if (face && (first_edge == NULL ||
+                           (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
+                float angle = 1.0f;
+                float ofs = face->reversed ? -ofs_back_clamped : ofs_front_clamped;
+                /* Use face_weight here to make faces thinner. */
+                if (do_flat_faces) {
+                  ofs *= face_weight[face->index];
+                }
+
+                if (smd->nonmanifold_offset_mode ==
+                    MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
+                  const MLoop *ml_next = orig_mloop + face->face->loopstart;
+                  ml = ml_next + (face->face->totloop - 1);
+                  const MLoop *ml_prev = ml - 1;
+                  for (int m = 0; m < face->face->totloop && vm[ml->v] != i;
+                       m++, ml_next++) {
+                    ml_prev = ml;
+                    ml = ml_next;
+                  }
+                  angle = angle_v3v3v3(orig_mvert_co[vm[ml_prev->v]],
+                                       orig_mvert_co[i],
+                                       orig_mvert_co[vm[ml_next->v]]);
+                  if (face->reversed) {
+                    total_angle_back += angle * ofs * ofs;
+                  }
+                  else {
+                    total_angle += angle * ofs * ofs;
+                  }
+                }
+                else {
+                  if (face->reversed) {
+                    total_angle_back++;
+                  }
+                  else {
+                    total_angle++;
+                  }
+                }
+                mul_v3_v3fl(face_nor, poly_nors[face->index], angle * ofs);
+                if (face->reversed) {
+                  add_v3_v3(nor_back, face_nor);
+                  has_back = true;
+                }
+                else {
+                  add_v3_v3(nor, face_nor);
+                  has_front = true;
+                }
+              }
+            }
+            if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
+              first_edge = edge;
+            }
+          }
+        }
+
+        /* Set normal length with selected method. */
+        if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
+          if (has_front) {
+            float length_sq = len_squared_v3(nor);
+            if (LIKELY(length_sq > FLT_EPSILON)) {
+              mul_v3_fl(nor, total_angle / length_sq);
+            }
+          }
+          if (has_back) {
+            float length_sq = len_squared_v3(nor_back);
+            if (LIKELY(length_sq > FLT_EPSILON)) {
+              mul_v3_fl(nor_back, total_angle_back / length_sq);
+            }
+            if (!has_front) {
+              copy_v3_v3(nor, nor_back);
+            }
+          }
+          if (has_front && has_back) {
+            float nor_length = len_v3(nor);
+            float nor_back_length = len_v3(nor_back);
+            float q = dot_v3v3(nor, nor_back);
+            if (LIKELY(fabsf(q) > FLT_EPSILON)) {
+              q /= nor_length * nor_back_length;
+            }
+            float d = 1.0f - q * q;
+            if (LIKELY(d > FLT_EPSILON)) {
+              d = 1.0f / d;
+              if (LIKELY(nor_length > FLT_EPSILON)) {
+                mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
+              }
+              if (LIKELY(nor_back_length > FLT_EPSILON)) {
+                mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
+              }
+              add_v3_v3(nor, nor_back);
+            }
+            else {
+              mul_v3_fl(nor, 0.5f);
+              mul_v3_fl(nor_back, 0.5f);
+              add_v3_v3(nor, nor_back);
+            }
+          }
+        }
+        else {
+          if (has_front && total_angle > FLT_EPSILON) {
+            mul_v3_fl(nor, 1.0f / total_angle);
+          }
+          if (has_back && total_angle_back > FLT_EPSILON) {
+            mul_v3_fl(nor_back, 1.0f / total_angle_back);
+            add_v3_v3(nor, nor_back);
+            if (has_front && total_angle > FLT_EPSILON) {
+              mul_v3_fl(nor, 0.5f);
+            }
+          }
+        }
+        /* Set move_nor for boundary fix. */
+        if (!disable_boundary_fix && g->edges_len > 2) {
+          edge_ptr = g->edges + 1;
+          float tmp[3];
+          uint k;
+          for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
+            const MEdge *e = orig_medge + (*edge_ptr)->old_edge;
+            sub_v3_v3v3(
+                tmp, orig_mvert_co[vm[e->v1] == i ? e->v2 : e->v1], orig_mvert_co[i]);
+            add_v3_v3(move_nor, tmp);
+          }
+          if (k == 1) {
+            disable_boundary_fix = true;
+          }
+          else {
+            disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
+          }
+        }
+        else {
+          disable_boundary_fix = true;
+        }
+      }
+      /* Fix boundary verts. */
+      if (!disable_boundary_fix) {
+        /* Constraint normal, nor * constr_nor == 0 after this fix. */
+        float constr_nor[3];
+        const MEdge *e0_edge = orig_medge + g->edges[0]->old_edge;
+        const MEdge *e1_edge = orig_medge + g->edges[g->edges_len - 1]->old_edge;
+        float e0[3];
+        float e1[3];
+        sub_v3_v3v3(e0,
+                    orig_mvert_co[vm[e0_edge->v1] == i ? e0_edge->v2 : e0_edge->v1],
+                    orig_mvert_co[i]);
+        sub_v3_v3v3(e1,
+                    orig_mvert_co[vm[e1_edge->v1] == i ? e1_edge->v2 : e1_edge->v1],
+                    orig_mvert_co[i]);
+        if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT) {
+          cross_v3_v3v3(constr_nor, e0, e1);
+        }
+        else {
+          float f0[3];
+          float f1[3];
+          if (g->edges[0]->faces[0]->reversed) {
+            negate_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
+          }
+          else {
+            copy_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
+          }
+          if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
+            negate_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+          }
+          else {
+            copy_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
+          }
+          float n0[3];
+          float n1[3];
+          cross_v3_v3v3(n0, e0, f0);
+          cross_v3_v3v3(n1, f1, e1);
+          normalize_v3(n0);
+          normalize_v3(n1);
+          add_v3_v3v3(constr_nor, n0, n1);
+        }
+        float d = dot_v3v3(constr_nor, move_nor);
+        if (LIKELY(fabsf(d) > FLT_EPSILON)) {
+          mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
+          sub_v3_v3(nor, move_nor);
+        }
+      }
+      float scalar_vgroup = 1;
+      /* Use vertex group. */
+      if (dvert && !do_flat_faces) {
+        const MDeformVert *dv = &dvert[i];
+        if (defgrp_invert) {
+          scalar_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
+        }
+        else {
+          scalar_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
+        }
+        scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
+      }
+      /* Do clamping. */
+      if (do_clamp) {
+        if (do_angle_clamp) {
+          if (g->edges_len > 2) {
+            float min_length = 0;
+            float angle = 0.5f * M_PI;
+            uint k = 0;
+            for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
+              float length = orig_edge_lengths[(*p)->old_edge];
+              float e_ang = (*p)->angle;
+              if (e_ang > angle) {
+                angle = e_ang;
+              }
+              if (length < min_length || k == 0) {
+                min_length = length;
+              }
+            }
+            float cos_ang = cosf(angle * 0.5f);
+            if (cos_ang > 0) {
+              float max_off = min_length * 0.5f / cos_ang;
+              if (max_off < offset * 0.5f) {
+                scalar_vgroup *= max_off / offset * 2;
+              }
+            }
+          }
+        }
+        else {
+          float min_length = 0;
+          uint k = 0;
+          for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
+            float length = orig_edge_lengths[(*p)->old_edge];
+            if (length < min_length || k == 0) {
+              min_length = length;
+            }
+          }
+          if (min_length < offset) {
+            scalar_vgroup *= min_length / offset;
+          }
+        }
+      }
+      mul_v3_fl(nor, scalar_vgroup);
+      add_v3_v3v3(g->co, nor, orig_mvert_co[i]);
+    }
+    else {
+      copy_v3_v3(g->co, orig_mvert_co[i]);
+    }
+  }
+}
+
 /* NOLINTNEXTLINE: readability-function-size */
 Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
                                           const ModifierEvalContext *ctx,
@@ -1406,443 +1897,34 @@ Mesh *MOD_solidify_nonmanifold_modifyMesh(ModifierData *md,
       }
     }
 
-    mv = orig_mvert;
-    gs_ptr = orig_vert_groups_arr;
-    for (uint i = 0; i < numVerts; i++, mv++, gs_ptr++) {
-      if (*gs_ptr) {
-        EdgeGroup *g = *gs_ptr;
-        for (uint j = 0; g->valid; j++, g++) {
-          if (!g->is_singularity) {
-            float *nor = g->no;
-            float move_nor[3] = {0, 0, 0};
-            bool disable_boundary_fix = (smd->nonmanifold_boundary_mode ==
-                                             MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_NONE ||
-                                         (g->is_orig_closed || g->split));
-            /* Constraints Method. */
-            if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_CONSTRAINTS) {
-              NewEdgeRef *first_edge = NULL;
-              NewEdgeRef **edge_ptr = g->edges;
-              /* Contains normal and offset [nx, ny, nz, ofs]. */
-              float(*normals_queue)[4] = MEM_malloc_arrayN(
-                  g->edges_len + 1, sizeof(*normals_queue), "normals_queue in solidify");
-              uint queue_index = 0;
-
-              float face_nors[3][3];
-              float nor_ofs[3];
-
-              const bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == NULL ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
-                      float ofs = face->reversed ? ofs_back_clamped : ofs_front_clamped;
-                      /* Use face_weight here to make faces thinner. */
-                      if (do_flat_faces) {
-                        ofs *= face_weight[face->index];
-                      }
-
-                      if (!null_faces[face->index]) {
-                        /* And normal to the queue. */
-                        mul_v3_v3fl(normals_queue[queue_index],
-                                    poly_nors[face->index],
-                                    face->reversed ? -1 : 1);
-                        normals_queue[queue_index++][3] = ofs;
-                      }
-                      else {
-                        /* Just use this approximate normal of the null face if there is no other
-                         * normal to use. */
-                        mul_v3_v3fl(face_nors[0], poly_nors[face->index], face->reversed ? -1 : 1);
-                        nor_ofs[0] = ofs;
-                      }
-                    }
-                  }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
-                  }
-                }
-              }
-              uint face_nors_len = 0;
-              const float stop_explosion = 0.999f - fabsf(smd->offset_fac) * 0.05f;
-              while (queue_index > 0) {
-                if (face_nors_len == 0) {
-                  if (queue_index <= 2) {
-                    for (uint k = 0; k < queue_index; k++) {
-                      copy_v3_v3(face_nors[k], normals_queue[k]);
-                      nor_ofs[k] = normals_queue[k][3];
-                    }
-                    face_nors_len = queue_index;
-                    queue_index = 0;
-                  }
-                  else {
-                    /* Find most different two normals. */
-                    float min_p = 2;
-                    uint min_n0 = 0;
-                    uint min_n1 = 0;
-                    for (uint k = 0; k < queue_index; k++) {
-                      for (uint m = k + 1; m < queue_index; m++) {
-                        float p = dot_v3v3(normals_queue[k], normals_queue[m]);
-                        if (p <= min_p + FLT_EPSILON) {
-                          min_p = p;
-                          min_n0 = m;
-                          min_n1 = k;
-                        }
-                      }
-                    }
-                    copy_v3_v3(face_nors[0], normals_queue[min_n0]);
-                    copy_v3_v3(face_nors[1], normals_queue[min_n1]);
-                    nor_ofs[0] = normals_queue[min_n0][3];
-                    nor_ofs[1] = normals_queue[min_n1][3];
-                    face_nors_len = 2;
-                    queue_index--;
-                    memmove(normals_queue + min_n0,
-                            normals_queue + min_n0 + 1,
-                            (queue_index - min_n0) * sizeof(*normals_queue));
-                    queue_index--;
-                    memmove(normals_queue + min_n1,
-                            normals_queue + min_n1 + 1,
-                            (queue_index - min_n1) * sizeof(*normals_queue));
-                    min_p = 1;
-                    min_n1 = 0;
-                    float max_p = -1;
-                    for (uint k = 0; k < queue_index; k++) {
-                      max_p = -1;
-                      for (uint m = 0; m < face_nors_len; m++) {
-                        float p = dot_v3v3(face_nors[m], normals_queue[k]);
-                        if (p > max_p + FLT_EPSILON) {
-                          max_p = p;
-                        }
-                      }
-                      if (max_p <= min_p + FLT_EPSILON) {
-                        min_p = max_p;
-                        min_n1 = k;
-                      }
-                    }
-                    if (min_p < 0.8) {
-                      copy_v3_v3(face_nors[2], normals_queue[min_n1]);
-                      nor_ofs[2] = normals_queue[min_n1][3];
-                      face_nors_len++;
-                      queue_index--;
-                      memmove(normals_queue + min_n1,
-                              normals_queue + min_n1 + 1,
-                              (queue_index - min_n1) * sizeof(*normals_queue));
-                    }
-                  }
-                }
-                else {
-                  uint best = 0;
-                  uint best_group = 0;
-                  float best_p = -1.0f;
-                  for (uint k = 0; k < queue_index; k++) {
-                    for (uint m = 0; m < face_nors_len; m++) {
-                      float p = dot_v3v3(face_nors[m], normals_queue[k]);
-                      if (p > best_p + FLT_EPSILON) {
-                        best_p = p;
-                        best = m;
-                        best_group = k;
-                      }
-                    }
-                  }
-                  add_v3_v3(face_nors[best], normals_queue[best_group]);
-                  normalize_v3(face_nors[best]);
-                  nor_ofs[best] = (nor_ofs[best] + normals_queue[best_group][3]) * 0.5f;
-                  queue_index--;
-                  memmove(normals_queue + best_group,
-                          normals_queue + best_group + 1,
-                          (queue_index - best_group) * sizeof(*normals_queue));
-                }
-              }
-              MEM_freeN(normals_queue);
-
-              /* When up to 3 constraint normals are found. */
-              if (ELEM(face_nors_len, 2, 3)) {
-                const float q = dot_v3v3(face_nors[0], face_nors[1]);
-                float d = 1.0f - q * q;
-                cross_v3_v3v3(move_nor, face_nors[0], face_nors[1]);
-                if (d > FLT_EPSILON * 10 && q < stop_explosion) {
-                  d = 1.0f / d;
-                  mul_v3_fl(face_nors[0], (nor_ofs[0] - nor_ofs[1] * q) * d);
-                  mul_v3_fl(face_nors[1], (nor_ofs[1] - nor_ofs[0] * q) * d);
-                }
-                else {
-                  d = 1.0f / (fabsf(q) + 1.0f);
-                  mul_v3_fl(face_nors[0], nor_ofs[0] * d);
-                  mul_v3_fl(face_nors[1], nor_ofs[1] * d);
-                }
-                add_v3_v3v3(nor, face_nors[0], face_nors[1]);
-                if (face_nors_len == 3) {
-                  float *free_nor = move_nor;
-                  mul_v3_fl(face_nors[2], nor_ofs[2]);
-                  d = dot_v3v3(face_nors[2], free_nor);
-                  if (LIKELY(fabsf(d) > FLT_EPSILON)) {
-                    sub_v3_v3v3(face_nors[0], nor, face_nors[2]); /* Override face_nor[0]. */
-                    mul_v3_fl(free_nor, dot_v3v3(face_nors[2], face_nors[0]) / d);
-                    sub_v3_v3(nor, free_nor);
-                  }
-                  disable_boundary_fix = true;
-                }
-              }
-              else {
-                BLI_assert(face_nors_len < 2);
-                mul_v3_v3fl(nor, face_nors[0], nor_ofs[0]);
-                disable_boundary_fix = true;
-              }
-            }
-            /* Fixed/Even Method. */
-            else {
-              float total_angle = 0;
-              float total_angle_back = 0;
-              NewEdgeRef *first_edge = NULL;
-              NewEdgeRef **edge_ptr = g->edges;
-              float face_nor[3];
-              float nor_back[3] = {0, 0, 0};
-              bool has_back = false;
-              bool has_front = false;
-              bool cycle = (g->is_orig_closed && !g->split) || g->is_even_split;
-              for (uint k = 0; k < g->edges_len; k++, edge_ptr++) {
-                if (!(k & 1) || (!cycle && k == g->edges_len - 1)) {
-                  NewEdgeRef *edge = *edge_ptr;
-                  for (uint l = 0; l < 2; l++) {
-                    NewFaceRef *face = edge->faces[l];
-                    if (face && (first_edge == NULL ||
-                                 (first_edge->faces[0] != face && first_edge->faces[1] != face))) {
-                      float angle = 1.0f;
-                      float ofs = face->reversed ? -ofs_back_clamped : ofs_front_clamped;
-                      /* Use face_weight here to make faces thinner. */
-                      if (do_flat_faces) {
-                        ofs *= face_weight[face->index];
-                      }
-
-                      if (smd->nonmanifold_offset_mode ==
-                          MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
-                        MLoop *ml_next = orig_mloop + face->face->loopstart;
-                        ml = ml_next + (face->face->totloop - 1);
-                        MLoop *ml_prev = ml - 1;
-                        for (int m = 0; m < face->face->totloop && vm[ml->v] != i;
-                             m++, ml_next++) {
-                          ml_prev = ml;
-                          ml = ml_next;
-                        }
-                        angle = angle_v3v3v3(orig_mvert_co[vm[ml_prev->v]],
-                                             orig_mvert_co[i],
-                                             orig_mvert_co[vm[ml_next->v]]);
-                        if (face->reversed) {
-                          total_angle_back += angle * ofs * ofs;
-                        }
-                        else {
-                          total_angle += angle * ofs * ofs;
-                        }
-                      }
-                      else {
-                        if (face->reversed) {
-                          total_angle_back++;
-                        }
-                        else {
-                          total_angle++;
-                        }
-                      }
-                      mul_v3_v3fl(face_nor, poly_nors[face->index], angle * ofs);
-                      if (face->reversed) {
-                        add_v3_v3(nor_back, face_nor);
-                        has_back = true;
-                      }
-                      else {
-                        add_v3_v3(nor, face_nor);
-                        has_front = true;
-                      }
-                    }
-                  }
-                  if ((cycle && k == 0) || (!cycle && k + 3 >= g->edges_len)) {
-                    first_edge = edge;
-                  }
-                }
-              }
-
-              /* Set normal length with selected method. */
-              if (smd->nonmanifold_offset_mode == MOD_SOLIDIFY_NONMANIFOLD_OFFSET_MODE_EVEN) {
-                if (has_front) {
-                  float length_sq = len_squared_v3(nor);
-                  if (LIKELY(length_sq > FLT_EPSILON)) {
-                    mul_v3_fl(nor, total_angle / length_sq);
-                  }
-                }
-                if (has_back) {
-                  float length_sq = len_squared_v3(nor_back);
-                  if (LIKELY(length_sq > FLT_EPSILON)) {
-                    mul_v3_fl(nor_back, total_angle_back / length_sq);
-                  }
-                  if (!has_front) {
-                    copy_v3_v3(nor, nor_back);
-                  }
-                }
-                if (has_front && has_back) {
-                  float nor_length = len_v3(nor);
-                  float nor_back_length = len_v3(nor_back);
-                  float q = dot_v3v3(nor, nor_back);
-                  if (LIKELY(fabsf(q) > FLT_EPSILON)) {
-                    q /= nor_length * nor_back_length;
-                  }
-                  float d = 1.0f - q * q;
-                  if (LIKELY(d > FLT_EPSILON)) {
-                    d = 1.0f / d;
-                    if (LIKELY(nor_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor, (1 - nor_back_length * q / nor_length) * d);
-                    }
-                    if (LIKELY(nor_back_length > FLT_EPSILON)) {
-                      mul_v3_fl(nor_back, (1 - nor_length * q / nor_back_length) * d);
-                    }
-                    add_v3_v3(nor, nor_back);
-                  }
-                  else {
-                    mul_v3_fl(nor, 0.5f);
-                    mul_v3_fl(nor_back, 0.5f);
-                    add_v3_v3(nor, nor_back);
-                  }
-                }
-              }
-              else {
-                if (has_front && total_angle > FLT_EPSILON) {
-                  mul_v3_fl(nor, 1.0f / total_angle);
-                }
-                if (has_back && total_angle_back > FLT_EPSILON) {
-                  mul_v3_fl(nor_back, 1.0f / total_angle_back);
-                  add_v3_v3(nor, nor_back);
-                  if (has_front && total_angle > FLT_EPSILON) {
-                    mul_v3_fl(nor, 0.5f);
-                  }
-                }
-              }
-              /* Set move_nor for boundary fix. */
-              if (!disable_boundary_fix && g->edges_len > 2) {
-                edge_ptr = g->edges + 1;
-                float tmp[3];
-                uint k;
-                for (k = 1; k + 1 < g->edges_len; k++, edge_ptr++) {
-                  MEdge *e = orig_medge + (*edge_ptr)->old_edge;
-                  sub_v3_v3v3(
-                      tmp, orig_mvert_co[vm[e->v1] == i ? e->v2 : e->v1], orig_mvert_co[i]);
-                  add_v3_v3(move_nor, tmp);
-                }
-                if (k == 1) {
-                  disable_boundary_fix = true;
-                }
-                else {
-                  disable_boundary_fix = normalize_v3(move_nor) == 0.0f;
-                }
-              }
-              else {
-                disable_boundary_fix = true;
-              }
-            }
-            /* Fix boundary verts. */
-            if (!disable_boundary_fix) {
-              /* Constraint normal, nor * constr_nor == 0 after this fix. */
-              float constr_nor[3];
-              MEdge *e0_edge = orig_medge + g->edges[0]->old_edge;
-              MEdge *e1_edge = orig_medge + g->edges[g->edges_len - 1]->old_edge;
-              float e0[3];
-              float e1[3];
-              sub_v3_v3v3(e0,
-                          orig_mvert_co[vm[e0_edge->v1] == i ? e0_edge->v2 : e0_edge->v1],
-                          orig_mvert_co[i]);
-              sub_v3_v3v3(e1,
-                          orig_mvert_co[vm[e1_edge->v1] == i ? e1_edge->v2 : e1_edge->v1],
-                          orig_mvert_co[i]);
-              if (smd->nonmanifold_boundary_mode == MOD_SOLIDIFY_NONMANIFOLD_BOUNDARY_MODE_FLAT) {
-                cross_v3_v3v3(constr_nor, e0, e1);
-              }
-              else {
-                float f0[3];
-                float f1[3];
-                if (g->edges[0]->faces[0]->reversed) {
-                  negate_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
-                }
-                else {
-                  copy_v3_v3(f0, poly_nors[g->edges[0]->faces[0]->index]);
-                }
-                if (g->edges[g->edges_len - 1]->faces[0]->reversed) {
-                  negate_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
-                }
-                else {
-                  copy_v3_v3(f1, poly_nors[g->edges[g->edges_len - 1]->faces[0]->index]);
-                }
-                float n0[3];
-                float n1[3];
-                cross_v3_v3v3(n0, e0, f0);
-                cross_v3_v3v3(n1, f1, e1);
-                normalize_v3(n0);
-                normalize_v3(n1);
-                add_v3_v3v3(constr_nor, n0, n1);
-              }
-              float d = dot_v3v3(constr_nor, move_nor);
-              if (LIKELY(fabsf(d) > FLT_EPSILON)) {
-                mul_v3_fl(move_nor, dot_v3v3(constr_nor, nor) / d);
-                sub_v3_v3(nor, move_nor);
-              }
-            }
-            float scalar_vgroup = 1;
-            /* Use vertex group. */
-            if (dvert && !do_flat_faces) {
-              MDeformVert *dv = &dvert[i];
-              if (defgrp_invert) {
-                scalar_vgroup = 1.0f - BKE_defvert_find_weight(dv, defgrp_index);
-              }
-              else {
-                scalar_vgroup = BKE_defvert_find_weight(dv, defgrp_index);
-              }
-              scalar_vgroup = offset_fac_vg + (scalar_vgroup * offset_fac_vg_inv);
-            }
-            /* Do clamping. */
-            if (do_clamp) {
-              if (do_angle_clamp) {
-                if (g->edges_len > 2) {
-                  float min_length = 0;
-                  float angle = 0.5f * M_PI;
-                  uint k = 0;
-                  for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
-                    float length = orig_edge_lengths[(*p)->old_edge];
-                    float e_ang = (*p)->angle;
-                    if (e_ang > angle) {
-                      angle = e_ang;
-                    }
-                    if (length < min_length || k == 0) {
-                      min_length = length;
-                    }
-                  }
-                  float cos_ang = cosf(angle * 0.5f);
-                  if (cos_ang > 0) {
-                    float max_off = min_length * 0.5f / cos_ang;
-                    if (max_off < offset * 0.5f) {
-                      scalar_vgroup *= max_off / offset * 2;
-                    }
-                  }
-                }
-              }
-              else {
-                float min_length = 0;
-                uint k = 0;
-                for (NewEdgeRef **p = g->edges; k < g->edges_len; k++, p++) {
-                  float length = orig_edge_lengths[(*p)->old_edge];
-                  if (length < min_length || k == 0) {
-                    min_length = length;
-                  }
-                }
-                if (min_length < offset) {
-                  scalar_vgroup *= min_length / offset;
-                }
-              }
-            }
-            mul_v3_fl(nor, scalar_vgroup);
-            add_v3_v3v3(g->co, nor, orig_mvert_co[i]);
-          }
-          else {
-            copy_v3_v3(g->co, orig_mvert_co[i]);
-          }
-        }
-      }
-    }
+    SolidifyEdgeGroupCoData co_data = {
+        .smd = smd,
+        .orig_vert_groups_arr = orig_vert_groups_arr,
+        .orig_medge = orig_medge,
+        .orig_mloop = orig_mloop,
+        .vm = vm,
+        .orig_mvert_co = (const float(*)[3])orig_mvert_co,
+        .poly_nors = (const float(*)[3])poly_nors,
+        .null_faces = null_faces,
+        .orig_edge_lengths = orig_edge_lengths,
+        .face_weight = face_weight,
+        .dvert = dvert,
+        .defgrp_index = defgrp_index,
+        .defgrp_invert = defgrp_invert,
+        .do_flat_faces = do_flat_faces,
+        .do_clamp = do_clamp,
+        .do_angle_clamp = do_angle_clamp,
+        .ofs_front_clamped = ofs_front_clamped,
+        .ofs_back_clamped = ofs_back_clamped,
+        .offset_fac_vg = offset_fac_vg,
+        .offset_fac_vg_inv = offset_fac_vg_inv,
+        .offset = offset,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(
+        0, (int)numVerts, &co_data, solidify_edge_group_co_task_cb, &settings);
 
     if (do_flat_faces) {
       MEM_freeN(face_weight);
@@ -43,6 +43,7 @@
 #include "BLI_float4x4.hh"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DEG_depsgraph_query.h"
@@ -54,6 +55,8 @@
 
 using blender::float3;
 using blender::float4x4;
+using blender::IndexRange;
+using blender::parallel_for;
 using blender::Span;
 
 static void initData(ModifierData *md)
@@ -227,33 +230,42 @@ static Mesh *new_mesh_from_openvdb_data(Span<openvdb::Vec3s> verts,
 
   Mesh *mesh = BKE_mesh_new_nomain(verts.size(), 0, 0, tot_loops, tot_polys);
 
+  /* The generated meshes of large volumes can have millions of elements, so they are written in
+   * parallel. */
+
   /* Write vertices. */
-  for (const int i : verts.index_range()) {
-    const blender::float3 co = blender::float3(verts[i].asV());
-    copy_v3_v3(mesh->mvert[i].co, co);
-  }
+  parallel_for(verts.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const blender::float3 co = blender::float3(verts[i].asV());
+      copy_v3_v3(mesh->mvert[i].co, co);
+    }
+  });
 
   /* Write triangles. */
-  for (const int i : tris.index_range()) {
-    mesh->mpoly[i].loopstart = 3 * i;
-    mesh->mpoly[i].totloop = 3;
-    for (int j = 0; j < 3; j++) {
-      /* Reverse vertex order to get correct normals. */
-      mesh->mloop[3 * i + j].v = tris[i][2 - j];
+  parallel_for(tris.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      mesh->mpoly[i].loopstart = 3 * i;
+      mesh->mpoly[i].totloop = 3;
+      for (int j = 0; j < 3; j++) {
+        /* Reverse vertex order to get correct normals. */
+        mesh->mloop[3 * i + j].v = tris[i][2 - j];
+      }
     }
-  }
+  });
 
   /* Write quads. */
   const int poly_offset = tris.size();
   const int loop_offset = tris.size() * 3;
-  for (const int i : quads.index_range()) {
-    mesh->mpoly[poly_offset + i].loopstart = loop_offset + 4 * i;
-    mesh->mpoly[poly_offset + i].totloop = 4;
-    for (int j = 0; j < 4; j++) {
-      /* Reverse vertex order to get correct normals. */
-      mesh->mloop[loop_offset + 4 * i + j].v = quads[i][3 - j];
+  parallel_for(quads.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      mesh->mpoly[poly_offset + i].loopstart = loop_offset + 4 * i;
+      mesh->mpoly[poly_offset + i].totloop = 4;
+      for (int j = 0; j < 4; j++) {
+        /* Reverse vertex order to get correct normals. */
+        mesh->mloop[loop_offset + 4 * i + j].v = quads[i][3 - j];
+      }
     }
-  }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_calc_normals(mesh);
@@ -37,6 +37,7 @@
 #include "BKE_deform.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_modifier.h"
 #include "BKE_screen.h"
 
 #include "UI_interface.h"
@@ -474,7 +475,9 @@ static void wn_face_area(WeightedNormalModifierData *wnmd, WeightedNormalData *w
   apply_weights_vertex_normal(wnmd, wn_data);
 }
 
-static void wn_corner_angle(WeightedNormalModifierData *wnmd, WeightedNormalData *wn_data)
+static void wn_corner_angle(WeightedNormalModifierData *wnmd,
+                            const ModifierEvalContext *ctx,
+                            WeightedNormalData *wn_data)
 {
   const int numLoops = wn_data->numLoops;
   const int numPolys = wn_data->numPolys;
@@ -490,10 +493,17 @@ static void wn_corner_angle(WeightedNormalModifierData *wnmd, WeightedNormalData
 
   ModePair *corner_angle = MEM_malloc_arrayN((size_t)numLoops, sizeof(*corner_angle), __func__);
 
+  /* One buffer for the angles of every face, sized for the face with the most corners. */
+  int totloop_max = 0;
+  for (mp_index = 0, mp = mpoly; mp_index < numPolys; mp_index++, mp++) {
+    totloop_max = max_ii(totloop_max, mp->totloop);
+  }
+  float *index_angle = BKE_modifier_temp_alloc(
+      ctx, sizeof(*index_angle) * (size_t)totloop_max, __func__);
+
   for (mp_index = 0, mp = mpoly; mp_index < numPolys; mp_index++, mp++) {
     MLoop *ml_start = &mloop[mp->loopstart];
 
-    float *index_angle = MEM_malloc_arrayN((size_t)mp->totloop, sizeof(*index_angle), __func__);
     BKE_mesh_calc_poly_angles(mp, ml_start, mvert, index_angle);
 
     ModePair *c_angl = &corner_angle[mp->loopstart];
@@ -505,8 +515,8 @@ static void wn_corner_angle(WeightedNormalModifierData *wnmd, WeightedNormalData
 
       loop_to_poly[ml_index] = mp_index;
     }
-    MEM_freeN(index_angle);
   }
+  BKE_modifier_temp_free(ctx, index_angle);
 
   qsort(corner_angle, numLoops, sizeof(*corner_angle), modepair_cmp_by_val_inverse);
 
@@ -515,7 +525,9 @@ static void wn_corner_angle(WeightedNormalModifierData *wnmd, WeightedNormalData
   apply_weights_vertex_normal(wnmd, wn_data);
 }
 
-static void wn_face_with_angle(WeightedNormalModifierData *wnmd, WeightedNormalData *wn_data)
+static void wn_face_with_angle(WeightedNormalModifierData *wnmd,
+                               const ModifierEvalContext *ctx,
+                               WeightedNormalData *wn_data)
 {
   const int numLoops = wn_data->numLoops;
   const int numPolys = wn_data->numPolys;
@@ -531,11 +543,18 @@ static void wn_face_with_angle(WeightedNormalModifierData *wnmd, WeightedNormalD
 
   ModePair *combined = MEM_malloc_arrayN((size_t)numLoops, sizeof(*combined), __func__);
 
+  /* One buffer for the angles of every face, sized for the face with the most corners. */
+  int totloop_max = 0;
+  for (mp_index = 0, mp = mpoly; mp_index < numPolys; mp_index++, mp++) {
+    totloop_max = max_ii(totloop_max, mp->totloop);
+  }
+  float *index_angle = BKE_modifier_temp_alloc(
+      ctx, sizeof(*index_angle) * (size_t)totloop_max, __func__);
+
   for (mp_index = 0, mp = mpoly; mp_index < numPolys; mp_index++, mp++) {
     MLoop *ml_start = &mloop[mp->loopstart];
 
     float face_area = BKE_mesh_calc_poly_area(mp, ml_start, mvert);
-    float *index_angle = MEM_malloc_arrayN((size_t)mp->totloop, sizeof(*index_angle), __func__);
     BKE_mesh_calc_poly_angles(mp, ml_start, mvert, index_angle);
 
     ModePair *cmbnd = &combined[mp->loopstart];
@@ -548,8 +567,8 @@ static void wn_face_with_angle(WeightedNormalModifierData *wnmd, WeightedNormalD
 
       loop_to_poly[ml_index] = mp_index;
     }
-    MEM_freeN(index_angle);
   }
+  BKE_modifier_temp_free(ctx, index_angle);
 
   qsort(combined, numLoops, sizeof(*combined), modepair_cmp_by_val_inverse);
 
@@ -666,10 +685,10 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
       wn_face_area(wnmd, &wn_data);
       break;
     case MOD_WEIGHTEDNORMAL_MODE_ANGLE:
-      wn_corner_angle(wnmd, &wn_data);
+      wn_corner_angle(wnmd, ctx, &wn_data);
       break;
     case MOD_WEIGHTEDNORMAL_MODE_FACE_ANGLE:
-      wn_face_with_angle(wnmd, &wn_data);
+      wn_face_with_angle(wnmd, ctx, &wn_data);
       break;
   }
 
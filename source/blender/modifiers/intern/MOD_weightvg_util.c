@@ -182,52 +182,59 @@ void weightvg_do_mask(const ModifierEvalContext *ctx,
 
     MOD_init_texture(&t_map, ctx);
 
+    /* Sample the texture for all weights at once, this is done in parallel. */
+    TexResult *tex_results = MEM_malloc_arrayN(
+        num, sizeof(*tex_results), "WeightVG Modifier, TEX mode, tex_results");
+    const bool do_color_manage = tex_use_channel != MOD_WVG_MASK_TEX_USE_INT;
+    BKE_texture_get_values(scene,
+                           texture,
+                           (const float(*)[3])tex_co,
+                           indices,
+                           num,
+                           tex_results,
+                           do_color_manage);
+
     /* For each weight (vertex), make the mix between org and new weights. */
     for (i = 0; i < num; i++) {
-      int idx = indices ? indices[i] : i;
-      TexResult texres;
+      const TexResult *texres = &tex_results[i];
       float hsv[3]; /* For HSV color space. */
-      bool do_color_manage;
-
-      do_color_manage = tex_use_channel != MOD_WVG_MASK_TEX_USE_INT;
 
-      texres.nor = NULL;
-      BKE_texture_get_value(scene, texture, tex_co[idx], &texres, do_color_manage);
       /* Get the good channel value... */
       switch (tex_use_channel) {
         case MOD_WVG_MASK_TEX_USE_INT:
-          org_w[i] = (new_w[i] * texres.tin * fact) + (org_w[i] * (1.0f - (texres.tin * fact)));
+          org_w[i] = (new_w[i] * texres->tin * fact) + (org_w[i] * (1.0f - (texres->tin * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_RED:
-          org_w[i] = (new_w[i] * texres.tr * fact) + (org_w[i] * (1.0f - (texres.tr * fact)));
+          org_w[i] = (new_w[i] * texres->tr * fact) + (org_w[i] * (1.0f - (texres->tr * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_GREEN:
-          org_w[i] = (new_w[i] * texres.tg * fact) + (org_w[i] * (1.0f - (texres.tg * fact)));
+          org_w[i] = (new_w[i] * texres->tg * fact) + (org_w[i] * (1.0f - (texres->tg * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_BLUE:
-          org_w[i] = (new_w[i] * texres.tb * fact) + (org_w[i] * (1.0f - (texres.tb * fact)));
+          org_w[i] = (new_w[i] * texres->tb * fact) + (org_w[i] * (1.0f - (texres->tb * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_HUE:
-          rgb_to_hsv_v(&texres.tr, hsv);
+          rgb_to_hsv_v(&texres->tr, hsv);
           org_w[i] = (new_w[i] * hsv[0] * fact) + (org_w[i] * (1.0f - (hsv[0] * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_SAT:
-          rgb_to_hsv_v(&texres.tr, hsv);
+          rgb_to_hsv_v(&texres->tr, hsv);
           org_w[i] = (new_w[i] * hsv[1] * fact) + (org_w[i] * (1.0f - (hsv[1] * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_VAL:
-          rgb_to_hsv_v(&texres.tr, hsv);
+          rgb_to_hsv_v(&texres->tr, hsv);
           org_w[i] = (new_w[i] * hsv[2] * fact) + (org_w[i] * (1.0f - (hsv[2] * fact)));
           break;
         case MOD_WVG_MASK_TEX_USE_ALPHA:
-          org_w[i] = (new_w[i] * texres.ta * fact) + (org_w[i] * (1.0f - (texres.ta * fact)));
+          org_w[i] = (new_w[i] * texres->ta * fact) + (org_w[i] * (1.0f - (texres->ta * fact)));
           break;
         default:
-          org_w[i] = (new_w[i] * texres.tin * fact) + (org_w[i] * (1.0f - (texres.tin * fact)));
+          org_w[i] = (new_w[i] * texres->tin * fact) + (org_w[i] * (1.0f - (texres->tin * fact)));
           break;
       }
     }
 
+    MEM_freeN(tex_results);
     MEM_freeN(tex_co);
   }
   else if ((ref_didx = BKE_object_defgroup_name_index(ob, defgrp_name)) != -1) {
@@ -153,6 +153,9 @@ static void local_merge(Main *bmain, bNodeTree *localtree, bNodeTree *ntree)
 
   for (lnode = localtree->nodes.first; lnode; lnode = lnode->next) {
     if (ntreeNodeExists(ntree, lnode->new_node)) {
+      lnode->new_node->exec_time = lnode->exec_time;
+      lnode->new_node->exec_memory = lnode->exec_memory;
+
       if (ELEM(lnode->type, CMP_NODE_VIEWER, CMP_NODE_SPLITVIEWER)) {
         if (lnode->id && (lnode->flag & NODE_DO_OUTPUT)) {
           /* image_merge does sanity check for pointers */
@@ -308,6 +311,11 @@ void ntreeCompositTagRender(Scene *scene)
    * This is still rather weak though,
    * ideally render struct would store own main AND original G_MAIN. */
 
+#ifdef WITH_COMPOSITOR
+  /* Cached compositor results still refer to the previous render result. */
+  COM_clearCaches();
+#endif
+
   for (Scene *sce_iter = G_MAIN->scenes.first; sce_iter; sce_iter = sce_iter->id.next) {
     if (sce_iter->nodetree) {
       bNode *node;
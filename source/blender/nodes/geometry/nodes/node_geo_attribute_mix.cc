@@ -16,6 +16,8 @@
 
 #include "BKE_material.h"
 
+#include "BLI_task.hh"
+
 #include "DNA_material_types.h"
 
 #include "node_geometry_util.hh"
@@ -49,15 +51,19 @@ static void do_mix_operation_float(const int blend_mode,
                                    const FloatReadAttribute &inputs_b,
                                    FloatWriteAttribute results)
 {
-  const int size = results.size();
-  for (const int i : IndexRange(size)) {
-    const float factor = factors[i];
-    float3 a{inputs_a[i]};
-    const float3 b{inputs_b[i]};
-    ramp_blend(blend_mode, a, factor, b);
-    const float result = a.x;
-    results.set(i, result);
-  }
+  Span<float> span_factors = factors.get_span();
+  Span<float> span_a = inputs_a.get_span();
+  Span<float> span_b = inputs_b.get_span();
+  MutableSpan<float> span_result = results.get_span_for_write_only();
+  parallel_for(span_result.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      float3 a{span_a[i]};
+      const float3 b{span_b[i]};
+      ramp_blend(blend_mode, a, span_factors[i], b);
+      span_result[i] = a.x;
+    }
+  });
+  results.apply_span();
 }
 
 static void do_mix_operation_float3(const int blend_mode,
@@ -66,14 +72,18 @@ static void do_mix_operation_float3(const int blend_mode,
                                     const Float3ReadAttribute &inputs_b,
                                     Float3WriteAttribute results)
 {
-  const int size = results.size();
-  for (const int i : IndexRange(size)) {
-    const float factor = factors[i];
-    float3 a = inputs_a[i];
-    const float3 b = inputs_b[i];
-    ramp_blend(blend_mode, a, factor, b);
-    results.set(i, a);
-  }
+  Span<float> span_factors = factors.get_span();
+  Span<float3> span_a = inputs_a.get_span();
+  Span<float3> span_b = inputs_b.get_span();
+  MutableSpan<float3> span_result = results.get_span_for_write_only();
+  parallel_for(span_result.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      float3 a = span_a[i];
+      ramp_blend(blend_mode, a, span_factors[i], span_b[i]);
+      span_result[i] = a;
+    }
+  });
+  results.apply_span();
 }
 
 static void do_mix_operation_color4f(const int blend_mode,
@@ -82,14 +92,18 @@ static void do_mix_operation_color4f(const int blend_mode,
                                      const Color4fReadAttribute &inputs_b,
                                      Color4fWriteAttribute results)
 {
-  const int size = results.size();
-  for (const int i : IndexRange(size)) {
-    const float factor = factors[i];
-    Color4f a = inputs_a[i];
-    const Color4f b = inputs_b[i];
-    ramp_blend(blend_mode, a, factor, b);
-    results.set(i, a);
-  }
+  Span<float> span_factors = factors.get_span();
+  Span<Color4f> span_a = inputs_a.get_span();
+  Span<Color4f> span_b = inputs_b.get_span();
+  MutableSpan<Color4f> span_result = results.get_span_for_write_only();
+  parallel_for(span_result.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      Color4f a = span_a[i];
+      ramp_blend(blend_mode, a, span_factors[i], span_b[i]);
+      span_result[i] = a;
+    }
+  });
+  results.apply_span();
 }
 
 static void do_mix_operation(const CustomDataType result_type,
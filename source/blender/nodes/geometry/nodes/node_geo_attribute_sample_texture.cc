@@ -15,9 +15,11 @@
  */
 
 #include "BLI_compiler_attrs.h"
+#include "BLI_task.hh"
 
 #include "DNA_texture_types.h"
 
+#include "BKE_image.h"
 #include "BKE_texture.h"
 
 #include "RE_texture.h"
@@ -63,14 +65,24 @@ static void execute_on_component(GeometryComponent &component, const GeoNodeExec
       mapping_name, ATTR_DOMAIN_POINT, {0, 0, 0});
 
   MutableSpan<Color4f> colors = attribute_out->get_span<Color4f>();
-  for (const int i : IndexRange(mapping_attribute.size())) {
-    TexResult texture_result = {0};
-    const float3 position = mapping_attribute[i];
-    /* For legacy reasons we have to map [0, 1] to [-1, 1] to support uv mappings. */
-    const float3 remapped_position = position * 2.0f - float3(1.0f);
-    BKE_texture_get_value(nullptr, texture, remapped_position, &texture_result, false);
-    colors[i] = {texture_result.tr, texture_result.tg, texture_result.tb, texture_result.ta};
-  }
+
+  /* Load the images used by the texture upfront, so that they can be sampled from multiple
+   * threads. */
+  ImagePool *pool = BKE_image_pool_new();
+  BKE_texture_fetch_images_for_pool(texture, pool);
+
+  parallel_for(IndexRange(mapping_attribute.size()), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      TexResult texture_result = {0};
+      const float3 position = mapping_attribute[i];
+      /* For legacy reasons we have to map [0, 1] to [-1, 1] to support uv mappings. */
+      const float3 remapped_position = position * 2.0f - float3(1.0f);
+      BKE_texture_get_value_ex(nullptr, texture, remapped_position, &texture_result, pool, false);
+      colors[i] = {texture_result.tr, texture_result.tg, texture_result.tb, texture_result.ta};
+    }
+  });
+
+  BKE_image_pool_free(pool);
   attribute_out.apply_span_and_save();
 }
 
@@ -14,12 +14,16 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <array>
+
 #include "BLI_float3.hh"
 #include "BLI_hash.h"
 #include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_rand.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_mesh_types.h"
@@ -78,6 +82,19 @@ static Span<MLoopTri> get_mesh_looptris(const Mesh &mesh)
   return {looptris, looptris_len};
 }
 
+static float looptri_density_factor(const Mesh &mesh,
+                                    const MLoopTri &looptri,
+                                    const FloatReadAttribute &density_factors)
+{
+  const int v0_index = mesh.mloop[looptri.tri[0]].v;
+  const int v1_index = mesh.mloop[looptri.tri[1]].v;
+  const int v2_index = mesh.mloop[looptri.tri[2]].v;
+  const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
+  const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
+  const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+  return (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+}
+
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const FloatReadAttribute *density_factors,
@@ -88,42 +105,177 @@ static void sample_mesh_surface(const Mesh &mesh,
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
 
+  /* Every triangle has its own random number generator, so that the points only depend on the
+   * seed and the triangle index. This allows sampling the triangles in parallel in two passes:
+   * first count the points of every triangle, then generate them at their final position. */
+  Array<int> point_offsets(looptris.size() + 1);
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = mesh.mvert[mesh.mloop[looptri.tri[0]].v].co;
+      const float3 v1_pos = mesh.mvert[mesh.mloop[looptri.tri[1]].v].co;
+      const float3 v2_pos = mesh.mvert[mesh.mloop[looptri.tri[2]].v].co;
+
+      const float density_factor = (density_factors == nullptr) ?
+                                       1.0f :
+                                       looptri_density_factor(mesh, looptri, *density_factors);
+      const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+
+      const int looptri_seed = BLI_hash_int(looptri_index + seed);
+      RandomNumberGenerator looptri_rng(looptri_seed);
+
+      const float points_amount_fl = area * base_density * density_factor;
+      const float add_point_probability = fractf(points_amount_fl);
+      const bool add_point = add_point_probability > looptri_rng.get_float();
+      point_offsets[looptri_index] = (int)points_amount_fl + (int)add_point;
+    }
+  });
+
+  int points_len = 0;
   for (const int looptri_index : looptris.index_range()) {
-    const MLoopTri &looptri = looptris[looptri_index];
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
-    const float3 v0_pos = mesh.mvert[v0_index].co;
-    const float3 v1_pos = mesh.mvert[v1_index].co;
-    const float3 v2_pos = mesh.mvert[v2_index].co;
+    const int point_amount = point_offsets[looptri_index];
+    point_offsets[looptri_index] = points_len;
+    points_len += point_amount;
+  }
+  point_offsets.last() = points_len;
+
+  r_positions.resize(points_len);
+  r_bary_coords.resize(points_len);
+  r_looptri_indices.resize(points_len);
+
+  parallel_for(looptris.index_range(), 1024, [&](IndexRange range) {
+    for (const int looptri_index : range) {
+      const int point_offset = point_offsets[looptri_index];
+      const int point_amount = point_offsets[looptri_index + 1] - point_offset;
+      if (point_amount == 0) {
+        continue;
+      }
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = mesh.mvert[mesh.mloop[looptri.tri[0]].v].co;
+      const float3 v1_pos = mesh.mvert[mesh.mloop[looptri.tri[1]].v].co;
+      const float3 v2_pos = mesh.mvert[mesh.mloop[looptri.tri[2]].v].co;
+
+      const int looptri_seed = BLI_hash_int(looptri_index + seed);
+      RandomNumberGenerator looptri_rng(looptri_seed);
+      /* Skip the random value used to round the amount of points in the first pass. */
+      looptri_rng.get_float();
+
+      for (const int i : IndexRange(point_offset, point_amount)) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[i] = bary_coord;
+        r_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
+}
 
-    float looptri_density_factor = 1.0f;
-    if (density_factors != nullptr) {
-      const float v0_density_factor = std::max(0.0f, (*density_factors)[v0_index]);
-      const float v1_density_factor = std::max(0.0f, (*density_factors)[v1_index]);
-      const float v2_density_factor = std::max(0.0f, (*density_factors)[v2_index]);
-      looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+/**
+ * Uniform grid with cells the size of the minimum distance, so that all points closer than the
+ * minimum distance to a point are in the cells around the cell of the point. The indices of the
+ * points are stored per cell in ascending order.
+ */
+class PointGrid {
+ private:
+  float3 min_;
+  float cell_size_;
+  int64_t cells_x_;
+  int64_t cells_y_;
+  int64_t cells_z_;
+  Map<uint64_t, IndexRange> range_by_cell_;
+  Array<int> point_indices_;
+
+ public:
+  /**
+   * Returns false when the amount of cells is too large to give every cell a unique key. This
+   * only happens when the minimum distance is tiny compared to the extent of the points.
+   */
+  bool build(Span<float3> positions, const float cell_size)
+  {
+    cell_size_ = cell_size;
+    min_ = float3(FLT_MAX);
+    float3 max = float3(-FLT_MAX);
+    for (const float3 &position : positions) {
+      minmax_v3v3_v3(min_, max, position);
     }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int looptri_seed = BLI_hash_int(looptri_index + seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const float points_amount_fl = area * base_density * looptri_density_factor;
-    const float add_point_probability = fractf(points_amount_fl);
-    const bool add_point = add_point_probability > looptri_rng.get_float();
-    const int point_amount = (int)points_amount_fl + (int)add_point;
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+    const float3 extent = (max - min_) / cell_size;
+    const float max_cells_per_axis = (float)(1 << 20);
+    if (!(extent.x < max_cells_per_axis && extent.y < max_cells_per_axis &&
+          extent.z < max_cells_per_axis)) {
+      return false;
+    }
+    cells_x_ = (int64_t)extent.x + 1;
+    cells_y_ = (int64_t)extent.y + 1;
+    cells_z_ = (int64_t)extent.z + 1;
+
+    Array<uint64_t> cell_keys(positions.size());
+    parallel_for(positions.index_range(), 4096, [&](IndexRange range) {
+      for (const int i : range) {
+        cell_keys[i] = this->cell_key(this->cell_coord(positions[i]));
+      }
+    });
+
+    /* Count the points in every cell, then fill the cells in the order of the point indices. */
+    for (const uint64_t key : cell_keys) {
+      range_by_cell_.add_or_modify(
+          key,
+          [](IndexRange *range) { new (range) IndexRange(0, 1); },
+          [](IndexRange *range) { *range = IndexRange(0, range->size() + 1); });
     }
+    int offset = 0;
+    for (IndexRange &range : range_by_cell_.values()) {
+      const int size = range.size();
+      range = IndexRange(offset, 0);
+      offset += size;
+    }
+    point_indices_.reinitialize(positions.size());
+    for (const int i : positions.index_range()) {
+      IndexRange &range = range_by_cell_.lookup(cell_keys[i]);
+      point_indices_[range.one_after_last()] = i;
+      range = IndexRange(range.start(), range.size() + 1);
+    }
+    return true;
   }
-}
+
+  /** Call the function for all points in the cells around the given position. */
+  template<typename Func> void foreach_point_in_neighborhood(const float3 &position, Func func)
+  {
+    const std::array<int64_t, 3> coord = this->cell_coord(position);
+    for (int64_t x = std::max<int64_t>(coord[0] - 1, 0);
+         x <= std::min<int64_t>(coord[0] + 1, cells_x_ - 1);
+         x++) {
+      for (int64_t y = std::max<int64_t>(coord[1] - 1, 0);
+           y <= std::min<int64_t>(coord[1] + 1, cells_y_ - 1);
+           y++) {
+        for (int64_t z = std::max<int64_t>(coord[2] - 1, 0);
+             z <= std::min<int64_t>(coord[2] + 1, cells_z_ - 1);
+             z++) {
+          const IndexRange *range = range_by_cell_.lookup_ptr(this->cell_key({x, y, z}));
+          if (range == nullptr) {
+            continue;
+          }
+          for (const int index : point_indices_.as_span().slice(*range)) {
+            func(index);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  std::array<int64_t, 3> cell_coord(const float3 &position) const
+  {
+    const float3 offset = (position - min_) / cell_size_;
+    return {std::min<int64_t>((int64_t)offset.x, cells_x_ - 1),
+            std::min<int64_t>((int64_t)offset.y, cells_y_ - 1),
+            std::min<int64_t>((int64_t)offset.z, cells_z_ - 1)};
+  }
+
+  uint64_t cell_key(const std::array<int64_t, 3> &coord) const
+  {
+    return (uint64_t)((coord[0] * cells_y_ + coord[1]) * cells_z_ + coord[2]);
+  }
+};
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
 {
@@ -135,13 +287,9 @@ BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
   return kdtree;
 }
 
-BLI_NOINLINE static void update_elimination_mask_for_close_points(
+BLI_NOINLINE static void update_elimination_mask_for_close_points_kdtree(
     Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
 {
-  if (minimum_distance <= 0.0f) {
-    return;
-  }
-
   KDTree_3d *kdtree = build_kdtree(positions);
 
   for (const int i : positions.index_range()) {
@@ -170,6 +318,39 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
   BLI_kdtree_3d_free(kdtree);
 }
 
+/**
+ * Keep points in the order of their indices, eliminating all points closer than the minimum
+ * distance to a point that is kept. Since the points of every triangle are generated from their
+ * own seed, the result doesn't depend on how the work was split between threads.
+ */
+BLI_NOINLINE static void update_elimination_mask_for_close_points(
+    Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
+{
+  if (minimum_distance <= 0.0f) {
+    return;
+  }
+
+  PointGrid grid;
+  if (!grid.build(positions, minimum_distance)) {
+    update_elimination_mask_for_close_points_kdtree(positions, minimum_distance, elimination_mask);
+    return;
+  }
+
+  const float minimum_distance_sq = minimum_distance * minimum_distance;
+  for (const int i : positions.index_range()) {
+    if (elimination_mask[i]) {
+      continue;
+    }
+    const float3 position = positions[i];
+    grid.foreach_point_in_neighborhood(position, [&](const int index) {
+      if (index != i && float3::distance_squared(position, positions[index]) <=
+                            minimum_distance_sq) {
+        elimination_mask[index] = true;
+      }
+    });
+  }
+}
+
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const Mesh &mesh,
     const FloatReadAttribute &density_factors,
@@ -178,30 +359,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     MutableSpan<bool> elimination_mask)
 {
   Span<MLoopTri> looptris = get_mesh_looptris(mesh);
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  parallel_for(bary_coords.index_range(), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_index = mesh.mloop[looptri.tri[0]].v;
-    const int v1_index = mesh.mloop[looptri.tri[1]].v;
-    const int v2_index = mesh.mloop[looptri.tri[2]].v;
+      const int v0_index = mesh.mloop[looptri.tri[0]].v;
+      const int v1_index = mesh.mloop[looptri.tri[1]].v;
+      const int v2_index = mesh.mloop[looptri.tri[2]].v;
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_index]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_index]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_index]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = BLI_hash_int_01(bary_coord.hash());
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = BLI_hash_int_01(bary_coord.hash());
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(Span<bool> elimination_mask,
@@ -58,8 +58,13 @@ static void geo_node_point_instance_update(bNodeTree *UNUSED(tree), bNode *node)
       seed_socket, type == GEO_NODE_POINT_INSTANCE_TYPE_COLLECTION && !use_whole_collection);
 }
 
-static void get_instanced_data__object(const GeoNodeExecParams &params,
-                                       MutableSpan<std::optional<InstancedData>> r_instances_data)
+/**
+ * Fill \a r_reference_handles with the reference of the instanced data for every point, or -1 for
+ * points that don't instance anything. The references are only added to \a instances once.
+ */
+static void get_instance_references__object(const GeoNodeExecParams &params,
+                                            InstancesComponent &instances,
+                                            MutableSpan<int> r_reference_handles)
 {
   bke::PersistentObjectHandle object_handle = params.get_input<bke::PersistentObjectHandle>(
       "Object");
@@ -71,14 +76,14 @@ static void get_instanced_data__object(const GeoNodeExecParams &params,
     InstancedData instance;
     instance.type = INSTANCE_DATA_TYPE_OBJECT;
     instance.data.object = object;
-    r_instances_data.fill(instance);
+    r_reference_handles.fill(instances.add_reference(instance));
   }
 }
 
-static void get_instanced_data__collection(
-    const GeoNodeExecParams &params,
-    const GeometryComponent &component,
-    MutableSpan<std::optional<InstancedData>> r_instances_data)
+static void get_instance_references__collection(const GeoNodeExecParams &params,
+                                                const GeometryComponent &component,
+                                                InstancesComponent &instances,
+                                                MutableSpan<int> r_reference_handles)
 {
   const bNode &node = params.node();
   NodeGeometryPointInstance *node_storage = (NodeGeometryPointInstance *)node.storage;
@@ -96,17 +101,17 @@ static void get_instanced_data__collection(
     InstancedData instance;
     instance.type = INSTANCE_DATA_TYPE_COLLECTION;
     instance.data.collection = collection;
-    r_instances_data.fill(instance);
+    r_reference_handles.fill(instances.add_reference(instance));
   }
   else {
-    Vector<InstancedData> possible_instances;
+    Vector<int> possible_handles;
     /* Direct child objects are instanced as objects. */
     LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
       Object *object = cob->ob;
       InstancedData instance;
       instance.type = INSTANCE_DATA_TYPE_OBJECT;
       instance.data.object = object;
-      possible_instances.append(instance);
+      possible_handles.append(instances.add_reference(instance));
     }
     /* Direct child collections are instanced as collections. */
     LISTBASE_FOREACH (CollectionChild *, child, &collection->children) {
@@ -114,41 +119,42 @@ static void get_instanced_data__collection(
       InstancedData instance;
       instance.type = INSTANCE_DATA_TYPE_COLLECTION;
       instance.data.collection = child_collection;
-      possible_instances.append(instance);
+      possible_handles.append(instances.add_reference(instance));
     }
 
-    if (!possible_instances.is_empty()) {
+    if (!possible_handles.is_empty()) {
       const int seed = params.get_input<int>("Seed");
       Array<uint32_t> ids = get_geometry_element_ids_as_uints(component, ATTR_DOMAIN_POINT);
-      for (const int i : r_instances_data.index_range()) {
-        const int index = BLI_hash_int_2d(ids[i], seed) % possible_instances.size();
-        r_instances_data[i] = possible_instances[index];
+      for (const int i : r_reference_handles.index_range()) {
+        const int index = BLI_hash_int_2d(ids[i], seed) % possible_handles.size();
+        r_reference_handles[i] = possible_handles[index];
       }
     }
   }
 }
 
-static Array<std::optional<InstancedData>> get_instanced_data(const GeoNodeExecParams &params,
-                                                              const GeometryComponent &component,
-                                                              const int amount)
+static Array<int> get_instance_references(const GeoNodeExecParams &params,
+                                          const GeometryComponent &component,
+                                          InstancesComponent &instances,
+                                          const int amount)
 {
   const bNode &node = params.node();
   NodeGeometryPointInstance *node_storage = (NodeGeometryPointInstance *)node.storage;
   const GeometryNodePointInstanceType type = (GeometryNodePointInstanceType)
                                                  node_storage->instance_type;
-  Array<std::optional<InstancedData>> instances_data(amount);
+  Array<int> reference_handles(amount, -1);
 
   switch (type) {
     case GEO_NODE_POINT_INSTANCE_TYPE_OBJECT: {
-      get_instanced_data__object(params, instances_data);
+      get_instance_references__object(params, instances, reference_handles);
       break;
     }
     case GEO_NODE_POINT_INSTANCE_TYPE_COLLECTION: {
-      get_instanced_data__collection(params, component, instances_data);
+      get_instance_references__collection(params, component, instances, reference_handles);
       break;
     }
   }
-  return instances_data;
+  return reference_handles;
 }
 
 static void add_instances_from_geometry_component(InstancesComponent &instances,
@@ -158,8 +164,8 @@ static void add_instances_from_geometry_component(InstancesComponent &instances,
   const AttributeDomain domain = ATTR_DOMAIN_POINT;
 
   const int domain_size = src_geometry.attribute_domain_size(domain);
-  Array<std::optional<InstancedData>> instances_data = get_instanced_data(
-      params, src_geometry, domain_size);
+  Array<int> reference_handles = get_instance_references(
+      params, src_geometry, instances, domain_size);
 
   Float3ReadAttribute positions = src_geometry.attribute_get_for_read<float3>(
       "position", domain, {0, 0, 0});
@@ -169,11 +175,12 @@ static void add_instances_from_geometry_component(InstancesComponent &instances,
       "scale", domain, {1, 1, 1});
   Int32ReadAttribute ids = src_geometry.attribute_get_for_read<int>("id", domain, -1);
 
+  instances.reserve(instances.instances_amount() + domain_size);
   for (const int i : IndexRange(domain_size)) {
-    if (instances_data[i].has_value()) {
+    if (reference_handles[i] != -1) {
       float transform[4][4];
       loc_eul_size_to_mat4(transform, positions[i], rotations[i], scales[i]);
-      instances.add_instance(*instances_data[i], transform, ids[i]);
+      instances.add_instance(reference_handles[i], transform, ids[i]);
     }
   }
 }
@@ -44,7 +44,7 @@ static int node_shader_gpu_blackbody(GPUMaterial *mat,
   float layer;
   GPUNodeLink *ramp_texture = GPU_color_band(mat, size, data, &layer);
 
-  return GPU_stack_link(mat, node, "node_blackbody", in, out, ramp_texture, GPU_constant(&layer));
+  return GPU_stack_link(mat, node, "node_blackbody", in, out, ramp_texture, GPU_uniform(&layer));
 }
 
 /* node type definition */
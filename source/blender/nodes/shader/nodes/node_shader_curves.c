@@ -97,7 +97,7 @@ static int gpu_shader_curve_vec(GPUMaterial *mat,
                         in,
                         out,
                         tex,
-                        GPU_constant(&layer),
+                        GPU_uniform(&layer),
                         GPU_uniform(range_xyz),
                         GPU_uniform(ext_xyz[0]),
                         GPU_uniform(ext_xyz[1]),
@@ -211,7 +211,7 @@ static int gpu_shader_curve_rgb(GPUMaterial *mat,
                           in,
                           out,
                           tex,
-                          GPU_constant(&layer),
+                          GPU_uniform(&layer),
                           GPU_uniform(range_rgba),
                           GPU_uniform(ext_rgba[3]));
   }
@@ -222,7 +222,7 @@ static int gpu_shader_curve_rgb(GPUMaterial *mat,
                         in,
                         out,
                         tex,
-                        GPU_constant(&layer),
+                        GPU_uniform(&layer),
                         GPU_uniform(range_rgba),
                         GPU_uniform(ext_rgba[0]),
                         GPU_uniform(ext_rgba[1]),
@@ -119,10 +119,10 @@ static int gpu_shader_valtorgb(GPUMaterial *mat,
   GPUNodeLink *tex = GPU_color_band(mat, size, array, &layer);
 
   if (coba->ipotype == COLBAND_INTERP_CONSTANT) {
-    return GPU_stack_link(mat, node, "valtorgb_nearest", in, out, tex, GPU_constant(&layer));
+    return GPU_stack_link(mat, node, "valtorgb_nearest", in, out, tex, GPU_uniform(&layer));
   }
 
-  return GPU_stack_link(mat, node, "valtorgb", in, out, tex, GPU_constant(&layer));
+  return GPU_stack_link(mat, node, "valtorgb", in, out, tex, GPU_uniform(&layer));
 }
 
 class ColorBandFunction : public blender::fn::MultiFunction {
@@ -123,7 +123,7 @@ static int node_shader_gpu_volume_principled(GPUMaterial *mat,
                         color,
                         temperature,
                         spectrummap,
-                        GPU_constant(&layer));
+                        GPU_uniform(&layer));
 }
 
 /* node type definition */
@@ -149,6 +149,8 @@ typedef struct RenderEngine {
 
   /* Depsgraph */
   struct Depsgraph *depsgraph;
+  /* Session UUID of the scene the depsgraph was built for, pointers may be reused after undo. */
+  unsigned int depsgraph_scene_session_uuid;
   bool has_grease_pencil;
 
   /* callback for render pass query */
@@ -164,6 +166,7 @@ typedef struct RenderEngine {
 
 RenderEngine *RE_engine_create(RenderEngineType *type);
 void RE_engine_free(RenderEngine *engine);
+void RE_engine_free_persistent_depsgraph(RenderEngine *engine);
 
 void RE_layer_load_from_file(
     struct RenderLayer *layer, struct ReportList *reports, const char *filename, int x, int y);
@@ -155,6 +155,13 @@ typedef struct RenderResult {
   char *error;
 
   struct StampData *stamp_data;
+
+  /* Multilayer EXR file of which the passes are only read when they are used, in which case
+   * pass buffers can be NULL, see #RE_pass_ensure_loaded. */
+  void *exrhandle;
+  /* Color space of the file and whether to predivide when converting the passes. */
+  char exr_colorspace[64];
+  bool exr_predivide;
 } RenderResult;
 
 typedef struct RenderStats {
@@ -188,6 +195,8 @@ void RE_FreeAllRender(void);
  * Invoked when loading new file.
  */
 void RE_FreeAllPersistentData(void);
+/* Free the depsgraphs kept with persistent data, invoked on undo. */
+void RE_FreeAllPersistentDepsgraphs(void);
 /* only call on file load */
 void RE_FreeAllRenderResults(void);
 /* for external render engines that can keep persistent data */
@@ -385,6 +394,9 @@ struct RenderView *RE_RenderViewGetByName(struct RenderResult *rr, const char *v
 
 RenderResult *RE_DuplicateRenderResult(RenderResult *rr);
 
+void RE_pass_ensure_loaded(struct RenderResult *rr, struct RenderPass *rpass);
+void RE_render_result_ensure_loaded(struct RenderResult *rr);
+
 #ifdef __cplusplus
 }
 #endif
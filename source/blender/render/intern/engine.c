@@ -148,6 +148,11 @@ void RE_engine_free(RenderEngine *engine)
   }
 #endif
 
+  if (engine->depsgraph) {
+    /* Kept around with persistent data. */
+    DEG_graph_free(engine->depsgraph);
+  }
+
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
   MEM_freeN(engine);
@@ -599,13 +604,56 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+
+/**
+ * With persistent data the depsgraph is kept around between renders of the same view layer, so
+ * the evaluated data-blocks of frames of an animation are only updated where they changed, and
+ * the engine can use the depsgraph updates to sync only those.
+ */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  return (engine->re->r.mode & R_PERSISTENT_DATA) && !(engine->re->r.scemode & R_BUTS_PREVIEW);
+}
+
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  DEG_graph_free(engine->depsgraph);
+
+  engine->depsgraph = NULL;
+}
+
+/**
+ * Free the depsgraph kept with persistent data, for when the data it was built for may have been
+ * freed (undo). The engine itself is kept, the next render builds a new depsgraph.
+ */
+void RE_engine_free_persistent_depsgraph(RenderEngine *engine)
+{
+  if (engine->depsgraph && !(engine->flag & RE_ENGINE_RENDERING)) {
+    engine_depsgraph_free(engine);
+  }
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
-  engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(engine->depsgraph, "RENDER");
+  if (engine->depsgraph) {
+    /* Reuse the depsgraph kept from the previous render if it was built for the same data.
+     * The scene is compared by its session UUID, a new scene may be allocated at the address
+     * of a freed one. The view layer is only compared after the scene is known to be the same. */
+    if (DEG_get_bmain(engine->depsgraph) != bmain ||
+        engine->depsgraph_scene_session_uuid != scene->id.session_uuid ||
+        DEG_get_input_view_layer(engine->depsgraph) != view_layer) {
+      engine_depsgraph_free(engine);
+    }
+  }
+
+  if (engine->depsgraph == NULL) {
+    engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    engine->depsgraph_scene_session_uuid = scene->id.session_uuid;
+    DEG_debug_name_set(engine->depsgraph, "RENDER");
+  }
 
   if (engine->re->r.scemode & R_BUTS_PREVIEW) {
     Depsgraph *depsgraph = engine->depsgraph;
@@ -615,19 +663,13 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
     DEG_ids_clear_recalc(bmain, depsgraph);
   }
   else {
-    BKE_scene_graph_update_for_newframe(engine->depsgraph);
+    /* Keep the recalc flags for the engine to sync only what changed since the last render. */
+    BKE_scene_graph_update_for_newframe_ex(engine->depsgraph, !engine_keep_depsgraph(engine));
   }
 
   engine->has_grease_pencil = DRW_render_check_grease_pencil(engine->depsgraph);
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
-{
-  DEG_graph_free(engine->depsgraph);
-
-  engine->depsgraph = NULL;
-}
-
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
 {
   if (!engine->depsgraph) {
@@ -699,6 +741,10 @@ bool RE_bake_engine(Render *re,
   BLI_rw_mutex_unlock(&re->partsmutex);
 
   if (type->bake) {
+    if (engine->depsgraph) {
+      /* Kept from a previous render with persistent data. */
+      engine_depsgraph_free(engine);
+    }
     engine->depsgraph = depsgraph;
 
     /* update is only called so we create the engine.session */
@@ -771,6 +817,9 @@ static void engine_render_view_layer(Render *re,
       engine->type->update(engine, re->main, engine->depsgraph);
     }
   }
+  if (engine_keep_depsgraph(engine)) {
+    DEG_ids_clear_recalc(re->main, engine->depsgraph);
+  }
 
   if (re->draw_lock) {
     re->draw_lock(re->dlh, 0);
@@ -800,7 +849,9 @@ static void engine_render_view_layer(Render *re,
   }
 
   /* Free dependency graph, if engine has not done it already. */
-  engine_depsgraph_free(engine);
+  if (!engine_keep_depsgraph(engine)) {
+    engine_depsgraph_free(engine);
+  }
 }
 
 bool RE_engine_render(Render *re, bool do_all)
@@ -1023,9 +1074,8 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
    *
    * TODO(sergey): Find better solution for this.
    */
-  if (engine->has_grease_pencil) {
+  if (engine->has_grease_pencil || engine_keep_depsgraph(engine)) {
     return;
   }
-  DEG_graph_free(engine->depsgraph);
-  engine->depsgraph = NULL;
+  engine_depsgraph_free(engine);
 }
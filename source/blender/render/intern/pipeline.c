@@ -49,6 +49,7 @@
 #include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
+#include "BLI_trace.h"
 
 #include "BLT_translation.h"
 
@@ -673,6 +674,16 @@ void RE_FreeAllPersistentData(void)
   }
 }
 
+void RE_FreeAllPersistentDepsgraphs(void)
+{
+  Render *re;
+  for (re = RenderGlobal.renderlist.first; re != NULL; re = re->next) {
+    if (re->engine != NULL) {
+      RE_engine_free_persistent_depsgraph(re->engine);
+    }
+  }
+}
+
 /* on file load, free all re */
 void RE_FreeAllRenderResults(void)
 {
@@ -1547,6 +1558,7 @@ static void do_render_all_options(Render *re)
   BKE_scene_camera_switch_update(re->scene);
 
   re->i.starttime = PIL_check_seconds_timer();
+  BLI_trace_zone_begin("Render Frame");
 
   /* ensure no images are in memory from previous animated sequences */
   BKE_image_all_free_anim_ibufs(re->main, re->r.cfra);
@@ -1570,6 +1582,7 @@ static void do_render_all_options(Render *re)
   }
 
   re->i.lastframetime = PIL_check_seconds_timer() - re->i.starttime;
+  BLI_trace_zone_end();
 
   re->stats_draw(re->sdh, &re->i);
 
@@ -2253,6 +2266,128 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/* Frames of an animation are compressed and written in a thread, while the next frame renders.
+ * EXR frames are written from a copy of the render result, other formats are converted for
+ * writing first and the job owns the resulting image buffer. */
+typedef struct RenderWriteJob {
+  RenderResult *rr;
+  /* Image written instead of the render result, when not NULL. */
+  ImBuf *ibuf;
+  ImageFormatData im_format;
+  char name[FILE_MAX];
+  /* View to write, empty for all views. */
+  char viewname[MAX_NAME];
+  bool ok;
+  int err;
+} RenderWriteJob;
+
+static void *render_write_thread(void *data)
+{
+  RenderWriteJob *job = data;
+
+  errno = 0;
+  if (job->ibuf) {
+    job->ok = BKE_imbuf_write(job->ibuf, job->name, &job->im_format);
+  }
+  else {
+    job->ok = RE_WriteRenderResult(
+        NULL, job->rr, job->name, &job->im_format, job->viewname[0] ? job->viewname : NULL, -1);
+  }
+  job->err = errno;
+
+  return NULL;
+}
+
+static bool render_write_is_exr(const RenderData *rd, RenderResult *rr)
+{
+  return ELEM(rd->im_format.imtype, R_IMF_IMTYPE_OPENEXR, R_IMF_IMTYPE_MULTILAYER) &&
+         RE_HasFloatPixels(rr);
+}
+
+/* Whether the write can be done by #render_write_thread, only for the views formats written to
+ * a single file and without the extra files RE_WriteRenderViewsImage creates. */
+static bool render_write_use_thread(Render *re, const RenderData *rd, RenderResult *rr)
+{
+  const bool is_mono = BLI_listbase_count_at_most(&rr->views, 2) < 2;
+
+  if ((re->flag & R_ANIMATION) == 0) {
+    return false;
+  }
+  if (render_write_is_exr(rd, rr)) {
+    return (rd->im_format.flag & R_IMF_FLAG_PREVIEW_JPG) == 0 &&
+           (is_mono || rd->im_format.views_format == R_IMF_VIEWS_MULTIVIEW);
+  }
+  return is_mono;
+}
+
+static void render_write_begin(Render *re, Scene *scene, RenderResult *rr, const char *name)
+{
+  RenderData *rd = &scene->r;
+  RenderWriteJob *job = MEM_callocN(sizeof(RenderWriteJob), "render write job");
+
+  job->im_format = rd->im_format;
+  BLI_strncpy(job->name, name, sizeof(job->name));
+
+  if (render_write_is_exr(rd, rr)) {
+    job->rr = RE_DuplicateRenderResult(rr);
+    if (rd->im_format.views_format != R_IMF_VIEWS_MULTIVIEW) {
+      RenderView *rv = rr->views.first;
+      STRNCPY(job->viewname, rv->name);
+    }
+  }
+  else {
+    /* Same conversion as RE_WriteRenderViewsImage, the color management and stamp metadata stay
+     * on this thread since they read the scene. */
+    ImBuf *ibuf = render_result_rect_to_ibuf(rr, rd, 0);
+    IMB_colormanagement_imbuf_for_write(
+        ibuf, true, false, &scene->view_settings, &scene->display_settings, &rd->im_format);
+
+    /* The buffers may still belong to the render result, which the next frame renders into. */
+    job->ibuf = IMB_dupImBuf(ibuf);
+    IMB_freeImBuf(ibuf);
+
+    if (rd->stamp & R_STAMP_ALL) {
+      BKE_imbuf_stamp_info(rr, job->ibuf);
+    }
+  }
+
+  re->write_job = job;
+  BLI_threadpool_init(&re->write_threads, render_write_thread, 1);
+  BLI_threadpool_insert(&re->write_threads, job);
+}
+
+/**
+ * Finish the write started by #render_write_begin, running the write callbacks that were held
+ * back until the file exists. Returns false when writing failed.
+ */
+static bool render_write_wait(Render *re, Scene *scene)
+{
+  RenderWriteJob *job = re->write_job;
+
+  if (job == NULL) {
+    return true;
+  }
+
+  BLI_threadpool_end(&re->write_threads);
+  re->write_job = NULL;
+
+  const bool ok = job->ok;
+  render_print_save_message(re->reports, job->name, ok, job->err);
+  if (job->rr) {
+    RE_FreeRenderResult(job->rr);
+  }
+  if (job->ibuf) {
+    IMB_freeImBuf(job->ibuf);
+  }
+  MEM_freeN(job);
+
+  if (ok) {
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+  }
+
+  return ok;
+}
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
@@ -2265,6 +2400,11 @@ static int do_write_image_or_movie(Render *re,
   double render_time;
   bool ok = true;
 
+  /* Only one frame is written in the background at a time. */
+  if (!render_write_wait(re, scene)) {
+    return false;
+  }
+
   RE_AcquireResultImageViews(re, &rres);
 
   /* write movie or image */
@@ -2287,8 +2427,13 @@ static int do_write_image_or_movie(Render *re,
                                    NULL);
     }
 
-    /* write images as individual images or stereo */
-    ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    if (render_write_use_thread(re, &scene->r, &rres)) {
+      render_write_begin(re, scene, &rres, name);
+    }
+    else {
+      /* write images as individual images or stereo */
+      ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    }
   }
 
   RE_ReleaseResultImageViews(re, &rres);
@@ -2591,11 +2736,18 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        /* For frames written in the background, this runs once writing is done. */
+        if (re->write_job == NULL) {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (!render_write_wait(re, scene)) {
+    G.is_break = true;
+  }
+
   /* end movie */
   if (is_movie) {
     re_movie_free_all(re, mh, totvideos);
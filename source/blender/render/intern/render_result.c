@@ -123,6 +123,10 @@ void render_result_free(RenderResult *rr)
 
   BKE_stamp_data_free(rr->stamp_data);
 
+  if (rr->exrhandle) {
+    IMB_exr_close(rr->exrhandle);
+  }
+
   MEM_freeN(rr);
 }
 
@@ -250,8 +254,10 @@ RenderPass *render_layer_add_pass(RenderResult *rr,
   }
 
   /* Always allocate combined for display, in case of save buffers
-   * other passes are not allocated and only saved to the EXR file. */
-  if (rl->exrhandle == NULL || STREQ(rpass->name, RE_PASSNAME_COMBINED)) {
+   * other passes are not allocated and only saved to the EXR file.
+   * Background renders display nothing, so only the tiles that are being
+   * rendered are kept in memory. */
+  if (rl->exrhandle == NULL || (STREQ(rpass->name, RE_PASSNAME_COMBINED) && !G.background)) {
     float *rect;
     int x;
 
@@ -759,7 +765,7 @@ RenderResult *render_result_new_from_exr(
       rpass->rectx = rectx;
       rpass->recty = recty;
 
-      if (rpass->channels >= 3) {
+      if (rpass->channels >= 3 && rpass->rect) {
         IMB_colormanagement_transform(rpass->rect,
                                       rpass->rectx,
                                       rpass->recty,
@@ -771,9 +777,70 @@ RenderResult *render_result_new_from_exr(
     }
   }
 
+  if (IMB_exr_is_deferred(exrhandle)) {
+    /* Passes are read when needed, the render result takes over the handle. */
+    rr->exrhandle = exrhandle;
+    STRNCPY(rr->exr_colorspace, colorspace);
+    rr->exr_predivide = predivide;
+  }
+
   return rr;
 }
 
+static void render_result_pass_load(RenderResult *rr, RenderLayer *rl, RenderPass *rpass)
+{
+  rpass->rect = IMB_exr_read_pass(rr->exrhandle, rl->name, rpass->name, rpass->view);
+
+  if (rpass->rect == NULL) {
+    rpass->rect = MEM_callocN(sizeof(float) * rpass->rectx * rpass->recty * rpass->channels,
+                              "pass rect");
+  }
+  else if (rpass->channels >= 3) {
+    IMB_colormanagement_transform(
+        rpass->rect,
+        rpass->rectx,
+        rpass->recty,
+        rpass->channels,
+        rr->exr_colorspace,
+        IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_SCENE_LINEAR),
+        rr->exr_predivide);
+  }
+}
+
+/**
+ * Read the buffer of a pass of a render result created from a multilayer file, when it was
+ * not read yet. Callers are responsible for not reading the same result from several threads.
+ */
+void RE_pass_ensure_loaded(RenderResult *rr, RenderPass *rpass)
+{
+  if (rr->exrhandle == NULL || rpass->rect != NULL) {
+    return;
+  }
+
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    if (BLI_findindex(&rl->passes, rpass) != -1) {
+      render_result_pass_load(rr, rl, rpass);
+      return;
+    }
+  }
+}
+
+/* Read all passes which have not been read yet, for code which accesses all passes. */
+void RE_render_result_ensure_loaded(RenderResult *rr)
+{
+  if (rr->exrhandle == NULL) {
+    return;
+  }
+
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      if (rpass->rect == NULL) {
+        render_result_pass_load(rr, rl, rpass);
+      }
+    }
+  }
+}
+
 void render_result_view_new(RenderResult *rr, const char *viewname)
 {
   RenderView *rv = MEM_callocN(sizeof(RenderView), "new render view");
@@ -1010,6 +1077,8 @@ bool RE_WriteRenderResult(ReportList *reports,
   BLI_make_existing_file(filename);
 
   int compress = (imf ? imf->exr_codec : 0);
+  /* OpenEXR's thread pool is created before the thread count arguments are known. */
+  IMB_exr_set_write_threads(exrhandle, BLI_system_thread_count());
   bool success = IMB_exr_begin_write(
       exrhandle, filename, rr->rectx, rr->recty, compress, rr->stamp_data);
   if (success) {
@@ -1648,8 +1717,11 @@ static RenderView *duplicate_render_view(RenderView *rview)
 
 RenderResult *RE_DuplicateRenderResult(RenderResult *rr)
 {
+  RE_render_result_ensure_loaded(rr);
+
   RenderResult *new_rr = MEM_mallocN(sizeof(RenderResult), "new duplicated render result");
   *new_rr = *rr;
+  new_rr->exrhandle = NULL;
   new_rr->next = new_rr->prev = NULL;
   new_rr->layers.first = new_rr->layers.last = NULL;
   new_rr->views.first = new_rr->views.last = NULL;
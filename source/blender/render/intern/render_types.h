@@ -153,6 +153,10 @@ struct Render {
   void **movie_ctx_arr;
   char viewname[MAX_NAME];
 
+  /* Background write of the previous frame of an animation, see #render_write_wait. */
+  ListBase write_threads;
+  struct RenderWriteJob *write_job;
+
   /* TODO replace by a whole draw manager. */
   void *gl_context;
   void *gpu_context;
@@ -32,9 +32,14 @@ struct Main;
 struct Scene;
 struct Sequence;
 
+/* Maximum number of threads rendering frames ahead of the playhead. */
+#define SEQ_PREFETCH_WORKERS_MAX 8
+
 typedef enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /* Prefetch workers use consecutive IDs starting with this one. */
   SEQ_TASK_PREFETCH_RENDER,
+  SEQ_TASK_MAX = SEQ_TASK_PREFETCH_RENDER + SEQ_PREFETCH_WORKERS_MAX,
 } eSeqTaskId;
 
 typedef struct SeqRenderData {
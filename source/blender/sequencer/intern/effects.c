@@ -230,19 +230,21 @@ static void do_alphaover_effect_byte(float facf0,
     while (x--) {
       /* rt = rt1 over rt2  (alpha from rt1) */
 
-      straight_uchar_to_premul_float(rt1, cp1);
-      straight_uchar_to_premul_float(rt2, cp2);
-
       fac = fac2;
-      mfac = 1.0f - fac2 * rt1[3];
 
-      if (fac <= 0.0f) {
+      /* Transparent and opaque foreground pixels are common with overlays, copy them without
+       * converting to float. */
+      if (fac <= 0.0f || cp1[3] == 0) {
         *((unsigned int *)rt) = *((unsigned int *)cp2);
       }
-      else if (mfac <= 0.0f) {
+      else if (fac >= 1.0f && cp1[3] == 255) {
         *((unsigned int *)rt) = *((unsigned int *)cp1);
       }
       else {
+        straight_uchar_to_premul_float(rt1, cp1);
+        straight_uchar_to_premul_float(rt2, cp2);
+        mfac = 1.0f - fac2 * rt1[3];
+
         tempc[0] = fac * rt1[0] + mfac * rt2[0];
         tempc[1] = fac * rt1[1] + mfac * rt2[1];
         tempc[2] = fac * rt1[2] + mfac * rt2[2];
@@ -262,19 +264,19 @@ static void do_alphaover_effect_byte(float facf0,
 
     x = xo;
     while (x--) {
-      straight_uchar_to_premul_float(rt1, cp1);
-      straight_uchar_to_premul_float(rt2, cp2);
-
       fac = fac4;
-      mfac = 1.0f - (fac4 * rt1[3]);
 
-      if (fac <= 0.0f) {
+      if (fac <= 0.0f || cp1[3] == 0) {
         *((unsigned int *)rt) = *((unsigned int *)cp2);
       }
-      else if (mfac <= 0.0f) {
+      else if (fac >= 1.0f && cp1[3] == 255) {
         *((unsigned int *)rt) = *((unsigned int *)cp1);
       }
       else {
+        straight_uchar_to_premul_float(rt1, cp1);
+        straight_uchar_to_premul_float(rt2, cp2);
+        mfac = 1.0f - (fac4 * rt1[3]);
+
         tempc[0] = fac * rt1[0] + mfac * rt2[0];
         tempc[1] = fac * rt1[1] + mfac * rt2[1];
         tempc[2] = fac * rt1[2] + mfac * rt2[2];
@@ -3897,6 +3899,8 @@ static int early_out_text(Sequence *seq, float UNUSED(facf0), float UNUSED(facf1
   return EARLY_NO_INPUT;
 }
 
+static ThreadMutex text_effect_lock = BLI_MUTEX_INITIALIZER;
+
 static ImBuf *do_text_effect(const SeqRenderData *context,
                              Sequence *seq,
                              float UNUSED(timeline_frame),
@@ -3917,6 +3921,9 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
   int y_ofs, x, y;
   double proxy_size_comp;
 
+  /* Font settings are shared by all threads rendering text. */
+  BLI_mutex_lock(&text_effect_lock);
+
   if (data->text_blf_id == SEQ_FONT_NOT_LOADED) {
     data->text_blf_id = -1;
 
@@ -4030,6 +4037,8 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
 
   BLF_disable(font, BLF_WORD_WRAP);
 
+  BLI_mutex_unlock(&text_effect_lock);
+
   return out;
 }
 
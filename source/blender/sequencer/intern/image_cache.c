@@ -20,10 +20,17 @@
  * \ingroup bke
  */
 
+#include <fcntl.h>
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
 
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -41,7 +48,9 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_global.h"
@@ -57,6 +66,15 @@
 #include "prefetch.h"
 #include "strip_time.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+#endif
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -90,6 +108,9 @@
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
  * Zlib compression with user definable level can be used to compress image data(per image)
+ * The fast setting uses LZO instead, the image is split in blocks of DCACHE_LZO_BLOCK_SIZE
+ * which are compressed and decompressed in parallel. Such images are read by memory-mapping
+ * the file.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -102,11 +123,20 @@
 /* <cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 1
+#define DCACHE_CURRENT_VERSION 2
+#define DCACHE_LZO_BLOCK_SIZE (1 << 20)
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
+/* #DiskCacheHeaderEntry.compression */
+enum {
+  DCACHE_COMPRESSION_ZLIB = 0,
+  /* Number of blocks and size of each block (uint32_t) followed by the LZO compressed blocks. */
+  DCACHE_COMPRESSION_LZO = 1,
+};
+
 typedef struct DiskCacheHeaderEntry {
   unsigned char encoding;
+  unsigned char compression;
   uint64_t frameno;
   uint64_t size_compressed;
   uint64_t size_raw;
@@ -146,7 +176,8 @@ typedef struct SeqCache {
   ThreadMutex iterator_mutex;
   struct BLI_mempool *keys_pool;
   struct BLI_mempool *items_pool;
-  struct SeqCacheKey *last_key;
+  /* Last stored key of each task, for linking intermediate items to the final frame. */
+  struct SeqCacheKey *last_key[SEQ_TASK_MAX];
   SeqDiskCache *disk_cache;
 } SeqCache;
 
@@ -187,6 +218,7 @@ static int seq_disk_cache_compression_level(void)
   switch (U.sequencer_disk_cache_compression) {
     case USER_SEQ_DISK_CACHE_COMPRESSION_NONE:
       return 0;
+    case USER_SEQ_DISK_CACHE_COMPRESSION_FAST: /* Only used when built without LZO. */
     case USER_SEQ_DISK_CACHE_COMPRESSION_LOW:
       return 1;
     case USER_SEQ_DISK_CACHE_COMPRESSION_HIGH:
@@ -196,6 +228,16 @@ static int seq_disk_cache_compression_level(void)
   return U.sequencer_disk_cache_compression;
 }
 
+static int seq_disk_cache_compression(void)
+{
+#ifdef WITH_LZO
+  if (U.sequencer_disk_cache_compression == USER_SEQ_DISK_CACHE_COMPRESSION_FAST) {
+    return DCACHE_COMPRESSION_LZO;
+  }
+#endif
+  return DCACHE_COMPRESSION_ZLIB;
+}
+
 static size_t seq_disk_cache_size_limit(void)
 {
   return (size_t)U.sequencer_disk_cache_size_limit * (1024 * 1024 * 1024);
@@ -488,29 +530,211 @@ static void seq_disk_cache_invalidate(Scene *scene,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
+#ifdef WITH_LZO
+typedef struct DiskCacheLZOData {
+  unsigned char *raw;
+  size_t size_raw;
+  /* When compressing, each block has LZO_OUT_LEN(DCACHE_LZO_BLOCK_SIZE) bytes. */
+  unsigned char *compressed;
+  uint64_t *block_offsets;
+  uint32_t *block_sizes;
+  bool failed;
+} DiskCacheLZOData;
+
+static size_t lzo_block_raw_size(const DiskCacheLZOData *data, const int block)
+{
+  return min_zz(DCACHE_LZO_BLOCK_SIZE, data->size_raw - (size_t)block * DCACHE_LZO_BLOCK_SIZE);
+}
+
+static void lzo_compress_block_task(void *__restrict userdata,
+                                    const int block,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DiskCacheLZOData *data = userdata;
+  const size_t out_stride = LZO_OUT_LEN(DCACHE_LZO_BLOCK_SIZE);
+  lzo_uint out_len = out_stride;
+  void *wrkmem = MEM_mallocN(LZO1X_MEM_COMPRESS, __func__);
+
+  const int r = lzo1x_1_compress(data->raw + (size_t)block * DCACHE_LZO_BLOCK_SIZE,
+                                 lzo_block_raw_size(data, block),
+                                 data->compressed + (size_t)block * out_stride,
+                                 &out_len,
+                                 wrkmem);
+  if (r == LZO_E_OK) {
+    data->block_sizes[block] = out_len;
+  }
+  else {
+    data->failed = true;
+  }
+
+  MEM_freeN(wrkmem);
+}
+
+static void lzo_decompress_block_task(void *__restrict userdata,
+                                      const int block,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DiskCacheLZOData *data = userdata;
+  lzo_uint out_len = lzo_block_raw_size(data, block);
+
+  const int r = lzo1x_decompress_safe(data->compressed + data->block_offsets[block],
+                                      data->block_sizes[block],
+                                      data->raw + (size_t)block * DCACHE_LZO_BLOCK_SIZE,
+                                      &out_len,
+                                      NULL);
+  if (r != LZO_E_OK || out_len != lzo_block_raw_size(data, block)) {
+    data->failed = true;
+  }
+}
+
+static int lzo_num_blocks(const size_t size_raw)
+{
+  return (int)((size_raw + DCACHE_LZO_BLOCK_SIZE - 1) / DCACHE_LZO_BLOCK_SIZE);
+}
+
+static size_t lzo_mem_to_file_at_pos(void *buf, size_t len, FILE *file, size_t offset)
+{
+  const uint32_t num_blocks = lzo_num_blocks(len);
+  DiskCacheLZOData data = {
+      .raw = buf,
+      .size_raw = len,
+      .compressed = MEM_mallocN(num_blocks * LZO_OUT_LEN(DCACHE_LZO_BLOCK_SIZE), __func__),
+      .block_sizes = MEM_mallocN(sizeof(uint32_t) * num_blocks, __func__),
+      .failed = false,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, num_blocks, &data, lzo_compress_block_task, &settings);
+
+  size_t bytes_written = 0;
+  if (!data.failed) {
+    fseek(file, offset, 0);
+    bool ok = fwrite(&num_blocks, sizeof(num_blocks), 1, file) == 1 &&
+              fwrite(data.block_sizes, sizeof(uint32_t), num_blocks, file) == num_blocks;
+    bytes_written = sizeof(uint32_t) * (1 + num_blocks);
+
+    for (int block = 0; ok && block < num_blocks; block++) {
+      const unsigned char *compressed = data.compressed +
+                                        (size_t)block * LZO_OUT_LEN(DCACHE_LZO_BLOCK_SIZE);
+      ok = fwrite(compressed, 1, data.block_sizes[block], file) == data.block_sizes[block];
+      bytes_written += data.block_sizes[block];
+    }
+
+    if (!ok || ferror(file)) {
+      bytes_written = 0;
+    }
+  }
+
+  MEM_freeN(data.compressed);
+  MEM_freeN(data.block_sizes);
+  return bytes_written;
+}
+
+static size_t lzo_file_to_mem_at_pos(void *buf,
+                                     size_t len,
+                                     const char *path,
+                                     const DiskCacheHeaderEntry *header_entry)
+{
+  const int fd = BLI_open(path, O_BINARY | O_RDONLY, 0);
+  if (fd == -1) {
+    return 0;
+  }
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fd);
+  if (mmap_file == NULL) {
+    close(fd);
+    return 0;
+  }
+
+  const bool switch_endian = (ENDIAN_ORDER == B_ENDIAN) && header_entry->encoding == 0;
+  const uint32_t num_blocks = lzo_num_blocks(len);
+  uint32_t num_blocks_file = 0;
+  DiskCacheLZOData data = {
+      .raw = buf,
+      .size_raw = len,
+      .block_offsets = MEM_mallocN(sizeof(uint64_t) * num_blocks, __func__),
+      .block_sizes = MEM_mallocN(sizeof(uint32_t) * num_blocks, __func__),
+      .failed = true,
+  };
+
+  if (BLI_mmap_read(mmap_file, &num_blocks_file, header_entry->offset, sizeof(uint32_t))) {
+    if (switch_endian) {
+      BLI_endian_switch_uint32(&num_blocks_file);
+    }
+  }
+
+  if (num_blocks_file == num_blocks &&
+      BLI_mmap_read(mmap_file,
+                    data.block_sizes,
+                    header_entry->offset + sizeof(uint32_t),
+                    sizeof(uint32_t) * num_blocks)) {
+    if (switch_endian) {
+      BLI_endian_switch_uint32_array(data.block_sizes, num_blocks);
+    }
+
+    uint64_t offset = header_entry->offset + sizeof(uint32_t) * (1 + num_blocks);
+    for (int block = 0; block < num_blocks; block++) {
+      data.block_offsets[block] = offset;
+      offset += data.block_sizes[block];
+    }
+
+    /* Make sure all blocks are inside of the mapped file before reading them directly. */
+    char last_byte;
+    if (offset > header_entry->offset &&
+        BLI_mmap_read(mmap_file, &last_byte, offset - 1, sizeof(last_byte))) {
+      data.compressed = BLI_mmap_get_pointer(mmap_file);
+      data.failed = false;
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(0, num_blocks, &data, lzo_decompress_block_task, &settings);
+    }
+  }
+
+  const bool failed = data.failed || BLI_mmap_any_io_error(mmap_file);
+  MEM_freeN(data.block_offsets);
+  MEM_freeN(data.block_sizes);
+  BLI_mmap_free(mmap_file);
+  close(fd);
+
+  return failed ? 0 : len;
+}
+#endif
+
 static size_t deflate_imbuf_to_file(ImBuf *ibuf,
                                     FILE *file,
                                     int level,
                                     DiskCacheHeaderEntry *header_entry)
 {
-  if (ibuf->rect) {
-    return BLI_gzip_mem_to_file_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset, level);
+  void *buf = ibuf->rect ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+
+#ifdef WITH_LZO
+  if (header_entry->compression == DCACHE_COMPRESSION_LZO) {
+    return lzo_mem_to_file_at_pos(buf, header_entry->size_raw, file, header_entry->offset);
   }
+#endif
 
   return BLI_gzip_mem_to_file_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset, level);
+      buf, header_entry->size_raw, file, header_entry->offset, level);
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+static size_t inflate_file_to_imbuf(ImBuf *ibuf,
+                                    FILE *file,
+                                    const char *path,
+                                    DiskCacheHeaderEntry *header_entry)
 {
-  if (ibuf->rect) {
-    return BLI_ungzip_file_to_mem_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset);
+  void *buf = ibuf->rect ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+
+  if (header_entry->compression == DCACHE_COMPRESSION_LZO) {
+#ifdef WITH_LZO
+    return lzo_file_to_mem_at_pos(buf, header_entry->size_raw, path, header_entry);
+#else
+    UNUSED_VARS(path);
+    return 0;
+#endif
   }
 
-  return BLI_ungzip_file_to_mem_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset);
+  return BLI_ungzip_file_to_mem_at_pos(buf, header_entry->size_raw, file, header_entry->offset);
 }
 
 static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -573,6 +797,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
     header->entry[i].encoding = 0;
   }
 
+  header->entry[i].compression = seq_disk_cache_compression();
   header->entry[i].offset = offset;
   header->entry[i].frameno = key->frame_index;
 
@@ -694,7 +919,7 @@ static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *ke
     return NULL;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, path, &header.entry[entry_index]);
 
   /* Sanity check. */
   if (bytes_read != expected_size) {
@@ -713,6 +938,7 @@ static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *ke
 #undef DCACHE_IMAGES_PER_FILE
 #undef COLORSPACE_NAME_MAX
 #undef DCACHE_CURRENT_VERSION
+#undef DCACHE_LZO_BLOCK_SIZE
 
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
 {
@@ -850,33 +1076,35 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
+  SeqCacheKey **last_key = &cache->last_key[key->task_id];
+
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = *last_key;
   }
 
   /* Store pointer to last cached key. */
-  SeqCacheKey *temp_last_key = cache->last_key;
+  SeqCacheKey *temp_last_key = *last_key;
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
     IMB_refImBuf(ibuf);
 
     if (!key->is_temp_cache) {
-      cache->last_key = key;
+      *last_key = key;
     }
   }
 
   /* Set last_key's reference to this key so we can look up chain backwards.
-   * Item is already put in cache, so cache->last_key points to current key.
+   * Item is already put in cache, so last_key points to current key.
    */
   if (!key->is_temp_cache && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = *last_key;
   }
 
   /* Reset linking. */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = NULL;
+    *last_key = NULL;
   }
 }
 
@@ -1126,7 +1354,6 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = NULL;
     cache->bmain = bmain;
     BLI_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
@@ -1244,7 +1471,7 @@ void SEQ_cache_cleanup(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
     BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
   }
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
 }
 
@@ -1308,7 +1535,7 @@ void seq_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
 }
 
@@ -1398,8 +1625,8 @@ bool seq_cache_put_if_possible(
     return true;
   }
 
-  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-  scene->ed->cache->last_key = NULL;
+  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key[context->task_id]);
+  scene->ed->cache->last_key[context->task_id] = NULL;
   return false;
 }
 
@@ -1432,6 +1659,15 @@ void seq_cache_put(
 
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
+
+  /* Another prefetch worker may have stored the same item since the check above. */
+  SeqCacheKey test_key;
+  seq_cache_populate_key(&test_key, context, seq, timeline_frame, type);
+  if (BLI_ghash_haskey(cache->hash, &test_key)) {
+    seq_cache_unlock(scene);
+    return;
+  }
+
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
@@ -1474,7 +1710,7 @@ void SEQ_cache_iterate(
     interrupt = callback_iter(userdata, key->seq, key->timeline_frame, key->type);
   }
 
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
 }
 
@@ -32,6 +32,7 @@
 #include "DNA_mask_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
@@ -273,6 +274,14 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
   Editing *ed = scene->ed;
   const bool is_multiview = (seq->flag & SEQ_USE_VIEWS) != 0 &&
                             (scene->r.scemode & R_MULTIVIEW) != 0;
+  int ib_flags = IB_rect;
+
+  if (seq->flag & SEQ_FILTERY) {
+    ib_flags |= IB_animdeinterlace;
+  }
+  if (U.video_flag & USER_VIDEO_HARDWARE_DECODE) {
+    ib_flags |= IB_animhwdecode;
+  }
 
   if ((seq->anims.first != NULL) && (((StripAnim *)seq->anims.first)->anim != NULL)) {
     return;
@@ -324,14 +333,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
         if (openfile) {
           sanim->anim = openanim(str,
-                                 IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                 ib_flags,
                                  seq->streamindex,
                                  seq->strip->colorspace_settings.name);
         }
         else {
           sanim->anim = openanim_noload(str,
-                                        IB_rect |
-                                            ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                        ib_flags,
                                         seq->streamindex,
                                         seq->strip->colorspace_settings.name);
         }
@@ -343,14 +351,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
         else {
           if (openfile) {
             sanim->anim = openanim(name,
-                                   IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                   ib_flags,
                                    seq->streamindex,
                                    seq->strip->colorspace_settings.name);
           }
           else {
             sanim->anim = openanim_noload(name,
-                                          IB_rect |
-                                              ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                          ib_flags,
                                           seq->streamindex,
                                           seq->strip->colorspace_settings.name);
           }
@@ -375,13 +382,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
     if (openfile) {
       sanim->anim = openanim(name,
-                             IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                             ib_flags,
                              seq->streamindex,
                              seq->strip->colorspace_settings.name);
     }
     else {
       sanim->anim = openanim_noload(name,
-                                    IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                    ib_flags,
                                     seq->streamindex,
                                     seq->strip->colorspace_settings.name);
     }
@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -644,6 +645,120 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Blocks of a big matrix touching each vertex, stored in increasing block order so
+ * #mul_bfmatrix_lfvector_indexed adds them up in the same order as #mul_bfmatrix_lfvector. */
+typedef struct fmatrixIndex {
+  unsigned int vcount;
+  /* Blocks with the vertex as row, the diagonal block first. */
+  unsigned int *row_offsets;
+  unsigned int *row_blocks;
+  /* Off-diagonal blocks with the vertex as column. */
+  unsigned int *col_offsets;
+  unsigned int *col_blocks;
+} fmatrixIndex;
+
+static void bfmatrix_index_offsets(unsigned int *offsets, unsigned int vcount)
+{
+  unsigned int offset = 0;
+  for (unsigned int v = 0; v <= vcount; v++) {
+    const unsigned int count = offsets[v];
+    offsets[v] = offset;
+    offset += count;
+  }
+}
+
+/* The index only depends on the rows and columns of the blocks, it can be used for all matrices
+ * sharing the layout of \a matrix. */
+static void create_bfmatrix_index(fmatrixIndex *index, const fmatrix3x3 *matrix)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int totblock = matrix[0].vcount + matrix[0].scount;
+
+  index->vcount = vcount;
+  index->row_offsets = MEM_calloc_arrayN(vcount + 1, sizeof(unsigned int), __func__);
+  index->col_offsets = MEM_calloc_arrayN(vcount + 1, sizeof(unsigned int), __func__);
+  index->row_blocks = MEM_malloc_arrayN(totblock, sizeof(unsigned int), __func__);
+  index->col_blocks = MEM_malloc_arrayN(
+      max_ii(matrix[0].scount, 1), sizeof(unsigned int), __func__);
+
+  for (unsigned int i = 0; i < totblock; i++) {
+    index->row_offsets[matrix[i].r]++;
+    if (i >= vcount) {
+      index->col_offsets[matrix[i].c]++;
+    }
+  }
+  bfmatrix_index_offsets(index->row_offsets, vcount);
+  bfmatrix_index_offsets(index->col_offsets, vcount);
+
+  unsigned int *row_fill = MEM_dupallocN(index->row_offsets);
+  unsigned int *col_fill = MEM_dupallocN(index->col_offsets);
+  for (unsigned int i = 0; i < totblock; i++) {
+    index->row_blocks[row_fill[matrix[i].r]++] = i;
+    if (i >= vcount) {
+      index->col_blocks[col_fill[matrix[i].c]++] = i;
+    }
+  }
+  MEM_freeN(row_fill);
+  MEM_freeN(col_fill);
+}
+
+static void del_bfmatrix_index(fmatrixIndex *index)
+{
+  MEM_freeN(index->row_offsets);
+  MEM_freeN(index->row_blocks);
+  MEM_freeN(index->col_offsets);
+  MEM_freeN(index->col_blocks);
+}
+
+typedef struct MulBFMatrixData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const fmatrixIndex *index;
+  const lfVector *fLongVector;
+} MulBFMatrixData;
+
+static void mul_bfmatrix_lfvector_task_cb(void *__restrict userdata,
+                                          const int v,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBFMatrixData *data = userdata;
+  const fmatrix3x3 *from = data->from;
+  const fmatrixIndex *index = data->index;
+  const lfVector *fLongVector = data->fLongVector;
+
+  /* Same sums as the two passes of #mul_bfmatrix_lfvector, gathered per vertex. */
+  float to[3] = {0.0f, 0.0f, 0.0f};
+  float temp[3] = {0.0f, 0.0f, 0.0f};
+  for (unsigned int j = index->col_offsets[v]; j < index->col_offsets[v + 1]; j++) {
+    const fmatrix3x3 *block = &from[index->col_blocks[j]];
+    muladd_fmatrixT_fvector(to, block->m, fLongVector[block->r]);
+  }
+  for (unsigned int j = index->row_offsets[v]; j < index->row_offsets[v + 1]; j++) {
+    const fmatrix3x3 *block = &from[index->row_blocks[j]];
+    muladd_fmatrix_fvector(temp, block->m, fLongVector[block->c]);
+  }
+  add_v3_v3v3(data->to[v], to, temp);
+}
+
+/* Multi-threaded version of #mul_bfmatrix_lfvector, giving the same result. */
+static void mul_bfmatrix_lfvector_indexed(float (*to)[3],
+                                          const fmatrix3x3 *from,
+                                          const fmatrixIndex *index,
+                                          const lfVector *fLongVector)
+{
+  MulBFMatrixData data = {
+      .to = to,
+      .from = from,
+      .index = index,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 512;
+  BLI_task_parallel_range(0, index->vcount, &data, mul_bfmatrix_lfvector_task_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -852,6 +967,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrixIndex *lA_index,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -879,7 +995,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_indexed(AdV, lA, lA_index, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -902,7 +1018,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_indexed(q, lA, lA_index, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1162,7 +1278,12 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* The springs of a step are known here, #SIM_mass_spring_add_block sets the same layout for all
+   * matrices with off-diagonal blocks. */
+  fmatrixIndex index;
+  create_bfmatrix_index(&index, data->A);
+
+  mul_bfmatrix_lfvector_indexed(dFdXmV, data->dFdX, &index, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1292,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &index, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1184,6 +1305,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
   del_lfvector(dFdXmV);
+  del_bfmatrix_index(&index);
 
   return result->status == SIM_SOLVER_SUCCESS;
 }
@@ -43,6 +43,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
@@ -207,36 +208,48 @@ void wm_event_init_from_window(wmWindow *win, wmEvent *event)
 /** \name Notifiers & Listeners
  * \{ */
 
-static bool wm_test_duplicate_notifier(const wmWindowManager *wm, uint type, void *reference)
+static uint note_hash_for_queue_fn(const void *ptr)
 {
-  LISTBASE_FOREACH (wmNotifier *, note, &wm->queue) {
-    if ((note->category | note->data | note->subtype | note->action) == type &&
-        note->reference == reference) {
-      return true;
-    }
-  }
+  const wmNotifier *note = ptr;
+  return (BLI_ghashutil_ptrhash(note->reference) ^
+          (note->category | note->data | note->subtype | note->action));
+}
 
-  return false;
+static bool note_cmp_for_queue_fn(const void *a, const void *b)
+{
+  const wmNotifier *note_a = a;
+  const wmNotifier *note_b = b;
+  return !(((note_a->category | note_a->data | note_a->subtype | note_a->action) ==
+            (note_b->category | note_b->data | note_b->subtype | note_b->action)) &&
+           (note_a->reference == note_b->reference));
 }
 
 void WM_event_add_notifier_ex(wmWindowManager *wm, const wmWindow *win, uint type, void *reference)
 {
-  if (wm_test_duplicate_notifier(wm, type, reference)) {
+  const wmNotifier note_test = {
+      .category = type & NOTE_CATEGORY,
+      .data = type & NOTE_DATA,
+      .subtype = type & NOTE_SUBTYPE,
+      .action = type & NOTE_ACTION,
+      .reference = reference,
+  };
+
+  /* Look up duplicates in a hash set, a linear search of the queue makes adding many notifiers
+   * (when linking thousands of objects from a script for example) quadratically slower. */
+  if (wm->notifier_queue_set == NULL) {
+    wm->notifier_queue_set = BLI_gset_new(
+        note_hash_for_queue_fn, note_cmp_for_queue_fn, __func__);
+  }
+  else if (BLI_gset_haskey(wm->notifier_queue_set, &note_test)) {
     return;
   }
 
-  wmNotifier *note = MEM_callocN(sizeof(wmNotifier), "notifier");
-
-  BLI_addtail(&wm->queue, note);
-
+  wmNotifier *note = MEM_mallocN(sizeof(wmNotifier), "notifier");
+  *note = note_test;
   note->window = win;
 
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
-
-  note->reference = reference;
+  BLI_addtail(&wm->queue, note);
+  BLI_gset_insert(wm->notifier_queue_set, note);
 }
 
 /* XXX: in future, which notifiers to send to other windows? */
@@ -250,20 +263,11 @@ void WM_main_add_notifier(unsigned int type, void *reference)
   Main *bmain = G_MAIN;
   wmWindowManager *wm = bmain->wm.first;
 
-  if (!wm || wm_test_duplicate_notifier(wm, type, reference)) {
+  if (!wm) {
     return;
   }
 
-  wmNotifier *note = MEM_callocN(sizeof(wmNotifier), "notifier");
-
-  BLI_addtail(&wm->queue, note);
-
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
-
-  note->reference = reference;
+  WM_event_add_notifier_ex(wm, NULL, type, reference);
 }
 
 /**
@@ -279,6 +283,7 @@ void WM_main_remove_notifier_reference(const void *reference)
       if (note->reference == reference) {
         /* Don't remove because this causes problems for #wm_event_do_notifiers
          * which may be looping on the data (deleting screens). */
+        BLI_gset_remove(wm->notifier_queue_set, note, NULL);
         wm_notifier_clear(note);
       }
     }
@@ -517,6 +522,9 @@ void wm_event_do_notifiers(bContext *C)
   /* The notifiers are sent without context, to keep it clean. */
   wmNotifier *note;
   while ((note = BLI_pophead(&wm->queue))) {
+    /* Removed before the listeners run, so they can send the same notifier again. */
+    BLI_gset_remove(wm->notifier_queue_set, note, NULL);
+
     LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
       Scene *scene = WM_window_get_active_scene(win);
       bScreen *screen = WM_window_get_active_screen(win);
@@ -31,6 +31,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.h"
@@ -386,7 +387,10 @@ static void *do_job_thread(void *job_v)
   wmJob *wm_job = job_v;
 
   BLI_thread_put_thread_on_fast_node();
+  BLI_trace_thread_name_set(wm_job->name);
+  BLI_trace_zone_begin(wm_job->name);
   wm_job->startjob(wm_job->run_customdata, &wm_job->stop, &wm_job->do_update, &wm_job->progress);
+  BLI_trace_zone_end();
   wm_job->ready = true;
 
   return NULL;
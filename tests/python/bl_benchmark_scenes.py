@@ -0,0 +1,194 @@
+# Apache License, Version 2.0
+
+"""
+Time loading, evaluating, drawing and rendering of a set of blend files.
+
+Timings are written as JSON, so that the results of different builds can be compared:
+
+  ./blender.bin --background -noaudio --factory-startup \
+    --python tests/python/bl_benchmark_scenes.py -- \
+    --files /path/to/a.blend /path/to/b.blend --frames 10 --output results.json
+
+Drawing is only timed when Blender runs with a window, a background instance has nothing to
+draw in. Render phases are taken from the status messages of the render engine, so they are only
+as detailed as the messages of the engine (Cycles reports synchronization, BVH building and
+sampling separately).
+"""
+
+import bpy
+import json
+import os
+import sys
+import time
+
+
+# Substrings of the render status messages, mapped to the phase they belong to.
+# Checked in this order, the first match decides the phase.
+RENDER_PHASES = (
+    ("BVH", "bvh"),
+    ("Synchroniz", "sync"),
+    ("Updating", "sync"),
+    ("Sample", "render"),
+    ("Rendering", "render"),
+    ("Path Tracing", "render"),
+    ("Denoising", "denoise"),
+)
+
+
+class RenderPhaseTimer:
+    """Accumulate the time spent in each render phase, using the render stats handler."""
+
+    def __init__(self):
+        self.phases = {}
+        self.phase = None
+        self.phase_start = 0.0
+
+    def _phase_from_stats(self, stats):
+        for substring, phase in RENDER_PHASES:
+            if substring in stats:
+                return phase
+        return "other"
+
+    def _switch_phase(self, phase):
+        now = time.perf_counter()
+        if self.phase is not None:
+            self.phases[self.phase] = self.phases.get(self.phase, 0.0) + now - self.phase_start
+        self.phase = phase
+        self.phase_start = now
+
+    def on_stats(self, stats):
+        phase = self._phase_from_stats(stats)
+        if phase != self.phase:
+            self._switch_phase(phase)
+
+    def __enter__(self):
+        bpy.app.handlers.render_stats.append(self.on_stats)
+        self._switch_phase("other")
+        return self
+
+    def __exit__(self, *args):
+        self._switch_phase(None)
+        bpy.app.handlers.render_stats.remove(self.on_stats)
+
+
+def time_load(filepath):
+    start = time.perf_counter()
+    bpy.ops.wm.open_mainfile(filepath=filepath, load_ui=False)
+    return time.perf_counter() - start
+
+
+def time_frames(scene, num_frames):
+    """Time the depsgraph evaluation of each frame, starting at the first frame of the scene."""
+    frame_times = []
+    for frame in range(scene.frame_start, scene.frame_start + num_frames):
+        start = time.perf_counter()
+        scene.frame_set(frame)
+        frame_times.append(time.perf_counter() - start)
+    return frame_times
+
+
+def time_draw(iterations):
+    """Time redrawing all windows, None when there is nothing to draw."""
+    if bpy.app.background:
+        return None
+    window = bpy.context.window_manager.windows[0]
+    override = {"window": window, "screen": window.screen}
+    start = time.perf_counter()
+    bpy.ops.wm.redraw_timer(override, type='DRAW_WIN_SWAP', iterations=iterations)
+    return (time.perf_counter() - start) / iterations
+
+
+def time_render():
+    """Render the current frame, return the total time and the time spent in each phase."""
+    with RenderPhaseTimer() as phase_timer:
+        start = time.perf_counter()
+        bpy.ops.render.render(write_still=False)
+        total = time.perf_counter() - start
+    return total, phase_timer.phases
+
+
+def benchmark_file(filepath, args):
+    result = {"file": os.path.basename(filepath)}
+    result["load_time"] = time_load(filepath)
+
+    scene = bpy.context.scene
+    result["engine"] = scene.render.engine
+
+    frame_times = time_frames(scene, args.frames)
+    result["frame_times"] = frame_times
+    result["frame_time_average"] = sum(frame_times) / len(frame_times) if frame_times else None
+
+    result["draw_time"] = time_draw(args.draw_iterations)
+
+    if not args.skip_render:
+        scene.frame_set(scene.frame_start)
+        result["render_time"], result["render_phases"] = time_render()
+
+    return result
+
+
+def argparse_create():
+    import argparse
+
+    # When --help or no args are given, print this help
+    description = "Time loading, evaluating, drawing and rendering of blend files."
+    parser = argparse.ArgumentParser(description=description)
+    parser.add_argument(
+        "--files",
+        dest="files",
+        nargs="+",
+        required=True,
+        help="Blend files to benchmark",
+    )
+    parser.add_argument(
+        "--frames",
+        dest="frames",
+        type=int,
+        default=10,
+        help="Number of frames to evaluate, starting at the first frame of the scene",
+    )
+    parser.add_argument(
+        "--draw-iterations",
+        dest="draw_iterations",
+        type=int,
+        default=10,
+        help="Number of times to redraw the windows, when not running in background",
+    )
+    parser.add_argument(
+        "--skip-render",
+        dest="skip_render",
+        action="store_true",
+        help="Don't render the first frame",
+    )
+    parser.add_argument(
+        "--output",
+        dest="output",
+        default=None,
+        help="File to write the JSON results to, they are printed when not given",
+    )
+
+    return parser
+
+
+def main():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    args = argparse_create().parse_args(argv)
+
+    results = {
+        "blender_version": bpy.app.version_string,
+        "build_hash": bpy.app.build_hash.decode("ascii"),
+        "build_type": bpy.app.build_type.decode("ascii"),
+        "files": [benchmark_file(filepath, args) for filepath in args.files],
+    }
+
+    text = json.dumps(results, indent=2)
+    if args.output is None:
+        print(text)
+    else:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            output_file.write(text)
+            output_file.write("\n")
+
+
+if __name__ == "__main__":
+    main()